@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "typealias integer { size = 32; } := u32;"
+    "typealias integer { size = 16; signed = true; } := s16;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = le;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 0;"
+    "  fields := struct {"
+    "    u32 a;"
+    "    s16 b;"
+    "    string s;"
+    "    u8 len;"
+    "    u16 arr[len];"
+    "    floating_point { exp_dig = 8; mant_dig = 24; align = 8; } f;"
+    "    enum : u8 { X, Y, Z } e;"
+    "  };"
+    "};";
+
+/*
+ * Data source of which the single data block is a whole memory
+ * region.
+ */
+class MemDataSrc final :
+    public yactfr::DataSource
+{
+public:
+    explicit MemDataSrc(const std::vector<std::uint8_t>& data) :
+        _memData {&data}
+    {
+    }
+
+private:
+    boost::optional<yactfr::DataBlock> _data(const yactfr::Index offset, yactfr::Size) override
+    {
+        if (offset >= _memData->size()) {
+            return boost::none;
+        }
+
+        return yactfr::DataBlock {_memData->data() + offset, _memData->size() - offset};
+    }
+
+private:
+    const std::vector<std::uint8_t> *_memData;
+};
+
+class MemDataSrcFactory final :
+    public yactfr::DataSourceFactory
+{
+public:
+    explicit MemDataSrcFactory(const std::vector<std::uint8_t>& data) :
+        _memData {&data}
+    {
+    }
+
+private:
+    yactfr::DataSource::Up _createDataSource() override
+    {
+        return std::make_unique<MemDataSrc>(*_memData);
+    }
+
+private:
+    const std::vector<std::uint8_t> *_memData;
+};
+
+std::vector<std::uint8_t> createData(const unsigned long erCount)
+{
+    std::vector<std::uint8_t> data;
+
+    for (auto i = 0UL; i < erCount; ++i) {
+        const auto len = i % 5;
+
+        data.push_back(0);
+
+        for (auto j = 0U; j < 4; ++j) {
+            data.push_back((i >> (j * 8)) & 0xff);
+        }
+
+        data.push_back(i & 0xff);
+        data.push_back(0x80);
+
+        for (const auto ch : "sched_switch") {
+            data.push_back(ch);
+        }
+
+        data.push_back(len);
+
+        for (auto j = 0U; j < len; ++j) {
+            data.push_back(j);
+            data.push_back(i & 0xff);
+        }
+
+        data.push_back(0);
+        data.push_back(0);
+        data.push_back(0x80);
+        data.push_back(0x3f);
+        data.push_back(i % 3);
+    }
+
+    return data;
+}
+
+/*
+ * Result of consuming elements: an element printer which only keeps a
+ * checksum of what it would print.
+ */
+struct Digest final
+{
+    void update(const unsigned long long val) noexcept
+    {
+        sum = sum * 31 + val;
+    }
+
+    unsigned long long sum = 0;
+};
+
+class DigestVisitor final :
+    public yactfr::ElementVisitor
+{
+public:
+    explicit DigestVisitor(Digest& digest) :
+        _digest {&digest}
+    {
+    }
+
+    void visit(const yactfr::PacketBeginningElement&) override
+    {
+        _digest->update(1);
+    }
+
+    void visit(const yactfr::EventRecordBeginningElement&) override
+    {
+        _digest->update(2);
+    }
+
+    void visit(const yactfr::EventRecordInfoElement& elem) override
+    {
+        _digest->update(elem.type() ? elem.type()->id() : 0);
+    }
+
+    void visit(const yactfr::StructureBeginningElement&) override
+    {
+        _digest->update(3);
+    }
+
+    void visit(const yactfr::FixedLengthUnsignedIntegerElement& elem) override
+    {
+        _digest->update(elem.value());
+    }
+
+    void visit(const yactfr::FixedLengthSignedIntegerElement& elem) override
+    {
+        _digest->update(static_cast<unsigned long long>(elem.value()));
+    }
+
+    void visit(const yactfr::FixedLengthFloatingPointNumberElement& elem) override
+    {
+        _digest->update(static_cast<unsigned long long>(elem.value() * 1000));
+    }
+
+    void visit(const yactfr::RawDataElement& elem) override
+    {
+        _digest->update(elem.end() - elem.begin());
+    }
+
+    void visit(const yactfr::DynamicLengthArrayBeginningElement& elem) override
+    {
+        _digest->update(elem.length());
+    }
+
+private:
+    Digest *_digest;
+};
+
+/*
+ * Object having the `operator()` overloads of all the `FuncTs`
+ * callable objects (overloaded lambdas).
+ */
+template <typename... FuncTs>
+struct Overloaded;
+
+template <typename FuncT>
+struct Overloaded<FuncT> :
+    FuncT
+{
+    explicit Overloaded(FuncT func) :
+        FuncT {std::move(func)}
+    {
+    }
+
+    using FuncT::operator();
+};
+
+template <typename FuncT, typename... FuncTs>
+struct Overloaded<FuncT, FuncTs...> :
+    FuncT,
+    Overloaded<FuncTs...>
+{
+    explicit Overloaded(FuncT func, FuncTs... funcs) :
+        FuncT {std::move(func)},
+        Overloaded<FuncTs...> {std::move(funcs)...}
+    {
+    }
+
+    using FuncT::operator();
+    using Overloaded<FuncTs...>::operator();
+};
+
+template <typename... FuncTs>
+Overloaded<FuncTs...> overloaded(FuncTs... funcs)
+{
+    return Overloaded<FuncTs...> {std::move(funcs)...};
+}
+
+// same as `DigestVisitor`
+auto digestFunc(Digest& digest)
+{
+    return overloaded(
+        [&digest](const yactfr::PacketBeginningElement&) {
+            digest.update(1);
+        },
+        [&digest](const yactfr::EventRecordBeginningElement&) {
+            digest.update(2);
+        },
+        [&digest](const yactfr::EventRecordInfoElement& elem) {
+            digest.update(elem.type() ? elem.type()->id() : 0);
+        },
+        [&digest](const yactfr::StructureBeginningElement&) {
+            digest.update(3);
+        },
+        [&digest](const yactfr::FixedLengthUnsignedIntegerElement& elem) {
+            digest.update(elem.value());
+        },
+        [&digest](const yactfr::FixedLengthSignedIntegerElement& elem) {
+            digest.update(static_cast<unsigned long long>(elem.value()));
+        },
+        [&digest](const yactfr::FixedLengthFloatingPointNumberElement& elem) {
+            digest.update(static_cast<unsigned long long>(elem.value() * 1000));
+        },
+        [&digest](const yactfr::RawDataElement& elem) {
+            digest.update(elem.end() - elem.begin());
+        },
+        [&digest](const yactfr::DynamicLengthArrayBeginningElement& elem) {
+            digest.update(elem.length());
+        },
+        [](const yactfr::Element&) {
+        }
+    );
+}
+
+template <typename ConsumeFuncT>
+std::chrono::duration<double> bestDur(const int iterCount, ConsumeFuncT&& consumeFunc)
+{
+    std::chrono::duration<double> best {0};
+
+    for (auto i = 0; i < iterCount; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+
+        consumeFunc();
+
+        const auto dur = std::chrono::duration<double> {
+            std::chrono::steady_clock::now() - begin
+        };
+
+        if (i == 0 || dur < best) {
+            best = dur;
+        }
+    }
+
+    return best;
+}
+
+} // namespace
+
+/*
+ * Element visitation benchmark.
+ *
+ * Usage:
+ *
+ *     elem-visit-bench [EVENT-RECORDS [ITERATIONS]]
+ *
+ * Creates an in-memory data stream of `EVENT-RECORDS` event records
+ * (default: 1000000) and consumes all its elements `ITERATIONS` times
+ * (default: 10) with each of the following methods:
+ *
+ * accept():
+ *     Iterates the element sequence and calls Element::accept() with
+ *     an element visitor.
+ *
+ * visit():
+ *     Iterates the element sequence and calls yactfr::visit() with
+ *     overloaded lambdas.
+ *
+ * decode():
+ *     Calls ElementSequence::decode() with the same overloaded lambdas.
+ *
+ * Prints the best duration of each method and the corresponding
+ * element throughput.
+ */
+int main(const int argc, const char * const argv[])
+{
+    const auto erCount = argc >= 2 ? std::max(std::atol(argv[1]), 1L) : 1000000L;
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 10;
+
+    try {
+        const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+        const auto data = createData(erCount);
+        MemDataSrcFactory factory {data};
+        yactfr::ElementSequence seq {*traceType, factory};
+        unsigned long long elemCount = 0;
+
+        for (auto it = seq.begin(); it != seq.end(); ++it) {
+            ++elemCount;
+        }
+
+        Digest acceptDigest, visitDigest, decodeDigest;
+        const auto acceptDur = bestDur(iterCount, [&] {
+            acceptDigest = Digest {};
+
+            DigestVisitor visitor {acceptDigest};
+
+            for (const auto& elem : seq) {
+                elem.accept(visitor);
+            }
+        });
+        const auto visitDur = bestDur(iterCount, [&] {
+            visitDigest = Digest {};
+
+            auto func = digestFunc(visitDigest);
+
+            for (const auto& elem : seq) {
+                yactfr::visit(elem, func);
+            }
+        });
+        const auto decodeDur = bestDur(iterCount, [&] {
+            decodeDigest = Digest {};
+            seq.decode(digestFunc(decodeDigest));
+        });
+
+        if (visitDigest.sum != acceptDigest.sum || decodeDigest.sum != acceptDigest.sum) {
+            std::cerr << "Digests don't match.\n";
+            return 1;
+        }
+
+        const auto print = [elemCount](const char * const name,
+                                       const std::chrono::duration<double>& dur) {
+            std::cout << std::setw(10) << std::left << name <<
+                         std::setw(10) << std::right << dur.count() * 1000 << " ms  " <<
+                         std::setw(10) << elemCount / dur.count() / 1e6 << " M elements/s\n";
+        };
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "size:       " << static_cast<double>(data.size()) / (1024 * 1024) <<
+                     " MiB\n" <<
+                     "elements:   " << elemCount << '\n' <<
+                     "iterations: " << iterCount << '\n';
+        print("accept()", acceptDur);
+        print("visit()", visitDur);
+        print("decode()", decodeDur);
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
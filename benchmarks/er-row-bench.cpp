@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "typealias integer { size = 32; } := u32;"
+    "typealias integer { size = 64; } := u64;"
+    "typealias integer { size = 16; signed = true; } := s16;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = le;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 0;"
+    "  fields := struct {"
+    "    u32 a;"
+    "    s16 b;"
+    "    u64 ts;"
+    "    u16 arr[4];"
+    "    floating_point { exp_dig = 8; mant_dig = 24; align = 8; } f;"
+    "    u8 c;"
+    "  };"
+    "};";
+
+// row of the event record type above
+struct Row final
+{
+    std::uint32_t a;
+    std::int16_t b;
+    std::uint64_t ts;
+    std::uint16_t arr[4];
+    float f;
+    std::uint8_t c;
+};
+
+/*
+ * Data source of which the single data block is a whole memory
+ * region.
+ */
+class MemDataSrc final :
+    public yactfr::DataSource
+{
+public:
+    explicit MemDataSrc(const std::vector<std::uint8_t>& data) :
+        _memData {&data}
+    {
+    }
+
+private:
+    boost::optional<yactfr::DataBlock> _data(const yactfr::Index offset, yactfr::Size) override
+    {
+        if (offset >= _memData->size()) {
+            return boost::none;
+        }
+
+        return yactfr::DataBlock {_memData->data() + offset, _memData->size() - offset};
+    }
+
+private:
+    const std::vector<std::uint8_t> *_memData;
+};
+
+class MemDataSrcFactory final :
+    public yactfr::DataSourceFactory
+{
+public:
+    explicit MemDataSrcFactory(const std::vector<std::uint8_t>& data) :
+        _memData {&data}
+    {
+    }
+
+private:
+    yactfr::DataSource::Up _createDataSource() override
+    {
+        return std::make_unique<MemDataSrc>(*_memData);
+    }
+
+private:
+    const std::vector<std::uint8_t> *_memData;
+};
+
+std::vector<std::uint8_t> createData(const unsigned long erCount)
+{
+    std::vector<std::uint8_t> data;
+
+    for (auto i = 0UL; i < erCount; ++i) {
+        data.push_back(0);
+
+        for (auto j = 0U; j < 4; ++j) {
+            data.push_back((i >> (j * 8)) & 0xff);
+        }
+
+        data.push_back(i & 0xff);
+        data.push_back(0x80);
+
+        for (auto j = 0U; j < 8; ++j) {
+            data.push_back((i * 1000 >> (j * 8)) & 0xff);
+        }
+
+        for (auto j = 0U; j < 4; ++j) {
+            data.push_back(j);
+            data.push_back(i & 0xff);
+        }
+
+        data.push_back(0);
+        data.push_back(0);
+        data.push_back(0x80);
+        data.push_back(0x3f);
+        data.push_back(i % 3);
+    }
+
+    return data;
+}
+
+// checksum of the fields of all the event records
+struct Digest final
+{
+    void update(const unsigned long long val) noexcept
+    {
+        sum = sum * 31 + val;
+    }
+
+    unsigned long long sum = 0;
+};
+
+template <typename ConsumeFuncT>
+std::chrono::duration<double> bestDur(const int iterCount, ConsumeFuncT&& consumeFunc)
+{
+    std::chrono::duration<double> best {0};
+
+    for (auto i = 0; i < iterCount; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+
+        consumeFunc();
+
+        const auto dur = std::chrono::duration<double> {
+            std::chrono::steady_clock::now() - begin
+        };
+
+        if (i == 0 || dur < best) {
+            best = dur;
+        }
+    }
+
+    return best;
+}
+
+} // namespace
+
+/*
+ * Event record row benchmark.
+ *
+ * Usage:
+ *
+ *     er-row-bench [EVENT-RECORDS [ITERATIONS]]
+ *
+ * Creates an in-memory data stream of `EVENT-RECORDS` event records
+ * (default: 1000000), all having a static layout, and reads all their
+ * fields `ITERATIONS` times (default: 10) with each of the following
+ * methods:
+ *
+ * elements:
+ *     Iterates all the elements of the element sequence.
+ *
+ * rows:
+ *     Calls ElementSequenceIterator::readEventRecordRow() for each
+ *     event record.
+ *
+ * Prints the best duration of each method and the corresponding
+ * event record throughput.
+ */
+int main(const int argc, const char * const argv[])
+{
+    const auto erCount = argc >= 2 ? std::max(std::atol(argv[1]), 1L) : 1000000L;
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 10;
+
+    try {
+        const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+        const auto data = createData(erCount);
+        MemDataSrcFactory factory {data};
+        yactfr::ElementSequence seq {*traceType, factory};
+        Digest elemDigest, rowDigest;
+        const auto elemDur = bestDur(iterCount, [&] {
+            elemDigest = Digest {};
+
+            for (const auto& elem : seq) {
+                if (elem.isFixedLengthUnsignedIntegerElement()) {
+                    elemDigest.update(elem.asFixedLengthUnsignedIntegerElement().value());
+                } else if (elem.isFixedLengthSignedIntegerElement()) {
+                    const auto val = elem.asFixedLengthSignedIntegerElement().value();
+
+                    elemDigest.update(static_cast<unsigned long long>(val));
+                } else if (elem.isFixedLengthFloatingPointNumberElement()) {
+                    const auto val = elem.asFixedLengthFloatingPointNumberElement().value();
+
+                    elemDigest.update(static_cast<unsigned long long>(val * 1000));
+                }
+            }
+        });
+        const auto rowDur = bestDur(iterCount, [&] {
+            rowDigest = Digest {};
+
+            Row row;
+            const auto endIt = seq.end();
+
+            for (auto it = seq.begin(); it != endIt; ++it) {
+                if (it->isFixedLengthUnsignedIntegerElement()) {
+                    // event record header
+                    rowDigest.update(it->asFixedLengthUnsignedIntegerElement().value());
+                    continue;
+                }
+
+                if (!it->isEventRecordInfoElement()) {
+                    continue;
+                }
+
+                it.readEventRecordRow(&row);
+                rowDigest.update(row.a);
+                rowDigest.update(static_cast<unsigned long long>(row.b));
+                rowDigest.update(row.ts);
+
+                for (const auto val : row.arr) {
+                    rowDigest.update(val);
+                }
+
+                rowDigest.update(static_cast<unsigned long long>(row.f * 1000));
+                rowDigest.update(row.c);
+            }
+        });
+
+        if (rowDigest.sum != elemDigest.sum) {
+            std::cerr << "Digests don't match.\n";
+            return 1;
+        }
+
+        const auto print = [erCount](const char * const name,
+                                     const std::chrono::duration<double>& dur) {
+            std::cout << std::setw(10) << std::left << name <<
+                         std::setw(10) << std::right << dur.count() * 1000 << " ms  " <<
+                         std::setw(10) << erCount / dur.count() / 1e6 <<
+                         " M event records/s\n";
+        };
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "size:          " << static_cast<double>(data.size()) / (1024 * 1024) <<
+                     " MiB\n" <<
+                     "event records: " << erCount << '\n' <<
+                     "iterations:    " << iterCount << '\n';
+        print("elements", elemDur);
+        print("rows", rowDur);
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
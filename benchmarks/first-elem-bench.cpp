@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+// current number of allocated heap bytes
+std::atomic<std::size_t> heapSize {0};
+
+// header which precedes each allocated block to record its size
+constexpr std::size_t allocHeaderSize = alignof(std::max_align_t);
+
+void *countedAlloc(const std::size_t size)
+{
+    const auto block = static_cast<char *>(std::malloc(allocHeaderSize + size));
+
+    if (!block) {
+        throw std::bad_alloc {};
+    }
+
+    *reinterpret_cast<std::size_t *>(block) = size;
+    heapSize += size;
+    return block + allocHeaderSize;
+}
+
+void countedFree(void * const ptr) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+
+    const auto block = static_cast<char *>(ptr) - allocHeaderSize;
+
+    heapSize -= *reinterpret_cast<std::size_t *>(block);
+    std::free(block);
+}
+
+/*
+ * Data source without any data: the first element of an element
+ * sequence is its end, once the iterator has its packet procedure.
+ */
+class EmptyDataSrc final :
+    public yactfr::DataSource
+{
+private:
+    boost::optional<yactfr::DataBlock> _data(yactfr::Index, yactfr::Size) override
+    {
+        return boost::none;
+    }
+};
+
+class EmptyDataSrcFactory final :
+    public yactfr::DataSourceFactory
+{
+private:
+    yactfr::DataSource::Up _createDataSource() override
+    {
+        return std::make_unique<EmptyDataSrc>();
+    }
+};
+
+} // namespace
+
+void *operator new(const std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](const std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void * const ptr) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void * const ptr) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void * const ptr, std::size_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void * const ptr, std::size_t) noexcept
+{
+    countedFree(ptr);
+}
+
+/*
+ * Time-to-first-element benchmark.
+ *
+ * Usage:
+ *
+ *     first-elem-bench PATH [ITERATIONS]
+ *
+ * Parses the metadata stream file `PATH` (TSDL or CTF 2, plain text or
+ * packetized) `ITERATIONS` times (default: 10), creating the first
+ * element sequence iterator of each resulting trace type, which builds
+ * its packet procedure, and prints the mean duration of this creation
+ * as well as the heap memory which the iterator and its packet
+ * procedure take.
+ *
+ * Configure yactfr with `-DOPT_EAGER_ER_PROCS=ON` to compare with
+ * building all the event record procedures up front.
+ */
+int main(const int argc, const char * const argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " PATH [ITERATIONS]\n";
+        return 1;
+    }
+
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 10;
+
+    try {
+        std::ifstream file {argv[1], std::ios::binary};
+        const auto metadataStream = yactfr::createMetadataStream(file);
+        std::chrono::duration<double> totalDur {0};
+        std::size_t iterHeapSize = 0;
+        EmptyDataSrcFactory factory;
+
+        for (auto i = 0; i < iterCount; ++i) {
+            const auto traceType = yactfr::fromMetadataText(metadataStream->text()).first;
+            yactfr::ElementSequence seq {*traceType, factory};
+            const auto heapSizeBefore = heapSize.load();
+            const auto begin = std::chrono::steady_clock::now();
+            const auto it = seq.begin();
+
+            totalDur += std::chrono::steady_clock::now() - begin;
+            iterHeapSize = heapSize.load() - heapSizeBefore;
+
+            if (it != seq.end()) {
+                std::abort();
+            }
+        }
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "iterations:         " << iterCount << '\n' <<
+                     "first element:      " << totalDur.count() * 1000 / iterCount << " ms\n" <<
+                     "iterator heap size: " << iterHeapSize << " B\n";
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
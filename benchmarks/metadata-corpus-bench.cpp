@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+/*
+ * Appends the paths of all the `pass-*` files found recursively within
+ * the directory `dirPath` to `paths`.
+ */
+void findPassFiles(const std::string& dirPath, std::vector<std::string>& paths)
+{
+    const auto dir = opendir(dirPath.c_str());
+
+    if (!dir) {
+        throw std::runtime_error {"Cannot open directory `" + dirPath + "`."};
+    }
+
+    while (const auto entry = readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        const auto path = dirPath + '/' + entry->d_name;
+        struct stat st;
+
+        if (stat(path.c_str(), &st) != 0) {
+            continue;
+        }
+
+        if (S_ISDIR(st.st_mode)) {
+            findPassFiles(path, paths);
+        } else if (S_ISREG(st.st_mode) && std::strncmp(entry->d_name, "pass-", 5) == 0) {
+            paths.push_back(path);
+        }
+    }
+
+    closedir(dir);
+}
+
+} // namespace
+
+/*
+ * Metadata corpus parsing benchmark.
+ *
+ * Usage:
+ *
+ *     metadata-corpus-bench DIR [ITERATIONS]
+ *
+ * Parses all the `pass-*` metadata stream files (TSDL or CTF 2) found
+ * recursively within the directory `DIR` (for example,
+ * `tests/tests-metadata-text`) `ITERATIONS` times (default: 10) and
+ * prints the best and mean durations to parse the whole corpus as well
+ * as the best throughput.
+ */
+int main(const int argc, const char * const argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " DIR [ITERATIONS]\n";
+        return 1;
+    }
+
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 10;
+
+    try {
+        std::vector<std::string> paths;
+
+        findPassFiles(argv[1], paths);
+        std::sort(paths.begin(), paths.end());
+
+        if (paths.empty()) {
+            throw std::runtime_error {"No `pass-*` metadata stream file found."};
+        }
+
+        // read all the metadata stream texts once
+        std::vector<std::string> texts;
+        std::size_t totalSize = 0;
+
+        for (const auto& path : paths) {
+            std::ifstream file {path, std::ios::binary};
+
+            texts.push_back(yactfr::createMetadataStream(file)->text());
+            totalSize += texts.back().size();
+        }
+
+        std::chrono::duration<double> bestDur {0};
+        std::chrono::duration<double> totalDur {0};
+
+        for (auto i = 0; i < iterCount; ++i) {
+            const auto begin = std::chrono::steady_clock::now();
+
+            for (const auto& text : texts) {
+                yactfr::fromMetadataText(text);
+            }
+
+            const auto dur = std::chrono::duration<double> {
+                std::chrono::steady_clock::now() - begin
+            };
+
+            if (i == 0 || dur < bestDur) {
+                bestDur = dur;
+            }
+
+            totalDur += dur;
+        }
+
+        const auto sizeMib = static_cast<double>(totalSize) / (1024 * 1024);
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "files:      " << texts.size() << '\n' <<
+                     "size:       " << sizeMib << " MiB\n" <<
+                     "iterations: " << iterCount << '\n' <<
+                     "best:       " << bestDur.count() * 1000 << " ms\n" <<
+                     "mean:       " << totalDur.count() * 1000 / iterCount << " ms\n" <<
+                     "throughput: " << sizeMib / bestDur.count() << " MiB/s\n";
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+/*
+ * Metadata parsing benchmark.
+ *
+ * Usage:
+ *
+ *     metadata-parse-bench PATH [ITERATIONS [THREADS]]
+ *
+ * Parses the metadata stream file `PATH` (TSDL or CTF 2, plain text or
+ * packetized) `ITERATIONS` times (default: 20) with up to `THREADS`
+ * threads (default: 1; 0 means the number of hardware threads) and
+ * prints the best and mean parsing durations as well as the best
+ * throughput.
+ */
+int main(const int argc, const char * const argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " PATH [ITERATIONS [THREADS]]\n";
+        return 1;
+    }
+
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 20;
+    const auto threadCount = argc >= 4 ? std::max(std::atoi(argv[3]), 0) : 1;
+
+    try {
+        std::ifstream file {argv[1], std::ios::binary};
+        const auto metadataStream = yactfr::createMetadataStream(file);
+        const auto& text = metadataStream->text();
+        std::chrono::duration<double> bestDur {0};
+        std::chrono::duration<double> totalDur {0};
+
+        for (auto i = 0; i < iterCount; ++i) {
+            const auto begin = std::chrono::steady_clock::now();
+
+            yactfr::fromMetadataText(text, threadCount);
+
+            const auto dur = std::chrono::duration<double> {
+                std::chrono::steady_clock::now() - begin
+            };
+
+            if (i == 0 || dur < bestDur) {
+                bestDur = dur;
+            }
+
+            totalDur += dur;
+        }
+
+        const auto sizeMib = static_cast<double>(text.size()) / (1024 * 1024);
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "size:       " << sizeMib << " MiB\n" <<
+                     "iterations: " << iterCount << '\n' <<
+                     "threads:    " << threadCount << '\n' <<
+                     "best:       " << bestDur.count() * 1000 << " ms\n" <<
+                     "mean:       " << totalDur.count() * 1000 / iterCount << " ms\n" <<
+                     "throughput: " << sizeMib / bestDur.count() << " MiB/s\n";
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+/*
+ * Calls `func` `iterCount` times and prints the best duration as
+ * `name`, considering a metadata stream size of `sizeMib` MiB.
+ */
+template <typename FuncT>
+void bench(const char * const name, const int iterCount, const double sizeMib, FuncT&& func)
+{
+    std::chrono::duration<double> bestDur {0};
+
+    for (auto i = 0; i < iterCount; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+
+        func();
+
+        const auto dur = std::chrono::duration<double> {
+            std::chrono::steady_clock::now() - begin
+        };
+
+        if (i == 0 || dur < bestDur) {
+            bestDur = dur;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3) << std::setw(14) << std::left <<
+                 name << bestDur.count() * 1000 << " ms (" <<
+                 sizeMib / bestDur.count() << " MiB/s)\n";
+}
+
+} // namespace
+
+/*
+ * Metadata stream opening benchmark.
+ *
+ * Usage:
+ *
+ *     metadata-stream-open-bench PATH [ITERATIONS]
+ *
+ * Decodes the metadata stream file `PATH` (plain text or packetized)
+ * `ITERATIONS` times (default: 20) with each createMetadataStream()
+ * overload (input file stream, memory range, and memory-mapped file
+ * path) and prints the best duration of each one.
+ */
+int main(const int argc, const char * const argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " PATH [ITERATIONS]\n";
+        return 1;
+    }
+
+    const std::string path {argv[1]};
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 20;
+
+    try {
+        std::string data;
+
+        {
+            std::ifstream file {path, std::ios::binary};
+
+            data.assign(std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {});
+        }
+
+        const auto sizeMib = static_cast<double>(data.size()) / (1024 * 1024);
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "size:         " << sizeMib << " MiB\n" <<
+                     "iterations:   " << iterCount << "\n\n";
+
+        bench("istream:", iterCount, sizeMib, [&path] {
+            std::ifstream file {path, std::ios::binary};
+
+            yactfr::createMetadataStream(file);
+        });
+
+        bench("memory range:", iterCount, sizeMib, [&data] {
+            yactfr::createMetadataStream(data.data(), data.data() + data.size());
+        });
+
+        bench("file path:", iterCount, sizeMib, [&path] {
+            yactfr::createMetadataStream(path);
+        });
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
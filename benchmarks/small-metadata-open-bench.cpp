@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+// small CTF 2 metadata stream, typical of a short-lived user space trace
+constexpr const char *metadata =
+    "\x1e{\"type\": \"preamble\", \"version\": 2}"
+    "\x1e{"
+    "  \"type\": \"trace-class\","
+    "  \"packet-header-field-class\": {"
+    "    \"type\": \"structure\","
+    "    \"member-classes\": ["
+    "      {"
+    "        \"name\": \"magic\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-unsigned-integer\","
+    "          \"length\": 32,"
+    "          \"byte-order\": \"little-endian\","
+    "          \"roles\": [\"packet-magic-number\"]"
+    "        }"
+    "      },"
+    "      {"
+    "        \"name\": \"stream_id\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-unsigned-integer\","
+    "          \"length\": 8,"
+    "          \"byte-order\": \"little-endian\","
+    "          \"roles\": [\"data-stream-class-id\"]"
+    "        }"
+    "      }"
+    "    ]"
+    "  }"
+    "}"
+    "\x1e{\"type\": \"clock-class\", \"id\": \"default\", \"frequency\": 1000000000}"
+    "\x1e{"
+    "  \"type\": \"data-stream-class\","
+    "  \"default-clock-class-id\": \"default\","
+    "  \"packet-context-field-class\": {"
+    "    \"type\": \"structure\","
+    "    \"member-classes\": ["
+    "      {"
+    "        \"name\": \"packet_size\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-unsigned-integer\","
+    "          \"length\": 32,"
+    "          \"byte-order\": \"little-endian\","
+    "          \"roles\": [\"packet-total-length\"]"
+    "        }"
+    "      },"
+    "      {"
+    "        \"name\": \"content_size\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-unsigned-integer\","
+    "          \"length\": 32,"
+    "          \"byte-order\": \"little-endian\","
+    "          \"roles\": [\"packet-content-length\"]"
+    "        }"
+    "      }"
+    "    ]"
+    "  },"
+    "  \"event-record-header-field-class\": {"
+    "    \"type\": \"structure\","
+    "    \"member-classes\": ["
+    "      {"
+    "        \"name\": \"id\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-unsigned-integer\","
+    "          \"length\": 8,"
+    "          \"byte-order\": \"little-endian\","
+    "          \"roles\": [\"event-record-class-id\"]"
+    "        }"
+    "      },"
+    "      {"
+    "        \"name\": \"timestamp\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-unsigned-integer\","
+    "          \"length\": 64,"
+    "          \"byte-order\": \"little-endian\","
+    "          \"roles\": [\"default-clock-timestamp\"]"
+    "        }"
+    "      }"
+    "    ]"
+    "  }"
+    "}"
+    "\x1e{"
+    "  \"type\": \"event-record-class\","
+    "  \"id\": 0,"
+    "  \"name\": \"hello\","
+    "  \"payload-field-class\": {"
+    "    \"type\": \"structure\","
+    "    \"member-classes\": ["
+    "      {\"name\": \"msg\", \"field-class\": {\"type\": \"null-terminated-string\"}},"
+    "      {"
+    "        \"name\": \"count\","
+    "        \"field-class\": {"
+    "          \"type\": \"fixed-length-signed-integer\","
+    "          \"length\": 32,"
+    "          \"byte-order\": \"little-endian\""
+    "        }"
+    "      }"
+    "    ]"
+    "  }"
+    "}"
+    "\x1e{"
+    "  \"type\": \"event-record-class\","
+    "  \"id\": 1,"
+    "  \"name\": \"bye\","
+    "  \"payload-field-class\": {"
+    "    \"type\": \"structure\","
+    "    \"member-classes\": ["
+    "      {\"name\": \"msg\", \"field-class\": {\"type\": \"null-terminated-string\"}}"
+    "    ]"
+    "  }"
+    "}";
+
+} // namespace
+
+/*
+ * Small CTF 2 metadata stream opening benchmark.
+ *
+ * Usage:
+ *
+ *     small-metadata-open-bench [ITERATIONS]
+ *
+ * Parses a small CTF 2 metadata stream, as when opening a small trace,
+ * `ITERATIONS` times (default: 10000) and prints the duration of the
+ * first parsing, the mean duration of the other ones, and the opening
+ * rate.
+ */
+int main(const int argc, const char * const argv[])
+{
+    const auto iterCount = argc >= 2 ? std::max(std::atoi(argv[1]), 2) : 10000;
+    const auto end = metadata + std::strlen(metadata);
+
+    try {
+        std::chrono::duration<double> firstDur {0};
+        std::chrono::duration<double> otherTotalDur {0};
+
+        for (auto i = 0; i < iterCount; ++i) {
+            const auto begin = std::chrono::steady_clock::now();
+
+            yactfr::fromMetadataText(metadata, end);
+
+            const auto dur = std::chrono::duration<double> {
+                std::chrono::steady_clock::now() - begin
+            };
+
+            if (i == 0) {
+                firstDur = dur;
+            } else {
+                otherTotalDur += dur;
+            }
+        }
+
+        const auto otherMeanDur = otherTotalDur.count() / (iterCount - 1);
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "iterations: " << iterCount << '\n' <<
+                     "first:      " << firstDur.count() * 1000000 << " us\n" <<
+                     "mean:       " << otherMeanDur * 1000000 << " us\n" <<
+                     "rate:       " << 1 / otherMeanDur << " opens/s\n";
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
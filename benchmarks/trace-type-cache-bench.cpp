@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+/*
+ * Appends the paths of all the `pass-*` files found recursively within
+ * the directory `dirPath` to `paths`, or only appends `dirPath` if it's
+ * a regular file.
+ */
+void findPassFiles(const std::string& dirPath, std::vector<std::string>& paths)
+{
+    struct stat st;
+
+    if (stat(dirPath.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+        paths.push_back(dirPath);
+        return;
+    }
+
+    const auto dir = opendir(dirPath.c_str());
+
+    if (!dir) {
+        throw std::runtime_error {"Cannot open directory `" + dirPath + "`."};
+    }
+
+    while (const auto entry = readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        const auto path = dirPath + '/' + entry->d_name;
+
+        if (stat(path.c_str(), &st) != 0) {
+            continue;
+        }
+
+        if (S_ISDIR(st.st_mode)) {
+            findPassFiles(path, paths);
+        } else if (S_ISREG(st.st_mode) && std::strncmp(entry->d_name, "pass-", 5) == 0) {
+            paths.push_back(path);
+        }
+    }
+
+    closedir(dir);
+}
+
+/*
+ * Calls `func` `iterCount` times, returning the best duration.
+ */
+template <typename FuncT>
+std::chrono::duration<double> bestDuration(const int iterCount, FuncT&& func)
+{
+    std::chrono::duration<double> bestDur {0};
+
+    for (auto i = 0; i < iterCount; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+
+        func();
+
+        const auto dur = std::chrono::duration<double> {
+            std::chrono::steady_clock::now() - begin
+        };
+
+        if (i == 0 || dur < bestDur) {
+            bestDur = dur;
+        }
+    }
+
+    return bestDur;
+}
+
+} // namespace
+
+/*
+ * Trace type cache benchmark.
+ *
+ * Usage:
+ *
+ *     trace-type-cache-bench PATH [ITERATIONS]
+ *
+ * `PATH` is either a metadata stream file or a directory in which to
+ * find all the `pass-*` metadata stream files recursively (for
+ * example, `tests/tests-metadata-text`).
+ *
+ * Opens all the metadata streams `ITERATIONS` times (default: 10):
+ *
+ * Cold:
+ *     Parses the metadata text (yactfr::fromMetadataText()).
+ *
+ * Warm:
+ *     Loads the trace type from a populated trace type cache
+ *     (yactfr::TraceTypeCache::fromMetadataText()).
+ *
+ * Then prints the best durations and the speedup.
+ */
+int main(const int argc, const char * const argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " PATH [ITERATIONS]\n";
+        return 1;
+    }
+
+    const auto iterCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 10;
+    char cacheDirPath[] = "/tmp/yactfr-trace-type-cache-bench-XXXXXX";
+
+    if (!mkdtemp(cacheDirPath)) {
+        std::cerr << "Cannot create temporary directory.\n";
+        return 1;
+    }
+
+    const yactfr::TraceTypeCache cache {cacheDirPath};
+    auto ret = 0;
+
+    try {
+        std::vector<std::string> paths;
+
+        findPassFiles(argv[1], paths);
+        std::sort(paths.begin(), paths.end());
+
+        if (paths.empty()) {
+            throw std::runtime_error {"No `pass-*` metadata stream file found."};
+        }
+
+        // read all the metadata stream texts once
+        std::vector<std::string> texts;
+
+        for (const auto& path : paths) {
+            std::ifstream file {path, std::ios::binary};
+
+            texts.push_back(yactfr::createMetadataStream(file)->text());
+        }
+
+        // populate the cache
+        for (const auto& text : texts) {
+            cache.fromMetadataText(text);
+        }
+
+        const auto coldDur = bestDuration(iterCount, [&texts] {
+            for (const auto& text : texts) {
+                yactfr::fromMetadataText(text);
+            }
+        });
+
+        const auto warmDur = bestDuration(iterCount, [&texts, &cache] {
+            for (const auto& text : texts) {
+                cache.fromMetadataText(text);
+            }
+        });
+
+        std::cout << std::fixed << std::setprecision(3) <<
+                     "files:      " << texts.size() << '\n' <<
+                     "iterations: " << iterCount << '\n' <<
+                     "cold:       " << coldDur.count() * 1000 << " ms\n" <<
+                     "warm:       " << warmDur.count() * 1000 << " ms\n" <<
+                     "speedup:    " << coldDur.count() / warmDur.count() << "x\n";
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        ret = 1;
+    }
+
+    // remove the cache files and directory
+    if (const auto dir = opendir(cacheDirPath)) {
+        while (const auto entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                std::remove((std::string {cacheDirPath} + '/' + entry->d_name).c_str());
+            }
+        }
+
+        closedir(dir);
+    }
+
+    rmdir(cacheDirPath);
+    return ret;
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+// approximate overhead of a red-black tree node (`std::map`, `std::set`)
+constexpr std::size_t treeNodeOverhead = 32;
+
+// approximate size of the control block of an `std::make_shared()` object
+constexpr std::size_t sharedCtrlBlockSize = 16;
+
+std::size_t strHeapSize(const std::string& str) noexcept
+{
+    // beyond the small string optimization buffer
+    return str.capacity() > 15 ? str.capacity() + 1 : 0;
+}
+
+std::size_t itemSize(const yactfr::Item& item)
+{
+    switch (item.kind()) {
+    case yactfr::ItemKind::Boolean:
+        return sizeof(yactfr::BooleanItem);
+
+    case yactfr::ItemKind::SignedInteger:
+        return sizeof(yactfr::SignedIntegerItem);
+
+    case yactfr::ItemKind::UnsignedInteger:
+        return sizeof(yactfr::UnsignedIntegerItem);
+
+    case yactfr::ItemKind::Real:
+        return sizeof(yactfr::RealItem);
+
+    case yactfr::ItemKind::String:
+        return sizeof(yactfr::StringItem) + strHeapSize(item.asString().value());
+
+    case yactfr::ItemKind::Array:
+    {
+        auto size = sizeof(yactfr::ArrayItem);
+
+        for (const auto& elemItem : item.asArray()) {
+            size += sizeof elemItem + (elemItem ? itemSize(*elemItem) : 0);
+        }
+
+        return size;
+    }
+
+    case yactfr::ItemKind::Map:
+    {
+        auto size = sizeof(yactfr::MapItem);
+
+        for (const auto& keyItemPair : item.asMap()) {
+            size += treeNodeOverhead + sizeof keyItemPair + strHeapSize(keyItemPair.first) +
+                    (keyItemPair.second ? itemSize(*keyItemPair.second) : 0);
+        }
+
+        return size;
+    }
+
+    default:
+        std::abort();
+    }
+}
+
+template <typename RangeSetT>
+std::size_t rangeSetSize(const RangeSetT& rangeSet)
+{
+    return sharedCtrlBlockSize + sizeof rangeSet.ranges() +
+           rangeSet.ranges().size() * (treeNodeOverhead + sizeof(typename RangeSetT::Range));
+}
+
+template <typename MappingsT>
+std::size_t mappingsSize(const MappingsT& mappings)
+{
+    auto size = sharedCtrlBlockSize + sizeof mappings;
+
+    for (const auto& nameRangeSetPair : mappings) {
+        size += treeNodeOverhead + sizeof nameRangeSetPair +
+                strHeapSize(nameRangeSetPair.first) + rangeSetSize(nameRangeSetPair.second);
+    }
+
+    return size;
+}
+
+/*
+ * Statistics of one kind of data type content.
+ */
+struct ContentStats final
+{
+    /*
+     * Accounts the content at `addr` of which the approximate size is
+     * `size`.
+     */
+    void account(const void * const addr, const std::size_t size)
+    {
+        ++refCount;
+        unsharedSize += size;
+
+        if (distinctAddrs.insert(addr).second) {
+            sharedSize += size;
+        }
+    }
+
+    // number of data types/members/options which refer to a content
+    std::size_t refCount = 0;
+
+    // distinct contents
+    std::unordered_set<const void *> distinctAddrs;
+
+    // approximate total size if each referrer had its own copy
+    std::size_t unsharedSize = 0;
+
+    // approximate total size of the distinct contents
+    std::size_t sharedSize = 0;
+};
+
+/*
+ * Accounts the content of the visited data types.
+ */
+class ContentStatsDtVisitor final :
+    public yactfr::DataTypeVisitor
+{
+public:
+    void visit(const yactfr::FixedLengthBitArrayType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::FixedLengthBitMapType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::FixedLengthBooleanType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::FixedLengthSignedIntegerType& dt) override
+    {
+        this->_visitIntType(dt);
+    }
+
+    void visit(const yactfr::FixedLengthUnsignedIntegerType& dt) override
+    {
+        this->_visitIntType(dt);
+    }
+
+    void visit(const yactfr::FixedLengthFloatingPointNumberType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::VariableLengthSignedIntegerType& dt) override
+    {
+        this->_visitIntType(dt);
+    }
+
+    void visit(const yactfr::VariableLengthUnsignedIntegerType& dt) override
+    {
+        this->_visitIntType(dt);
+    }
+
+    void visit(const yactfr::NullTerminatedStringType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::StructureType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+
+        for (const auto& memberType : dt) {
+            this->_accountAttrs(memberType->attributes());
+            memberType->dataType().accept(*this);
+        }
+    }
+
+    void visit(const yactfr::StaticLengthArrayType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+        dt.elementType().accept(*this);
+    }
+
+    void visit(const yactfr::DynamicLengthArrayType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+        dt.elementType().accept(*this);
+    }
+
+    void visit(const yactfr::StaticLengthStringType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::DynamicLengthStringType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::StaticLengthBlobType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::DynamicLengthBlobType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+    }
+
+    void visit(const yactfr::VariantWithUnsignedIntegerSelectorType& dt) override
+    {
+        this->_visitVarType(dt);
+    }
+
+    void visit(const yactfr::VariantWithSignedIntegerSelectorType& dt) override
+    {
+        this->_visitVarType(dt);
+    }
+
+    void visit(const yactfr::OptionalWithBooleanSelectorType& dt) override
+    {
+        this->_accountAttrs(dt.attributes());
+        dt.dataType().accept(*this);
+    }
+
+    void visit(const yactfr::OptionalWithUnsignedIntegerSelectorType& dt) override
+    {
+        this->_visitOptIntSelType(dt);
+    }
+
+    void visit(const yactfr::OptionalWithSignedIntegerSelectorType& dt) override
+    {
+        this->_visitOptIntSelType(dt);
+    }
+
+    const ContentStats& attrStats() const noexcept
+    {
+        return _attrStats;
+    }
+
+    const ContentStats& mappingsStats() const noexcept
+    {
+        return _mappingsStats;
+    }
+
+    const ContentStats& rangeSetStats() const noexcept
+    {
+        return _rangeSetStats;
+    }
+
+    std::size_t dtCount() const noexcept
+    {
+        return _dtCount;
+    }
+
+private:
+    void _accountAttrs(const yactfr::MapItem * const attrs)
+    {
+        ++_dtCount;
+
+        if (attrs) {
+            _attrStats.account(attrs, itemSize(*attrs));
+        }
+    }
+
+    template <typename IntTypeT>
+    void _visitIntType(const IntTypeT& dt)
+    {
+        this->_accountAttrs(dt.attributes());
+        _mappingsStats.account(&dt.mappings(), mappingsSize(dt.mappings()));
+    }
+
+    template <typename RangeSetT>
+    void _accountRangeSet(const RangeSetT& rangeSet)
+    {
+        _rangeSetStats.account(&rangeSet.ranges(), rangeSetSize(rangeSet));
+    }
+
+    template <typename VarTypeT>
+    void _visitVarType(const VarTypeT& dt)
+    {
+        this->_accountAttrs(dt.attributes());
+
+        for (const auto& opt : dt) {
+            if (opt->attributes()) {
+                _attrStats.account(opt->attributes(), itemSize(*opt->attributes()));
+            }
+
+            this->_accountRangeSet(opt->selectorRanges());
+            opt->dataType().accept(*this);
+        }
+    }
+
+    template <typename OptTypeT>
+    void _visitOptIntSelType(const OptTypeT& dt)
+    {
+        this->_accountAttrs(dt.attributes());
+        this->_accountRangeSet(dt.selectorRanges());
+        dt.dataType().accept(*this);
+    }
+
+private:
+    ContentStats _attrStats;
+    ContentStats _mappingsStats;
+    ContentStats _rangeSetStats;
+    std::size_t _dtCount = 0;
+};
+
+void printStats(const char * const title, const ContentStats& stats)
+{
+    std::cout << title << '\n' <<
+                 "  references:    " << stats.refCount << '\n' <<
+                 "  distinct:      " << stats.distinctAddrs.size() << '\n' <<
+                 "  unshared size: " << stats.unsharedSize << " B\n" <<
+                 "  shared size:   " << stats.sharedSize << " B\n";
+}
+
+} // namespace
+
+/*
+ * Trace type memory report.
+ *
+ * Usage:
+ *
+ *     trace-type-mem-report PATH
+ *
+ * Parses the metadata stream file `PATH` (TSDL or CTF 2, plain text or
+ * packetized) and prints, for each kind of data type content which
+ * equal data types of a trace type share (attributes, integer type
+ * mappings, and selector integer range sets), the number of references,
+ * the number of distinct contents, and the approximate sizes without
+ * and with sharing.
+ */
+int main(const int argc, const char * const argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " PATH\n";
+        return 1;
+    }
+
+    try {
+        std::ifstream file {argv[1], std::ios::binary};
+        const auto metadataStream = yactfr::createMetadataStream(file);
+        const auto traceType = yactfr::fromMetadataText(metadataStream->text()).first;
+        ContentStatsDtVisitor visitor;
+        const auto acceptIfSet = [&visitor](const yactfr::DataType * const dt) {
+            if (dt) {
+                dt->accept(visitor);
+            }
+        };
+
+        acceptIfSet(traceType->packetHeaderType());
+
+        for (const auto& dst : traceType->dataStreamTypes()) {
+            acceptIfSet(dst->packetContextType());
+            acceptIfSet(dst->eventRecordHeaderType());
+            acceptIfSet(dst->eventRecordCommonContextType());
+
+            for (const auto& ert : dst->eventRecordTypes()) {
+                acceptIfSet(ert->specificContextType());
+                acceptIfSet(ert->payloadType());
+            }
+        }
+
+        const auto unsharedSize = visitor.attrStats().unsharedSize +
+                                  visitor.mappingsStats().unsharedSize +
+                                  visitor.rangeSetStats().unsharedSize;
+        const auto sharedSize = visitor.attrStats().sharedSize +
+                                visitor.mappingsStats().sharedSize +
+                                visitor.rangeSetStats().sharedSize;
+
+        std::cout << "data types: " << visitor.dtCount() << "\n\n";
+        printStats("Attributes:", visitor.attrStats());
+        printStats("Integer type mappings:", visitor.mappingsStats());
+        printStats("Selector integer range sets:", visitor.rangeSetStats());
+        std::cout << std::fixed << std::setprecision(1) <<
+                     "\nTotal:\n" <<
+                     "  unshared size: " << unsharedSize << " B\n" <<
+                     "  shared size:   " << sharedSize << " B\n" <<
+                     "  saved:         " << unsharedSize - sharedSize << " B (" <<
+                     (unsharedSize == 0 ? 0. :
+                      100. * (unsharedSize - sharedSize) / unsharedSize) << " %)\n";
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -95,6 +95,78 @@ public:
     */
     boost::optional<DataBlock> data(Index offset, Size minimumSize);
 
+    /*!
+    @brief
+        Like data(), but sets \p isAvailable to \c false and returns
+        \c boost::none instead of throwing DataNotAvailable.
+
+    This method, on success, <strong>invalidates the last returned
+    \link DataBlock data block\endlink</strong>, if any.
+
+    When this method sets \p isAvailable to \c false, you should call
+    it again later with the same parameter values, exactly like when
+    data() throws DataNotAvailable.
+
+    @param[in] offset
+        Offset at which to get data from this source. This
+        value does not need to be aligned in any special way.
+    @param[in] minimumSize
+        Minimum size of the data block to get (bytes).
+    @param[out] isAvailable
+        Set to \c false if the requested minimum number of bytes
+        (\p minimumSize) at the requested offset (\p offset) is not
+        available now, or to \c true otherwise.
+
+    @returns
+        Data block, which remains valid until this method or data() is
+        called again or until this source is destroyed, or
+        \c boost::none if there's no data at offset \p offset or if
+        the data is not available now (see \p isAvailable).
+
+    @pre
+        \p minimumSize ≤ 9.
+
+    @post
+        On success, the last returned
+        \link DataBlock data block\endlink, if any, is invalidated.
+    */
+    boost::optional<DataBlock> tryData(Index offset, Size minimumSize, bool& isAvailable);
+
+    /*!
+    @brief
+        Indicates to this data source that its user won't need the data
+        before the offset \p offset anymore.
+
+    An element sequence iterator calls this method when it reaches the
+    end of a packet.
+
+    This is only a hint: a data source may use it to release resources
+    (memory, page cache, and the rest) associated to data before
+    \p offset. It's still valid to request data before \p offset
+    afterwards (after restoring an iterator position, for example).
+
+    This method doesn't invalidate the last returned
+    \link DataBlock data block\endlink, if any.
+
+    @param[in] offset
+        Offset before which the user of this source won't need data
+        anymore. This value does not need to be aligned in any special
+        way.
+    */
+    void releaseDataBefore(Index offset) noexcept;
+
+    /*!
+    @brief
+        Returns whether or not many element sequence iterators may
+        share this data source (see
+        ElementSequence::iteratorCopiesShareDataSource()).
+
+    @returns
+        \c true if many element sequence iterators may share this data
+        source.
+    */
+    bool isShareable() const noexcept;
+
 private:
     /*!
     @brief
@@ -149,6 +221,78 @@ private:
         later.
     */
     virtual boost::optional<DataBlock> _data(Index offset, Size minimumSize) = 0;
+
+    /*!
+    @brief
+        Like _data(), but sets \p isAvailable to \c false and returns
+        \c boost::none instead of throwing DataNotAvailable (user
+        implementation).
+
+    The default implementation calls _data() and catches
+    DataNotAvailable. Override this method if your data source can
+    know that data is not available now without throwing: this is
+    what makes ElementSequenceIterator::tryAdvance() exception-free.
+
+    @param[in] offset
+        Offset at which to get data from this source. There
+        is not guarantee that this value is aligned in any way.
+    @param[in] minimumSize
+        Minimum size of the data block to return (bytes).
+    @param[out] isAvailable
+        Set to \c false if the requested minimum number of bytes
+        (\p minimumSize) at the requested offset (\p offset) is not
+        available now, or to \c true otherwise.
+
+    @returns
+        Data block, which \em must remain valid until this method or
+        _data() is called again and until this source is destroyed, or
+        \c boost::none to indicate that there's no data at offset \p
+        offset or that the data is not available now (see
+        \p isAvailable).
+
+    @pre
+        \p minimumSize ≤ 9.
+    */
+    virtual boost::optional<DataBlock> _tryData(Index offset, Size minimumSize, bool& isAvailable);
+
+    /*!
+    @brief
+        Indicates to this data source that its user won't need the data
+        before the offset \p offset anymore (user implementation).
+
+    The default implementation does nothing.
+
+    This method <strong>must not</strong> invalidate the last returned
+    \link DataBlock data block\endlink, if any: the data block
+    part after \p offset must remain valid.
+
+    @param[in] offset
+        Offset before which the user of this source won't need data
+        anymore. There is no guarantee that this value is aligned in
+        any way.
+    */
+    virtual void _releaseDataBefore(Index offset) noexcept;
+
+    /*!
+    @brief
+        Returns whether or not many element sequence iterators may
+        share this data source (user implementation).
+
+    Iterators sharing a data source request data blocks in turns, each
+    one at its own offsets: the requested offsets of the data source
+    don't increase monotonically anymore.
+
+    The default implementation returns \c true. Override this method
+    to return \c false if your data source can't provide data at an
+    offset which it already provided data after (because it forgets
+    consumed data, for example): the copies of an iterator then get
+    their own data source.
+
+    @returns
+        \c true if many element sequence iterators may share this data
+        source.
+    */
+    virtual bool _isShareable() const noexcept;
 };
 
 } // namespace yactfr
@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_ELEM_SEQ_IT_CHECKPOINT_HPP
+#define YACTFR_ELEM_SEQ_IT_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "aliases.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class Vm;
+
+} // namespace internal
+
+/*!
+@brief
+    Invalid element sequence iterator checkpoint error.
+
+@ingroup element_seq
+
+An instance is thrown when the data of an
+ElementSequenceIteratorCheckpoint object isn't valid, or doesn't match
+the trace type of the iterator which restores it.
+*/
+class InvalidElementSequenceIteratorCheckpoint final :
+    public std::runtime_error
+{
+public:
+    explicit InvalidElementSequenceIteratorCheckpoint(std::string message) :
+        std::runtime_error {std::move(message)}
+    {
+    }
+};
+
+/*!
+@brief
+    Element sequence iterator checkpoint.
+
+@ingroup element_seq
+
+An element sequence iterator checkpoint is a compact, serializable
+alternative to ElementSequenceIteratorPosition: instead of a copy of the
+whole state of an ElementSequenceIterator object, it only contains what
+the iterator needs to reconstruct its position:
+
+- The offset of the current packet.
+- The offset and state of the beginning of the current event record,
+  if any: data stream type ID, expected packet lengths, saved
+  lengths/selectors, and default clock value.
+- The index of the current element within its packet.
+
+Its data (data()) is typically a few dozen bytes which you may write
+to a file, and then use with
+ElementSequenceIteratorCheckpoint(Data) in another process to restore
+the position of an iterator created from an element sequence having
+the same data and an equivalent trace type (same metadata).
+
+Call ElementSequenceIterator::saveCheckpoint() to set an
+ElementSequenceIteratorCheckpoint object and
+ElementSequenceIterator::restoreCheckpoint() to restore a position.
+Restoring a checkpoint decodes again the current event record up to
+the current element (or the current packet up to the current element
+if the current element precedes the first event record).
+*/
+class ElementSequenceIteratorCheckpoint final
+{
+    friend class internal::Vm;
+
+public:
+    /// Checkpoint data.
+    using Data = std::vector<std::uint8_t>;
+
+public:
+    /*!
+    @brief
+        Creates an empty element sequence iterator checkpoint.
+
+    Call ElementSequenceIterator::saveCheckpoint() with this object
+    before restoring the position of an iterator with
+    ElementSequenceIterator::restoreCheckpoint().
+    */
+    explicit ElementSequenceIteratorCheckpoint() = default;
+
+    /*!
+    @brief
+        Creates an element sequence iterator checkpoint from the data
+        \p data of another checkpoint.
+
+    @param[in] data
+        Data of another element sequence iterator checkpoint
+        (data()), possibly from another process.
+
+    @throws InvalidElementSequenceIteratorCheckpoint
+        \p data isn't valid checkpoint data.
+    */
+    explicit ElementSequenceIteratorCheckpoint(Data data);
+
+    /// Default copy constructor.
+    ElementSequenceIteratorCheckpoint(const ElementSequenceIteratorCheckpoint&) = default;
+
+    /// Default move constructor.
+    ElementSequenceIteratorCheckpoint(ElementSequenceIteratorCheckpoint&&) = default;
+
+    /// Default copy assignment operator.
+    ElementSequenceIteratorCheckpoint& operator=(const ElementSequenceIteratorCheckpoint&) = default;
+
+    /// Default move assignment operator.
+    ElementSequenceIteratorCheckpoint& operator=(ElementSequenceIteratorCheckpoint&&) = default;
+
+    /*!
+    @brief
+        Data of this element sequence iterator checkpoint, empty if
+        this checkpoint is empty.
+
+    @returns
+        Data of this checkpoint.
+    */
+    const Data& data() const noexcept
+    {
+        return _data;
+    }
+
+    /*!
+    @brief
+        Offset (bits) of the element of this checkpoint within its
+        element sequence.
+
+    @returns
+        Offset of the element of this checkpoint.
+
+    @pre
+        This checkpoint is not empty.
+    */
+    Index offset() const noexcept
+    {
+        return _offset;
+    }
+
+    /*!
+    @brief
+        Returns whether or not this element sequence iterator
+        checkpoint is \em empty.
+
+    It's not possible to call
+    ElementSequenceIterator::restoreCheckpoint() with an empty
+    checkpoint.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is
+        \em not empty.
+    */
+    operator bool() const noexcept
+    {
+        return !_data.empty();
+    }
+
+    /*!
+    @brief
+        Equality operator.
+
+    @param[in] other
+        Element sequence iterator checkpoint to compare to.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is equal
+        to \p other.
+
+    @pre
+        This element sequence iterator checkpoint and \p other \em must
+        have been set (ElementSequenceIterator::saveCheckpoint()) by
+        iterators created from element sequences having the same data.
+    */
+    bool operator==(const ElementSequenceIteratorCheckpoint& other) const noexcept
+    {
+        return _offset == other._offset && _mark == other._mark;
+    }
+
+    /*!
+    @brief
+        Non-equality operator.
+
+    @param[in] other
+        Element sequence iterator checkpoint to compare to.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is \em not
+        equal to \p other.
+
+    @pre
+        Same as operator==().
+    */
+    bool operator!=(const ElementSequenceIteratorCheckpoint& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    /*!
+    @brief
+        Less-than operator.
+
+    @param[in] other
+        Element sequence iterator checkpoint to compare to.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is before
+        \p other.
+
+    @pre
+        Same as operator==().
+    */
+    bool operator<(const ElementSequenceIteratorCheckpoint& other) const noexcept
+    {
+        return _offset < other._offset || (_offset == other._offset && _mark < other._mark);
+    }
+
+    /*!
+    @brief
+        Less-than or equality operator.
+
+    @param[in] other
+        Element sequence iterator checkpoint to compare to.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is before
+        or equal to \p other.
+
+    @pre
+        Same as operator==().
+    */
+    bool operator<=(const ElementSequenceIteratorCheckpoint& other) const noexcept
+    {
+        return !(other < *this);
+    }
+
+    /*!
+    @brief
+        Greater-than operator.
+
+    @param[in] other
+        Element sequence iterator checkpoint to compare to.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is after
+        \p other.
+
+    @pre
+        Same as operator==().
+    */
+    bool operator>(const ElementSequenceIteratorCheckpoint& other) const noexcept
+    {
+        return other < *this;
+    }
+
+    /*!
+    @brief
+        Greater-than or equality operator.
+
+    @param[in] other
+        Element sequence iterator checkpoint to compare to.
+
+    @returns
+        \c true if this element sequence iterator checkpoint is after
+        or equal to \p other.
+
+    @pre
+        Same as operator==().
+    */
+    bool operator>=(const ElementSequenceIteratorCheckpoint& other) const noexcept
+    {
+        return !(*this < other);
+    }
+
+private:
+    Data _data;
+
+    // offset (bits) of the element within its element sequence
+    Index _offset = 0;
+
+    // mark of the element within its packet
+    Index _mark = 0;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_ELEM_SEQ_IT_CHECKPOINT_HPP
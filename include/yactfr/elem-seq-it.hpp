@@ -10,10 +10,13 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <boost/optional/optional.hpp>
 
 #include "elem-seq-it-pos.hpp"
+#include "elem-seq-it-checkpoint.hpp"
 #include "aliases.hpp"
 
 namespace yactfr {
@@ -24,7 +27,10 @@ class Vm;
 } // namespace internal
 
 class Element;
+class EventRecordRowLayout;
+class FieldHandle;
 class DataSourceFactory;
+class ElementSequenceMetrics;
 class TraceType;
 
 /*!
@@ -49,9 +55,29 @@ public:
     using pointer = const Element *;
     using iterator_category = std::input_iterator_tag;
 
+    /*!
+    @brief
+        Result of tryAdvance().
+    */
+    enum class AdvanceResult {
+        /// The iterator advanced to a new element.
+        Element,
+
+        /// The iterator reached the end of its element sequence.
+        End,
+
+        /*!
+        Data is not available now from the data source: the iterator
+        didn't move; try again later.
+        */
+        DataNotAvailable,
+    };
+
 private:
     explicit ElementSequenceIterator(DataSourceFactory& dataSrcFactory,
-                                     const TraceType& traceType, bool end);
+                                     const TraceType& traceType, bool end,
+                                     bool copiesShareDataSrc,
+                                     ElementSequenceMetrics *metrics);
 
 private:
     static const Index _endOffset;
@@ -62,10 +88,12 @@ public:
         Copy constructor.
 
     The created element sequence iterator creates a new data source from
-    the data source factory of its element sequence. See savePosition()
-    and restorePosition() for an alternative which can save and restore
-    element sequence iterator positions without creating new data
-    sources.
+    the data source factory of its element sequence, unless the copies
+    of the iterators of this element sequence share their data source
+    (see ElementSequence::iteratorCopiesShareDataSource()). See
+    savePosition() and restorePosition() for an alternative which can
+    save and restore element sequence iterator positions without
+    creating new data sources.
 
     @param[in] other
         Element sequence iterator to copy.
@@ -106,11 +134,13 @@ public:
     @brief
         Sets this element sequence iterator to a copy of \p other.
 
-    This element sequence iterator creates a new data source from the
-    data source factory of its element sequence. See savePosition() and
-    restorePosition() for an alternative which can save and restore
-    element sequence iterator positions without creating new data
-    sources.
+    This element sequence iterator keeps its own data source, or shares
+    the one of \p other if the copies of the iterators of this element
+    sequence share their data source (see
+    ElementSequence::iteratorCopiesShareDataSource()). See
+    savePosition() and restorePosition() for an alternative which can
+    save and restore element sequence iterator positions without
+    creating new data sources.
 
     @param[in] other
         Other element sequence iterator to copy.
@@ -173,6 +203,44 @@ public:
     */
     ElementSequenceIterator& operator++();
 
+    /*!
+    @brief
+        Tries to advance this element sequence iterator to the next
+        element, returning AdvanceResult::DataNotAvailable instead of
+        throwing DataNotAvailable if the data source doesn't have the
+        required data now.
+
+    This is the same as operator++(), except for how this method
+    reports that data is not available now. When this method returns
+    AdvanceResult::DataNotAvailable:
+
+    - This iterator didn't move: its current element remains valid.
+    - Calling this method or operator++() again later continues
+      exactly where the iterator stopped.
+
+    This method doesn't throw to report that data is not available
+    now, as long as the data source implements the non-throwing
+    DataSource::tryData() hook (the memory mapped file views of
+    MemoryMappedFileViewFactory do). This makes it suitable to follow
+    live data streams.
+
+    @returns
+        Result of the operation.
+
+    @post
+        If this method returns AdvanceResult::Element or
+        AdvanceResult::End, the current element of this iterator is
+        invalidated.
+
+    @throws ?
+        Any exception that the data source can throw when getting a new
+        data block.
+    @throws DecodingError
+        Any derived decoding error (see decoding-errors.hpp): advancing
+        led to a decoding error.
+    */
+    AdvanceResult tryAdvance();
+
     /*!
     @brief
         Returns the current element of this element sequence iterator.
@@ -295,6 +363,152 @@ public:
     */
     void restorePosition(const ElementSequenceIteratorPosition& pos);
 
+    /*!
+    @brief
+        Saves the position of this element sequence iterator
+        into the compact checkpoint \p checkpoint.
+
+    Contrary to savePosition(), this method doesn't copy the whole
+    state of this iterator: \p checkpoint only contains what's needed
+    to reconstruct its position (see ElementSequenceIteratorCheckpoint),
+    and you may serialize it (ElementSequenceIteratorCheckpoint::data())
+    to restore the position in another process.
+
+    This method reuses the data buffer of \p checkpoint, if any.
+
+    @param[in] checkpoint
+        Checkpoint to set.
+
+    @pre
+        This iterator is not equal to ElementSequence::end() on the
+        element sequence which created this iterator.
+    */
+    void saveCheckpoint(ElementSequenceIteratorCheckpoint& checkpoint) const;
+
+    /*!
+    @brief
+        Restores the position of this element sequence iterator from
+        the checkpoint \p checkpoint.
+
+    This method decodes the current event record of \p checkpoint
+    again, up to its element (or its packet, up to its element, if the
+    element precedes the first event record of the packet).
+
+    @param[in] checkpoint
+        Checkpoint to use to restore the position of this iterator.
+
+    @pre
+        \p checkpoint is not empty.
+    @pre
+        \p checkpoint was set with saveCheckpoint() by an iterator
+        created from an element sequence having the same data and an
+        equivalent trace type.
+
+    @throws InvalidElementSequenceIteratorCheckpoint
+        \p checkpoint doesn't match the trace type or data of this
+        iterator.
+    @throws ?
+        Any exception that the data source can throw when getting a new
+        data block.
+    @throws DataNotAvailable
+        Data is not available now from the data source: try again later.
+    @throws DecodingError
+        Any decoding error.
+    */
+    void restoreCheckpoint(const ElementSequenceIteratorCheckpoint& checkpoint);
+
+    /*!
+    @brief
+        Row layout of the current event record, or \c nullptr if
+        this iterator isn't within an event record or if the fields of
+        its type don't have a static layout.
+
+    @pre
+        This iterator is not equal to ElementSequence::end() on the
+        element sequence which created this iterator.
+
+    @sa readEventRecordRow()
+    */
+    const EventRecordRowLayout *eventRecordRowLayout() const noexcept;
+
+    /*!
+    @brief
+        Reads the fields of the current event record to the row
+        \p row, as described by eventRecordRowLayout(), and advances
+        this iterator to its EventRecordEndElement.
+
+    Use this method, instead of iterating the elements of the specific
+    context and payload of an event record, to get all its fields as
+    native values at once: when all of them are byte-aligned within
+    the current data block, this method doesn't create any intermediate
+    element.
+
+    If this method throws, then the contents of \p row are unspecified
+    and this iterator is somewhere within the current event record:
+    you may keep incrementing it.
+
+    @param[in] row
+        Row to fill, of at least
+        <code>eventRecordRowLayout()->size()</code> bytes and aligned
+        to <code>eventRecordRowLayout()->alignment()</code> bytes.
+
+    @pre
+        The current element is an EventRecordInfoElement.
+    @pre
+        eventRecordRowLayout() isn't \c nullptr.
+
+    @throws ?
+        Any exception that the data source can throw when getting a new
+        data block.
+    @throws DataNotAvailable
+        Data is not available now from the data source: try again later.
+    @throws DecodingError
+        Any decoding error.
+    */
+    void readEventRecordRow(void *row);
+
+    /*!
+    @brief
+        Last decoded value, within the current packet, of the field
+        which \p fieldHandle targets, or \c boost::none if this
+        iterator didn't decode it yet within the current packet.
+
+    The returned value is the raw value of the field:
+
+    <dl>
+      <dt>Fixed-length boolean</dt>
+      <dd>Not zero means true.</dd>
+
+      <dt>Unsigned integer</dt>
+      <dd>Value.</dd>
+
+      <dt>Signed integer</dt>
+      <dd>Value, as a two's complement \c std::uint64_t.</dd>
+    </dl>
+
+    This method always returns \c boost::none when this iterator was
+    created before \p fieldHandle.
+
+    After seekPacket() or restoreCheckpoint(), this method returns
+    \c boost::none for the fields of the current packet which this
+    iterator didn't decode again.
+
+    @param[in] fieldHandle
+        Handle of the field of which to get the last decoded value.
+
+    @returns
+        Last decoded value of the field which \p fieldHandle targets,
+        or \c boost::none if not available.
+
+    @pre
+        This iterator is not equal to ElementSequence::end() on the
+        element sequence which created this iterator.
+    @pre
+        \p fieldHandle belongs to the trace type of the element
+        sequence which created this iterator.
+    */
+    boost::optional<std::uint64_t> fieldValue(const FieldHandle& fieldHandle) const noexcept;
+
     /*!
     @brief
         Equality operator.
@@ -429,11 +643,28 @@ public:
     }
 
 private:
+    // type of the function which _decode() calls for each element
+    using _tSinkFunc = void (*)(void *, const Element&);
+
     void _resetOther(ElementSequenceIterator& other);
 
+    /*
+     * Decodes the rest of the element sequence, calling `sinkFunc`
+     * with `sink` and each element, and then makes this iterator an
+     * end iterator.
+     */
+    void _decode(_tSinkFunc sinkFunc, void *sink);
+
 private:
     DataSourceFactory *_dataSrcFactory;
     const TraceType *_traceType;
+
+    // whether or not the copies of this iterator share its data source
+    bool _copiesShareDataSrc;
+
+    // decoding metrics to update, or `nullptr` if none
+    ElementSequenceMetrics *_metrics;
+
     std::unique_ptr<internal::Vm> _vm;
 
     // current element
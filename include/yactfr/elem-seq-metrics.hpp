@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_ELEM_SEQ_METRICS_HPP
+#define YACTFR_ELEM_SEQ_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <boost/noncopyable.hpp>
+
+#include "metadata/fwd.hpp"
+#include "aliases.hpp"
+#include "elem.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class Vm;
+
+} // namespace internal
+
+/*!
+@brief
+    Element sequence decoding metrics.
+
+@ingroup element_seq
+
+Element sequence decoding metrics are counters which the
+\link ElementSequenceIterator element sequence iterators\endlink of an
+element sequence update while decoding when you set them with
+ElementSequence::metrics():
+
+- Number of bytes and of packets which the iterators decoded.
+
+- Number of event records, per event record type and per data stream
+  type.
+
+- Number of elements, per element kind.
+
+- Decoding time of one event record out of samplingPeriod() event
+  records, per event record type.
+
+- Histogram of the durations of one
+  ElementSequenceIterator::operator++() call out of samplingPeriod()
+  calls.
+
+All the accessors of this object are lock-free: you may read them from
+another thread while iterators update them. Several iterators, on
+different threads, may also update the same metrics object.
+
+Decoding metrics are only available if the yactfr library was built
+with them (\c -DOPT_METRICS=YES, not the default), in which case
+isSupported() returns \c true. Otherwise, iterators never update
+metrics and there's no decoding overhead at all.
+*/
+class ElementSequenceMetrics final :
+    boost::noncopyable
+{
+    friend class internal::Vm;
+
+public:
+    /*!
+    @brief
+        Number of buckets of the histogram of the durations of
+        ElementSequenceIterator::operator++() calls (see
+        incrementDurationCount()).
+    */
+    static constexpr Size incrementDurationHistogramSize = 32;
+
+    /// Metrics of a single event record type.
+    class EventRecordTypeMetrics final :
+        boost::noncopyable
+    {
+        friend class ElementSequenceMetrics;
+
+    private:
+        explicit EventRecordTypeMetrics() = default;
+
+    public:
+        /// Number of decoded event records of this type.
+        unsigned long long count() const noexcept
+        {
+            return _count.load(std::memory_order_relaxed);
+        }
+
+        /// Number of sampled event records of this type.
+        unsigned long long sampledCount() const noexcept
+        {
+            return _sampledCount.load(std::memory_order_relaxed);
+        }
+
+        /*!
+        @brief
+            Total decoding time of the sampled event records of this
+            type.
+
+        The mean decoding time of an event record of this type is
+        <code>sampledDuration() / sampledCount()</code>.
+        */
+        std::chrono::nanoseconds sampledDuration() const noexcept
+        {
+            return std::chrono::nanoseconds {_sampledDurNs.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        void _reset() noexcept;
+
+    private:
+        std::atomic<unsigned long long> _count {0};
+        std::atomic<unsigned long long> _sampledCount {0};
+        std::atomic<unsigned long long> _sampledDurNs {0};
+    };
+
+public:
+    /*!
+    @brief
+        Builds element sequence decoding metrics for the data streams
+        which \p traceType describes, sampling one event record and
+        one ElementSequenceIterator::operator++() call out of
+        \p samplingPeriod.
+
+    Those metrics only have per event record type and per data stream
+    type counters for the event record types and data stream types
+    which \p traceType contains when you call this constructor.
+
+    \p traceType must exist as long as those metrics exist.
+
+    @param[in] traceType
+        Trace type which describes the data streams to measure.
+    @param[in] samplingPeriod
+        Sampling period of the measured durations.
+
+    @pre
+        \p samplingPeriod ≥ 1.
+    */
+    explicit ElementSequenceMetrics(const TraceType& traceType, unsigned int samplingPeriod = 64);
+
+    /*!
+    @brief
+        Whether or not the yactfr library supports decoding metrics.
+
+    If this method returns \c false, then the counters of any
+    element sequence metrics object remain zero.
+    */
+    static bool isSupported() noexcept;
+
+    /// Trace type of those metrics.
+    const TraceType& traceType() const noexcept
+    {
+        return *_traceType;
+    }
+
+    /// Sampling period.
+    unsigned int samplingPeriod() const noexcept
+    {
+        return _samplingPeriod;
+    }
+
+    /*!
+    @brief
+        Number of bytes of the packets which iterators decoded
+        completely.
+    */
+    unsigned long long byteCount() const noexcept
+    {
+        return _byteCount.load(std::memory_order_relaxed);
+    }
+
+    /// Number of packets which iterators decoded completely.
+    unsigned long long packetCount() const noexcept
+    {
+        return _pktCount.load(std::memory_order_relaxed);
+    }
+
+    /// Number of decoded event records.
+    unsigned long long eventRecordCount() const noexcept
+    {
+        return _erCount.load(std::memory_order_relaxed);
+    }
+
+    /*!
+    @brief
+        Number of decoded event records of which the type is part of
+        \p dataStreamType.
+
+    @param[in] dataStreamType
+        Data stream type of the event records to count.
+
+    @returns
+        Number of decoded event records of which the type is part of
+        \p dataStreamType, or 0 if \p dataStreamType wasn't part of
+        traceType() when building those metrics.
+    */
+    unsigned long long eventRecordCount(const DataStreamType& dataStreamType) const noexcept;
+
+    /*!
+    @brief
+        Metrics of the event record type \p eventRecordType, or
+        \c nullptr if \p eventRecordType wasn't part of traceType()
+        when building those metrics.
+
+    @param[in] eventRecordType
+        Event record type of which to get the metrics.
+
+    @returns
+        Metrics of \p eventRecordType, or \c nullptr if none.
+    */
+    const EventRecordTypeMetrics *eventRecordTypeMetrics(const EventRecordType& eventRecordType) const noexcept;
+
+    /*!
+    @brief
+        Number of elements of kind \p kind which iterators provided.
+
+    @param[in] kind
+        Kind of the elements to count.
+
+    @returns
+        Number of elements of kind \p kind which iterators provided.
+    */
+    unsigned long long elementCount(Element::Kind kind) const noexcept;
+
+    /*!
+    @brief
+        Number of measured ElementSequenceIterator::operator++() calls
+        which lasted \f$[2^{index}, 2^{index + 1})\f$ nanoseconds
+        (less than 2 nanoseconds for the index 0).
+
+    @param[in] index
+        Index of the histogram bucket.
+
+    @returns
+        Number of measured ElementSequenceIterator::operator++() calls
+        of the histogram bucket \p index.
+
+    @pre
+        \p index < #incrementDurationHistogramSize
+    */
+    unsigned long long incrementDurationCount(Index index) const noexcept
+    {
+        return _incrDurCounts[index].load(std::memory_order_relaxed);
+    }
+
+    /*!
+    @brief
+        Resets all the counters of those metrics to zero.
+
+    Calling this method while iterators update those metrics is safe,
+    but some counters could then reflect increments which occurred
+    before the reset.
+    */
+    void reset() noexcept;
+
+private:
+    static constexpr Size _elemKindCount = 49;
+
+    void _countElem(Element::Kind kind) noexcept;
+    void _countPkt(Size byteCount) noexcept;
+    void _countEr(const EventRecordType& ert) noexcept;
+    void _addSampledErDur(const EventRecordType& ert, std::chrono::nanoseconds dur) noexcept;
+    void _addIncrDur(std::chrono::nanoseconds dur) noexcept;
+
+    static void _add(std::atomic<unsigned long long>& counter,
+                     const unsigned long long val = 1) noexcept
+    {
+        counter.fetch_add(val, std::memory_order_relaxed);
+    }
+
+private:
+    const TraceType *_traceType;
+    const unsigned int _samplingPeriod;
+    std::atomic<unsigned long long> _byteCount {0};
+    std::atomic<unsigned long long> _pktCount {0};
+    std::atomic<unsigned long long> _erCount {0};
+    std::array<std::atomic<unsigned long long>, _elemKindCount> _elemCounts;
+    std::array<std::atomic<unsigned long long>, incrementDurationHistogramSize> _incrDurCounts;
+
+    // built once: lock-free lookups afterwards
+    std::unordered_map<const DataStreamType *,
+                       std::unique_ptr<std::atomic<unsigned long long>>> _dstErCounts;
+    std::unordered_map<const EventRecordType *,
+                       std::unique_ptr<EventRecordTypeMetrics>> _ertMetrics;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_ELEM_SEQ_METRICS_HPP
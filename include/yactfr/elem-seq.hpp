@@ -9,12 +9,15 @@
 #define YACTFR_ELEM_SEQ_HPP
 
 #include <memory>
+#include <type_traits>
 
 #include "elem-seq-it.hpp"
+#include "elem.hpp"
 
 namespace yactfr {
 
 class DataSourceFactory;
+class ElementSequenceMetrics;
 class TraceType;
 
 /*!
@@ -61,6 +64,106 @@ public:
     */
     explicit ElementSequence(const TraceType& traceType, DataSourceFactory& dataSourceFactory);
 
+    /// Whether or not iterator copies share their data source.
+    bool iteratorCopiesShareDataSource() const noexcept
+    {
+        return _itCopiesShareDataSrc;
+    }
+
+    /*!
+    @brief
+        Sets whether or not the copies of the iterators which this
+        element sequence creates share their data source to
+        \p shareDataSource.
+
+    When disabled (the default), copying an element sequence iterator
+    (copy constructor or copy assignment operator) creates a new data
+    source from the data source factory of this element sequence,
+    making the copy fully independent from the original.
+
+    When enabled, an element sequence iterator and all its copies (and
+    the copies of those) share a single, reference-counted data source.
+    Each iterator still has its own position and its own cursor within
+    the current data block: copying an iterator only copies its state,
+    which makes forking iterators (lookahead, backtracking) cheap, even
+    with a data source factory of which the data sources are expensive
+    to create (MemoryMappedFileViewFactory, for example).
+
+    However, with a shared data source:
+
+    - Advancing an iterator may invalidate the data which the current
+      element of the other iterators sharing the same data source
+      points to (RawDataElement::begin(), for example), but not the
+      positions of those iterators: they request their data block again
+      when they advance.
+
+    - You must not use iterators sharing the same data source
+      concurrently from different threads.
+
+    - Iterators don't indicate to the data source that they won't need
+      data anymore (DataSource::releaseDataBefore()) while other
+      iterators share it.
+
+    Copies never share a data source which isn't shareable (see
+    DataSource::isShareable()), like the ones which
+    SharedMemoryRingDataSourceFactory creates.
+
+    This setting only applies to the iterators which begin() and at()
+    create \em after this call.
+
+    @param[in] shareDataSource
+        \c true to make the copies of the iterators which this element
+        sequence creates share their data source.
+    */
+    void iteratorCopiesShareDataSource(const bool shareDataSource) noexcept
+    {
+        _itCopiesShareDataSrc = shareDataSource;
+    }
+
+    /*!
+    @brief
+        Decoding metrics which the iterators which this element
+        sequence creates update, or \c nullptr if none (the default).
+    */
+    ElementSequenceMetrics *metrics() const noexcept
+    {
+        return _metrics;
+    }
+
+    /*!
+    @brief
+        Sets the decoding metrics which the iterators which this element
+        sequence creates update to \p metrics.
+
+    With \c nullptr (the default), iterators don't update any
+    metrics.
+
+    Iterators only update \p metrics if the yactfr library was built
+    with \c -DOPT_METRICS=YES, which isn't the default (see
+    ElementSequenceMetrics::isSupported()). Otherwise, this setting has
+    no effect.
+
+    \p metrics, if not \c nullptr, must exist as long as any iterator
+    which this element sequence creates after this call exists.
+
+    This setting only applies to the iterators which begin() and at()
+    create \em after this call. Copies of an iterator update the same
+    metrics as the original.
+
+    @param[in] metrics
+        Decoding metrics which the iterators which this element sequence
+        creates update, or \c nullptr to disable decoding metrics.
+
+    @pre
+        If \p metrics isn't \c nullptr, then
+        <code>&metrics->traceType()</code> is the trace type of this
+        element sequence.
+    */
+    void metrics(ElementSequenceMetrics * const metrics) noexcept
+    {
+        _metrics = metrics;
+    }
+
     /*!
     @brief
         Returns an element sequence iterator at the beginning of this
@@ -131,9 +234,95 @@ public:
     */
     Iterator at(Index offset);
 
+    /*!
+    @brief
+        Decodes this whole element sequence, calling \p sink with each
+        element, in order.
+
+    This is a push alternative to iterating this element sequence
+    yourself: this method creates an iterator at the beginning of this
+    element sequence and, for each element, calls the overload of
+    \p sink of which the parameter is the concrete element type,
+    for example:
+
+    @code
+    struct Sink
+    {
+        void operator()(const yactfr::FixedLengthUnsignedIntegerElement& elem)
+        {
+            sum += elem.value();
+        }
+
+        void operator()(const yactfr::FixedLengthSignedIntegerElement& elem)
+        {
+            sum += elem.value();
+        }
+
+        // any other element
+        void operator()(const yactfr::Element&)
+        {
+        }
+
+        unsigned long long sum = 0;
+    };
+
+    Sink sink;
+
+    seq.decode(sink);
+    @endcode
+
+    \p sink may also be a generic lambda.
+
+    Because \p sink is a template parameter and this method selects the
+    overload to call with a switch statement on the kind of the element
+    (see visit()), the compiler can inline the overloads of \p sink in
+    the function which the decoding loop calls for each element.
+
+    Unlike advancing an iterator, the decoding loop doesn't return after
+    each element: it calls this function and continues decoding.
+
+    The element which \p sink receives is only valid during the call.
+
+    @param[in] sink
+        Callable object of which an overload accepts each concrete
+        element type (or a base of it, like <code>const
+        Element&</code>).
+
+    @throws ?
+        Any exception that the data source can throw or that
+        \p sink can throw.
+    @throws DecodingError
+        Any derived decoding error (see decoding-errors.hpp).
+    @throws DataNotAvailable
+        Data is not available now from the data source.
+    */
+    template <typename SinkT>
+    void decode(SinkT&& sink)
+    {
+        auto it = this->begin();
+
+        if (it == this->end()) {
+            return;
+        }
+
+        // constructing the iterator decodes the first element
+        yactfr::visit(*it, sink);
+        it._decode(&ElementSequence::_callSink<std::remove_reference_t<SinkT>>,
+                   const_cast<void *>(static_cast<const void *>(&sink)));
+    }
+
+private:
+    template <typename SinkT>
+    static void _callSink(void * const sink, const Element& elem)
+    {
+        yactfr::visit(elem, *static_cast<SinkT *>(sink));
+    }
+
 private:
     const TraceType *_traceType;
     DataSourceFactory *_dataSrcFactory;
+    bool _itCopiesShareDataSrc = false;
+    ElementSequenceMetrics *_metrics = nullptr;
 };
 
 } // namespace yactfr
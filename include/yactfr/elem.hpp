@@ -8,8 +8,11 @@
 #ifndef YACTFR_ELEM_HPP
 #define YACTFR_ELEM_HPP
 
+#include <cassert>
 #include <cstdint>
+#include <cstdlib>
 #include <string>
+#include <utility>
 #include <algorithm>
 #include <unordered_set>
 #include <boost/uuid/uuid.hpp>
@@ -42,6 +45,11 @@ class VmPos;
 
 } // namespace internal
 
+class Element;
+
+template <typename FuncT>
+decltype(auto) visit(const Element& elem, FuncT&& func);
+
 /*!
 @defgroup elems Elements
 @brief
@@ -58,6 +66,9 @@ class VmPos;
 */
 class Element
 {
+    template <typename FuncT>
+    friend decltype(auto) visit(const Element&, FuncT&&);
+
 private:
     enum _tKind
     {
@@ -250,7 +261,8 @@ public:
 
 protected:
     explicit Element(const Kind kind) :
-        _kind {kind}
+        _kind {kind},
+        _kindIndex {Element::_kindIndexFromKind(kind)}
     {
     }
 
@@ -1304,8 +1316,169 @@ private:
         return (static_cast<unsigned long long>(_kind) & kind) == kind;
     }
 
+    /*
+     * Dense index (0 to 48) of the element kind `kind`.
+     *
+     * The values of `Kind` are sparse bit sets: visit() switches on
+     * this index instead so that the compiler can use a jump table.
+     */
+    static constexpr std::uint8_t _kindIndexFromKind(const Kind kind) noexcept
+    {
+        switch (kind) {
+        case Kind::PacketBeginning:
+            return 0;
+
+        case Kind::PacketEnd:
+            return 1;
+
+        case Kind::ScopeBeginning:
+            return 2;
+
+        case Kind::ScopeEnd:
+            return 3;
+
+        case Kind::PacketContentBeginning:
+            return 4;
+
+        case Kind::PacketContentEnd:
+            return 5;
+
+        case Kind::EventRecordBeginning:
+            return 6;
+
+        case Kind::EventRecordEnd:
+            return 7;
+
+        case Kind::PacketMagicNumber:
+            return 8;
+
+        case Kind::MetadataStreamUuid:
+            return 9;
+
+        case Kind::DataStreamInfo:
+            return 10;
+
+        case Kind::DefaultClockValue:
+            return 11;
+
+        case Kind::PacketInfo:
+            return 12;
+
+        case Kind::EventRecordInfo:
+            return 13;
+
+        case Kind::FixedLengthBitArray:
+            return 14;
+
+        case Kind::FixedLengthBitMap:
+            return 15;
+
+        case Kind::FixedLengthBoolean:
+            return 16;
+
+        case Kind::FixedLengthSignedInteger:
+            return 17;
+
+        case Kind::FixedLengthUnsignedInteger:
+            return 18;
+
+        case Kind::FixedLengthFloatingPointNumber:
+            return 19;
+
+        case Kind::VariableLengthSignedInteger:
+            return 20;
+
+        case Kind::VariableLengthUnsignedInteger:
+            return 21;
+
+        case Kind::NullTerminatedStringBeginning:
+            return 22;
+
+        case Kind::NullTerminatedStringEnd:
+            return 23;
+
+        case Kind::RawData:
+            return 24;
+
+        case Kind::StructureBeginning:
+            return 25;
+
+        case Kind::StructureEnd:
+            return 26;
+
+        case Kind::StaticLengthArrayBeginning:
+            return 27;
+
+        case Kind::StaticLengthArrayEnd:
+            return 28;
+
+        case Kind::DynamicLengthArrayBeginning:
+            return 29;
+
+        case Kind::DynamicLengthArrayEnd:
+            return 30;
+
+        case Kind::StaticLengthBlobBeginning:
+            return 31;
+
+        case Kind::StaticLengthBlobEnd:
+            return 32;
+
+        case Kind::DynamicLengthBlobBeginning:
+            return 33;
+
+        case Kind::DynamicLengthBlobEnd:
+            return 34;
+
+        case Kind::StaticLengthStringBeginning:
+            return 35;
+
+        case Kind::StaticLengthStringEnd:
+            return 36;
+
+        case Kind::DynamicLengthStringBeginning:
+            return 37;
+
+        case Kind::DynamicLengthStringEnd:
+            return 38;
+
+        case Kind::VariantWithSignedIntegerSelectorBeginning:
+            return 39;
+
+        case Kind::VariantWithSignedIntegerSelectorEnd:
+            return 40;
+
+        case Kind::VariantWithUnsignedIntegerSelectorBeginning:
+            return 41;
+
+        case Kind::VariantWithUnsignedIntegerSelectorEnd:
+            return 42;
+
+        case Kind::OptionalWithBooleanSelectorBeginning:
+            return 43;
+
+        case Kind::OptionalWithBooleanSelectorEnd:
+            return 44;
+
+        case Kind::OptionalWithSignedIntegerSelectorBeginning:
+            return 45;
+
+        case Kind::OptionalWithSignedIntegerSelectorEnd:
+            return 46;
+
+        case Kind::OptionalWithUnsignedIntegerSelectorBeginning:
+            return 47;
+
+        case Kind::OptionalWithUnsignedIntegerSelectorEnd:
+            return 48;
+        }
+
+        return 0;
+    }
+
 private:
     Kind _kind;
+    std::uint8_t _kindIndex;
 };
 
 /*!
@@ -4304,6 +4477,213 @@ inline const VariantWithUnsignedIntegerSelectorEndElement& Element::asVariantWit
     return static_cast<const VariantWithUnsignedIntegerSelectorEndElement&>(*this);
 }
 
+/*!
+@brief
+    Calls \p func with the concrete element of \p elem, returning what
+    \p func returns.
+
+@ingroup elems
+
+This is a static alternative to Element::accept() and ElementVisitor:
+this function calls the overload of \p func of which the parameter is
+the concrete type of \p elem (for example,
+<code>const FixedLengthUnsignedIntegerElement&</code>), selecting it
+with a switch statement on the kind of \p elem. Without virtual
+method calls, the compiler can inline the overloads of \p func.
+
+\p func may be a generic lambda or an object having many
+<code>operator()</code> overloads, for example:
+
+@code
+struct Counter
+{
+    void operator()(const yactfr::EventRecordBeginningElement&)
+    {
+        ++erCount;
+    }
+
+    // any other element
+    void operator()(const yactfr::Element&)
+    {
+    }
+
+    unsigned long long erCount = 0;
+};
+
+Counter counter;
+
+for (const auto& elem : seq) {
+    yactfr::visit(elem, counter);
+}
+@endcode
+
+All the overloads which \p func can call must return the same type.
+
+@param[in] elem
+    Element to visit.
+@param[in] func
+    Callable object of which an overload accepts each concrete element
+    type (or a base of it, like <code>const Element&</code>).
+
+@returns
+    Return value of \p func.
+*/
+template <typename FuncT>
+decltype(auto) visit(const Element& elem, FuncT&& func)
+{
+    switch (elem._kindIndex) {
+    case Element::_kindIndexFromKind(Element::Kind::PacketBeginning):
+        return std::forward<FuncT>(func)(elem.asPacketBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::PacketEnd):
+        return std::forward<FuncT>(func)(elem.asPacketEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::ScopeBeginning):
+        return std::forward<FuncT>(func)(elem.asScopeBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::ScopeEnd):
+        return std::forward<FuncT>(func)(elem.asScopeEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::PacketContentBeginning):
+        return std::forward<FuncT>(func)(elem.asPacketContentBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::PacketContentEnd):
+        return std::forward<FuncT>(func)(elem.asPacketContentEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::EventRecordBeginning):
+        return std::forward<FuncT>(func)(elem.asEventRecordBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::EventRecordEnd):
+        return std::forward<FuncT>(func)(elem.asEventRecordEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::PacketMagicNumber):
+        return std::forward<FuncT>(func)(elem.asPacketMagicNumberElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::MetadataStreamUuid):
+        return std::forward<FuncT>(func)(elem.asMetadataStreamUuidElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DataStreamInfo):
+        return std::forward<FuncT>(func)(elem.asDataStreamInfoElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DefaultClockValue):
+        return std::forward<FuncT>(func)(elem.asDefaultClockValueElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::PacketInfo):
+        return std::forward<FuncT>(func)(elem.asPacketInfoElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::EventRecordInfo):
+        return std::forward<FuncT>(func)(elem.asEventRecordInfoElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::FixedLengthBitArray):
+        return std::forward<FuncT>(func)(elem.asFixedLengthBitArrayElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::FixedLengthBitMap):
+        return std::forward<FuncT>(func)(elem.asFixedLengthBitMapElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::FixedLengthBoolean):
+        return std::forward<FuncT>(func)(elem.asFixedLengthBooleanElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::FixedLengthSignedInteger):
+        return std::forward<FuncT>(func)(elem.asFixedLengthSignedIntegerElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::FixedLengthUnsignedInteger):
+        return std::forward<FuncT>(func)(elem.asFixedLengthUnsignedIntegerElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::FixedLengthFloatingPointNumber):
+        return std::forward<FuncT>(func)(elem.asFixedLengthFloatingPointNumberElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::VariableLengthSignedInteger):
+        return std::forward<FuncT>(func)(elem.asVariableLengthSignedIntegerElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::VariableLengthUnsignedInteger):
+        return std::forward<FuncT>(func)(elem.asVariableLengthUnsignedIntegerElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::NullTerminatedStringBeginning):
+        return std::forward<FuncT>(func)(elem.asNullTerminatedStringBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::NullTerminatedStringEnd):
+        return std::forward<FuncT>(func)(elem.asNullTerminatedStringEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::RawData):
+        return std::forward<FuncT>(func)(elem.asRawDataElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StructureBeginning):
+        return std::forward<FuncT>(func)(elem.asStructureBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StructureEnd):
+        return std::forward<FuncT>(func)(elem.asStructureEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StaticLengthArrayBeginning):
+        return std::forward<FuncT>(func)(elem.asStaticLengthArrayBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StaticLengthArrayEnd):
+        return std::forward<FuncT>(func)(elem.asStaticLengthArrayEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DynamicLengthArrayBeginning):
+        return std::forward<FuncT>(func)(elem.asDynamicLengthArrayBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DynamicLengthArrayEnd):
+        return std::forward<FuncT>(func)(elem.asDynamicLengthArrayEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StaticLengthBlobBeginning):
+        return std::forward<FuncT>(func)(elem.asStaticLengthBlobBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StaticLengthBlobEnd):
+        return std::forward<FuncT>(func)(elem.asStaticLengthBlobEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DynamicLengthBlobBeginning):
+        return std::forward<FuncT>(func)(elem.asDynamicLengthBlobBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DynamicLengthBlobEnd):
+        return std::forward<FuncT>(func)(elem.asDynamicLengthBlobEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StaticLengthStringBeginning):
+        return std::forward<FuncT>(func)(elem.asStaticLengthStringBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::StaticLengthStringEnd):
+        return std::forward<FuncT>(func)(elem.asStaticLengthStringEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DynamicLengthStringBeginning):
+        return std::forward<FuncT>(func)(elem.asDynamicLengthStringBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::DynamicLengthStringEnd):
+        return std::forward<FuncT>(func)(elem.asDynamicLengthStringEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::VariantWithSignedIntegerSelectorBeginning):
+        return std::forward<FuncT>(func)(elem.asVariantWithSignedIntegerSelectorBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::VariantWithSignedIntegerSelectorEnd):
+        return std::forward<FuncT>(func)(elem.asVariantWithSignedIntegerSelectorEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::VariantWithUnsignedIntegerSelectorBeginning):
+        return std::forward<FuncT>(func)(elem.asVariantWithUnsignedIntegerSelectorBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::VariantWithUnsignedIntegerSelectorEnd):
+        return std::forward<FuncT>(func)(elem.asVariantWithUnsignedIntegerSelectorEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::OptionalWithBooleanSelectorBeginning):
+        return std::forward<FuncT>(func)(elem.asOptionalWithBooleanSelectorBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::OptionalWithBooleanSelectorEnd):
+        return std::forward<FuncT>(func)(elem.asOptionalWithBooleanSelectorEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::OptionalWithSignedIntegerSelectorBeginning):
+        return std::forward<FuncT>(func)(elem.asOptionalWithSignedIntegerSelectorBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::OptionalWithSignedIntegerSelectorEnd):
+        return std::forward<FuncT>(func)(elem.asOptionalWithSignedIntegerSelectorEndElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::OptionalWithUnsignedIntegerSelectorBeginning):
+        return std::forward<FuncT>(func)(elem.asOptionalWithUnsignedIntegerSelectorBeginningElement());
+
+    case Element::_kindIndexFromKind(Element::Kind::OptionalWithUnsignedIntegerSelectorEnd):
+        return std::forward<FuncT>(func)(elem.asOptionalWithUnsignedIntegerSelectorEndElement());
+    }
+
+    assert(false);
+    std::abort();
+}
+
 } // namespace yactfr
 
 #endif // YACTFR_ELEM_HPP
@@ -0,0 +1,506 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_ER_COLUMNAR_EXPORTER_HPP
+#define YACTFR_ER_COLUMNAR_EXPORTER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include "metadata/fwd.hpp"
+#include "metadata/aliases.hpp"
+#include "elem-seq.hpp"
+#include "elem.hpp"
+#include "aliases.hpp"
+
+namespace yactfr {
+
+class EventRecordColumnarExporter;
+
+/*!
+@brief
+    Column of an event record table.
+
+@ingroup element_seq
+
+An event record column contains the values of a single field (or the
+timestamps) of all the rows (event records) of an
+EventRecordTable, in a layout which is compatible with the
+<a href="https://arrow.apache.org/docs/format/Columnar.html">Apache
+Arrow columnar format</a>:
+
+<dl>
+  <dt>Validity bitmap (validityBitmap())</dt>
+  <dd>
+    Bit \em i (least significant bit first) of this bitmap is set
+    if the value of row \em i is valid, or cleared if it's null.
+
+    A value is null when its field isn't part of the event record
+    (unselected option of a variant, or disabled optional), or, for
+    the timestamp column, when the event record has no default clock
+    value.
+  </dd>
+
+  <dt>Values (values())</dt>
+  <dd>
+    For a fixed-width column (all the types except Type::String and
+    Type::Blob): one value per row, in the native byte order:
+
+    <dl>
+      <dt>Type::UnsignedInteger and Type::Timestamp</dt>
+      <dd>\c std::uint64_t</dd>
+
+      <dt>Type::SignedInteger</dt>
+      <dd>\c std::int64_t</dd>
+
+      <dt>Type::FloatingPointNumber</dt>
+      <dd>\c double</dd>
+
+      <dt>Type::Boolean</dt>
+      <dd>\c std::uint8_t (0 or 1)</dd>
+    </dl>
+
+    The value of a null row is zero.
+
+    For a Type::String or Type::Blob column: the concatenated data of
+    all the rows.
+  </dd>
+
+  <dt>Offsets (offsets())</dt>
+  <dd>
+    For a Type::String or Type::Blob column only: size() + 1 offsets
+    (like the Arrow large string/binary layout) such that the data of
+    row \em i is between offsets <em>i</em> and <em>i</em> + 1 of
+    values().
+  </dd>
+</dl>
+
+The data of a string row is the encoded string (see
+StringType::encoding()), excluding the encoded U+0000 codepoint and
+any following byte.
+*/
+class EventRecordColumn final
+{
+    friend class EventRecordColumnarExporter;
+    friend class EventRecordTable;
+
+public:
+    /// Type of an event record column.
+    enum class Type
+    {
+        /// Unsigned integers and fixed-length bit arrays/maps.
+        UnsignedInteger,
+
+        /// Signed integers.
+        SignedInteger,
+
+        /// Floating point numbers.
+        FloatingPointNumber,
+
+        /// Booleans.
+        Boolean,
+
+        /// Strings.
+        String,
+
+        /// BLOBs.
+        Blob,
+
+        /// Default clock values (cycles) of the event records.
+        Timestamp,
+    };
+
+private:
+    explicit EventRecordColumn(std::string name, Type type, const DataType *dt);
+
+public:
+    /*!
+    @brief
+        Name of this column.
+
+    The name of the timestamp column is \c timestamp.
+
+    The name of another column is the path of its field, the names of
+    the structure members and variant options being separated with
+    <code>.</code>, starting with \c specific-context or \c payload,
+    for example <code>payload.msg</code>.
+    */
+    const std::string& name() const noexcept
+    {
+        return _name;
+    }
+
+    /// Type of this column.
+    Type type() const noexcept
+    {
+        return _type;
+    }
+
+    /*!
+    @brief
+        Data type of the fields of this column, or \c nullptr for the
+        timestamp column.
+    */
+    const DataType *dataType() const noexcept
+    {
+        return _dt;
+    }
+
+    /// Number of rows of this column.
+    Size size() const noexcept
+    {
+        return _size;
+    }
+
+    /// Number of null rows of this column.
+    Size nullCount() const noexcept
+    {
+        return _nullCount;
+    }
+
+    /*!
+    @brief
+        Returns whether or not the row at index \p index is null.
+
+    @param[in] index
+        Index of the row to check.
+
+    @returns
+        \c true if the row at index \p index is null.
+
+    @pre
+        \p index < size()
+    */
+    bool isNull(const Index index) const noexcept
+    {
+        return !(_validityBitmap[index / 8] & (1U << (index % 8)));
+    }
+
+    /// Validity bitmap of this column.
+    const std::vector<std::uint8_t>& validityBitmap() const noexcept
+    {
+        return _validityBitmap;
+    }
+
+    /// Values of this column.
+    const std::vector<std::uint8_t>& values() const noexcept
+    {
+        return _vals;
+    }
+
+    /*!
+    @brief
+        Offsets of the data of each row within values(), for a
+        Type::String or Type::Blob column.
+    */
+    const std::vector<std::int64_t>& offsets() const noexcept
+    {
+        return _offsets;
+    }
+
+    /*!
+    @brief
+        Value of the row at index \p index of this Type::UnsignedInteger
+        or Type::Timestamp column.
+
+    @pre
+        \p index < size()
+    */
+    std::uint64_t unsignedIntegerValue(Index index) const noexcept;
+
+    /*!
+    @brief
+        Value of the row at index \p index of this Type::SignedInteger
+        column.
+
+    @pre
+        \p index < size()
+    */
+    std::int64_t signedIntegerValue(Index index) const noexcept;
+
+    /*!
+    @brief
+        Value of the row at index \p index of this
+        Type::FloatingPointNumber column.
+
+    @pre
+        \p index < size()
+    */
+    double floatingPointNumberValue(Index index) const noexcept;
+
+    /*!
+    @brief
+        Value of the row at index \p index of this Type::Boolean column.
+
+    @pre
+        \p index < size()
+    */
+    bool booleanValue(Index index) const noexcept;
+
+    /*!
+    @brief
+        Data of the row at index \p index of this Type::String or
+        Type::Blob column.
+
+    @pre
+        \p index < size()
+    */
+    std::string stringValue(Index index) const;
+
+private:
+    template <typename ValT>
+    void _appendFixedWidthVal(ValT val);
+
+    void _appendValidity(bool isValid);
+    void _appendNull();
+    void _appendStrData(const std::uint8_t *begin, const std::uint8_t *end);
+    void _endStrVal(Size codeUnitSize);
+    void _clear() noexcept;
+    void _truncate(Size size);
+
+private:
+    std::string _name;
+    Type _type;
+    const DataType *_dt;
+    Size _size = 0;
+    Size _nullCount = 0;
+    std::vector<std::uint8_t> _validityBitmap;
+    std::vector<std::uint8_t> _vals;
+    std::vector<std::int64_t> _offsets;
+};
+
+/*!
+@brief
+    Event record table.
+
+@ingroup element_seq
+
+An event record table contains the exported event records of a single
+event record type, one row per event record, as
+\link EventRecordColumn columns\endlink.
+
+The first column is the timestamp column (Type::Timestamp). The other
+columns are the scalar fields of the specific context and payload of
+the event record type, in field order.
+
+Fields within arrays don't have any column.
+*/
+class EventRecordTable final
+{
+    friend class EventRecordColumnarExporter;
+
+public:
+    /// Columns.
+    using Columns = std::vector<EventRecordColumn>;
+
+private:
+    explicit EventRecordTable(const EventRecordType& ert);
+
+public:
+    /// Event record type of the rows of this table.
+    const EventRecordType& eventRecordType() const noexcept
+    {
+        return *_ert;
+    }
+
+    /// Number of rows of this table.
+    Size rowCount() const noexcept
+    {
+        return _rowCount;
+    }
+
+    /// Columns of this table.
+    const Columns& columns() const noexcept
+    {
+        return _cols;
+    }
+
+    /*!
+    @brief
+        Returns the column named \p name, or \c nullptr if not found.
+
+    @param[in] name
+        Name of the column to find.
+
+    @returns
+        Column named \p name, or \c nullptr if not found.
+    */
+    const EventRecordColumn *operator[](const std::string& name) const noexcept;
+
+private:
+    void _addCols(const DataType& dt, const std::string& name);
+    void _addCol(std::string name, EventRecordColumn::Type type, const DataType *dt);
+    void _finishRow();
+    void _abortRow();
+    void _clear() noexcept;
+
+private:
+    const EventRecordType *_ert;
+    Columns _cols;
+    Size _rowCount = 0;
+
+    // index of column of a given field data type
+    std::unordered_map<const DataType *, Index> _colIndexes;
+};
+
+/*!
+@brief
+    Event record columnar exporter.
+
+@ingroup element_seq
+
+An event record columnar exporter decodes an
+\link ElementSequence element sequence\endlink and exports the
+event records of chosen types to
+\link EventRecordTable event record tables\endlink, one per event
+record type, of which the columns have an
+<a href="https://arrow.apache.org/docs/format/Columnar.html">Apache
+Arrow</a>-compatible layout (see EventRecordColumn).
+
+Export event records in batches with exportBatch(), for example:
+
+@code
+yactfr::EventRecordColumnarExporter exporter {seq, {&ert1, &ert2}};
+
+while (exporter.exportBatch(4096) > 0) {
+    const auto table1 = exporter.table(ert1);
+
+    // use `table1` and the other tables...
+
+    exporter.clear();
+}
+@endcode
+*/
+class EventRecordColumnarExporter final :
+    boost::noncopyable
+{
+public:
+    /// Tables.
+    using Tables = std::vector<EventRecordTable>;
+
+public:
+    /*!
+    @brief
+        Builds an event record columnar exporter which exports the event
+        records of \p seq of which the types are in \p eventRecordTypes.
+
+    \p seq and the types of \p eventRecordTypes must exist as long as
+    this exporter exists.
+
+    @param[in] seq
+        Element sequence to decode.
+    @param[in] eventRecordTypes
+        Types of the event records to export.
+    */
+    explicit EventRecordColumnarExporter(ElementSequence& seq,
+                                         const std::vector<const EventRecordType *>& eventRecordTypes);
+
+    /*!
+    @brief
+        Decodes the next elements of the element sequence of this
+        exporter, appending the event records of chosen types to their
+        tables, until this exporter appends \p maxEventRecordCount rows
+        or until the end of the element sequence.
+
+    @param[in] maxEventRecordCount
+        Maximum number of rows to append.
+
+    @returns
+        Number of appended rows (0 means the end of the element
+        sequence).
+
+    @throws ?
+        Any exception that the data source can throw.
+    @throws DecodingError
+        Any derived decoding error (see decoding-errors.hpp). The tables
+        don't contain the event record which led to this error.
+    @throws DataNotAvailable
+        Data is not available now from the data source: try again
+        later.
+    */
+    Size exportBatch(Size maxEventRecordCount);
+
+    /*!
+    @brief
+        Table of the event records of type \p eventRecordType, or
+        \c nullptr if this exporter doesn't export such event records.
+    */
+    const EventRecordTable *table(const EventRecordType& eventRecordType) const noexcept;
+
+    /// Tables of this exporter, in the order of the constructor.
+    const Tables& tables() const noexcept
+    {
+        return _tables;
+    }
+
+    /*!
+    @brief
+        Removes all the rows of the tables of this exporter, keeping
+        their allocated memory for the next batches.
+    */
+    void clear() noexcept;
+
+private:
+    void _handleElem(const Element& elem);
+    void _handleElem(const EventRecordBeginningElement& elem);
+    void _handleElem(const DefaultClockValueElement& elem);
+    void _handleElem(const EventRecordInfoElement& elem);
+    void _handleElem(const EventRecordEndElement& elem);
+    void _handleElem(const FixedLengthBitArrayElement& elem);
+    void _handleElem(const FixedLengthBooleanElement& elem);
+    void _handleElem(const FixedLengthSignedIntegerElement& elem);
+    void _handleElem(const FixedLengthUnsignedIntegerElement& elem);
+    void _handleElem(const FixedLengthFloatingPointNumberElement& elem);
+    void _handleElem(const VariableLengthSignedIntegerElement& elem);
+    void _handleElem(const VariableLengthUnsignedIntegerElement& elem);
+    void _handleElem(const NullTerminatedStringBeginningElement& elem);
+    void _handleElem(const NullTerminatedStringEndElement& elem);
+    void _handleElem(const NonNullTerminatedStringBeginningElement& elem);
+    void _handleElem(const NonNullTerminatedStringEndElement& elem);
+    void _handleElem(const BlobBeginningElement& elem);
+    void _handleElem(const BlobEndElement& elem);
+    void _handleElem(const RawDataElement& elem);
+    void _beginStrVal(const DataElement& elem, Size codeUnitSize);
+    void _endStrVal();
+    EventRecordColumn *_col(const DataElement& elem) noexcept;
+    void _abortRow();
+
+private:
+    ElementSequence *_seq;
+    ElementSequenceIterator _endIt;
+    Tables _tables;
+
+    // index of table of a given event record type
+    std::unordered_map<const EventRecordType *, Index> _tableIndexes;
+
+    // current iterator (`boost::none` before the first batch)
+    boost::optional<ElementSequenceIterator> _it;
+
+    // whether or not this exporter already handled the element of `*_it`
+    bool _elemIsHandled = false;
+
+    // table of current event record, if exported
+    EventRecordTable *_curTable = nullptr;
+
+    // default clock value of current event record
+    boost::optional<Cycles> _curTs;
+
+    // column of current string/BLOB, if exported
+    EventRecordColumn *_curStrCol = nullptr;
+    Size _curStrCodeUnitSize = 1;
+
+    // number of rows which the current batch appended
+    Size _batchRowCount = 0;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_ER_COLUMNAR_EXPORTER_HPP
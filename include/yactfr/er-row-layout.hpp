@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_ER_ROW_LAYOUT_HPP
+#define YACTFR_ER_ROW_LAYOUT_HPP
+
+#include <vector>
+#include <boost/noncopyable.hpp>
+
+#include "metadata/fwd.hpp"
+#include "aliases.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class Vm;
+class PktProcBuilder;
+
+} // namespace internal
+
+/*!
+@brief
+    Event record row layout.
+
+@ingroup element_seq
+
+An event record row layout describes how
+ElementSequenceIterator::readEventRecordRow() writes the fields of
+an event record having a <em>static layout</em> to a row buffer.
+
+The fields of an event record type have a static layout when its
+specific context and payload types only contain, recursively,
+structure types, static-length array types, and fixed-length bit array
+types (including fixed-length bit map, boolean, integer, and floating
+point number types), with at most 1024 fixed-length bit array fields
+in total.
+
+A row is like a C structure having one member per field, in field order
+(specific context first, and then payload, depth-first, each element of
+a static-length array being a distinct field), each member being
+naturally aligned:
+
+<dl>
+  <dt>Fixed-length boolean</dt>
+  <dd>\c std::uint8_t (0 or 1)</dd>
+
+  <dt>Fixed-length floating point number</dt>
+  <dd>\c float (32-bit) or \c double (64-bit)</dd>
+
+  <dt>Fixed-length signed integer</dt>
+  <dd>
+    Smallest of \c std::int8_t, \c std::int16_t, \c std::int32_t, and
+    \c std::int64_t which can hold the value.
+  </dd>
+
+  <dt>Other fixed-length bit array</dt>
+  <dd>
+    Smallest of \c std::uint8_t, \c std::uint16_t, \c std::uint32_t,
+    and \c std::uint64_t which can hold the value.
+  </dd>
+</dl>
+
+Get the row layout of the current event record with
+ElementSequenceIterator::eventRecordRowLayout().
+*/
+class EventRecordRowLayout final :
+    boost::noncopyable
+{
+    friend class internal::Vm;
+    friend class internal::PktProcBuilder;
+
+public:
+    /// Field of an event record row.
+    class Field final
+    {
+        friend class internal::Vm;
+        friend class internal::PktProcBuilder;
+
+    private:
+        explicit Field(const FixedLengthBitArrayType& type, Index offset, Size size,
+                       unsigned int dsAlign) noexcept;
+
+    public:
+        /// Type of this field.
+        const FixedLengthBitArrayType& type() const noexcept
+        {
+            return *_type;
+        }
+
+        /// Offset (bytes) of this field within a row.
+        Index offset() const noexcept
+        {
+            return _offset;
+        }
+
+        /// Size (bytes) of this field within a row.
+        Size size() const noexcept
+        {
+            return _size;
+        }
+
+    private:
+        const FixedLengthBitArrayType *_type;
+        Index _offset;
+        Size _size;
+
+        /*
+         * Alignment (bits) of this field within the data stream,
+         * including the alignment of any structure or static-length
+         * array which starts with it.
+         */
+        unsigned int _dsAlign;
+    };
+
+    /// Fields.
+    using Fields = std::vector<Field>;
+
+private:
+    explicit EventRecordRowLayout(const EventRecordType& ert) noexcept;
+
+public:
+    /// Event record type of this layout.
+    const EventRecordType& eventRecordType() const noexcept
+    {
+        return *_ert;
+    }
+
+    /// Fields of a row.
+    const Fields& fields() const noexcept
+    {
+        return _fields;
+    }
+
+    /*!
+    @brief
+        Size (bytes) of a row, a multiple of alignment().
+    */
+    Size size() const noexcept
+    {
+        return _size;
+    }
+
+    /// Alignment (bytes) of a row.
+    Size alignment() const noexcept
+    {
+        return _align;
+    }
+
+private:
+    const EventRecordType *_ert;
+    Fields _fields;
+    Size _size = 0;
+    Size _align = 1;
+
+    // alignment (bits) of the data stream after the last field
+    unsigned int _endDsAlign = 1;
+
+    // maximum length (bits) of the fields within the data stream
+    Size _maxDsLenBits = 0;
+
+    // whether or not all the fields start on a byte boundary
+    bool _fieldsAreByteAligned = true;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_ER_ROW_LAYOUT_HPP
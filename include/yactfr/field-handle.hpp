@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_FIELD_HANDLE_HPP
+#define YACTFR_FIELD_HANDLE_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include "metadata/data-loc.hpp"
+#include "metadata/dt.hpp"
+#include "aliases.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class TraceTypeImpl;
+
+} // namespace internal
+
+class ElementSequenceIterator;
+
+/*!
+@brief
+    Field handle.
+
+@ingroup element_seq
+
+A field handle gives access, from an element sequence iterator, to
+the last decoded value of a boolean or integer field in O(1) (see
+ElementSequenceIterator::fieldValue()), without having to track the
+elements which the iterator provides.
+
+Get a field handle with TraceType::fieldHandle(): a field handle
+belongs to its trace type.
+*/
+class FieldHandle final :
+    boost::noncopyable
+{
+    friend class internal::TraceTypeImpl;
+    friend class ElementSequenceIterator;
+
+private:
+    explicit FieldHandle(Index index, DataLocation location, DataTypeSet dataTypes);
+
+public:
+    /// Data location of this field handle.
+    const DataLocation& location() const noexcept
+    {
+        return _loc;
+    }
+
+    /*!
+    @brief
+        Boolean and integer data types which location() targets.
+
+    This set contains more than one data type when location() targets
+    fields within different options of a variant.
+    */
+    const DataTypeSet& dataTypes() const noexcept
+    {
+        return _dts;
+    }
+
+private:
+    const Index _index;
+    const DataLocation _loc;
+    const DataTypeSet _dts;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_FIELD_HANDLE_HPP
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_METADATA_DT_CONTENT_HPP
+#define YACTFR_INTERNAL_METADATA_DT_CONTENT_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "../../metadata/item.hpp"
+#include "../../metadata/int-range-set.hpp"
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * The following functions intern the immutable content of data types
+ * (attributes, integer type mappings, and selector integer range sets)
+ * when building them: each one returns some content equal to its
+ * parameter which any other live data type may already share.
+ *
+ * Interned content lives as long as its last user.
+ */
+
+/*
+ * Returns attributes equal to `attrs`, or `nullptr` if `attrs` is
+ * `nullptr`.
+ */
+std::shared_ptr<const MapItem> internAttrs(MapItem::Up attrs);
+
+/*
+ * Returns integer type mappings equal to `mappings`.
+ */
+std::shared_ptr<const std::map<std::string, IntegerRangeSet<long long>>>
+internIntTypeMappings(std::map<std::string, IntegerRangeSet<long long>>&& mappings);
+
+std::shared_ptr<const std::map<std::string, IntegerRangeSet<unsigned long long>>>
+internIntTypeMappings(std::map<std::string, IntegerRangeSet<unsigned long long>>&& mappings);
+
+/*
+ * Returns an integer range set equal to `rangeSet`.
+ */
+IntegerRangeSet<long long> internIntRangeSet(const IntegerRangeSet<long long>& rangeSet);
+
+IntegerRangeSet<unsigned long long>
+internIntRangeSet(const IntegerRangeSet<unsigned long long>& rangeSet);
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_METADATA_DT_CONTENT_HPP
@@ -12,6 +12,7 @@
 #include <utility>
 #include <unordered_map>
 #include <set>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 #include "dt.hpp"
@@ -377,7 +378,8 @@ public:
     }
 
 private:
-    void _buildErtMap();
+    void _buildErtMap() const;
+    void _addErts(std::vector<EventRecordType::Up>&& erts) const;
     bool _isDataTypeEmpty(const DataType *type) const;
     void _setTraceType(const TraceType& traceType) const;
 
@@ -386,8 +388,14 @@ private:
     const boost::optional<std::string> _ns;
     const boost::optional<std::string> _name;
     const boost::optional<std::string> _uid;
-    const EventRecordTypeSet _erts;
-    std::unordered_map<TypeId, const EventRecordType *> _idsToErts;
+
+    /*
+     * Mutable because an incremental metadata text parser may add
+     * event record types to an existing data stream type.
+     */
+    mutable EventRecordTypeSet _erts;
+    mutable std::unordered_map<TypeId, const EventRecordType *> _idsToErts;
+
     StructureType::Up _pktCtxType;
     StructureType::Up _erHeaderType;
     StructureType::Up _erCommonCtxType;
@@ -683,7 +683,7 @@ private:
 private:
     const _tKind _theKind;
     unsigned int _align;
-    const MapItem::Up _attrs;
+    const std::shared_ptr<const MapItem> _attrs;
 };
 
 /*!
@@ -12,6 +12,7 @@
 #include <string>
 #include <boost/uuid/uuid.hpp>
 
+#include "../aliases.hpp"
 #include "trace-type.hpp"
 
 namespace yactfr {
@@ -130,6 +131,83 @@ inline FromMetadataTextReturn fromMetadataText(const std::string& text)
     return fromMetadataText(text.data(), text.data() + text.size());
 }
 
+/*!
+@brief
+    Builds trace type and metadata stream UUID objects by parsing the
+    metadata text from \p begin to \p end using up to \p threadCount
+    threads.
+
+@ingroup metadata
+
+This function is equivalent to
+fromMetadataText(const char *, const char *), therefore refer to its
+documentation, but it parses independent parts of the metadata text
+concurrently:
+
+<dl>
+  <dt>CTF&nbsp;1.8</dt>
+  <dd>
+    The \c event blocks which follow the \c trace block.
+  </dd>
+
+  <dt>CTF&nbsp;2</dt>
+  <dd>
+    The JSON texts and the validation of the fragments.
+  </dd>
+</dl>
+
+The result, including the error which this function throws, if any, is
+the same as with fromMetadataText(const char *, const char *): when
+more than one part of the metadata text is invalid, this function
+reports the error of the first one.
+
+This is worth it for large metadata texts (many event record types).
+
+@param[in] begin
+    Beginning of metadata text.
+@param[in] end
+    End of metadata text.
+@param[in] threadCount
+    Maximum number of threads to use, including the calling thread.
+    0 means the number of hardware threads, while 1 means to parse
+    sequentially.
+
+@returns
+    Resulting trace type and optional metadata stream UUID pair.
+
+@throws TextParseError
+    An error occurred while parsing the document.
+*/
+FromMetadataTextReturn fromMetadataText(const char *begin, const char *end, Size threadCount);
+
+/*!
+@brief
+    Builds trace type and metadata stream UUID objects by parsing the
+    metadata text \p text using up to \p threadCount threads.
+
+@ingroup metadata
+
+This function effectively calls
+fromMetadataText(const char *, const char *, Size), therefore refer to
+its documentation.
+
+@param[in] text
+    Metadata text.
+@param[in] threadCount
+    Maximum number of threads to use, including the calling thread
+    (0 means the number of hardware threads).
+
+@returns
+    Resulting trace type and optional metadata stream UUID pair.
+
+@throws TextParseError
+    An error occurred while parsing the document.
+*/
+inline FromMetadataTextReturn fromMetadataText(const std::string& text, const Size threadCount)
+{
+    return fromMetadataText(text.data(), text.data() + text.size(), threadCount);
+}
+
 } // namespace yactfr
 
 #endif // YACTFR_METADATA_FROM_METADATA_TEXT_HPP
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_METADATA_INCR_METADATA_TEXT_PARSER_HPP
+#define YACTFR_METADATA_INCR_METADATA_TEXT_PARSER_HPP
+
+#include <memory>
+#include <string>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include "../aliases.hpp"
+#include "trace-type.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class IncrMetadataTextParserImpl;
+
+} // namespace internal
+
+/*!
+@brief
+    Incremental metadata text parser.
+
+@ingroup metadata
+
+An incremental metadata text parser parses an initial metadata text,
+like fromMetadataText() does, and then parses metadata texts which
+the producer appends to the same metadata stream, for example during an
+LTTng live session, <em>adding</em> the new
+\link EventRecordType event record types\endlink to the existing
+\link DataStreamType data stream types\endlink of its trace type
+instead of building a new trace type.
+
+An appended CTF&nbsp;1.8 metadata text may only contain data type
+aliases and \c event blocks. An appended CTF&nbsp;2 metadata text may
+only contain field class alias and event record class fragments (no
+preamble fragment). An appended metadata text may use the data type
+aliases of the previous metadata texts.
+
+The trace type of an incremental metadata text parser keeps its
+existing data stream and event record types: element sequences and
+element sequence iterators which use it remain valid. When possible,
+appendMetadataText() also extends the internal packet procedure of the
+trace type in place so that existing element sequence iterators may
+decode the event records of the new types without restarting. This
+isn't possible when:
+
+- The event record header type of the data stream type doesn't
+  contain an event record type ID (the data stream type contained a
+  single event record type).
+
+- The length/selector type of a dynamic-length, variant, or optional
+  type of a new event record type is outside said event record type.
+
+In those cases, existing element sequence iterators keep decoding
+with the previous event record types only (they throw
+UnknownEventRecordTypeDecodingError when they reach an event record of
+a new type) while new element sequence iterators decode with all of
+them.
+
+@note
+    You must not call appendMetadataText() while an element sequence
+    iterator of traceType() is decoding in another thread.
+*/
+class IncrementalMetadataTextParser final :
+    boost::noncopyable
+{
+public:
+    /*!
+    @brief
+        Builds an incremental metadata text parser, parsing the initial
+        metadata text from \p begin to \p end.
+
+    This constructor automatically discovers whether the text between
+    \p begin and \p end is a CTF&nbsp;1.8 or CTF&nbsp;2 metadata text.
+
+    @param[in] begin
+        Beginning of initial metadata text.
+    @param[in] end
+        End of initial metadata text.
+
+    @throws TextParseError
+        An error occurred while parsing the document.
+    */
+    explicit IncrementalMetadataTextParser(const char *begin, const char *end);
+
+    /*!
+    @brief
+        Builds an incremental metadata text parser, parsing the initial
+        metadata text \p text.
+
+    @param[in] text
+        Initial metadata text.
+
+    @throws TextParseError
+        An error occurred while parsing the document.
+    */
+    explicit IncrementalMetadataTextParser(const std::string& text);
+
+    ~IncrementalMetadataTextParser();
+
+    /*!
+    @brief
+        Trace type.
+
+    This parser owns the returned trace type: it must exist as long as
+    you use the trace type.
+    */
+    const TraceType& traceType() const noexcept;
+
+    /// Metadata stream UUID of the initial metadata text, if any.
+    const boost::optional<boost::uuids::uuid>& metadataStreamUuid() const noexcept;
+
+    /*!
+    @brief
+        Parses the metadata text from \p begin to \p end, which follows
+        the metadata texts which this parser already parsed, adding its
+        event record types to traceType().
+
+    @param[in] begin
+        Beginning of appended metadata text.
+    @param[in] end
+        End of appended metadata text.
+
+    @returns
+        Number of new event record types.
+
+    @throws TextParseError
+        An error occurred while parsing the document. In that case,
+        traceType() and this parser remain as they were before calling
+        this method. The text locations of the error are relative to
+        \p begin.
+    */
+    Size appendMetadataText(const char *begin, const char *end);
+
+    /*!
+    @brief
+        Parses the metadata text \p text, which follows the metadata
+        texts which this parser already parsed, adding its event record
+        types to traceType().
+
+    This method effectively calls
+    appendMetadataText(const char *, const char *), therefore refer to
+    its documentation.
+
+    @param[in] text
+        Appended metadata text.
+
+    @returns
+        Number of new event record types.
+
+    @throws TextParseError
+        An error occurred while parsing the document.
+    */
+    Size appendMetadataText(const std::string& text)
+    {
+        return this->appendMetadataText(text.data(), text.data() + text.size());
+    }
+
+private:
+    const std::unique_ptr<internal::IncrMetadataTextParserImpl> _pimpl;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_METADATA_INCR_METADATA_TEXT_PARSER_HPP
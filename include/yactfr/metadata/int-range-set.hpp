@@ -9,12 +9,18 @@
 #define YACTFR_METADATA_INT_RANGE_SET_HPP
 
 #include <cassert>
+#include <memory>
 #include <set>
 #include <type_traits>
 
 #include "int-range.hpp"
 
 namespace yactfr {
+namespace internal {
+
+class DtContentPool;
+
+} // namespace internal
 
 /*!
 @brief
@@ -25,6 +31,8 @@ namespace yactfr {
 An integer range set is a set of
 \link IntegerRange integer ranges\endlink.
 
+An integer range set is immutable: its copies share the same ranges.
+
 @tparam ValueT
     Type of the lower and upper values of contained integer ranges.
 @tparam ValidatePreconditionsV
@@ -34,6 +42,8 @@ An integer range set is a set of
 template <typename ValueT, bool ValidatePreconditionsV = true>
 class IntegerRangeSet final
 {
+    friend class internal::DtContentPool;
+
 public:
     /// Type of the lower and upper values of contained integer ranges.
     using Value = ValueT;
@@ -46,7 +56,8 @@ public:
     @brief
         Builds an empty integer range set.
     */
-    explicit IntegerRangeSet()
+    explicit IntegerRangeSet() :
+        _ranges {std::make_shared<const std::set<Range>>()}
     {
     }
 
@@ -58,8 +69,8 @@ public:
     @param[in] ranges
         Integer ranges of this integer range set.
     */
-    explicit IntegerRangeSet(const std::set<Range> ranges) :
-        _ranges {std::move(ranges)}
+    explicit IntegerRangeSet(std::set<Range> ranges) :
+        _ranges {std::make_shared<const std::set<Range>>(std::move(ranges))}
     {
     }
 
@@ -78,19 +89,19 @@ public:
     /// Ranges of this integer range set.
     const std::set<Range>& ranges() const noexcept
     {
-        return _ranges;
+        return *_ranges;
     }
 
     /// Range set iterator at the first range of this set.
     typename std::set<Range>::const_iterator begin() const noexcept
     {
-        return _ranges.begin();
+        return _ranges->begin();
     }
 
     /// Range set iterator \em after the last range of this set.
     typename std::set<Range>::const_iterator end() const noexcept
     {
-        return _ranges.end();
+        return _ranges->end();
     }
 
     /*!
@@ -108,7 +119,7 @@ public:
     bool contains(const Value value) const noexcept
     {
         // check all contained ranges
-        for (auto& range : _ranges) {
+        for (auto& range : *_ranges) {
             if (range.contains(value)) {
                 return true;
             }
@@ -132,7 +143,7 @@ public:
     */
     bool intersects(const IntegerRangeSet& other) const noexcept
     {
-        for (auto& range : _ranges) {
+        for (auto& range : *_ranges) {
             for (auto& otherRange : other.ranges()) {
                 if (range.intersects(otherRange)) {
                     return true;
@@ -155,7 +166,7 @@ public:
     */
     bool operator==(const IntegerRangeSet& other) const noexcept
     {
-        return other.ranges() == _ranges;
+        return _ranges == other._ranges || *_ranges == *other._ranges;
     }
 
     /*!
@@ -187,7 +198,7 @@ public:
     */
     bool operator<(const IntegerRangeSet& other) const noexcept
     {
-        if (_ranges < other._ranges) {
+        if (*_ranges < *other._ranges) {
             return true;
         }
 
@@ -195,7 +206,13 @@ public:
     }
 
 private:
-    std::set<Range> _ranges;
+    explicit IntegerRangeSet(std::shared_ptr<const std::set<Range>> ranges) :
+        _ranges {std::move(ranges)}
+    {
+    }
+
+private:
+    std::shared_ptr<const std::set<Range>> _ranges;
 };
 
 } // namespace yactfr
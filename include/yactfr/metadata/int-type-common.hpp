@@ -11,11 +11,14 @@
 #include <cassert>
 #include <set>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <type_traits>
 #include <boost/optional/optional.hpp>
 
+#include <yactfr/internal/metadata/dt-content.hpp>
+
 #include "bo.hpp"
 #include "dt.hpp"
 #include "int-range-set.hpp"
@@ -66,7 +69,7 @@ public:
 protected:
     explicit IntegerTypeCommon(const DisplayBase prefDispBase, Mappings&& mappings) :
         _prefDispBase {prefDispBase},
-        _mappings {std::move(mappings)}
+        _mappings {internal::internIntTypeMappings(std::move(mappings))}
     {
         assert(this->_mappingsAreValid());
     }
@@ -81,13 +84,13 @@ public:
     /// Mappings.
     const Mappings& mappings() const noexcept
     {
-        return _mappings;
+        return *_mappings;
     }
 
     /// Constant mapping iterator set at the first mapping of this type.
     typename Mappings::const_iterator begin() const noexcept
     {
-        return _mappings.begin();
+        return _mappings->begin();
     }
 
     /*!
@@ -97,7 +100,7 @@ public:
     */
     typename Mappings::const_iterator end() const noexcept
     {
-        return _mappings.end();
+        return _mappings->end();
     }
 
     /*!
@@ -113,9 +116,9 @@ public:
     */
     const MappingRangeSet *operator[](const std::string& name) const noexcept
     {
-        const auto it = _mappings.find(name);
+        const auto it = _mappings->find(name);
 
-        if (it == _mappings.end()) {
+        if (it == _mappings->end()) {
             return nullptr;
         }
 
@@ -136,7 +139,7 @@ public:
     */
     bool valueIsMapped(const MappingValueT value) const
     {
-        for (const auto& nameRangeSetPair : _mappings) {
+        for (const auto& nameRangeSetPair : *_mappings) {
             if (nameRangeSetPair.second.contains(value)) {
                 return true;
             }
@@ -162,7 +165,7 @@ public:
     void mappingNamesForValue(const MappingValueT value,
                               std::unordered_set<const std::string *>& names) const
     {
-        for (auto& nameRangesPair : _mappings) {
+        for (auto& nameRangesPair : *_mappings) {
             if (nameRangesPair.second.contains(value)) {
                 names.insert(&nameRangesPair.first);
             }
@@ -173,13 +176,13 @@ protected:
     bool _isEqual(const IntegerTypeCommon& other) const noexcept
     {
         return _prefDispBase == other._prefDispBase &&
-               _mappings == other._mappings;
+               *_mappings == *other._mappings;
     }
 
 private:
     bool _mappingsAreValid() noexcept
     {
-        for (const auto& nameRangeSetPair : _mappings) {
+        for (const auto& nameRangeSetPair : *_mappings) {
             if (nameRangeSetPair.second.ranges().empty()) {
                 return false;
             }
@@ -190,7 +193,9 @@ private:
 
 private:
     const DisplayBase _prefDispBase;
-    const Mappings _mappings;
+
+    // shared with equal mappings of other integer types
+    const std::shared_ptr<const Mappings> _mappings;
 };
 
 namespace internal {
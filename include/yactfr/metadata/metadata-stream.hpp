@@ -14,6 +14,11 @@
 #include <memory>
 
 namespace yactfr {
+namespace internal {
+
+class MetadataStreamDecoder;
+
+} // namespace internal
 
 /*!
 @brief
@@ -71,6 +76,59 @@ metadata stream. This function doesn't seek within \p stream.
 */
 std::unique_ptr<const MetadataStream> createMetadataStream(std::istream& stream);
 
+/*!
+@brief
+    Builds a metadata stream object by decoding the whole stream
+    from \p begin to \p end.
+
+@ingroup metadata_stream
+
+Like createMetadataStream(std::istream&), but decodes the metadata
+stream in place: this function walks the packet headers of a
+packetized metadata stream directly within the range, copying each
+packet content once into the resulting metadata text, and copies a
+plain text metadata stream once as a whole.
+
+Only this function uses the range: it doesn't belong to the returned
+metadata stream.
+
+@param[in] begin
+    Beginning of the metadata stream to decode.
+@param[in] end
+    End of the metadata stream to decode.
+
+@throws InvalidMetadataStream
+    The content of the metadata stream is invalid.
+*/
+std::unique_ptr<const MetadataStream> createMetadataStream(const char *begin, const char *end);
+
+/*!
+@brief
+    Builds a metadata stream object by decoding the whole metadata
+    stream file \p path.
+
+@ingroup metadata_stream
+
+This function memory-maps the file \p path and decodes it like
+createMetadataStream(const char *, const char *) does, without any
+intermediate input stream. Prefer this function to
+createMetadataStream(std::istream&) to open a large metadata stream
+file.
+
+Only this function uses the file: you may modify or remove it once
+this function returns.
+
+@param[in] path
+    Path of the metadata stream file to decode (\em not a metadata
+    text).
+
+@throws IOError
+    An I/O error occurred.
+@throws InvalidMetadataStream
+    The content of the metadata stream is invalid.
+*/
+std::unique_ptr<const MetadataStream> createMetadataStream(const std::string& path);
+
 } // namespace yactfr
 
 #endif // YACTFR_METADATA_METADATA_STREAM_HPP
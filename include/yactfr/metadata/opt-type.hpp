@@ -225,7 +225,7 @@ protected:
                                              DataLocation&& selLoc, SelectorRangeSet&& selRanges,
                                              MapItem::Up attrs) :
         OptionalType {kind, minAlign, std::move(dt), std::move(selLoc), std::move(attrs)},
-        _selRanges {std::move(selRanges)}
+        _selRanges {internal::internIntRangeSet(selRanges)}
     {
     }
 
@@ -237,6 +237,7 @@ public:
     }
 
 private:
+    // shared with equal selector ranges of other data types
     const SelectorRangeSet _selRanges;
 };
 
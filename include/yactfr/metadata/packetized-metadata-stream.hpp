@@ -13,6 +13,7 @@
 
 #include "../aliases.hpp"
 #include "bo.hpp"
+#include "metadata-stream.hpp"
 
 namespace yactfr {
 
@@ -25,7 +26,7 @@ namespace yactfr {
 class PacketizedMetadataStream final :
     public MetadataStream
 {
-    friend std::unique_ptr<const MetadataStream> createMetadataStream(std::istream&);
+    friend class internal::MetadataStreamDecoder;
 
 private:
     explicit PacketizedMetadataStream(std::string text, Size pktCount, unsigned int majorVersion,
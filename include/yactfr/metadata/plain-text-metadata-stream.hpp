@@ -27,7 +27,7 @@ A plain text metadata stream is roughly a string container.
 class PlainTextMetadataStream final :
     public MetadataStream
 {
-    friend std::unique_ptr<const MetadataStream> createMetadataStream(std::istream&);
+    friend class internal::MetadataStreamDecoder;
 
 private:
     explicit PlainTextMetadataStream(std::string text);
@@ -180,7 +180,9 @@ private:
     mutable boost::optional<std::string> _dispName;
     const std::string _name;
     const DataType::Up _dt;
-    const MapItem::Up _attrs;
+
+    // shared with equal attributes of other structure member types
+    const std::shared_ptr<const MapItem> _attrs;
 };
 
 } // namespace yactfr
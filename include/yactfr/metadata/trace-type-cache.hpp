@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_METADATA_TRACE_TYPE_CACHE_HPP
+#define YACTFR_METADATA_TRACE_TYPE_CACHE_HPP
+
+#include <string>
+#include <boost/noncopyable.hpp>
+
+#include "from-metadata-text.hpp"
+
+namespace yactfr {
+
+/*!
+@brief
+    On-disk cache of trace types.
+
+@ingroup metadata
+
+A trace type cache is a directory which contains the binary forms of
+trace and metadata stream UUID pairs which fromMetadataText() built,
+each one named after a hash of its metadata text.
+
+fromMetadataText(const char *, const char *) const returns the same
+trace type and metadata stream UUID as
+yactfr::fromMetadataText(const char *, const char *) would, but loads
+it from the cache directory when possible, which is much faster than
+parsing the metadata text. Otherwise, it parses the metadata text and
+then tries to save the result to the cache directory for the next call.
+
+A cache file is only used when it contains the exact same metadata text
+and when a yactfr library having the same binary format version wrote
+it: any other cache file is ignored and overwritten.
+
+A cache failure (cache directory which doesn't exist, permission
+denied, invalid cache file, and so on) never makes
+fromMetadataText(const char *, const char *) const fail: it then only
+parses the metadata text.
+
+@note
+    The cache doesn't contain the internal packet procedure of a trace
+    type: like with a trace type which
+    yactfr::fromMetadataText(const char *, const char *) returns, an
+    element sequence iterator builds it once when it needs it.
+*/
+class TraceTypeCache final :
+    boost::noncopyable
+{
+public:
+    /*!
+    @brief
+        Builds a trace type cache which uses the existing directory
+        \p directoryPath.
+
+    @param[in] directoryPath
+        Path of the cache directory.
+    */
+    explicit TraceTypeCache(std::string directoryPath);
+
+    /// Path of the cache directory.
+    const std::string& directoryPath() const noexcept
+    {
+        return _dirPath;
+    }
+
+    /*!
+    @brief
+        Returns the trace type and metadata stream UUID pair of the
+        metadata text from \p begin to \p end, loading it from the
+        cache directory if possible.
+
+    @param[in] begin
+        Beginning of metadata text.
+    @param[in] end
+        End of metadata text.
+
+    @returns
+        Resulting trace type and optional metadata stream UUID pair.
+
+    @throws TextParseError
+        An error occurred while parsing the document.
+    */
+    FromMetadataTextReturn fromMetadataText(const char *begin, const char *end) const;
+
+    /*!
+    @brief
+        Returns the trace type and metadata stream UUID pair of the
+        metadata text \p text, loading it from the cache directory if
+        possible.
+
+    This method effectively calls
+    fromMetadataText(const char *, const char *) const, therefore
+    refer to its documentation.
+
+    @param[in] text
+        Metadata text.
+
+    @returns
+        Resulting trace type and optional metadata stream UUID pair.
+
+    @throws TextParseError
+        An error occurred while parsing the document.
+    */
+    FromMetadataTextReturn fromMetadataText(const std::string& text) const
+    {
+        return this->fromMetadataText(text.data(), text.data() + text.size());
+    }
+
+    /*!
+    @brief
+        Path of the cache file of the metadata text from \p begin
+        to \p end.
+
+    This file doesn't necessarily exist.
+
+    @param[in] begin
+        Beginning of metadata text.
+    @param[in] end
+        End of metadata text.
+
+    @returns
+        Path of the cache file of the metadata text from \p begin
+        to \p end.
+    */
+    std::string filePath(const char *begin, const char *end) const;
+
+private:
+    std::string _dirPath;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_METADATA_TRACE_TYPE_CACHE_HPP
@@ -47,6 +47,9 @@ struct DstIdComp final
 
 } // namespace internal
 
+class DataLocation;
+class FieldHandle;
+
 /*!
 @brief
     Set of clock types with unique internal IDs.
@@ -297,6 +300,67 @@ public:
     /// Whether or not this type is empty (has no data stream types).
     bool isEmpty() const noexcept;
 
+    /*!
+    @brief
+        Returns a handle of the boolean or integer field at the data
+        location \p location within the data streams which
+        \p dataStreamType describes, or \c nullptr if there's none.
+
+    \p location may only target a field of the packet header, packet
+    context, event record header, or event record common context
+    scope.
+
+    The returned field handle remains valid as long as this trace type
+    exists. Calling this method again with an equivalent location
+    returns the same field handle.
+
+    Path elements of \p location may cross arrays (the value of the
+    field is then the one of its last decoded element) and variants
+    (the field handle then targets the fields of all the options
+    having the remaining path).
+
+    Only the element sequence iterators which you create after having
+    created a field handle may provide its values (see
+    ElementSequenceIterator::fieldValue()).
+
+    Creating a field handle while an element sequence iterator of this
+    trace type is running on another thread is \em not safe.
+
+    @param[in] dataStreamType
+        Data stream type of this type which contains the field.
+    @param[in] location
+        Location of the boolean or integer field.
+
+    @returns
+        Field handle of \p location, or \c nullptr if \p location
+        doesn't target at least one boolean or integer field.
+    */
+    const FieldHandle *fieldHandle(const DataStreamType& dataStreamType,
+                                   const DataLocation& location) const;
+
+    /*!
+    @brief
+        Returns a handle of the boolean or integer field at the data
+        location \p location within the event records which
+        \p eventRecordType describes, or \c nullptr if there's none.
+
+    This method is the same as
+    fieldHandle(const DataStreamType&, const DataLocation&) const,
+    except that \p location may also target a field of the event
+    record specific context or payload scope.
+
+    @param[in] eventRecordType
+        Event record type of this type which contains the field.
+    @param[in] location
+        Location of the boolean or integer field.
+
+    @returns
+        Field handle of \p location, or \c nullptr if \p location
+        doesn't target at least one boolean or integer field.
+    */
+    const FieldHandle *fieldHandle(const EventRecordType& eventRecordType,
+                                   const DataLocation& location) const;
+
 private:
     const std::unique_ptr<internal::TraceTypeImpl> _pimpl;
 };
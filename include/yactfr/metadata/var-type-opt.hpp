@@ -15,6 +15,7 @@
 #include <boost/optional.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <yactfr/internal/metadata/dt-content.hpp>
 #include <yactfr/internal/metadata/utils.hpp>
 
 #include "dt.hpp"
@@ -79,8 +80,8 @@ public:
                                MapItem::Up attributes = nullptr) :
         _name {std::move(name)},
         _dt {std::move(dataType)},
-        _selRanges {std::move(selectorRanges)},
-        _attrs {std::move(attributes)}
+        _selRanges {internal::internIntRangeSet(selectorRanges)},
+        _attrs {internal::internAttrs(std::move(attributes))}
     {
     }
 
@@ -229,8 +230,10 @@ private:
     const boost::optional<std::string> _name;
     mutable boost::optional<std::string> _dispName;
     const DataType::Up _dt;
+
+    // shared with equal contents of other variant type options
     const SelectorRangeSet _selRanges;
-    const MapItem::Up _attrs;
+    const std::shared_ptr<const MapItem> _attrs;
 };
 
 /*!
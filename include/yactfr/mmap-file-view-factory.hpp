@@ -9,7 +9,9 @@
 #define YACTFR_MMAP_FILE_VIEW_FACTORY_HPP
 
 #include <memory>
+#include <chrono>
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 #include <string>
 
 #include "data-src-factory.hpp"
@@ -111,6 +113,205 @@ public:
     */
     void expectedAccessPattern(AccessPattern expectedAccessPattern) noexcept;
 
+    /// Whether or not future memory maps are pre-faulted.
+    bool prefaultPages() const noexcept;
+
+    /*!
+    @brief
+        Sets whether or not future memory maps are pre-faulted to
+        \p prefaultPages.
+
+    When enabled, each memory map operation populates (prefaults) the
+    page tables of the whole mapped region (\c MAP_POPULATE on Linux).
+    This makes the memory map operation itself slower, but removes page
+    faults when the VM then reads the data. This is worth it when the
+    file data is already in the page cache.
+
+    This setting has no effect on platforms which don't support it.
+
+    Note that this setting only applies to memory map operations
+    performed \em after this call, by any data source created by this
+    factory.
+
+    @param[in] prefaultPages
+        \c true to pre-fault future memory maps.
+    */
+    void prefaultPages(bool prefaultPages) noexcept;
+
+    /// Whether or not future memory maps are advised to use huge pages.
+    bool adviseHugePages() const noexcept;
+
+    /*!
+    @brief
+        Sets whether or not future memory maps are advised to use huge
+        pages to \p adviseHugePages.
+
+    When enabled, each memory map operation advises the kernel to back
+    the mapped region with transparent huge pages
+    (\c MADV_HUGEPAGE on Linux). This reduces TLB misses and page
+    faults for files which live in a filesystem supporting huge pages
+    in its page cache (tmpfs, for example). For other files, this is
+    a harmless hint.
+
+    This setting has no effect on platforms which don't support it.
+
+    Note that this setting only applies to memory map operations
+    performed \em after this call, by any data source created by this
+    factory.
+
+    @param[in] adviseHugePages
+        \c true to advise future memory maps to use huge pages.
+    */
+    void adviseHugePages(bool adviseHugePages) noexcept;
+
+    /// Whether or not the region following a memory map is read ahead.
+    bool readAheadNextRegion() const noexcept;
+
+    /*!
+    @brief
+        Sets whether or not the file region following the current
+        memory map of a data source is read ahead to
+        \p readAheadNextRegion.
+
+    When enabled, a memory mapped file view which reaches the last
+    quarter of its current memory map advises the kernel that it will
+    soon need the file region which follows
+    (\c POSIX_FADV_WILLNEED), so that the kernel starts reading it into
+    the page cache before the view maps it.
+
+    This setting has no effect on platforms which don't support it.
+
+    @param[in] readAheadNextRegion
+        \c true to read ahead the region following the current memory
+        map of a data source.
+    */
+    void readAheadNextRegion(bool readAheadNextRegion) noexcept;
+
+    /// Whether or not data sources drop the data they moved past.
+    bool dropBehind() const noexcept;
+
+    /*!
+    @brief
+        Sets whether or not the data sources of this factory drop the
+        data which their element sequence iterator moved past to
+        \p dropBehind.
+
+    When enabled, each time an element sequence iterator reaches the
+    end of a packet, its memory mapped file view drops the pages of the
+    file regions before this point from its memory map
+    (\c MADV_DONTNEED) and from the page cache
+    (\c POSIX_FADV_DONTNEED). This keeps the resident set of a
+    sequential scan of a whole data stream constant-size, and avoids
+    evicting the hot pages of other processes from the page cache.
+
+    Prefer not enabling this if you expect to revisit data (seeking
+    packets, restoring iterator positions, or iterating the same
+    element sequence with many iterators): a memory mapped file view
+    must read dropped data from the file again.
+
+    This setting has no effect on platforms which don't support it.
+
+    @param[in] dropBehind
+        \c true to make the data sources of this factory drop the data
+        which their element sequence iterator moved past.
+    */
+    void dropBehind(bool dropBehind) noexcept;
+
+    /// Whether or not the data sources of this factory follow the file.
+    bool followFile() const noexcept;
+
+    /*!
+    @brief
+        Sets whether or not the data sources of this factory follow the
+        file, which another process could be writing to, to
+        \p followFile.
+
+    When disabled (the default), the size of the file is the one it
+    had when you built this factory, and a memory mapped file view
+    indicates that there's no more data at the end of the file: the
+    element sequence iterator reaches its end.
+
+    When enabled, a memory mapped file view which reaches the current
+    end of the file first checks whether or not the file grew. If it
+    didn't, then the view throws DataNotAvailable, which
+    ElementSequenceIterator::operator++() and
+    ElementSequence::begin() propagate. This includes the case where
+    the end of the file is in the middle of a partially written
+    packet. You can then wait for the file to grow with
+    waitForFileGrowth() or with fileChangeFd(), and resume by
+    calling ElementSequenceIterator::operator++() again: the iterator
+    continues exactly where it stopped.
+
+    Disable this mode when you know the file won't grow anymore
+    (the writer closed it, for example) so that your iterator can
+    reach its end.
+
+    @param[in] followFile
+        \c true to make the data sources of this factory follow the
+        file.
+    */
+    void followFile(bool followFile) noexcept;
+
+    /*!
+    @brief
+        Returns a file descriptor which becomes readable when the
+        file changes, or -1 if this platform doesn't support it.
+
+    This is useful to wait for more data, when following the file
+    (see followFile()), with your own event loop (\c poll(),
+    \c epoll(), and the rest). When this file descriptor becomes
+    readable, call updateFileSize().
+
+    This factory owns the returned file descriptor: don't close it.
+
+    @returns
+        File descriptor (an inotify instance on Linux) which becomes
+        readable when the file changes, or -1 if not supported.
+
+    @throws IOError
+        Cannot create the file descriptor.
+    */
+    int fileChangeFd();
+
+    /*!
+    @brief
+        Updates the known size of the file from its current status,
+        returning whether or not the file grew.
+
+    This method also discards the pending events of the file
+    descriptor which fileChangeFd() returns.
+
+    @returns
+        \c true if the file grew.
+
+    @throws IOError
+        Cannot get the file status.
+    */
+    bool updateFileSize();
+
+    /*!
+    @brief
+        Blocks until the file grows or until \p timeout elapses,
+        returning whether or not the file grew.
+
+    Call this when a data source of this factory throws
+    DataNotAvailable while following the file (see followFile()).
+
+    This method doesn't poll the file status repeatedly on platforms
+    where fileChangeFd() is supported.
+
+    @param[in] timeout
+        Maximum duration to wait, or \c boost::none to wait
+        indefinitely.
+
+    @returns
+        \c true if the file grew, or \c false if \p timeout elapsed.
+
+    @throws IOError
+        Cannot get the file status or wait for changes.
+    */
+    bool waitForFileGrowth(const boost::optional<std::chrono::milliseconds>& timeout = boost::none);
+
 private:
     DataSource::Up _createDataSource() override;
 
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_SHM_RING_DATA_SRC_FACTORY_HPP
+#define YACTFR_SHM_RING_DATA_SRC_FACTORY_HPP
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <boost/noncopyable.hpp>
+
+#include "data-src-factory.hpp"
+#include "aliases.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class ShmRingDataSrcFactoryImpl;
+
+} // namespace internal
+
+/*!
+@brief
+    Header of a shared memory packet ring.
+
+@ingroup element_seq
+
+A shared memory packet ring is a POSIX shared memory object which a
+single producer (a tracer, for example) fills with packets and which
+one or more consumers (SharedMemoryRingDataSourceFactory data sources)
+read without copying them.
+
+The layout of the shared memory object is:
+
+-# This header, at offset 0.
+
+-# maxConsumerCount consumer position entries, the first one
+   at consumersOffset(), each one being an
+   <code>std::atomic<std::uint64_t></code> in its own
+   #lineSize-byte line (see consumerOffset()).
+
+   A consumer position entry is either #freeConsumerPosition (unused),
+   or the sequence number of the oldest packet which the corresponding
+   consumer still needs.
+
+-# slotCount packet slots, the first one at slotsOffset(), each one
+   being an <code>std::uint64_t</code> packet size (bytes), followed by
+   the packet data at offset #lineSize within the slot (see
+   slotOffset()).
+
+The packet having the sequence number \em N (the first published packet
+has the sequence number 0) lives in the slot <em>N</em> mod slotCount.
+
+Producer protocol (all the atomic operations are sequentially
+consistent):
+
+-# Initialize the header and set all the consumer position entries to
+   #freeConsumerPosition.
+
+-# To publish the packet \em N (the current value of
+   publishedCount): make sure that no consumer position entry \em P
+   (other than #freeConsumerPosition) is such that
+   <em>N</em> − \em P ≥ slotCount (otherwise, the ring is full: try
+   again later), write the packet size and data to its slot, and then
+   set publishedCount to <em>N</em> + 1.
+
+-# When done, set isClosed to 1.
+
+Consumers only read the slots of the published packets, and only write
+their own consumer position entry: both sides are lock-free.
+*/
+struct SharedMemoryRingHeader final
+{
+    /// Expected value of #magic.
+    static constexpr std::uint64_t expectedMagic = 0x676e697272746379ULL;
+
+    /// Expected value of #version.
+    static constexpr std::uint32_t expectedVersion = 1;
+
+    /// Value of an unused consumer position entry.
+    static constexpr std::uint64_t freeConsumerPosition = ~0ULL;
+
+    /// Size of a line (bytes): alignment of all the layout parts.
+    static constexpr std::uint64_t lineSize = 64;
+
+    /// Magic number (#expectedMagic).
+    std::uint64_t magic;
+
+    /// Layout version (#expectedVersion).
+    std::uint32_t version;
+
+    /// Number of consumer position entries.
+    std::uint32_t maxConsumerCount;
+
+    /// Number of packet slots.
+    std::uint64_t slotCount;
+
+    /// Maximum size of a packet (bytes).
+    std::uint64_t slotSize;
+
+    /// Number of published packets.
+    alignas(lineSize) std::atomic<std::uint64_t> publishedCount;
+
+    /// 1 if the producer won't publish packets anymore.
+    std::atomic<std::uint32_t> isClosed;
+
+    /// Offset of the first consumer position entry.
+    static constexpr std::uint64_t consumersOffset() noexcept
+    {
+        return (sizeof(SharedMemoryRingHeader) + lineSize - 1) & ~(lineSize - 1);
+    }
+
+    /// Offset of the consumer position entry at index \p index.
+    static constexpr std::uint64_t consumerOffset(const std::uint64_t index) noexcept
+    {
+        return consumersOffset() + index * lineSize;
+    }
+
+    /// Offset of the first packet slot.
+    std::uint64_t slotsOffset() const noexcept
+    {
+        return consumerOffset(maxConsumerCount);
+    }
+
+    /// Size of a packet slot, including its packet size (bytes).
+    std::uint64_t slotStride() const noexcept
+    {
+        return lineSize + ((slotSize + lineSize - 1) & ~(lineSize - 1));
+    }
+
+    /// Offset of the packet slot at index \p index.
+    std::uint64_t slotOffset(const std::uint64_t index) const noexcept
+    {
+        return this->slotsOffset() + index * this->slotStride();
+    }
+
+    /// Total size of the shared memory object (bytes).
+    std::uint64_t segmentSize() const noexcept
+    {
+        return this->slotOffset(slotCount);
+    }
+};
+
+/*!
+@brief
+    Shared memory packet ring data source factory.
+
+@ingroup element_seq
+
+This is a factory of data sources which read the packets of a shared
+memory packet ring (see SharedMemoryRingHeader) which a producer fills
+live.
+
+The element sequence of such a data source is the concatenation of
+the packets which it reads. A data source starts with the oldest packet
+which it can safely read when you create it, and then follows the
+published packets in order, exposing each packet as
+\link DataBlock data blocks\endlink without copying it.
+
+A data source throws DataNotAvailable (or reports it with
+DataSource::tryData(), see ElementSequenceIterator::tryAdvance()) when
+it caught up with the producer, and indicates that there's no more
+data once the producer closed the ring.
+
+Each data source occupies a consumer position entry of the ring while
+it exists: the producer never overwrites a packet which an existing
+data source still needs. A data source releases a packet as soon as its
+element sequence iterator reaches its end. Therefore, don't
+restore an iterator position or seek a packet located before the
+current packet of an iterator, and don't copy an iterator: the copy
+gets its own data source, even with
+ElementSequence::iteratorCopiesShareDataSource(), of which the element
+sequence can start with another packet.
+*/
+class SharedMemoryRingDataSourceFactory final :
+    public DataSourceFactory,
+    boost::noncopyable
+{
+public:
+    /*!
+    @brief
+        Creates a shared memory packet ring data source factory which
+        can create data sources reading the ring of the POSIX shared
+        memory object named \p name.
+
+    @param[in] name
+        Name of the POSIX shared memory object (see \c shm_open()).
+
+    @throws IOError
+        An I/O error occurred (shared memory object not found,
+        permission denied, invalid ring layout, and the rest).
+    */
+    explicit SharedMemoryRingDataSourceFactory(std::string name);
+
+private:
+    DataSource::Up _createDataSource() override;
+
+private:
+    /*
+     * Shared because data sources also keep a reference to keep the
+     * shared memory object mapped.
+     */
+    std::shared_ptr<internal::ShmRingDataSrcFactoryImpl> _pimpl;
+};
+
+} // namespace yactfr
+
+#endif // YACTFR_SHM_RING_DATA_SRC_FACTORY_HPP
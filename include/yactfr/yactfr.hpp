@@ -19,11 +19,16 @@
 #include "data-src-factory.hpp"
 #include "data-src.hpp"
 #include "decoding-errors.hpp"
+#include "elem-seq-it-checkpoint.hpp"
 #include "elem-seq-it-pos.hpp"
+#include "elem-seq-metrics.hpp"
 #include "elem-seq-it.hpp"
 #include "elem-seq.hpp"
 #include "elem-visitor.hpp"
 #include "elem.hpp"
+#include "er-columnar-exporter.hpp"
+#include "er-row-layout.hpp"
+#include "field-handle.hpp"
 #include "io-error.hpp"
 #include "metadata/aliases.hpp"
 #include "metadata/array-type.hpp"
@@ -48,6 +53,7 @@
 #include "metadata/fl-int-type.hpp"
 #include "metadata/from-metadata-text.hpp"
 #include "metadata/fwd.hpp"
+#include "metadata/incr-metadata-text-parser.hpp"
 #include "metadata/int-range-set.hpp"
 #include "metadata/int-range.hpp"
 #include "metadata/int-type-common.hpp"
@@ -66,11 +72,13 @@
 #include "metadata/struct-type.hpp"
 #include "metadata/trace-env.hpp"
 #include "metadata/trace-type.hpp"
+#include "metadata/trace-type-cache.hpp"
 #include "metadata/utils.hpp"
 #include "metadata/var-type-opt.hpp"
 #include "metadata/var-type.hpp"
 #include "metadata/vl-int-type.hpp"
 #include "mmap-file-view-factory.hpp"
+#include "shm-ring-data-src-factory.hpp"
 #include "text-parse-error.hpp"
 
 #endif // YACTFR_YACTFR_HPP
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_TESTS_SHM_RING_PRODUCER_HPP
+#define YACTFR_TESTS_SHM_RING_PRODUCER_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <new>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#include <yactfr/shm-ring-data-src-factory.hpp>
+
+/*
+ * Producer of a shared memory packet ring (see
+ * `yactfr::SharedMemoryRingHeader`).
+ *
+ * Creates the shared memory object on construction and removes it on
+ * destruction.
+ */
+class ShmRingProducer final
+{
+public:
+    explicit ShmRingProducer(std::string name, const std::uint32_t maxConsumerCount,
+                             const std::uint64_t slotCount, const std::uint64_t slotSize) :
+        _name {std::move(name)}
+    {
+        yactfr::SharedMemoryRingHeader tmpHeader;
+
+        tmpHeader.maxConsumerCount = maxConsumerCount;
+        tmpHeader.slotCount = slotCount;
+        tmpHeader.slotSize = slotSize;
+        _size = tmpHeader.segmentSize();
+
+        const auto fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+        if (fd < 0) {
+            throw std::runtime_error {"Cannot create shared memory object."};
+        }
+
+        if (ftruncate(fd, static_cast<off_t>(_size)) < 0) {
+            static_cast<void>(::close(fd));
+            static_cast<void>(shm_unlink(_name.c_str()));
+            throw std::runtime_error {"Cannot resize shared memory object."};
+        }
+
+        _addr = static_cast<std::uint8_t *>(mmap(nullptr, _size, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED, fd, 0));
+        static_cast<void>(::close(fd));
+
+        if (_addr == MAP_FAILED) {
+            static_cast<void>(shm_unlink(_name.c_str()));
+            throw std::runtime_error {"Cannot memory-map shared memory object."};
+        }
+
+        auto& header = *new (_addr) yactfr::SharedMemoryRingHeader;
+
+        header.magic = yactfr::SharedMemoryRingHeader::expectedMagic;
+        header.version = yactfr::SharedMemoryRingHeader::expectedVersion;
+        header.maxConsumerCount = maxConsumerCount;
+        header.slotCount = slotCount;
+        header.slotSize = slotSize;
+        header.publishedCount.store(0);
+        header.isClosed.store(0);
+
+        for (std::uint64_t index = 0; index < maxConsumerCount; ++index) {
+            new (this->_consumerPos(index)) std::atomic<std::uint64_t> {
+                yactfr::SharedMemoryRingHeader::freeConsumerPosition
+            };
+        }
+    }
+
+    ~ShmRingProducer()
+    {
+        static_cast<void>(munmap(_addr, _size));
+        static_cast<void>(shm_unlink(_name.c_str()));
+    }
+
+    /*
+     * Publishes the packet `data` of `size` bytes, returning `false`
+     * if the ring is full.
+     */
+    bool tryPublish(const std::uint8_t * const data, const std::size_t size)
+    {
+        auto& header = this->_header();
+        const auto seq = header.publishedCount.load();
+
+        if (size > header.slotSize) {
+            throw std::invalid_argument {"Packet is too large."};
+        }
+
+        for (std::uint64_t index = 0; index < header.maxConsumerCount; ++index) {
+            const auto pos = this->_consumerPos(index)->load();
+
+            if (pos != yactfr::SharedMemoryRingHeader::freeConsumerPosition &&
+                    seq - pos >= header.slotCount) {
+                return false;
+            }
+        }
+
+        const auto slot = _addr + header.slotOffset(seq % header.slotCount);
+        const std::uint64_t size64 = size;
+
+        std::memcpy(slot, &size64, sizeof size64);
+        std::memcpy(slot + yactfr::SharedMemoryRingHeader::lineSize, data, size);
+        header.publishedCount.store(seq + 1);
+        return true;
+    }
+
+    void close()
+    {
+        this->_header().isClosed.store(1);
+    }
+
+    // number of occupied consumer position entries
+    std::uint64_t consumerCount()
+    {
+        std::uint64_t count = 0;
+
+        for (std::uint64_t index = 0; index < this->_header().maxConsumerCount; ++index) {
+            if (this->_consumerPos(index)->load() !=
+                    yactfr::SharedMemoryRingHeader::freeConsumerPosition) {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+private:
+    yactfr::SharedMemoryRingHeader& _header()
+    {
+        return *reinterpret_cast<yactfr::SharedMemoryRingHeader *>(_addr);
+    }
+
+    std::atomic<std::uint64_t> *_consumerPos(const std::uint64_t index)
+    {
+        return reinterpret_cast<std::atomic<std::uint64_t> *>(_addr +
+            yactfr::SharedMemoryRingHeader::consumerOffset(index));
+    }
+
+private:
+    const std::string _name;
+    std::uint8_t *_addr;
+    std::size_t _size;
+};
+
+#endif // YACTFR_TESTS_SHM_RING_PRODUCER_HPP
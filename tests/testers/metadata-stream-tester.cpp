@@ -9,6 +9,9 @@
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <memory>
+#include <string>
 #include <stdexcept>
 #include <yactfr/yactfr.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -17,21 +20,45 @@ int main(const int argc, const char * const argv[])
 {
     assert(argc >= 3);
 
-    const auto useStdin = argv[1];
+    /*
+     * Mode:
+     *
+     * `0`:
+     *     Input file stream.
+     *
+     * `1`:
+     *     Standard input stream.
+     *
+     * `m`:
+     *     Memory range (whole file contents).
+     *
+     * `p`:
+     *     File path.
+     */
+    const auto mode = argv[1][0];
     const auto path = argv[2];
 
     try {
-        std::istream *stream;
-        std::ifstream file {argv[1]};
+        std::unique_ptr<const yactfr::MetadataStream> metaStream;
 
-        if (useStdin[0] == '1') {
-            stream = &std::cin;
+        if (mode == 'p') {
+            metaStream = yactfr::createMetadataStream(std::string {path});
+        } else if (mode == 'm') {
+            std::ifstream file {path, std::ios::binary};
+            std::ostringstream ss;
+
+            ss << file.rdbuf();
+
+            const auto data = ss.str();
+
+            metaStream = yactfr::createMetadataStream(data.data(), data.data() + data.size());
+        } else if (mode == '1') {
+            metaStream = yactfr::createMetadataStream(std::cin);
         } else {
-            file.open(path, std::ios::binary | std::ios::in);
-            stream = &file;
-        }
+            std::ifstream file {path, std::ios::binary | std::ios::in};
 
-        const auto metaStream = yactfr::createMetadataStream(*stream);
+            metaStream = yactfr::createMetadataStream(file);
+        }
 
         std::cout << "text-size=" << metaStream->text().size() <<
                      ",has-ctf-1-signature=" << metaStream->hasCtf1Signature();
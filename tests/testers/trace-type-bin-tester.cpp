@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <yactfr/yactfr.hpp>
+
+#include <yactfr/internal/metadata/trace-type-bin.hpp>
+
+namespace {
+
+bool dtsEq(const yactfr::DataType * const dt, const yactfr::DataType * const expectedDt)
+{
+    if (!dt || !expectedDt) {
+        return !dt && !expectedDt;
+    }
+
+    return *dt == *expectedDt;
+}
+
+/*
+ * Checks that the trace type `traceType`, decoded from the binary form
+ * of `expectedTraceType`, has the same data types, printing the
+ * mismatch, if any.
+ */
+bool checkTraceType(const yactfr::TraceType& traceType,
+                    const yactfr::TraceType& expectedTraceType)
+{
+    if (!dtsEq(traceType.packetHeaderType(), expectedTraceType.packetHeaderType())) {
+        std::cout << "Packet header type mismatch." << std::endl;
+        return false;
+    }
+
+    if (traceType.dataStreamTypes().size() != expectedTraceType.dataStreamTypes().size()) {
+        std::cout << "Data stream type count mismatch." << std::endl;
+        return false;
+    }
+
+    for (const auto& expectedDst : expectedTraceType) {
+        const auto dst = traceType[expectedDst->id()];
+
+        if (!dst || dst->size() != expectedDst->size() ||
+                !dtsEq(dst->packetContextType(), expectedDst->packetContextType()) ||
+                !dtsEq(dst->eventRecordHeaderType(), expectedDst->eventRecordHeaderType()) ||
+                !dtsEq(dst->eventRecordCommonContextType(),
+                       expectedDst->eventRecordCommonContextType())) {
+            std::cout << "Data stream type " << expectedDst->id() << " mismatch." << std::endl;
+            return false;
+        }
+
+        for (const auto& expectedErt : *expectedDst) {
+            const auto ert = (*dst)[expectedErt->id()];
+
+            if (!ert ||
+                    !dtsEq(ert->specificContextType(), expectedErt->specificContextType()) ||
+                    !dtsEq(ert->payloadType(), expectedErt->payloadType())) {
+                std::cout << "Event record type " << expectedErt->id() << " mismatch." <<
+                             std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int, const char * const argv[])
+{
+    try {
+        std::ifstream file {argv[1]};
+        const auto metadataStream = yactfr::createMetadataStream(file);
+        const auto& text = metadataStream->text();
+        const auto textBegin = text.data();
+        const auto textEnd = text.data() + text.size();
+        const auto ret = yactfr::fromMetadataText(textBegin, textEnd);
+        const auto bin = yactfr::internal::traceTypeToBin(*ret.first, ret.second, textBegin,
+                                                          textEnd);
+        const auto binRet = yactfr::internal::traceTypeFromBin(bin, textBegin, textEnd);
+
+        if (binRet.second != ret.second) {
+            std::cout << "Metadata stream UUID mismatch." << std::endl;
+            return 0;
+        }
+
+        if (!checkTraceType(*binRet.first, *ret.first)) {
+            return 0;
+        }
+
+        // everything else: the decoded trace type has the same binary form
+        if (yactfr::internal::traceTypeToBin(*binRet.first, binRet.second, textBegin,
+                                             textEnd) != bin) {
+            std::cout << "Binary form mismatch." << std::endl;
+        }
+    } catch (const std::exception& ex) {
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 0;
+}
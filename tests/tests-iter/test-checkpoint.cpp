@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+
+namespace {
+
+constexpr auto metadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "  packet.header := struct {"
+    "    u8 stream_id;"
+    "  };"
+    "};"
+    "clock { name = clk; };"
+    "typealias integer { size = 8; map = clock.clk.value; } := tick;"
+    "stream {"
+    "  id = 1;"
+    "  packet.context := struct {"
+    "    u16 packet_size;"
+    "    u16 content_size;"
+    "    u8 n;"
+    "  };"
+    "  event.header := struct {"
+    "    u8 id;"
+    "    tick ts;"
+    "  };"
+    "};"
+    "event {"
+    "  stream_id = 1;"
+    "  id = 0;"
+    "  fields := struct {"
+    "    u8 a[stream.packet.context.n];"
+    "    string s;"
+    "  };"
+    "};"
+    "event {"
+    "  stream_id = 1;"
+    "  id = 1;"
+    "  fields := struct {"
+    "    enum : u8 { X, Y } tag;"
+    "    variant <tag> {"
+    "      u8 X;"
+    "      u16 Y;"
+    "    } v;"
+    "  };"
+    "};"
+    "stream {"
+    "  id = 2;"
+    "  packet.context := struct {"
+    "    u16 packet_size;"
+    "    u16 content_size;"
+    "  };"
+    "};"
+    "event {"
+    "  stream_id = 2;"
+    "  fields := struct {"
+    "    u16 x;"
+    "  };"
+    "};";
+
+constexpr std::uint8_t stream[] = {
+    // packet header, packet context (stream 1, n = 2)
+    0x01, 0x00, 0xd0, 0x00, 0xb8, 0x02,
+
+    // event records
+    0x00, 0x10, 0xaa, 0xbb, 'h', 'i', 0x00,
+    0x01, 0x20, 0x01, 0x12, 0x34,
+    0x00, 0x30, 0x01, 0x02, 0x00,
+
+    // padding
+    0xff, 0xff, 0xff,
+
+    // packet header, packet context (stream 2)
+    0x02, 0x00, 0x48, 0x00, 0x48,
+
+    // event records
+    0xbe, 0xef,
+    0xca, 0xfe,
+
+    // packet header, packet context (stream 1, n = 0)
+    0x01, 0x00, 0x50, 0x00, 0x50, 0x00,
+
+    // event record
+    0x01, 0x05, 0x00, 0x7f,
+};
+
+// largest expected checkpoint data size (bytes)
+constexpr std::size_t maxCheckpointDataSize = 24;
+
+std::string elemStr(const yactfr::ElementSequenceIterator& it)
+{
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+
+    ss << it.offset() << ' ';
+    it->accept(printer);
+    return ss.str();
+}
+
+/*
+ * Returns the string of each remaining element of `it`.
+ */
+std::vector<std::string> remElemStrs(yactfr::ElementSequenceIterator& it,
+                                     const yactfr::ElementSequenceIterator& end)
+{
+    std::vector<std::string> strs;
+
+    for (; it != end; ++it) {
+        strs.push_back(elemStr(it));
+    }
+
+    return strs;
+}
+
+bool check(const bool cond, const std::size_t index, const char * const what)
+{
+    if (!cond) {
+        std::cerr << "Element #" << index << ": " << what << '\n';
+    }
+
+    return cond;
+}
+
+/*
+ * Small data blocks so that the VM decodes the event record again
+ * with many of them.
+ */
+constexpr std::size_t maxDataBlkSize = 3;
+
+bool testRestore(const yactfr::TraceType& traceType)
+{
+    MemDataSrcFactory factory {stream, sizeof stream, maxDataBlkSize};
+    yactfr::ElementSequence seq {traceType, factory};
+    auto it = seq.begin();
+    const auto expectedStrs = remElemStrs(it, seq.end());
+    yactfr::ElementSequenceIteratorCheckpoint checkpoint;
+    auto ok = true;
+
+    it = seq.begin();
+
+    for (std::size_t index = 0; index < expectedStrs.size(); ++index, ++it) {
+        it.saveCheckpoint(checkpoint);
+        ok = ok && check(checkpoint && checkpoint.offset() == it.offset(), index,
+                         "Unexpected checkpoint offset.");
+        ok = ok && check(checkpoint.data().size() <= maxCheckpointDataSize, index,
+                         "Checkpoint data is too large.");
+
+        // as if it came from another process
+        const yactfr::ElementSequenceIteratorCheckpoint otherCheckpoint {checkpoint.data()};
+
+        ok = ok && check(otherCheckpoint == checkpoint, index,
+                         "Checkpoint from data isn't equal.");
+
+        // restore with another element sequence, from an end iterator (no VM)
+        MemDataSrcFactory otherFactory {stream, sizeof stream, maxDataBlkSize};
+        yactfr::ElementSequence otherSeq {traceType, otherFactory};
+        auto otherIt = otherSeq.end();
+
+        otherIt.restoreCheckpoint(otherCheckpoint);
+        ok = ok && check(otherIt.offset() == it.offset(), index, "Unexpected restored offset.");
+
+        const std::vector<std::string> expectedRemStrs {expectedStrs.begin() + index,
+                                                        expectedStrs.end()};
+
+        ok = ok && check(remElemStrs(otherIt, otherSeq.end()) == expectedRemStrs, index,
+                         "Unexpected elements after restoring.");
+    }
+
+    return ok;
+}
+
+bool throwsInvalid(const yactfr::ElementSequenceIteratorCheckpoint::Data& data)
+{
+    try {
+        yactfr::ElementSequenceIteratorCheckpoint checkpoint {data};
+    } catch (const yactfr::InvalidElementSequenceIteratorCheckpoint&) {
+        return true;
+    }
+
+    return false;
+}
+
+bool testInvalid(const yactfr::TraceType& traceType)
+{
+    MemDataSrcFactory factory {stream, sizeof stream};
+    yactfr::ElementSequence seq {traceType, factory};
+    auto it = seq.begin();
+    yactfr::ElementSequenceIteratorCheckpoint checkpoint;
+
+    // first element of the payload of the first event record
+    for (auto i = 0; i < 20; ++i) {
+        ++it;
+    }
+
+    it.saveCheckpoint(checkpoint);
+
+    auto data = checkpoint.data();
+    auto ok = true;
+
+    // truncated data, unexpected format version, and trailing data
+    ok = ok && check(throwsInvalid({}), 0, "Empty data is valid.");
+    ok = ok && check(throwsInvalid({data.begin(), data.end() - 1}), 0, "Truncated data is valid.");
+    data.front() = 0x7f;
+    ok = ok && check(throwsInvalid(data), 0, "Unexpected format version is valid.");
+    data = checkpoint.data();
+    data.push_back(0);
+    ok = ok && check(throwsInvalid(data), 0, "Trailing data is valid.");
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(metadata).first;
+    const auto restoreOk = testRestore(*traceType);
+    const auto invalidOk = testInvalid(*traceType);
+
+    return restoreOk && invalidOk ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstring>
+#include <sstream>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+/*
+ * Sink which sums the values of the fixed-length integer elements and
+ * counts the other elements.
+ */
+struct IntSumSink final
+{
+    void operator()(const yactfr::FixedLengthUnsignedIntegerElement& elem)
+    {
+        sum += elem.value();
+    }
+
+    void operator()(const yactfr::FixedLengthSignedIntegerElement& elem)
+    {
+        sum += static_cast<unsigned long long>(elem.value());
+    }
+
+    void operator()(const yactfr::Element&)
+    {
+        ++otherCount;
+    }
+
+    unsigned long long sum = 0;
+    unsigned long long otherCount = 0;
+};
+
+} // namespace
+
+int main()
+{
+    const auto traceTypeMsUuidPair = yactfr::fromMetadataText(metadata,
+                                                              metadata + std::strlen(metadata));
+    MemDataSrcFactory factory {stream, sizeof stream};
+    yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, factory};
+
+    // expected: pull iteration with virtual visitation
+    std::ostringstream expectedSs;
+    ElemPrinter expectedPrinter {expectedSs, 0};
+    IntSumSink expectedSink;
+
+    for (const auto& elem : seq) {
+        elem.accept(expectedPrinter);
+
+        if (elem.isFixedLengthUnsignedIntegerElement()) {
+            expectedSink(elem.asFixedLengthUnsignedIntegerElement());
+        } else if (elem.isFixedLengthSignedIntegerElement()) {
+            expectedSink(elem.asFixedLengthSignedIntegerElement());
+        } else {
+            expectedSink(elem);
+        }
+    }
+
+    /*
+     * Generic lambda: the static type of `elem` selects the visit()
+     * overload, which must be the one which accept() calls.
+     */
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+
+    seq.decode([&printer](const auto& elem) {
+        static_cast<yactfr::ElementVisitor&>(printer).visit(elem);
+    });
+
+    if (ss.str() != expectedSs.str()) {
+        std::cerr << "Expected:\n\n" << expectedSs.str() << "\nGot:\n\n" << ss.str();
+        return 1;
+    }
+
+    // yactfr::visit() returns what the callable object returns
+    for (const auto& elem : seq) {
+        const auto concreteElem = yactfr::visit(elem, [](const auto& concreteElem) {
+            return static_cast<const yactfr::Element *>(&concreteElem);
+        });
+
+        if (concreteElem != &elem) {
+            std::cerr << "Unexpected concrete element.\n";
+            return 1;
+        }
+    }
+
+    // one-byte data blocks
+    {
+        MemDataSrcFactory smallBlkFactory {stream, sizeof stream, 1};
+        yactfr::ElementSequence smallBlkSeq {*traceTypeMsUuidPair.first, smallBlkFactory};
+        std::ostringstream smallBlkExpectedSs;
+        ElemPrinter smallBlkExpectedPrinter {smallBlkExpectedSs, 0};
+
+        // raw data elements depend on the data block size
+        for (const auto& elem : smallBlkSeq) {
+            elem.accept(smallBlkExpectedPrinter);
+        }
+
+        std::ostringstream smallBlkSs;
+        ElemPrinter smallBlkPrinter {smallBlkSs, 0};
+
+        smallBlkSeq.decode([&smallBlkPrinter](const auto& elem) {
+            static_cast<yactfr::ElementVisitor&>(smallBlkPrinter).visit(elem);
+        });
+
+        if (smallBlkSs.str() != smallBlkExpectedSs.str()) {
+            std::cerr << "Expected:\n\n" << smallBlkExpectedSs.str() << "\nGot:\n\n" <<
+                         smallBlkSs.str();
+            return 1;
+        }
+    }
+
+    // overloaded sink with a catch-all overload
+    IntSumSink sink;
+
+    seq.decode(sink);
+
+    if (sink.sum != expectedSink.sum || sink.otherCount != expectedSink.otherCount) {
+        std::cerr << "Expecting sum " << expectedSink.sum << " and " <<
+                     expectedSink.otherCount << " other elements, got sum " << sink.sum <<
+                     " and " << sink.otherCount << " other elements.\n";
+        return 1;
+    }
+
+    return 0;
+}
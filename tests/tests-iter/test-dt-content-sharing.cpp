@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <string>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 1;"
+    "  fields := struct {"
+    "    enum : u8 { A, B = 4 ... 7, C } e1;"
+    "    enum : u8 { X, Y } e2;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 2;"
+    "  fields := struct {"
+    "    enum : u8 { A, B = 4 ... 7, C } e1;"
+    "    enum : u8 { A, B = 4 ... 7, D } e2;"
+    "    variant <e1> {"
+    "      u8 A;"
+    "      u8 B;"
+    "      u8 C;"
+    "    } v;"
+    "  };"
+    "};";
+
+constexpr auto ctf2Metadata =
+    "\x1e{\"type\": \"preamble\", \"version\": 2}"
+    "\x1e{\"type\": \"trace-class\"}"
+    "\x1e{\"type\": \"data-stream-class\", \"event-record-header-field-class\": "
+    "{\"type\": \"structure\", \"member-classes\": [{\"name\": \"id\", \"field-class\": "
+    "{\"type\": \"fixed-length-unsigned-integer\", \"length\": 8, \"byte-order\": \"big-endian\", "
+    "\"roles\": [\"event-record-class-id\"]}}]}}"
+    "\x1e{\"type\": \"event-record-class\", \"id\": 1, \"payload-field-class\": "
+    "{\"type\": \"structure\", \"member-classes\": ["
+    "{\"name\": \"a\", \"field-class\": {\"type\": \"null-terminated-string\", "
+    "\"attributes\": {\"ns\": {\"meow\": [1, \"mix\"]}}}}, "
+    "{\"name\": \"b\", \"field-class\": {\"type\": \"null-terminated-string\", "
+    "\"attributes\": {\"ns\": {\"meow\": [1, \"mix\"]}}}}, "
+    "{\"name\": \"c\", \"field-class\": {\"type\": \"null-terminated-string\", "
+    "\"attributes\": {\"ns\": {\"meow\": [2, \"mix\"]}}}}]}}";
+
+const yactfr::DataType& memberDt(const yactfr::TraceType& traceType, const yactfr::TypeId ertId,
+                                 const char * const name)
+{
+    const auto& dst = **traceType.dataStreamTypes().begin();
+    const auto ert = dst[ertId];
+
+    return (*ert->payloadType())[name]->dataType();
+}
+
+bool check(const bool cond, const char * const what)
+{
+    if (!cond) {
+        std::cerr << what << '\n';
+    }
+
+    return cond;
+}
+
+bool testTsdl()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+    const auto& e11 = memberDt(*traceType, 1, "e1").asFixedLengthUnsignedIntegerType();
+    const auto& e12 = memberDt(*traceType, 1, "e2").asFixedLengthUnsignedIntegerType();
+    const auto& e21 = memberDt(*traceType, 2, "e1").asFixedLengthUnsignedIntegerType();
+    const auto& e22 = memberDt(*traceType, 2, "e2").asFixedLengthUnsignedIntegerType();
+    const auto& v = memberDt(*traceType, 2, "v").asVariantWithUnsignedIntegerSelectorType();
+
+    return check(&e11 != &e21, "TSDL: data types aren't distinct.") &&
+           check(&e11.mappings() == &e21.mappings(), "TSDL: equal mappings aren't shared.") &&
+           check(&e11.mappings() != &e12.mappings() && &e11.mappings() != &e22.mappings(),
+                 "TSDL: different mappings are shared.") &&
+           check(e11.mappings().size() == 3 && e11["B"] &&
+                 e11["B"]->contains(5) && !e11["B"]->contains(8),
+                 "TSDL: unexpected mappings.") &&
+           check(&v["A"]->selectorRanges().ranges() != &v["B"]->selectorRanges().ranges(),
+                 "TSDL: different selector ranges are shared.");
+}
+
+bool testCtf2()
+{
+    const auto traceType = yactfr::fromMetadataText(ctf2Metadata).first;
+    const auto& a = memberDt(*traceType, 1, "a");
+    const auto& b = memberDt(*traceType, 1, "b");
+    const auto& c = memberDt(*traceType, 1, "c");
+
+    return check(&a != &b, "CTF 2: data types aren't distinct.") &&
+           check(a.attributes() == b.attributes(), "CTF 2: equal attributes aren't shared.") &&
+           check(a.attributes() != c.attributes(), "CTF 2: different attributes are shared.") &&
+           check(*a.attributes() == *b.attributes() && *a.attributes() != *c.attributes(),
+                 "CTF 2: unexpected attributes.");
+}
+
+bool testAcrossTraceTypes()
+{
+    auto traceType1 = yactfr::fromMetadataText(ctf2Metadata).first;
+    const auto traceType2 = yactfr::fromMetadataText(ctf2Metadata).first;
+
+    if (!check(memberDt(*traceType1, 1, "a").attributes() ==
+               memberDt(*traceType2, 1, "a").attributes(),
+               "Equal attributes of different trace types aren't shared.")) {
+        return false;
+    }
+
+    // shared attributes outlive the first trace type
+    traceType1.reset();
+
+    const auto& a = memberDt(*traceType2, 1, "a");
+    const auto& b = memberDt(*traceType2, 1, "b");
+    const auto& c = memberDt(*traceType2, 1, "c");
+
+    return check(a.attributes()->size() == 1 && *a.attributes() == *b.attributes(),
+                 "Shared attributes don't outlive their first trace type.") &&
+           check(a == b && a != c, "Data types aren't compared by attribute content.");
+}
+
+} // namespace
+
+int main()
+{
+    const auto tsdlOk = testTsdl();
+    const auto ctf2Ok = testCtf2();
+    const auto acrossOk = testAcrossTraceTypes();
+
+    return tsdlOk && ctf2Ok && acrossOk ? 0 : 1;
+}
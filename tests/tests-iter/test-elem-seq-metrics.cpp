@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstring>
+#include <map>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+bool check(const bool cond, const char * const what)
+{
+    if (!cond) {
+        std::cerr << "Unexpected: " << what << ".\n";
+    }
+
+    return cond;
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceTypeMsUuidPair = yactfr::fromMetadataText(metadata,
+                                                              metadata + std::strlen(metadata));
+    const auto& traceType = *traceTypeMsUuidPair.first;
+    MemDataSrcFactory factory {stream, sizeof stream, 7};
+    yactfr::ElementSequence seq {traceType, factory};
+
+    // expected counts
+    std::map<yactfr::Element::Kind, unsigned long long> expectedElemCounts;
+    std::map<const yactfr::EventRecordType *, unsigned long long> expectedErtCounts;
+    std::map<const yactfr::DataStreamType *, unsigned long long> expectedDstCounts;
+    unsigned long long expectedPktCount = 0;
+    unsigned long long expectedErCount = 0;
+
+    for (const auto& elem : seq) {
+        ++expectedElemCounts[elem.kind()];
+
+        if (elem.isPacketEndElement()) {
+            ++expectedPktCount;
+        } else if (elem.isEventRecordInfoElement()) {
+            const auto ert = elem.asEventRecordInfoElement().type();
+
+            ++expectedErCount;
+            ++expectedErtCounts[ert];
+            ++expectedDstCounts[ert->dataStreamType()];
+        }
+    }
+
+    // a sampling period of 1 measures everything
+    yactfr::ElementSequenceMetrics metrics {traceType, 1};
+
+    if (!check(seq.metrics() == nullptr, "default metrics") ||
+            !check(&metrics.traceType() == &traceType, "trace type") ||
+            !check(metrics.samplingPeriod() == 1, "sampling period")) {
+        return 1;
+    }
+
+    seq.metrics(&metrics);
+
+    {
+        const auto endIt = seq.end();
+        auto it = seq.begin();
+
+        // a copy updates the same metrics
+        auto itCopy = it;
+
+        for (; it != endIt; ++it);
+    }
+
+#ifdef YACTFR_TEST_EXPECT_METRICS
+    if (!check(yactfr::ElementSequenceMetrics::isSupported(), "no metrics support")) {
+        return 1;
+    }
+#endif
+
+    if (!yactfr::ElementSequenceMetrics::isSupported()) {
+        return check(metrics.byteCount() == 0 && metrics.packetCount() == 0 &&
+                     metrics.eventRecordCount() == 0, "counts without support") ? 0 : 1;
+    }
+
+    if (!check(metrics.byteCount() == sizeof stream, "byte count") ||
+            !check(metrics.packetCount() == expectedPktCount, "packet count") ||
+            !check(metrics.eventRecordCount() == expectedErCount, "event record count")) {
+        return 1;
+    }
+
+    for (const auto& kindCountPair : expectedElemCounts) {
+        if (!check(metrics.elementCount(kindCountPair.first) == kindCountPair.second,
+                   "element count")) {
+            return 1;
+        }
+    }
+
+    if (!check(metrics.elementCount(yactfr::Element::Kind::VariableLengthSignedInteger) == 0,
+               "absent element kind count")) {
+        return 1;
+    }
+
+    unsigned long long incrCount = 0;
+
+    for (yactfr::Index i = 0; i < yactfr::ElementSequenceMetrics::incrementDurationHistogramSize; ++i) {
+        incrCount += metrics.incrementDurationCount(i);
+    }
+
+    /*
+     * Constructing the iterator provides the first element and the
+     * last increment reaches the end of the element sequence.
+     */
+    unsigned long long elemCount = 0;
+
+    for (const auto& kindCountPair : expectedElemCounts) {
+        elemCount += kindCountPair.second;
+    }
+
+    if (!check(incrCount == elemCount + 1, "measured increment count")) {
+        return 1;
+    }
+
+    for (const auto& dst : traceType) {
+        if (!check(metrics.eventRecordCount(*dst) == expectedDstCounts[dst.get()],
+                   "data stream type event record count")) {
+            return 1;
+        }
+
+        for (const auto& ert : *dst) {
+            const auto ertMetrics = metrics.eventRecordTypeMetrics(*ert);
+
+            if (!check(ertMetrics != nullptr, "event record type metrics") ||
+                    !check(ertMetrics->count() == expectedErtCounts[ert.get()],
+                           "event record type count") ||
+                    !check(ertMetrics->sampledCount() == ertMetrics->count(),
+                           "sampled event record type count")) {
+                return 1;
+            }
+        }
+    }
+
+    metrics.reset();
+
+    if (!check(metrics.byteCount() == 0 && metrics.packetCount() == 0 &&
+               metrics.eventRecordCount() == 0 && metrics.incrementDurationCount(0) == 0,
+               "reset counts")) {
+        return 1;
+    }
+
+    // only measure one call and one event record out of four
+    yactfr::ElementSequenceMetrics sampledMetrics {traceType, 4};
+
+    seq.metrics(&sampledMetrics);
+
+    for (auto it = seq.begin(); it != seq.end(); ++it);
+
+    unsigned long long sampledIncrCount = 0;
+
+    for (yactfr::Index i = 0; i < yactfr::ElementSequenceMetrics::incrementDurationHistogramSize; ++i) {
+        sampledIncrCount += sampledMetrics.incrementDurationCount(i);
+    }
+
+    unsigned long long sampledErCount = 0;
+
+    for (const auto& dst : traceType) {
+        for (const auto& ert : *dst) {
+            sampledErCount += sampledMetrics.eventRecordTypeMetrics(*ert)->sampledCount();
+        }
+    }
+
+    if (!check(sampledIncrCount == (elemCount + 1) / 4, "sampled increment count") ||
+            !check(sampledErCount == expectedErCount / 4, "sampled event record count")) {
+        return 1;
+    }
+
+    // no metrics for the iterators which begin() creates afterwards
+    seq.metrics(nullptr);
+
+    for (auto it = seq.begin(); it != seq.end(); ++it);
+
+    return check(metrics.packetCount() == 0, "packet count without metrics") ? 0 : 1;
+}
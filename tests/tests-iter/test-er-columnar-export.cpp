@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "typealias integer { size = 32; signed = true; } := s32;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "};"
+    "clock {"
+    "  name = cc;"
+    "  freq = 1000;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "    integer { size = 16; map = clock.cc.value; } ts;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 0;"
+    "  fields := struct {"
+    "    enum : u8 { A, B } tag;"
+    "    variant <tag> {"
+    "      u16 A;"
+    "      string B;"
+    "    } v;"
+    "    s32 s;"
+    "    floating_point { exp_dig = 8; mant_dig = 24; align = 8; } f;"
+    "    u8 len;"
+    "    u8 arr[len];"
+    "    string msg;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 1;"
+    "  fields := struct {"
+    "    u16 x;"
+    "  };"
+    "};";
+
+const std::uint8_t stream[] = {
+    // event record 0: option A
+    0x00, 0x00, 0x10,
+    0x00,
+    0x01, 0x02,
+    0xff, 0xff, 0xff, 0xfb,
+    0x3f, 0xc0, 0x00, 0x00,
+    0x02, 0x07, 0x08,
+    'h', 'i', 0x00,
+
+    // event record 1 (not exported)
+    0x01, 0x00, 0x20,
+    0x03, 0x04,
+
+    // event record 2: option B
+    0x00, 0x00, 0x30,
+    0x01,
+    'y', 'o', 0x00,
+    0x00, 0x00, 0x00, 0x07,
+    0xc0, 0x00, 0x00, 0x00,
+    0x00,
+    0x00,
+};
+
+bool check(const bool cond, const char * const what)
+{
+    if (!cond) {
+        std::cerr << "Unexpected: " << what << ".\n";
+    }
+
+    return cond;
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+    const auto& dst = **traceType->dataStreamTypes().begin();
+    const auto& ert0 = *dst[0];
+    const auto& ert1 = *dst[1];
+    MemDataSrcFactory factory {stream, sizeof stream};
+    yactfr::ElementSequence seq {*traceType, factory};
+    yactfr::EventRecordColumnarExporter exporter {seq, {&ert0}};
+
+    if (!check(exporter.table(ert1) == nullptr, "table of unselected event record type") ||
+            !check(exporter.exportBatch(1) == 1, "first batch size") ||
+            !check(exporter.exportBatch(1) == 1, "second batch size") ||
+            !check(exporter.exportBatch(1) == 0, "last batch size")) {
+        return 1;
+    }
+
+    const auto& table = *exporter.table(ert0);
+
+    if (!check(table.rowCount() == 2, "row count") ||
+            !check(table.columns().size() == 8, "column count") ||
+            !check(table["payload.arr"] == nullptr, "array column")) {
+        return 1;
+    }
+
+    const auto& ts = *table["timestamp"];
+    const auto& tag = *table["payload.tag"];
+    const auto& a = *table["payload.v.A"];
+    const auto& b = *table["payload.v.B"];
+    const auto& s = *table["payload.s"];
+    const auto& f = *table["payload.f"];
+    const auto& msg = *table["payload.msg"];
+
+    if (!check(ts.type() == yactfr::EventRecordColumn::Type::Timestamp, "timestamp type") ||
+            !check(ts.nullCount() == 0, "timestamp null count") ||
+            !check(ts.unsignedIntegerValue(0) == 0x10, "timestamp #0") ||
+            !check(ts.unsignedIntegerValue(1) == 0x30, "timestamp #1") ||
+            !check(tag.type() == yactfr::EventRecordColumn::Type::UnsignedInteger, "tag type") ||
+            !check(tag.unsignedIntegerValue(1) == 1, "tag #1") ||
+            !check(a.size() == 2 && b.size() == 2, "option column sizes") ||
+            !check(a.nullCount() == 1 && b.nullCount() == 1, "option null counts") ||
+            !check(!a.isNull(0) && a.isNull(1), "option A validity") ||
+            !check(a.validityBitmap().size() == 1 && a.validityBitmap()[0] == 1,
+                   "option A validity bitmap") ||
+            !check(a.unsignedIntegerValue(0) == 0x0102, "option A #0") ||
+            !check(b.isNull(0) && !b.isNull(1), "option B validity") ||
+            !check(b.offsets().size() == 3, "option B offset count") ||
+            !check(b.stringValue(0).empty() && b.stringValue(1) == "yo", "option B values") ||
+            !check(s.signedIntegerValue(0) == -5 && s.signedIntegerValue(1) == 7, "s values") ||
+            !check(f.floatingPointNumberValue(0) == 1.5 &&
+                   f.floatingPointNumberValue(1) == -2., "f values") ||
+            !check(f.values().size() == 2 * sizeof(double), "f values size") ||
+            !check(msg.type() == yactfr::EventRecordColumn::Type::String, "msg type") ||
+            !check(msg.stringValue(0) == "hi" && msg.stringValue(1).empty(), "msg values") ||
+            !check(msg.values().size() == 2, "msg values size")) {
+        return 1;
+    }
+
+    exporter.clear();
+
+    if (!check(table.rowCount() == 0 && msg.size() == 0 && msg.offsets().size() == 1,
+               "cleared table")) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "typealias integer { size = 16; signed = true; } := s16;"
+    "typealias integer { size = 32; } := u32;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "  event.context := struct {"
+    "    u8 ctx;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 0;"
+    "  fields := struct {"
+    "    u8 a;"
+    "    s16 b;"
+    "    floating_point { exp_dig = 8; mant_dig = 24; align = 8; } f;"
+    "    u32 arr[2];"
+    "    struct {"
+    "      u8 x;"
+    "    } s;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 1;"
+    "  fields := struct {"
+    "    string msg;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 2;"
+    "  fields := struct {"
+    "    u8 hi;"
+    "    integer { size = 3; signed = true; align = 1; } lo;"
+    "    integer { size = 5; align = 1; } rest;"
+    "    u16 c;"
+    "  };"
+    "};";
+
+const std::uint8_t stream[] = {
+    // event record 0
+    0x00, 0xaa,
+    0x17,
+    0xff, 0xfe,
+    0x3f, 0xc0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x02,
+    0x2a,
+
+    // event record 1 (no row layout)
+    0x01, 0xbb,
+    'h', 'i', 0x00,
+
+    // event record 2
+    0x02, 0xcc,
+    0x09,
+    0xb6,
+    0x12, 0x34,
+};
+
+struct Ert0Row final
+{
+    std::uint8_t a;
+    std::int16_t b;
+    float f;
+    std::uint32_t arr[2];
+    std::uint8_t x;
+};
+
+struct Ert2Row final
+{
+    std::uint8_t hi;
+    std::int8_t lo;
+    std::uint8_t rest;
+    std::uint16_t c;
+};
+
+bool check(const bool cond, const char * const what)
+{
+    if (!cond) {
+        std::cerr << "Unexpected: " << what << ".\n";
+    }
+
+    return cond;
+}
+
+bool checkLayout0(const yactfr::EventRecordRowLayout& layout)
+{
+    const auto& fields = layout.fields();
+
+    return check(layout.size() == sizeof(Ert0Row), "size of #0") &&
+           check(layout.alignment() == alignof(Ert0Row), "alignment of #0") &&
+           check(fields.size() == 6, "field count of #0") &&
+           check(fields[0].offset() == offsetof(Ert0Row, a), "offset of `a`") &&
+           check(fields[1].offset() == offsetof(Ert0Row, b), "offset of `b`") &&
+           check(fields[2].offset() == offsetof(Ert0Row, f), "offset of `f`") &&
+           check(fields[2].type().isFixedLengthFloatingPointNumberType(), "type of `f`") &&
+           check(fields[3].offset() == offsetof(Ert0Row, arr), "offset of `arr[0]`") &&
+           check(fields[4].offset() == offsetof(Ert0Row, arr) + 4, "offset of `arr[1]`") &&
+           check(&fields[3].type() == &fields[4].type(), "type of `arr[1]`") &&
+           check(fields[5].offset() == offsetof(Ert0Row, x), "offset of `s.x`") &&
+           check(fields[5].size() == 1, "size of `s.x`");
+}
+
+bool checkLayout2(const yactfr::EventRecordRowLayout& layout)
+{
+    const auto& fields = layout.fields();
+
+    return check(layout.size() == sizeof(Ert2Row), "size of #2") &&
+           check(fields.size() == 4, "field count of #2") &&
+           check(fields[1].size() == 1, "size of `lo`") &&
+           check(fields[3].offset() == offsetof(Ert2Row, c), "offset of `c`");
+}
+
+/*
+ * Reads the rows of `stream` through data blocks of at most
+ * `maxDataBlkSize` bytes.
+ */
+bool checkRows(const yactfr::TraceType& traceType, const yactfr::Size maxDataBlkSize)
+{
+    MemDataSrcFactory factory {stream, sizeof stream, maxDataBlkSize};
+    yactfr::ElementSequence seq {traceType, factory};
+    Ert0Row row0;
+    Ert2Row row2;
+    unsigned int erCount = 0;
+    unsigned int msgCount = 0;
+    const auto endIt = seq.end();
+
+    std::memset(&row0, 0, sizeof row0);
+    std::memset(&row2, 0, sizeof row2);
+
+    for (auto it = seq.begin(); it != endIt; ++it) {
+        if (it->isNullTerminatedStringBeginningElement()) {
+            ++msgCount;
+            continue;
+        }
+
+        if (!it->isEventRecordInfoElement()) {
+            continue;
+        }
+
+        const auto layout = it.eventRecordRowLayout();
+        const auto id = it->asEventRecordInfoElement().type()->id();
+
+        ++erCount;
+
+        if (!layout) {
+            if (!check(id == 1, "no row layout")) {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (!check(&layout->eventRecordType() == it->asEventRecordInfoElement().type(),
+                   "event record type of row layout") ||
+                !(id == 0 ? checkLayout0(*layout) : checkLayout2(*layout))) {
+            return false;
+        }
+
+        it.readEventRecordRow(id == 0 ? static_cast<void *>(&row0) : &row2);
+
+        if (!check(it->isEventRecordEndElement(), "event record end element after row")) {
+            return false;
+        }
+    }
+
+    return check(erCount == 3, "event record count") &&
+           check(msgCount == 1, "string count") &&
+           check(row0.a == 0x17, "`a`") &&
+           check(row0.b == -2, "`b`") &&
+           check(row0.f == 1.5f, "`f`") &&
+           check(row0.arr[0] == 1 && row0.arr[1] == 0x80000002, "`arr`") &&
+           check(row0.x == 0x2a, "`s.x`") &&
+           check(row2.hi == 9, "`hi`") &&
+           check(row2.lo == -3, "`lo`") &&
+           check(row2.rest == 22, "`rest`") &&
+           check(row2.c == 0x1234, "`c`");
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+
+    // whole data at once, and then byte by byte
+    if (!checkRows(*traceType, sizeof stream) || !checkRows(*traceType, 1)) {
+        return 1;
+    }
+
+    return 0;
+}
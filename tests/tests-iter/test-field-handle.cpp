@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdint>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "typealias integer { size = 8; signed = true; } := s8;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "  event.context := struct {"
+    "    u16 cpu;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 0;"
+    "  fields := struct {"
+    "    s8 neg;"
+    "    u8 len;"
+    "    u8 arr[len];"
+    "    enum : u8 { A, B } tag;"
+    "    variant <tag> {"
+    "      u8 A;"
+    "      u16 B;"
+    "    } v;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 1;"
+    "  fields := struct {"
+    "    string msg;"
+    "  };"
+    "};";
+
+const std::uint8_t stream[] = {
+    // event record 0
+    0x00, 0x00, 0x03,
+    0xfb,
+    0x02, 0x07, 0x09,
+    0x01,
+    0x01, 0x02,
+
+    // event record 1
+    0x01, 0x00, 0x04,
+    'h', 'i', 0x00,
+};
+
+bool check(const bool cond, const char * const what)
+{
+    if (!cond) {
+        std::cerr << "Unexpected: " << what << ".\n";
+    }
+
+    return cond;
+}
+
+yactfr::DataLocation payloadLoc(const char * const name)
+{
+    return yactfr::DataLocation {yactfr::Scope::EventRecordPayload, {name}};
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+    const auto& dst = **traceType->dataStreamTypes().begin();
+    const auto& ert0 = *dst[0];
+    const auto& ert1 = *dst[1];
+    MemDataSrcFactory factory {stream, sizeof stream};
+    yactfr::ElementSequence seq {*traceType, factory};
+
+    // created before the field handles
+    const auto oldIt = seq.begin();
+
+    const yactfr::DataLocation cpuLoc {yactfr::Scope::EventRecordCommonContext, {"cpu"}};
+    const auto cpu = traceType->fieldHandle(dst, cpuLoc);
+    const auto neg = traceType->fieldHandle(ert0, payloadLoc("neg"));
+    const auto arr = traceType->fieldHandle(ert0, payloadLoc("arr"));
+    const auto v = traceType->fieldHandle(ert0, payloadLoc("v"));
+
+    if (!check(cpu && neg && arr && v, "field handles") ||
+            !check(traceType->fieldHandle(ert1, cpuLoc) == cpu, "equivalent field handle") ||
+            !check(traceType->fieldHandle(ert0, payloadLoc("neg")) == neg,
+                   "same field handle") ||
+            !check(cpu->location() == cpuLoc, "field handle location") ||
+            !check(v->dataTypes().size() == 2, "variant field handle data types") ||
+            !check(!traceType->fieldHandle(dst, payloadLoc("neg")), "payload from data stream type") ||
+            !check(!traceType->fieldHandle(ert1, payloadLoc("msg")), "string field handle") ||
+            !check(!traceType->fieldHandle(ert0, payloadLoc("nope")), "unknown member")) {
+        return 1;
+    }
+
+    if (!check(!oldIt.fieldValue(*cpu), "value from an iterator created before")) {
+        return 1;
+    }
+
+    auto erEndCount = 0U;
+    const auto endIt = seq.end();
+
+    for (auto it = seq.begin(); it != endIt; ++it) {
+        if (it->isEventRecordBeginningElement() && erEndCount == 0) {
+            if (!check(!it.fieldValue(*cpu) && !it.fieldValue(*neg), "values before decoding")) {
+                return 1;
+            }
+        }
+
+        if (!it->isEventRecordEndElement()) {
+            continue;
+        }
+
+        ++erEndCount;
+
+        const auto expectedCpu = erEndCount == 1 ? 3U : 4U;
+
+        if (!check(it.fieldValue(*cpu) == static_cast<std::uint64_t>(expectedCpu), "`cpu`") ||
+                !check(static_cast<std::int64_t>(*it.fieldValue(*neg)) == -5, "`neg`") ||
+                !check(it.fieldValue(*arr) == static_cast<std::uint64_t>(9), "`arr`") ||
+                !check(it.fieldValue(*v) == static_cast<std::uint64_t>(0x102), "`v`")) {
+            return 1;
+        }
+    }
+
+    return check(erEndCount == 2, "event record count") ? 0 : 1;
+}
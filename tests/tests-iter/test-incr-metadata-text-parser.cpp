@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 1;"
+    "  fields := struct {"
+    "    u8 a;"
+    "  };"
+    "};";
+
+// length type within the event record type: extends in place
+constexpr auto tsdlAppendedMetadata1 =
+    "typealias integer { size = 8; } := len_t;"
+    "event {"
+    "  id = 2;"
+    "  fields := struct {"
+    "    len_t len;"
+    "    u16 vals[len];"
+    "  };"
+    "};";
+
+// length type within the event record header type: can't extend in place
+constexpr auto tsdlAppendedMetadata2 =
+    "event {"
+    "  id = 3;"
+    "  fields := struct {"
+    "    u8 vals[stream.event.header.id];"
+    "  };"
+    "};";
+
+constexpr std::uint8_t tsdlStream[] = {
+    0x01, 0x42,
+    0x02, 0x02, 0x01, 0x02, 0x03, 0x04,
+    0x03, 0x07, 0x08, 0x09,
+};
+
+constexpr auto ctf2Metadata =
+    "\x1e{\"type\": \"preamble\", \"version\": 2}"
+    "\x1e{\"type\": \"trace-class\"}"
+    "\x1e{\"type\": \"field-class-alias\", \"name\": \"u8\", \"field-class\": "
+    "{\"type\": \"fixed-length-unsigned-integer\", \"length\": 8, \"byte-order\": \"big-endian\"}}"
+    "\x1e{\"type\": \"data-stream-class\", \"event-record-header-field-class\": "
+    "{\"type\": \"structure\", \"member-classes\": [{\"name\": \"id\", \"field-class\": "
+    "{\"type\": \"fixed-length-unsigned-integer\", \"length\": 8, \"byte-order\": \"big-endian\", "
+    "\"roles\": [\"event-record-class-id\"]}}]}}"
+    "\x1e{\"type\": \"event-record-class\", \"id\": 1, \"payload-field-class\": "
+    "{\"type\": \"structure\", \"member-classes\": [{\"name\": \"a\", \"field-class\": \"u8\"}]}}";
+
+constexpr auto ctf2AppendedMetadata =
+    "\x1e{\"type\": \"event-record-class\", \"id\": 2, \"payload-field-class\": "
+    "{\"type\": \"structure\", \"member-classes\": [{\"name\": \"len\", \"field-class\": \"u8\"}, "
+    "{\"name\": \"vals\", \"field-class\": {\"type\": \"dynamic-length-array\", "
+    "\"length-field-location\": {\"path\": [\"len\"]}, \"element-field-class\": \"u8\"}}]}}";
+
+constexpr std::uint8_t ctf2Stream[] = {
+    0x01, 0x42,
+    0x02, 0x03, 0x05, 0x06, 0x07,
+};
+
+/*
+ * Appends a summary of `elem` to `summary`.
+ */
+void summarize(const yactfr::Element& elem, std::string& summary)
+{
+    if (elem.isEventRecordInfoElement()) {
+        summary += "ERT:" + std::to_string(elem.asEventRecordInfoElement().type()->id()) + ' ';
+    } else if (elem.isFixedLengthUnsignedIntegerElement()) {
+        summary += std::to_string(elem.asFixedLengthUnsignedIntegerElement().value()) + ' ';
+    }
+}
+
+/*
+ * Advances `it` until the end of the next event record, appending a
+ * summary of its elements to `summary`.
+ */
+void decodeEr(yactfr::ElementSequenceIterator& it, const yactfr::ElementSequenceIterator& end,
+              std::string& summary)
+{
+    while (it != end) {
+        ++it;
+
+        if (it == end) {
+            return;
+        }
+
+        summarize(*it, summary);
+
+        if (it->isEventRecordEndElement()) {
+            return;
+        }
+    }
+}
+
+/*
+ * Returns the summary of all the elements of `seq`.
+ */
+std::string decodeAll(yactfr::ElementSequence& seq)
+{
+    std::string summary;
+
+    for (const auto& elem : seq) {
+        summarize(elem, summary);
+    }
+
+    return summary;
+}
+
+bool check(const std::string& got, const std::string& expected, const char * const what)
+{
+    if (got != expected) {
+        std::cerr << what << ": expected `" << expected << "`, got `" << got << "`.\n";
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Checks that appending `text` to `parser` fails.
+ */
+bool checkAppendFails(yactfr::IncrementalMetadataTextParser& parser, const std::string& text,
+                      const char * const what)
+{
+    try {
+        parser.appendMetadataText(text);
+    } catch (const yactfr::TextParseError&) {
+        return true;
+    }
+
+    std::cerr << what << ": expecting a text parse error.\n";
+    return false;
+}
+
+bool testTsdl()
+{
+    yactfr::IncrementalMetadataTextParser parser {tsdlMetadata};
+    MemDataSrcFactory factory {tsdlStream, sizeof tsdlStream};
+    yactfr::ElementSequence seq {parser.traceType(), factory};
+    auto it = seq.begin();
+    const auto end = seq.end();
+    std::string summary;
+
+    // first event record, as the existing iterator sees it
+    decodeEr(it, end, summary);
+
+    if (!check(summary, "1 ERT:1 66 ", "Before first append")) {
+        return false;
+    }
+
+    if (parser.appendMetadataText(tsdlAppendedMetadata1) != 1) {
+        std::cerr << "First append: expecting one new event record type.\n";
+        return false;
+    }
+
+    // existing iterator decodes the new event record type
+    summary.clear();
+    decodeEr(it, end, summary);
+
+    if (!check(summary, "2 ERT:2 2 258 772 ", "After first append")) {
+        return false;
+    }
+
+    if (parser.appendMetadataText(tsdlAppendedMetadata2) != 1) {
+        std::cerr << "Second append: expecting one new event record type.\n";
+        return false;
+    }
+
+    // existing iterator doesn't know the third event record type
+    try {
+        decodeEr(it, end, summary);
+        std::cerr << "Second append: expecting an unknown event record type error.\n";
+        return false;
+    } catch (const yactfr::UnknownEventRecordTypeDecodingError&) {
+    }
+
+    // new iterator decodes all of them
+    if (!check(decodeAll(seq), "1 ERT:1 66 2 ERT:2 2 258 772 3 ERT:3 7 8 9 ",
+               "New iterator")) {
+        return false;
+    }
+
+    // rejected appended metadata texts
+    if (!checkAppendFails(parser, "stream { id = 1; };", "Data stream type block") ||
+            !checkAppendFails(parser, "event { id = 2; fields := struct { u8 a; }; };",
+                              "Duplicate event record type") ||
+            !checkAppendFails(parser,
+                              "typealias integer { size = 8; } := tmp_t;"
+                              "event { id = 4; fields := struct { u8 a; }; };"
+                              "event { id = 5; fields := struct { nope_t a; }; };",
+                              "Unknown data type alias")) {
+        return false;
+    }
+
+    // the failed append above didn't keep anything
+    if (parser.appendMetadataText("typealias integer { size = 8; } := tmp_t;"
+                                  "event { id = 4; fields := struct { tmp_t a; }; };"
+                                  "event { id = 5; fields := struct { len_t a; }; };") != 2) {
+        std::cerr << "Append after failure: expecting two new event record types.\n";
+        return false;
+    }
+
+    if (parser.traceType().dataStreamTypes().size() != 1 ||
+            (*parser.traceType().dataStreamTypes().begin())->eventRecordTypes().size() != 5) {
+        std::cerr << "Append after failure: expecting five event record types.\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool testCtf2()
+{
+    yactfr::IncrementalMetadataTextParser parser {ctf2Metadata};
+    MemDataSrcFactory factory {ctf2Stream, sizeof ctf2Stream};
+    yactfr::ElementSequence seq {parser.traceType(), factory};
+    auto it = seq.begin();
+    const auto end = seq.end();
+    std::string summary;
+
+    decodeEr(it, end, summary);
+
+    if (!check(summary, "1 ERT:1 66 ", "CTF 2: before append")) {
+        return false;
+    }
+
+    if (!checkAppendFails(parser, "\x1e{\"type\": \"trace-class\"}", "CTF 2: trace type")) {
+        return false;
+    }
+
+    if (parser.appendMetadataText(ctf2AppendedMetadata) != 1) {
+        std::cerr << "CTF 2: expecting one new event record type.\n";
+        return false;
+    }
+
+    summary.clear();
+    decodeEr(it, end, summary);
+    return check(summary, "2 ERT:2 3 5 6 7 ", "CTF 2: after append");
+}
+
+} // namespace
+
+int main()
+{
+    return testTsdl() && testCtf2() ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+
+namespace {
+
+constexpr unsigned int ertCount = 32;
+
+constexpr unsigned int roundCount = 3;
+
+constexpr unsigned int threadCount = 8;
+
+/*
+ * Returns a TSDL metadata text with `ertCount` event record types:
+ *
+ * * The procedure of an even one only needs the values which it reads
+ *   itself (the VM builds it on first dispatch).
+ *
+ * * An odd one has a dynamic-length array of which the length is in
+ *   the event record common context.
+ */
+std::string tsdlMetadata()
+{
+    std::string text =
+        "/* CTF 1.8 */\n"
+        "typealias integer { size = 8; } := u8;"
+        "trace {"
+        "  major = 1;"
+        "  minor = 8;"
+        "  byte_order = be;"
+        "};"
+        "stream {"
+        "  event.header := struct {"
+        "    u8 id;"
+        "  };"
+        "  event.context := struct {"
+        "    u8 n;"
+        "  };"
+        "};";
+
+    for (auto id = 0U; id < ertCount; ++id) {
+        text += "event { id = " + std::to_string(id) + "; fields := struct {";
+
+        if (id % 2 == 0) {
+            text += "u8 len; u8 a[len]; enum : u8 { X, Y } tag; variant <tag> { u8 X; struct { u8 p; u8 q; } Y; } v;";
+        } else {
+            text += "u8 b[stream.event.context.n];";
+        }
+
+        text += "}; };";
+    }
+
+    return text;
+}
+
+/*
+ * Appends an event record of type `id` to `data`, and its expected
+ * unsigned integer values to `vals`.
+ */
+void appendEr(const unsigned int id, const unsigned int round, std::vector<std::uint8_t>& data,
+              std::vector<unsigned long long>& vals)
+{
+    const auto append = [&data, &vals](const std::uint8_t val) {
+        data.push_back(val);
+        vals.push_back(val);
+    };
+
+    append(id);
+    append(2);
+
+    if (id % 2 == 0) {
+        const auto len = (id + round) % 3;
+
+        append(len);
+
+        for (auto i = 0U; i < len; ++i) {
+            append(id + i);
+        }
+
+        const auto tag = (id / 2 + round) % 2;
+
+        append(tag);
+        append(0xaa);
+
+        if (tag == 1) {
+            append(0xbb);
+        }
+    } else {
+        append(id);
+        append(round);
+    }
+}
+
+/*
+ * Collects the values of the fixed-length unsigned integer elements.
+ */
+class ValsCollector final :
+    public yactfr::ElementVisitor
+{
+public:
+    explicit ValsCollector(std::vector<unsigned long long>& vals) :
+        _vals {&vals}
+    {
+    }
+
+    void visit(const yactfr::FixedLengthUnsignedIntegerElement& elem) override
+    {
+        _vals->push_back(elem.value());
+    }
+
+private:
+    std::vector<unsigned long long> *_vals;
+};
+
+std::vector<unsigned long long> decodedVals(const yactfr::TraceType& traceType,
+                                            const std::vector<std::uint8_t>& data)
+{
+    std::vector<unsigned long long> vals;
+    ValsCollector collector {vals};
+    MemDataSrcFactory factory {data.data(), data.size()};
+    yactfr::ElementSequence seq {traceType, factory};
+
+    for (const auto& elem : seq) {
+        elem.accept(collector);
+    }
+
+    return vals;
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata()).first;
+    std::vector<std::uint8_t> data;
+    std::vector<unsigned long long> expectedVals;
+
+    /*
+     * Only some event record types per round so that the iterators
+     * keep building procedures until the end.
+     */
+    for (auto round = 0U; round < roundCount; ++round) {
+        for (auto id = round; id < ertCount; id += round + 1) {
+            appendEr(id, round, data, expectedVals);
+        }
+    }
+
+    /*
+     * All the iterators share the packet procedure of `traceType`:
+     * start them at the same time so that they race to build the same
+     * event record procedures.
+     */
+    std::atomic<bool> go {false};
+    std::atomic<unsigned int> failCount {0};
+    std::vector<std::thread> threads;
+
+    for (auto i = 0U; i < threadCount; ++i) {
+        threads.emplace_back([&] {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            if (decodedVals(*traceType, data) != expectedVals) {
+                ++failCount;
+            }
+        });
+    }
+
+    go.store(true);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failCount > 0) {
+        std::cerr << failCount << " thread(s) decoded unexpected values.\n";
+        return 1;
+    }
+
+    // all the procedures are built now
+    if (decodedVals(*traceType, data) != expectedVals) {
+        std::cerr << "Unexpected values after the concurrent decoding.\n";
+        return 1;
+    }
+
+    return 0;
+}
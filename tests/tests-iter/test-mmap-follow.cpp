@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <sstream>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <unistd.h>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+void printElem(const yactfr::Element& elem, ElemPrinter& printer)
+{
+    // raw data element boundaries depend on the data block sizes
+    if (elem.isRawDataElement()) {
+        return;
+    }
+
+    elem.accept(printer);
+}
+
+std::string elemSeqStr(yactfr::ElementSequence& seq)
+{
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+
+    for (const auto& elem : seq) {
+        printElem(elem, printer);
+    }
+
+    return ss.str();
+}
+
+void appendToFile(const char * const path, const std::uint8_t * const begin,
+                  const std::uint8_t * const end)
+{
+    std::ofstream file {path, std::ios::binary | std::ios::app};
+
+    file.write(reinterpret_cast<const char *>(begin), end - begin);
+}
+
+/*
+ * Writes the first `cutOffset` bytes of `data` to a new file, follows
+ * it until data isn't available, appends the rest of `data`, and then
+ * iterates until the end.
+ */
+std::string followedElemSeqStr(const yactfr::TraceType& traceType,
+                               const std::vector<std::uint8_t>& data, const std::size_t cutOffset,
+                               std::size_t& notAvailCount)
+{
+    char path[] = "/tmp/yactfr-test-mmap-follow-XXXXXX";
+    const auto fd = mkstemp(path);
+
+    if (fd < 0) {
+        std::cerr << "Cannot create temporary file.\n";
+        std::exit(1);
+    }
+
+    close(fd);
+    appendToFile(path, data.data(), data.data() + cutOffset);
+
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+    yactfr::MemoryMappedFileViewFactory factory {path, 4096};
+
+    factory.followFile(true);
+
+    yactfr::ElementSequence seq {traceType, factory};
+    auto it = seq.end();
+    auto appended = false;
+
+    while (true) {
+        try {
+            if (it == seq.end()) {
+                it = seq.begin();
+            } else {
+                ++it;
+            }
+
+            if (it == seq.end()) {
+                break;
+            }
+
+            printElem(*it, printer);
+        } catch (const yactfr::DataNotAvailable&) {
+            ++notAvailCount;
+
+            if (appended) {
+                std::cerr << "Data not available after appending the rest.\n";
+                std::exit(1);
+            }
+
+            appendToFile(path, data.data() + cutOffset, data.data() + data.size());
+
+            if (!factory.waitForFileGrowth(std::chrono::milliseconds {5000})) {
+                std::cerr << "File didn't grow.\n";
+                std::exit(1);
+            }
+
+            // the writer is done
+            factory.followFile(false);
+            appended = true;
+        }
+    }
+
+    std::remove(path);
+    return ss.str();
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceTypeMsUuidPair = yactfr::fromMetadataText(metadata,
+                                                              metadata + std::strlen(metadata));
+    std::vector<std::uint8_t> data;
+
+    for (auto i = 0U; i < 2; ++i) {
+        data.insert(data.end(), stream, stream + sizeof stream);
+    }
+
+    MemDataSrcFactory memFactory {data.data(), data.size()};
+    yactfr::ElementSequence memSeq {*traceTypeMsUuidPair.first, memFactory};
+    const auto expected = elemSeqStr(memSeq);
+
+    // cut anywhere, including in the middle of packets
+    for (std::size_t cutOffset = 1; cutOffset < data.size(); ++cutOffset) {
+        std::size_t notAvailCount = 0;
+        const auto got = followedElemSeqStr(*traceTypeMsUuidPair.first, data, cutOffset,
+                                            notAvailCount);
+
+        if (notAvailCount != 1) {
+            std::cerr << "Expecting data not to be available once (cut at " << cutOffset <<
+                         "), got " << notAvailCount << ".\n";
+            return 1;
+        }
+
+        if (got != expected) {
+            std::cerr << "Cut at " << cutOffset << ": expected:\n\n" << expected <<
+                         "\nGot:\n\n" << got;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <sstream>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <unistd.h>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+std::string elemSeqStr(yactfr::ElementSequence& seq)
+{
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+
+    for (const auto& elem : seq) {
+        // raw data element boundaries depend on the data block sizes
+        if (elem.isRawDataElement()) {
+            continue;
+        }
+
+        elem.accept(printer);
+    }
+
+    return ss.str();
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceTypeMsUuidPair = yactfr::fromMetadataText(metadata,
+                                                              metadata + std::strlen(metadata));
+
+    // repeat the common stream so that it spans many memory maps
+    std::vector<std::uint8_t> data;
+
+    for (auto i = 0U; i < 256; ++i) {
+        data.insert(data.end(), stream, stream + sizeof stream);
+    }
+
+    char path[] = "/tmp/yactfr-test-mmap-hints-XXXXXX";
+    const auto fd = mkstemp(path);
+
+    if (fd < 0) {
+        std::cerr << "Cannot create temporary file.\n";
+        return 1;
+    }
+
+    close(fd);
+
+    {
+        std::ofstream file {path, std::ios::binary};
+
+        file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    }
+
+    MemDataSrcFactory memFactory {data.data(), data.size()};
+    yactfr::ElementSequence memSeq {*traceTypeMsUuidPair.first, memFactory};
+    const auto expected = elemSeqStr(memSeq);
+    yactfr::MemoryMappedFileViewFactory mmapFactory {
+        path, 4096, yactfr::MemoryMappedFileViewFactory::AccessPattern::Sequential
+    };
+
+    mmapFactory.prefaultPages(true);
+    mmapFactory.adviseHugePages(true);
+    mmapFactory.readAheadNextRegion(true);
+
+    yactfr::ElementSequence mmapSeq {*traceTypeMsUuidPair.first, mmapFactory};
+    const auto got = elemSeqStr(mmapSeq);
+
+    std::remove(path);
+
+    if (got != expected) {
+        std::cerr << "Expected:\n\n" << expected << "\nGot:\n\n" << got;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+
+namespace {
+
+// number of heap allocations so far
+std::size_t allocCount = 0;
+
+void *countedAlloc(const std::size_t size)
+{
+    const auto ptr = std::malloc(size == 0 ? 1 : size);
+
+    if (!ptr) {
+        throw std::bad_alloc {};
+    }
+
+    ++allocCount;
+    return ptr;
+}
+
+// number of dimensions of the static-length array of the payload
+constexpr unsigned int arrayDimCount = 24;
+
+// number of dynamic-length arrays (saved lengths) per event record
+constexpr unsigned int dlArrayCount = 24;
+
+constexpr unsigned int erCount = 16;
+
+/*
+ * Returns a TSDL metadata text of which the event record type needs
+ * more stack frames and saved values than the inline storage of the VM
+ * can contain.
+ */
+std::string tsdlMetadata()
+{
+    std::string text =
+        "/* CTF 1.8 */\n"
+        "typealias integer { size = 8; } := u8;"
+        "trace {"
+        "  major = 1;"
+        "  minor = 8;"
+        "  byte_order = be;"
+        "};"
+        "event {"
+        "  fields := struct {";
+
+    for (auto i = 0U; i < dlArrayCount; ++i) {
+        const auto name = "len" + std::to_string(i);
+
+        text += "u8 " + name + "; u8 a" + std::to_string(i) + "[" + name + "];";
+    }
+
+    text += "u8 m";
+
+    for (auto i = 0U; i < arrayDimCount; ++i) {
+        text += "[1]";
+    }
+
+    text += "; string s;"
+            "  };"
+            "};";
+    return text;
+}
+
+std::vector<std::uint8_t> stream()
+{
+    std::vector<std::uint8_t> data;
+
+    for (auto er = 0U; er < erCount; ++er) {
+        for (auto i = 0U; i < dlArrayCount; ++i) {
+            const auto len = (er + i) % 3;
+
+            data.push_back(len);
+
+            for (auto j = 0U; j < len; ++j) {
+                data.push_back(j);
+            }
+        }
+
+        data.push_back(er);
+        data.push_back('x');
+        data.push_back(0);
+    }
+
+    return data;
+}
+
+} // namespace
+
+void *operator new(const std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](const std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void * const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata()).first;
+    const auto data = stream();
+    MemDataSrcFactory factory {data.data(), data.size()};
+    yactfr::ElementSequence seq {*traceType, factory};
+    std::size_t elemCount = 0;
+
+    // first iteration: builds any event record procedure on dispatch
+    for (auto it = seq.begin(); it != seq.end(); ++it) {
+        ++elemCount;
+    }
+
+    auto it = seq.begin();
+    yactfr::ElementSequenceIteratorPosition pos;
+
+    // allocates the VM position once
+    it.savePosition(pos);
+
+    const auto allocCountBefore = allocCount;
+    std::size_t steadyElemCount = 1;
+
+    for (++it; it != seq.end(); ++it) {
+        it.savePosition(pos);
+        ++steadyElemCount;
+    }
+
+    const auto steadyAllocCount = allocCount - allocCountBefore;
+
+    if (steadyElemCount != elemCount) {
+        std::cerr << "Unexpected element count: " << steadyElemCount << " (expecting " <<
+                     elemCount << ").\n";
+        return 1;
+    }
+
+    if (steadyAllocCount != 0) {
+        std::cerr << steadyAllocCount << " heap allocation(s) while iterating.\n";
+        return 1;
+    }
+
+    return 0;
+}
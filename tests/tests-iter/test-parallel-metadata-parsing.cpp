@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+
+namespace {
+
+constexpr unsigned int ertCount = 40;
+
+constexpr yactfr::Size threadCounts[] = {0, 2, 3, 16};
+
+std::string tsdlPrologue(const bool withEnv = true)
+{
+    std::string text =
+        "/* CTF 1.8 */\n"
+        "typealias integer { size = 8; } := u8;"
+        "trace {"
+        "  major = 1;"
+        "  minor = 8;"
+        "  byte_order = be;"
+        "};"
+        "typealias integer { size = 16; } := u16;"
+        "stream {"
+        "  event.header := struct {"
+        "    u8 id;"
+        "  };"
+        "};";
+
+    if (withEnv) {
+        text += "env { count = 2; };";
+    }
+
+    return text;
+}
+
+std::string tsdlErtBlock(const unsigned int id, const std::string& extraMembers = "")
+{
+    return "event {\n"
+           "  id = " + std::to_string(id) + ";\n"
+           "  name = \"ert" + std::to_string(id) + "\";\n"
+           "  fields := struct {\n"
+           "    u8 a;\n"
+           "    u16 b;\n"
+           "    u8 c[env.count];\n" + extraMembers +
+           "  };\n"
+           "};\n";
+}
+
+/*
+ * Returns a valid TSDL metadata text with `ertCount` event record
+ * types, some of them using a root data type alias which the metadata
+ * text defines between `event` blocks.
+ */
+std::string tsdlMetadata()
+{
+    auto text = tsdlPrologue();
+
+    for (auto id = 0U; id < ertCount; ++id) {
+        if (id == ertCount / 2) {
+            text += "typealias integer { size = 8; signed = true; } := s8;";
+        }
+
+        text += tsdlErtBlock(id, id >= ertCount / 2 ? "    s8 d;\n" : "");
+    }
+
+    return text;
+}
+
+/*
+ * Returns a data stream which contains one event record of each event
+ * record type of tsdlMetadata().
+ */
+std::vector<std::uint8_t> tsdlStream()
+{
+    std::vector<std::uint8_t> data;
+
+    for (auto id = 0U; id < ertCount; ++id) {
+        data.push_back(id);
+        data.push_back(id * 3);
+        data.push_back(0x01);
+        data.push_back(id);
+        data.push_back(0xaa);
+        data.push_back(0xbb);
+
+        if (id >= ertCount / 2) {
+            data.push_back(0xff);
+        }
+    }
+
+    return data;
+}
+
+std::string ctf2ErcFrag(const unsigned int id)
+{
+    return "\x1e{\"type\": \"event-record-class\", \"id\": " + std::to_string(id) +
+           ", \"payload-field-class\": {\"type\": \"structure\", \"member-classes\": "
+           "[{\"name\": \"a\", \"field-class\": \"u8\"}, {\"name\": \"b\", \"field-class\": "
+           "{\"type\": \"static-length-array\", \"length\": " + std::to_string(id % 3) +
+           ", \"element-field-class\": \"u8\"}}]}}\n";
+}
+
+std::string ctf2Metadata()
+{
+    std::string text =
+        "\x1e{\"type\": \"preamble\", \"version\": 2}\n"
+        "\x1e{\"type\": \"trace-class\"}\n"
+        "\x1e{\"type\": \"field-class-alias\", \"name\": \"u8\", \"field-class\": "
+        "{\"type\": \"fixed-length-unsigned-integer\", \"length\": 8, "
+        "\"byte-order\": \"big-endian\"}}\n"
+        "\x1e{\"type\": \"data-stream-class\", \"event-record-header-field-class\": "
+        "{\"type\": \"structure\", \"member-classes\": [{\"name\": \"id\", \"field-class\": "
+        "{\"type\": \"fixed-length-unsigned-integer\", \"length\": 8, "
+        "\"byte-order\": \"big-endian\", \"roles\": [\"event-record-class-id\"]}}]}}\n";
+
+    for (auto id = 0U; id < ertCount; ++id) {
+        text += ctf2ErcFrag(id);
+    }
+
+    return text;
+}
+
+std::vector<std::uint8_t> ctf2Stream()
+{
+    std::vector<std::uint8_t> data;
+
+    for (auto id = 0U; id < ertCount; ++id) {
+        data.push_back(id);
+        data.push_back(id * 5);
+
+        for (auto i = 0U; i < id % 3; ++i) {
+            data.push_back(i);
+        }
+    }
+
+    return data;
+}
+
+/*
+ * Returns the printed elements of decoding `data` with `traceType`.
+ */
+std::string elemSeqStr(const yactfr::TraceType& traceType, const std::vector<std::uint8_t>& data)
+{
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+    MemDataSrcFactory factory {data.data(), data.size()};
+    yactfr::ElementSequence seq {traceType, factory};
+
+    for (const auto& elem : seq) {
+        elem.accept(printer);
+    }
+
+    return ss.str();
+}
+
+/*
+ * Returns the result of parsing `text` with `threadCount` threads: the
+ * printed elements of decoding `data` on success, or the error message
+ * otherwise.
+ */
+std::string parseResult(const std::string& text, const yactfr::Size threadCount,
+                        const std::vector<std::uint8_t>& data)
+{
+    try {
+        const auto ret = yactfr::fromMetadataText(text, threadCount);
+
+        return elemSeqStr(*ret.first, data);
+    } catch (const yactfr::TextParseError& exc) {
+        return std::string {"ERROR: "} + exc.what();
+    }
+}
+
+/*
+ * Checks that parsing `text` in parallel gives the same result as
+ * parsing it sequentially, which must be an error if `expectError` is
+ * true.
+ */
+bool check(const std::string& text, const bool expectError, const char * const what,
+           const std::vector<std::uint8_t>& data = {})
+{
+    const auto expected = parseResult(text, 1, data);
+
+    if ((expected.compare(0, 7, "ERROR: ") == 0) != expectError) {
+        std::cerr << what << ": unexpected sequential result:\n\n" << expected << '\n';
+        return false;
+    }
+
+    for (const auto threadCount : threadCounts) {
+        const auto got = parseResult(text, threadCount, data);
+
+        if (got != expected) {
+            std::cerr << what << " (" << threadCount << " threads): expected:\n\n" <<
+                         expected << "\nGot:\n\n" << got << '\n';
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testTsdl()
+{
+    auto ok = check(tsdlMetadata(), false, "TSDL", tsdlStream());
+
+    // root data type alias which follows the `event` block
+    {
+        auto text = tsdlPrologue();
+
+        text += tsdlErtBlock(0) + tsdlErtBlock(1, "    late_t d;\n");
+        text += "typealias integer { size = 8; } := late_t;";
+        text += tsdlErtBlock(2, "    late_t d;\n");
+        ok = ok && check(text, true, "TSDL: late data type alias");
+    }
+
+    // environment block which follows the `event` block
+    {
+        auto text = tsdlPrologue(false);
+
+        text += tsdlErtBlock(0) + "env { count = 2; };";
+        ok = ok && check(text, true, "TSDL: late environment");
+    }
+
+    // two invalid `event` blocks: first one wins
+    {
+        auto text = tsdlPrologue();
+
+        for (auto id = 0U; id < ertCount; ++id) {
+            text += tsdlErtBlock(id, id == 7 ? "    nope_t x;\n" :
+                                     id == 30 ? "    u8 y[stream.nope];\n" : "");
+        }
+
+        ok = ok && check(text, true, "TSDL: two invalid `event` blocks");
+    }
+
+    // invalid `event` block followed with an invalid `stream` block
+    {
+        auto text = tsdlPrologue();
+
+        text += tsdlErtBlock(0) + tsdlErtBlock(1, "    nope_t x;\n") + tsdlErtBlock(2);
+        text += "stream { id = 1; meow = 23; };";
+        ok = ok && check(text, true, "TSDL: invalid `event`, then `stream` block");
+    }
+
+    // invalid `stream` block followed with an invalid `event` block
+    {
+        auto text = tsdlPrologue();
+
+        text += tsdlErtBlock(0) + "stream { id = 1; meow = 23; };";
+        text += tsdlErtBlock(1, "    nope_t x;\n");
+        ok = ok && check(text, true, "TSDL: invalid `stream`, then `event` block");
+    }
+
+    // duplicate event record type ID
+    {
+        auto text = tsdlPrologue();
+
+        text += tsdlErtBlock(0) + tsdlErtBlock(1) + tsdlErtBlock(2) + tsdlErtBlock(1);
+        ok = ok && check(text, true, "TSDL: duplicate ID");
+    }
+
+    // incomplete `event` block
+    {
+        auto text = tsdlPrologue();
+
+        text += tsdlErtBlock(0, "    nope_t x;\n") + tsdlErtBlock(1);
+        text += "event { id = 2; fields := struct { u8 a; ";
+        ok = ok && check(text, true, "TSDL: incomplete `event` block");
+    }
+
+    return ok;
+}
+
+bool testCtf2()
+{
+    auto ok = check(ctf2Metadata(), false, "CTF 2", ctf2Stream());
+
+    // two invalid JSON texts: first one wins
+    {
+        auto text = ctf2Metadata();
+
+        text += ctf2ErcFrag(ertCount) + "\x1e{\"type\": \"event-record-class\", \"id\": }\n";
+        text += ctf2ErcFrag(ertCount + 1) + "\x1e{\"type\": [}\n";
+        ok = ok && check(text, true, "CTF 2: two invalid JSON texts");
+    }
+
+    // invalid fragment followed with an invalid JSON text
+    {
+        auto text = ctf2Metadata();
+
+        text += "\x1e{\"type\": \"event-record-class\", \"id\": 1, \"meow\": 23}\n";
+        text += "\x1e{\"type\": [}\n";
+        ok = ok && check(text, true, "CTF 2: invalid fragment, then JSON text");
+    }
+
+    // duplicate event record class ID followed with an invalid JSON text
+    {
+        auto text = ctf2Metadata();
+
+        text += ctf2ErcFrag(3) + "\x1e{\"type\": [}\n";
+        ok = ok && check(text, true, "CTF 2: duplicate ID, then invalid JSON text");
+    }
+
+    // invalid fragment followed with an empty fragment
+    {
+        auto text = ctf2Metadata();
+
+        text += "\x1e{\"type\": \"event-record-class\", \"id\": -1}\n\x1e\x1e";
+        ok = ok && check(text, true, "CTF 2: invalid fragment, then empty fragment");
+    }
+
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    const auto tsdlOk = testTsdl();
+    const auto ctf2Ok = testCtf2();
+
+    return tsdlOk && ctf2Ok ? 0 : 1;
+}
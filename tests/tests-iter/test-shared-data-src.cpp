@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <yactfr/yactfr.hpp>
+
+namespace {
+
+constexpr auto tsdlMetadata =
+    "/* CTF 1.8 */\n"
+    "typealias integer { size = 8; } := u8;"
+    "typealias integer { size = 16; } := u16;"
+    "trace {"
+    "  major = 1;"
+    "  minor = 8;"
+    "  byte_order = be;"
+    "};"
+    "stream {"
+    "  event.header := struct {"
+    "    u8 id;"
+    "  };"
+    "};"
+    "event {"
+    "  id = 1;"
+    "  fields := struct {"
+    "    u8 len;"
+    "    u8 a[len];"
+    "    u16 b;"
+    "  };"
+    "};";
+
+constexpr unsigned int erCount = 12;
+
+// maximum number of elements to look ahead with a copy
+constexpr unsigned int lookaheadLen = 5;
+
+/*
+ * Data source which copies each data block to its own buffer: the last
+ * returned data block is really invalid once it returns a new one.
+ */
+class CopyingDataSrc final :
+    public yactfr::DataSource
+{
+public:
+    explicit CopyingDataSrc(const std::vector<std::uint8_t>& data) :
+        _srcData {&data}
+    {
+    }
+
+private:
+    boost::optional<yactfr::DataBlock> _data(const yactfr::Index offset,
+                                             const yactfr::Size minSize) override
+    {
+        if (offset >= _srcData->size()) {
+            return boost::none;
+        }
+
+        const auto size = std::min(_srcData->size() - offset, std::max<yactfr::Size>(minSize, 3));
+
+        std::fill(_buf.begin(), _buf.end(), 0xff);
+        std::copy(_srcData->begin() + offset, _srcData->begin() + offset + size, _buf.begin());
+        return yactfr::DataBlock {_buf.data(), size};
+    }
+
+private:
+    const std::vector<std::uint8_t> *_srcData;
+    std::vector<std::uint8_t> _buf = std::vector<std::uint8_t>(16);
+};
+
+class CountingDataSrcFactory final :
+    public yactfr::DataSourceFactory
+{
+public:
+    explicit CountingDataSrcFactory(const std::vector<std::uint8_t>& data) :
+        _data {&data}
+    {
+    }
+
+    unsigned int count() const noexcept
+    {
+        return _count;
+    }
+
+private:
+    yactfr::DataSource::Up _createDataSource() override
+    {
+        ++_count;
+        return std::make_unique<CopyingDataSrc>(*_data);
+    }
+
+private:
+    const std::vector<std::uint8_t> *_data;
+    unsigned int _count = 0;
+};
+
+struct Rec final
+{
+    bool operator==(const Rec& other) const noexcept
+    {
+        return kind == other.kind && offset == other.offset && val == other.val;
+    }
+
+    bool operator!=(const Rec& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    yactfr::Element::Kind kind;
+    yactfr::Index offset;
+    unsigned long long val;
+};
+
+Rec rec(const yactfr::ElementSequenceIterator& it)
+{
+    return Rec {
+        it->kind(), it.offset(),
+        it->isFixedLengthUnsignedIntegerElement() ?
+            it->asFixedLengthUnsignedIntegerElement().value() : 0
+    };
+}
+
+std::vector<Rec> refRecs(const yactfr::TraceType& traceType,
+                         const std::vector<std::uint8_t>& data)
+{
+    std::vector<Rec> recs;
+    CountingDataSrcFactory factory {data};
+    yactfr::ElementSequence seq {traceType, factory};
+
+    for (auto it = seq.begin(); it != seq.end(); ++it) {
+        recs.push_back(rec(it));
+    }
+
+    return recs;
+}
+
+/*
+ * Iterates `seq`, looking ahead with a copy of the iterator at each
+ * element and assigning the iterator to a third one from time to time,
+ * and checks the elements against `recs`.
+ */
+bool checkForks(yactfr::ElementSequence& seq, const std::vector<Rec>& recs)
+{
+    auto it = seq.begin();
+    auto other = seq.begin();
+
+    for (auto i = 0U; i < recs.size(); ++i) {
+        if (it == seq.end() || rec(it) != recs[i]) {
+            std::cerr << "Unexpected element #" << i << ".\n";
+            return false;
+        }
+
+        auto lookahead = it;
+
+        for (auto j = i + 1; j < std::min<std::size_t>(i + lookaheadLen, recs.size()); ++j) {
+            ++lookahead;
+
+            if (rec(lookahead) != recs[j]) {
+                std::cerr << "Unexpected element #" << j << " (lookahead from #" << i << ").\n";
+                return false;
+            }
+        }
+
+        if (i % 3 == 0) {
+            other = it;
+            ++other;
+        }
+
+        ++it;
+
+        if (i % 3 == 0 && i + 1 < recs.size() && rec(other) != recs[i + 1]) {
+            std::cerr << "Unexpected element #" << i + 1 << " (assigned copy).\n";
+            return false;
+        }
+    }
+
+    if (it != seq.end()) {
+        std::cerr << "Expecting the end of the element sequence.\n";
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceType = yactfr::fromMetadataText(tsdlMetadata).first;
+    std::vector<std::uint8_t> data;
+
+    for (auto i = 0U; i < erCount; ++i) {
+        const auto len = i % 4;
+
+        data.push_back(1);
+        data.push_back(len);
+
+        for (auto j = 0U; j < len; ++j) {
+            data.push_back(i * 16 + j);
+        }
+
+        data.push_back(i);
+        data.push_back(0x80 | i);
+    }
+
+    const auto recs = refRecs(*traceType, data);
+
+    // shared data source: one data source for all the copies
+    {
+        CountingDataSrcFactory factory {data};
+        yactfr::ElementSequence seq {*traceType, factory};
+
+        seq.iteratorCopiesShareDataSource(true);
+
+        if (!checkForks(seq, recs)) {
+            return 1;
+        }
+
+        if (factory.count() != 2) {
+            std::cerr << "Expecting two data sources, got " << factory.count() << ".\n";
+            return 1;
+        }
+    }
+
+    // default: a new data source for each copy
+    {
+        CountingDataSrcFactory factory {data};
+        yactfr::ElementSequence seq {*traceType, factory};
+
+        if (!checkForks(seq, recs)) {
+            return 1;
+        }
+
+        if (factory.count() != 2 + recs.size()) {
+            std::cerr << "Expecting " << 2 + recs.size() << " data sources, got " <<
+                         factory.count() << ".\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstring>
+#include <sstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <shm-ring-producer.hpp>
+#include <elem-printer.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+void printElem(const yactfr::Element& elem, ElemPrinter& printer)
+{
+    // raw data element boundaries depend on the data block sizes
+    if (!elem.isRawDataElement()) {
+        elem.accept(printer);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceTypeMsUuidPair = yactfr::fromMetadataText(metadata,
+                                                              metadata + std::strlen(metadata));
+
+    // repeat the common stream so that the packets wrap around the ring
+    std::vector<std::uint8_t> data;
+
+    for (auto i = 0U; i < 4; ++i) {
+        data.insert(data.end(), stream, stream + sizeof stream);
+    }
+
+    // expected elements and packets
+    std::string expected;
+    std::vector<std::vector<std::uint8_t>> pkts;
+
+    {
+        std::ostringstream ss;
+        ElemPrinter printer {ss, 0};
+        MemDataSrcFactory factory {data.data(), data.size()};
+        yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, factory};
+        yactfr::Index pktOffset = 0;
+
+        for (auto it = seq.begin(); it != seq.end(); ++it) {
+            printElem(*it, printer);
+
+            if (it->isPacketEndElement()) {
+                const auto pktEndOffset = it.offset() / 8;
+
+                pkts.emplace_back(data.begin() + pktOffset, data.begin() + pktEndOffset);
+                pktOffset = pktEndOffset;
+            }
+        }
+
+        expected = ss.str();
+    }
+
+    ShmRingProducer producer {"/yactfr-test-shm-ring-" + std::to_string(getpid()), 2, 2, 256};
+    yactfr::SharedMemoryRingDataSourceFactory factory {
+        "/yactfr-test-shm-ring-" + std::to_string(getpid())
+    };
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+    std::size_t nextPktIndex = 0;
+    std::size_t notAvailCount = 0;
+    std::size_t fullCount = 0;
+
+    // publish as many packets as possible, closing the ring at the end
+    const auto publish = [&] {
+        while (nextPktIndex < pkts.size()) {
+            const auto& pkt = pkts[nextPktIndex];
+
+            if (!producer.tryPublish(pkt.data(), pkt.size())) {
+                ++fullCount;
+                return;
+            }
+
+            ++nextPktIndex;
+        }
+
+        producer.close();
+    };
+
+    producer.tryPublish(pkts[0].data(), pkts[0].size());
+    ++nextPktIndex;
+
+    {
+        yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, factory};
+        auto it = seq.begin();
+
+        if (producer.consumerCount() != 1) {
+            std::cerr << "Expecting one consumer.\n";
+            return 1;
+        }
+
+        printElem(*it, printer);
+
+        while (true) {
+            const auto res = it.tryAdvance();
+
+            if (res == yactfr::ElementSequenceIterator::AdvanceResult::End) {
+                break;
+            } else if (res == yactfr::ElementSequenceIterator::AdvanceResult::DataNotAvailable) {
+                ++notAvailCount;
+                publish();
+                continue;
+            }
+
+            printElem(*it, printer);
+        }
+    }
+
+    if (ss.str() != expected) {
+        std::cerr << "Expected:\n\n" << expected << "\nGot:\n\n" << ss.str();
+        return 1;
+    }
+
+    if (nextPktIndex != pkts.size()) {
+        std::cerr << "Expecting all the packets to be published.\n";
+        return 1;
+    }
+
+    if (notAvailCount == 0 || fullCount == 0) {
+        std::cerr << "Expecting data not to be available and the ring to be full at least once.\n";
+        return 1;
+    }
+
+    if (producer.consumerCount() != 0) {
+        std::cerr << "Expecting the data source to release its consumer position entry.\n";
+        return 1;
+    }
+
+    // a lagging copy doesn't share the data source of its original
+    std::string expectedTwoPkts;
+
+    {
+        std::vector<std::uint8_t> twoPktsData {pkts[0]};
+
+        twoPktsData.insert(twoPktsData.end(), pkts[1].begin(), pkts[1].end());
+
+        std::ostringstream twoPktsSs;
+        ElemPrinter twoPktsPrinter {twoPktsSs, 0};
+        MemDataSrcFactory twoPktsFactory {twoPktsData.data(), twoPktsData.size()};
+        yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, twoPktsFactory};
+
+        for (auto it = seq.begin(); it != seq.end(); ++it) {
+            printElem(*it, twoPktsPrinter);
+        }
+
+        expectedTwoPkts = twoPktsSs.str();
+    }
+
+    ShmRingProducer copyProducer {
+        "/yactfr-test-shm-ring-copy-" + std::to_string(getpid()), 2, 2, 256
+    };
+    yactfr::SharedMemoryRingDataSourceFactory copyFactory {
+        "/yactfr-test-shm-ring-copy-" + std::to_string(getpid())
+    };
+
+    copyProducer.tryPublish(pkts[0].data(), pkts[0].size());
+
+    {
+        yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, copyFactory};
+
+        seq.iteratorCopiesShareDataSource(true);
+
+        auto it = seq.begin();
+        auto itCopy = it;
+
+        if (copyProducer.consumerCount() != 2) {
+            std::cerr << "Expecting the iterator copy to have its own data source.\n";
+            return 1;
+        }
+
+        copyProducer.tryPublish(pkts[1].data(), pkts[1].size());
+        copyProducer.close();
+
+        for (auto curIt : {&it, &itCopy}) {
+            std::ostringstream itSs;
+            ElemPrinter itPrinter {itSs, 0};
+
+            for (; *curIt != seq.end(); ++*curIt) {
+                printElem(**curIt, itPrinter);
+            }
+
+            if (itSs.str() != expectedTwoPkts) {
+                std::cerr << "Expected:\n\n" << expectedTwoPkts << "\nGot:\n\n" << itSs.str();
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
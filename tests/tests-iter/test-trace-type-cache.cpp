@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <sstream>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+std::string elemSeqStr(const yactfr::TraceType& traceType)
+{
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+    MemDataSrcFactory factory {stream, sizeof stream};
+    yactfr::ElementSequence seq {traceType, factory};
+
+    for (const auto& elem : seq) {
+        elem.accept(printer);
+    }
+
+    return ss.str();
+}
+
+bool readFile(const std::string& path, std::string& contents)
+{
+    std::ifstream file {path, std::ios::binary};
+
+    if (!file) {
+        return false;
+    }
+
+    std::ostringstream ss;
+
+    ss << file.rdbuf();
+    contents = ss.str();
+    return true;
+}
+
+void writeFile(const std::string& path, const std::string& contents)
+{
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+
+    file.write(contents.data(), contents.size());
+}
+
+/*
+ * Returns the number of entries of the directory `path`, excluding
+ * `.` and `..`.
+ */
+unsigned int dirEntryCount(const char * const path)
+{
+    const auto dir = opendir(path);
+
+    if (!dir) {
+        return 0;
+    }
+
+    unsigned int count = 0;
+
+    while (const auto entry = readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+            ++count;
+        }
+    }
+
+    closedir(dir);
+    return count;
+}
+
+/*
+ * Checks that `ret` is equivalent to `expectedRet`, printing `what` on
+ * failure.
+ */
+bool checkRet(const yactfr::FromMetadataTextReturn& ret,
+              const yactfr::FromMetadataTextReturn& expectedRet, const char * const what)
+{
+    if (ret.second != expectedRet.second) {
+        std::cerr << what << ": metadata stream UUID mismatch.\n";
+        return false;
+    }
+
+    if (!ret.first->packetHeaderType() ||
+            ret.first->packetHeaderType()->size() !=
+            expectedRet.first->packetHeaderType()->size()) {
+        std::cerr << what << ": packet header type mismatch.\n";
+        return false;
+    }
+
+    if (ret.first->dataStreamTypes().size() != expectedRet.first->dataStreamTypes().size()) {
+        std::cerr << what << ": data stream type count mismatch.\n";
+        return false;
+    }
+
+    const auto expected = elemSeqStr(*expectedRet.first);
+    const auto got = elemSeqStr(*ret.first);
+
+    if (got != expected) {
+        std::cerr << what << ": expected:\n\n" << expected << "\nGot:\n\n" << got;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    const auto metadataEnd = metadata + std::strlen(metadata);
+    const auto expectedRet = yactfr::fromMetadataText(metadata, metadataEnd);
+    char dirPath[] = "/tmp/yactfr-test-trace-type-cache-XXXXXX";
+
+    if (!mkdtemp(dirPath)) {
+        std::cerr << "Cannot create temporary directory.\n";
+        return 1;
+    }
+
+    const yactfr::TraceTypeCache cache {dirPath};
+    const auto filePath = cache.filePath(metadata, metadataEnd);
+    const auto otherMetadata = std::string {metadata} + "\n/* other */\n";
+    const auto otherFilePath = cache.filePath(otherMetadata.data(),
+                                              otherMetadata.data() + otherMetadata.size());
+    auto ok = true;
+
+    // cold: parses and writes the cache file
+    ok = ok && checkRet(cache.fromMetadataText(metadata, metadataEnd), expectedRet, "Cold");
+
+    std::string bin;
+
+    if (ok && !readFile(filePath, bin)) {
+        std::cerr << "Cache file `" << filePath << "` doesn't exist.\n";
+        ok = false;
+    }
+
+    // warm: loads the cache file
+    ok = ok && checkRet(cache.fromMetadataText(metadata, metadataEnd), expectedRet, "Warm");
+
+    // unexpected format version: falls back to parsing and rewrites
+    if (ok) {
+        auto badBin = bin;
+
+        badBin[8] = 0x7f;
+        writeFile(filePath, badBin);
+        ok = checkRet(cache.fromMetadataText(metadata, metadataEnd), expectedRet,
+                      "Format version mismatch");
+
+        std::string newBin;
+
+        if (ok && (!readFile(filePath, newBin) || newBin != bin)) {
+            std::cerr << "Cache file wasn't rewritten after a format version mismatch.\n";
+            ok = false;
+        }
+    }
+
+    // truncated cache file: falls back to parsing
+    if (ok) {
+        writeFile(filePath, bin.substr(0, bin.size() / 2));
+        ok = checkRet(cache.fromMetadataText(metadata, metadataEnd), expectedRet, "Truncated");
+    }
+
+    // other metadata text with the same cache file: falls back to parsing
+    if (ok) {
+        writeFile(otherFilePath, bin);
+        ok = checkRet(cache.fromMetadataText(otherMetadata), expectedRet, "Other text");
+    }
+
+    // cache directory which doesn't exist: only parses
+    if (ok) {
+        const yactfr::TraceTypeCache noDirCache {std::string {dirPath} + "/nope"};
+
+        ok = checkRet(noDirCache.fromMetadataText(metadata, metadataEnd), expectedRet,
+                      "Missing directory");
+    }
+
+    // concurrent cold fills of the same cache file within this process
+    if (ok) {
+        std::remove(filePath.c_str());
+        std::remove(otherFilePath.c_str());
+
+        std::vector<yactfr::FromMetadataTextReturn> rets(8);
+        std::vector<std::thread> threads;
+
+        for (auto& ret : rets) {
+            threads.emplace_back([&cache, &ret, metadataEnd] {
+                ret = cache.fromMetadataText(metadata, metadataEnd);
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& ret : rets) {
+            ok = ok && checkRet(ret, expectedRet, "Concurrent cold");
+        }
+
+        std::string newBin;
+
+        if (ok && (!readFile(filePath, newBin) || newBin != bin)) {
+            std::cerr << "Unexpected cache file after concurrent cold fills.\n";
+            ok = false;
+        }
+
+        // only the cache file: no temporary file left
+        if (ok && dirEntryCount(dirPath) != 1) {
+            std::cerr << "Unexpected files left after concurrent cold fills.\n";
+            ok = false;
+        }
+    }
+
+    std::remove(filePath.c_str());
+    std::remove(otherFilePath.c_str());
+    rmdir(dirPath);
+    return ok ? 0 : 1;
+}
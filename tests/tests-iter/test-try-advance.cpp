@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+#include <vector>
+
+#include <yactfr/yactfr.hpp>
+
+#include <mem-data-src-factory.hpp>
+#include <elem-printer.hpp>
+#include <common-trace.hpp>
+
+namespace {
+
+/*
+ * Memory data source of which the available data is limited to the
+ * first `*avail` bytes: it reports that the data after is not available
+ * now, without throwing from tryData().
+ */
+class GrowingMemDataSrc final :
+    public yactfr::DataSource
+{
+public:
+    explicit GrowingMemDataSrc(const std::vector<std::uint8_t>& data, const std::size_t& avail,
+                               std::size_t& throwCount) :
+        _buf {&data},
+        _avail {&avail},
+        _throwCount {&throwCount}
+    {
+    }
+
+private:
+    boost::optional<yactfr::DataBlock> _data(const yactfr::Index offset,
+                                             const yactfr::Size minSize) override
+    {
+        bool isAvailable;
+        auto dataBlock = this->_tryData(offset, minSize, isAvailable);
+
+        if (!isAvailable) {
+            ++*_throwCount;
+            throw yactfr::DataNotAvailable {};
+        }
+
+        return dataBlock;
+    }
+
+    boost::optional<yactfr::DataBlock> _tryData(const yactfr::Index offset,
+                                                const yactfr::Size minSize,
+                                                bool& isAvailable) override
+    {
+        isAvailable = true;
+
+        if (offset + minSize > *_avail) {
+            if (*_avail < _buf->size()) {
+                isAvailable = false;
+            }
+
+            return boost::none;
+        }
+
+        // small data blocks to also exercise data block boundaries
+        return yactfr::DataBlock {
+            static_cast<const void *>(_buf->data() + offset),
+            std::min(*_avail - offset, std::max(minSize, static_cast<yactfr::Size>(3)))
+        };
+    }
+
+private:
+    const std::vector<std::uint8_t> *_buf;
+    const std::size_t *_avail;
+    std::size_t *_throwCount;
+};
+
+class GrowingMemDataSrcFactory final :
+    public yactfr::DataSourceFactory
+{
+public:
+    explicit GrowingMemDataSrcFactory(const std::vector<std::uint8_t>& data) :
+        _data {&data}
+    {
+    }
+
+    // makes one more byte available
+    void grow() noexcept
+    {
+        ++_avail;
+    }
+
+    std::size_t throwCount() const noexcept
+    {
+        return _throwCount;
+    }
+
+private:
+    yactfr::DataSource::Up _createDataSource() override
+    {
+        return std::make_unique<GrowingMemDataSrc>(*_data, _avail, _throwCount);
+    }
+
+private:
+    const std::vector<std::uint8_t> *_data;
+    std::size_t _avail = 1;
+    std::size_t _throwCount = 0;
+};
+
+void printElem(const yactfr::Element& elem, ElemPrinter& printer)
+{
+    // raw data element boundaries depend on the data block sizes
+    if (elem.isRawDataElement()) {
+        return;
+    }
+
+    elem.accept(printer);
+}
+
+} // namespace
+
+int main()
+{
+    const auto traceTypeMsUuidPair = yactfr::fromMetadataText(metadata,
+                                                              metadata + std::strlen(metadata));
+    const std::vector<std::uint8_t> data {stream, stream + sizeof stream};
+    std::string expected;
+
+    {
+        std::ostringstream ss;
+        ElemPrinter printer {ss, 0};
+        MemDataSrcFactory factory {data.data(), data.size()};
+        yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, factory};
+
+        for (const auto& elem : seq) {
+            printElem(elem, printer);
+        }
+
+        expected = ss.str();
+    }
+
+    /*
+     * Make a single byte available at a time: the iterator must resume
+     * exactly where it stopped each time.
+     */
+    std::ostringstream ss;
+    ElemPrinter printer {ss, 0};
+    GrowingMemDataSrcFactory factory {data};
+    yactfr::ElementSequence seq {*traceTypeMsUuidPair.first, factory};
+    auto it = seq.begin();
+    std::size_t notAvailCount = 0;
+
+    printElem(*it, printer);
+
+    while (true) {
+        const auto res = it.tryAdvance();
+
+        if (res == yactfr::ElementSequenceIterator::AdvanceResult::End) {
+            break;
+        } else if (res == yactfr::ElementSequenceIterator::AdvanceResult::DataNotAvailable) {
+            ++notAvailCount;
+            factory.grow();
+            continue;
+        }
+
+        printElem(*it, printer);
+    }
+
+    if (ss.str() != expected) {
+        std::cerr << "Expected:\n\n" << expected << "\nGot:\n\n" << ss.str();
+        return 1;
+    }
+
+    if (notAvailCount == 0) {
+        std::cerr << "Expecting data not to be available at least once.\n";
+        return 1;
+    }
+
+    if (factory.throwCount() != 0) {
+        std::cerr << "Expecting no DataNotAvailable exception, got " <<
+                     factory.throwCount() << ".\n";
+        return 1;
+    }
+
+    return 0;
+}
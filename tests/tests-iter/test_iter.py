@@ -23,6 +23,78 @@ def test_move_assign(iter_executor):
     iter_executor('move-assign')
 
 
+def test_mmap_hints(iter_executor):
+    iter_executor('mmap-hints')
+
+
+def test_mmap_drop_behind(iter_executor):
+    iter_executor('mmap-drop-behind')
+
+
+def test_mmap_follow(iter_executor):
+    iter_executor('mmap-follow')
+
+
+def test_try_advance(iter_executor):
+    iter_executor('try-advance')
+
+
+def test_shm_ring(iter_executor):
+    iter_executor('shm-ring')
+
+
+def test_trace_type_cache(iter_executor):
+    iter_executor('trace-type-cache')
+
+
+def test_incr_metadata_text_parser(iter_executor):
+    iter_executor('incr-metadata-text-parser')
+
+
+def test_parallel_metadata_parsing(iter_executor):
+    iter_executor('parallel-metadata-parsing')
+
+
+def test_dt_content_sharing(iter_executor):
+    iter_executor('dt-content-sharing')
+
+
+def test_lazy_er_procs(iter_executor):
+    iter_executor('lazy-er-procs')
+
+
+def test_checkpoint(iter_executor):
+    iter_executor('checkpoint')
+
+
+def test_no_alloc(iter_executor):
+    iter_executor('no-alloc')
+
+
+def test_shared_data_src(iter_executor):
+    iter_executor('shared-data-src')
+
+
+def test_decode(iter_executor):
+    iter_executor('decode')
+
+
+def test_er_columnar_export(iter_executor):
+    iter_executor('er-columnar-export')
+
+
+def test_er_row(iter_executor):
+    iter_executor('er-row')
+
+
+def test_field_handle(iter_executor):
+    iter_executor('field-handle')
+
+
+def test_elem_seq_metrics(iter_executor):
+    iter_executor('elem-seq-metrics')
+
+
 def test_move_ctor(iter_executor):
     iter_executor('move-ctor')
 
@@ -10,14 +10,21 @@ def _metadata_stream_path(name):
     return os.path.join(os.path.dirname(__file__), name)
 
 
+# input file stream, memory range, and file path
+_MODES = ['0', 'm', 'p']
+
+
 def _exec_fail(name, offset):
-    assert(subprocess.call([_TESTER_PATH, '0', _metadata_stream_path(f'fail-{name}'), str(offset)]) == 2)
+    for mode in _MODES:
+        assert(subprocess.call([_TESTER_PATH, mode, _metadata_stream_path(f'fail-{name}'),
+                                str(offset)]) == 2)
 
 
 def _exec_pass(name, expected):
-    output = subprocess.check_output([_TESTER_PATH, '0', _metadata_stream_path(f'pass-{name}')],
-                                     text=True)
-    assert(output.strip() == expected.strip())
+    for mode in _MODES:
+        output = subprocess.check_output([_TESTER_PATH, mode,
+                                          _metadata_stream_path(f'pass-{name}')], text=True)
+        assert(output.strip() == expected.strip())
 
 
 @pytest.fixture
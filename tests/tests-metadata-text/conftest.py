@@ -73,6 +73,16 @@ class _MetadataTextItem(pytest.Item):
         if output != expect:
             raise yactfrutils.UnexpectedOutput(output, expect)
 
+        # the trace type must survive a binary form round trip
+        if expect_to_pass:
+            tester_path = os.path.join(os.environ['YACTFR_BINARY_DIR'], 'tests', 'testers',
+                                       'trace-type-bin-tester')
+            output = subprocess.check_output([tester_path, metadata_stream_path], text=True)
+            output = output.strip('\n')
+
+            if output != '':
+                raise yactfrutils.UnexpectedOutput(output, '')
+
         # delete temporary directory, if any
         if tmp_dir is not None:
             #tmp_dir.cleanup()
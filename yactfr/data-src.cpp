@@ -5,6 +5,8 @@
  * of the MIT license. See the LICENSE file for details.
  */
 
+#include <cassert>
+
 #include <yactfr/data-src.hpp>
 
 namespace yactfr {
@@ -23,4 +25,49 @@ boost::optional<DataBlock> DataSource::data(const Index offset, const Size minSi
     return dataBlock;
 }
 
+boost::optional<DataBlock> DataSource::tryData(const Index offset, const Size minSize,
+                                               bool& isAvailable)
+{
+    assert(minSize <= 9);
+
+    const auto dataBlock = this->_tryData(offset, minSize, isAvailable);
+
+    assert(!dataBlock || isAvailable);
+    assert(!dataBlock || dataBlock->size() >= minSize);
+    return dataBlock;
+}
+
+boost::optional<DataBlock> DataSource::_tryData(const Index offset, const Size minSize,
+                                                bool& isAvailable)
+{
+    try {
+        auto dataBlock = this->_data(offset, minSize);
+
+        isAvailable = true;
+        return dataBlock;
+    } catch (const DataNotAvailable&) {
+        isAvailable = false;
+        return boost::none;
+    }
+}
+
+void DataSource::releaseDataBefore(const Index offset) noexcept
+{
+    this->_releaseDataBefore(offset);
+}
+
+void DataSource::_releaseDataBefore(Index) noexcept
+{
+}
+
+bool DataSource::isShareable() const noexcept
+{
+    return this->_isShareable();
+}
+
+bool DataSource::_isShareable() const noexcept
+{
+    return true;
+}
+
 } // namespace yactfr
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <yactfr/elem-seq-it-checkpoint.hpp>
+
+#include "internal/it-checkpoint.hpp"
+
+namespace yactfr {
+
+ElementSequenceIteratorCheckpoint::ElementSequenceIteratorCheckpoint(Data data) :
+    _data {std::move(data)}
+{
+    const auto contents = internal::itCheckpointFromData(_data);
+
+    _offset = contents.pktOffsetBytes * 8 + contents.elemOffsetInPktBits;
+    _mark = contents.mark;
+}
+
+} // namespace yactfr
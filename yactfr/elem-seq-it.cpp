@@ -6,6 +6,7 @@
  */
 
 #include <yactfr/elem-seq-it.hpp>
+#include <yactfr/field-handle.hpp>
 
 #include "internal/vm.hpp"
 #include "internal/metadata/trace-type-impl.hpp"
@@ -15,14 +16,19 @@ namespace yactfr {
 constexpr Index ElementSequenceIterator::_endOffset = static_cast<Index>(~0ULL);
 
 ElementSequenceIterator::ElementSequenceIterator(DataSourceFactory& dataSrcFactory,
-                                                 const TraceType& traceType, const bool end) :
+                                                 const TraceType& traceType, const bool end,
+                                                 const bool copiesShareDataSrc,
+                                                 ElementSequenceMetrics * const metrics) :
     _dataSrcFactory {&dataSrcFactory},
-    _traceType {&traceType}
+    _traceType {&traceType},
+    _copiesShareDataSrc {copiesShareDataSrc},
+    _metrics {metrics}
 {
     if (end) {
         _offset = _endOffset;
     } else {
-        _vm = std::make_unique<internal::Vm>(*_dataSrcFactory, traceType._pimpl->pktProc(), *this);
+        _vm = std::make_unique<internal::Vm>(*_dataSrcFactory, _copiesShareDataSrc,
+                                             traceType._pimpl->pktProc(), *this);
         _vm->nextElem();
     }
 }
@@ -37,6 +43,8 @@ void ElementSequenceIterator::_resetOther(ElementSequenceIterator& other)
 ElementSequenceIterator::ElementSequenceIterator(const ElementSequenceIterator& other) :
     _dataSrcFactory {other._dataSrcFactory},
     _traceType {other._traceType},
+    _copiesShareDataSrc {other._copiesShareDataSrc},
+    _metrics {other._metrics},
     _offset {other._offset},
     _mark {other._mark}
 {
@@ -56,6 +64,8 @@ ElementSequenceIterator::ElementSequenceIterator(const ElementSequenceIterator&
 ElementSequenceIterator::ElementSequenceIterator(ElementSequenceIterator&& other) :
     _dataSrcFactory {other._dataSrcFactory},
     _traceType {other._traceType},
+    _copiesShareDataSrc {other._copiesShareDataSrc},
+    _metrics {other._metrics},
     _offset {other._offset},
     _mark {other._mark}
 {
@@ -84,6 +94,7 @@ ElementSequenceIterator& ElementSequenceIterator::operator=(const ElementSequenc
      */
     assert(_dataSrcFactory == other._dataSrcFactory);
     assert(_traceType == other._traceType);
+    _metrics = other._metrics;
     _offset = other._offset;
     _mark = other._mark;
 
@@ -110,6 +121,7 @@ ElementSequenceIterator& ElementSequenceIterator::operator=(ElementSequenceItera
      */
     assert(_dataSrcFactory == other._dataSrcFactory);
     assert(_traceType == other._traceType);
+    _metrics = other._metrics;
     _offset = other._offset;
     _mark = other._mark;
 
@@ -128,6 +140,13 @@ ElementSequenceIterator& ElementSequenceIterator::operator=(ElementSequenceItera
     return *this;
 }
 
+void ElementSequenceIterator::_decode(const _tSinkFunc sinkFunc, void * const sink)
+{
+    assert(_offset != _endOffset);
+    assert(_vm);
+    _vm->decode(sinkFunc, sink);
+}
+
 ElementSequenceIterator& ElementSequenceIterator::operator++()
 {
     assert(_offset != _endOffset);
@@ -136,6 +155,18 @@ ElementSequenceIterator& ElementSequenceIterator::operator++()
     return *this;
 }
 
+ElementSequenceIterator::AdvanceResult ElementSequenceIterator::tryAdvance()
+{
+    assert(_offset != _endOffset);
+    assert(_vm);
+
+    if (!_vm->tryNextElem()) {
+        return AdvanceResult::DataNotAvailable;
+    }
+
+    return _offset == _endOffset ? AdvanceResult::End : AdvanceResult::Element;
+}
+
 void ElementSequenceIterator::seekPacket(const Index offset)
 {
     assert(_vm);
@@ -155,11 +186,50 @@ void ElementSequenceIterator::restorePosition(const ElementSequenceIteratorPosit
          * This iterator is at the end of the element sequence and has
          * no VM. Create a new VM before restoring the VM's position.
          */
-        _vm = std::make_unique<internal::Vm>(*_dataSrcFactory, _traceType->_pimpl->pktProc(),
-                                             *this);
+        _vm = std::make_unique<internal::Vm>(*_dataSrcFactory, _copiesShareDataSrc,
+                                             _traceType->_pimpl->pktProc(), *this);
     }
 
     _vm->restorePos(pos);
 }
 
+void ElementSequenceIterator::saveCheckpoint(ElementSequenceIteratorCheckpoint& checkpoint) const
+{
+    assert(_vm);
+    _vm->saveCheckpoint(checkpoint);
+}
+
+void ElementSequenceIterator::restoreCheckpoint(const ElementSequenceIteratorCheckpoint& checkpoint)
+{
+    if (!_vm) {
+        // see restorePosition()
+        _vm = std::make_unique<internal::Vm>(*_dataSrcFactory, _copiesShareDataSrc,
+                                             _traceType->_pimpl->pktProc(), *this);
+    }
+
+    _vm->restoreCheckpoint(checkpoint);
+}
+
+const EventRecordRowLayout *ElementSequenceIterator::eventRecordRowLayout() const noexcept
+{
+    assert(_vm);
+
+    const auto erProc = _vm->pos().curErProc;
+
+    return erProc ? erProc->rowLayout() : nullptr;
+}
+
+void ElementSequenceIterator::readEventRecordRow(void * const row)
+{
+    assert(_vm);
+    assert(_curElem && _curElem->isEventRecordInfoElement());
+    _vm->readErRow(static_cast<std::uint8_t *>(row));
+}
+
+boost::optional<std::uint64_t> ElementSequenceIterator::fieldValue(const FieldHandle& handle) const noexcept
+{
+    assert(_vm);
+    return _vm->fieldVal(handle._index);
+}
+
 } // namespace yactfr
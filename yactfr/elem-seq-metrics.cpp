@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cassert>
+
+#include <yactfr/elem-seq-metrics.hpp>
+#include <yactfr/metadata/trace-type.hpp>
+
+namespace yactfr {
+namespace {
+
+// index of `kind` within the element count array
+Index elemKindIndex(const Element::Kind kind) noexcept
+{
+    switch (kind) {
+    case Element::Kind::PacketBeginning:
+        return 0;
+
+    case Element::Kind::PacketEnd:
+        return 1;
+
+    case Element::Kind::ScopeBeginning:
+        return 2;
+
+    case Element::Kind::ScopeEnd:
+        return 3;
+
+    case Element::Kind::PacketContentBeginning:
+        return 4;
+
+    case Element::Kind::PacketContentEnd:
+        return 5;
+
+    case Element::Kind::EventRecordBeginning:
+        return 6;
+
+    case Element::Kind::EventRecordEnd:
+        return 7;
+
+    case Element::Kind::PacketMagicNumber:
+        return 8;
+
+    case Element::Kind::MetadataStreamUuid:
+        return 9;
+
+    case Element::Kind::DataStreamInfo:
+        return 10;
+
+    case Element::Kind::DefaultClockValue:
+        return 11;
+
+    case Element::Kind::PacketInfo:
+        return 12;
+
+    case Element::Kind::EventRecordInfo:
+        return 13;
+
+    case Element::Kind::FixedLengthBitArray:
+        return 14;
+
+    case Element::Kind::FixedLengthBitMap:
+        return 15;
+
+    case Element::Kind::FixedLengthBoolean:
+        return 16;
+
+    case Element::Kind::FixedLengthSignedInteger:
+        return 17;
+
+    case Element::Kind::FixedLengthUnsignedInteger:
+        return 18;
+
+    case Element::Kind::FixedLengthFloatingPointNumber:
+        return 19;
+
+    case Element::Kind::VariableLengthSignedInteger:
+        return 20;
+
+    case Element::Kind::VariableLengthUnsignedInteger:
+        return 21;
+
+    case Element::Kind::NullTerminatedStringBeginning:
+        return 22;
+
+    case Element::Kind::NullTerminatedStringEnd:
+        return 23;
+
+    case Element::Kind::RawData:
+        return 24;
+
+    case Element::Kind::StructureBeginning:
+        return 25;
+
+    case Element::Kind::StructureEnd:
+        return 26;
+
+    case Element::Kind::StaticLengthArrayBeginning:
+        return 27;
+
+    case Element::Kind::StaticLengthArrayEnd:
+        return 28;
+
+    case Element::Kind::DynamicLengthArrayBeginning:
+        return 29;
+
+    case Element::Kind::DynamicLengthArrayEnd:
+        return 30;
+
+    case Element::Kind::StaticLengthBlobBeginning:
+        return 31;
+
+    case Element::Kind::StaticLengthBlobEnd:
+        return 32;
+
+    case Element::Kind::DynamicLengthBlobBeginning:
+        return 33;
+
+    case Element::Kind::DynamicLengthBlobEnd:
+        return 34;
+
+    case Element::Kind::StaticLengthStringBeginning:
+        return 35;
+
+    case Element::Kind::StaticLengthStringEnd:
+        return 36;
+
+    case Element::Kind::DynamicLengthStringBeginning:
+        return 37;
+
+    case Element::Kind::DynamicLengthStringEnd:
+        return 38;
+
+    case Element::Kind::VariantWithSignedIntegerSelectorBeginning:
+        return 39;
+
+    case Element::Kind::VariantWithSignedIntegerSelectorEnd:
+        return 40;
+
+    case Element::Kind::VariantWithUnsignedIntegerSelectorBeginning:
+        return 41;
+
+    case Element::Kind::VariantWithUnsignedIntegerSelectorEnd:
+        return 42;
+
+    case Element::Kind::OptionalWithBooleanSelectorBeginning:
+        return 43;
+
+    case Element::Kind::OptionalWithBooleanSelectorEnd:
+        return 44;
+
+    case Element::Kind::OptionalWithSignedIntegerSelectorBeginning:
+        return 45;
+
+    case Element::Kind::OptionalWithSignedIntegerSelectorEnd:
+        return 46;
+
+    case Element::Kind::OptionalWithUnsignedIntegerSelectorBeginning:
+        return 47;
+
+    case Element::Kind::OptionalWithUnsignedIntegerSelectorEnd:
+        return 48;
+
+    default:
+        std::abort();
+    }
+}
+
+} // namespace
+
+constexpr Size ElementSequenceMetrics::incrementDurationHistogramSize;
+constexpr Size ElementSequenceMetrics::_elemKindCount;
+
+void ElementSequenceMetrics::EventRecordTypeMetrics::_reset() noexcept
+{
+    _count.store(0, std::memory_order_relaxed);
+    _sampledCount.store(0, std::memory_order_relaxed);
+    _sampledDurNs.store(0, std::memory_order_relaxed);
+}
+
+ElementSequenceMetrics::ElementSequenceMetrics(const TraceType& traceType,
+                                               const unsigned int samplingPeriod) :
+    _traceType {&traceType},
+    _samplingPeriod {samplingPeriod}
+{
+    assert(samplingPeriod >= 1);
+
+    for (auto& counter : _elemCounts) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& counter : _incrDurCounts) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& dst : traceType) {
+        _dstErCounts.emplace(dst.get(), std::make_unique<std::atomic<unsigned long long>>(0));
+
+        for (auto& ert : dst->eventRecordTypes()) {
+            _ertMetrics.emplace(ert.get(),
+                                std::unique_ptr<EventRecordTypeMetrics> {new EventRecordTypeMetrics});
+        }
+    }
+}
+
+bool ElementSequenceMetrics::isSupported() noexcept
+{
+#ifdef YACTFR_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned long long ElementSequenceMetrics::eventRecordCount(const DataStreamType& dst) const noexcept
+{
+    const auto it = _dstErCounts.find(&dst);
+
+    if (it == _dstErCounts.end()) {
+        return 0;
+    }
+
+    return it->second->load(std::memory_order_relaxed);
+}
+
+const ElementSequenceMetrics::EventRecordTypeMetrics *ElementSequenceMetrics::eventRecordTypeMetrics(const EventRecordType& ert) const noexcept
+{
+    const auto it = _ertMetrics.find(&ert);
+
+    if (it == _ertMetrics.end()) {
+        return nullptr;
+    }
+
+    return it->second.get();
+}
+
+unsigned long long ElementSequenceMetrics::elementCount(const Element::Kind kind) const noexcept
+{
+    return _elemCounts[elemKindIndex(kind)].load(std::memory_order_relaxed);
+}
+
+void ElementSequenceMetrics::reset() noexcept
+{
+    _byteCount.store(0, std::memory_order_relaxed);
+    _pktCount.store(0, std::memory_order_relaxed);
+    _erCount.store(0, std::memory_order_relaxed);
+
+    for (auto& counter : _elemCounts) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& counter : _incrDurCounts) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& dstCounterPair : _dstErCounts) {
+        dstCounterPair.second->store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& ertMetricsPair : _ertMetrics) {
+        ertMetricsPair.second->_reset();
+    }
+}
+
+void ElementSequenceMetrics::_countElem(const Element::Kind kind) noexcept
+{
+    ElementSequenceMetrics::_add(_elemCounts[elemKindIndex(kind)]);
+}
+
+void ElementSequenceMetrics::_countPkt(const Size byteCount) noexcept
+{
+    ElementSequenceMetrics::_add(_pktCount);
+    ElementSequenceMetrics::_add(_byteCount, byteCount);
+}
+
+void ElementSequenceMetrics::_countEr(const EventRecordType& ert) noexcept
+{
+    ElementSequenceMetrics::_add(_erCount);
+
+    const auto ertIt = _ertMetrics.find(&ert);
+
+    if (ertIt != _ertMetrics.end()) {
+        ElementSequenceMetrics::_add(ertIt->second->_count);
+    }
+
+    const auto dstIt = _dstErCounts.find(ert.dataStreamType());
+
+    if (dstIt != _dstErCounts.end()) {
+        ElementSequenceMetrics::_add(*dstIt->second);
+    }
+}
+
+void ElementSequenceMetrics::_addSampledErDur(const EventRecordType& ert,
+                                              const std::chrono::nanoseconds dur) noexcept
+{
+    const auto it = _ertMetrics.find(&ert);
+
+    if (it == _ertMetrics.end()) {
+        return;
+    }
+
+    ElementSequenceMetrics::_add(it->second->_sampledCount);
+    ElementSequenceMetrics::_add(it->second->_sampledDurNs, dur.count());
+}
+
+void ElementSequenceMetrics::_addIncrDur(const std::chrono::nanoseconds dur) noexcept
+{
+    // index of the most significant bit
+    auto ns = static_cast<unsigned long long>(dur.count());
+    Index index = 0;
+
+    while (ns > 1 && index < incrementDurationHistogramSize - 1) {
+        ns >>= 1;
+        ++index;
+    }
+
+    ElementSequenceMetrics::_add(_incrDurCounts[index]);
+}
+
+} // namespace yactfr
@@ -27,12 +27,14 @@ ElementSequence::Iterator ElementSequence::at(const Index offset)
 
 ElementSequence::Iterator ElementSequence::begin()
 {
-    return ElementSequence::Iterator {*_dataSrcFactory, *_traceType, false};
+    return ElementSequence::Iterator {*_dataSrcFactory, *_traceType, false, _itCopiesShareDataSrc,
+                                     _metrics};
 }
 
 ElementSequence::Iterator ElementSequence::end() noexcept
 {
-    return ElementSequence::Iterator {*_dataSrcFactory, *_traceType, true};
+    return ElementSequence::Iterator {*_dataSrcFactory, *_traceType, true, _itCopiesShareDataSrc,
+                                     _metrics};
 }
 
 } // namespace yactfr
@@ -0,0 +1,575 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include <yactfr/er-columnar-exporter.hpp>
+#include <yactfr/decoding-errors.hpp>
+#include <yactfr/metadata/ert.hpp>
+#include <yactfr/metadata/struct-type.hpp>
+#include <yactfr/metadata/struct-member-type.hpp>
+#include <yactfr/metadata/var-type.hpp>
+#include <yactfr/metadata/opt-type.hpp>
+#include <yactfr/metadata/nt-str-type.hpp>
+#include <yactfr/metadata/non-nt-str-type.hpp>
+#include <yactfr/metadata/blob-type.hpp>
+
+namespace yactfr {
+namespace {
+
+/*
+ * Size of a value of a fixed-width column of type `type`.
+ */
+Size fixedWidthValSize(const EventRecordColumn::Type type) noexcept
+{
+    return type == EventRecordColumn::Type::Boolean ? 1 : 8;
+}
+
+bool isVarWidthColType(const EventRecordColumn::Type type) noexcept
+{
+    return type == EventRecordColumn::Type::String || type == EventRecordColumn::Type::Blob;
+}
+
+/*
+ * Size of a code unit of a string having the encoding `encoding`.
+ */
+Size strCodeUnitSize(const StringEncoding encoding) noexcept
+{
+    switch (encoding) {
+    case StringEncoding::Utf8:
+        return 1;
+
+    case StringEncoding::Utf16Be:
+    case StringEncoding::Utf16Le:
+        return 2;
+
+    default:
+        return 4;
+    }
+}
+
+} // namespace
+
+EventRecordColumn::EventRecordColumn(std::string name, const Type type, const DataType * const dt) :
+    _name {std::move(name)},
+    _type {type},
+    _dt {dt}
+{
+    if (isVarWidthColType(type)) {
+        _offsets.push_back(0);
+    }
+}
+
+std::uint64_t EventRecordColumn::unsignedIntegerValue(const Index index) const noexcept
+{
+    assert(index < _size);
+
+    std::uint64_t val;
+
+    std::memcpy(&val, _vals.data() + index * sizeof val, sizeof val);
+    return val;
+}
+
+std::int64_t EventRecordColumn::signedIntegerValue(const Index index) const noexcept
+{
+    assert(index < _size);
+
+    std::int64_t val;
+
+    std::memcpy(&val, _vals.data() + index * sizeof val, sizeof val);
+    return val;
+}
+
+double EventRecordColumn::floatingPointNumberValue(const Index index) const noexcept
+{
+    assert(index < _size);
+
+    double val;
+
+    std::memcpy(&val, _vals.data() + index * sizeof val, sizeof val);
+    return val;
+}
+
+bool EventRecordColumn::booleanValue(const Index index) const noexcept
+{
+    assert(index < _size);
+    return _vals[index] != 0;
+}
+
+std::string EventRecordColumn::stringValue(const Index index) const
+{
+    assert(index < _size);
+
+    const auto begin = reinterpret_cast<const char *>(_vals.data());
+
+    return std::string {begin + _offsets[index], begin + _offsets[index + 1]};
+}
+
+template <typename ValT>
+void EventRecordColumn::_appendFixedWidthVal(const ValT val)
+{
+    assert(sizeof val == fixedWidthValSize(_type));
+
+    const auto offset = _vals.size();
+
+    _vals.resize(offset + sizeof val);
+    std::memcpy(_vals.data() + offset, &val, sizeof val);
+    this->_appendValidity(true);
+}
+
+void EventRecordColumn::_appendValidity(const bool isValid)
+{
+    if (_size % 8 == 0) {
+        _validityBitmap.push_back(0);
+    }
+
+    if (isValid) {
+        _validityBitmap.back() |= 1U << (_size % 8);
+    } else {
+        ++_nullCount;
+    }
+
+    ++_size;
+}
+
+void EventRecordColumn::_appendNull()
+{
+    if (isVarWidthColType(_type)) {
+        // drop any partial data
+        _vals.resize(_offsets.back());
+        _offsets.push_back(_offsets.back());
+    } else {
+        _vals.resize(_vals.size() + fixedWidthValSize(_type), 0);
+    }
+
+    this->_appendValidity(false);
+}
+
+void EventRecordColumn::_appendStrData(const std::uint8_t * const begin,
+                                       const std::uint8_t * const end)
+{
+    assert(isVarWidthColType(_type));
+    _vals.insert(_vals.end(), begin, end);
+}
+
+void EventRecordColumn::_endStrVal(const Size codeUnitSize)
+{
+    assert(isVarWidthColType(_type));
+
+    auto endOffset = _vals.size();
+
+    if (codeUnitSize > 0) {
+        // find the first null code unit, if any
+        for (auto offset = static_cast<Size>(_offsets.back());
+                offset + codeUnitSize <= _vals.size(); offset += codeUnitSize) {
+            const auto codeUnitBegin = _vals.begin() + offset;
+
+            if (std::all_of(codeUnitBegin, codeUnitBegin + codeUnitSize,
+                            [](const std::uint8_t byte) {
+                return byte == 0;
+            })) {
+                endOffset = offset;
+                break;
+            }
+        }
+    }
+
+    _vals.resize(endOffset);
+    _offsets.push_back(static_cast<std::int64_t>(endOffset));
+    this->_appendValidity(true);
+}
+
+void EventRecordColumn::_clear() noexcept
+{
+    _size = 0;
+    _nullCount = 0;
+    _validityBitmap.clear();
+    _vals.clear();
+
+    if (isVarWidthColType(_type)) {
+        _offsets.resize(1);
+    }
+}
+
+void EventRecordColumn::_truncate(const Size size)
+{
+    if (size >= _size) {
+        if (isVarWidthColType(_type)) {
+            // drop any partial data
+            _vals.resize(_offsets.back());
+        }
+
+        return;
+    }
+
+    for (auto index = size; index < _size; ++index) {
+        if (this->isNull(index)) {
+            --_nullCount;
+        }
+    }
+
+    if (isVarWidthColType(_type)) {
+        _offsets.resize(size + 1);
+        _vals.resize(_offsets.back());
+    } else {
+        _vals.resize(size * fixedWidthValSize(_type));
+    }
+
+    _validityBitmap.resize((size + 7) / 8);
+
+    if (size % 8 != 0) {
+        _validityBitmap.back() &= (1U << (size % 8)) - 1;
+    }
+
+    _size = size;
+}
+
+EventRecordTable::EventRecordTable(const EventRecordType& ert) :
+    _ert {&ert}
+{
+    this->_addCol("timestamp", EventRecordColumn::Type::Timestamp, nullptr);
+
+    if (ert.specificContextType()) {
+        this->_addCols(*ert.specificContextType(), "specific-context");
+    }
+
+    if (ert.payloadType()) {
+        this->_addCols(*ert.payloadType(), "payload");
+    }
+}
+
+const EventRecordColumn *EventRecordTable::operator[](const std::string& name) const noexcept
+{
+    const auto it = std::find_if(_cols.begin(), _cols.end(), [&name](const auto& col) {
+        return col.name() == name;
+    });
+
+    return it == _cols.end() ? nullptr : &*it;
+}
+
+void EventRecordTable::_addCols(const DataType& dt, const std::string& name)
+{
+    using Type = EventRecordColumn::Type;
+
+    const auto addOptCols = [this, &name](const auto& varType) {
+        Index index = 0;
+
+        for (const auto& opt : varType.options()) {
+            const auto& optName = opt->displayName();
+
+            this->_addCols(opt->dataType(),
+                           name + '.' + (optName ? *optName : std::to_string(index)));
+            ++index;
+        }
+    };
+
+    if (dt.isStructureType()) {
+        for (const auto& memberType : dt.asStructureType()) {
+            const auto& memberName = memberType->displayName();
+
+            this->_addCols(memberType->dataType(),
+                           name + '.' + (memberName ? *memberName : memberType->name()));
+        }
+    } else if (dt.isVariantWithUnsignedIntegerSelectorType()) {
+        addOptCols(dt.asVariantWithUnsignedIntegerSelectorType());
+    } else if (dt.isVariantWithSignedIntegerSelectorType()) {
+        addOptCols(dt.asVariantWithSignedIntegerSelectorType());
+    } else if (dt.isOptionalType()) {
+        this->_addCols(dt.asOptionalType().dataType(), name);
+    } else if (dt.isFixedLengthBooleanType()) {
+        this->_addCol(name, Type::Boolean, &dt);
+    } else if (dt.isSignedIntegerType()) {
+        this->_addCol(name, Type::SignedInteger, &dt);
+    } else if (dt.isUnsignedIntegerType()) {
+        this->_addCol(name, Type::UnsignedInteger, &dt);
+    } else if (dt.isFixedLengthFloatingPointNumberType()) {
+        this->_addCol(name, Type::FloatingPointNumber, &dt);
+    } else if (dt.isFixedLengthBitArrayType()) {
+        // including bit map
+        this->_addCol(name, Type::UnsignedInteger, &dt);
+    } else if (dt.isStringType()) {
+        this->_addCol(name, Type::String, &dt);
+    } else if (dt.isBlobType()) {
+        this->_addCol(name, Type::Blob, &dt);
+    }
+
+    // no columns for arrays
+}
+
+void EventRecordTable::_addCol(std::string name, const EventRecordColumn::Type type,
+                               const DataType * const dt)
+{
+    if (dt) {
+        _colIndexes.insert(std::make_pair(dt, _cols.size()));
+    }
+
+    _cols.push_back(EventRecordColumn {std::move(name), type, dt});
+}
+
+void EventRecordTable::_finishRow()
+{
+    // fields which aren't part of this event record
+    for (auto& col : _cols) {
+        if (col._size == _rowCount) {
+            col._appendNull();
+        }
+    }
+
+    ++_rowCount;
+}
+
+void EventRecordTable::_abortRow()
+{
+    for (auto& col : _cols) {
+        col._truncate(_rowCount);
+    }
+}
+
+void EventRecordTable::_clear() noexcept
+{
+    for (auto& col : _cols) {
+        col._clear();
+    }
+
+    _rowCount = 0;
+}
+
+EventRecordColumnarExporter::EventRecordColumnarExporter(ElementSequence& seq,
+                                                         const std::vector<const EventRecordType *>& eventRecordTypes) :
+    _seq {&seq},
+    _endIt {seq.end()}
+{
+    for (const auto ert : eventRecordTypes) {
+        assert(ert);
+
+        if (_tableIndexes.find(ert) != _tableIndexes.end()) {
+            continue;
+        }
+
+        _tableIndexes.insert(std::make_pair(ert, _tables.size()));
+        _tables.push_back(EventRecordTable {*ert});
+    }
+}
+
+Size EventRecordColumnarExporter::exportBatch(const Size maxEventRecordCount)
+{
+    _batchRowCount = 0;
+
+    if (!_it) {
+        _it = _seq->begin();
+        _elemIsHandled = false;
+    }
+
+    try {
+        while (_batchRowCount < maxEventRecordCount && *_it != _endIt) {
+            if (_elemIsHandled) {
+                ++*_it;
+                _elemIsHandled = false;
+                continue;
+            }
+
+            yactfr::visit(**_it, [this](const auto& elem) {
+                this->_handleElem(elem);
+            });
+
+            _elemIsHandled = true;
+        }
+    } catch (const DecodingError&) {
+        this->_abortRow();
+        throw;
+    }
+
+    return _batchRowCount;
+}
+
+const EventRecordTable *EventRecordColumnarExporter::table(const EventRecordType& eventRecordType) const noexcept
+{
+    const auto it = _tableIndexes.find(&eventRecordType);
+
+    return it == _tableIndexes.end() ? nullptr : &_tables[it->second];
+}
+
+void EventRecordColumnarExporter::clear() noexcept
+{
+    // drop any partial event record
+    _curTable = nullptr;
+    _curStrCol = nullptr;
+
+    for (auto& table : _tables) {
+        table._clear();
+    }
+}
+
+void EventRecordColumnarExporter::_abortRow()
+{
+    if (_curTable) {
+        _curTable->_abortRow();
+    }
+
+    _curTable = nullptr;
+    _curStrCol = nullptr;
+}
+
+EventRecordColumn *EventRecordColumnarExporter::_col(const DataElement& elem) noexcept
+{
+    if (!_curTable) {
+        return nullptr;
+    }
+
+    const auto it = _curTable->_colIndexes.find(&elem.dataType());
+
+    return it == _curTable->_colIndexes.end() ? nullptr : &_curTable->_cols[it->second];
+}
+
+void EventRecordColumnarExporter::_handleElem(const Element&)
+{
+}
+
+void EventRecordColumnarExporter::_handleElem(const EventRecordBeginningElement&)
+{
+    _curTable = nullptr;
+    _curTs = boost::none;
+    _curStrCol = nullptr;
+}
+
+void EventRecordColumnarExporter::_handleElem(const DefaultClockValueElement& elem)
+{
+    _curTs = elem.cycles();
+}
+
+void EventRecordColumnarExporter::_handleElem(const EventRecordInfoElement& elem)
+{
+    if (!elem.type()) {
+        return;
+    }
+
+    const auto it = _tableIndexes.find(elem.type());
+
+    if (it != _tableIndexes.end()) {
+        _curTable = &_tables[it->second];
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const EventRecordEndElement&)
+{
+    if (!_curTable) {
+        return;
+    }
+
+    if (_curTs) {
+        _curTable->_cols.front()._appendFixedWidthVal(static_cast<std::uint64_t>(*_curTs));
+    }
+
+    _curTable->_finishRow();
+    _curTable = nullptr;
+    ++_batchRowCount;
+}
+
+void EventRecordColumnarExporter::_handleElem(const FixedLengthBitArrayElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<std::uint64_t>(elem.unsignedIntegerValue()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const FixedLengthBooleanElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<std::uint8_t>(elem.value()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const FixedLengthSignedIntegerElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<std::int64_t>(elem.value()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const FixedLengthUnsignedIntegerElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<std::uint64_t>(elem.value()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const FixedLengthFloatingPointNumberElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<double>(elem.value()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const VariableLengthSignedIntegerElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<std::int64_t>(elem.value()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const VariableLengthUnsignedIntegerElement& elem)
+{
+    if (const auto col = this->_col(elem)) {
+        col->_appendFixedWidthVal(static_cast<std::uint64_t>(elem.value()));
+    }
+}
+
+void EventRecordColumnarExporter::_handleElem(const NullTerminatedStringBeginningElement& elem)
+{
+    this->_beginStrVal(elem, strCodeUnitSize(elem.type().encoding()));
+}
+
+void EventRecordColumnarExporter::_handleElem(const NullTerminatedStringEndElement&)
+{
+    this->_endStrVal();
+}
+
+void EventRecordColumnarExporter::_handleElem(const NonNullTerminatedStringBeginningElement& elem)
+{
+    this->_beginStrVal(elem, strCodeUnitSize(elem.type().encoding()));
+}
+
+void EventRecordColumnarExporter::_handleElem(const NonNullTerminatedStringEndElement&)
+{
+    this->_endStrVal();
+}
+
+void EventRecordColumnarExporter::_handleElem(const BlobBeginningElement& elem)
+{
+    // no null code unit in a BLOB
+    this->_beginStrVal(elem, 0);
+}
+
+void EventRecordColumnarExporter::_handleElem(const BlobEndElement&)
+{
+    this->_endStrVal();
+}
+
+void EventRecordColumnarExporter::_handleElem(const RawDataElement& elem)
+{
+    if (_curStrCol) {
+        _curStrCol->_appendStrData(elem.begin(), elem.end());
+    }
+}
+
+void EventRecordColumnarExporter::_beginStrVal(const DataElement& elem, const Size codeUnitSize)
+{
+    _curStrCol = this->_col(elem);
+    _curStrCodeUnitSize = codeUnitSize;
+}
+
+void EventRecordColumnarExporter::_endStrVal()
+{
+    if (_curStrCol) {
+        _curStrCol->_endStrVal(_curStrCodeUnitSize);
+        _curStrCol = nullptr;
+    }
+}
+
+} // namespace yactfr
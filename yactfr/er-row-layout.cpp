@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <yactfr/er-row-layout.hpp>
+
+namespace yactfr {
+
+EventRecordRowLayout::Field::Field(const FixedLengthBitArrayType& type, const Index offset,
+                                   const Size size, const unsigned int dsAlign) noexcept :
+    _type {&type},
+    _offset {offset},
+    _size {size},
+    _dsAlign {dsAlign}
+{
+}
+
+EventRecordRowLayout::EventRecordRowLayout(const EventRecordType& ert) noexcept :
+    _ert {&ert}
+{
+}
+
+} // namespace yactfr
@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <yactfr/field-handle.hpp>
+
+#include <utility>
+
+namespace yactfr {
+
+FieldHandle::FieldHandle(const Index index, DataLocation location, DataTypeSet dataTypes) :
+    _index {index},
+    _loc {std::move(location)},
+    _dts {std::move(dataTypes)}
+{
+}
+
+} // namespace yactfr
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_INLINE_VEC_HPP
+#define YACTFR_INTERNAL_INLINE_VEC_HPP
+
+#include <cassert>
+#include <algorithm>
+#include <memory>
+
+#include <yactfr/aliases.hpp>
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * Vector of which the capacity is meant to only change with reserve()
+ * and resize().
+ *
+ * The first `InlineCapV` elements are part of the vector object itself:
+ * an `InlineVec` object having a capacity of at most `InlineCapV`
+ * elements doesn't allocate any heap memory, even when copying it.
+ *
+ * Copying an `InlineVec` object to another one having an enough
+ * capacity doesn't allocate either.
+ *
+ * `T` must be default-constructible and copyable.
+ */
+template <typename T, Size InlineCapV>
+class InlineVec final
+{
+public:
+    using iterator = T *;
+    using const_iterator = const T *;
+
+public:
+    explicit InlineVec() = default;
+
+    InlineVec(const InlineVec& other)
+    {
+        *this = other;
+    }
+
+    InlineVec& operator=(const InlineVec& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        this->reserve(other._cap);
+        std::copy(other.begin(), other.end(), _elems);
+        _size = other._size;
+        return *this;
+    }
+
+    /*
+     * Makes sure this vector may contain `cap` elements without
+     * allocating.
+     */
+    void reserve(const Size cap)
+    {
+        if (cap <= _cap) {
+            return;
+        }
+
+        auto heapElems = std::make_unique<T[]>(cap);
+
+        std::copy(this->begin(), this->end(), heapElems.get());
+        _heapElems = std::move(heapElems);
+        _elems = _heapElems.get();
+        _cap = cap;
+    }
+
+    /*
+     * Sets the size of this vector to `size`, setting any new element
+     * to `val`.
+     */
+    void resize(const Size size, const T& val)
+    {
+        this->reserve(size);
+
+        if (size > _size) {
+            std::fill(_elems + _size, _elems + size, val);
+        }
+
+        _size = size;
+    }
+
+    /*
+     * Appends `elem`.
+     *
+     * Reserve enough capacity beforehand: this method only allocates
+     * when this vector is full, as a safety net, instead of writing
+     * past its elements.
+     */
+    void push_back(const T& elem)
+    {
+        if (_size == _cap) {
+            this->_grow();
+        }
+
+        _elems[_size] = elem;
+        ++_size;
+    }
+
+    void pop_back() noexcept
+    {
+        assert(_size > 0);
+        --_size;
+    }
+
+    void clear() noexcept
+    {
+        _size = 0;
+    }
+
+    T& back() noexcept
+    {
+        assert(_size > 0);
+        return _elems[_size - 1];
+    }
+
+    const T& back() const noexcept
+    {
+        assert(_size > 0);
+        return _elems[_size - 1];
+    }
+
+    T& operator[](const Index index) noexcept
+    {
+        assert(index < _size);
+        return _elems[index];
+    }
+
+    const T& operator[](const Index index) const noexcept
+    {
+        assert(index < _size);
+        return _elems[index];
+    }
+
+    Size size() const noexcept
+    {
+        return _size;
+    }
+
+    Size capacity() const noexcept
+    {
+        return _cap;
+    }
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    iterator begin() noexcept
+    {
+        return _elems;
+    }
+
+    iterator end() noexcept
+    {
+        return _elems + _size;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return _elems;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _elems + _size;
+    }
+
+private:
+    /*
+     * Doubles the capacity of this vector.
+     */
+    void _grow()
+    {
+        this->reserve(_cap * 2);
+    }
+
+private:
+    // current elements: `_inlineElems` or `_heapElems.get()`
+    T *_elems = _inlineElems;
+    Size _size = 0;
+    Size _cap = InlineCapV;
+    T _inlineElems[InlineCapV];
+    std::unique_ptr<T[]> _heapElems;
+};
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_INLINE_VEC_HPP
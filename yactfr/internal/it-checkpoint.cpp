@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <sstream>
+
+#include "it-checkpoint.hpp"
+
+namespace yactfr {
+namespace internal {
+namespace {
+
+/*
+ * Flags of the checkpoint data.
+ */
+constexpr unsigned int flagPktEnd = 1 << 0;
+constexpr unsigned int flagErBeginning = 1 << 1;
+
+/*
+ * Last fixed-length bit array byte order (two bits after the flags
+ * above).
+ */
+constexpr unsigned int boShift = 2;
+constexpr unsigned int boNone = 0;
+constexpr unsigned int boBig = 1;
+constexpr unsigned int boLittle = 2;
+
+/*
+ * Writes unsigned integers (LEB128) to a checkpoint data buffer.
+ */
+class Writer final
+{
+public:
+    explicit Writer(ElementSequenceIteratorCheckpoint::Data& data) :
+        _data {&data}
+    {
+        _data->clear();
+    }
+
+    void writeUInt(unsigned long long val)
+    {
+        do {
+            auto byte = static_cast<std::uint8_t>(val & 0x7f);
+
+            val >>= 7;
+
+            if (val != 0) {
+                byte |= 0x80;
+            }
+
+            _data->push_back(byte);
+        } while (val != 0);
+    }
+
+    /*
+     * Writes 0 if `val` is not set, or its value plus one otherwise.
+     */
+    template <typename ValT>
+    void writeOptUInt(const boost::optional<ValT>& val)
+    {
+        this->writeUInt(val ? static_cast<unsigned long long>(*val) + 1 : 0);
+    }
+
+private:
+    ElementSequenceIteratorCheckpoint::Data *_data;
+};
+
+/*
+ * Reads what `Writer` writes.
+ */
+class Reader final
+{
+public:
+    explicit Reader(const ElementSequenceIteratorCheckpoint::Data& data) :
+        _at {data.data()},
+        _end {data.data() + data.size()}
+    {
+    }
+
+    unsigned long long readUInt()
+    {
+        unsigned long long val = 0;
+
+        for (unsigned int shift = 0; shift < 64; shift += 7) {
+            if (_at == _end) {
+                throw InvalidElementSequenceIteratorCheckpoint {"Unexpected end of data."};
+            }
+
+            const auto byte = *_at;
+
+            ++_at;
+            val |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+
+            if (!(byte & 0x80)) {
+                return val;
+            }
+        }
+
+        throw InvalidElementSequenceIteratorCheckpoint {"Invalid unsigned integer."};
+    }
+
+    template <typename ValT>
+    boost::optional<ValT> readOptUInt()
+    {
+        const auto val = this->readUInt();
+
+        if (val == 0) {
+            return boost::none;
+        }
+
+        return static_cast<ValT>(val - 1);
+    }
+
+    /*
+     * Reads a count, making sure it's not greater than the number of
+     * remaining bytes (each item takes at least one byte) so that a
+     * corrupted count can't make this reader reserve too much memory.
+     */
+    Size readCount()
+    {
+        const auto count = this->readUInt();
+
+        if (count > static_cast<unsigned long long>(_end - _at)) {
+            throw InvalidElementSequenceIteratorCheckpoint {"Invalid count."};
+        }
+
+        return static_cast<Size>(count);
+    }
+
+    bool isAtEnd() const noexcept
+    {
+        return _at == _end;
+    }
+
+private:
+    const std::uint8_t *_at;
+    const std::uint8_t *_end;
+};
+
+} // namespace
+
+void itCheckpointToData(const ItCheckpointContents& contents,
+                        ElementSequenceIteratorCheckpoint::Data& data)
+{
+    Writer writer {data};
+    unsigned int flags = 0;
+
+    if (contents.isPktEnd) {
+        flags |= flagPktEnd;
+    }
+
+    if (contents.erBeginning) {
+        flags |= flagErBeginning;
+
+        if (contents.erBeginning->lastFlBitArrayBo) {
+            flags |= (*contents.erBeginning->lastFlBitArrayBo == ByteOrder::Big ? boBig :
+                      boLittle) << boShift;
+        } else {
+            flags |= boNone << boShift;
+        }
+    }
+
+    writer.writeUInt(itCheckpointFormatVersion);
+    writer.writeUInt(contents.pktOffsetBytes);
+    writer.writeUInt(contents.elemOffsetInPktBits);
+    writer.writeUInt(contents.mark);
+    writer.writeUInt(flags);
+
+    if (!contents.erBeginning) {
+        return;
+    }
+
+    const auto& erBeginning = *contents.erBeginning;
+
+    writer.writeUInt(erBeginning.dstId);
+    writer.writeUInt(erBeginning.headOffsetInPktBits);
+    writer.writeUInt(erBeginning.mark);
+    writer.writeOptUInt(erBeginning.expectedPktTotalLenBits);
+    writer.writeOptUInt(erBeginning.expectedPktContentLenBits);
+    writer.writeUInt(erBeginning.defClkVal);
+    writer.writeUInt(erBeginning.savedVals.size());
+
+    for (const auto& savedVal : erBeginning.savedVals) {
+        writer.writeOptUInt(savedVal);
+    }
+}
+
+ItCheckpointContents itCheckpointFromData(const ElementSequenceIteratorCheckpoint::Data& data)
+{
+    Reader reader {data};
+    const auto version = reader.readUInt();
+
+    if (version != itCheckpointFormatVersion) {
+        std::ostringstream ss;
+
+        ss << "Unexpected format version " << version << " (expecting " <<
+              itCheckpointFormatVersion << ").";
+        throw InvalidElementSequenceIteratorCheckpoint {ss.str()};
+    }
+
+    ItCheckpointContents contents;
+
+    contents.pktOffsetBytes = reader.readUInt();
+    contents.elemOffsetInPktBits = reader.readUInt();
+    contents.mark = reader.readUInt();
+
+    const auto flags = reader.readUInt();
+
+    if (flags >> (boShift + 2) != 0) {
+        throw InvalidElementSequenceIteratorCheckpoint {"Invalid flags."};
+    }
+
+    contents.isPktEnd = flags & flagPktEnd;
+
+    if (contents.mark == 0) {
+        throw InvalidElementSequenceIteratorCheckpoint {"Invalid element mark."};
+    }
+
+    if (flags & flagErBeginning) {
+        ItCheckpointContents::ErBeginning erBeginning;
+
+        switch ((flags >> boShift) & 3) {
+        case boNone:
+            break;
+
+        case boBig:
+            erBeginning.lastFlBitArrayBo = ByteOrder::Big;
+            break;
+
+        case boLittle:
+            erBeginning.lastFlBitArrayBo = ByteOrder::Little;
+            break;
+
+        default:
+            throw InvalidElementSequenceIteratorCheckpoint {"Invalid byte order."};
+        }
+
+        erBeginning.dstId = reader.readUInt();
+        erBeginning.headOffsetInPktBits = reader.readUInt();
+        erBeginning.mark = reader.readUInt();
+        erBeginning.expectedPktTotalLenBits = reader.readOptUInt<Size>();
+        erBeginning.expectedPktContentLenBits = reader.readOptUInt<Size>();
+        erBeginning.defClkVal = reader.readUInt();
+
+        if (erBeginning.mark >= contents.mark ||
+                erBeginning.headOffsetInPktBits > contents.elemOffsetInPktBits) {
+            throw InvalidElementSequenceIteratorCheckpoint {
+                "Event record beginning is after the element."
+            };
+        }
+
+        erBeginning.savedVals.resize(reader.readCount());
+
+        for (auto& savedVal : erBeginning.savedVals) {
+            savedVal = reader.readOptUInt<std::uint64_t>();
+        }
+
+        contents.erBeginning = std::move(erBeginning);
+    } else if ((flags >> boShift) != 0) {
+        throw InvalidElementSequenceIteratorCheckpoint {"Invalid flags."};
+    }
+
+    if (contents.isPktEnd && (contents.erBeginning || contents.elemOffsetInPktBits != 0)) {
+        throw InvalidElementSequenceIteratorCheckpoint {"Invalid packet end."};
+    }
+
+    if (!reader.isAtEnd()) {
+        throw InvalidElementSequenceIteratorCheckpoint {"Unexpected data after checkpoint."};
+    }
+
+    return contents;
+}
+
+} // namespace internal
+} // namespace yactfr
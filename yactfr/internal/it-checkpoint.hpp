@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_IT_CHECKPOINT_HPP
+#define YACTFR_INTERNAL_IT_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <vector>
+#include <boost/optional.hpp>
+
+#include <yactfr/aliases.hpp>
+#include <yactfr/metadata/aliases.hpp>
+#include <yactfr/metadata/bo.hpp>
+#include <yactfr/elem-seq-it-checkpoint.hpp>
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * Version of the element sequence iterator checkpoint format.
+ *
+ * Increment this whenever the format which itCheckpointToData() writes
+ * changes so that itCheckpointFromData() rejects checkpoint data which
+ * an older/newer version of yactfr wrote.
+ */
+constexpr unsigned int itCheckpointFormatVersion = 1;
+
+/*
+ * Decoded contents of an element sequence iterator checkpoint.
+ */
+struct ItCheckpointContents final
+{
+    // state at the beginning of the last event record of the packet
+    struct ErBeginning final
+    {
+        TypeId dstId = 0;
+        Index headOffsetInPktBits = 0;
+        Index mark = 0;
+        boost::optional<Size> expectedPktTotalLenBits;
+        boost::optional<Size> expectedPktContentLenBits;
+        std::uint64_t defClkVal = 0;
+        boost::optional<ByteOrder> lastFlBitArrayBo;
+        std::vector<boost::optional<std::uint64_t>> savedVals;
+    };
+
+    // offset of the packet of the element within its element sequence
+    Index pktOffsetBytes = 0;
+
+    // offset of the element within its packet (bits)
+    Index elemOffsetInPktBits = 0;
+
+    // mark of the element within its packet
+    Index mark = 0;
+
+    // whether or not the element is the end of its packet
+    bool isPktEnd = false;
+
+    // event record beginning from which to decode again, if any
+    boost::optional<ErBeginning> erBeginning;
+};
+
+/*
+ * Writes the data of an element sequence iterator checkpoint having
+ * the contents `contents` to `data`, replacing its contents.
+ */
+void itCheckpointToData(const ItCheckpointContents& contents,
+                        ElementSequenceIteratorCheckpoint::Data& data);
+
+/*
+ * Returns the contents of the element sequence iterator checkpoint
+ * data `data`.
+ *
+ * Throws `InvalidElementSequenceIteratorCheckpoint` if `data` is
+ * invalid or has an unexpected format version.
+ */
+ItCheckpointContents itCheckpointFromData(const ElementSequenceIteratorCheckpoint::Data& data);
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_IT_CHECKPOINT_HPP
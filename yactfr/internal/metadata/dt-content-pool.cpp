@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+
+#include <yactfr/internal/metadata/dt-content.hpp>
+
+#include "dt-content-pool.hpp"
+
+namespace yactfr {
+namespace internal {
+
+std::size_t itemHash(const Item& item) noexcept
+{
+    std::size_t hash = 0;
+
+    boost::hash_combine(hash, static_cast<int>(item.kind()));
+
+    switch (item.kind()) {
+    case ItemKind::Boolean:
+        boost::hash_combine(hash, item.asBoolean().value());
+        break;
+
+    case ItemKind::SignedInteger:
+        boost::hash_combine(hash, item.asSignedInteger().value());
+        break;
+
+    case ItemKind::UnsignedInteger:
+        boost::hash_combine(hash, item.asUnsignedInteger().value());
+        break;
+
+    case ItemKind::Real:
+        boost::hash_combine(hash, item.asReal().value());
+        break;
+
+    case ItemKind::String:
+        boost::hash_combine(hash, item.asString().value());
+        break;
+
+    case ItemKind::Array:
+        for (const auto& elemItem : item.asArray()) {
+            boost::hash_combine(hash, elemItem ? itemHash(*elemItem) : 0);
+        }
+
+        break;
+
+    case ItemKind::Map:
+        for (const auto& keyItemPair : item.asMap()) {
+            boost::hash_combine(hash, keyItemPair.first);
+            boost::hash_combine(hash, keyItemPair.second ? itemHash(*keyItemPair.second) : 0);
+        }
+
+        break;
+
+    default:
+        std::abort();
+    }
+
+    return hash;
+}
+
+DtContentPool& DtContentPool::instance()
+{
+    static DtContentPool pool;
+
+    return pool;
+}
+
+std::shared_ptr<const MapItem> DtContentPool::intern(MapItem::Up attrs)
+{
+    if (!attrs) {
+        return nullptr;
+    }
+
+    const auto hash = itemHash(*attrs);
+    const std::lock_guard<std::mutex> lock {_mutex};
+
+    return _attrs.intern(std::move(attrs), hash);
+}
+
+std::shared_ptr<const MapItem> internAttrs(MapItem::Up attrs)
+{
+    return DtContentPool::instance().intern(std::move(attrs));
+}
+
+std::shared_ptr<const std::map<std::string, IntegerRangeSet<long long>>>
+internIntTypeMappings(std::map<std::string, IntegerRangeSet<long long>>&& mappings)
+{
+    return DtContentPool::instance().intern(std::move(mappings));
+}
+
+std::shared_ptr<const std::map<std::string, IntegerRangeSet<unsigned long long>>>
+internIntTypeMappings(std::map<std::string, IntegerRangeSet<unsigned long long>>&& mappings)
+{
+    return DtContentPool::instance().intern(std::move(mappings));
+}
+
+IntegerRangeSet<long long> internIntRangeSet(const IntegerRangeSet<long long>& rangeSet)
+{
+    return DtContentPool::instance().intern(rangeSet);
+}
+
+IntegerRangeSet<unsigned long long>
+internIntRangeSet(const IntegerRangeSet<unsigned long long>& rangeSet)
+{
+    return DtContentPool::instance().intern(rangeSet);
+}
+
+} // namespace internal
+} // namespace yactfr
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_METADATA_DT_CONTENT_POOL_HPP
+#define YACTFR_INTERNAL_METADATA_DT_CONTENT_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <yactfr/metadata/item.hpp>
+#include <yactfr/metadata/int-range-set.hpp>
+#include <yactfr/metadata/int-type-common.hpp>
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * Returns the hash of the item `item`.
+ */
+std::size_t itemHash(const Item& item) noexcept;
+
+/*
+ * Returns the hash of the integer range set `rangeSet`.
+ */
+template <typename ValueT>
+std::size_t intRangeSetHash(const IntegerRangeSet<ValueT>& rangeSet) noexcept
+{
+    std::size_t hash = 0;
+
+    for (const auto& range : rangeSet) {
+        boost::hash_combine(hash, range.lower());
+        boost::hash_combine(hash, range.upper());
+    }
+
+    return hash;
+}
+
+/*
+ * Returns the hash of the integer type mappings `mappings`.
+ */
+template <typename ValueT>
+std::size_t intTypeMappingsHash(const std::map<std::string, IntegerRangeSet<ValueT>>& mappings)
+    noexcept
+{
+    std::size_t hash = 0;
+
+    for (const auto& nameRangeSetPair : mappings) {
+        boost::hash_combine(hash, nameRangeSetPair.first);
+        boost::hash_combine(hash, intRangeSetHash(nameRangeSetPair.second));
+    }
+
+    return hash;
+}
+
+/*
+ * Process-wide pool of data type content.
+ *
+ * The data type content pool interns the immutable content of data
+ * types (attributes, integer type mappings, and selector integer range
+ * sets) which their constructors receive: intern() returns an equal
+ * content which some live data type already uses, if any, so that
+ * equal contents share the same memory.
+ *
+ * The data types (the nodes) remain distinct objects.
+ *
+ * The pool only keeps weak references: an interned content lives as
+ * long as its last data type. intern() forgets the expired contents
+ * having the same hash, and sweeps all of them when the number of
+ * entries doubles.
+ *
+ * All the methods are thread-safe.
+ */
+class DtContentPool final :
+    boost::noncopyable
+{
+public:
+    /*
+     * Returns the single data type content pool.
+     */
+    static DtContentPool& instance();
+
+    /*
+     * Returns attributes equal to `attrs`, or `nullptr` if `attrs` is
+     * `nullptr`.
+     */
+    std::shared_ptr<const MapItem> intern(MapItem::Up attrs);
+
+    /*
+     * Returns integer type mappings equal to `mappings`.
+     */
+    std::shared_ptr<const IntegerTypeCommon<long long>::Mappings>
+    intern(IntegerTypeCommon<long long>::Mappings&& mappings)
+    {
+        return this->_internIntTypeMappings<long long>(_sIntTypeMappings, std::move(mappings));
+    }
+
+    std::shared_ptr<const IntegerTypeCommon<unsigned long long>::Mappings>
+    intern(IntegerTypeCommon<unsigned long long>::Mappings&& mappings)
+    {
+        return this->_internIntTypeMappings<unsigned long long>(_uIntTypeMappings,
+                                                                std::move(mappings));
+    }
+
+    /*
+     * Returns an integer range set equal to `rangeSet`.
+     */
+    IntegerRangeSet<long long> intern(const IntegerRangeSet<long long>& rangeSet)
+    {
+        return this->_internIntRangeSet(_sIntRangeSets, rangeSet);
+    }
+
+    IntegerRangeSet<unsigned long long> intern(const IntegerRangeSet<unsigned long long>& rangeSet)
+    {
+        return this->_internIntRangeSet(_uIntRangeSets, rangeSet);
+    }
+
+private:
+    /*
+     * Set of weak references to contents of type `ObjT`.
+     */
+    template <typename ObjT>
+    class _tWeakSet final
+    {
+    public:
+        /*
+         * Returns the content equal to `obj` (having the hash `hash`)
+         * which this set knows, adding `obj` if there's none.
+         */
+        std::shared_ptr<const ObjT> intern(std::shared_ptr<const ObjT> obj, const std::size_t hash)
+        {
+            const auto range = _entries.equal_range(hash);
+
+            for (auto it = range.first; it != range.second;) {
+                auto existingObj = it->second.lock();
+
+                if (!existingObj) {
+                    it = _entries.erase(it);
+                    continue;
+                }
+
+                if (*existingObj == *obj) {
+                    return existingObj;
+                }
+
+                ++it;
+            }
+
+            _entries.emplace(hash, obj);
+
+            if (_entries.size() >= _sweepSize) {
+                this->_sweep();
+            }
+
+            return obj;
+        }
+
+    private:
+        void _sweep()
+        {
+            for (auto it = _entries.begin(); it != _entries.end();) {
+                if (it->second.expired()) {
+                    it = _entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            _sweepSize = std::max(_sweepSize, _entries.size() * 2);
+        }
+
+    private:
+        std::unordered_multimap<std::size_t, std::weak_ptr<const ObjT>> _entries;
+
+        // entry count which triggers the next sweep
+        std::size_t _sweepSize = 1024;
+    };
+
+    template <typename ValueT>
+    using _tIntTypeMappingsSet = _tWeakSet<typename IntegerTypeCommon<ValueT>::Mappings>;
+
+    template <typename ValueT>
+    using _tIntRangeSetSet = _tWeakSet<std::set<typename IntegerRangeSet<ValueT>::Range>>;
+
+private:
+    explicit DtContentPool() = default;
+
+    template <typename ValueT>
+    std::shared_ptr<const typename IntegerTypeCommon<ValueT>::Mappings>
+    _internIntTypeMappings(_tIntTypeMappingsSet<ValueT>& set,
+                           typename IntegerTypeCommon<ValueT>::Mappings&& mappings)
+    {
+        using Mappings = typename IntegerTypeCommon<ValueT>::Mappings;
+
+        const auto hash = intTypeMappingsHash(mappings);
+        auto obj = std::make_shared<const Mappings>(std::move(mappings));
+        const std::lock_guard<std::mutex> lock {_mutex};
+
+        return set.intern(std::move(obj), hash);
+    }
+
+    template <typename ValueT>
+    IntegerRangeSet<ValueT> _internIntRangeSet(_tIntRangeSetSet<ValueT>& set,
+                                               const IntegerRangeSet<ValueT>& rangeSet)
+    {
+        const auto hash = intRangeSetHash(rangeSet);
+        const std::lock_guard<std::mutex> lock {_mutex};
+
+        return IntegerRangeSet<ValueT> {set.intern(rangeSet._ranges, hash)};
+    }
+
+private:
+    std::mutex _mutex;
+    _tWeakSet<MapItem> _attrs;
+    _tIntTypeMappingsSet<long long> _sIntTypeMappings;
+    _tIntTypeMappingsSet<unsigned long long> _uIntTypeMappings;
+    _tIntRangeSetSet<long long> _sIntRangeSets;
+    _tIntRangeSetSet<unsigned long long> _uIntRangeSets;
+};
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_METADATA_DT_CONTENT_POOL_HPP
@@ -0,0 +1,4464 @@
+/*
+ * Copyright (C) 2022-2023 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <yactfr/metadata/fl-bit-array-type.hpp>
+#include <yactfr/metadata/fl-bit-map-type.hpp>
+#include <yactfr/metadata/fl-bool-type.hpp>
+#include <yactfr/metadata/fl-int-type.hpp>
+#include <yactfr/metadata/fl-float-type.hpp>
+#include <yactfr/metadata/vl-int-type.hpp>
+#include <yactfr/metadata/nt-str-type.hpp>
+#include <yactfr/metadata/sl-str-type.hpp>
+#include <yactfr/metadata/sl-blob-type.hpp>
+#include <yactfr/metadata/clk-orig.hpp>
+#include <yactfr/metadata/clk-offset.hpp>
+#include <yactfr/text-parse-error.hpp>
+
+#include "ctf-2-json-frag-parser.hpp"
+#include "ctf-2-json-strs.hpp"
+#include "json-parser.hpp"
+#include "../../utils.hpp"
+
+namespace yactfr {
+namespace internal {
+namespace {
+
+/*
+ * Kind of a JSON value.
+ */
+enum class JsonValKind
+{
+    Null,
+    Bool,
+    SInt,
+    UInt,
+    Real,
+    Str,
+    Array,
+    Obj,
+};
+
+/*
+ * JSON value as the JSON parser reports it: the whole value for a
+ * scalar JSON value, or only its kind and location for the beginning
+ * of a JSON array or object.
+ */
+struct ParsedJsonVal final
+{
+    explicit ParsedJsonVal(const JsonValKind kindParam, TextLocation locParam) :
+        kind {kindParam},
+        loc {std::move(locParam)}
+    {
+    }
+
+    JsonValKind kind;
+    TextLocation loc;
+
+    // raw value, depending on `kind`
+    bool boolVal = false;
+    unsigned long long uIntVal = 0;
+    long long sIntVal = 0;
+    double realVal = 0.;
+    const std::string *strVal = nullptr;
+
+    /*
+     * For the beginning of a JSON object: raw string value of its
+     * `type` property, if known in advance (`objTypeBegin` isn't
+     * `nullptr`).
+     */
+    const char *objTypeBegin = nullptr;
+    const char *objTypeEnd = nullptr;
+};
+
+/*
+ * Throws a text parse error at `loc` indicating that a JSON value
+ * having the kind `kind` (or `null` if `allowNull` is true) is
+ * expected.
+ */
+[[ noreturn ]] void throwExpectingKind(const JsonValKind kind, const TextLocation& loc,
+                                       const bool allowNull = false)
+{
+    std::ostringstream ss;
+
+    ss << "Expecting ";
+
+    switch (kind) {
+    case JsonValKind::Null:
+        ss << "`null`";
+        break;
+
+    case JsonValKind::Bool:
+        ss << "a boolean";
+        break;
+
+    case JsonValKind::SInt:
+        ss << "a signed integer";
+        break;
+
+    case JsonValKind::UInt:
+        ss << "an unsigned integer";
+        break;
+
+    case JsonValKind::Real:
+        ss << "a real number";
+        break;
+
+    case JsonValKind::Str:
+        ss << "a string";
+        break;
+
+    case JsonValKind::Array:
+        ss << "an array";
+        break;
+
+    case JsonValKind::Obj:
+        ss << "an object";
+        break;
+
+    default:
+        std::abort();
+    }
+
+    if (allowNull) {
+        ss << " or `null`";
+    }
+
+    ss << '.';
+    throwTextParseError(ss.str(), loc);
+}
+
+/*
+ * Returns a pointer to a new text parse error having the initial
+ * message `msg` at `loc`.
+ */
+std::exception_ptr createTextParseError(std::string msg, const TextLocation& loc)
+{
+    try {
+        throwTextParseError(std::move(msg), loc);
+    } catch (const TextParseError&) {
+        return std::current_exception();
+    }
+}
+
+/*
+ * Appends the message `msg` at `loc` to the text parse error `exc`
+ * points to, and returns `exc`.
+ */
+std::exception_ptr withAppendedMsg(const std::exception_ptr& exc, std::string msg,
+                                   const TextLocation& loc)
+{
+    try {
+        std::rethrow_exception(exc);
+    } catch (TextParseError& tpExc) {
+        appendMsgToTextParseError(tpExc, std::move(msg), loc);
+        return std::current_exception();
+    }
+}
+
+void expectKind(const ParsedJsonVal& val, const JsonValKind kind)
+{
+    if (val.kind != kind) {
+        throwExpectingKind(kind, val.loc);
+    }
+}
+
+const std::string& strOfVal(const ParsedJsonVal& val)
+{
+    expectKind(val, JsonValKind::Str);
+    return *val.strVal;
+}
+
+unsigned long long uIntOfVal(const ParsedJsonVal& val)
+{
+    expectKind(val, JsonValKind::UInt);
+    return val.uIntVal;
+}
+
+unsigned long long uIntInRangeOfVal(const ParsedJsonVal& val, const unsigned long long minVal,
+                                    const unsigned long long maxVal)
+{
+    const auto uIntVal = uIntOfVal(val);
+
+    if (uIntVal < minVal) {
+        std::ostringstream ss;
+
+        ss << "Integer " << uIntVal << " is too small: " <<
+              "expecting at least " << minVal << ".";
+        throwTextParseError(ss.str(), val.loc);
+    }
+
+    if (uIntVal > maxVal) {
+        std::ostringstream ss;
+
+        ss << "Integer " << uIntVal << " is too large: " <<
+              "expecting at most " << maxVal << ".";
+        throwTextParseError(ss.str(), val.loc);
+    }
+
+    return uIntVal;
+}
+
+/*
+ * Validates that the JSON value `val`, if it's an unsigned integer,
+ * fits a signed integer.
+ */
+void validateSIntUIntVal(const ParsedJsonVal& val)
+{
+    if (val.kind != JsonValKind::UInt) {
+        return;
+    }
+
+    static constexpr auto llMaxAsUll = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+
+    if (val.uIntVal > llMaxAsUll) {
+        std::ostringstream ss;
+
+        ss << "Expecting a signed integer: " << val.uIntVal <<
+              " is greater than " << llMaxAsUll << '.';
+        throwTextParseError(ss.str(), val.loc);
+    }
+}
+
+/*
+ * Returns the value of the JSON integer value `val` as a signed
+ * integer.
+ */
+long long sIntOfVal(const ParsedJsonVal& val)
+{
+    if (val.kind != JsonValKind::UInt && val.kind != JsonValKind::SInt) {
+        throwTextParseError("Expecting an integer.", val.loc);
+    }
+
+    validateSIntUIntVal(val);
+    return val.kind == JsonValKind::UInt ? static_cast<long long>(val.uIntVal) : val.sIntVal;
+}
+
+template <typename ValT>
+void writeRawVal(std::ostringstream& ss, const ValT& val)
+{
+    ss << val;
+}
+
+void writeRawVal(std::ostringstream& ss, const std::string& val)
+{
+    ss << '`' << val << '`';
+}
+
+/*
+ * Returns the element of `set` equal to `val`, throwing a text parse
+ * error at `loc` if there's none.
+ */
+template <typename ValT>
+const ValT& valInSet(const ValT& val, const std::set<ValT>& set, const TextLocation& loc)
+{
+    const auto it = set.find(val);
+
+    if (it != set.end()) {
+        return *it;
+    }
+
+    std::ostringstream ss;
+
+    ss << "Unexpected value ";
+    writeRawVal(ss, val);
+    ss << ": expecting ";
+
+    if (set.size() == 1) {
+        // special case: direct value
+        writeRawVal(ss, *set.begin());
+    } else if (set.size() == 2) {
+        // special case: "or" word without any comma
+        writeRawVal(ss, *set.begin());
+        ss << " or ";
+        writeRawVal(ss, *std::next(set.begin()));
+    } else {
+        // enumeration with at least one comma
+        const auto lastIt = std::prev(set.end());
+
+        for (auto it = set.begin(); it != lastIt; ++it) {
+            writeRawVal(ss, *it);
+            ss << ", ";
+        }
+
+        ss << "or ";
+        writeRawVal(ss, *lastIt);
+    }
+
+    ss << '.';
+    throwTextParseError(ss.str(), loc);
+}
+
+const std::string& strInSetOfVal(const ParsedJsonVal& val, const std::set<std::string>& set)
+{
+    return valInSet(strOfVal(val), set, val.loc);
+}
+
+unsigned long long uIntInSetOfVal(const ParsedJsonVal& val,
+                                  const std::set<unsigned long long>& set)
+{
+    return valInSet(uIntOfVal(val), set, val.loc);
+}
+
+unsigned long long alignOfVal(const ParsedJsonVal& val)
+{
+    const auto align = uIntOfVal(val);
+
+    if (!isPowOfTwo(align)) {
+        std::ostringstream ss;
+
+        ss << "Invalid alignment: " << align << " is not a power of two.";
+        throwTextParseError(ss.str(), val.loc);
+    }
+
+    return align;
+}
+
+ByteOrder boOfVal(const ParsedJsonVal& val)
+{
+    static const std::set<std::string> boStrs {strs::be, strs::le};
+    auto& boStr = strOfVal(val);
+
+    try {
+        valInSet(boStr, boStrs, val.loc);
+    } catch (TextParseError& exc) {
+        appendMsgToTextParseError(exc, "Invalid byte order:", val.loc);
+        throw;
+    }
+
+    return boStr == strs::le ? ByteOrder::Little : ByteOrder::Big;
+}
+
+BitOrder bioOfVal(const ParsedJsonVal& val)
+{
+    static const std::set<std::string> bioStrs {strs::ftl, strs::ltf};
+    auto& bioStr = strOfVal(val);
+
+    try {
+        valInSet(bioStr, bioStrs, val.loc);
+    } catch (TextParseError& exc) {
+        appendMsgToTextParseError(exc, "Invalid bit order:", val.loc);
+        throw;
+    }
+
+    return bioStr == strs::ftl ? BitOrder::FirstToLast : BitOrder::LastToFirst;
+}
+
+StringEncoding strEncodingOfVal(const ParsedJsonVal& val)
+{
+    static const std::set<std::string> encodingStrs {
+        strs::utf8,
+        strs::utf16Be,
+        strs::utf16Le,
+        strs::utf32Be,
+        strs::utf32Le,
+    };
+
+    auto& encodingStr = strInSetOfVal(val, encodingStrs);
+
+    if (encodingStr == strs::utf8) {
+        return StringEncoding::Utf8;
+    } else if (encodingStr == strs::utf16Be) {
+        return StringEncoding::Utf16Be;
+    } else if (encodingStr == strs::utf16Le) {
+        return StringEncoding::Utf16Le;
+    } else if (encodingStr == strs::utf32Be) {
+        return StringEncoding::Utf32Be;
+    } else {
+        assert(encodingStr == strs::utf32Le);
+        return StringEncoding::Utf32Le;
+    }
+}
+
+Scope scopeOfVal(const ParsedJsonVal& val)
+{
+    static const std::set<std::string> scopeStrs {
+        strs::pktHeader,
+        strs::pktCtx,
+        strs::erHeader,
+        strs::erCommonCtx,
+        strs::erSpecCtx,
+        strs::erPayload,
+    };
+
+    auto& scopeStr = strInSetOfVal(val, scopeStrs);
+
+    if (scopeStr == strs::pktHeader) {
+        return Scope::PacketHeader;
+    } else if (scopeStr == strs::pktCtx) {
+        return Scope::PacketContext;
+    } else if (scopeStr == strs::erHeader) {
+        return Scope::EventRecordHeader;
+    } else if (scopeStr == strs::erCommonCtx) {
+        return Scope::EventRecordCommonContext;
+    } else if (scopeStr == strs::erSpecCtx) {
+        return Scope::EventRecordSpecificContext;
+    } else {
+        assert(scopeStr == strs::erPayload);
+        return Scope::EventRecordPayload;
+    }
+}
+
+/*
+ * Returns the item equivalent to the scalar JSON value `val`.
+ */
+Item::Up itemOfScalarVal(const ParsedJsonVal& val)
+{
+    switch (val.kind) {
+    case JsonValKind::Null:
+        return nullptr;
+
+    case JsonValKind::Bool:
+        return createItem(val.boolVal);
+
+    case JsonValKind::SInt:
+        return createItem(val.sIntVal);
+
+    case JsonValKind::UInt:
+        return createItem(val.uIntVal);
+
+    case JsonValKind::Real:
+        return createItem(val.realVal);
+
+    case JsonValKind::Str:
+        return createItem(*val.strVal);
+
+    default:
+        std::abort();
+    }
+}
+
+/*
+ * State which all the JSON value handlers of a fragment share.
+ */
+struct ParsingCtx final
+{
+    // available data type aliases, or `nullptr` if none
+    const PseudoDtAliases *aliases;
+
+    // true if some data type refers to a data type alias while `aliases` is `nullptr`
+    bool needsAliases = false;
+};
+
+/*
+ * JSON value handler.
+ *
+ * A JSON value handler validates a JSON array or object, as the JSON
+ * parser reports its contents, and builds the corresponding result.
+ *
+ * A JSON value handler doesn't throw from the methods which receive
+ * the contents of its JSON value: it records the first validation
+ * error and throws it from onEnd(). This makes it possible to keep
+ * parsing the rest of the JSON text, a JSON syntax error having
+ * precedence over any validation error.
+ *
+ * A JSON value handler may also have an erection error (reference to
+ * an unknown data type alias) which, unlike a validation error,
+ * doesn't make its JSON value invalid: erectExc() returns it after
+ * onEnd().
+ */
+class JsonValHandler
+{
+public:
+    using Up = std::unique_ptr<JsonValHandler>;
+
+protected:
+    explicit JsonValHandler(ParsingCtx& ctx, TextLocation loc) :
+        _ctx {&ctx},
+        _loc {std::move(loc)}
+    {
+    }
+
+public:
+    virtual ~JsonValHandler() = default;
+
+    /*
+     * Handles the key `key` of the next property of the JSON object.
+     */
+    virtual void onKey(const std::string&)
+    {
+    }
+
+    /*
+     * Handles the scalar JSON element or property value `val`.
+     */
+    virtual void onScalar(const ParsedJsonVal& val) = 0;
+
+    /*
+     * Handles the beginning of the compound JSON element or property
+     * value `val`, returning the handler of its contents, or `nullptr`
+     * to skip them.
+     */
+    virtual Up onCompoundBegin(const ParsedJsonVal& val) = 0;
+
+    /*
+     * Handles the end of the valid compound JSON element or property
+     * value which `child`, which onCompoundBegin() returned, handled.
+     */
+    virtual void onCompoundEnd(JsonValHandler& child) = 0;
+
+    /*
+     * Handles the end of the invalid compound JSON element or property
+     * value at `loc`, `exc` describing why it's invalid.
+     *
+     * Called from a `catch` block: `std::current_exception()` refers
+     * to `exc`.
+     */
+    virtual void onCompoundError(TextParseError& exc, const TextLocation& loc) = 0;
+
+    /*
+     * Ends the JSON value, throwing `TextParseError` if it's invalid.
+     */
+    virtual void onEnd() = 0;
+
+    const TextLocation& loc() const noexcept
+    {
+        return _loc;
+    }
+
+    const std::exception_ptr& erectExc() const noexcept
+    {
+        return _erectExc;
+    }
+
+protected:
+    /*
+     * Returns whether or not this handler may erect its result.
+     */
+    bool _canErect() const noexcept
+    {
+        return !_erectExc && !_ctx->needsAliases;
+    }
+
+    /*
+     * Sets the erection error of this handler to the erection error
+     * of `child`, if it has any and this handler has none.
+     */
+    void _takeErectExc(const JsonValHandler& child)
+    {
+        if (!_erectExc && child._erectExc) {
+            _erectExc = child._erectExc;
+        }
+    }
+
+protected:
+    ParsingCtx *_ctx;
+    TextLocation _loc;
+    std::exception_ptr _erectExc;
+};
+
+/*
+ * Stack of JSON value handlers.
+ *
+ * Routes the JSON events to the handler of the innermost compound JSON
+ * value, calling the handler methods to begin and end its compound
+ * JSON values.
+ */
+class JsonValHandlerStack final
+{
+public:
+    /*
+     * Builds a JSON value handler stack of which `rootHandler` (not
+     * owned) handles the outermost JSON values.
+     */
+    explicit JsonValHandlerStack(JsonValHandler& rootHandler) :
+        _rootHandler {&rootHandler}
+    {
+    }
+
+    void onKey(const std::string& key)
+    {
+        if (_skipDepth == 0) {
+            this->_top().onKey(key);
+        }
+    }
+
+    void onScalar(const ParsedJsonVal& val)
+    {
+        if (_skipDepth == 0) {
+            this->_top().onScalar(val);
+        }
+    }
+
+    void onCompoundBegin(const ParsedJsonVal& val)
+    {
+        if (_skipDepth > 0) {
+            ++_skipDepth;
+            return;
+        }
+
+        auto handler = this->_top().onCompoundBegin(val);
+
+        if (handler) {
+            _handlers.push_back(std::move(handler));
+        } else {
+            _skipDepth = 1;
+        }
+    }
+
+    void onCompoundEnd()
+    {
+        if (_skipDepth > 0) {
+            --_skipDepth;
+            return;
+        }
+
+        assert(!_handlers.empty());
+
+        const auto handler = std::move(_handlers.back());
+
+        _handlers.pop_back();
+
+        auto& parentHandler = this->_top();
+
+        try {
+            handler->onEnd();
+        } catch (TextParseError& exc) {
+            parentHandler.onCompoundError(exc, handler->loc());
+            return;
+        }
+
+        parentHandler.onCompoundEnd(*handler);
+    }
+
+private:
+    JsonValHandler& _top() noexcept
+    {
+        return _handlers.empty() ? *_rootHandler : *_handlers.back();
+    }
+
+private:
+    JsonValHandler *_rootHandler;
+    std::vector<JsonValHandler::Up> _handlers;
+
+    // depth within the skipped compound JSON value, if any
+    Size _skipDepth = 0;
+};
+
+/*
+ * Handler of a JSON array or object which converts it to an item
+ * (attributes).
+ */
+class ItemValHandler final :
+    public JsonValHandler
+{
+public:
+    explicit ItemValHandler(ParsingCtx& ctx, const ParsedJsonVal& val) :
+        JsonValHandler {ctx, val.loc},
+        _isArray {val.kind == JsonValKind::Array}
+    {
+    }
+
+    void onKey(const std::string& key) override
+    {
+        _key = key;
+    }
+
+    void onScalar(const ParsedJsonVal& val) override
+    {
+        this->_addItem(itemOfScalarVal(val));
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal& val) override
+    {
+        return std::make_unique<ItemValHandler>(*_ctx, val);
+    }
+
+    void onCompoundEnd(JsonValHandler& child) override
+    {
+        this->_addItem(static_cast<ItemValHandler&>(child).releaseItem());
+    }
+
+    void onCompoundError(TextParseError&, const TextLocation&) override
+    {
+        // an item handler never fails
+        std::abort();
+    }
+
+    void onEnd() override
+    {
+    }
+
+    Item::Up releaseItem()
+    {
+        if (_isArray) {
+            return createItem(std::move(_arrayItems));
+        }
+
+        return this->releaseMapItem();
+    }
+
+    MapItem::Up releaseMapItem()
+    {
+        assert(!_isArray);
+        return createItem(std::move(_mapItems));
+    }
+
+private:
+    void _addItem(Item::Up item)
+    {
+        if (_isArray) {
+            _arrayItems.push_back(std::move(item));
+        } else {
+            _mapItems.insert(std::make_pair(_key, std::move(item)));
+        }
+    }
+
+private:
+    bool _isArray;
+    std::string _key;
+    ArrayItem::Container _arrayItems;
+    MapItem::Container _mapItems;
+};
+
+/*
+ * Handler of a CTF 2 JSON extensions object.
+ */
+class ExtValHandler final :
+    public JsonValHandler
+{
+public:
+    explicit ExtValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonValHandler {ctx, std::move(loc)}
+    {
+    }
+
+    void onKey(const std::string&) override
+    {
+        _isEmpty = false;
+    }
+
+    void onScalar(const ParsedJsonVal&) override
+    {
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal&) override
+    {
+        // any extension is invalid anyway
+        return nullptr;
+    }
+
+    void onCompoundEnd(JsonValHandler&) override
+    {
+    }
+
+    void onCompoundError(TextParseError&, const TextLocation&) override
+    {
+    }
+
+    void onEnd() override
+    {
+        if (!_isEmpty) {
+            // never valid
+            throwTextParseError("yactfr doesn't support any extension.", _loc);
+        }
+    }
+
+private:
+    bool _isEmpty = true;
+};
+
+/*
+ * JSON object property requirement.
+ */
+struct PropReq final
+{
+    // property name (one of the `strs` strings, to compare pointers)
+    const char *name;
+
+    // whether or not the property is mandatory
+    bool isRequired;
+
+    // index of the property within its table
+    unsigned int index;
+};
+
+/*
+ * JSON object property requirement table.
+ */
+struct PropReqTable final
+{
+    std::unordered_map<std::string, PropReq> reqs;
+
+    // bit mask of the mandatory properties (bit index: `PropReq::index`)
+    std::uint64_t requiredMask = 0;
+};
+
+/*
+ * JSON object property specification.
+ */
+struct PropSpec final
+{
+    const char *name;
+    bool isRequired;
+};
+
+using PropSpecs = std::vector<PropSpec>;
+
+/*
+ * Creates a JSON object property requirement table from the
+ * specifications `initSpecs` (range construction of the map, if not
+ * empty) followed with `addedSpecs` (insertions).
+ *
+ * The iteration order of the map, which is the order in which
+ * JsonObjValHandler checks the presence of mandatory properties,
+ * depends on this construction sequence.
+ */
+PropReqTable createPropReqTable(const PropSpecs& initSpecs, const PropSpecs& addedSpecs)
+{
+    using Reqs = decltype(PropReqTable::reqs);
+
+    PropReqTable table;
+    std::vector<Reqs::value_type> initEntries;
+    auto index = 0U;
+
+    for (auto& spec : initSpecs) {
+        initEntries.emplace_back(spec.name, PropReq {spec.name, spec.isRequired, index});
+        ++index;
+    }
+
+    if (!initEntries.empty()) {
+        table.reqs = Reqs {initEntries.begin(), initEntries.end()};
+    }
+
+    for (auto& spec : addedSpecs) {
+        table.reqs.emplace(spec.name, PropReq {spec.name, spec.isRequired, index});
+        ++index;
+    }
+
+    for (auto& keyReqPair : table.reqs) {
+        if (keyReqPair.second.isRequired) {
+            table.requiredMask |= std::uint64_t {1} << keyReqPair.second.index;
+        }
+    }
+
+    assert(index <= 64);
+    return table;
+}
+
+/*
+ * JSON object handler.
+ *
+ * If this handler has a property requirement table, then a property
+ * which isn't part of it is invalid. Otherwise, _prop() is always
+ * `nullptr` and the subclass handles all the properties.
+ *
+ * onEnd() throws, in this order:
+ *
+ * 1. The error about the first missing mandatory property, in table
+ *    order.
+ *
+ * 2. The error about the property having the smallest key amongst the
+ *    unknown and invalid properties.
+ *
+ * 3. Any error which _onEnd() throws.
+ *
+ * _appendCtx() may append messages to this error.
+ */
+class JsonObjValHandler :
+    public JsonValHandler
+{
+protected:
+    explicit JsonObjValHandler(ParsingCtx& ctx, TextLocation loc,
+                               const PropReqTable * const propReqTable = nullptr) :
+        JsonValHandler {ctx, std::move(loc)},
+        _propReqTable {propReqTable}
+    {
+    }
+
+public:
+    void onKey(const std::string& key) override
+    {
+        if (_propReqTable) {
+            const auto it = _propReqTable->reqs.find(key);
+
+            if (it != _propReqTable->reqs.end()) {
+                _curKey = &it->first;
+                _curPropReq = &it->second;
+                _seenProps |= std::uint64_t {1} << it->second.index;
+                return;
+            }
+        }
+
+        _curPropReq = nullptr;
+        _otherKey = key;
+        _curKey = &_otherKey;
+    }
+
+    void onScalar(const ParsedJsonVal& val) override
+    {
+        if (!this->_isKnownProp(val)) {
+            return;
+        }
+
+        try {
+            this->_onScalarProp(val);
+        } catch (TextParseError& exc) {
+            this->_onPropError(exc, val.loc);
+        }
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal& val) override
+    {
+        if (!this->_isKnownProp(val)) {
+            return nullptr;
+        }
+
+        try {
+            return this->_onCompoundPropBegin(val);
+        } catch (TextParseError& exc) {
+            this->_onPropError(exc, val.loc);
+            return nullptr;
+        }
+    }
+
+    void onCompoundEnd(JsonValHandler& child) override
+    {
+        this->_onCompoundPropEnd(child);
+    }
+
+    void onCompoundError(TextParseError& exc, const TextLocation& loc) override
+    {
+        this->_onPropError(exc, loc);
+    }
+
+    void onEnd() override
+    {
+        try {
+            this->_validateMandatoryProps();
+
+            if (_propExc) {
+                std::rethrow_exception(_propExc);
+            }
+
+            this->_onEnd();
+        } catch (TextParseError& exc) {
+            this->_appendCtx(exc);
+            throw;
+        }
+    }
+
+protected:
+    /*
+     * Name of the current property (one of the `strs` strings), or
+     * `nullptr` if this handler has no property requirement table.
+     */
+    const char *_prop() const noexcept
+    {
+        return _curPropReq ? _curPropReq->name : nullptr;
+    }
+
+    /*
+     * Key of the current property.
+     */
+    const std::string& _key() const noexcept
+    {
+        assert(_curKey);
+        return *_curKey;
+    }
+
+    /*
+     * Handles the scalar value `val` of the current property, throwing
+     * `TextParseError` if it's invalid.
+     *
+     * `val` may also be the beginning of a compound value for a
+     * property which only accepts a scalar value, in which case this
+     * method must throw.
+     */
+    virtual void _onScalarProp(const ParsedJsonVal& val) = 0;
+
+    /*
+     * Handles the beginning of the compound value `val` of the current
+     * property, returning its handler, or throwing `TextParseError` if
+     * it's invalid.
+     */
+    virtual Up _onCompoundPropBegin(const ParsedJsonVal& val)
+    {
+        // scalar property: throws
+        this->_onScalarProp(val);
+        std::abort();
+    }
+
+    /*
+     * Handles the end of the valid compound value of the current
+     * property which `child` handled.
+     */
+    virtual void _onCompoundPropEnd(JsonValHandler&)
+    {
+    }
+
+    /*
+     * Called when all the properties are valid: performs any
+     * additional validation and builds the result.
+     */
+    virtual void _onEnd()
+    {
+    }
+
+    /*
+     * Appends the messages of this JSON object to `exc`.
+     */
+    virtual void _appendCtx(TextParseError&)
+    {
+    }
+
+    /*
+     * Appends the message of the current property, of which the value
+     * is at `valLoc`, to `exc`.
+     */
+    virtual void _appendPropCtx(TextParseError& exc, const TextLocation& valLoc)
+    {
+        std::ostringstream ss;
+
+        ss << "In object property `" << this->_key() << "`:";
+        appendMsgToTextParseError(exc, ss.str(), valLoc);
+    }
+
+    /*
+     * Returns the handler of the value `val` of a CTF 2 attributes
+     * property.
+     */
+    Up _createAttrsHandler(const ParsedJsonVal& val)
+    {
+        expectKind(val, JsonValKind::Obj);
+        return std::make_unique<ItemValHandler>(*_ctx, val);
+    }
+
+    /*
+     * Returns the handler of the value `val` of a CTF 2 extensions
+     * property.
+     */
+    Up _createExtHandler(const ParsedJsonVal& val)
+    {
+        expectKind(val, JsonValKind::Obj);
+        return std::make_unique<ExtValHandler>(*_ctx, val.loc);
+    }
+
+    /*
+     * Returns a clone of the pseudo data type which the data type
+     * alias named by the JSON value `val` of the current property
+     * aliases.
+     *
+     * Returns `nullptr` if the alias isn't available. If the alias
+     * doesn't exist, then this method also sets `erectExc`, if not
+     * already set, to the corresponding erection error.
+     */
+    PseudoDt::Up _aliasedPseudoDt(const ParsedJsonVal& val, std::exception_ptr& erectExc)
+    {
+        if (val.kind != JsonValKind::Str) {
+            // neither a data type alias name nor a full data type
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        }
+
+        if (!_ctx->aliases) {
+            _ctx->needsAliases = true;
+            return nullptr;
+        }
+
+        const auto it = _ctx->aliases->find(*val.strVal);
+
+        if (it != _ctx->aliases->end()) {
+            return it->second->clone();
+        }
+
+        if (!erectExc) {
+            std::ostringstream ss;
+
+            ss << "Cannot find data type alias `" << *val.strVal << "`.";
+            erectExc = createTextParseError(ss.str(), val.loc);
+            ss.str(std::string {});
+            ss << "In object property `" << this->_key() << "`:";
+            erectExc = withAppendedMsg(erectExc, ss.str(), val.loc);
+        }
+
+        return nullptr;
+    }
+
+private:
+    /*
+     * Returns whether or not the current property, of which the value
+     * is `val`, is known, recording an error if it's not.
+     */
+    bool _isKnownProp(const ParsedJsonVal& val)
+    {
+        if (_curPropReq || !_propReqTable) {
+            return true;
+        }
+
+        if (!this->_hasPropExcBeforeCurKey()) {
+            std::ostringstream ss;
+
+            ss << "Unknown object property `" << this->_key() << "`.";
+            this->_setPropExc(createTextParseError(ss.str(), val.loc));
+        }
+
+        return false;
+    }
+
+    void _onPropError(TextParseError& exc, const TextLocation& valLoc)
+    {
+        if (this->_hasPropExcBeforeCurKey()) {
+            return;
+        }
+
+        this->_appendPropCtx(exc, valLoc);
+        this->_setPropExc(std::current_exception());
+    }
+
+    bool _hasPropExcBeforeCurKey() const
+    {
+        return _propExc && _propExcKey < this->_key();
+    }
+
+    void _setPropExc(std::exception_ptr exc)
+    {
+        _propExc = std::move(exc);
+        _propExcKey = this->_key();
+    }
+
+    void _validateMandatoryProps() const
+    {
+        if (!_propReqTable ||
+                (_seenProps & _propReqTable->requiredMask) == _propReqTable->requiredMask) {
+            return;
+        }
+
+        for (auto& keyPropReqPair : _propReqTable->reqs) {
+            auto& propReq = keyPropReqPair.second;
+
+            if (propReq.isRequired && !(_seenProps & (std::uint64_t {1} << propReq.index))) {
+                std::ostringstream ss;
+
+                ss << "Missing mandatory object property `" << keyPropReqPair.first << "`.";
+                throwTextParseError(ss.str(), _loc);
+            }
+        }
+    }
+
+private:
+    const PropReqTable *_propReqTable;
+
+    // current property
+    const std::string *_curKey = nullptr;
+    const PropReq *_curPropReq = nullptr;
+
+    // current key when it's not part of `*_propReqTable`
+    std::string _otherKey;
+
+    // bit mask of the properties seen so far
+    std::uint64_t _seenProps = 0;
+
+    // error of the invalid property having the smallest key, and its key
+    std::exception_ptr _propExc;
+    std::string _propExcKey;
+};
+
+/*
+ * JSON array handler.
+ *
+ * onEnd() throws, in this order:
+ *
+ * 1. The error about the size of the array (outside the
+ *    [`minSize`, `maxSize`] range).
+ *
+ * 2. The error about the first invalid element.
+ *
+ * 3. Any error which _onEnd() throws.
+ *
+ * _appendCtx() may append messages to this error.
+ */
+class JsonArrayValHandler :
+    public JsonValHandler
+{
+protected:
+    explicit JsonArrayValHandler(ParsingCtx& ctx, TextLocation loc, const Size minSize = 0,
+                                 const Size maxSize = std::numeric_limits<Size>::max()) :
+        JsonValHandler {ctx, std::move(loc)},
+        _minSize {minSize},
+        _maxSize {maxSize}
+    {
+    }
+
+public:
+    void onScalar(const ParsedJsonVal& val) override
+    {
+        ++_size;
+
+        if (_elemExc) {
+            // already invalid
+            return;
+        }
+
+        try {
+            this->_onScalarElem(val);
+        } catch (TextParseError& exc) {
+            this->_onElemError(exc, val.loc);
+        }
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal& val) override
+    {
+        ++_size;
+
+        if (_elemExc) {
+            // already invalid
+            return nullptr;
+        }
+
+        try {
+            return this->_onCompoundElemBegin(val);
+        } catch (TextParseError& exc) {
+            this->_onElemError(exc, val.loc);
+            return nullptr;
+        }
+    }
+
+    void onCompoundEnd(JsonValHandler& child) override
+    {
+        this->_onCompoundElemEnd(child);
+    }
+
+    void onCompoundError(TextParseError& exc, const TextLocation& loc) override
+    {
+        this->_onElemError(exc, loc);
+    }
+
+    void onEnd() override
+    {
+        try {
+            if (_size < _minSize) {
+                std::ostringstream ss;
+
+                ss << "Size of array (" << _size << ") is too small: " <<
+                      "expecting at least " << _minSize << " elements.";
+                throwTextParseError(ss.str(), _loc);
+            }
+
+            if (_size > _maxSize) {
+                std::ostringstream ss;
+
+                ss << "Size of array (" << _size << ") is too large: " <<
+                      "expecting at most " << _maxSize << " elements    .";
+                throwTextParseError(ss.str(), _loc);
+            }
+
+            if (_elemExc) {
+                std::rethrow_exception(_elemExc);
+            }
+
+            this->_onEnd();
+        } catch (TextParseError& exc) {
+            this->_appendCtx(exc);
+            throw;
+        }
+    }
+
+protected:
+    /*
+     * Number of the current element (starting at 1).
+     */
+    Size _elemNumber() const noexcept
+    {
+        return _size;
+    }
+
+    /*
+     * Handles the scalar element `val`, throwing `TextParseError` if
+     * it's invalid.
+     *
+     * `val` may also be the beginning of a compound element if the
+     * array only accepts scalar elements, in which case this method
+     * must throw.
+     */
+    virtual void _onScalarElem(const ParsedJsonVal& val) = 0;
+
+    /*
+     * Handles the beginning of the compound element `val`, returning
+     * its handler, or throwing `TextParseError` if it's invalid.
+     */
+    virtual Up _onCompoundElemBegin(const ParsedJsonVal& val)
+    {
+        // scalar element: throws
+        this->_onScalarElem(val);
+        std::abort();
+    }
+
+    /*
+     * Handles the end of the valid compound element which `child`
+     * handled.
+     */
+    virtual void _onCompoundElemEnd(JsonValHandler&)
+    {
+    }
+
+    /*
+     * Called when the size and all the elements are valid: performs
+     * any additional validation and builds the result.
+     */
+    virtual void _onEnd()
+    {
+    }
+
+    /*
+     * Appends the messages of this JSON array to `exc`.
+     */
+    virtual void _appendCtx(TextParseError&)
+    {
+    }
+
+private:
+    void _onElemError(TextParseError& exc, const TextLocation& loc)
+    {
+        std::ostringstream ss;
+
+        ss << "In array element #" << _size << ":";
+        appendMsgToTextParseError(exc, ss.str(), loc);
+        _elemExc = std::current_exception();
+    }
+
+private:
+    Size _minSize;
+    Size _maxSize;
+    Size _size = 0;
+    std::exception_ptr _elemExc;
+};
+
+/*
+ * Handler of a CTF 2 JSON UUID array.
+ */
+class UuidValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    explicit UuidValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonArrayValHandler {ctx, std::move(loc), 16, 16}
+    {
+    }
+
+    const boost::uuids::uuid& uuid() const noexcept
+    {
+        return _uuid;
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        const auto byte = uIntInRangeOfVal(val, 0, 255);
+
+        if (this->_elemNumber() <= _uuid.static_size()) {
+            _uuid.data[this->_elemNumber() - 1] = static_cast<std::uint8_t>(byte);
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid UUID:", _loc);
+    }
+
+private:
+    boost::uuids::uuid _uuid;
+};
+
+/*
+ * Handler of the path array of a CTF 2 JSON data location.
+ */
+class DataLocPathValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    explicit DataLocPathValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonArrayValHandler {ctx, std::move(loc), 1}
+    {
+    }
+
+    PseudoDataLoc::PathElems& pathElems() noexcept
+    {
+        return _pathElems;
+    }
+
+    // location of the last element
+    const TextLocation& lastElemLoc() const noexcept
+    {
+        return _lastElemLoc;
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        if (val.kind == JsonValKind::Str) {
+            _pathElems.emplace_back(*val.strVal);
+        } else if (val.kind == JsonValKind::Null) {
+            _pathElems.emplace_back(boost::none);
+        } else {
+            throwExpectingKind(JsonValKind::Str, val.loc, true);
+        }
+
+        _lastElemLoc = val.loc;
+    }
+
+private:
+    PseudoDataLoc::PathElems _pathElems;
+    TextLocation _lastElemLoc;
+};
+
+/*
+ * Handler of a CTF 2 JSON data location object.
+ */
+class DataLocValHandler final :
+    public JsonObjValHandler
+{
+public:
+    explicit DataLocValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonObjValHandler {ctx, std::move(loc), &DataLocValHandler::_propReqTable()}
+    {
+    }
+
+    PseudoDataLoc releaseDataLoc()
+    {
+        return PseudoDataLoc {
+            _scope ? PseudoDataLoc::Kind::Abs : PseudoDataLoc::Kind::Rel2,
+            _scope, std::move(_pathElems), _loc
+        };
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createPropReqTable({
+            {strs::orig, false},
+            {strs::path, true},
+        }, {});
+
+        return table;
+    }
+
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        if (this->_prop() == strs::orig) {
+            _scope = scopeOfVal(val);
+        } else {
+            assert(this->_prop() == strs::path);
+            throwExpectingKind(JsonValKind::Array, val.loc);
+        }
+    }
+
+    Up _onCompoundPropBegin(const ParsedJsonVal& val) override
+    {
+        if (this->_prop() == strs::path) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<DataLocPathValHandler>(*_ctx, val.loc);
+        }
+
+        return JsonObjValHandler::_onCompoundPropBegin(val);
+    }
+
+    void _onCompoundPropEnd(JsonValHandler& child) override
+    {
+        auto& pathHandler = static_cast<DataLocPathValHandler&>(child);
+
+        _pathElems = std::move(pathHandler.pathElems());
+        _lastPathElemLoc = pathHandler.lastElemLoc();
+    }
+
+    void _onEnd() override
+    {
+        if (!_pathElems.back()) {
+            throwTextParseError("Path ends with `null`.", _lastPathElemLoc);
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid data location:", _loc);
+    }
+
+private:
+    boost::optional<Scope> _scope;
+    PseudoDataLoc::PathElems _pathElems;
+    TextLocation _lastPathElemLoc;
+};
+
+/*
+ * Kind of the integers of a CTF 2 JSON integer range.
+ */
+enum class IntRangeKind
+{
+    // unsigned integers
+    UInt,
+
+    // integers which fit signed integers
+    SInt,
+
+    // any integers
+    Int,
+};
+
+/*
+ * Handler of a CTF 2 JSON integer range array.
+ */
+class IntRangeValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    explicit IntRangeValHandler(ParsingCtx& ctx, TextLocation loc, const IntRangeKind kind) :
+        JsonArrayValHandler {ctx, std::move(loc), 2, 2},
+        _kind {kind}
+    {
+    }
+
+    /*
+     * Returns the lower (`index` is 0) or upper (`index` is 1) value,
+     * casted as `ValT`.
+     */
+    template <typename ValT>
+    ValT val(const Index index) const noexcept
+    {
+        assert(index < 2);
+
+        if (_isUInt[index]) {
+            return static_cast<ValT>(_uVals[index]);
+        } else {
+            return static_cast<ValT>(_sVals[index]);
+        }
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        switch (_kind) {
+        case IntRangeKind::UInt:
+            uIntOfVal(val);
+            break;
+
+        case IntRangeKind::SInt:
+            sIntOfVal(val);
+            break;
+
+        case IntRangeKind::Int:
+            if (val.kind != JsonValKind::UInt && val.kind != JsonValKind::SInt) {
+                throwTextParseError("Expecting an integer.", val.loc);
+            }
+
+            break;
+
+        default:
+            std::abort();
+        }
+
+        if (this->_elemNumber() <= 2) {
+            const auto index = this->_elemNumber() - 1;
+
+            _isUInt[index] = val.kind == JsonValKind::UInt;
+            _uVals[index] = val.uIntVal;
+            _sVals[index] = val.sIntVal;
+        }
+    }
+
+    template <typename LowerT, typename UpperT>
+    void _throwLowerGtUpper(const LowerT lower, const UpperT upper) const
+    {
+        std::ostringstream ss;
+
+        ss << lower << " is greater than " << upper << '.';
+        throwTextParseError(ss.str(), _loc);
+    }
+
+    void _onEnd() override
+    {
+        /*
+         * Here's the truth table:
+         *
+         * ╔════╦════════════╦════════════╦═══════════════════════════╗
+         * ║ ID ║ Lower      ║ Upper      ║ Valid?                    ║
+         * ╠════╬════════════╬════════════╬═══════════════════════════╣
+         * ║ 1  ║ Unsigned   ║ Unsigned   ║ Lower < upper             ║
+         * ║ 2  ║ Signed     ║ Signed     ║ Lower < upper             ║
+         * ║ 3  ║ Unsigned   ║ Signed ≥ 0 ║ Lower < upper as unsigned ║
+         * ║ 4  ║ Unsigned   ║ Signed < 0 ║ No                        ║
+         * ║ 5  ║ Signed ≥ 0 ║ Unsigned   ║ Lower as unsigned < upper ║
+         * ║ 6  ║ Signed < 0 ║ Unsigned   ║ Yes                       ║
+         * ╚════╩════════════╩════════════╩═══════════════════════════╝
+         */
+        if (_isUInt[0]) {
+            const auto uLower = _uVals[0];
+
+            if (_isUInt[1]) {
+                const auto uUpper = _uVals[1];
+
+                if (uUpper < uLower) {
+                    // ID 1
+                    this->_throwLowerGtUpper(uLower, uUpper);
+                }
+            } else {
+                const auto sUpper = _sVals[1];
+
+                if (sUpper < 0) {
+                    // ID 4
+                    this->_throwLowerGtUpper(uLower, sUpper);
+                }
+
+                if (static_cast<unsigned long long>(sUpper) < uLower) {
+                    // ID 3
+                    this->_throwLowerGtUpper(uLower, sUpper);
+                }
+            }
+        } else {
+            const auto sLower = _sVals[0];
+
+            if (!_isUInt[1]) {
+                const auto sUpper = _sVals[1];
+
+                if (sUpper < sLower) {
+                    // ID 2
+                    this->_throwLowerGtUpper(sLower, sUpper);
+                }
+            } else if (sLower >= 0) {
+                const auto uUpper = _uVals[1];
+
+                if (uUpper < static_cast<unsigned long long>(sLower)) {
+                    // ID 5
+                    this->_throwLowerGtUpper(sLower, uUpper);
+                }
+            }
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid integer range:", _loc);
+    }
+
+private:
+    IntRangeKind _kind;
+    bool _isUInt[2] = {false, false};
+    unsigned long long _uVals[2] = {0, 0};
+    long long _sVals[2] = {0, 0};
+};
+
+/*
+ * Handler of a CTF 2 JSON integer range set array, building an
+ * instance of `RangeSetT`.
+ */
+template <typename RangeSetT>
+class IntRangeSetValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    explicit IntRangeSetValHandler(ParsingCtx& ctx, TextLocation loc, const IntRangeKind kind) :
+        JsonArrayValHandler {ctx, std::move(loc), 1},
+        _kind {kind}
+    {
+    }
+
+    RangeSetT releaseRangeSet()
+    {
+        return RangeSetT {std::move(_ranges)};
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        throwExpectingKind(JsonValKind::Array, val.loc);
+    }
+
+    Up _onCompoundElemBegin(const ParsedJsonVal& val) override
+    {
+        expectKind(val, JsonValKind::Array);
+        return std::make_unique<IntRangeValHandler>(*_ctx, val.loc, _kind);
+    }
+
+    void _onCompoundElemEnd(JsonValHandler& child) override
+    {
+        using Val = typename RangeSetT::Value;
+
+        auto& rangeHandler = static_cast<IntRangeValHandler&>(child);
+
+        _ranges.insert(typename RangeSetT::Range {
+            rangeHandler.val<Val>(0), rangeHandler.val<Val>(1)
+        });
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid integer range set:", _loc);
+    }
+
+private:
+    IntRangeKind _kind;
+    std::set<typename RangeSetT::Range> _ranges;
+};
+
+/*
+ * Handler of a CTF 2 JSON integer type mappings or bit map flags
+ * object, building an instance of `MappingsT`.
+ */
+template <typename MappingsT>
+class IntTypeMappingsValHandler final :
+    public JsonObjValHandler
+{
+private:
+    using _tRangeSetValHandler = IntRangeSetValHandler<typename MappingsT::mapped_type>;
+
+public:
+    /*
+     * `entryName` is the name of an entry (for example, "mapping") and
+     * `objName` the name of the object (for example, "integer type
+     * mappings").
+     */
+    explicit IntTypeMappingsValHandler(ParsingCtx& ctx, TextLocation loc,
+                                       const IntRangeKind rangeKind,
+                                       const char * const entryName,
+                                       const char * const objName,
+                                       const bool allowEmpty = true) :
+        JsonObjValHandler {ctx, std::move(loc)},
+        _rangeKind {rangeKind},
+        _entryName {entryName},
+        _objName {objName},
+        _allowEmpty {allowEmpty}
+    {
+    }
+
+    MappingsT releaseMappings()
+    {
+        return std::move(_mappings);
+    }
+
+private:
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        _isEmpty = false;
+        throwExpectingKind(JsonValKind::Array, val.loc);
+    }
+
+    Up _onCompoundPropBegin(const ParsedJsonVal& val) override
+    {
+        _isEmpty = false;
+        expectKind(val, JsonValKind::Array);
+        return std::make_unique<_tRangeSetValHandler>(*_ctx, val.loc, _rangeKind);
+    }
+
+    void _onCompoundPropEnd(JsonValHandler& child) override
+    {
+        _mappings.insert(std::make_pair(this->_key(),
+                                        static_cast<_tRangeSetValHandler&>(child).releaseRangeSet()));
+    }
+
+    void _onEnd() override
+    {
+        if (!_allowEmpty && _isEmpty) {
+            std::ostringstream ss;
+
+            ss << "Expecting at least one " << _entryName << '.';
+            throwTextParseError(ss.str(), _loc);
+        }
+    }
+
+    void _appendPropCtx(TextParseError& exc, const TextLocation&) override
+    {
+        std::ostringstream ss;
+
+        ss << "In " << _entryName << " `" << this->_key() << "`:";
+        appendMsgToTextParseError(exc, ss.str(), _loc);
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        std::ostringstream ss;
+
+        ss << "Invalid " << _objName << ":";
+        appendMsgToTextParseError(exc, ss.str(), _loc);
+    }
+
+private:
+    IntRangeKind _rangeKind;
+    const char *_entryName;
+    const char *_objName;
+    bool _allowEmpty;
+    bool _isEmpty = true;
+    MappingsT _mappings;
+};
+
+/*
+ * Handler of a CTF 2 JSON roles array.
+ */
+class RolesValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    /*
+     * `isUIntType` indicates whether or not the roles are the ones of
+     * an unsigned integer type: if so, then roles() returns them.
+     */
+    explicit RolesValHandler(ParsingCtx& ctx, TextLocation loc, const bool isUIntType) :
+        JsonArrayValHandler {ctx, std::move(loc)},
+        _isUIntType {isUIntType}
+    {
+    }
+
+    UnsignedIntegerTypeRoleSet& roles() noexcept
+    {
+        return _roles;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return this->_elemNumber() == 0;
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        auto& roleName = strOfVal(val);
+
+        if (!_isUIntType) {
+            return;
+        }
+
+        // ignore any unknown role
+        if (roleName == strs::dscId) {
+            _roles.insert(UnsignedIntegerTypeRole::DataStreamTypeId);
+        } else if (roleName == strs::dsId) {
+            _roles.insert(UnsignedIntegerTypeRole::DataStreamId);
+        } else if (roleName == strs::pktMagicNumber) {
+            _roles.insert(UnsignedIntegerTypeRole::PacketMagicNumber);
+        } else if (roleName == strs::defClkTs) {
+            _roles.insert(UnsignedIntegerTypeRole::DefaultClockTimestamp);
+        } else if (roleName == strs::discErCounterSnap) {
+            _roles.insert(UnsignedIntegerTypeRole::DiscardedEventRecordCounterSnapshot);
+        } else if (roleName == strs::pktContentLen) {
+            _roles.insert(UnsignedIntegerTypeRole::PacketContentLength);
+        } else if (roleName == strs::pktTotalLen) {
+            _roles.insert(UnsignedIntegerTypeRole::PacketTotalLength);
+        } else if (roleName == strs::pktEndDefClkTs) {
+            _roles.insert(UnsignedIntegerTypeRole::PacketEndDefaultClockTimestamp);
+        } else if (roleName == strs::pktSeqNum) {
+            _roles.insert(UnsignedIntegerTypeRole::PacketSequenceNumber);
+        } else if (roleName == strs::ercId) {
+            _roles.insert(UnsignedIntegerTypeRole::EventRecordTypeId);
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid roles:", _loc);
+    }
+
+private:
+    bool _isUIntType;
+    UnsignedIntegerTypeRoleSet _roles;
+};
+
+/*
+ * JSON event, as recorded by `JsonValRecorder`.
+ */
+struct JsonEvent final
+{
+    enum class Kind
+    {
+        Key,
+        Scalar,
+        CompoundBegin,
+        CompoundEnd,
+    };
+
+    explicit JsonEvent(const Kind kindParam, ParsedJsonVal valParam) :
+        kind {kindParam},
+        val {std::move(valParam)}
+    {
+    }
+
+    Kind kind;
+
+    // value (scalar or compound beginning)
+    ParsedJsonVal val;
+
+    // key or string value (`val.strVal` is invalid)
+    std::string str;
+};
+
+using JsonEvents = std::vector<JsonEvent>;
+
+/*
+ * Handler which records the contents of a compound JSON value as
+ * JSON events to replay them later.
+ */
+class JsonValRecorder final :
+    public JsonValHandler
+{
+public:
+    explicit JsonValRecorder(ParsingCtx& ctx, TextLocation loc, JsonEvents& events) :
+        JsonValHandler {ctx, std::move(loc)},
+        _events {&events}
+    {
+    }
+
+    void onKey(const std::string& key) override
+    {
+        _events->emplace_back(JsonEvent::Kind::Key, ParsedJsonVal {JsonValKind::Null, _loc});
+        _events->back().str = key;
+    }
+
+    void onScalar(const ParsedJsonVal& val) override
+    {
+        recordVal(*_events, JsonEvent::Kind::Scalar, val);
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal& val) override
+    {
+        recordVal(*_events, JsonEvent::Kind::CompoundBegin, val);
+        return std::make_unique<JsonValRecorder>(*_ctx, val.loc, *_events);
+    }
+
+    void onCompoundEnd(JsonValHandler&) override
+    {
+    }
+
+    void onCompoundError(TextParseError&, const TextLocation&) override
+    {
+        // a recorder never fails
+        std::abort();
+    }
+
+    void onEnd() override
+    {
+        _events->emplace_back(JsonEvent::Kind::CompoundEnd, ParsedJsonVal {JsonValKind::Null, _loc});
+    }
+
+    /*
+     * Appends an event of kind `kind` for the value `val` to `events`.
+     */
+    static void recordVal(JsonEvents& events, const JsonEvent::Kind kind,
+                          const ParsedJsonVal& val)
+    {
+        events.emplace_back(kind, val);
+
+        if (val.kind == JsonValKind::Str) {
+            events.back().str = *val.strVal;
+        }
+
+        events.back().val.strVal = nullptr;
+    }
+
+    /*
+     * Replays `events` to `handlerStack`.
+     */
+    static void replay(JsonEvents& events, JsonValHandlerStack& handlerStack)
+    {
+        for (auto& event : events) {
+            switch (event.kind) {
+            case JsonEvent::Kind::Key:
+                handlerStack.onKey(event.str);
+                break;
+
+            case JsonEvent::Kind::Scalar:
+                if (event.val.kind == JsonValKind::Str) {
+                    event.val.strVal = &event.str;
+                }
+
+                handlerStack.onScalar(event.val);
+                break;
+
+            case JsonEvent::Kind::CompoundBegin:
+                handlerStack.onCompoundBegin(event.val);
+                break;
+
+            case JsonEvent::Kind::CompoundEnd:
+                handlerStack.onCompoundEnd();
+                break;
+
+            default:
+                std::abort();
+            }
+        }
+    }
+
+private:
+    JsonEvents *_events;
+};
+
+/*
+ * Handler of a JSON object of which the `type` property selects the
+ * specific handler of its properties.
+ *
+ * If the value of the `type` property is known in advance (see
+ * objTypeHints()), then this handler creates the specific handler with
+ * _createSpecHandler() immediately.
+ *
+ * Otherwise, until it gets the `type` property, this handler records
+ * the other properties; it then creates the specific handler and
+ * replays them to it. This makes the order of the properties
+ * irrelevant.
+ */
+class TypedObjValHandler :
+    public JsonValHandler
+{
+protected:
+    /*
+     * `val` is the beginning of the JSON object, `types` the set of
+     * valid types, and `ctxMsg` the message to append to an error
+     * regarding the `type` property.
+     */
+    explicit TypedObjValHandler(ParsingCtx& ctx, const ParsedJsonVal& val,
+                                const std::set<std::string>& types, const char * const ctxMsg) :
+        JsonValHandler {ctx, val.loc},
+        _types {&types},
+        _ctxMsg {ctxMsg},
+        _typeHintBegin {val.objTypeBegin},
+        _typeHintEnd {val.objTypeEnd}
+    {
+    }
+
+public:
+    void onKey(const std::string& key) override
+    {
+        if (_typeHintBegin) {
+            this->_setTypeFromHint();
+        }
+
+        if (_specHandler) {
+            _specHandler->onKey(key);
+        } else if (!_typeExc) {
+            if (key == strs::type) {
+                _nextValIsType = true;
+            } else {
+                _events.emplace_back(JsonEvent::Kind::Key, ParsedJsonVal {JsonValKind::Null, _loc});
+                _events.back().str = key;
+            }
+        }
+    }
+
+    void onScalar(const ParsedJsonVal& val) override
+    {
+        if (_specHandler) {
+            _specHandler->onScalar(val);
+        } else if (!_typeExc) {
+            if (_nextValIsType) {
+                this->_setType(val);
+            } else {
+                JsonValRecorder::recordVal(_events, JsonEvent::Kind::Scalar, val);
+            }
+        }
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal& val) override
+    {
+        if (_specHandler) {
+            return _specHandler->onCompoundBegin(val);
+        } else if (_typeExc) {
+            return nullptr;
+        }
+
+        if (_nextValIsType) {
+            // invalid anyway
+            this->_setType(val);
+            return nullptr;
+        }
+
+        JsonValRecorder::recordVal(_events, JsonEvent::Kind::CompoundBegin, val);
+        return std::make_unique<JsonValRecorder>(*_ctx, val.loc, _events);
+    }
+
+    void onCompoundEnd(JsonValHandler& child) override
+    {
+        // ignore the end of a recorded value
+        if (_specHandler) {
+            _specHandler->onCompoundEnd(child);
+        }
+    }
+
+    void onCompoundError(TextParseError& exc, const TextLocation& loc) override
+    {
+        assert(_specHandler);
+        _specHandler->onCompoundError(exc, loc);
+    }
+
+    void onEnd() override
+    {
+        if (_typeExc) {
+            std::rethrow_exception(_typeExc);
+        }
+
+        if (!_specHandler) {
+            std::ostringstream ss;
+
+            ss << "Missing mandatory object property `" << strs::type << "`.";
+            std::rethrow_exception(withAppendedMsg(createTextParseError(ss.str(), _loc),
+                                                   _ctxMsg, _loc));
+        }
+
+        _specHandler->onEnd();
+        this->_takeErectExc(*_specHandler);
+    }
+
+protected:
+    /*
+     * Creates the specific handler for the type `type`, which is an
+     * element of the set of valid types.
+     */
+    virtual Up _createSpecHandler(const std::string& type) = 0;
+
+    JsonValHandler& _specHandlerRef() const noexcept
+    {
+        assert(_specHandler);
+        return *_specHandler;
+    }
+
+private:
+    /*
+     * Creates the specific handler from the `type` property value
+     * which the JSON object contains, known in advance, if it's a
+     * valid type.
+     *
+     * Otherwise, _setType() handles the `type` property as usual.
+     */
+    void _setTypeFromHint()
+    {
+        const auto it = _types->find(std::string {_typeHintBegin, _typeHintEnd});
+
+        _typeHintBegin = nullptr;
+
+        if (it != _types->end()) {
+            _specHandler = this->_createSpecHandler(*it);
+        }
+    }
+
+    void _setType(const ParsedJsonVal& val)
+    {
+        _nextValIsType = false;
+
+        try {
+            auto& type = strInSetOfVal(val, *_types);
+
+            _specHandler = this->_createSpecHandler(type);
+        } catch (TextParseError& exc) {
+            std::ostringstream ss;
+
+            ss << "In object property `" << strs::type << "`:";
+            appendMsgToTextParseError(exc, ss.str(), val.loc);
+            appendMsgToTextParseError(exc, _ctxMsg, _loc);
+            _typeExc = std::current_exception();
+            return;
+        }
+
+        // replay the properties preceding the `type` property
+        if (!_events.empty()) {
+            JsonValHandlerStack handlerStack {*_specHandler};
+
+            JsonValRecorder::replay(_events, handlerStack);
+            _events.clear();
+        }
+
+        // feed the `type` property
+        static const std::string typeKey {strs::type};
+
+        _specHandler->onKey(typeKey);
+        _specHandler->onScalar(val);
+    }
+
+private:
+    const std::set<std::string> *_types;
+    const char *_ctxMsg;
+
+    // raw value of the `type` property, if known in advance and not used yet
+    const char *_typeHintBegin;
+    const char *_typeHintEnd;
+
+    bool _nextValIsType = false;
+    JsonEvents _events;
+    std::exception_ptr _typeExc;
+    Up _specHandler;
+};
+
+/*
+ * Handler of a CTF 2 JSON full data type object.
+ */
+class AnyDtValHandler final :
+    public TypedObjValHandler
+{
+public:
+    explicit AnyDtValHandler(ParsingCtx& ctx, const ParsedJsonVal& val) :
+        TypedObjValHandler {ctx, val, AnyDtValHandler::_typeStrs(),
+                            "Invalid data type:"}
+    {
+    }
+
+    /*
+     * Returns the erected pseudo data type, or `nullptr` if the
+     * handler can't erect it.
+     */
+    PseudoDt::Up releasePseudoDt() const;
+
+private:
+    static const std::set<std::string>& _typeStrs()
+    {
+        static const std::set<std::string> typeStrs {
+            strs::flBitArray,
+            strs::flBitMap,
+            strs::flBool,
+            strs::flUInt,
+            strs::flSInt,
+            strs::flFloat,
+            strs::vlUInt,
+            strs::vlSInt,
+            strs::ntStr,
+            strs::slStr,
+            strs::dlStr,
+            strs::slBlob,
+            strs::dlBlob,
+            strs::structure,
+            strs::slArray,
+            strs::dlArray,
+            strs::opt,
+            strs::var,
+        };
+
+        return typeStrs;
+    }
+
+    Up _createSpecHandler(const std::string& type) override;
+};
+
+/*
+ * Handler of a CTF 2 JSON structure member type object.
+ */
+class StructMemberTypeValHandler final :
+    public JsonObjValHandler
+{
+public:
+    explicit StructMemberTypeValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonObjValHandler {ctx, std::move(loc), &StructMemberTypeValHandler::_propReqTable()}
+    {
+    }
+
+    const std::string& name() const noexcept
+    {
+        return _name;
+    }
+
+    const TextLocation& nameLoc() const noexcept
+    {
+        return _nameLoc;
+    }
+
+    PseudoNamedDt::Up releasePseudoMemberType()
+    {
+        return std::move(_pseudoMemberType);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createPropReqTable({
+            {strs::name, true},
+            {strs::fc, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        }, {});
+
+        return table;
+    }
+
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::name) {
+            _name = strOfVal(val);
+            _nameLoc = val.loc;
+        } else if (prop == strs::fc) {
+            _pseudoDt = this->_aliasedPseudoDt(val, _erectExc);
+        } else {
+            assert(prop == strs::attrs || prop == strs::ext);
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        }
+    }
+
+    Up _onCompoundPropBegin(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::fc) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<AnyDtValHandler>(*_ctx, val);
+        } else if (prop == strs::attrs) {
+            return this->_createAttrsHandler(val);
+        } else if (prop == strs::ext) {
+            return this->_createExtHandler(val);
+        }
+
+        return JsonObjValHandler::_onCompoundPropBegin(val);
+    }
+
+    void _onCompoundPropEnd(JsonValHandler& child) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::fc) {
+            _pseudoDt = static_cast<AnyDtValHandler&>(child).releasePseudoDt();
+            this->_takeErectExc(child);
+        } else if (prop == strs::attrs) {
+            _attrs = static_cast<ItemValHandler&>(child).releaseMapItem();
+        }
+    }
+
+    void _onEnd() override
+    {
+        if (_erectExc) {
+            std::ostringstream ss;
+
+            ss << "In structure member type `" << _name << "`:";
+            _erectExc = withAppendedMsg(_erectExc, ss.str(), _loc);
+        }
+
+        if (!this->_canErect()) {
+            return;
+        }
+
+        _pseudoMemberType = std::make_unique<PseudoNamedDt>(_name, std::move(_pseudoDt),
+                                                            _attrs ? std::move(_attrs) :
+                                                            createItem(MapItem::Container {}));
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid structure member type:", _loc);
+    }
+
+private:
+    std::string _name;
+    TextLocation _nameLoc;
+    PseudoDt::Up _pseudoDt;
+    MapItem::Up _attrs;
+    PseudoNamedDt::Up _pseudoMemberType;
+};
+
+/*
+ * Handler of the member type array of a CTF 2 JSON structure type.
+ */
+class StructMemberTypesValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    explicit StructMemberTypesValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonArrayValHandler {ctx, std::move(loc)}
+    {
+    }
+
+    PseudoNamedDts& pseudoMemberTypes() noexcept
+    {
+        return _pseudoMemberTypes;
+    }
+
+    /*
+     * First duplicate member type name and its location, if any.
+     */
+    const boost::optional<std::pair<std::string, TextLocation>>& dupName() const noexcept
+    {
+        return _dupName;
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        throwExpectingKind(JsonValKind::Obj, val.loc);
+    }
+
+    Up _onCompoundElemBegin(const ParsedJsonVal& val) override
+    {
+        expectKind(val, JsonValKind::Obj);
+        return std::make_unique<StructMemberTypeValHandler>(*_ctx, val.loc);
+    }
+
+    void _onCompoundElemEnd(JsonValHandler& child) override
+    {
+        auto& memberTypeHandler = static_cast<StructMemberTypeValHandler&>(child);
+
+        if (!_names.insert(memberTypeHandler.name()).second && !_dupName) {
+            _dupName = std::make_pair(memberTypeHandler.name(), memberTypeHandler.nameLoc());
+        }
+
+        this->_takeErectExc(child);
+
+        if (this->_canErect()) {
+            _pseudoMemberTypes.push_back(memberTypeHandler.releasePseudoMemberType());
+        }
+    }
+
+private:
+    PseudoNamedDts _pseudoMemberTypes;
+    std::unordered_set<std::string> _names;
+    boost::optional<std::pair<std::string, TextLocation>> _dupName;
+};
+
+/*
+ * Handler of a CTF 2 JSON variant type option object.
+ */
+class VarTypeOptValHandler final :
+    public JsonObjValHandler
+{
+public:
+    explicit VarTypeOptValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonObjValHandler {ctx, std::move(loc), &VarTypeOptValHandler::_propReqTable()}
+    {
+    }
+
+    const boost::optional<std::string>& name() const noexcept
+    {
+        return _name;
+    }
+
+    const TextLocation& nameLoc() const noexcept
+    {
+        return _nameLoc;
+    }
+
+    PseudoNamedDt::Up releasePseudoOpt()
+    {
+        return std::move(_pseudoOpt);
+    }
+
+    PseudoVarWithIntRangesType::RangeSets::value_type releaseSelRanges()
+    {
+        return std::move(*_selRanges);
+    }
+
+private:
+    using _tSelRangeSetValHandler = IntRangeSetValHandler<PseudoVarWithIntRangesType::RangeSets::value_type>;
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createPropReqTable({
+            {strs::name, false},
+            {strs::fc, true},
+            {strs::selFieldRanges, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        }, {});
+
+        return table;
+    }
+
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::name) {
+            _name = strOfVal(val);
+            _nameLoc = val.loc;
+        } else if (prop == strs::fc) {
+            _pseudoDt = this->_aliasedPseudoDt(val, _erectExc);
+        } else if (prop == strs::selFieldRanges) {
+            throwExpectingKind(JsonValKind::Array, val.loc);
+        } else {
+            assert(prop == strs::attrs || prop == strs::ext);
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        }
+    }
+
+    Up _onCompoundPropBegin(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::fc) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<AnyDtValHandler>(*_ctx, val);
+        } else if (prop == strs::selFieldRanges) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<_tSelRangeSetValHandler>(*_ctx, val.loc, IntRangeKind::Int);
+        } else if (prop == strs::attrs) {
+            return this->_createAttrsHandler(val);
+        } else if (prop == strs::ext) {
+            return this->_createExtHandler(val);
+        }
+
+        return JsonObjValHandler::_onCompoundPropBegin(val);
+    }
+
+    void _onCompoundPropEnd(JsonValHandler& child) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::fc) {
+            _pseudoDt = static_cast<AnyDtValHandler&>(child).releasePseudoDt();
+            this->_takeErectExc(child);
+        } else if (prop == strs::selFieldRanges) {
+            _selRanges = static_cast<_tSelRangeSetValHandler&>(child).releaseRangeSet();
+        } else if (prop == strs::attrs) {
+            _attrs = static_cast<ItemValHandler&>(child).releaseMapItem();
+        }
+    }
+
+    void _onEnd() override
+    {
+        if (!this->_canErect()) {
+            return;
+        }
+
+        _pseudoOpt = std::make_unique<PseudoNamedDt>(_name, std::move(_pseudoDt),
+                                                     _attrs ? std::move(_attrs) :
+                                                     createItem(MapItem::Container {}));
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        /*
+         * Not checking for integer range overlaps here because we don't
+         * know the signedness of those ranges yet (depends on the
+         * effective selector type(s)).
+         *
+         * This will be easier to do once we know the signedness,
+         * comparing only integers having the same type.
+         */
+        appendMsgToTextParseError(exc, "Invalid variant type option:", _loc);
+    }
+
+private:
+    boost::optional<std::string> _name;
+    TextLocation _nameLoc;
+    PseudoDt::Up _pseudoDt;
+    boost::optional<PseudoVarWithIntRangesType::RangeSets::value_type> _selRanges;
+    MapItem::Up _attrs;
+    PseudoNamedDt::Up _pseudoOpt;
+};
+
+/*
+ * Handler of the option array of a CTF 2 JSON variant type.
+ */
+class VarTypeOptsValHandler final :
+    public JsonArrayValHandler
+{
+public:
+    explicit VarTypeOptsValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonArrayValHandler {ctx, std::move(loc), 1}
+    {
+    }
+
+    PseudoNamedDts& pseudoOpts() noexcept
+    {
+        return _pseudoOpts;
+    }
+
+    PseudoVarWithIntRangesType::RangeSets& selRangeSets() noexcept
+    {
+        return _selRangeSets;
+    }
+
+    /*
+     * First duplicate option name and its location, if any.
+     */
+    const boost::optional<std::pair<std::string, TextLocation>>& dupName() const noexcept
+    {
+        return _dupName;
+    }
+
+private:
+    void _onScalarElem(const ParsedJsonVal& val) override
+    {
+        throwExpectingKind(JsonValKind::Obj, val.loc);
+    }
+
+    Up _onCompoundElemBegin(const ParsedJsonVal& val) override
+    {
+        expectKind(val, JsonValKind::Obj);
+        return std::make_unique<VarTypeOptValHandler>(*_ctx, val.loc);
+    }
+
+    void _onCompoundElemEnd(JsonValHandler& child) override
+    {
+        auto& optHandler = static_cast<VarTypeOptValHandler&>(child);
+
+        if (optHandler.name() && !_names.insert(*optHandler.name()).second && !_dupName) {
+            _dupName = std::make_pair(*optHandler.name(), optHandler.nameLoc());
+        }
+
+        if (!_erectExc && optHandler.erectExc()) {
+            std::ostringstream ss;
+
+            ss << "In variant type option #" << this->_elemNumber() << ":";
+            _erectExc = withAppendedMsg(optHandler.erectExc(), ss.str(), optHandler.loc());
+        }
+
+        if (this->_canErect()) {
+            _pseudoOpts.push_back(optHandler.releasePseudoOpt());
+            _selRangeSets.push_back(optHandler.releaseSelRanges());
+        }
+    }
+
+private:
+    PseudoNamedDts _pseudoOpts;
+    PseudoVarWithIntRangesType::RangeSets _selRangeSets;
+    std::unordered_set<std::string> _names;
+    boost::optional<std::pair<std::string, TextLocation>> _dupName;
+};
+
+/*
+ * Returns the property requirement table of the CTF 2 JSON data type
+ * object of which the type is `type`.
+ */
+const PropReqTable& dtPropReqTable(const char * const type)
+{
+    if (type == strs::flBitArray || type == strs::flBool || type == strs::flFloat) {
+        static const auto table = createPropReqTable({}, {
+            {strs::len, true},
+            {strs::bo, true},
+            {strs::bio, false},
+            {strs::align, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::flBitMap) {
+        static const auto table = createPropReqTable({
+            {strs::flags, true},
+        }, {
+            {strs::len, true},
+            {strs::bo, true},
+            {strs::bio, false},
+            {strs::align, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::flUInt) {
+        static const auto table = createPropReqTable({
+            {strs::roles, false},
+            {strs::mappings, false},
+        }, {
+            {strs::prefDispBase, false},
+            {strs::len, true},
+            {strs::bo, true},
+            {strs::bio, false},
+            {strs::align, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::flSInt) {
+        static const auto table = createPropReqTable({
+            {strs::mappings, false},
+        }, {
+            {strs::prefDispBase, false},
+            {strs::len, true},
+            {strs::bo, true},
+            {strs::bio, false},
+            {strs::align, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::vlUInt) {
+        static const auto table = createPropReqTable({
+            {strs::roles, false},
+            {strs::mappings, false},
+        }, {
+            {strs::prefDispBase, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::vlSInt) {
+        static const auto table = createPropReqTable({
+            {strs::mappings, false},
+        }, {
+            {strs::prefDispBase, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::ntStr) {
+        static const auto table = createPropReqTable({}, {
+            {strs::encoding, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::slStr) {
+        static const auto table = createPropReqTable({
+            {strs::len, true},
+        }, {
+            {strs::encoding, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::dlStr) {
+        static const auto table = createPropReqTable({
+            {strs::lenFieldLoc, true},
+        }, {
+            {strs::encoding, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::slBlob) {
+        static const auto table = createPropReqTable({}, {
+            {strs::len, true},
+            {strs::roles, false},
+            {strs::mediaType, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::dlBlob) {
+        static const auto table = createPropReqTable({
+            {strs::lenFieldLoc, true},
+        }, {
+            {strs::mediaType, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::structure) {
+        static const auto table = createPropReqTable({
+            {strs::memberClss, false},
+            {strs::minAlign, false},
+        }, {
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::slArray) {
+        static const auto table = createPropReqTable({
+            {strs::len, true},
+        }, {
+            {strs::elemFc, true},
+            {strs::minAlign, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::dlArray) {
+        static const auto table = createPropReqTable({
+            {strs::lenFieldLoc, true},
+        }, {
+            {strs::elemFc, true},
+            {strs::minAlign, false},
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else if (type == strs::opt) {
+        static const auto table = createPropReqTable({
+            {strs::fc, true},
+            {strs::selFieldLoc, true},
+            {strs::selFieldRanges, false},
+        }, {
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    } else {
+        assert(type == strs::var);
+
+        static const auto table = createPropReqTable({
+            {strs::opts, true},
+            {strs::selFieldLoc, true},
+        }, {
+            {strs::type, true},
+            {strs::attrs, false},
+            {strs::ext, false},
+        });
+
+        return table;
+    }
+}
+
+/*
+ * Handler of a CTF 2 JSON data type object of a given type.
+ */
+class DtValHandler final :
+    public JsonObjValHandler
+{
+private:
+    using _tUIntMappings = FixedLengthUnsignedIntegerType::Mappings;
+    using _tSIntMappings = FixedLengthSignedIntegerType::Mappings;
+    using _tSelRangeSet = PseudoOptWithIntSelType::RangeSet;
+
+public:
+    /*
+     * `type` is one of the `strs` data type strings.
+     */
+    explicit DtValHandler(ParsingCtx& ctx, TextLocation loc, const char * const type) :
+        JsonObjValHandler {ctx, std::move(loc), &dtPropReqTable(type)},
+        _type {type}
+    {
+    }
+
+    PseudoDt::Up releasePseudoDt() noexcept
+    {
+        return std::move(_pseudoDt);
+    }
+
+private:
+    bool _isFlBitArrayType() const noexcept
+    {
+        return _type == strs::flBitArray || _type == strs::flBitMap || _type == strs::flBool ||
+               _type == strs::flUInt || _type == strs::flSInt || _type == strs::flFloat;
+    }
+
+    bool _isUIntType() const noexcept
+    {
+        return _type == strs::flUInt || _type == strs::vlUInt;
+    }
+
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::type) {
+            // already validated by `AnyDtValHandler`
+            return;
+        } else if (prop == strs::len) {
+            _len = this->_isFlBitArrayType() ? uIntInRangeOfVal(val, 1, 64) : uIntOfVal(val);
+            _lenLoc = val.loc;
+        } else if (prop == strs::bo) {
+            _bo = boOfVal(val);
+        } else if (prop == strs::bio) {
+            _bio = bioOfVal(val);
+        } else if (prop == strs::align) {
+            _align = alignOfVal(val);
+        } else if (prop == strs::minAlign) {
+            _minAlign = alignOfVal(val);
+        } else if (prop == strs::prefDispBase) {
+            static const std::set<unsigned long long> prefDispBases {2, 8, 10, 16};
+
+            _prefDispBase = static_cast<DisplayBase>(uIntInSetOfVal(val, prefDispBases));
+        } else if (prop == strs::encoding) {
+            _encoding = strEncodingOfVal(val);
+        } else if (prop == strs::mediaType) {
+            _mediaType = strOfVal(val);
+        } else if (prop == strs::elemFc || prop == strs::fc) {
+            _pseudoInnerDt = this->_aliasedPseudoDt(val, _erectExc);
+        } else if (prop == strs::roles || prop == strs::selFieldRanges ||
+                prop == strs::memberClss || prop == strs::opts) {
+            throwExpectingKind(JsonValKind::Array, val.loc);
+        } else {
+            assert(prop == strs::attrs || prop == strs::ext || prop == strs::mappings ||
+                   prop == strs::flags || prop == strs::lenFieldLoc ||
+                   prop == strs::selFieldLoc);
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        }
+    }
+
+    Up _onCompoundPropBegin(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::attrs) {
+            return this->_createAttrsHandler(val);
+        } else if (prop == strs::ext) {
+            return this->_createExtHandler(val);
+        } else if (prop == strs::mappings) {
+            expectKind(val, JsonValKind::Obj);
+
+            if (this->_isUIntType()) {
+                return std::make_unique<IntTypeMappingsValHandler<_tUIntMappings>>(*_ctx, val.loc,
+                                                                                   IntRangeKind::UInt,
+                                                                                   "mapping",
+                                                                                   "integer type mappings");
+            } else {
+                return std::make_unique<IntTypeMappingsValHandler<_tSIntMappings>>(*_ctx, val.loc,
+                                                                                   IntRangeKind::SInt,
+                                                                                   "mapping",
+                                                                                   "integer type mappings");
+            }
+        } else if (prop == strs::flags) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<IntTypeMappingsValHandler<FixedLengthBitMapType::Flags>>(*_ctx, val.loc,
+                                                                                             IntRangeKind::UInt,
+                                                                                             "flag",
+                                                                                             "fixed-length bit map type flags",
+                                                                                             false);
+        } else if (prop == strs::roles) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<RolesValHandler>(*_ctx, val.loc, this->_isUIntType());
+        } else if (prop == strs::lenFieldLoc || prop == strs::selFieldLoc) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<DataLocValHandler>(*_ctx, val.loc);
+        } else if (prop == strs::selFieldRanges) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<IntRangeSetValHandler<_tSelRangeSet>>(*_ctx, val.loc,
+                                                                          IntRangeKind::Int);
+        } else if (prop == strs::elemFc || prop == strs::fc) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<AnyDtValHandler>(*_ctx, val);
+        } else if (prop == strs::memberClss) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<StructMemberTypesValHandler>(*_ctx, val.loc);
+        } else if (prop == strs::opts) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<VarTypeOptsValHandler>(*_ctx, val.loc);
+        }
+
+        return JsonObjValHandler::_onCompoundPropBegin(val);
+    }
+
+    void _onCompoundPropEnd(JsonValHandler& child) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::attrs) {
+            _attrs = static_cast<ItemValHandler&>(child).releaseMapItem();
+        } else if (prop == strs::mappings) {
+            if (this->_isUIntType()) {
+                _uIntMappings = static_cast<IntTypeMappingsValHandler<_tUIntMappings>&>(child).releaseMappings();
+            } else {
+                _sIntMappings = static_cast<IntTypeMappingsValHandler<_tSIntMappings>&>(child).releaseMappings();
+            }
+        } else if (prop == strs::flags) {
+            _flags = static_cast<IntTypeMappingsValHandler<FixedLengthBitMapType::Flags>&>(child).releaseMappings();
+        } else if (prop == strs::roles) {
+            auto& rolesHandler = static_cast<RolesValHandler&>(child);
+
+            _roles = std::move(rolesHandler.roles());
+            _hasRoles = !rolesHandler.isEmpty();
+        } else if (prop == strs::lenFieldLoc || prop == strs::selFieldLoc) {
+            _pseudoDataLoc = static_cast<DataLocValHandler&>(child).releaseDataLoc();
+        } else if (prop == strs::selFieldRanges) {
+            _selRanges = static_cast<IntRangeSetValHandler<_tSelRangeSet>&>(child).releaseRangeSet();
+        } else if (prop == strs::elemFc || prop == strs::fc) {
+            _pseudoInnerDt = static_cast<AnyDtValHandler&>(child).releasePseudoDt();
+            this->_takeErectExc(child);
+        } else if (prop == strs::memberClss) {
+            auto& memberTypesHandler = static_cast<StructMemberTypesValHandler&>(child);
+
+            _pseudoNamedDts = std::move(memberTypesHandler.pseudoMemberTypes());
+            _dupName = memberTypesHandler.dupName();
+            this->_takeErectExc(child);
+        } else if (prop == strs::opts) {
+            auto& optsHandler = static_cast<VarTypeOptsValHandler&>(child);
+
+            _pseudoNamedDts = std::move(optsHandler.pseudoOpts());
+            _selRangeSets = std::move(optsHandler.selRangeSets());
+            _dupName = optsHandler.dupName();
+            this->_takeErectExc(child);
+        }
+    }
+
+    void _onEnd() override
+    {
+        if (_type == strs::flFloat && _len != 32 && _len != 64) {
+            std::ostringstream ss;
+
+            ss << "Unexpected length " << _len << ": yactfr only supports 32 and 64.";
+            throwTextParseError(ss.str(), _lenLoc);
+        }
+
+        if (_dupName) {
+            std::ostringstream ss;
+
+            ss << "Duplicate " <<
+                  (_type == strs::structure ? "structure member type" : "variant type option") <<
+                  " name `" << _dupName->first << "`.";
+            throwTextParseError(ss.str(), _dupName->second);
+        }
+
+        if (_erectExc) {
+            if (_type == strs::slArray || _type == strs::dlArray) {
+                _erectExc = withAppendedMsg(_erectExc, "In array type:", _loc);
+            } else if (_type == strs::opt) {
+                _erectExc = withAppendedMsg(_erectExc, "In optional type:", _loc);
+            }
+        }
+
+        if (this->_canErect()) {
+            _pseudoDt = this->_createPseudoDt(_attrs ? std::move(_attrs) :
+                                              createItem(MapItem::Container {}));
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        if (_type == strs::flBitArray) {
+            appendMsgToTextParseError(exc, "Invalid fixed-length bit array type:", _loc);
+        } else if (_type == strs::flBitMap) {
+            appendMsgToTextParseError(exc, "Invalid fixed-length bit map type:", _loc);
+        } else if (_type == strs::flBool) {
+            appendMsgToTextParseError(exc, "Invalid fixed-length boolean type:", _loc);
+        } else if (_type == strs::flUInt) {
+            appendMsgToTextParseError(exc, "Invalid fixed-length bit array type:", _loc);
+            appendMsgToTextParseError(exc, "Invalid fixed-length unsigned integer type:", _loc);
+        } else if (_type == strs::flSInt) {
+            appendMsgToTextParseError(exc, "Invalid fixed-length bit array type:", _loc);
+            appendMsgToTextParseError(exc, "Invalid fixed-length signed integer type:", _loc);
+        } else if (_type == strs::flFloat) {
+            appendMsgToTextParseError(exc, "Invalid fixed-length floating-point number type:",
+                                      _loc);
+        } else if (_type == strs::vlUInt) {
+            appendMsgToTextParseError(exc, "Invalid variable-length unsigned integer type:",
+                                      _loc);
+        } else if (_type == strs::vlSInt) {
+            appendMsgToTextParseError(exc, "Invalid variable-length signed integer type:", _loc);
+        } else if (_type == strs::ntStr) {
+            appendMsgToTextParseError(exc, "Invalid null-terminated string type:", _loc);
+        } else if (_type == strs::slStr) {
+            appendMsgToTextParseError(exc, "Invalid static-length string type:", _loc);
+        } else if (_type == strs::dlStr) {
+            appendMsgToTextParseError(exc, "Invalid dynamic-length string type:", _loc);
+        } else if (_type == strs::slBlob) {
+            appendMsgToTextParseError(exc, "Invalid static-length BLOB type:", _loc);
+        } else if (_type == strs::dlBlob) {
+            appendMsgToTextParseError(exc, "Invalid dynamic-length BLOB type:", _loc);
+        } else if (_type == strs::structure) {
+            appendMsgToTextParseError(exc, "Invalid structure type:", _loc);
+        } else if (_type == strs::slArray) {
+            appendMsgToTextParseError(exc, "Invalid static-length array type:", _loc);
+        } else if (_type == strs::dlArray) {
+            appendMsgToTextParseError(exc, "Invalid dynamic-length array type:", _loc);
+        } else if (_type == strs::opt) {
+            appendMsgToTextParseError(exc, "Invalid optional type:", _loc);
+        } else {
+            assert(_type == strs::var);
+            appendMsgToTextParseError(exc, "Invalid variant type:", _loc);
+        }
+    }
+
+    template <typename DtT, typename... ArgTs>
+    PseudoDt::Up _createPseudoScalarDtWrapper(ArgTs&&... args) const
+    {
+        return std::make_unique<PseudoScalarDtWrapper>(
+            std::make_unique<const DtT>(std::forward<ArgTs>(args)...), _loc
+        );
+    }
+
+    PseudoDt::Up _createPseudoDt(MapItem::Up attrs)
+    {
+        if (this->_isFlBitArrayType()) {
+            return this->_createPseudoFlBitArrayType(std::move(attrs));
+        } else if (_type == strs::vlUInt) {
+            return this->_createPseudoScalarDtWrapper<VariableLengthUnsignedIntegerType>(
+                _prefDispBase, std::move(_uIntMappings), std::move(attrs), std::move(_roles)
+            );
+        } else if (_type == strs::vlSInt) {
+            return this->_createPseudoScalarDtWrapper<VariableLengthSignedIntegerType>(
+                _prefDispBase, std::move(_sIntMappings), std::move(attrs)
+            );
+        } else if (_type == strs::ntStr) {
+            return this->_createPseudoScalarDtWrapper<NullTerminatedStringType>(_encoding,
+                                                                                std::move(attrs));
+        } else if (_type == strs::slStr) {
+            return this->_createPseudoScalarDtWrapper<StaticLengthStringType>(_len, _encoding,
+                                                                              std::move(attrs));
+        } else if (_type == strs::dlStr) {
+            /*
+             * Returning a pseudo dynamic-length array type having a
+             * pseudo fixed-length unsigned integer type with an encoding
+             * for a dynamic-length string type to accomodate the common
+             * pseudo type API which also serves the CTF 1.8 use case.
+             *
+             * dtFromPseudoRootDt() will convert this pseudo
+             * dynamic-length array type to a `DynamicLengthStringType`
+             * instance.
+             */
+            return std::make_unique<PseudoDlArrayType>(
+                std::move(*_pseudoDataLoc),
+                std::make_unique<PseudoFlUIntType>(8, 8, ByteOrder::Big, BitOrder::LastToFirst,
+                                                   DisplayBase::Decimal,
+                                                   FixedLengthUnsignedIntegerType::Mappings {},
+                                                   _encoding),
+                std::move(attrs), _loc
+            );
+        } else if (_type == strs::slBlob) {
+            return this->_createPseudoScalarDtWrapper<StaticLengthBlobType>(
+                _len, this->_mediaTypeStr(), std::move(attrs), _hasRoles
+            );
+        } else if (_type == strs::dlBlob) {
+            return std::make_unique<PseudoDlBlobType>(std::move(*_pseudoDataLoc),
+                                                      std::string {this->_mediaTypeStr()},
+                                                      std::move(attrs), _loc);
+        } else if (_type == strs::structure) {
+            return std::make_unique<PseudoStructType>(_minAlign, std::move(_pseudoNamedDts),
+                                                      std::move(attrs), _loc);
+        } else if (_type == strs::slArray) {
+            return std::make_unique<PseudoSlArrayType>(_minAlign, _len, std::move(_pseudoInnerDt),
+                                                       std::move(attrs), _loc);
+        } else if (_type == strs::dlArray) {
+            return std::make_unique<PseudoDlArrayType>(_minAlign, std::move(*_pseudoDataLoc),
+                                                       std::move(_pseudoInnerDt),
+                                                       std::move(attrs), _loc);
+        } else if (_type == strs::opt) {
+            // selector field ranges (presence indicates which kind of optional type)
+            if (_selRanges) {
+                return std::make_unique<PseudoOptWithIntSelType>(std::move(_pseudoInnerDt),
+                                                                 std::move(*_pseudoDataLoc),
+                                                                 std::move(*_selRanges),
+                                                                 std::move(attrs), _loc);
+            } else {
+                return std::make_unique<PseudoOptWithBoolSelType>(std::move(_pseudoInnerDt),
+                                                                  std::move(*_pseudoDataLoc),
+                                                                  std::move(attrs), _loc);
+            }
+        } else {
+            assert(_type == strs::var);
+            return std::make_unique<PseudoVarWithIntRangesType>(std::move(*_pseudoDataLoc),
+                                                                std::move(_pseudoNamedDts),
+                                                                std::move(_selRangeSets),
+                                                                std::move(attrs), _loc);
+        }
+    }
+
+    PseudoDt::Up _createPseudoFlBitArrayType(MapItem::Up attrs)
+    {
+        const auto bio = _bio ? *_bio :
+                         (_bo == ByteOrder::Big ? BitOrder::LastToFirst : BitOrder::FirstToLast);
+
+        if (_type == strs::flBitArray) {
+            return this->_createPseudoScalarDtWrapper<FixedLengthBitArrayType>(_align, _len, _bo,
+                                                                               bio,
+                                                                               std::move(attrs));
+        } else if (_type == strs::flBitMap) {
+            return this->_createPseudoScalarDtWrapper<FixedLengthBitMapType>(_align, _len, _bo,
+                                                                             std::move(_flags),
+                                                                             bio,
+                                                                             std::move(attrs));
+        } else if (_type == strs::flBool) {
+            return this->_createPseudoScalarDtWrapper<FixedLengthBooleanType>(_align, _len, _bo,
+                                                                              bio,
+                                                                              std::move(attrs));
+        } else if (_type == strs::flUInt) {
+            return this->_createPseudoScalarDtWrapper<FixedLengthUnsignedIntegerType>(
+                _align, _len, _bo, bio, _prefDispBase, std::move(_uIntMappings),
+                std::move(attrs), std::move(_roles)
+            );
+        } else if (_type == strs::flSInt) {
+            return this->_createPseudoScalarDtWrapper<FixedLengthSignedIntegerType>(
+                _align, _len, _bo, bio, _prefDispBase, std::move(_sIntMappings),
+                std::move(attrs)
+            );
+        } else {
+            assert(_type == strs::flFloat);
+            return this->_createPseudoScalarDtWrapper<FixedLengthFloatingPointNumberType>(
+                _align, _len, _bo, bio, std::move(attrs)
+            );
+        }
+    }
+
+    const char *_mediaTypeStr() const noexcept
+    {
+        return _mediaType ? _mediaType->c_str() : strs::appOctetStream;
+    }
+
+private:
+    const char *_type;
+    unsigned long long _len = 0;
+    TextLocation _lenLoc;
+    ByteOrder _bo = ByteOrder::Big;
+    boost::optional<BitOrder> _bio;
+    unsigned long long _align = 1;
+    unsigned long long _minAlign = 1;
+    DisplayBase _prefDispBase = DisplayBase::Decimal;
+    StringEncoding _encoding = StringEncoding::Utf8;
+    boost::optional<std::string> _mediaType;
+    MapItem::Up _attrs;
+    _tUIntMappings _uIntMappings;
+    _tSIntMappings _sIntMappings;
+    FixedLengthBitMapType::Flags _flags;
+    UnsignedIntegerTypeRoleSet _roles;
+    bool _hasRoles = false;
+
+    // length or selector location
+    boost::optional<PseudoDataLoc> _pseudoDataLoc;
+
+    // optional type selector field ranges
+    boost::optional<_tSelRangeSet> _selRanges;
+
+    // array element or optional data type
+    PseudoDt::Up _pseudoInnerDt;
+
+    // structure member types or variant type options
+    PseudoNamedDts _pseudoNamedDts;
+    PseudoVarWithIntRangesType::RangeSets _selRangeSets;
+    boost::optional<std::pair<std::string, TextLocation>> _dupName;
+
+    // result
+    PseudoDt::Up _pseudoDt;
+};
+
+PseudoDt::Up AnyDtValHandler::releasePseudoDt() const
+{
+    return static_cast<DtValHandler&>(this->_specHandlerRef()).releasePseudoDt();
+}
+
+JsonValHandler::Up AnyDtValHandler::_createSpecHandler(const std::string& type)
+{
+    static const char * const types[] = {
+        strs::flBitArray,
+        strs::flBitMap,
+        strs::flBool,
+        strs::flUInt,
+        strs::flSInt,
+        strs::flFloat,
+        strs::vlUInt,
+        strs::vlSInt,
+        strs::ntStr,
+        strs::slStr,
+        strs::dlStr,
+        strs::slBlob,
+        strs::dlBlob,
+        strs::structure,
+        strs::slArray,
+        strs::dlArray,
+        strs::opt,
+        strs::var,
+    };
+
+    for (const auto typeStr : types) {
+        if (type == typeStr) {
+            return std::make_unique<DtValHandler>(*_ctx, _loc, typeStr);
+        }
+    }
+
+    std::abort();
+}
+
+/*
+ * Handler of a CTF 2 JSON clock origin object.
+ */
+class ClkOrigValHandler final :
+    public JsonObjValHandler
+{
+public:
+    explicit ClkOrigValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonObjValHandler {ctx, std::move(loc), &ClkOrigValHandler::_propReqTable()}
+    {
+    }
+
+    ClockOrigin releaseOrig()
+    {
+        return ClockOrigin {std::move(_ns), std::move(_name), std::move(_uid)};
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createPropReqTable({
+            {strs::ns, false},
+            {strs::name, true},
+            {strs::uid, true},
+        }, {});
+
+        return table;
+    }
+
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::ns) {
+            _ns = strOfVal(val);
+        } else if (prop == strs::name) {
+            _name = strOfVal(val);
+        } else {
+            assert(prop == strs::uid);
+            _uid = strOfVal(val);
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        // object validation, then origin property validation
+        appendMsgToTextParseError(exc, "Invalid clock origin:", _loc);
+        appendMsgToTextParseError(exc, "Invalid clock origin:", _loc);
+    }
+
+private:
+    boost::optional<std::string> _ns;
+    std::string _name;
+    std::string _uid;
+};
+
+/*
+ * Handler of a CTF 2 JSON clock offset object.
+ */
+class ClkOffsetValHandler final :
+    public JsonObjValHandler
+{
+public:
+    explicit ClkOffsetValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonObjValHandler {ctx, std::move(loc), &ClkOffsetValHandler::_propReqTable()}
+    {
+    }
+
+    long long secs() const noexcept
+    {
+        return _secs;
+    }
+
+    const boost::optional<unsigned long long>& cycles() const noexcept
+    {
+        return _cycles;
+    }
+
+    const TextLocation& cyclesLoc() const noexcept
+    {
+        return _cyclesLoc;
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createPropReqTable({
+            {strs::secs, false},
+            {strs::cycles, false},
+        }, {});
+
+        return table;
+    }
+
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        if (this->_prop() == strs::secs) {
+            _secs = sIntOfVal(val);
+        } else {
+            assert(this->_prop() == strs::cycles);
+            _cycles = uIntOfVal(val);
+            _cyclesLoc = val.loc;
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid clock offset:", _loc);
+    }
+
+private:
+    long long _secs = 0;
+    boost::optional<unsigned long long> _cycles;
+    TextLocation _cyclesLoc;
+};
+
+/*
+ * Handler of a CTF 2 JSON trace environment object.
+ */
+class TraceEnvValHandler final :
+    public JsonObjValHandler
+{
+public:
+    explicit TraceEnvValHandler(ParsingCtx& ctx, TextLocation loc) :
+        JsonObjValHandler {ctx, std::move(loc)}
+    {
+    }
+
+    TraceEnvironment::Entries releaseEntries()
+    {
+        return std::move(_entries);
+    }
+
+private:
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        if (val.kind == JsonValKind::Str) {
+            _entries.emplace(std::make_pair(this->_key(), *val.strVal));
+        } else if (val.kind == JsonValKind::SInt || val.kind == JsonValKind::UInt) {
+            _entries.emplace(std::make_pair(this->_key(), sIntOfVal(val)));
+        } else {
+            throwTextParseError("Expecting an integer or a string.", val.loc);
+        }
+    }
+
+    void _appendPropCtx(TextParseError& exc, const TextLocation& valLoc) override
+    {
+        std::ostringstream ss;
+
+        ss << "Invalid trace environment entry `" << this->_key() << "`:";
+        appendMsgToTextParseError(exc, ss.str(), valLoc);
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, "Invalid trace environment:", _loc);
+    }
+
+private:
+    TraceEnvironment::Entries _entries;
+};
+
+/*
+ * Returns the property requirement table of a CTF 2 JSON fragment
+ * object having the specific properties `specs`.
+ */
+PropReqTable createFragPropReqTable(const PropSpecs& specs)
+{
+    return createPropReqTable(specs, {
+        {strs::type, true},
+        {strs::attrs, false},
+        {strs::ext, false},
+    });
+}
+
+/*
+ * Handler of a CTF 2 JSON fragment object of a given type.
+ */
+class FragValHandler :
+    public JsonObjValHandler
+{
+protected:
+    explicit FragValHandler(ParsingCtx& ctx, TextLocation loc, const PropReqTable& propReqTable,
+                            const char * const ctxMsg) :
+        JsonObjValHandler {ctx, std::move(loc), &propReqTable},
+        _ctxMsg {ctxMsg}
+    {
+    }
+
+public:
+    /*
+     * Returns the resulting fragment, once valid.
+     */
+    virtual Ctf2JsonFrag::Up releaseFrag() = 0;
+
+protected:
+    /*
+     * Handles the scalar value `val` of the current specific property
+     * (like _onScalarProp()).
+     */
+    virtual void _onScalarFragProp(const ParsedJsonVal& val) = 0;
+
+    /*
+     * Handles the beginning of the compound value `val` of the current
+     * specific property (like _onCompoundPropBegin()).
+     */
+    virtual Up _onCompoundFragPropBegin(const ParsedJsonVal& val)
+    {
+        // scalar property: throws
+        this->_onScalarFragProp(val);
+        std::abort();
+    }
+
+    /*
+     * Handles the end of the valid compound value of the current
+     * specific property (like _onCompoundPropEnd()).
+     */
+    virtual void _onCompoundFragPropEnd(JsonValHandler&)
+    {
+    }
+
+    /*
+     * Returns the data type property named `prop` of the resulting
+     * fragment, or `nullptr` if `prop` isn't a data type property.
+     */
+    virtual Ctf2JsonFragDtProp *_dtProp(const char *)
+    {
+        return nullptr;
+    }
+
+    /*
+     * Releases the attributes of the fragment.
+     */
+    MapItem::Up _releaseAttrs()
+    {
+        return _attrs ? std::move(_attrs) : createItem(MapItem::Container {});
+    }
+
+private:
+    void _onScalarProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::type) {
+            // already validated by `AnyFragValHandler`
+            return;
+        } else if (prop == strs::attrs || prop == strs::ext) {
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        } else if (const auto dtProp = this->_dtProp(prop)) {
+            dtProp->pseudoDt = this->_aliasedPseudoDt(val, dtProp->exc);
+        } else {
+            this->_onScalarFragProp(val);
+        }
+    }
+
+    Up _onCompoundPropBegin(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::attrs) {
+            return this->_createAttrsHandler(val);
+        } else if (prop == strs::ext) {
+            return this->_createExtHandler(val);
+        } else if (this->_dtProp(prop)) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<AnyDtValHandler>(*_ctx, val);
+        }
+
+        return this->_onCompoundFragPropBegin(val);
+    }
+
+    void _onCompoundPropEnd(JsonValHandler& child) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::attrs) {
+            _attrs = static_cast<ItemValHandler&>(child).releaseMapItem();
+        } else if (const auto dtProp = this->_dtProp(prop)) {
+            dtProp->pseudoDt = static_cast<AnyDtValHandler&>(child).releasePseudoDt();
+            dtProp->exc = child.erectExc();
+        } else if (prop != strs::ext) {
+            this->_onCompoundFragPropEnd(child);
+        }
+    }
+
+    void _appendCtx(TextParseError& exc) override
+    {
+        appendMsgToTextParseError(exc, _ctxMsg, _loc);
+    }
+
+private:
+    const char *_ctxMsg;
+    MapItem::Up _attrs;
+};
+
+/*
+ * Handler of a CTF 2 JSON preamble fragment object.
+ */
+class PreFragValHandler final :
+    public FragValHandler
+{
+public:
+    explicit PreFragValHandler(ParsingCtx& ctx, TextLocation loc) :
+        FragValHandler {ctx, loc, PreFragValHandler::_propReqTable(),
+                        "Invalid preamble fragment:"},
+        _frag {std::make_unique<Ctf2JsonPreFrag>(std::move(loc))}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() override
+    {
+        return std::move(_frag);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createFragPropReqTable({
+            {strs::version, true},
+            {strs::uuid, false},
+        });
+
+        return table;
+    }
+
+    void _onScalarFragProp(const ParsedJsonVal& val) override
+    {
+        if (this->_prop() == strs::version) {
+            static const std::set<unsigned long long> versions {2};
+
+            uIntInSetOfVal(val, versions);
+        } else {
+            assert(this->_prop() == strs::uuid);
+            throwExpectingKind(JsonValKind::Array, val.loc);
+        }
+    }
+
+    Up _onCompoundFragPropBegin(const ParsedJsonVal& val) override
+    {
+        if (this->_prop() == strs::uuid) {
+            expectKind(val, JsonValKind::Array);
+            return std::make_unique<UuidValHandler>(*_ctx, val.loc);
+        }
+
+        return FragValHandler::_onCompoundFragPropBegin(val);
+    }
+
+    void _onCompoundFragPropEnd(JsonValHandler& child) override
+    {
+        _frag->uuid = static_cast<UuidValHandler&>(child).uuid();
+    }
+
+private:
+    std::unique_ptr<Ctf2JsonPreFrag> _frag;
+};
+
+/*
+ * Handler of a CTF 2 JSON data type alias fragment object.
+ */
+class DtAliasFragValHandler final :
+    public FragValHandler
+{
+public:
+    explicit DtAliasFragValHandler(ParsingCtx& ctx, TextLocation loc) :
+        FragValHandler {ctx, loc, DtAliasFragValHandler::_propReqTable(),
+                        "Invalid data type alias fragment:"},
+        _frag {std::make_unique<Ctf2JsonDtAliasFrag>(std::move(loc))}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() override
+    {
+        return std::move(_frag);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createFragPropReqTable({
+            {strs::name, true},
+            {strs::fc, true},
+        });
+
+        return table;
+    }
+
+    void _onScalarFragProp(const ParsedJsonVal& val) override
+    {
+        assert(this->_prop() == strs::name);
+        _frag->name = strOfVal(val);
+        _frag->nameLoc = val.loc;
+    }
+
+    Ctf2JsonFragDtProp *_dtProp(const char * const prop) override
+    {
+        return prop == strs::fc ? &_frag->dt : nullptr;
+    }
+
+private:
+    std::unique_ptr<Ctf2JsonDtAliasFrag> _frag;
+};
+
+/*
+ * Handler of a CTF 2 JSON trace type fragment object.
+ */
+class TraceTypeFragValHandler final :
+    public FragValHandler
+{
+public:
+    explicit TraceTypeFragValHandler(ParsingCtx& ctx, TextLocation loc) :
+        FragValHandler {ctx, loc, TraceTypeFragValHandler::_propReqTable(),
+                        "Invalid trace type fragment:"},
+        _frag {std::make_unique<Ctf2JsonTraceTypeFrag>(std::move(loc))}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() override
+    {
+        return std::move(_frag);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createFragPropReqTable({
+            {strs::ns, false},
+            {strs::name, false},
+            {strs::uid, false},
+            {strs::pktHeaderFc, false},
+            {strs::env, false},
+        });
+
+        return table;
+    }
+
+    void _onScalarFragProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::ns) {
+            _frag->ns = strOfVal(val);
+        } else if (prop == strs::name) {
+            _frag->name = strOfVal(val);
+        } else if (prop == strs::uid) {
+            _frag->uid = strOfVal(val);
+        } else {
+            assert(prop == strs::env);
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        }
+    }
+
+    Up _onCompoundFragPropBegin(const ParsedJsonVal& val) override
+    {
+        if (this->_prop() == strs::env) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<TraceEnvValHandler>(*_ctx, val.loc);
+        }
+
+        return FragValHandler::_onCompoundFragPropBegin(val);
+    }
+
+    void _onCompoundFragPropEnd(JsonValHandler& child) override
+    {
+        _frag->envEntries = static_cast<TraceEnvValHandler&>(child).releaseEntries();
+    }
+
+    Ctf2JsonFragDtProp *_dtProp(const char * const prop) override
+    {
+        return prop == strs::pktHeaderFc ? &_frag->pktHeaderDt : nullptr;
+    }
+
+    void _onEnd() override
+    {
+        _frag->attrs = this->_releaseAttrs();
+    }
+
+private:
+    std::unique_ptr<Ctf2JsonTraceTypeFrag> _frag;
+};
+
+/*
+ * Handler of a CTF 2 JSON clock type fragment object.
+ */
+class ClkTypeFragValHandler final :
+    public FragValHandler
+{
+public:
+    explicit ClkTypeFragValHandler(ParsingCtx& ctx, TextLocation loc) :
+        FragValHandler {ctx, loc, ClkTypeFragValHandler::_propReqTable(),
+                        "Invalid clock type fragment:"},
+        _frag {std::make_unique<Ctf2JsonClkTypeFrag>(std::move(loc))}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() override
+    {
+        return std::move(_frag);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createFragPropReqTable({
+            {strs::id, true},
+            {strs::ns, false},
+            {strs::name, false},
+            {strs::uid, false},
+            {strs::freq, true},
+            {strs::descr, false},
+            {strs::orig, false},
+            {strs::offsetFromOrig, false},
+            {strs::prec, false},
+            {strs::accuracy, false},
+        });
+
+        return table;
+    }
+
+    void _onScalarFragProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::id) {
+            _id = strOfVal(val);
+        } else if (prop == strs::ns) {
+            _ns = strOfVal(val);
+        } else if (prop == strs::name) {
+            _name = strOfVal(val);
+        } else if (prop == strs::uid) {
+            _uid = strOfVal(val);
+        } else if (prop == strs::freq) {
+            _freq = uIntInRangeOfVal(val, 1, std::numeric_limits<unsigned long long>::max());
+        } else if (prop == strs::descr) {
+            _descr = strOfVal(val);
+        } else if (prop == strs::orig) {
+            this->_setOrig(val);
+        } else if (prop == strs::prec) {
+            _prec = uIntOfVal(val);
+        } else if (prop == strs::accuracy) {
+            _accuracy = uIntOfVal(val);
+        } else {
+            assert(prop == strs::offsetFromOrig);
+            throwExpectingKind(JsonValKind::Obj, val.loc);
+        }
+    }
+
+    void _setOrig(const ParsedJsonVal& val)
+    {
+        try {
+            if (val.kind == JsonValKind::Str) {
+                if (*val.strVal != strs::unixEpoch) {
+                    std::ostringstream ss;
+
+                    ss << "Expecting `" << strs::unixEpoch << "` or a clock origin object.";
+                    throwTextParseError(ss.str(), val.loc);
+                }
+
+                _orig = ClockOrigin {};
+            } else {
+                throwTextParseError("Expecting a string or an object.", val.loc);
+            }
+        } catch (TextParseError& exc) {
+            appendMsgToTextParseError(exc, "Invalid clock origin:", val.loc);
+            throw;
+        }
+    }
+
+    Up _onCompoundFragPropBegin(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::orig && val.kind == JsonValKind::Obj) {
+            return std::make_unique<ClkOrigValHandler>(*_ctx, val.loc);
+        } else if (prop == strs::offsetFromOrig) {
+            expectKind(val, JsonValKind::Obj);
+            return std::make_unique<ClkOffsetValHandler>(*_ctx, val.loc);
+        }
+
+        return FragValHandler::_onCompoundFragPropBegin(val);
+    }
+
+    void _onCompoundFragPropEnd(JsonValHandler& child) override
+    {
+        if (this->_prop() == strs::orig) {
+            _orig = static_cast<ClkOrigValHandler&>(child).releaseOrig();
+        } else {
+            assert(this->_prop() == strs::offsetFromOrig);
+
+            auto& offsetHandler = static_cast<ClkOffsetValHandler&>(child);
+
+            _offsetSecs = offsetHandler.secs();
+            _offsetCycles = offsetHandler.cycles();
+            _offsetCyclesLoc = offsetHandler.cyclesLoc();
+        }
+    }
+
+    void _onEnd() override
+    {
+        if (_offsetCycles && *_offsetCycles >= _freq) {
+            std::ostringstream ss;
+
+            ss << "Invalid `" << strs::cycles << "` property of " <<
+                  "`" << strs::offsetFromOrig << "` property: " <<
+                  "value " << *_offsetCycles << " is greater than the value of the " <<
+                  "`" << strs::freq << "` property (" << _freq << ").";
+            throwTextParseError(ss.str(), _offsetCyclesLoc);
+        }
+
+        _frag->clkType = ClockType::create(std::move(_id), std::move(_ns), std::move(_name),
+                                           std::move(_uid), boost::none, _freq,
+                                           std::move(_descr), std::move(_orig), _prec,
+                                           _accuracy,
+                                           ClockOffset {_offsetSecs, _offsetCycles ? *_offsetCycles : 0ULL},
+                                           this->_releaseAttrs());
+    }
+
+private:
+    std::unique_ptr<Ctf2JsonClkTypeFrag> _frag;
+    std::string _id;
+    boost::optional<std::string> _ns;
+    boost::optional<std::string> _name;
+    boost::optional<std::string> _uid;
+    unsigned long long _freq = 0;
+    boost::optional<std::string> _descr;
+    boost::optional<ClockOrigin> _orig;
+    long long _offsetSecs = 0;
+    boost::optional<unsigned long long> _offsetCycles;
+    TextLocation _offsetCyclesLoc;
+    boost::optional<unsigned long long> _prec;
+    boost::optional<unsigned long long> _accuracy;
+};
+
+/*
+ * Handler of a CTF 2 JSON data stream type fragment object.
+ */
+class DstFragValHandler final :
+    public FragValHandler
+{
+public:
+    explicit DstFragValHandler(ParsingCtx& ctx, TextLocation loc) :
+        FragValHandler {ctx, loc, DstFragValHandler::_propReqTable(),
+                        "Invalid data stream type fragment:"},
+        _frag {std::make_unique<Ctf2JsonDstFrag>(std::move(loc))}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() override
+    {
+        return std::move(_frag);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createFragPropReqTable({
+            {strs::ns, false},
+            {strs::name, false},
+            {strs::uid, false},
+            {strs::id, false},
+            {strs::defCcId, false},
+            {strs::pktCtxFc, false},
+            {strs::erHeaderFc, false},
+            {strs::erCommonCtxFc, false},
+        });
+
+        return table;
+    }
+
+    void _onScalarFragProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::ns) {
+            _frag->ns = strOfVal(val);
+        } else if (prop == strs::name) {
+            _frag->name = strOfVal(val);
+        } else if (prop == strs::uid) {
+            _frag->uid = strOfVal(val);
+        } else if (prop == strs::id) {
+            _frag->id = uIntOfVal(val);
+        } else {
+            assert(prop == strs::defCcId);
+            _frag->defClkTypeId = strOfVal(val);
+            _frag->defClkTypeIdLoc = val.loc;
+        }
+    }
+
+    Ctf2JsonFragDtProp *_dtProp(const char * const prop) override
+    {
+        if (prop == strs::pktCtxFc) {
+            return &_frag->pktCtxDt;
+        } else if (prop == strs::erHeaderFc) {
+            return &_frag->erHeaderDt;
+        } else if (prop == strs::erCommonCtxFc) {
+            return &_frag->erCommonCtxDt;
+        }
+
+        return nullptr;
+    }
+
+    void _onEnd() override
+    {
+        _frag->attrs = this->_releaseAttrs();
+    }
+
+private:
+    std::unique_ptr<Ctf2JsonDstFrag> _frag;
+};
+
+/*
+ * Handler of a CTF 2 JSON event record type fragment object.
+ */
+class ErtFragValHandler final :
+    public FragValHandler
+{
+public:
+    explicit ErtFragValHandler(ParsingCtx& ctx, TextLocation loc) :
+        FragValHandler {ctx, loc, ErtFragValHandler::_propReqTable(),
+                        "Invalid event record type fragment:"},
+        _frag {std::make_unique<Ctf2JsonErtFrag>(std::move(loc))}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() override
+    {
+        return std::move(_frag);
+    }
+
+private:
+    static const PropReqTable& _propReqTable()
+    {
+        static const auto table = createFragPropReqTable({
+            {strs::ns, false},
+            {strs::name, false},
+            {strs::uid, false},
+            {strs::id, false},
+            {strs::dscId, false},
+            {strs::specCtxFc, false},
+            {strs::payloadFc, false},
+        });
+
+        return table;
+    }
+
+    void _onScalarFragProp(const ParsedJsonVal& val) override
+    {
+        const auto prop = this->_prop();
+
+        if (prop == strs::ns) {
+            _frag->ns = strOfVal(val);
+        } else if (prop == strs::name) {
+            _frag->name = strOfVal(val);
+        } else if (prop == strs::uid) {
+            _frag->uid = strOfVal(val);
+        } else if (prop == strs::id) {
+            _frag->id = uIntOfVal(val);
+            _frag->idLoc = val.loc;
+        } else {
+            assert(prop == strs::dscId);
+            _frag->dstId = uIntOfVal(val);
+            _frag->dstIdLoc = val.loc;
+        }
+    }
+
+    Ctf2JsonFragDtProp *_dtProp(const char * const prop) override
+    {
+        if (prop == strs::specCtxFc) {
+            return &_frag->specCtxDt;
+        } else if (prop == strs::payloadFc) {
+            return &_frag->payloadDt;
+        }
+
+        return nullptr;
+    }
+
+    void _onEnd() override
+    {
+        _frag->attrs = this->_releaseAttrs();
+    }
+
+private:
+    std::unique_ptr<Ctf2JsonErtFrag> _frag;
+};
+
+/*
+ * Handler of a CTF 2 JSON fragment object.
+ */
+class AnyFragValHandler final :
+    public TypedObjValHandler
+{
+public:
+    explicit AnyFragValHandler(ParsingCtx& ctx, const ParsedJsonVal& val) :
+        TypedObjValHandler {ctx, val, AnyFragValHandler::_typeStrs(),
+                            "Invalid fragment:"}
+    {
+    }
+
+    Ctf2JsonFrag::Up releaseFrag() const
+    {
+        return static_cast<FragValHandler&>(this->_specHandlerRef()).releaseFrag();
+    }
+
+private:
+    static const std::set<std::string>& _typeStrs()
+    {
+        static const std::set<std::string> typeStrs {
+            strs::pre,
+            strs::fcAlias,
+            strs::tc,
+            strs::cc,
+            strs::dsc,
+            strs::erc,
+        };
+
+        return typeStrs;
+    }
+
+    Up _createSpecHandler(const std::string& type) override
+    {
+        if (type == strs::pre) {
+            return std::make_unique<PreFragValHandler>(*_ctx, _loc);
+        } else if (type == strs::fcAlias) {
+            return std::make_unique<DtAliasFragValHandler>(*_ctx, _loc);
+        } else if (type == strs::tc) {
+            return std::make_unique<TraceTypeFragValHandler>(*_ctx, _loc);
+        } else if (type == strs::cc) {
+            return std::make_unique<ClkTypeFragValHandler>(*_ctx, _loc);
+        } else if (type == strs::dsc) {
+            return std::make_unique<DstFragValHandler>(*_ctx, _loc);
+        } else {
+            assert(type == strs::erc);
+            return std::make_unique<ErtFragValHandler>(*_ctx, _loc);
+        }
+    }
+};
+
+/*
+ * Handler of the root JSON value of a fragment.
+ */
+class FragRootValHandler final :
+    public JsonValHandler
+{
+public:
+    explicit FragRootValHandler(ParsingCtx& ctx) :
+        JsonValHandler {ctx, TextLocation {}}
+    {
+    }
+
+    void onScalar(const ParsedJsonVal& val) override
+    {
+        _exc = createTextParseError("Expecting an object.", val.loc);
+    }
+
+    Up onCompoundBegin(const ParsedJsonVal& val) override
+    {
+        if (val.kind != JsonValKind::Obj) {
+            this->onScalar(val);
+            return nullptr;
+        }
+
+        return std::make_unique<AnyFragValHandler>(*_ctx, val);
+    }
+
+    void onCompoundEnd(JsonValHandler& child) override
+    {
+        _frag = static_cast<AnyFragValHandler&>(child).releaseFrag();
+    }
+
+    void onCompoundError(TextParseError&, const TextLocation&) override
+    {
+        _exc = std::current_exception();
+    }
+
+    void onEnd() override
+    {
+    }
+
+    /*
+     * Returns the resulting fragment, `nullptr` if it needs data type
+     * aliases, or throws its validation error.
+     */
+    Ctf2JsonFrag::Up releaseFrag()
+    {
+        if (_exc) {
+            std::rethrow_exception(_exc);
+        }
+
+        if (_ctx->needsAliases) {
+            return nullptr;
+        }
+
+        return std::move(_frag);
+    }
+
+private:
+    Ctf2JsonFrag::Up _frag;
+    std::exception_ptr _exc;
+};
+
+/*
+ * Raw string value of the `type` property of a JSON object, if known
+ * (`begin` isn't `nullptr`).
+ */
+struct ObjTypeHint final
+{
+    const char *begin = nullptr;
+    const char *end = nullptr;
+};
+
+/*
+ * Scans the JSON text between `begin` (included) and `end` (excluded)
+ * and returns, for each JSON object in order of beginning, the raw
+ * value of its `type` property, if it's a string without any escape
+ * sequence.
+ *
+ * This makes it possible for a `TypedObjValHandler` instance to create
+ * its specific handler immediately, whatever the position of the
+ * `type` property within its JSON object, instead of recording and
+ * replaying the preceding properties at each nesting level.
+ *
+ * This function doesn't validate anything: a JSON syntax error has
+ * precedence over any validation error anyway.
+ */
+std::vector<ObjTypeHint> objTypeHints(const char * const begin, const char * const end)
+{
+    // compound value within which the scanner currently is
+    struct Level final
+    {
+        // index of the hint of the JSON object, or `-1` for a JSON array
+        long long hintIndex;
+
+        // next string is a JSON object key
+        bool nextStrIsKey;
+
+        // last JSON object key is `type` and its value is the next token
+        bool nextValIsType;
+
+        // found a `type` key which isn't usable
+        bool hasUnusableType;
+    };
+
+    static const auto typeLen = std::strlen(strs::type);
+    std::vector<ObjTypeHint> hints;
+    std::vector<Level> levels;
+    auto at = begin;
+
+    while (at != end) {
+        const auto ch = *at;
+
+        if ((ch == '{' || ch == '[') && !levels.empty() && levels.back().nextValIsType) {
+            // compound `type` property value
+            levels.back().nextValIsType = false;
+            levels.back().hasUnusableType = true;
+        }
+
+        switch (ch) {
+        case '{':
+            levels.push_back({static_cast<long long>(hints.size()), true, false, false});
+            hints.emplace_back();
+            ++at;
+            continue;
+
+        case '[':
+            levels.push_back({-1, false, false, false});
+            ++at;
+            continue;
+
+        case '}':
+        case ']':
+            if (!levels.empty()) {
+                levels.pop_back();
+            }
+
+            ++at;
+            continue;
+
+        case ',':
+            if (!levels.empty() && levels.back().hintIndex >= 0) {
+                levels.back().nextStrIsKey = true;
+            }
+
+            ++at;
+            continue;
+
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case ':':
+            ++at;
+            continue;
+
+        default:
+            break;
+        }
+
+        // string or other scalar value
+        auto tokenBegin = at;
+        auto tokenEnd = at + 1;
+        auto hasEscape = false;
+
+        if (ch == '"') {
+            ++tokenBegin;
+
+            while (tokenEnd != end && *tokenEnd != '"') {
+                if (*tokenEnd == '\\') {
+                    hasEscape = true;
+                    ++tokenEnd;
+
+                    if (tokenEnd == end) {
+                        break;
+                    }
+                }
+
+                ++tokenEnd;
+            }
+
+            at = tokenEnd == end ? end : tokenEnd + 1;
+        } else {
+            ++at;
+        }
+
+        if (levels.empty() || levels.back().hintIndex < 0) {
+            continue;
+        }
+
+        auto& level = levels.back();
+
+        if (ch == '"' && level.nextStrIsKey) {
+            // JSON object key
+            level.nextStrIsKey = false;
+
+            if (hasEscape) {
+                // could be `type` once unescaped
+                level.hasUnusableType = true;
+            } else if (static_cast<Size>(tokenEnd - tokenBegin) == typeLen &&
+                    std::equal(tokenBegin, tokenEnd, strs::type)) {
+                level.nextValIsType = true;
+            }
+        } else if (level.nextValIsType) {
+            level.nextValIsType = false;
+
+            if (ch == '"' && !hasEscape && !level.hasUnusableType) {
+                auto& hint = hints[level.hintIndex];
+
+                hint.begin = tokenBegin;
+                hint.end = tokenEnd;
+            } else {
+                level.hasUnusableType = true;
+            }
+        }
+    }
+
+    return hints;
+}
+
+/*
+ * Listener for the listener version of parseJson() which validates a
+ * CTF 2 fragment and builds the corresponding `Ctf2JsonFrag` object.
+ */
+class Ctf2JsonFragBuilder final
+{
+public:
+    explicit Ctf2JsonFragBuilder(const char * const begin, const char * const end,
+                                 const Size baseOffset, const PseudoDtAliases * const aliases) :
+        _objTypeHints {objTypeHints(begin, end)},
+        _baseOffset {baseOffset},
+        _ctx {aliases},
+        _rootHandler {_ctx},
+        _handlerStack {_rootHandler}
+    {
+    }
+
+    void onNull(const TextLocation& loc)
+    {
+        _handlerStack.onScalar(this->_val(JsonValKind::Null, loc));
+    }
+
+    void onScalarVal(const bool val, const TextLocation& loc)
+    {
+        auto parsedVal = this->_val(JsonValKind::Bool, loc);
+
+        parsedVal.boolVal = val;
+        _handlerStack.onScalar(parsedVal);
+    }
+
+    void onScalarVal(const unsigned long long val, const TextLocation& loc)
+    {
+        auto parsedVal = this->_val(JsonValKind::UInt, loc);
+
+        parsedVal.uIntVal = val;
+        _handlerStack.onScalar(parsedVal);
+    }
+
+    void onScalarVal(const long long val, const TextLocation& loc)
+    {
+        auto parsedVal = this->_val(JsonValKind::SInt, loc);
+
+        parsedVal.sIntVal = val;
+        _handlerStack.onScalar(parsedVal);
+    }
+
+    void onScalarVal(const double val, const TextLocation& loc)
+    {
+        auto parsedVal = this->_val(JsonValKind::Real, loc);
+
+        parsedVal.realVal = val;
+        _handlerStack.onScalar(parsedVal);
+    }
+
+    void onScalarVal(const std::string& val, const TextLocation& loc)
+    {
+        auto parsedVal = this->_val(JsonValKind::Str, loc);
+
+        parsedVal.strVal = &val;
+        _handlerStack.onScalar(parsedVal);
+    }
+
+    void onArrayBegin(const TextLocation& loc)
+    {
+        _handlerStack.onCompoundBegin(this->_val(JsonValKind::Array, loc));
+    }
+
+    void onArrayEnd(const TextLocation&)
+    {
+        _handlerStack.onCompoundEnd();
+    }
+
+    void onObjBegin(const TextLocation& loc)
+    {
+        auto parsedVal = this->_val(JsonValKind::Obj, loc);
+
+        if (_objIndex < _objTypeHints.size()) {
+            auto& hint = _objTypeHints[_objIndex];
+
+            parsedVal.objTypeBegin = hint.begin;
+            parsedVal.objTypeEnd = hint.end;
+        }
+
+        ++_objIndex;
+        _handlerStack.onCompoundBegin(parsedVal);
+    }
+
+    void onObjKey(const std::string& key, const TextLocation&)
+    {
+        _handlerStack.onKey(key);
+    }
+
+    void onObjEnd(const TextLocation&)
+    {
+        _handlerStack.onCompoundEnd();
+    }
+
+    Ctf2JsonFrag::Up releaseFrag()
+    {
+        return _rootHandler.releaseFrag();
+    }
+
+private:
+    ParsedJsonVal _val(const JsonValKind kind, const TextLocation& loc) const
+    {
+        return ParsedJsonVal {kind, TextLocation {
+            loc.offset() + _baseOffset, loc.lineNumber(), loc.columnNumber()
+        }};
+    }
+
+private:
+    // `type` property values of the JSON objects, and index of the next JSON object
+    std::vector<ObjTypeHint> _objTypeHints;
+    Index _objIndex = 0;
+
+    Size _baseOffset;
+    ParsingCtx _ctx;
+    FragRootValHandler _rootHandler;
+    JsonValHandlerStack _handlerStack;
+};
+
+} // namespace
+
+Ctf2JsonFrag::Up parseCtf2JsonFrag(const char * const begin, const char * const end,
+                                   const Size baseOffset, const PseudoDtAliases * const aliases)
+{
+    Ctf2JsonFragBuilder builder {begin, end, baseOffset, aliases};
+
+    try {
+        parseJson(begin, end, builder);
+    } catch (const TextParseError& exc) {
+        // parseJson() only throws single-message text parse errors
+        assert(exc.messages().size() == 1);
+
+        auto& firstMsg = exc.messages().front();
+
+        throwTextParseError(firstMsg.message(), TextLocation {
+            firstMsg.location().offset() + baseOffset,
+            firstMsg.location().lineNumber(),
+            firstMsg.location().columnNumber()
+        });
+    }
+
+    return builder.releaseFrag();
+}
+
+} // namespace internal
+} // namespace yactfr
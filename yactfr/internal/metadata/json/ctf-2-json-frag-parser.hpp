@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022-2023 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_METADATA_JSON_CTF_2_JSON_FRAG_PARSER_HPP
+#define YACTFR_INTERNAL_METADATA_JSON_CTF_2_JSON_FRAG_PARSER_HPP
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <boost/optional.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include <yactfr/aliases.hpp>
+#include <yactfr/text-loc.hpp>
+#include <yactfr/metadata/item.hpp>
+#include <yactfr/metadata/clk-type.hpp>
+#include <yactfr/metadata/trace-env.hpp>
+
+#include "../pseudo-types.hpp"
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * Pseudo data type aliases (name to aliased pseudo data type).
+ */
+using PseudoDtAliases = std::unordered_map<std::string, PseudoDt::Up>;
+
+/*
+ * Data type property of a CTF 2 JSON fragment.
+ */
+struct Ctf2JsonFragDtProp final
+{
+    // pseudo data type, or `nullptr` if none or on erection error
+    PseudoDt::Up pseudoDt;
+
+    /*
+     * Erection error (unknown data type alias), if any.
+     *
+     * Kept apart from the validation errors: the metadata stream
+     * parser throws it at the same point as it would throw any other
+     * error regarding this property.
+     */
+    std::exception_ptr exc;
+};
+
+/*
+ * Valid CTF 2 JSON fragment.
+ */
+struct Ctf2JsonFrag
+{
+    using Up = std::unique_ptr<Ctf2JsonFrag>;
+
+    enum class Kind
+    {
+        Pre,
+        DtAlias,
+        TraceType,
+        ClkType,
+        Dst,
+        Ert,
+    };
+
+    explicit Ctf2JsonFrag(const Kind kindParam, TextLocation locParam) :
+        kind {kindParam},
+        loc {std::move(locParam)}
+    {
+    }
+
+    virtual ~Ctf2JsonFrag() = default;
+
+    // kind of fragment
+    Kind kind;
+
+    // location of the JSON fragment object
+    TextLocation loc;
+};
+
+/*
+ * Valid CTF 2 JSON preamble fragment.
+ */
+struct Ctf2JsonPreFrag final :
+    public Ctf2JsonFrag
+{
+    explicit Ctf2JsonPreFrag(TextLocation loc) :
+        Ctf2JsonFrag {Kind::Pre, std::move(loc)}
+    {
+    }
+
+    // metadata stream UUID
+    boost::optional<boost::uuids::uuid> uuid;
+};
+
+/*
+ * Valid CTF 2 JSON data type alias fragment.
+ */
+struct Ctf2JsonDtAliasFrag final :
+    public Ctf2JsonFrag
+{
+    explicit Ctf2JsonDtAliasFrag(TextLocation loc) :
+        Ctf2JsonFrag {Kind::DtAlias, std::move(loc)}
+    {
+    }
+
+    // name and location of the JSON name string
+    std::string name;
+    TextLocation nameLoc;
+
+    // aliased data type
+    Ctf2JsonFragDtProp dt;
+};
+
+/*
+ * Valid CTF 2 JSON trace type fragment.
+ */
+struct Ctf2JsonTraceTypeFrag final :
+    public Ctf2JsonFrag
+{
+    explicit Ctf2JsonTraceTypeFrag(TextLocation loc) :
+        Ctf2JsonFrag {Kind::TraceType, std::move(loc)}
+    {
+    }
+
+    boost::optional<std::string> ns;
+    boost::optional<std::string> name;
+    boost::optional<std::string> uid;
+    TraceEnvironment::Entries envEntries;
+    Ctf2JsonFragDtProp pktHeaderDt;
+    MapItem::Up attrs;
+};
+
+/*
+ * Valid CTF 2 JSON clock type fragment.
+ */
+struct Ctf2JsonClkTypeFrag final :
+    public Ctf2JsonFrag
+{
+    explicit Ctf2JsonClkTypeFrag(TextLocation loc) :
+        Ctf2JsonFrag {Kind::ClkType, std::move(loc)}
+    {
+    }
+
+    // clock type (its internal ID is the `id` property)
+    ClockType::Up clkType;
+};
+
+/*
+ * Valid CTF 2 JSON data stream type fragment.
+ */
+struct Ctf2JsonDstFrag final :
+    public Ctf2JsonFrag
+{
+    explicit Ctf2JsonDstFrag(TextLocation loc) :
+        Ctf2JsonFrag {Kind::Dst, std::move(loc)}
+    {
+    }
+
+    TypeId id = 0;
+    boost::optional<std::string> ns;
+    boost::optional<std::string> name;
+    boost::optional<std::string> uid;
+
+    // default clock type ID and location of its JSON string
+    boost::optional<std::string> defClkTypeId;
+    TextLocation defClkTypeIdLoc;
+
+    Ctf2JsonFragDtProp pktCtxDt;
+    Ctf2JsonFragDtProp erHeaderDt;
+    Ctf2JsonFragDtProp erCommonCtxDt;
+    MapItem::Up attrs;
+};
+
+/*
+ * Valid CTF 2 JSON event record type fragment.
+ */
+struct Ctf2JsonErtFrag final :
+    public Ctf2JsonFrag
+{
+    explicit Ctf2JsonErtFrag(TextLocation loc) :
+        Ctf2JsonFrag {Kind::Ert, std::move(loc)}
+    {
+    }
+
+    // IDs and locations of their JSON integers (if set)
+    boost::optional<TypeId> dstId;
+    TextLocation dstIdLoc;
+    boost::optional<TypeId> id;
+    TextLocation idLoc;
+
+    boost::optional<std::string> ns;
+    boost::optional<std::string> name;
+    boost::optional<std::string> uid;
+    Ctf2JsonFragDtProp specCtxDt;
+    Ctf2JsonFragDtProp payloadDt;
+    MapItem::Up attrs;
+};
+
+/*
+ * Parses the CTF 2 JSON fragment between `begin` (included) and `end`
+ * (excluded), validating it and erecting its pseudo data types as the
+ * JSON parser emits its events, and returns the resulting valid
+ * fragment.
+ *
+ * `baseOffset` is the offset of `begin` within the whole metadata
+ * stream: this function adds it to the offset of any text location.
+ *
+ * `aliases` contains the data type aliases which the fragment may use.
+ * If `aliases` is `nullptr` and the fragment is valid, but uses a data
+ * type alias, then this function returns `nullptr`: call it again with
+ * the data type aliases to get the fragment.
+ *
+ * Throws `TextParseError` when the fragment isn't valid.
+ */
+Ctf2JsonFrag::Up parseCtf2JsonFrag(const char *begin, const char *end, Size baseOffset,
+                                   const PseudoDtAliases *aliases);
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_METADATA_JSON_CTF_2_JSON_FRAG_PARSER_HPP
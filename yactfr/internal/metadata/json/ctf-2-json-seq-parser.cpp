@@ -7,33 +7,23 @@
 
 #include <cassert>
 #include <sstream>
+#include <exception>
+#include <utility>
+#include <vector>
 
 #include "ctf-2-json-seq-parser.hpp"
-#include "ctf-2-json-strs.hpp"
-#include "json-val-from-text.hpp"
-#include "item-from-json-val.hpp"
 #include "../trace-type-from-pseudo-trace-type.hpp"
+#include "../parallel.hpp"
 #include "../../utils.hpp"
 
 namespace yactfr {
 namespace internal {
-namespace {
 
-JsonObjVal::Up createDefClkOffsetJsonObjVal()
-{
-    JsonObjVal::Container entries;
-
-    entries.insert(std::make_pair(strs::secs, createJsonVal(0LL, TextLocation {})));
-    entries.insert(std::make_pair(strs::cycles, createJsonVal(0ULL, TextLocation {})));
-    return createJsonVal(std::move(entries), TextLocation {});
-}
-
-} // namespace
-
-Ctf2JsonSeqParser::Ctf2JsonSeqParser(const char * const begin, const char * const end) :
+Ctf2JsonSeqParser::Ctf2JsonSeqParser(const char * const begin, const char * const end,
+                                     const Size threadCount) :
     _begin {begin},
     _end {end},
-    _defClkOffsetVal {createDefClkOffsetJsonObjVal()}
+    _threadCount {threadCount}
 {
     this->_parseMetadata();
 }
@@ -48,311 +38,373 @@ void Ctf2JsonSeqParser::_createTraceType()
     _traceType = traceTypeFromPseudoTraceType(*_pseudoTraceType);
 }
 
-void Ctf2JsonSeqParser::_parseMetadata()
+template <typename FuncT>
+void Ctf2JsonSeqParser::_forEachFragRange(const char * const begin, const char * const end,
+                                          FuncT&& func)
 {
-    auto fragBegin = _begin;
+    auto fragBegin = begin;
     const char *fragEnd;
-    Index fragIndex = 0;
 
     while (true) {
         // find the beginning pointer of the JSON fragment
-        while (fragBegin != _end && *fragBegin == 30) {
+        while (fragBegin != end && *fragBegin == 30) {
             ++fragBegin;
         }
 
-        if (fragBegin == _end) {
+        if (fragBegin == end) {
             // end of stream
-            this->_createTraceType();
             return;
         }
 
         // find the end pointer of the JSON fragment
         fragEnd = fragBegin;
 
-        while (fragEnd != _end && *fragEnd != 30) {
+        while (fragEnd != end && *fragEnd != 30) {
             ++fragEnd;
         }
 
         if (fragBegin == fragEnd) {
             throwTextParseError("Expecting a fragment.",
-                                TextLocation {static_cast<Index>(fragBegin - _begin), 0, 0});
+                                TextLocation {static_cast<Index>(fragBegin - begin), 0, 0});
         }
 
-        // parse fragment
-        this->_parseFrag(fragBegin, fragEnd, fragIndex);
+        func(fragBegin, fragEnd);
 
         // go to next fragment
         fragBegin = fragEnd;
+    }
+}
+
+template <typename FuncT>
+void Ctf2JsonSeqParser::_parseFrags(const char * const begin, const char * const end,
+                                    FuncT&& func)
+{
+    Index fragIndex = 0;
+
+    this->_forEachFragRange(begin, end, [this, begin, &func,
+                                         &fragIndex](const char * const fragBegin,
+                                                     const char * const fragEnd) {
+        func(*parseCtf2JsonFrag(fragBegin, fragEnd, fragBegin - begin, &_dtAliases), fragIndex);
         ++fragIndex;
+    });
+}
+
+void Ctf2JsonSeqParser::_parseFragsParallel()
+{
+    std::vector<std::pair<const char *, const char *>> fragRanges;
+
+    /*
+     * Keep any framing error for after having handled the preceding
+     * fragments, like _parseFrags() would.
+     */
+    std::exception_ptr framingExc;
+
+    try {
+        this->_forEachFragRange(_begin, _end, [&fragRanges](const char * const fragBegin,
+                                                            const char * const fragEnd) {
+            fragRanges.push_back(std::make_pair(fragBegin, fragEnd));
+        });
+    } catch (const TextParseError&) {
+        framingExc = std::current_exception();
+    }
+
+    /*
+     * Parse and validate all the fragments concurrently.
+     *
+     * Without any data type alias, a worker thread gets a null
+     * fragment for a valid fragment which refers to a data type alias.
+     */
+    std::vector<Ctf2JsonFrag::Up> frags(fragRanges.size());
+    std::vector<std::exception_ptr> excs(fragRanges.size());
+
+    parallelFor(fragRanges.size(), effectiveThreadCount(_threadCount, fragRanges.size()),
+                [this, &fragRanges, &frags, &excs](Index, const Index fragIndex) {
+        const auto& fragRange = fragRanges[fragIndex];
+
+        try {
+            frags[fragIndex] = parseCtf2JsonFrag(fragRange.first, fragRange.second,
+                                                 fragRange.first - _begin, nullptr);
+        } catch (...) {
+            excs[fragIndex] = std::current_exception();
+        }
+    });
+
+    /*
+     * Handle the fragments in order, throwing the error of the first
+     * fragment which can't be parsed, if any: the resulting error is
+     * the one which _parseFrags() would throw.
+     */
+    for (Index fragIndex = 0; fragIndex < fragRanges.size(); ++fragIndex) {
+        if (excs[fragIndex]) {
+            std::rethrow_exception(excs[fragIndex]);
+        }
+
+        auto& frag = frags[fragIndex];
+
+        if (!frag) {
+            // needs the data type aliases so far
+            const auto& fragRange = fragRanges[fragIndex];
+
+            frag = parseCtf2JsonFrag(fragRange.first, fragRange.second, fragRange.first - _begin,
+                                     &_dtAliases);
+        }
+
+        this->_handleFrag(*frag, fragIndex);
+        frag.reset();
+    }
+
+    if (framingExc) {
+        std::rethrow_exception(framingExc);
     }
 }
 
-void Ctf2JsonSeqParser::_parseFrag(const char * const begin, const char * const end,
-    const Index index)
+void Ctf2JsonSeqParser::_parseMetadata()
 {
-    this->_handleFrag(*parseJson(begin, end, begin - _begin), index);
+    if (_threadCount == 1) {
+        this->_parseFrags(_begin, _end, [this](Ctf2JsonFrag& frag, const Index fragIndex) {
+            this->_handleFrag(frag, fragIndex);
+        });
+    } else {
+        this->_parseFragsParallel();
+    }
+
+    this->_createTraceType();
 }
 
-void Ctf2JsonSeqParser::_handleFrag(const JsonVal& jsonFrag, const Index index)
+ErtsByDstId Ctf2JsonSeqParser::parseAppendedMetadata(const char * const begin,
+                                                     const char * const end,
+                                                     const TraceType& traceType)
 {
-    // validate
-    _fragValReq.validate(jsonFrag);
+    assert(end >= begin);
+    assert(_pseudoTraceType);
+
+    std::vector<std::string> newDtAliasNames;
+
+    try {
+        this->_parseFrags(begin, end, [this, &newDtAliasNames](Ctf2JsonFrag& frag, Index) {
+            this->_handleAppendedFrag(frag, newDtAliasNames);
+        });
+
+        return newErtsFromPseudoTraceType(*_pseudoTraceType, traceType);
+    } catch (const TextParseError&) {
+        removeNewPseudoOrphanErts(*_pseudoTraceType, traceType);
 
-    // get type
-    auto& jsonFragObj = jsonFrag.asObj();
-    auto& type = jsonFragObj.getRawStrVal(strs::type);
+        for (auto& name : newDtAliasNames) {
+            _dtAliases.erase(name);
+        }
 
+        throw;
+    }
+}
+
+void Ctf2JsonSeqParser::_handleFrag(Ctf2JsonFrag& frag, const Index index)
+{
     // specific preamble fragment case
     if (index == 0) {
-        if (type != strs::pre) {
-            throwTextParseError("Expecting the preamble fragment.", jsonFrag.loc());
+        if (frag.kind != Ctf2JsonFrag::Kind::Pre) {
+            throwTextParseError("Expecting the preamble fragment.", frag.loc);
         }
 
         // set metadata stream UUID, if any
-        _metadataStreamUuid = uuidOfObj(jsonFragObj);
+        _metadataStreamUuid = static_cast<const Ctf2JsonPreFrag&>(frag).uuid;
 
         // done with this fragment
         return;
     }
 
     // defer to specific method
-    if (type == strs::pre) {
+    switch (frag.kind) {
+    case Ctf2JsonFrag::Kind::Pre:
         assert(index > 0);
         throwTextParseError("Preamble fragment must be the first fragment of "
-                            "the metadata stream.", jsonFrag.loc());
-    } else if (type == strs::fcAlias) {
-        this->_handleDtAliasFrag(jsonFragObj);
-    } else if (type == strs::tc) {
-        this->_handleTraceTypeFrag(jsonFragObj);
-    } else if (type == strs::cc) {
-        this->_handleClkTypeFrag(jsonFragObj);
-    } else if (type == strs::dsc) {
-        this->_handleDstFrag(jsonFragObj);
+                            "the metadata stream.", frag.loc);
+
+    case Ctf2JsonFrag::Kind::DtAlias:
+        this->_handleDtAliasFrag(static_cast<Ctf2JsonDtAliasFrag&>(frag));
+        break;
+
+    case Ctf2JsonFrag::Kind::TraceType:
+        this->_handleTraceTypeFrag(static_cast<Ctf2JsonTraceTypeFrag&>(frag));
+        break;
+
+    case Ctf2JsonFrag::Kind::ClkType:
+        this->_handleClkTypeFrag(static_cast<Ctf2JsonClkTypeFrag&>(frag));
+        break;
+
+    case Ctf2JsonFrag::Kind::Dst:
+        this->_handleDstFrag(static_cast<Ctf2JsonDstFrag&>(frag));
+        break;
+
+    case Ctf2JsonFrag::Kind::Ert:
+        this->_handleErtFrag(static_cast<Ctf2JsonErtFrag&>(frag));
+        break;
+
+    default:
+        std::abort();
+    }
+}
+
+void Ctf2JsonSeqParser::_handleAppendedFrag(Ctf2JsonFrag& frag,
+                                            std::vector<std::string>& newDtAliasNames)
+{
+    if (frag.kind == Ctf2JsonFrag::Kind::DtAlias) {
+        auto& dtAliasFrag = static_cast<Ctf2JsonDtAliasFrag&>(frag);
+
+        this->_handleDtAliasFrag(dtAliasFrag);
+        newDtAliasNames.push_back(dtAliasFrag.name);
+    } else if (frag.kind == Ctf2JsonFrag::Kind::Ert) {
+        this->_handleErtFrag(static_cast<Ctf2JsonErtFrag&>(frag));
     } else {
-        assert(type == strs::erc);
-        this->_handleErtFrag(jsonFragObj);
+        throwTextParseError("Expecting a data type alias or event record type fragment: "
+                            "an appended metadata stream may only add data type aliases and "
+                            "event record types.", frag.loc);
     }
 }
 
-void Ctf2JsonSeqParser::_handleDtAliasFrag(const JsonObjVal& jsonFrag)
+void Ctf2JsonSeqParser::_handleDtAliasFrag(Ctf2JsonDtAliasFrag& frag)
 {
     try {
-        auto& jsonNameVal = jsonFrag.asObj()[strs::name]->asStr();
+        auto pseudoDt = this->_pseudoDtOfFragDtProp(frag.dt);
 
-        _pseudoDtErector.addAlias(*jsonNameVal,
-                                  _pseudoDtErector.pseudoDtOfJsonObj(jsonFrag, strs::fc),
-                                  jsonNameVal.loc());
+        // check for duplicate
+        if (_dtAliases.find(frag.name) != _dtAliases.end()) {
+            std::ostringstream ss;
+
+            ss << "Duplicate data type alias named `" << frag.name << "`.";
+            throwTextParseError(ss.str(), frag.nameLoc);
+        }
+
+        _dtAliases.emplace(frag.name, std::move(pseudoDt));
     } catch (TextParseError& exc) {
-        appendMsgToTextParseError(exc, "In data type alias fragment:", jsonFrag.loc());
+        appendMsgToTextParseError(exc, "In data type alias fragment:", frag.loc);
         throw;
     }
 }
 
-void Ctf2JsonSeqParser::_handleTraceTypeFrag(const JsonObjVal& jsonFrag)
+void Ctf2JsonSeqParser::_handleTraceTypeFrag(Ctf2JsonTraceTypeFrag& frag)
 {
     if (_pseudoTraceType) {
-        throwTextParseError("Duplicate trace type fragment.", jsonFrag.loc());
-    }
-
-    // environment
-    TraceEnvironment::Entries envEntries;
-
-    const auto jsonEnv = jsonFrag[strs::env];
-
-    if (jsonEnv) {
-        for (auto& keyJsonValPair : jsonEnv->asObj()) {
-            auto& jsonEntryVal = *keyJsonValPair.second;
-
-            if (jsonEntryVal.isStr()) {
-                envEntries.emplace(std::make_pair(keyJsonValPair.first, *jsonEntryVal.asStr()));
-            } else if (jsonEntryVal.isSInt()) {
-                envEntries.emplace(std::make_pair(keyJsonValPair.first, *jsonEntryVal.asSInt()));
-            } else {
-                assert(jsonEntryVal.isUInt());
-                envEntries.emplace(std::make_pair(keyJsonValPair.first,
-                                                  static_cast<long long>(*jsonEntryVal.asUInt())));
-            }
-        }
+        throwTextParseError("Duplicate trace type fragment.", frag.loc);
     }
 
     try {
         _pseudoTraceType = PseudoTraceType {
-            2, 0, optStrOfObj(jsonFrag, strs::ns), optStrOfObj(jsonFrag, strs::name),
-            optStrOfObj(jsonFrag, strs::uid),
-            TraceEnvironment {std::move(envEntries)},
-            this->_pseudoScopeDtOfJsonObj(jsonFrag, strs::pktHeaderFc),
-            attrsOfObj(jsonFrag)
+            2, 0, std::move(frag.ns), std::move(frag.name), std::move(frag.uid),
+            TraceEnvironment {std::move(frag.envEntries)},
+            this->_pseudoScopeDtOfFragDtProp(frag.pktHeaderDt),
+            std::move(frag.attrs)
         };
     } catch (TextParseError& exc) {
-        appendMsgToTextParseError(exc, "In trace type fragment:", jsonFrag.loc());
+        appendMsgToTextParseError(exc, "In trace type fragment:", frag.loc);
         throw;
     }
 }
 
-void Ctf2JsonSeqParser::_handleClkTypeFrag(const JsonObjVal& jsonFrag)
+void Ctf2JsonSeqParser::_handleClkTypeFrag(Ctf2JsonClkTypeFrag& frag)
 {
     this->_ensureExistingPseudoTraceType();
 
     // internal ID
-    auto id = jsonFrag.getRawStrVal(strs::id);
+    auto& id = *frag.clkType->internalId();
 
     if (_pseudoTraceType->hasClkType(id)) {
         std::ostringstream ss;
 
         ss << "Duplicate clock type fragment with internal ID `" << id << "`.";
-        throwTextParseError(ss.str(), jsonFrag.loc());
-    }
-
-    // offset
-    auto& jsonOffsetFromOrigVal = jsonFrag.getVal(strs::offsetFromOrig, *_defClkOffsetVal);
-    const auto jsonOffsetSecsVal = jsonOffsetFromOrigVal[strs::secs];
-    auto offsetFromOrigSecs = 0LL;
-
-    if (jsonOffsetSecsVal) {
-        offsetFromOrigSecs = rawIntValFromJsonIntVal<long long>(*jsonOffsetSecsVal);
+        throwTextParseError(ss.str(), frag.loc);
     }
 
-    const auto offsetFromOrigCycles = jsonOffsetFromOrigVal.getRawVal(strs::cycles, 0ULL);
-
-    // origin
-    boost::optional<ClockOrigin> orig;
-    const auto jsonOrigVal = jsonFrag[strs::orig];
-
-    if (jsonOrigVal) {
-        if (jsonOrigVal->isStr()) {
-            assert(*jsonOrigVal->asStr() == strs::unixEpoch);
-            orig = ClockOrigin {};
-        } else {
-            assert(jsonOrigVal->isObj());
-
-            auto& jsonOrigObjVal = jsonOrigVal->asObj();
-
-            orig = ClockOrigin {
-                optStrOfObj(jsonOrigObjVal, strs::ns),
-                *jsonOrigObjVal[strs::name]->asStr(),
-                *jsonOrigObjVal[strs::uid]->asStr()
-            };
-        }
-    }
-
-    // create corresponding clock type
-    auto clkType = ClockType::create(std::move(id), optStrOfObj(jsonFrag, strs::ns),
-                                     optStrOfObj(jsonFrag, strs::name),
-                                     optStrOfObj(jsonFrag, strs::uid), boost::none,
-                                     jsonFrag.getRawUIntVal(strs::freq),
-                                     optStrOfObj(jsonFrag, strs::descr), std::move(orig),
-                                     optUIntOfObj(jsonFrag, strs::prec),
-                                     optUIntOfObj(jsonFrag, strs::accuracy),
-                                     ClockOffset {offsetFromOrigSecs, offsetFromOrigCycles},
-                                     attrsOfObj(jsonFrag));
-
     // add to pseudo trace type
-    _pseudoTraceType->clkTypes().insert(std::move(clkType));
-}
-
-namespace {
-
-boost::optional<std::pair<std::string, TextLocation>> optStrOfObjWithLoc(const JsonObjVal& jsonObjVal,
-                                                                         const std::string& propName)
-{
-    if (const auto jsonVal = jsonObjVal[propName]) {
-        return std::make_pair(*jsonVal->asStr(), jsonVal->loc());
-    }
-
-    return boost::none;
+    _pseudoTraceType->clkTypes().insert(std::move(frag.clkType));
 }
 
-} // namespace
-
-const ClockType *Ctf2JsonSeqParser::_defClkTypeOfDstFrag(const JsonObjVal& jsonFrag)
+const ClockType *Ctf2JsonSeqParser::_defClkTypeOfDstFrag(const Ctf2JsonDstFrag& frag)
 {
-    if (const auto defClkTypeId = optStrOfObjWithLoc(jsonFrag, strs::defCcId)) {
-        if (const auto defClkType = _pseudoTraceType->findClkType(defClkTypeId->first)) {
+    if (frag.defClkTypeId) {
+        if (const auto defClkType = _pseudoTraceType->findClkType(*frag.defClkTypeId)) {
             return defClkType;
         }
 
         std::ostringstream ss;
 
-        ss << '`' << defClkTypeId->first << "` doesn't identify an existing clock type.";
-        throwTextParseError(ss.str(), defClkTypeId->second);
+        ss << '`' << *frag.defClkTypeId << "` doesn't identify an existing clock type.";
+        throwTextParseError(ss.str(), frag.defClkTypeIdLoc);
     }
 
     return nullptr;
 }
 
-void Ctf2JsonSeqParser::_handleDstFrag(const JsonObjVal& jsonFrag)
+void Ctf2JsonSeqParser::_handleDstFrag(Ctf2JsonDstFrag& frag)
 {
     this->_ensureExistingPseudoTraceType();
 
     // ID
-    const auto id = jsonFrag.getRawVal(strs::id, 0ULL);
+    const auto id = frag.id;
 
     if (_pseudoTraceType->hasPseudoDst(id)) {
         std::ostringstream ss;
 
         ss << "Duplicate data stream type with ID " << id << '.';
-        throwTextParseError(ss.str(), jsonFrag.loc());
+        throwTextParseError(ss.str(), frag.loc);
     }
 
     try {
+        const auto defClkType = this->_defClkTypeOfDstFrag(frag);
+        auto pseudoErCommonCtxDt = this->_pseudoScopeDtOfFragDtProp(frag.erCommonCtxDt);
+        auto pseudoErHeaderDt = this->_pseudoScopeDtOfFragDtProp(frag.erHeaderDt);
+        auto pseudoPktCtxDt = this->_pseudoScopeDtOfFragDtProp(frag.pktCtxDt);
+
         _pseudoTraceType->pseudoDsts().insert(std::make_pair(id, std::make_unique<PseudoDst>(
-            id,
-            optStrOfObj(jsonFrag, strs::ns), optStrOfObj(jsonFrag, strs::name),
-            optStrOfObj(jsonFrag, strs::uid),
-            this->_pseudoScopeDtOfJsonObj(jsonFrag, strs::pktCtxFc),
-            this->_pseudoScopeDtOfJsonObj(jsonFrag, strs::erHeaderFc),
-            this->_pseudoScopeDtOfJsonObj(jsonFrag, strs::erCommonCtxFc),
-            this->_defClkTypeOfDstFrag(jsonFrag), attrsOfObj(jsonFrag)
+            id, std::move(frag.ns), std::move(frag.name), std::move(frag.uid),
+            std::move(pseudoPktCtxDt), std::move(pseudoErHeaderDt),
+            std::move(pseudoErCommonCtxDt), defClkType, std::move(frag.attrs)
         )));
     } catch (TextParseError& exc) {
-        appendMsgToTextParseError(exc, "In data stream type fragment:", jsonFrag.loc());
+        appendMsgToTextParseError(exc, "In data stream type fragment:", frag.loc);
         throw;
     }
 
     _pseudoTraceType->pseudoOrphanErts()[id];
 }
 
-void Ctf2JsonSeqParser::_handleErtFrag(const JsonObjVal& jsonFrag)
+void Ctf2JsonSeqParser::_handleErtFrag(Ctf2JsonErtFrag& frag)
 {
     this->_ensureExistingPseudoTraceType();
 
     // data stream type ID
-    const auto jsonDstIdVal = jsonFrag[strs::dscId];
-    const auto dstId = jsonDstIdVal ? *jsonDstIdVal->asUInt() : 0ULL;
+    const auto dstId = frag.dstId ? *frag.dstId : 0ULL;
 
     if (!_pseudoTraceType->hasPseudoDst(dstId)) {
         std::ostringstream ss;
 
         ss << "No data stream type exists with ID " << dstId << '.';
-        throwTextParseError(ss.str(), jsonDstIdVal ? jsonDstIdVal->loc() : jsonFrag.loc());
+        throwTextParseError(ss.str(), frag.dstId ? frag.dstIdLoc : frag.loc);
     }
 
     // ID
-    const auto jsonIdVal = jsonFrag[strs::id];
-    const auto id = jsonIdVal ? *jsonIdVal->asUInt() : 0ULL;
+    const auto id = frag.id ? *frag.id : 0ULL;
 
     if (_pseudoTraceType->hasPseudoOrphanErt(dstId, id)) {
         std::ostringstream ss;
 
         ss << "Duplicate event record type with ID " << id <<
               " within data stream type " << dstId << '.';
-        throwTextParseError(ss.str(), jsonIdVal ? jsonIdVal->loc() : jsonFrag.loc());
+        throwTextParseError(ss.str(), frag.id ? frag.idLoc : frag.loc);
     }
 
     try {
         _pseudoTraceType->pseudoOrphanErts()[dstId].insert(std::make_pair(id, PseudoOrphanErt {
             PseudoErt {
-                id, optStrOfObj(jsonFrag, strs::ns), optStrOfObj(jsonFrag, strs::name),
-                optStrOfObj(jsonFrag, strs::uid),
+                id, std::move(frag.ns), std::move(frag.name), std::move(frag.uid),
                 boost::none, boost::none,
-                this->_pseudoScopeDtOfJsonObj(jsonFrag, strs::specCtxFc),
-                this->_pseudoScopeDtOfJsonObj(jsonFrag, strs::payloadFc),
-                attrsOfObj(jsonFrag)
+                this->_pseudoScopeDtOfFragDtProp(frag.specCtxDt),
+                this->_pseudoScopeDtOfFragDtProp(frag.payloadDt),
+                std::move(frag.attrs)
             },
-            jsonFrag.loc()
+            frag.loc
         }));
     } catch (TextParseError& exc) {
-        appendMsgToTextParseError(exc, "In event record type fragment:", jsonFrag.loc());
+        appendMsgToTextParseError(exc, "In event record type fragment:", frag.loc);
         throw;
     }
 }
@@ -368,10 +420,18 @@ void Ctf2JsonSeqParser::_ensureExistingPseudoTraceType()
     _pseudoTraceType = PseudoTraceType {2, 0};
 }
 
-PseudoDt::Up Ctf2JsonSeqParser::_pseudoScopeDtOfJsonObj(const JsonObjVal& jsonObjVal,
-                                                        const std::string& propName)
+PseudoDt::Up Ctf2JsonSeqParser::_pseudoDtOfFragDtProp(Ctf2JsonFragDtProp& prop)
+{
+    if (prop.exc) {
+        std::rethrow_exception(prop.exc);
+    }
+
+    return std::move(prop.pseudoDt);
+}
+
+PseudoDt::Up Ctf2JsonSeqParser::_pseudoScopeDtOfFragDtProp(Ctf2JsonFragDtProp& prop)
 {
-    if (auto pseudoDt = _pseudoDtErector.pseudoDtOfJsonObj(jsonObjVal, propName)) {
+    if (auto pseudoDt = Ctf2JsonSeqParser::_pseudoDtOfFragDtProp(prop)) {
         if (pseudoDt->kind() != PseudoDt::Kind::Struct) {
             throwTextParseError("Root data type of scope must be a structure type.",
                                 pseudoDt->loc());
@@ -10,6 +10,8 @@
 
 #include <cassert>
 #include <array>
+#include <string>
+#include <vector>
 #include <boost/optional.hpp>
 #include <boost/uuid/uuid.hpp>
 
@@ -20,11 +22,9 @@
 #include <yactfr/text-parse-error.hpp>
 #include <yactfr/metadata/aliases.hpp>
 
-#include "ctf-2-json-val-req.hpp"
-#include "ctf-2-json-utils.hpp"
-#include "json-val.hpp"
-#include "pseudo-dt-erector.hpp"
+#include "ctf-2-json-frag-parser.hpp"
 #include "../pseudo-types.hpp"
+#include "../trace-type-from-pseudo-trace-type.hpp"
 
 namespace yactfr {
 namespace internal {
@@ -43,12 +43,16 @@ public:
      * string between `begin` (included) and `end` (excluded), and
      * parses it.
      *
+     * If `threadCount` isn't 1, then this parser parses and validates
+     * the JSON fragments on `threadCount` threads (0 means the number
+     * of hardware threads) before handling them in order.
+     *
      * You can release the resulting trace type from this parser with
      * releaseTraceType().
      *
      * Throws `TextParseError` when there was a parsing error.
      */
-    explicit Ctf2JsonSeqParser(const char *begin, const char *end);
+    explicit Ctf2JsonSeqParser(const char *begin, const char *end, Size threadCount = 1);
 
     /*
      * Releases and returns the parsed trace type.
@@ -66,6 +70,24 @@ public:
         return _metadataStreamUuid;
     }
 
+    /*
+     * Parses the JSON text sequence between `begin` (included) and
+     * `end` (excluded) which follows the JSON text sequence(s) which
+     * this parser already parsed, and returns the resulting new event
+     * record types, which `traceType`, the trace type which
+     * releaseTraceType() returned, doesn't contain yet.
+     *
+     * Such an appended JSON text sequence may only contain data type
+     * alias and event record type fragments. It may use the data type
+     * aliases of the previous JSON text sequences.
+     *
+     * Throws `TextParseError` when there was a parsing error, in which
+     * case the state of this parser is as it was before calling this
+     * method. The text locations of the error are relative to `begin`.
+     */
+    ErtsByDstId parseAppendedMetadata(const char *begin, const char *end,
+                                      const TraceType& traceType);
+
 private:
     /*
      * Creates the yactfr trace type from the pseudo trace type.
@@ -80,52 +102,78 @@ private:
     void _parseMetadata();
 
     /*
-     * Parses the JSON fragment between `begin` (included) and `end`
-     * (excluded), updating the internal state on success, or throwing
-     * `TextParseError` on failure.
+     * Calls `func(fragBegin, fragEnd)` for each JSON fragment of the
+     * JSON text sequence between `begin` (included) and `end`
+     * (excluded).
      */
-    void _parseFrag(const char *begin, const char *end, Index fragIndex);
+    template <typename FuncT>
+    void _forEachFragRange(const char *begin, const char *end, FuncT&& func);
 
     /*
-     * Handles the JSON fragment `jsonFrag`, updating the internal state
-     * on success, or throwing `TextParseError` on failure.
+     * Parses each JSON fragment of the JSON text sequence between
+     * `begin` (included) and `end` (excluded), calling
+     * `func(frag, fragIndex)` for each one.
      */
-    void _handleFrag(const JsonVal& jsonFrag, Index fragIndex);
+    template <typename FuncT>
+    void _parseFrags(const char *begin, const char *end, FuncT&& func);
 
     /*
-     * Handles the JSON trace type fragment `jsonFrag`, updating the
-     * internal state on success, or throwing `TextParseError` on
-     * failure.
+     * Parses and validates all the JSON fragments of the whole
+     * metadata string concurrently, and then handles them in order
+     * with _handleFrag().
+     *
+     * A worker thread can't erect a data type which refers to a data
+     * type alias, as the alias may be the result of a preceding
+     * fragment: such a fragment is parsed again, in order, with the
+     * data type aliases so far.
      */
-    void _handleTraceTypeFrag(const JsonObjVal& jsonFrag);
+    void _parseFragsParallel();
 
     /*
-     * Handles the JSON data type alias fragment `jsonFrag`, updating
-     * the internal state on success, or throwing `TextParseError` on
-     * failure.
+     * Handles the valid fragment `frag`, updating the internal state on
+     * success, or throwing `TextParseError` on failure.
+     */
+    void _handleFrag(Ctf2JsonFrag& frag, Index fragIndex);
+
+    /*
+     * Like _handleFrag(), but for a fragment of an appended JSON text
+     * sequence, appending the name of any new data type alias to
+     * `newDtAliasNames`.
      */
-    void _handleDtAliasFrag(const JsonObjVal& jsonFrag);
+    void _handleAppendedFrag(Ctf2JsonFrag& frag, std::vector<std::string>& newDtAliasNames);
 
     /*
-     * Handles the JSON clock type fragment `jsonFrag`, updating the
+     * Handles the trace type fragment `frag`, updating the internal
+     * state on success, or throwing `TextParseError` on failure.
+     */
+    void _handleTraceTypeFrag(Ctf2JsonTraceTypeFrag& frag);
+
+    /*
+     * Handles the data type alias fragment `frag`, updating the
      * internal state on success, or throwing `TextParseError` on
      * failure.
      */
-    void _handleClkTypeFrag(const JsonObjVal& jsonFrag);
+    void _handleDtAliasFrag(Ctf2JsonDtAliasFrag& frag);
+
+    /*
+     * Handles the clock type fragment `frag`, updating the internal
+     * state on success, or throwing `TextParseError` on failure.
+     */
+    void _handleClkTypeFrag(Ctf2JsonClkTypeFrag& frag);
 
     /*
-     * Handles the JSON data stream type fragment `jsonFrag`, updating
-     * the internal state on success, or throwing `TextParseError` on
+     * Handles the data stream type fragment `frag`, updating the
+     * internal state on success, or throwing `TextParseError` on
      * failure.
      */
-    void _handleDstFrag(const JsonObjVal& jsonFrag);
+    void _handleDstFrag(Ctf2JsonDstFrag& frag);
 
     /*
-     * Handles the JSON event record type fragment `jsonFrag`, updating
-     * the internal state on success, or throwing `TextParseError` on
+     * Handles the event record type fragment `frag`, updating the
+     * internal state on success, or throwing `TextParseError` on
      * failure.
      */
-    void _handleErtFrag(const JsonObjVal& jsonFrag);
+    void _handleErtFrag(Ctf2JsonErtFrag& frag);
 
     /*
      * Ensures that `_pseudoTraceType` is initialized.
@@ -133,32 +181,36 @@ private:
     void _ensureExistingPseudoTraceType();
 
     /*
-     * Calls `_pseudoDtErector.pseudoDtOfJsonObj()`, also validating
-     * that the returned value is a pseudo structure type.
+     * Releases and returns the pseudo data type of the fragment
+     * property `prop` (`nullptr` if none), throwing its erection error,
+     * if any.
+     */
+    static PseudoDt::Up _pseudoDtOfFragDtProp(Ctf2JsonFragDtProp& prop);
+
+    /*
+     * Like _pseudoDtOfFragDtProp(), also validating that the returned
+     * value is a pseudo structure type.
      */
-    PseudoDt::Up _pseudoScopeDtOfJsonObj(const JsonObjVal& jsonObjVal, const std::string& propName);
+    static PseudoDt::Up _pseudoScopeDtOfFragDtProp(Ctf2JsonFragDtProp& prop);
 
     /*
-     * Returns the default clock type for the JSON data stream type
-     * fragment `jsonFrag`, or `nullptr` if none.
+     * Returns the default clock type for the data stream type fragment
+     * `frag`, or `nullptr` if none.
      *
      * Throws if it can't find the clock type.
      */
-    const ClockType *_defClkTypeOfDstFrag(const JsonObjVal& jsonFrag);
+    const ClockType *_defClkTypeOfDstFrag(const Ctf2JsonDstFrag& frag);
 
 private:
     // beginning and end metadata string pointers
     const char *_begin;
     const char *_end;
 
-    // fragment requirement
-    JsonAnyFragValReq _fragValReq;
-
-    // pseudo data type erector
-    PseudoDtErector _pseudoDtErector;
+    // number of threads to parse the fragments (0: hardware threads)
+    Size _threadCount;
 
-    // default clock offset JSON value
-    JsonObjVal::Up _defClkOffsetVal;
+    // data type aliases
+    PseudoDtAliases _dtAliases;
 
     // final trace type
     TraceType::Up _traceType;
@@ -189,8 +189,8 @@ void JsonParser<ListenerT>::_expectVal()
     }
 
     /*
-     * This one is last because it's potentially slow due to calling
-     * StrScanner::tryScanConstReal().
+     * This one is last because it can scan the same characters twice
+     * (integer, then real number).
      */
     if (this->_tryParseNumber()) {
         return;
@@ -258,9 +258,10 @@ bool JsonParser<ListenerT>::_tryParseNumber()
     const auto loc = _ss.loc();
 
     /*
-     * The tryScanConstReal() method call below is somewhat expensive
-     * currently because it involves calling std::regex_search() to
-     * confirm the JSON constant real number form.
+     * The tryScanConstReal() method call below is more expensive than
+     * scanning an integer because it involves confirming the JSON
+     * constant real number form and then calling std::strtod(), while
+     * most JSON numbers of a metadata stream are integers.
      *
      * The strategy below is to:
      *
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_METADATA_PARALLEL_HPP
+#define YACTFR_INTERNAL_METADATA_PARALLEL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <yactfr/aliases.hpp>
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * Returns the number of threads to use to process `count` independent
+ * items, given the requested thread count `threadCount` (0 means the
+ * number of hardware threads).
+ */
+inline Size effectiveThreadCount(const Size threadCount, const Size count) noexcept
+{
+    auto effThreadCount = threadCount;
+
+    if (effThreadCount == 0) {
+        effThreadCount = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    return std::max(std::min(effThreadCount, count), static_cast<Size>(1));
+}
+
+/*
+ * Calls `func(threadIndex, index)` for each index from 0 to `count`
+ * (excluded) on at most `threadCount` threads, including the current
+ * one, returning once all the calls are done.
+ *
+ * `threadIndex` is the index (from 0 to `threadCount`, excluded) of the
+ * calling thread: `func` may use it to select a per-thread state. The
+ * order of the calls is unspecified.
+ *
+ * `func` must not throw: catch and keep any exception to rethrow it
+ * afterwards, in a deterministic order.
+ *
+ * If this function can't create a thread, then it continues with the
+ * threads it has.
+ */
+template <typename FuncT>
+void parallelFor(const Size count, const Size threadCount, FuncT&& func)
+{
+    assert(threadCount >= 1);
+
+    std::atomic<Index> nextIndex {0};
+
+    const auto work = [count, &nextIndex, &func](const Index threadIndex) {
+        while (true) {
+            const auto index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+
+            if (index >= count) {
+                return;
+            }
+
+            func(threadIndex, index);
+        }
+    };
+
+    /*
+     * Reserve beforehand so that emplace_back() never reallocates: an
+     * exception must never destroy `threads` while some of its threads
+     * are joinable, as this would call std::terminate().
+     */
+    std::vector<std::thread> threads;
+
+    threads.reserve(threadCount - 1);
+
+    for (Index threadIndex = 1; threadIndex < threadCount; ++threadIndex) {
+        try {
+            threads.emplace_back(work, threadIndex);
+        } catch (...) {
+            // `std::system_error` or `std::bad_alloc`: use the ones so far
+            break;
+        }
+    }
+
+    work(0);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_METADATA_PARALLEL_HPP
@@ -5,6 +5,8 @@
  * of the MIT license. See the LICENSE file for details.
  */
 
+#include <sstream>
+
 #include <yactfr/text-parse-error.hpp>
 
 #include "str-scanner.hpp"
@@ -12,16 +14,6 @@
 namespace yactfr {
 namespace internal {
 
-const std::regex StrScanner::_realRegex {
-    "^"                     // start of target
-    "-?"                    // optional negation
-    "(?:0|[1-9]\\d*)"       // integer part
-    "(?=[eE.]\\d)"          // assertion: need fraction/exponent part
-    "(?:\\.\\d+)?"          // optional fraction part
-    "(?:[eE][+-]?\\d+)?",   // optional exponent part
-    std::regex::optimize
-};
-
 StrScanner::StrScanner(const char * const begin, const char * const end) : //-V730
     _begin {begin},
     _end {end},
@@ -36,17 +28,126 @@ void StrScanner::reset()
     _at = _begin;
     _nbLines = 0;
     _lineBegin = _begin;
+
+    // forget the previous skips: the string may have changed since
+    for (auto& entry : _skipMemo) {
+        entry.from = nullptr;
+    }
+
+    for (auto& entry : _tokenMemo) {
+        entry.from = nullptr;
+    }
+}
+
+void StrScanner::reset(const char * const begin, const char * const end)
+{
+    _begin = begin;
+    _end = end;
+    this->reset();
 }
 
 void StrScanner::reject()
 {
     assert(!_stack.empty());
-    _at = _stack.back().at;
-    _lineBegin = _stack.back().lineBegin;
-    _nbLines = _stack.back().nbLines;
+    this->pos(_stack.back());
     _stack.pop_back();
 }
 
+bool StrScanner::trySkipBlock()
+{
+    StrScannerRejecter ssRej {*this};
+
+    if (!this->tryScanToken("{")) {
+        return false;
+    }
+
+    Size depth = 1;
+
+    while (true) {
+        this->skipCommentsAndWhitespaces();
+
+        if (this->isDone()) {
+            return false;
+        }
+
+        switch (*_at) {
+        case '{':
+            ++depth;
+            break;
+
+        case '}':
+            --depth;
+
+            if (depth == 0) {
+                ++_at;
+                ssRej.accept();
+                return true;
+            }
+
+            break;
+
+        case '"':
+            // skip literal string, including any escaped `"`
+            ++_at;
+
+            while (!this->isDone() && *_at != '"') {
+                if (*_at == '\\' && this->charsLeft() >= 2) {
+                    ++_at;
+                }
+
+                this->_checkNewLine();
+                ++_at;
+            }
+
+            if (this->isDone()) {
+                return false;
+            }
+
+            break;
+
+        default:
+            break;
+        }
+
+        // the newline characters are whitespaces (already skipped)
+        ++_at;
+    }
+}
+
+bool StrScanner::_atConstRealPrefix() const noexcept
+{
+    const auto isDigitAt = [this](const char * const at) {
+        return at < _end && *at >= '0' && *at <= '9';
+    };
+
+    auto at = _at;
+
+    // optional negation
+    if (at != _end && *at == '-') {
+        ++at;
+    }
+
+    // integer part: `0` or a nonzero digit followed with digits
+    if (!isDigitAt(at)) {
+        return false;
+    }
+
+    if (*at == '0') {
+        ++at;
+    } else {
+        while (isDigitAt(at)) {
+            ++at;
+        }
+    }
+
+    // need a fraction or exponent part: `.`, `e`, or `E`, then a digit
+    if (at == _end || (*at != '.' && *at != 'e' && *at != 'E')) {
+        return false;
+    }
+
+    return isDigitAt(at + 1);
+}
+
 void StrScanner::_skipWhitespaces()
 {
     while (!this->isDone()) {
@@ -205,6 +306,59 @@ bool StrScanner::_tryAppendEscapedChar(const char * const escapeSeqStartList)
     return false;
 }
 
+void StrScanner::_skipCommentsAndWhitespacesMemo()
+{
+    auto& entry = _skipMemo[static_cast<Index>(_at - _begin) % _skipMemo.size()];
+
+    if (entry.from == _at) {
+        // already skipped from this position
+        _at = entry.to;
+
+        if (entry.nbNewLines > 0) {
+            _nbLines += entry.nbNewLines;
+            _lineBegin = entry.lineBegin;
+        }
+
+        return;
+    }
+
+    const auto from = _at;
+    const auto nbLines = _nbLines;
+
+    this->_skipCommentsAndWhitespaces<true, true>();
+    entry.from = from;
+    entry.to = _at;
+    entry.nbNewLines = _nbLines - nbLines;
+    entry.lineBegin = _lineBegin;
+}
+
+StrScanner::_tTokenMemoEntry& StrScanner::_tokenMemoEntry()
+{
+    auto& entry = _tokenMemo[static_cast<Index>(_at - _begin) % _tokenMemo.size()];
+
+    if (entry.from == _at) {
+        // already scanned from this position
+        return entry;
+    }
+
+    auto at = _at;
+
+    // first character: `_` or alpha
+    if (at != _end && (*at == '_' || std::isalpha(*at))) {
+        ++at;
+
+        // other characters: `_` or alphanumeric
+        while (at != _end && (*at == '_' || std::isalnum(*at))) {
+            ++at;
+        }
+    }
+
+    entry.from = _at;
+    entry.identEnd = at;
+    entry.ident.assign(_at, at);
+    return entry;
+}
+
 void StrScanner::_skipComment()
 {
     if (this->charsLeft() >= 2) {
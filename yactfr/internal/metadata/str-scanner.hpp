@@ -13,7 +13,6 @@
 #include <memory>
 #include <vector>
 #include <limits>
-#include <regex>
 #include <cmath>
 #include <array>
 #include <boost/utility.hpp>
@@ -58,6 +57,23 @@ namespace internal {
 class StrScanner final :
     private boost::noncopyable
 {
+public:
+    /*
+     * Scanning position, including what's needed to compute its text
+     * location.
+     */
+    struct Pos final
+    {
+        // character pointer
+        const char *at;
+
+        // position of the beginning of the line of `at`
+        const char *lineBegin;
+
+        // number of lines before `at`
+        Size nbLines;
+    };
+
 public:
     /*
      * Builds a string scanner, wrapping a string between `begin`
@@ -90,6 +106,29 @@ public:
         _at = at;
     }
 
+    /*
+     * Returns the current position.
+     */
+    Pos pos() const noexcept
+    {
+        return Pos {_at, _lineBegin, _nbLines};
+    }
+
+    /*
+     * Sets the current position to `pos`, which you got with pos(),
+     * possibly from another string scanner wrapping the same string.
+     *
+     * Unlike at(const char *), this method keeps the current location
+     * (loc()) valid.
+     */
+    void pos(const Pos& pos)
+    {
+        assert(pos.at >= _begin && pos.at <= _end);
+        _at = pos.at;
+        _lineBegin = pos.lineBegin;
+        _nbLines = pos.nbLines;
+    }
+
     /*
      * Returns the beginning character pointer, the one with which this
      * string scanner was built.
@@ -144,6 +183,12 @@ public:
      */
     void reset();
 
+    /*
+     * Makes this string scanner wrap the string between `begin`
+     * (included) and `end` (excluded) instead, and resets it.
+     */
+    void reset(const char *begin, const char *end);
+
     /*
      * Pushes the current character pointer position on the character
      * pointer stack.
@@ -156,7 +201,7 @@ public:
      */
     void save()
     {
-        _stack.push_back({_at, _lineBegin, _nbLines});
+        _stack.push_back(this->pos());
     }
 
     /*
@@ -190,6 +235,10 @@ public:
      *
      * The returned string remains valid as long as you don't call any
      * method of this object.
+     *
+     * Scanning an identifier again from the same position (after a
+     * backtrack, for example) doesn't read its characters again (see
+     * `_tokenMemo`).
      */
     template <bool SkipWsV, bool SkipCommentsV>
     const std::string *tryScanIdent();
@@ -342,6 +391,16 @@ public:
         return this->tryScanToken<true, true>(token);
     }
 
+    /*
+     * Tries to skip a block, from `{` to its matching `}`, without
+     * scanning what's within it, except for comments and literal
+     * strings, placing the current character pointer after the closing
+     * `}` on success.
+     *
+     * Returns whether or not a complete block was skipped.
+     */
+    bool trySkipBlock();
+
     /*
      * Skips the following whitespaces (if `SkipWsV` is true) and
      * comments (if `SkipCommentsV` is true).
@@ -353,6 +412,69 @@ public:
             return;
         }
 
+        if (this->isDone()) {
+            return;
+        }
+
+        switch (*_at) {
+        case ' ':
+        case '\t':
+        case '\v':
+        case '\n':
+        case '\r':
+        case '/':
+            break;
+
+        default:
+            // already at the beginning of a token: nothing to skip
+            return;
+        }
+
+        if (SkipWsV && SkipCommentsV) {
+            this->_skipCommentsAndWhitespacesMemo();
+        } else {
+            this->_skipCommentsAndWhitespaces<SkipWsV, SkipCommentsV>();
+        }
+    }
+
+private:
+    /*
+     * An entry of the skip memo (see `_skipMemo`).
+     */
+    struct _tSkipMemoEntry final
+    {
+        // position from which the scanner skipped (`nullptr`: unused entry)
+        const char *from = nullptr;
+
+        // resulting position: beginning of the next token
+        const char *to;
+
+        // number of newline characters between `from` and `to`
+        Size nbNewLines;
+
+        // beginning of the line of `to` if `nbNewLines` isn't zero
+        const char *lineBegin;
+    };
+
+    /*
+     * An entry of the token memo (see `_tokenMemo`).
+     */
+    struct _tTokenMemoEntry final
+    {
+        // beginning of the token (`nullptr`: unused entry)
+        const char *from = nullptr;
+
+        // end of the C identifier at `from`, or `from` if there's none
+        const char *identEnd;
+
+        // C identifier at `from` (empty if there's none)
+        std::string ident;
+    };
+
+private:
+    template <bool SkipWsV, bool SkipCommentsV>
+    void _skipCommentsAndWhitespaces()
+    {
         while (!this->isDone()) {
             const auto at = _at;
 
@@ -371,23 +493,19 @@ public:
         }
     }
 
-private:
     /*
-     * A frame of the character pointer stack.
+     * Skips the following whitespaces and comments, reusing the result
+     * of a previous skip from the same position, if any.
      */
-    struct _tStackFrame final
-    {
-        // position when save() was called
-        const char *at;
+    void _skipCommentsAndWhitespacesMemo();
 
-        // position of the beginning of the current line when save() was called
-        const char *lineBegin;
-
-        // number of lines scanned so far when save was called()
-        Size nbLines;
-    };
+    /*
+     * Returns the token memo entry of the current position, scanning
+     * the C identifier at the current position (without moving the
+     * current character pointer) if it's not already known.
+     */
+    _tTokenMemoEntry& _tokenMemoEntry();
 
-private:
     template <typename ValT>
     static boost::optional<ValT> _tryNegateConstInt(unsigned long long ullVal, bool negate);
 
@@ -397,6 +515,18 @@ private:
     template <typename ValT, int BaseV>
     boost::optional<ValT> _tryScanConstInt(bool negate);
 
+    /*
+     * Returns whether or not the characters at the current position
+     * start like a JSON constant real number having a fraction and/or
+     * an exponent part, that is, whether or not they match the
+     * ECMAScript regular expression
+     *
+     *     ^-?(?:0|[1-9]\d*)(?=[eE.]\d)
+     *
+     * which is what std::strtod() may then parse.
+     */
+    bool _atConstRealPrefix() const noexcept;
+
     void _skipComment();
     void _skipWhitespaces();
     void _appendEscapedUnicodeChar(const char *at);
@@ -422,11 +552,6 @@ private:
         return c;
     }
 
-    _tStackFrame& _stackTop()
-    {
-        return _stack.back();
-    }
-
     void _checkNewLine()
     {
         if (*_at == '\n') {
@@ -452,7 +577,31 @@ private:
     Size _nbLines = 0;
 
     // character pointer stack
-    std::vector<_tStackFrame> _stack;
+    std::vector<Pos> _stack;
+
+    /*
+     * Skip memo: the results of the latest skips of whitespaces and
+     * comments, indexed by starting offset (modulo the size).
+     *
+     * A backtracking parser (see reject()) typically tries several
+     * alternatives from the same position, each one skipping the same
+     * whitespaces and comments between the same tokens again: with
+     * this memo, finding the beginning of a token which the scanner
+     * already found is a single lookup.
+     */
+    std::array<_tSkipMemoEntry, 64> _skipMemo;
+
+    /*
+     * Token memo: the C identifiers (or their absence) which the
+     * scanner found at the beginnings of the latest tokens, indexed by
+     * offset (modulo the size).
+     *
+     * After a backtrack, the parser asks for an identifier at a
+     * position where it already scanned one (for example, the
+     * type name of a field, which many alternatives start with): this
+     * memo turns such a scan into a single lookup without any copy.
+     */
+    std::array<_tTokenMemoEntry, 64> _tokenMemo;
 
     // conversion buffer used to scan constant integers
     std::array<char, 72> _convBuf;
@@ -460,8 +609,6 @@ private:
     // string buffer
     std::string _strBuf;
 
-    // real number string regex
-    static const std::regex _realRegex;
 };
 
 template <bool SkipWsV, bool SkipCommentsV>
@@ -469,36 +616,15 @@ const std::string *StrScanner::tryScanIdent()
 {
     this->skipCommentsAndWhitespaces<SkipWsV, SkipCommentsV>();
 
-    // first character: `_` or alpha
-    const auto c = this->_scanAnyChar();
-
-    if (c < 0) {
-        return nullptr;
-    }
-
-    auto chr = static_cast<char>(c);
+    auto& entry = this->_tokenMemoEntry();
 
-    if (chr != '_' && !std::isalpha(chr)) {
-        --_at;
+    if (entry.identEnd == _at) {
+        // no identifier here
         return nullptr;
     }
 
-    _strBuf.clear();
-    _strBuf.push_back(chr);
-
-    // other characters: `_` or alphanumeric
-    while (!this->isDone()) {
-        chr = *_at;
-
-        if (chr != '_' && !std::isalpha(chr) && !std::isdigit(chr)) {
-            break;
-        }
-
-        _strBuf.push_back(chr);
-        ++_at;
-    }
-
-    return &_strBuf;
+    _at = entry.identEnd;
+    return &entry.ident;
 }
 
 template <bool SkipWsV, bool SkipCommentsV>
@@ -789,7 +915,7 @@ boost::optional<double> StrScanner::tryScanConstReal()
      * This is needed because std::strtod() accepts more formats which
      * JSON doesn't support.
      */
-    if (!std::regex_search(_at, _end, StrScanner::_realRegex)) {
+    if (!this->_atConstRealPrefix()) {
         return boost::none;
     }
 
@@ -0,0 +1,1664 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <sstream>
+#include <set>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include <yactfr/metadata/dt-visitor.hpp>
+#include <yactfr/metadata/fl-bit-array-type.hpp>
+#include <yactfr/metadata/fl-bit-map-type.hpp>
+#include <yactfr/metadata/fl-bool-type.hpp>
+#include <yactfr/metadata/fl-int-type.hpp>
+#include <yactfr/metadata/fl-float-type.hpp>
+#include <yactfr/metadata/vl-int-type.hpp>
+#include <yactfr/metadata/nt-str-type.hpp>
+#include <yactfr/metadata/sl-str-type.hpp>
+#include <yactfr/metadata/dl-str-type.hpp>
+#include <yactfr/metadata/sl-blob-type.hpp>
+#include <yactfr/metadata/dl-blob-type.hpp>
+#include <yactfr/metadata/struct-type.hpp>
+#include <yactfr/metadata/sl-array-type.hpp>
+#include <yactfr/metadata/dl-array-type.hpp>
+#include <yactfr/metadata/var-type.hpp>
+#include <yactfr/metadata/opt-type.hpp>
+#include <yactfr/metadata/item.hpp>
+
+#include "trace-type-bin.hpp"
+
+namespace yactfr {
+namespace internal {
+namespace {
+
+/*
+ * Binary trace type format
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ * A binary trace type is:
+ *
+ * 1. The 8-byte magic `YACTFRTT`.
+ * 2. The format version (`traceTypeBinFormatVersion`).
+ * 3. The size and bytes of the original metadata text.
+ * 4. The optional metadata stream UUID.
+ * 5. The trace type.
+ * 6. The 64-bit FNV-1a hash of all the preceding bytes, least
+ *    significant byte first.
+ *
+ * Unsigned integers are ULEB128-encoded, signed integers are
+ * zigzag-then-ULEB128-encoded, and real numbers are the 8 bytes of
+ * their IEEE 754 representation, least significant byte first.
+ *
+ * A string is its size followed with its bytes. An optional value is a
+ * boolean (whether or not it's set) followed with the value, if set.
+ *
+ * A data type is a data type tag (`DtTag`), its alignment (minimum
+ * alignment for a compound data type), its optional attributes, and
+ * then the properties specific to its kind.
+ *
+ * The reader validates each decoded value against the preconditions of
+ * the public constructor which receives it. It doesn't resolve data
+ * locations again: the trailing hash rejects a corrupted binary trace
+ * type of which the data locations could be invalid.
+ */
+constexpr char binMagic[] = {'Y', 'A', 'C', 'T', 'F', 'R', 'T', 'T'};
+
+/*
+ * Returns the 64-bit FNV-1a hash of the bytes from `begin` to `end`.
+ */
+std::uint64_t binHash(const char *begin, const char * const end) noexcept
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (; begin != end; ++begin) {
+        hash ^= static_cast<unsigned char>(*begin);
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+enum class DtTag
+{
+    FlBitArray,
+    FlBitMap,
+    FlBool,
+    FlSInt,
+    FlUInt,
+    FlFloat,
+    VlSInt,
+    VlUInt,
+    NtStr,
+    SlStr,
+    DlStr,
+    SlBlob,
+    DlBlob,
+    Struct,
+    SlArray,
+    DlArray,
+    VarUIntSel,
+    VarSIntSel,
+    OptBoolSel,
+    OptUIntSel,
+    OptSIntSel,
+};
+
+constexpr unsigned int lastDtTag = static_cast<unsigned int>(DtTag::OptSIntSel);
+
+/*
+ * Appends the binary form of a trace type to some string.
+ */
+class TraceTypeBinWriter final :
+    public DataTypeVisitor
+{
+public:
+    explicit TraceTypeBinWriter(std::string& buf) :
+        _buf {&buf}
+    {
+    }
+
+    void writeHeader(const char * const metadataTextBegin, const char * const metadataTextEnd)
+    {
+        _buf->append(binMagic, sizeof binMagic);
+        this->_writeUInt(traceTypeBinFormatVersion);
+        this->_writeUInt(metadataTextEnd - metadataTextBegin);
+        _buf->append(metadataTextBegin, metadataTextEnd);
+    }
+
+    void writeHash()
+    {
+        auto hash = binHash(_buf->data(), _buf->data() + _buf->size());
+
+        for (auto i = 0U; i < 8; ++i) {
+            _buf->push_back(static_cast<char>(hash & 0xff));
+            hash >>= 8;
+        }
+    }
+
+    void writeMetadataStreamUuid(const boost::optional<boost::uuids::uuid>& uuid)
+    {
+        this->_writeOpt(uuid, [this](const boost::uuids::uuid& uuidVal) {
+            this->_writeUuid(uuidVal);
+        });
+    }
+
+    void writeTraceType(const TraceType& traceType)
+    {
+        this->_writeUInt(traceType.majorVersion());
+        this->_writeUInt(traceType.minorVersion());
+        this->_writeOptStr(traceType.nameSpace());
+        this->_writeOptStr(traceType.name());
+        this->_writeOptStr(traceType.uid());
+
+        // environment
+        this->_writeUInt(traceType.environment().entries().size());
+
+        for (const auto& keyEntryPair : traceType.environment().entries()) {
+            this->_writeStr(keyEntryPair.first);
+
+            if (const auto strEntry = boost::get<std::string>(&keyEntryPair.second)) {
+                this->_writeBool(true);
+                this->_writeStr(*strEntry);
+            } else {
+                this->_writeBool(false);
+                this->_writeSInt(boost::get<long long>(keyEntryPair.second));
+            }
+        }
+
+        this->_writeOptDt(traceType.packetHeaderType());
+
+        // clock types
+        this->_writeUInt(traceType.clockTypes().size());
+
+        for (const auto& clkType : traceType.clockTypes()) {
+            const auto index = _clkTypeIndexes.size();
+
+            _clkTypeIndexes.emplace(clkType.get(), index);
+            this->_writeClkType(*clkType);
+        }
+
+        // data stream types
+        this->_writeUInt(traceType.dataStreamTypes().size());
+
+        for (const auto& dst : traceType.dataStreamTypes()) {
+            this->_writeDst(*dst);
+        }
+
+        this->_writeAttrs(traceType.attributes());
+    }
+
+    void visit(const FixedLengthBitArrayType& dt) override
+    {
+        this->_writeDtCommon(DtTag::FlBitArray, dt, dt.alignment());
+        this->_writeFlBitArrayTypeProps(dt);
+    }
+
+    void visit(const FixedLengthBitMapType& dt) override
+    {
+        this->_writeDtCommon(DtTag::FlBitMap, dt, dt.alignment());
+        this->_writeFlBitArrayTypeProps(dt);
+        this->_writeRangeSetMap(dt.flags());
+    }
+
+    void visit(const FixedLengthBooleanType& dt) override
+    {
+        this->_writeDtCommon(DtTag::FlBool, dt, dt.alignment());
+        this->_writeFlBitArrayTypeProps(dt);
+    }
+
+    void visit(const FixedLengthSignedIntegerType& dt) override
+    {
+        this->_writeDtCommon(DtTag::FlSInt, dt, dt.alignment());
+        this->_writeFlBitArrayTypeProps(dt);
+        this->_writeIntTypeProps(dt);
+    }
+
+    void visit(const FixedLengthUnsignedIntegerType& dt) override
+    {
+        this->_writeDtCommon(DtTag::FlUInt, dt, dt.alignment());
+        this->_writeFlBitArrayTypeProps(dt);
+        this->_writeIntTypeProps(dt);
+        this->_writeRoles(dt.roles());
+    }
+
+    void visit(const FixedLengthFloatingPointNumberType& dt) override
+    {
+        this->_writeDtCommon(DtTag::FlFloat, dt, dt.alignment());
+        this->_writeFlBitArrayTypeProps(dt);
+    }
+
+    void visit(const VariableLengthSignedIntegerType& dt) override
+    {
+        this->_writeDtCommon(DtTag::VlSInt, dt, dt.alignment());
+        this->_writeIntTypeProps(dt);
+    }
+
+    void visit(const VariableLengthUnsignedIntegerType& dt) override
+    {
+        this->_writeDtCommon(DtTag::VlUInt, dt, dt.alignment());
+        this->_writeIntTypeProps(dt);
+        this->_writeRoles(dt.roles());
+    }
+
+    void visit(const NullTerminatedStringType& dt) override
+    {
+        this->_writeDtCommon(DtTag::NtStr, dt, dt.alignment());
+        this->_writeEnum(dt.encoding());
+    }
+
+    void visit(const StaticLengthStringType& dt) override
+    {
+        this->_writeDtCommon(DtTag::SlStr, dt, dt.alignment());
+        this->_writeEnum(dt.encoding());
+        this->_writeUInt(dt.maximumLength());
+    }
+
+    void visit(const DynamicLengthStringType& dt) override
+    {
+        this->_writeDtCommon(DtTag::DlStr, dt, dt.alignment());
+        this->_writeEnum(dt.encoding());
+        this->_writeDataLoc(dt.maximumLengthLocation());
+    }
+
+    void visit(const StaticLengthBlobType& dt) override
+    {
+        this->_writeDtCommon(DtTag::SlBlob, dt, dt.alignment());
+        this->_writeStr(dt.mediaType());
+        this->_writeUInt(dt.length());
+        this->_writeBool(dt.hasMetadataStreamUuidRole());
+    }
+
+    void visit(const DynamicLengthBlobType& dt) override
+    {
+        this->_writeDtCommon(DtTag::DlBlob, dt, dt.alignment());
+        this->_writeStr(dt.mediaType());
+        this->_writeDataLoc(dt.lengthLocation());
+    }
+
+    void visit(const StructureType& dt) override
+    {
+        this->_writeDtCommon(DtTag::Struct, dt, dt.minimumAlignment());
+        this->_writeUInt(dt.size());
+
+        for (const auto& memberType : dt) {
+            this->_writeStr(memberType->name());
+            memberType->dataType().accept(*this);
+            this->_writeAttrs(memberType->attributes());
+        }
+    }
+
+    void visit(const StaticLengthArrayType& dt) override
+    {
+        this->_writeDtCommon(DtTag::SlArray, dt, dt.minimumAlignment());
+        dt.elementType().accept(*this);
+        this->_writeUInt(dt.length());
+        this->_writeBool(dt.hasMetadataStreamUuidRole());
+    }
+
+    void visit(const DynamicLengthArrayType& dt) override
+    {
+        this->_writeDtCommon(DtTag::DlArray, dt, dt.minimumAlignment());
+        dt.elementType().accept(*this);
+        this->_writeDataLoc(dt.lengthLocation());
+    }
+
+    void visit(const VariantWithUnsignedIntegerSelectorType& dt) override
+    {
+        this->_writeDtCommon(DtTag::VarUIntSel, dt, dt.minimumAlignment());
+        this->_writeVarTypeProps(dt);
+    }
+
+    void visit(const VariantWithSignedIntegerSelectorType& dt) override
+    {
+        this->_writeDtCommon(DtTag::VarSIntSel, dt, dt.minimumAlignment());
+        this->_writeVarTypeProps(dt);
+    }
+
+    void visit(const OptionalWithBooleanSelectorType& dt) override
+    {
+        this->_writeDtCommon(DtTag::OptBoolSel, dt, dt.minimumAlignment());
+        this->_writeOptTypeProps(dt);
+    }
+
+    void visit(const OptionalWithUnsignedIntegerSelectorType& dt) override
+    {
+        this->_writeDtCommon(DtTag::OptUIntSel, dt, dt.minimumAlignment());
+        this->_writeOptTypeProps(dt);
+        this->_writeRangeSet(dt.selectorRanges());
+    }
+
+    void visit(const OptionalWithSignedIntegerSelectorType& dt) override
+    {
+        this->_writeDtCommon(DtTag::OptSIntSel, dt, dt.minimumAlignment());
+        this->_writeOptTypeProps(dt);
+        this->_writeRangeSet(dt.selectorRanges());
+    }
+
+private:
+    void _writeUInt(unsigned long long val)
+    {
+        do {
+            auto byte = static_cast<char>(val & 0x7f);
+
+            val >>= 7;
+
+            if (val != 0) {
+                byte |= 0x80;
+            }
+
+            _buf->push_back(byte);
+        } while (val != 0);
+    }
+
+    void _writeSInt(const long long val)
+    {
+        // zigzag encoding
+        this->_writeUInt((static_cast<unsigned long long>(val) << 1) ^
+                         static_cast<unsigned long long>(val >> 63));
+    }
+
+    void _writeInt(const unsigned long long val)
+    {
+        this->_writeUInt(val);
+    }
+
+    void _writeInt(const long long val)
+    {
+        this->_writeSInt(val);
+    }
+
+    void _writeBool(const bool val)
+    {
+        _buf->push_back(val ? 1 : 0);
+    }
+
+    void _writeReal(const double val)
+    {
+        std::uint64_t bits;
+
+        static_assert(sizeof bits == sizeof val, "`double` has 64 bits.");
+        std::memcpy(&bits, &val, sizeof bits);
+
+        for (auto i = 0U; i < 8; ++i) {
+            _buf->push_back(static_cast<char>((bits >> (i * 8)) & 0xff));
+        }
+    }
+
+    void _writeStr(const std::string& str)
+    {
+        this->_writeUInt(str.size());
+        _buf->append(str);
+    }
+
+    void _writeUuid(const boost::uuids::uuid& uuid)
+    {
+        _buf->append(reinterpret_cast<const char *>(uuid.begin()), uuid.size());
+    }
+
+    template <typename EnumT>
+    void _writeEnum(const EnumT val)
+    {
+        this->_writeUInt(static_cast<unsigned long long>(val));
+    }
+
+    template <typename ValT, typename WriteFuncT>
+    void _writeOpt(const boost::optional<ValT>& val, WriteFuncT&& writeFunc)
+    {
+        this->_writeBool(static_cast<bool>(val));
+
+        if (val) {
+            writeFunc(*val);
+        }
+    }
+
+    void _writeOptStr(const boost::optional<std::string>& str)
+    {
+        this->_writeOpt(str, [this](const std::string& strVal) {
+            this->_writeStr(strVal);
+        });
+    }
+
+    void _writeItem(const Item * const item)
+    {
+        // a null item is a "kind" past the last one
+        if (!item) {
+            this->_writeUInt(static_cast<unsigned long long>(ItemKind::Map) + 1);
+            return;
+        }
+
+        this->_writeEnum(item->kind());
+
+        switch (item->kind()) {
+        case ItemKind::Boolean:
+            this->_writeBool(item->asBoolean().value());
+            break;
+
+        case ItemKind::SignedInteger:
+            this->_writeSInt(item->asSignedInteger().value());
+            break;
+
+        case ItemKind::UnsignedInteger:
+            this->_writeUInt(item->asUnsignedInteger().value());
+            break;
+
+        case ItemKind::Real:
+            this->_writeReal(item->asReal().value());
+            break;
+
+        case ItemKind::String:
+            this->_writeStr(item->asString().value());
+            break;
+
+        case ItemKind::Array:
+            this->_writeUInt(item->asArray().size());
+
+            for (const auto& elemItem : item->asArray()) {
+                this->_writeItem(elemItem.get());
+            }
+
+            break;
+
+        case ItemKind::Map:
+            this->_writeUInt(item->asMap().size());
+
+            for (const auto& keyItemPair : item->asMap()) {
+                this->_writeStr(keyItemPair.first);
+                this->_writeItem(keyItemPair.second.get());
+            }
+
+            break;
+        }
+    }
+
+    void _writeAttrs(const MapItem * const attrs)
+    {
+        this->_writeBool(attrs);
+
+        if (attrs) {
+            this->_writeItem(attrs);
+        }
+    }
+
+    void _writeDataLoc(const DataLocation& loc)
+    {
+        this->_writeEnum(loc.scope());
+        this->_writeUInt(loc.size());
+
+        for (const auto& pathElem : loc) {
+            this->_writeStr(pathElem);
+        }
+    }
+
+    template <typename RangeSetT>
+    void _writeRangeSet(const RangeSetT& rangeSet)
+    {
+        this->_writeUInt(rangeSet.ranges().size());
+
+        for (const auto& range : rangeSet) {
+            this->_writeInt(range.lower());
+            this->_writeInt(range.upper());
+        }
+    }
+
+    template <typename RangeSetMapT>
+    void _writeRangeSetMap(const RangeSetMapT& map)
+    {
+        this->_writeUInt(map.size());
+
+        for (const auto& nameRangeSetPair : map) {
+            this->_writeStr(nameRangeSetPair.first);
+            this->_writeRangeSet(nameRangeSetPair.second);
+        }
+    }
+
+    void _writeRoles(const UnsignedIntegerTypeRoleSet& roles)
+    {
+        this->_writeUInt(roles.size());
+
+        for (const auto role : roles) {
+            this->_writeEnum(role);
+        }
+    }
+
+    void _writeDtCommon(const DtTag tag, const DataType& dt, const unsigned int align)
+    {
+        this->_writeEnum(tag);
+        this->_writeUInt(align);
+        this->_writeAttrs(dt.attributes());
+    }
+
+    void _writeOptDt(const DataType * const dt)
+    {
+        this->_writeBool(dt);
+
+        if (dt) {
+            dt->accept(*this);
+        }
+    }
+
+    void _writeFlBitArrayTypeProps(const FixedLengthBitArrayType& dt)
+    {
+        this->_writeUInt(dt.length());
+        this->_writeEnum(dt.byteOrder());
+        this->_writeEnum(dt.bitOrder());
+    }
+
+    template <typename IntTypeT>
+    void _writeIntTypeProps(const IntTypeT& dt)
+    {
+        this->_writeEnum(dt.preferredDisplayBase());
+        this->_writeRangeSetMap(dt.mappings());
+    }
+
+    template <typename VarTypeT>
+    void _writeVarTypeProps(const VarTypeT& dt)
+    {
+        this->_writeDataLoc(dt.selectorLocation());
+        this->_writeUInt(dt.size());
+
+        for (const auto& opt : dt) {
+            this->_writeOptStr(opt->name());
+            opt->dataType().accept(*this);
+            this->_writeRangeSet(opt->selectorRanges());
+            this->_writeAttrs(opt->attributes());
+        }
+    }
+
+    void _writeOptTypeProps(const OptionalType& dt)
+    {
+        dt.dataType().accept(*this);
+        this->_writeDataLoc(dt.selectorLocation());
+    }
+
+    void _writeClkType(const ClockType& clkType)
+    {
+        this->_writeOptStr(clkType.internalId());
+        this->_writeOptStr(clkType.nameSpace());
+        this->_writeOptStr(clkType.name());
+        this->_writeOptStr(clkType.uid());
+        this->_writeOpt(clkType.originalUuid(), [this](const boost::uuids::uuid& uuid) {
+            this->_writeUuid(uuid);
+        });
+        this->_writeUInt(clkType.frequency());
+        this->_writeOptStr(clkType.description());
+        this->_writeOpt(clkType.origin(), [this](const ClockOrigin& orig) {
+            this->_writeOptStr(orig.nameSpace());
+            this->_writeStr(orig.name());
+            this->_writeStr(orig.uid());
+        });
+        this->_writeOpt(clkType.precision(), [this](const Cycles prec) {
+            this->_writeUInt(prec);
+        });
+        this->_writeOpt(clkType.accuracy(), [this](const Cycles accuracy) {
+            this->_writeUInt(accuracy);
+        });
+        this->_writeSInt(clkType.offsetFromOrigin().seconds());
+        this->_writeUInt(clkType.offsetFromOrigin().cycles());
+        this->_writeAttrs(clkType.attributes());
+    }
+
+    void _writeErt(const EventRecordType& ert)
+    {
+        this->_writeUInt(ert.id());
+        this->_writeOptStr(ert.nameSpace());
+        this->_writeOptStr(ert.name());
+        this->_writeOptStr(ert.uid());
+        this->_writeOpt(ert.logLevel(), [this](const LogLevel logLevel) {
+            this->_writeSInt(logLevel);
+        });
+        this->_writeOptStr(ert.emfUri());
+        this->_writeOptDt(ert.specificContextType());
+        this->_writeOptDt(ert.payloadType());
+        this->_writeAttrs(ert.attributes());
+    }
+
+    void _writeDst(const DataStreamType& dst)
+    {
+        this->_writeUInt(dst.id());
+        this->_writeOptStr(dst.nameSpace());
+        this->_writeOptStr(dst.name());
+        this->_writeOptStr(dst.uid());
+        this->_writeUInt(dst.size());
+
+        for (const auto& ert : dst) {
+            this->_writeErt(*ert);
+        }
+
+        this->_writeOptDt(dst.packetContextType());
+        this->_writeOptDt(dst.eventRecordHeaderType());
+        this->_writeOptDt(dst.eventRecordCommonContextType());
+
+        // default clock type: index within the written clock types
+        this->_writeBool(dst.defaultClockType());
+
+        if (dst.defaultClockType()) {
+            assert(_clkTypeIndexes.find(dst.defaultClockType()) != _clkTypeIndexes.end());
+            this->_writeUInt(_clkTypeIndexes[dst.defaultClockType()]);
+        }
+
+        this->_writeAttrs(dst.attributes());
+    }
+
+private:
+    std::string *_buf;
+
+    // indexes of the written clock types
+    std::unordered_map<const ClockType *, Index> _clkTypeIndexes;
+};
+
+/*
+ * Reads the binary form of a trace type.
+ */
+class TraceTypeBinReader final
+{
+public:
+    explicit TraceTypeBinReader(const std::string& bin) :
+        _at {bin.data()},
+        _end {bin.data() + bin.size()}
+    {
+    }
+
+    void readHeader(const char * const metadataTextBegin, const char * const metadataTextEnd)
+    {
+        this->_readHash();
+
+        if (this->_left() < sizeof binMagic ||
+                std::memcmp(_at, binMagic, sizeof binMagic) != 0) {
+            throw InvalidTraceTypeBin {"Invalid magic."};
+        }
+
+        _at += sizeof binMagic;
+
+        const auto version = this->_readUInt();
+
+        if (version != traceTypeBinFormatVersion) {
+            std::ostringstream ss;
+
+            ss << "Unexpected format version " << version << " (expecting " <<
+                  traceTypeBinFormatVersion << ").";
+            throw InvalidTraceTypeBin {ss.str()};
+        }
+
+        const auto textSize = this->_readSize();
+        const auto expectedTextSize = static_cast<Size>(metadataTextEnd - metadataTextBegin);
+
+        if (textSize != expectedTextSize ||
+                std::memcmp(_at, metadataTextBegin, expectedTextSize) != 0) {
+            throw InvalidTraceTypeBin {"Different metadata text."};
+        }
+
+        _at += textSize;
+    }
+
+    boost::optional<boost::uuids::uuid> readMetadataStreamUuid()
+    {
+        if (!this->_readBool()) {
+            return boost::none;
+        }
+
+        return this->_readUuid();
+    }
+
+    TraceType::Up readTraceType()
+    {
+        const auto majorVersion = this->_readUInt();
+        const auto minorVersion = this->_readUInt();
+
+        if (!((majorVersion == 1 && minorVersion == 8) ||
+                (majorVersion == 2 && minorVersion == 0))) {
+            throw InvalidTraceTypeBin {"Invalid CTF version."};
+        }
+
+        _majorVersion = static_cast<unsigned int>(majorVersion);
+
+        auto ns = this->_readOptStr();
+        auto name = this->_readOptStr();
+        auto uid = this->_readOptStr();
+
+        // environment
+        TraceEnvironment::Entries envEntries;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            auto key = this->_readStr();
+
+            if (this->_readBool()) {
+                envEntries.emplace(std::move(key), this->_readStr());
+            } else {
+                envEntries.emplace(std::move(key), this->_readSInt());
+            }
+        }
+
+        auto pktHeaderType = this->_readScopeType({
+            UnsignedIntegerTypeRole::PacketMagicNumber,
+            UnsignedIntegerTypeRole::DataStreamTypeId,
+            UnsignedIntegerTypeRole::DataStreamId,
+        }, true);
+
+        // clock types
+        ClockTypeSet clkTypes;
+        std::set<std::string> clkTypeIds;
+
+        _clkTypes.clear();
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            auto clkType = this->_readClkType();
+
+            if (clkType->internalId() && !clkTypeIds.insert(*clkType->internalId()).second) {
+                throw InvalidTraceTypeBin {"Duplicate clock type internal ID."};
+            }
+
+            _clkTypes.push_back(clkType.get());
+            clkTypes.insert(std::move(clkType));
+        }
+
+        // data stream types
+        DataStreamTypeSet dsts;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            if (!dsts.insert(this->_readDst()).second) {
+                throw InvalidTraceTypeBin {"Duplicate data stream type ID."};
+            }
+        }
+
+        auto attrs = this->_readAttrs();
+
+        if (_at != _end) {
+            throw InvalidTraceTypeBin {"Extra data after trace type."};
+        }
+
+        return TraceType::create(majorVersion, minorVersion, std::move(ns), std::move(name),
+                                 std::move(uid), TraceEnvironment {std::move(envEntries)},
+                                 std::move(pktHeaderType), std::move(clkTypes), std::move(dsts),
+                                 std::move(attrs));
+    }
+
+private:
+    Size _left() const noexcept
+    {
+        return _end - _at;
+    }
+
+    /*
+     * Checks the trailing hash of the binary trace type and excludes
+     * it from the bytes to read.
+     */
+    void _readHash()
+    {
+        this->_ensureLeft(8);
+        _end -= 8;
+
+        std::uint64_t expectedHash = 0;
+
+        for (auto i = 0U; i < 8; ++i) {
+            expectedHash |= static_cast<std::uint64_t>(static_cast<unsigned char>(_end[i])) <<
+                            (i * 8);
+        }
+
+        if (binHash(_at, _end) != expectedHash) {
+            throw InvalidTraceTypeBin {"Invalid hash."};
+        }
+    }
+
+    void _ensureLeft(const Size size) const
+    {
+        if (this->_left() < size) {
+            throw InvalidTraceTypeBin {"Truncated binary trace type."};
+        }
+    }
+
+    unsigned long long _readUInt()
+    {
+        unsigned long long val = 0;
+
+        for (unsigned int shift = 0; shift < 64; shift += 7) {
+            this->_ensureLeft(1);
+
+            const auto byte = static_cast<unsigned char>(*_at);
+
+            ++_at;
+            val |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+
+            if (!(byte & 0x80)) {
+                return val;
+            }
+        }
+
+        throw InvalidTraceTypeBin {"Invalid unsigned integer."};
+    }
+
+    long long _readSInt()
+    {
+        const auto val = this->_readUInt();
+
+        // zigzag decoding
+        return static_cast<long long>((val >> 1) ^ (~(val & 1) + 1));
+    }
+
+    /*
+     * Reads a size, making sure it's not greater than the number of
+     * remaining bytes so that a corrupted size can't make this reader
+     * reserve too much memory or loop for too long.
+     */
+    Size _readSize()
+    {
+        const auto size = this->_readUInt();
+
+        this->_ensureLeft(size);
+        return size;
+    }
+
+    void _readInt(unsigned long long& val)
+    {
+        val = this->_readUInt();
+    }
+
+    void _readInt(long long& val)
+    {
+        val = this->_readSInt();
+    }
+
+    bool _readBool()
+    {
+        this->_ensureLeft(1);
+
+        const auto byte = *_at;
+
+        ++_at;
+
+        if (byte != 0 && byte != 1) {
+            throw InvalidTraceTypeBin {"Invalid boolean."};
+        }
+
+        return byte == 1;
+    }
+
+    double _readReal()
+    {
+        this->_ensureLeft(8);
+
+        std::uint64_t bits = 0;
+
+        for (auto i = 0U; i < 8; ++i) {
+            bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(_at[i])) << (i * 8);
+        }
+
+        _at += 8;
+
+        double val;
+
+        std::memcpy(&val, &bits, sizeof val);
+        return val;
+    }
+
+    std::string _readStr()
+    {
+        const auto size = this->_readSize();
+        std::string str {_at, _at + size};
+
+        _at += size;
+        return str;
+    }
+
+    boost::uuids::uuid _readUuid()
+    {
+        boost::uuids::uuid uuid;
+
+        this->_ensureLeft(uuid.static_size());
+        std::copy(_at, _at + uuid.static_size(), uuid.begin());
+        _at += uuid.static_size();
+        return uuid;
+    }
+
+    template <typename EnumT>
+    EnumT _readEnum(const unsigned int lastVal)
+    {
+        const auto val = this->_readUInt();
+
+        if (val > lastVal) {
+            throw InvalidTraceTypeBin {"Invalid enumerator."};
+        }
+
+        return static_cast<EnumT>(val);
+    }
+
+    boost::optional<std::string> _readOptStr()
+    {
+        if (!this->_readBool()) {
+            return boost::none;
+        }
+
+        return this->_readStr();
+    }
+
+    Item::Up _readItem()
+    {
+        const auto kind = this->_readUInt();
+
+        if (kind == static_cast<unsigned long long>(ItemKind::Map) + 1) {
+            // null item
+            return nullptr;
+        }
+
+        switch (static_cast<ItemKind>(this->_checkItemKind(kind))) {
+        case ItemKind::Boolean:
+            return createItem(this->_readBool());
+
+        case ItemKind::SignedInteger:
+            return createItem(this->_readSInt());
+
+        case ItemKind::UnsignedInteger:
+            return createItem(this->_readUInt());
+
+        case ItemKind::Real:
+            return createItem(this->_readReal());
+
+        case ItemKind::String:
+            return createItem(this->_readStr());
+
+        case ItemKind::Array:
+        {
+            ArrayItem::Container items;
+
+            for (auto i = this->_readSize(); i > 0; --i) {
+                items.push_back(this->_readItem());
+            }
+
+            return createItem(std::move(items));
+        }
+
+        case ItemKind::Map:
+            return this->_readMapItem();
+        }
+
+        std::abort();
+    }
+
+    unsigned long long _checkItemKind(const unsigned long long kind) const
+    {
+        if (kind > static_cast<unsigned long long>(ItemKind::Map)) {
+            throw InvalidTraceTypeBin {"Invalid item kind."};
+        }
+
+        return kind;
+    }
+
+    MapItem::Up _readMapItem()
+    {
+        MapItem::Container items;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            auto key = this->_readStr();
+
+            items.emplace(std::move(key), this->_readItem());
+        }
+
+        return createItem(std::move(items));
+    }
+
+    MapItem::Up _readAttrs()
+    {
+        if (!this->_readBool()) {
+            return nullptr;
+        }
+
+        if (_majorVersion == 1) {
+            throw InvalidTraceTypeBin {"Unexpected attributes (CTF 1)."};
+        }
+
+        if (this->_readUInt() != static_cast<unsigned long long>(ItemKind::Map)) {
+            throw InvalidTraceTypeBin {"Expecting a map item."};
+        }
+
+        return this->_readMapItem();
+    }
+
+    DataLocation _readDataLoc()
+    {
+        const auto scope = this->_readEnum<Scope>(static_cast<unsigned int>(Scope::EventRecordPayload));
+        DataLocation::PathElements pathElems;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            pathElems.push_back(this->_readStr());
+        }
+
+        return DataLocation {scope, std::move(pathElems)};
+    }
+
+    template <typename RangeSetT>
+    RangeSetT _readRangeSet()
+    {
+        std::set<typename RangeSetT::Range> ranges;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            typename RangeSetT::Value lower, upper;
+
+            this->_readInt(lower);
+            this->_readInt(upper);
+
+            if (lower > upper) {
+                throw InvalidTraceTypeBin {"Invalid integer range."};
+            }
+
+            ranges.insert(typename RangeSetT::Range {lower, upper});
+        }
+
+        return RangeSetT {std::move(ranges)};
+    }
+
+    template <typename RangeSetMapT>
+    RangeSetMapT _readRangeSetMap()
+    {
+        RangeSetMapT map;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            auto name = this->_readStr();
+
+            map.emplace(std::move(name),
+                        this->_readRangeSet<typename RangeSetMapT::mapped_type>());
+        }
+
+        return map;
+    }
+
+    UnsignedIntegerTypeRoleSet _readRoles()
+    {
+        UnsignedIntegerTypeRoleSet roles;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            const auto role = this->_readEnum<UnsignedIntegerTypeRole>(static_cast<unsigned int>(UnsignedIntegerTypeRole::EventRecordTypeId));
+
+            if (_allowedRoles.find(role) == _allowedRoles.end()) {
+                throw InvalidTraceTypeBin {"Unexpected unsigned integer type role."};
+            }
+
+            if (role == UnsignedIntegerTypeRole::DefaultClockTimestamp ||
+                    role == UnsignedIntegerTypeRole::PacketEndDefaultClockTimestamp) {
+                _hasDefClkRole = true;
+            }
+
+            roles.insert(role);
+        }
+
+        return roles;
+    }
+
+    /*
+     * Reads a metadata stream UUID role flag for a static-length
+     * array/BLOB type of length `len` which is only valid with CTF
+     * `majorVersion`.
+     */
+    bool _readMsUuidRole(const unsigned long long len, const unsigned int majorVersion)
+    {
+        if (!this->_readBool()) {
+            return false;
+        }
+
+        if (!_isMsUuidRoleAllowed || _majorVersion != majorVersion || len != 16) {
+            throw InvalidTraceTypeBin {"Unexpected metadata stream UUID role."};
+        }
+
+        return true;
+    }
+
+    /*
+     * Checks the alignment `align` of a string or BLOB type.
+     */
+    unsigned int _checkByteAlign(const unsigned int align) const
+    {
+        if (align < 8) {
+            throw InvalidTraceTypeBin {"Invalid string or BLOB type alignment."};
+        }
+
+        return align;
+    }
+
+    StringEncoding _readStrEncoding()
+    {
+        return this->_readEnum<StringEncoding>(static_cast<unsigned int>(StringEncoding::Utf32Le));
+    }
+
+    DisplayBase _readDispBase()
+    {
+        const auto val = this->_readUInt();
+
+        if (val != 2 && val != 8 && val != 10 && val != 16) {
+            throw InvalidTraceTypeBin {"Invalid display base."};
+        }
+
+        return static_cast<DisplayBase>(val);
+    }
+
+    unsigned int _readAlign()
+    {
+        const auto align = this->_readUInt();
+
+        if (align == 0 || (align & (align - 1)) != 0) {
+            throw InvalidTraceTypeBin {"Invalid alignment."};
+        }
+
+        return static_cast<unsigned int>(align);
+    }
+
+    /*
+     * Fixed-length bit array type properties.
+     */
+    struct _tFlBitArrayTypeProps final
+    {
+        unsigned int len;
+        ByteOrder bo;
+        BitOrder bio;
+    };
+
+    _tFlBitArrayTypeProps _readFlBitArrayTypeProps()
+    {
+        const auto len = this->_readUInt();
+
+        if (len == 0 || len > 64) {
+            throw InvalidTraceTypeBin {"Invalid fixed-length bit array type length."};
+        }
+
+        const auto bo = this->_readEnum<ByteOrder>(static_cast<unsigned int>(ByteOrder::Little));
+        const auto bio = this->_readEnum<BitOrder>(static_cast<unsigned int>(BitOrder::LastToFirst));
+
+        return {static_cast<unsigned int>(len), bo, bio};
+    }
+
+    template <typename VarTypeT>
+    DataType::Up _readVarType(const unsigned int minAlign, MapItem::Up attrs)
+    {
+        auto selLoc = this->_readDataLoc();
+        typename VarTypeT::Options opts;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            auto name = this->_readOptStr();
+            auto dt = this->_readDt();
+            auto selRanges = this->_readRangeSet<typename VarTypeT::Option::SelectorRangeSet>();
+
+            for (const auto& opt : opts) {
+                if (opt->selectorRanges().intersects(selRanges)) {
+                    throw InvalidTraceTypeBin {"Overlapping variant type option selector ranges."};
+                }
+            }
+
+            opts.push_back(VarTypeT::Option::create(std::move(name), std::move(dt),
+                                                    std::move(selRanges), this->_readAttrs()));
+        }
+
+        if (opts.empty()) {
+            throw InvalidTraceTypeBin {"Variant type without options."};
+        }
+
+        return VarTypeT::create(minAlign, std::move(opts), std::move(selLoc), std::move(attrs));
+    }
+
+    template <typename OptTypeT>
+    DataType::Up _readOptIntSelType(const unsigned int minAlign, MapItem::Up attrs)
+    {
+        auto dt = this->_readDt();
+        auto selLoc = this->_readDataLoc();
+        auto selRanges = this->_readRangeSet<typename OptTypeT::SelectorRangeSet>();
+
+        return OptTypeT::create(minAlign, std::move(dt), std::move(selLoc), std::move(selRanges),
+                                std::move(attrs));
+    }
+
+    DataType::Up _readDt()
+    {
+        const auto tag = this->_readEnum<DtTag>(lastDtTag);
+
+        if (_majorVersion == 1) {
+            switch (tag) {
+            case DtTag::VlSInt:
+            case DtTag::VlUInt:
+            case DtTag::SlBlob:
+            case DtTag::DlBlob:
+            case DtTag::OptBoolSel:
+            case DtTag::OptUIntSel:
+            case DtTag::OptSIntSel:
+                throw InvalidTraceTypeBin {"Unexpected data type (CTF 1)."};
+
+            default:
+                break;
+            }
+        }
+
+        const auto align = this->_readAlign();
+        auto attrs = this->_readAttrs();
+
+        switch (tag) {
+        case DtTag::FlBitArray:
+        {
+            const auto props = this->_readFlBitArrayTypeProps();
+
+            return FixedLengthBitArrayType::create(align, props.len, props.bo, props.bio,
+                                                   std::move(attrs));
+        }
+
+        case DtTag::FlBitMap:
+        {
+            const auto props = this->_readFlBitArrayTypeProps();
+            auto flags = this->_readRangeSetMap<FixedLengthBitMapType::Flags>();
+
+            if (flags.empty()) {
+                throw InvalidTraceTypeBin {"Fixed-length bit map type without flags."};
+            }
+
+            for (const auto& nameRangesPair : flags) {
+                for (const auto& range : nameRangesPair.second) {
+                    if (range.upper() >= props.len) {
+                        throw InvalidTraceTypeBin {"Invalid fixed-length bit map type flag."};
+                    }
+                }
+            }
+
+            return FixedLengthBitMapType::create(align, props.len, props.bo, std::move(flags),
+                                                 props.bio, std::move(attrs));
+        }
+
+        case DtTag::FlBool:
+        {
+            const auto props = this->_readFlBitArrayTypeProps();
+
+            return FixedLengthBooleanType::create(align, props.len, props.bo, props.bio,
+                                                  std::move(attrs));
+        }
+
+        case DtTag::FlSInt:
+        {
+            const auto props = this->_readFlBitArrayTypeProps();
+            const auto dispBase = this->_readDispBase();
+            auto mappings = this->_readRangeSetMap<FixedLengthSignedIntegerType::Mappings>();
+
+            return FixedLengthSignedIntegerType::create(align, props.len, props.bo, props.bio,
+                                                        dispBase, std::move(mappings),
+                                                        std::move(attrs));
+        }
+
+        case DtTag::FlUInt:
+        {
+            const auto props = this->_readFlBitArrayTypeProps();
+            const auto dispBase = this->_readDispBase();
+            auto mappings = this->_readRangeSetMap<FixedLengthUnsignedIntegerType::Mappings>();
+
+            return FixedLengthUnsignedIntegerType::create(align, props.len, props.bo, props.bio,
+                                                          dispBase, std::move(mappings),
+                                                          std::move(attrs), this->_readRoles());
+        }
+
+        case DtTag::FlFloat:
+        {
+            const auto props = this->_readFlBitArrayTypeProps();
+
+            if (props.len != 32 && props.len != 64) {
+                throw InvalidTraceTypeBin {
+                    "Invalid fixed-length floating point number type length."
+                };
+            }
+
+            return FixedLengthFloatingPointNumberType::create(align, props.len, props.bo,
+                                                              props.bio, std::move(attrs));
+        }
+
+        case DtTag::VlSInt:
+        {
+            const auto dispBase = this->_readDispBase();
+            auto mappings = this->_readRangeSetMap<VariableLengthSignedIntegerType::Mappings>();
+
+            return VariableLengthSignedIntegerType::create(align, dispBase, std::move(mappings),
+                                                           std::move(attrs));
+        }
+
+        case DtTag::VlUInt:
+        {
+            const auto dispBase = this->_readDispBase();
+            auto mappings = this->_readRangeSetMap<VariableLengthUnsignedIntegerType::Mappings>();
+
+            return VariableLengthUnsignedIntegerType::create(align, dispBase, std::move(mappings),
+                                                             std::move(attrs),
+                                                             this->_readRoles());
+        }
+
+        case DtTag::NtStr:
+            return NullTerminatedStringType::create(this->_checkByteAlign(align),
+                                                    this->_readStrEncoding(), std::move(attrs));
+
+        case DtTag::SlStr:
+        {
+            const auto encoding = this->_readStrEncoding();
+
+            return StaticLengthStringType::create(this->_checkByteAlign(align),
+                                                  this->_readUInt(), encoding, std::move(attrs));
+        }
+
+        case DtTag::DlStr:
+        {
+            const auto encoding = this->_readStrEncoding();
+
+            return DynamicLengthStringType::create(this->_checkByteAlign(align),
+                                                   this->_readDataLoc(), encoding,
+                                                   std::move(attrs));
+        }
+
+        case DtTag::SlBlob:
+        {
+            auto mediaType = this->_readStr();
+            const auto len = this->_readUInt();
+
+            return StaticLengthBlobType::create(this->_checkByteAlign(align), len,
+                                                std::move(mediaType), std::move(attrs),
+                                                this->_readMsUuidRole(len, 2));
+        }
+
+        case DtTag::DlBlob:
+        {
+            auto mediaType = this->_readStr();
+
+            return DynamicLengthBlobType::create(this->_checkByteAlign(align),
+                                                 this->_readDataLoc(), std::move(mediaType),
+                                                 std::move(attrs));
+        }
+
+        case DtTag::Struct:
+        {
+            StructureType::MemberTypes memberTypes;
+            std::set<std::string> names;
+
+            for (auto i = this->_readSize(); i > 0; --i) {
+                auto name = this->_readStr();
+
+                if (!names.insert(name).second) {
+                    throw InvalidTraceTypeBin {"Duplicate structure member type name."};
+                }
+
+                auto dt = this->_readDt();
+
+                memberTypes.push_back(StructureMemberType::create(std::move(name), std::move(dt),
+                                                                  this->_readAttrs()));
+            }
+
+            return StructureType::create(align, std::move(memberTypes), std::move(attrs));
+        }
+
+        case DtTag::SlArray:
+        {
+            auto elemType = this->_readDt();
+            const auto len = this->_readUInt();
+            const auto hasMsUuidRole = this->_readMsUuidRole(len, 1);
+
+            if (hasMsUuidRole && !(elemType->isFixedLengthUnsignedIntegerType() &&
+                                   elemType->asFixedLengthUnsignedIntegerType().alignment() == 8 &&
+                                   elemType->asFixedLengthUnsignedIntegerType().length() == 8)) {
+                throw InvalidTraceTypeBin {"Unexpected metadata stream UUID role."};
+            }
+
+            return StaticLengthArrayType::create(align, std::move(elemType), len,
+                                                 std::move(attrs), hasMsUuidRole);
+        }
+
+        case DtTag::DlArray:
+        {
+            auto elemType = this->_readDt();
+
+            return DynamicLengthArrayType::create(align, std::move(elemType),
+                                                  this->_readDataLoc(), std::move(attrs));
+        }
+
+        case DtTag::VarUIntSel:
+            return this->_readVarType<VariantWithUnsignedIntegerSelectorType>(align,
+                                                                              std::move(attrs));
+
+        case DtTag::VarSIntSel:
+            return this->_readVarType<VariantWithSignedIntegerSelectorType>(align,
+                                                                            std::move(attrs));
+
+        case DtTag::OptBoolSel:
+        {
+            auto dt = this->_readDt();
+
+            return OptionalWithBooleanSelectorType::create(align, std::move(dt),
+                                                           this->_readDataLoc(),
+                                                           std::move(attrs));
+        }
+
+        case DtTag::OptUIntSel:
+            return this->_readOptIntSelType<OptionalWithUnsignedIntegerSelectorType>(align,
+                                                                                     std::move(attrs));
+
+        case DtTag::OptSIntSel:
+            return this->_readOptIntSelType<OptionalWithSignedIntegerSelectorType>(align,
+                                                                                   std::move(attrs));
+        }
+
+        std::abort();
+    }
+
+    StructureType::Up _readOptStructType()
+    {
+        if (!this->_readBool()) {
+            return nullptr;
+        }
+
+        auto dt = this->_readDt();
+
+        if (!dt->isStructureType()) {
+            throw InvalidTraceTypeBin {"Expecting a structure type."};
+        }
+
+        return StructureType::Up {static_cast<const StructureType *>(dt.release())};
+    }
+
+    /*
+     * Reads an optional scope structure type of which the unsigned
+     * integer types may only have the roles `allowedRoles` and of
+     * which the static-length array/BLOB types may only have a
+     * metadata stream UUID role if `isMsUuidRoleAllowed` is true.
+     */
+    StructureType::Up _readScopeType(UnsignedIntegerTypeRoleSet allowedRoles,
+                                     const bool isMsUuidRoleAllowed)
+    {
+        _allowedRoles = std::move(allowedRoles);
+        _isMsUuidRoleAllowed = isMsUuidRoleAllowed;
+
+        auto dt = this->_readOptStructType();
+
+        _allowedRoles.clear();
+        _isMsUuidRoleAllowed = false;
+        return dt;
+    }
+
+    ClockType::Up _readClkType()
+    {
+        auto id = this->_readOptStr();
+        auto ns = this->_readOptStr();
+        auto name = this->_readOptStr();
+        auto uid = this->_readOptStr();
+        boost::optional<boost::uuids::uuid> origUuid;
+
+        if (this->_readBool()) {
+            origUuid = this->_readUuid();
+        }
+
+        const auto freq = this->_readUInt();
+
+        if (freq == 0) {
+            throw InvalidTraceTypeBin {"Invalid clock type frequency."};
+        }
+
+        auto descr = this->_readOptStr();
+        boost::optional<ClockOrigin> orig;
+
+        if (this->_readBool()) {
+            auto origNs = this->_readOptStr();
+            auto origName = this->_readStr();
+            auto origUid = this->_readStr();
+
+            orig = ClockOrigin {std::move(origNs), std::move(origName), std::move(origUid)};
+        }
+
+        boost::optional<Cycles> prec;
+
+        if (this->_readBool()) {
+            prec = this->_readUInt();
+        }
+
+        boost::optional<Cycles> accuracy;
+
+        if (this->_readBool()) {
+            accuracy = this->_readUInt();
+        }
+
+        const auto offsetSecs = this->_readSInt();
+        const auto offsetCycles = this->_readUInt();
+
+        if (offsetCycles >= freq) {
+            throw InvalidTraceTypeBin {"Invalid clock type offset."};
+        }
+
+        return ClockType::create(std::move(id), std::move(ns), std::move(name), std::move(uid),
+                                 origUuid, freq, std::move(descr), std::move(orig), prec,
+                                 accuracy, ClockOffset {offsetSecs, offsetCycles},
+                                 this->_readAttrs());
+    }
+
+    EventRecordType::Up _readErt()
+    {
+        const auto id = this->_readUInt();
+        auto ns = this->_readOptStr();
+        auto name = this->_readOptStr();
+        auto uid = this->_readOptStr();
+        boost::optional<LogLevel> logLevel;
+
+        if (this->_readBool()) {
+            logLevel = this->_readSInt();
+        }
+
+        auto emfUri = this->_readOptStr();
+
+        if (_majorVersion == 2 && (logLevel || emfUri)) {
+            throw InvalidTraceTypeBin {"Unexpected log level or EMF URI (CTF 2)."};
+        }
+
+        auto specCtxType = this->_readScopeType({}, false);
+        auto payloadType = this->_readScopeType({}, false);
+
+        return EventRecordType::create(id, std::move(ns), std::move(name), std::move(uid),
+                                       std::move(logLevel), std::move(emfUri),
+                                       std::move(specCtxType), std::move(payloadType),
+                                       this->_readAttrs());
+    }
+
+    DataStreamType::Up _readDst()
+    {
+        const auto id = this->_readUInt();
+        auto ns = this->_readOptStr();
+        auto name = this->_readOptStr();
+        auto uid = this->_readOptStr();
+        EventRecordTypeSet erts;
+
+        for (auto i = this->_readSize(); i > 0; --i) {
+            if (!erts.insert(this->_readErt()).second) {
+                throw InvalidTraceTypeBin {"Duplicate event record type ID."};
+            }
+        }
+
+        /*
+         * The default clock type comes after the scope types: accept
+         * the default clock timestamp roles now and check below.
+         */
+        _hasDefClkRole = false;
+
+        auto pktCtxType = this->_readScopeType({
+            UnsignedIntegerTypeRole::PacketTotalLength,
+            UnsignedIntegerTypeRole::PacketContentLength,
+            UnsignedIntegerTypeRole::DiscardedEventRecordCounterSnapshot,
+            UnsignedIntegerTypeRole::PacketSequenceNumber,
+            UnsignedIntegerTypeRole::DefaultClockTimestamp,
+            UnsignedIntegerTypeRole::PacketEndDefaultClockTimestamp,
+        }, false);
+        auto erHeaderType = this->_readScopeType({
+            UnsignedIntegerTypeRole::EventRecordTypeId,
+            UnsignedIntegerTypeRole::DefaultClockTimestamp,
+        }, false);
+        auto erCommonCtxType = this->_readScopeType({}, false);
+        const ClockType *defClkType = nullptr;
+
+        if (this->_readBool()) {
+            const auto index = this->_readUInt();
+
+            if (index >= _clkTypes.size()) {
+                throw InvalidTraceTypeBin {"Invalid default clock type index."};
+            }
+
+            defClkType = _clkTypes[index];
+        }
+
+        if (_hasDefClkRole && !defClkType) {
+            throw InvalidTraceTypeBin {"Default clock timestamp role without default clock type."};
+        }
+
+        return DataStreamType::create(id, std::move(ns), std::move(name), std::move(uid),
+                                      std::move(erts), std::move(pktCtxType),
+                                      std::move(erHeaderType), std::move(erCommonCtxType),
+                                      defClkType, this->_readAttrs());
+    }
+
+private:
+    const char *_at;
+    const char *_end;
+
+    // read clock types, in order
+    std::vector<const ClockType *> _clkTypes;
+
+    // CTF major version of the trace type
+    unsigned int _majorVersion = 0;
+
+    // valid roles of the unsigned integer types of the current scope
+    UnsignedIntegerTypeRoleSet _allowedRoles;
+
+    // whether or not the current scope may contain a metadata stream UUID role
+    bool _isMsUuidRoleAllowed = false;
+
+    // whether or not the current data stream type has a default clock timestamp role
+    bool _hasDefClkRole = false;
+};
+
+} // namespace
+
+std::string traceTypeToBin(const TraceType& traceType,
+                           const boost::optional<boost::uuids::uuid>& metadataStreamUuid,
+                           const char * const metadataTextBegin,
+                           const char * const metadataTextEnd)
+{
+    std::string bin;
+    TraceTypeBinWriter writer {bin};
+
+    writer.writeHeader(metadataTextBegin, metadataTextEnd);
+    writer.writeMetadataStreamUuid(metadataStreamUuid);
+    writer.writeTraceType(traceType);
+    writer.writeHash();
+    return bin;
+}
+
+FromMetadataTextReturn traceTypeFromBin(const std::string& bin,
+                                        const char * const metadataTextBegin,
+                                        const char * const metadataTextEnd)
+{
+    TraceTypeBinReader reader {bin};
+
+    reader.readHeader(metadataTextBegin, metadataTextEnd);
+
+    auto metadataStreamUuid = reader.readMetadataStreamUuid();
+
+    return std::make_pair(reader.readTraceType(), std::move(metadataStreamUuid));
+}
+
+} // namespace internal
+} // namespace yactfr
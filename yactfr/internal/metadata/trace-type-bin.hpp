@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_METADATA_TRACE_TYPE_BIN_HPP
+#define YACTFR_INTERNAL_METADATA_TRACE_TYPE_BIN_HPP
+
+#include <string>
+#include <stdexcept>
+#include <boost/optional.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include <yactfr/metadata/from-metadata-text.hpp>
+#include <yactfr/metadata/trace-type.hpp>
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * Version of the binary trace type format.
+ *
+ * Increment this whenever the format which traceTypeToBin() writes
+ * changes so that traceTypeFromBin() rejects binary trace types which
+ * an older/newer version of yactfr wrote.
+ */
+constexpr unsigned int traceTypeBinFormatVersion = 2;
+
+/*
+ * Error thrown by traceTypeFromBin() when the binary trace type is
+ * invalid or has an unexpected format version.
+ */
+class InvalidTraceTypeBin final :
+    public std::runtime_error
+{
+public:
+    explicit InvalidTraceTypeBin(const std::string& msg) :
+        std::runtime_error {msg}
+    {
+    }
+};
+
+/*
+ * Returns the binary form of the trace type `traceType` and metadata
+ * stream UUID `metadataStreamUuid`, keeping the metadata text from
+ * `metadataTextBegin` to `metadataTextEnd` with it.
+ *
+ * The binary form only contains what's needed to build an equivalent
+ * trace type with the public constructors: traceTypeFromBin() lets
+ * `TraceType` compute everything else (parent links, key data types,
+ * display names, and the packet procedure when needed) again.
+ */
+std::string traceTypeToBin(const TraceType& traceType,
+                           const boost::optional<boost::uuids::uuid>& metadataStreamUuid,
+                           const char *metadataTextBegin, const char *metadataTextEnd);
+
+/*
+ * Returns the trace type and metadata stream UUID pair of which the
+ * binary form, as written by traceTypeToBin(), is `bin`, provided that
+ * the metadata text which the binary form contains is the one from
+ * `metadataTextBegin` to `metadataTextEnd`.
+ *
+ * Throws `InvalidTraceTypeBin` if `bin` isn't a valid binary trace
+ * type (including any decoded value which doesn't satisfy the
+ * preconditions of the public constructors), if its format version
+ * isn't `traceTypeBinFormatVersion`, or if it doesn't contain the
+ * expected metadata text.
+ */
+FromMetadataTextReturn traceTypeFromBin(const std::string& bin,
+                                        const char *metadataTextBegin,
+                                        const char *metadataTextEnd);
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_METADATA_TRACE_TYPE_BIN_HPP
@@ -9,6 +9,7 @@
 #include <cassert>
 #include <tuple>
 #include <set>
+#include <sstream>
 
 #include <yactfr/text-loc.hpp>
 #include <yactfr/metadata/sl-array-type.hpp>
@@ -31,12 +32,60 @@ TraceType::Up traceTypeFromPseudoTraceType(PseudoTraceType& pseudoTraceType)
     return TraceTypeFromPseudoTraceTypeConverter {pseudoTraceType}.releaseTraceType();
 }
 
+ErtsByDstId newErtsFromPseudoTraceType(PseudoTraceType& pseudoTraceType,
+                                       const TraceType& traceType)
+{
+    return std::move(TraceTypeFromPseudoTraceTypeConverter {pseudoTraceType, traceType}._newErts);
+}
+
+namespace {
+
+bool traceTypeHasErt(const TraceType& traceType, const TypeId dstId, const TypeId ertId)
+{
+    const auto dst = traceType[dstId];
+
+    return dst && (*dst)[ertId];
+}
+
+} // namespace
+
+void removeNewPseudoOrphanErts(PseudoTraceType& pseudoTraceType, const TraceType& traceType)
+{
+    auto& pseudoOrphanErts = pseudoTraceType.pseudoOrphanErts();
+
+    for (auto dstIt = pseudoOrphanErts.begin(); dstIt != pseudoOrphanErts.end();) {
+        auto& dstPseudoOrphanErts = dstIt->second;
+
+        for (auto it = dstPseudoOrphanErts.begin(); it != dstPseudoOrphanErts.end();) {
+            if (traceTypeHasErt(traceType, dstIt->first, it->first)) {
+                ++it;
+            } else {
+                it = dstPseudoOrphanErts.erase(it);
+            }
+        }
+
+        // PseudoTraceType::validate() expects no empty orphan entry
+        if (dstPseudoOrphanErts.empty() && !pseudoTraceType.hasPseudoDst(dstIt->first)) {
+            dstIt = pseudoOrphanErts.erase(dstIt);
+        } else {
+            ++dstIt;
+        }
+    }
+}
+
 TraceTypeFromPseudoTraceTypeConverter::TraceTypeFromPseudoTraceTypeConverter(PseudoTraceType& pseudoTraceType) :
     _pseudoTraceType {&pseudoTraceType}
 {
     _traceType = this->_traceTypeFromPseudoTraceType();
 }
 
+TraceTypeFromPseudoTraceTypeConverter::TraceTypeFromPseudoTraceTypeConverter(PseudoTraceType& pseudoTraceType,
+                                                                             const TraceType& traceType) :
+    _pseudoTraceType {&pseudoTraceType}
+{
+    _newErts = this->_newErtsFromPseudoTraceType(traceType);
+}
+
 TraceType::Up TraceTypeFromPseudoTraceTypeConverter::_traceTypeFromPseudoTraceType()
 {
     // validate first
@@ -58,6 +107,56 @@ TraceType::Up TraceTypeFromPseudoTraceTypeConverter::_traceTypeFromPseudoTraceTy
                              tryCloneAttrs(_pseudoTraceType->attrs()));
 }
 
+ErtsByDstId TraceTypeFromPseudoTraceTypeConverter::_newErtsFromPseudoTraceType(const TraceType& traceType)
+{
+    // validate first (checks that all the pseudo DSTs exist)
+    _pseudoTraceType->validate();
+
+    ErtsByDstId newErts;
+
+    for (auto& dstIdPseudoOrphanErtsPair : _pseudoTraceType->pseudoOrphanErts()) {
+        const auto dstId = dstIdPseudoOrphanErtsPair.first;
+        PseudoErtSet pseudoErts;
+        std::vector<PseudoOrphanErt *> newPseudoOrphanErts;
+
+        for (auto& ertIdPseudoOrphanErtPair : dstIdPseudoOrphanErtsPair.second) {
+            auto& pseudoOrphanErt = ertIdPseudoOrphanErtPair.second;
+
+            pseudoErts.insert(&pseudoOrphanErt.pseudoErt());
+
+            if (!traceTypeHasErt(traceType, dstId, ertIdPseudoOrphanErtPair.first)) {
+                newPseudoOrphanErts.push_back(&pseudoOrphanErt);
+            }
+        }
+
+        if (newPseudoOrphanErts.empty()) {
+            continue;
+        }
+
+        auto& pseudoDst = *_pseudoTraceType->pseudoDsts().at(dstId);
+
+        // validate pseudo data stream type with all its pseudo ERTs
+        pseudoDst.validate(pseudoErts);
+
+        if (!pseudoDst.pseudoErHeaderType() && pseudoErts.size() > 1) {
+            std::ostringstream ss;
+
+            ss << "Data stream type with ID " << dstId << " has no event record header "
+                  "type, but it would contain more than one event record type.";
+            throwTextParseError(ss.str(), newPseudoOrphanErts.front()->loc());
+        }
+
+        // convert new pseudo event record types
+        auto& ertVec = newErts[dstId];
+
+        for (const auto pseudoOrphanErt : newPseudoOrphanErts) {
+            ertVec.push_back(this->_ertFromPseudoErt(pseudoOrphanErt->pseudoErt(), pseudoDst));
+        }
+    }
+
+    return newErts;
+}
+
 StructureType::Up TraceTypeFromPseudoTraceTypeConverter::_scopeStructTypeFromPseudoDt(PseudoDt * const pseudoDt,
                                                                                       const Scope scope,
                                                                                       const PseudoDst * const pseudoDst,
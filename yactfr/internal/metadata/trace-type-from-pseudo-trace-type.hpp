@@ -15,6 +15,7 @@
 #include <cassert>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <boost/optional.hpp>
 #include <boost/utility.hpp>
 
@@ -34,6 +35,28 @@ namespace internal {
 
 TraceType::Up traceTypeFromPseudoTraceType(PseudoTraceType& pseudoTraceType);
 
+/*
+ * New event record types, grouped by data stream type ID.
+ */
+using ErtsByDstId = std::unordered_map<TypeId, std::vector<EventRecordType::Up>>;
+
+/*
+ * Converts the pseudo orphan event record types of `pseudoTraceType`
+ * which the trace type `traceType`, previously converted from
+ * `pseudoTraceType`, doesn't contain yet to yactfr event record types.
+ *
+ * Throws `TextParseError` if any new pseudo event record type is
+ * invalid.
+ */
+ErtsByDstId newErtsFromPseudoTraceType(PseudoTraceType& pseudoTraceType,
+                                       const TraceType& traceType);
+
+/*
+ * Removes the pseudo orphan event record types of `pseudoTraceType`
+ * which the trace type `traceType` doesn't contain.
+ */
+void removeNewPseudoOrphanErts(PseudoTraceType& pseudoTraceType, const TraceType& traceType);
+
 /*
  * Converter of root pseudo data type to yactfr data type.
  */
@@ -41,10 +64,14 @@ class TraceTypeFromPseudoTraceTypeConverter :
     boost::noncopyable
 {
     friend TraceType::Up traceTypeFromPseudoTraceType(PseudoTraceType&);
+    friend ErtsByDstId newErtsFromPseudoTraceType(PseudoTraceType&, const TraceType&);
 
 private:
     explicit TraceTypeFromPseudoTraceTypeConverter(PseudoTraceType& pseudoTraceType);
 
+    explicit TraceTypeFromPseudoTraceTypeConverter(PseudoTraceType& pseudoTraceType,
+                                                   const TraceType& traceType);
+
     /*
      * Releases and returns the resulting yactfr trace type.
      */
@@ -59,6 +86,13 @@ private:
      */
     TraceType::Up _traceTypeFromPseudoTraceType();
 
+    /*
+     * Converts the pseudo orphan event record types of
+     * `*_pseudoTraceType` which `traceType` doesn't contain yet to
+     * yactfr event record types.
+     */
+    ErtsByDstId _newErtsFromPseudoTraceType(const TraceType& traceType);
+
     /*
      * Converts the pseudo data stream type `pseudoDst` to a yactfr data
      * stream type.
@@ -88,6 +122,9 @@ private:
     // final yactfr trace type
     TraceType::Up _traceType;
 
+    // new yactfr event record types
+    ErtsByDstId _newErts;
+
     // pseudo trace type
     PseudoTraceType *_pseudoTraceType;
 };
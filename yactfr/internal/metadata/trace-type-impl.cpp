@@ -437,6 +437,165 @@ void TraceTypeImpl::_setDispNames() const
     }
 }
 
+void TraceTypeImpl::addErts(const TypeId dstId, std::vector<EventRecordType::Up>&& erts)
+{
+    const auto dst = this->findDst(dstId);
+
+    assert(dst);
+
+    std::vector<const EventRecordType *> newErts;
+    SetDispNamesDtVisitor dispNamesVisitor {_majorVersion == 1};
+
+    for (auto& ert : erts) {
+        ert->_setDst(*dst);
+
+        if (ert->specificContextType()) {
+            ert->specificContextType()->accept(dispNamesVisitor);
+        }
+
+        if (ert->payloadType()) {
+            ert->payloadType()->accept(dispNamesVisitor);
+        }
+
+        if (ert->specificContextType()) {
+            SetKeyDtsDtVisitor visitor {*this, dst, ert.get()};
+
+            ert->specificContextType()->accept(visitor);
+        }
+
+        if (ert->payloadType()) {
+            SetKeyDtsDtVisitor visitor {*this, dst, ert.get()};
+
+            ert->payloadType()->accept(visitor);
+        }
+
+        newErts.push_back(ert.get());
+    }
+
+    dst->_addErts(std::move(erts));
+
+    if (_pktProc && !PktProcBuilder::tryAddErProcs(*_pktProc, *dst, newErts)) {
+        // existing iterators keep the current one; build a new one later
+        _oldPktProcs.push_back(std::move(_pktProc));
+    }
+}
+
+namespace {
+
+/*
+ * Inserts into `dts` the boolean and integer data types which the
+ * path elements of `loc` from `locIt` target from `dt`, crossing
+ * arrays, optionals, and all the options of variants.
+ */
+void findFieldHandleDts(const DataType& dt, const DataLocation& loc,
+                        DataLocation::PathElements::const_iterator locIt, DataTypeSet& dts);
+
+template <typename VarTypeT>
+void findFieldHandleDtsVar(const VarTypeT& dt, const DataLocation& loc,
+                           const DataLocation::PathElements::const_iterator locIt,
+                           DataTypeSet& dts)
+{
+    for (auto& opt : dt.options()) {
+        findFieldHandleDts(opt->dataType(), loc, locIt, dts);
+    }
+}
+
+void findFieldHandleDts(const DataType& dt, const DataLocation& loc,
+                        const DataLocation::PathElements::const_iterator locIt, DataTypeSet& dts)
+{
+    if (dt.isFixedLengthBooleanType() || dt.isIntegerType()) {
+        if (locIt == loc.end()) {
+            dts.insert(&dt);
+        }
+    } else if (dt.isStructureType()) {
+        if (locIt == loc.end()) {
+            return;
+        }
+
+        const auto memberType = dt.asStructureType()[*locIt];
+
+        if (memberType) {
+            findFieldHandleDts(memberType->dataType(), loc, locIt + 1, dts);
+        }
+    } else if (dt.isArrayType()) {
+        findFieldHandleDts(dt.asArrayType().elementType(), loc, locIt, dts);
+    } else if (dt.isVariantWithUnsignedIntegerSelectorType()) {
+        findFieldHandleDtsVar(dt.asVariantWithUnsignedIntegerSelectorType(), loc, locIt, dts);
+    } else if (dt.isVariantWithSignedIntegerSelectorType()) {
+        findFieldHandleDtsVar(dt.asVariantWithSignedIntegerSelectorType(), loc, locIt, dts);
+    } else if (dt.isOptionalType()) {
+        findFieldHandleDts(dt.asOptionalType().dataType(), loc, locIt, dts);
+    }
+}
+
+} // namespace
+
+const FieldHandle *TraceTypeImpl::fieldHandle(const DataStreamType& dst,
+                                              const EventRecordType * const ert,
+                                              const DataLocation& loc)
+{
+    const auto scopeDt = call([this, &dst, ert, &loc]() -> const DataType * {
+        switch (loc.scope()) {
+        case Scope::PacketHeader:
+            return _pktHeaderType.get();
+
+        case Scope::PacketContext:
+            return dst.packetContextType();
+
+        case Scope::EventRecordHeader:
+            return dst.eventRecordHeaderType();
+
+        case Scope::EventRecordCommonContext:
+            return dst.eventRecordCommonContextType();
+
+        case Scope::EventRecordSpecificContext:
+            return ert ? ert->specificContextType() : nullptr;
+
+        case Scope::EventRecordPayload:
+            return ert ? ert->payloadType() : nullptr;
+
+        default:
+            std::abort();
+        }
+    });
+
+    if (!scopeDt) {
+        return nullptr;
+    }
+
+    DataTypeSet dts;
+
+    findFieldHandleDts(*scopeDt, loc, loc.begin(), dts);
+
+    if (dts.empty()) {
+        return nullptr;
+    }
+
+    // equivalent location: same targeted data types
+    for (auto& fieldHandle : _fieldHandles) {
+        if (fieldHandle->dataTypes() == dts) {
+            return fieldHandle.get();
+        }
+    }
+
+    const auto index = _fieldHandles.size();
+
+    for (const auto dt : dts) {
+        _fieldValPoss[dt] = index;
+    }
+
+    _fieldHandles.push_back(std::unique_ptr<const FieldHandle> {
+        new FieldHandle {index, loc, std::move(dts)}
+    });
+
+    if (_pktProc) {
+        // existing iterators keep the current one; build a new one later
+        _oldPktProcs.push_back(std::move(_pktProc));
+    }
+
+    return _fieldHandles.back().get();
+}
+
 const PktProc& TraceTypeImpl::pktProc() const
 {
     if (!_pktProc) {
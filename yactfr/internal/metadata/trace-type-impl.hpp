@@ -13,8 +13,10 @@
 #include <string>
 #include <sstream>
 #include <functional>
+#include <vector>
 
 #include <yactfr/metadata/trace-type.hpp>
+#include <yactfr/field-handle.hpp>
 #include <yactfr/aliases.hpp>
 #include <yactfr/metadata/aliases.hpp>
 #include <yactfr/metadata/item.hpp>
@@ -93,6 +95,64 @@ public:
      */
     const PktProc& pktProc() const;
 
+    // packet procedure if pktProc() built it, or `nullptr`
+    const PktProc *builtPktProc() const noexcept
+    {
+        return _pktProc.get();
+    }
+
+    /*
+     * Adds the new event record types `erts` to the data stream type
+     * having the ID `dstId`, setting their parent links, display names,
+     * and length/selector types.
+     *
+     * If the packet procedure already exists, this method extends it in
+     * place with new event record procedures when possible so that
+     * existing element sequence iterators, which keep a pointer to it,
+     * may also decode event records of the new types. Otherwise, this
+     * method keeps the current packet procedure alive for those
+     * iterators and pktProc() builds a new one the next time.
+     *
+     * Adding event record types while an element sequence iterator of
+     * this trace type is running on another thread is NOT safe.
+     */
+    void addErts(TypeId dstId, std::vector<EventRecordType::Up>&& erts);
+
+    /*
+     * Returns the handle of the boolean or integer field at the
+     * location `loc`, `ert` being `nullptr` for a data stream type
+     * location, creating it if needed, or `nullptr` if `loc` doesn't
+     * target any boolean or integer field.
+     *
+     * Creating a field handle makes pktProc() build a new packet
+     * procedure the next time, keeping the current one alive for
+     * existing element sequence iterators.
+     */
+    const FieldHandle *fieldHandle(const DataStreamType& dst, const EventRecordType *ert,
+                                   const DataLocation& loc);
+
+    const std::vector<std::unique_ptr<const FieldHandle>>& fieldHandles() const noexcept
+    {
+        return _fieldHandles;
+    }
+
+    /*
+     * Field value positions (field handle indexes) of the data types
+     * which the field handles target.
+     */
+    const std::unordered_map<const DataType *, Index>& fieldValPoss() const noexcept
+    {
+        return _fieldValPoss;
+    }
+
+    /*
+     * Returns the implementation of `traceType`.
+     */
+    static TraceTypeImpl& of(const TraceType& traceType) noexcept
+    {
+        return *traceType._pimpl;
+    }
+
     static DataTypeSet& dlArrayTypeLenTypes(const DynamicLengthArrayType& dt) noexcept
     {
         return dt._lenTypes();
@@ -152,7 +212,18 @@ private:
     const TraceType *_traceType;
 
     // packet procedure cache; created the first time we need it
-    mutable std::unique_ptr<const PktProc> _pktProc;
+    mutable std::unique_ptr<PktProc> _pktProc;
+
+    /*
+     * Previous packet procedures which addErts() couldn't extend in
+     * place, but which existing element sequence iterators may still
+     * use.
+     */
+    std::vector<std::unique_ptr<const PktProc>> _oldPktProcs;
+
+    // field handles, the index of each one being its position
+    std::vector<std::unique_ptr<const FieldHandle>> _fieldHandles;
+    std::unordered_map<const DataType *, Index> _fieldValPoss;
 };
 
 } // namespace internal
@@ -7,6 +7,9 @@
 
 #include <iostream>
 #include <sstream>
+#include <functional>
+#include <set>
+#include <unordered_set>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -14,6 +17,7 @@
 
 #include "tsdl-parser.hpp"
 #include "../trace-type-from-pseudo-trace-type.hpp"
+#include "../parallel.hpp"
 #include "../../utils.hpp"
 
 namespace yactfr {
@@ -370,13 +374,24 @@ void TsdlParser::_setPseudoDstDefClkType()
 
 void TsdlParser::_stackPush(const _tStackFrame::Kind kind)
 {
-    _stack.push_back(_tStackFrame {kind});
+    if (_stackSize == _stack.size()) {
+        _stack.emplace_back(kind);
+    } else {
+        _stack[_stackSize].kind = kind;
+    }
+
+    ++_stackSize;
 }
 
 void TsdlParser::_stackPop()
 {
-    assert(!_stack.empty());
-    _stack.pop_back();
+    assert(_stackSize > 0);
+
+    auto& frame = this->_stackTop();
+
+    frame.dtAliases.clear();
+    frame.idents.clear();
+    --_stackSize;
 }
 
 void TsdlParser::_createTraceType()
@@ -405,21 +420,59 @@ void TsdlParser::_createTraceType()
     _traceType = traceTypeFromPseudoTraceType(*_pseudoTraceType);
 }
 
-void TsdlParser::_checkDupPseudoNamedDt(const PseudoNamedDts& entries, const TextLocation& loc)
+namespace {
+
+/*
+ * Returns the first element of `elems` having the same name, as
+ * returned by `nameFunc`, as a preceding element, or `elems.end()` if
+ * there's none.
+ *
+ * Most structure/variant types and attribute lists only have a few
+ * entries, so this function compares names without allocating anything
+ * in that case.
+ */
+template <typename ContainerT, typename NameFuncT>
+typename ContainerT::const_iterator findDupName(const ContainerT& elems, NameFuncT&& nameFunc)
 {
-    std::set<std::string> entryNames;
+    if (elems.size() <= 16) {
+        for (auto it = elems.begin(); it != elems.end(); ++it) {
+            const auto& name = nameFunc(*it);
 
-    for (const auto& entry : entries) {
-        assert(entry->name());
+            for (auto prevIt = elems.begin(); prevIt != it; ++prevIt) {
+                if (nameFunc(*prevIt) == name) {
+                    return it;
+                }
+            }
+        }
 
-        if (entryNames.find(*entry->name()) != entryNames.end()) {
-            std::ostringstream ss;
+        return elems.end();
+    }
 
-            ss << "Duplicate identifier (member type or option name) `" << *entry->name() << "`.";
-            throwTextParseError(ss.str(), loc);
+    std::set<std::reference_wrapper<const std::string>, std::less<std::string>> names;
+
+    for (auto it = elems.begin(); it != elems.end(); ++it) {
+        if (!names.insert(nameFunc(*it)).second) {
+            return it;
         }
+    }
 
-        entryNames.insert(*entry->name());
+    return elems.end();
+}
+
+} // namespace
+
+void TsdlParser::_checkDupPseudoNamedDt(const PseudoNamedDts& entries, const TextLocation& loc)
+{
+    const auto it = findDupName(entries, [](const PseudoNamedDt::Up& entry) -> const std::string& {
+        assert(entry->name());
+        return *entry->name();
+    });
+
+    if (it != entries.end()) {
+        std::ostringstream ss;
+
+        ss << "Duplicate identifier (member type or option name) `" << *(*it)->name() << "`.";
+        throwTextParseError(ss.str(), loc);
     }
 }
 
@@ -439,17 +492,15 @@ bool TsdlParser::_isPseudoVarTypeWithoutSelLocRec(const PseudoDt& pseudoDt)
 
 void TsdlParser::_checkDupAttr(const _tAttrs& attrs)
 {
-    std::set<std::string> attrSet;
-
-    for (const auto& attr : attrs) {
-        if (attrSet.find(attr.name) != attrSet.end()) {
-            std::ostringstream ss;
+    const auto it = findDupName(attrs, [](const TsdlAttr& attr) -> const std::string& {
+        return attr.name;
+    });
 
-            ss << "Duplicate attribute `" << attr.name << "`.";
-            throwTextParseError(ss.str(), attr.nameTextLoc());
-        }
+    if (it != attrs.end()) {
+        std::ostringstream ss;
 
-        attrSet.insert(attr.name);
+        ss << "Duplicate attribute `" << it->name << "`.";
+        throwTextParseError(ss.str(), it->nameTextLoc());
     }
 }
 
@@ -625,11 +676,11 @@ boost::optional<PseudoDataLoc> TsdlParser::_pseudoDataLocFromRelAllPathElems(con
      * bottom, until we reach a data type alias or the root frame (both
      * lead to an exception).
      */
-    assert(!_stack.empty());
+    assert(_stackSize > 0);
     assert(!allPathElems.empty());
 
     // find position of first path element in stack from top to bottom
-    auto stackIt = _stack.cend() - 1;
+    auto stackIt = _stack.cbegin() + _stackSize - 1;
     const auto& firstPathElem = *allPathElems.front();
 
     while (true) {
@@ -712,6 +763,13 @@ void TsdlParser::_addDtAlias(std::string&& name, const PseudoDt& pseudoDt,
         throwTextParseError(ss.str(), curLoc);
     }
 
+    // keep the definition index of a root alias for worker parsers
+    if (_threadCount != 1 && &frame == &_stack.front()) {
+        const auto index = _rootDtAliasIndexes.size();
+
+        _rootDtAliasIndexes.insert(std::make_pair(name, index));
+    }
+
     // add alias
     frame.dtAliases[std::move(name)] = pseudoDt.clone();
 }
@@ -729,8 +787,14 @@ void TsdlParser::_addDtAlias(std::string&& name, const PseudoDt& pseudoDt)
 
 PseudoDt::Up TsdlParser::_aliasedPseudoDt(const std::string& name, TextLocation loc) const
 {
-    for (auto it = _stack.crbegin(); it != _stack.crend(); ++it) {
+    for (auto it = _stack.crend() - _stackSize; it != _stack.crend(); ++it) {
         const auto& frame = *it;
+
+        if (frame.dtAliases.empty()) {
+            // most frames (structure/variant types) have no aliases
+            continue;
+        }
+
         const auto findIt = frame.dtAliases.find(name);
 
         if (findIt == frame.dtAliases.end()) {
@@ -743,16 +807,41 @@ PseudoDt::Up TsdlParser::_aliasedPseudoDt(const std::string& name, TextLocation
         return dt;
     }
 
+    if (_mainParser) {
+        /*
+         * Root data type alias of the main parser which precedes the
+         * `event` block which this worker parser is parsing?
+         */
+        const auto idxIt = _mainParser->_rootDtAliasIndexes.find(name);
+
+        if (idxIt != _mainParser->_rootDtAliasIndexes.end() &&
+                idxIt->second < _visibleRootDtAliasCount) {
+            auto dt = _mainParser->_stack.front().dtAliases.at(name)->clone();
+
+            dt->loc(std::move(loc));
+            return dt;
+        }
+    }
+
     return nullptr;
 }
 
-TsdlParser::TsdlParser(const char * const begin, const char * const end) :
-    _ss {begin, end}
+TsdlParser::TsdlParser(const char * const begin, const char * const end, const Size threadCount) :
+    _ss {begin, end},
+    _threadCount {threadCount}
 {
     assert(end >= begin);
     this->_parseMetadata();
 }
 
+TsdlParser::TsdlParser(const TsdlParser * const mainParser) :
+    _ss {mainParser->_ss.begin(), mainParser->_ss.end()},
+    _nativeBo {mainParser->_nativeBo},
+    _mainParser {mainParser}
+{
+    this->_stackPush(_tStackFrame::Kind::Root);
+}
+
 const boost::optional<boost::uuids::uuid> TsdlParser::metadataStreamUuid() const noexcept
 {
     assert(_pseudoTraceType);
@@ -766,31 +855,116 @@ const boost::optional<boost::uuids::uuid> TsdlParser::metadataStreamUuid() const
 
 void TsdlParser::_parseMetadata()
 {
-    _LexicalScope lexScope {*this, _tStackFrame::Kind::Root};
+    /*
+     * Not using a `_LexicalScope` here: keep the root frame, and
+     * therefore the root data type aliases, for
+     * parseAppendedMetadata().
+     */
+    this->_stackPush(_tStackFrame::Kind::Root);
 
-    while (this->_tryParseRootBlock());
+    try {
+        while (this->_tryParseRootBlock());
 
-    // make sure we skip the remaining fruitless stuff
-    this->_skipCommentsAndWhitespacesAndSemicolons();
+        // make sure we skip the remaining fruitless stuff
+        this->_skipCommentsAndWhitespacesAndSemicolons();
 
-    if (!_ss.isDone()) {
-        throwTextParseError("Expecting data type alias (`typealias`, `typedef`, `enum NAME`, "
-                            "`struct NAME`, or `variant NAME`), trace type block (`trace`), "
-                            "trace environment block (`env`), "
-                            "clock type block (`clock`), data stream type block (`stream`), "
-                            "or event record type block (`event`). Did you forget the `;` "
-                            "after the closing `}` of the block?",
-                            _ss.loc());
+        if (!_ss.isDone()) {
+            throwTextParseError("Expecting data type alias (`typealias`, `typedef`, "
+                                "`enum NAME`, `struct NAME`, or `variant NAME`), "
+                                "trace type block (`trace`), trace environment block (`env`), "
+                                "clock type block (`clock`), data stream type block (`stream`), "
+                                "or event record type block (`event`). Did you forget the `;` "
+                                "after the closing `}` of the block?",
+                                _ss.loc());
+        }
+    } catch (const TextParseError&) {
+        /*
+         * A sequential parser would report the error of a deferred
+         * `event` block which precedes this one first.
+         */
+        this->_addErtBlocks();
+        throw;
     }
 
     if (!_pseudoTraceType) {
         throwTextParseError("Missing `trace` block.");
     }
 
+    this->_addErtBlocks();
+
     // create a yactfr trace type from the pseudo trace type
     this->_createTraceType();
 }
 
+ErtsByDstId TsdlParser::parseAppendedMetadata(const char * const begin, const char * const end,
+                                              const TraceType& traceType)
+{
+    assert(end >= begin);
+    assert(_pseudoTraceType);
+    assert(_stackSize == 1);
+
+    // names of the current root data type aliases, to roll back
+    auto& rootDtAliases = _stack.front().dtAliases;
+    std::unordered_set<std::string> rootDtAliasNames;
+
+    for (auto& nameDtPair : rootDtAliases) {
+        rootDtAliasNames.insert(nameDtPair.first);
+    }
+
+    _ss.reset(begin, end);
+
+    // cached entries point to the previous metadata string
+    _fastPseudoFlIntTypes.clear();
+
+    try {
+        while (this->_tryParseAppendedRootBlock());
+
+        // make sure we skip the remaining fruitless stuff
+        this->_skipCommentsAndWhitespacesAndSemicolons();
+
+        if (!_ss.isDone()) {
+            throwTextParseError("Expecting data type alias (`typealias`, `typedef`, `enum NAME`, "
+                                "`struct NAME`, or `variant NAME`) or event record type block "
+                                "(`event`): an appended metadata text may only add data type "
+                                "aliases and event record types. Did you forget the `;` after "
+                                "the closing `}` of the block?",
+                                _ss.loc());
+        }
+
+        return newErtsFromPseudoTraceType(*_pseudoTraceType, traceType);
+    } catch (const TextParseError&) {
+        removeNewPseudoOrphanErts(*_pseudoTraceType, traceType);
+
+        for (auto it = rootDtAliases.begin(); it != rootDtAliases.end();) {
+            if (rootDtAliasNames.find(it->first) == rootDtAliasNames.end()) {
+                it = rootDtAliases.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        throw;
+    }
+}
+
+bool TsdlParser::_tryParseAppendedRootBlock()
+{
+    this->_skipCommentsAndWhitespacesAndSemicolons();
+
+    const auto loc = _ss.loc();
+
+    if (this->_tryParseDtAlias()) {
+        return true;
+    }
+
+    try {
+        return this->_tryParseErtBlock();
+    } catch (TextParseError& error) {
+        appendMsgToTextParseError(error, "In `event` root block:", loc);
+        throw;
+    }
+}
+
 bool TsdlParser::_tryParseRootBlock()
 {
     this->_skipCommentsAndWhitespacesAndSemicolons();
@@ -801,6 +975,10 @@ bool TsdlParser::_tryParseRootBlock()
         return true;
     }
 
+    if (this->_tryDeferErtBlock()) {
+        return true;
+    }
+
     try {
         if (this->_tryParseErtBlock()) {
             return true;
@@ -2248,8 +2426,9 @@ bool TsdlParser::_tryParseTraceTypeBlock()
         assert(nativeBo);
         _nativeBo = *nativeBo;
         _fastPseudoFlIntTypes.clear();
-        assert(_stack.size() == 2);
+        assert(_stackSize == 2);
         _stack[0].dtAliases.clear();
+        _rootDtAliasIndexes.clear();
         _ss.reset();
     }
 
@@ -2371,6 +2550,147 @@ bool TsdlParser::_tryParseDstBlock()
 }
 
 bool TsdlParser::_tryParseErtBlock()
+{
+    boost::optional<_tErtBlock> ertBlock;
+
+    if (!this->_tryParseErtBlock(ertBlock)) {
+        return false;
+    }
+
+    if (ertBlock) {
+        if (this->_isDeferringErtBlocks()) {
+            // keep it in order with the deferred ones
+            _ertBlockSlots.push_back(_tErtBlockSlot {
+                _ss.pos(), _rootDtAliasIndexes.size(), _envParsed, std::move(ertBlock), nullptr
+            });
+        } else {
+            this->_addPseudoOrphanErt(std::move(*ertBlock));
+        }
+    }
+
+    return true;
+}
+
+void TsdlParser::_addPseudoOrphanErt(_tErtBlock&& ertBlock)
+{
+    // get or create pseudo data stream type for orphan
+    auto& dstPseudoOrphanErts = _pseudoTraceType->pseudoOrphanErts()[ertBlock.dstId];
+
+    // check if the pseudo event record type exists
+    if (dstPseudoOrphanErts.find(ertBlock.id) != dstPseudoOrphanErts.end()) {
+        std::ostringstream ss;
+
+        ss << "Duplicate `event` block with ID " << ertBlock.id <<
+              " and data stream type ID " << ertBlock.dstId << ".";
+        throwTextParseError(ss.str(), ertBlock.pseudoOrphanErt.loc());
+    }
+
+    dstPseudoOrphanErts.insert(std::make_pair(ertBlock.id,
+                                              std::move(ertBlock.pseudoOrphanErt)));
+}
+
+bool TsdlParser::_tryDeferErtBlock()
+{
+    if (!this->_isDeferringErtBlocks()) {
+        return false;
+    }
+
+    StrScannerRejecter ssRej {_ss};
+    const auto pos = _ss.pos();
+
+    /*
+     * Only defer a block which looks complete: parse any other one
+     * right away to report its error where a sequential parser would.
+     */
+    if (!_ss.tryScanToken("event") || !_ss.trySkipBlock() || !_ss.tryScanToken(";")) {
+        return false;
+    }
+
+    ssRej.accept();
+    _ertBlockSlots.push_back(_tErtBlockSlot {
+        pos, _rootDtAliasIndexes.size(), _envParsed, boost::none, nullptr
+    });
+    return true;
+}
+
+void TsdlParser::_parseDeferredErtBlock(_tErtBlockSlot& slot)
+{
+    assert(_mainParser);
+    _ss.pos(slot.pos);
+    _visibleRootDtAliasCount = slot.rootDtAliasCount;
+    _envParsed = slot.envParsed;
+
+    const auto loc = _ss.loc();
+
+    try {
+        const auto parsed = this->_tryParseErtBlock(slot.ertBlock);
+
+        static_cast<void>(parsed);
+        assert(parsed);
+    } catch (TextParseError& error) {
+        appendMsgToTextParseError(error, "In `event` root block:", loc);
+        throw;
+    }
+}
+
+void TsdlParser::_addErtBlocks()
+{
+    if (_ertBlockSlots.empty()) {
+        return;
+    }
+
+    std::vector<_tErtBlockSlot *> unparsedSlots;
+
+    for (auto& slot : _ertBlockSlots) {
+        if (!slot.ertBlock) {
+            unparsedSlots.push_back(&slot);
+        }
+    }
+
+    if (!unparsedSlots.empty()) {
+        const auto threadCount = effectiveThreadCount(_threadCount, unparsedSlots.size());
+        std::vector<std::unique_ptr<TsdlParser>> workers;
+
+        for (Index i = 0; i < threadCount; ++i) {
+            workers.push_back(std::unique_ptr<TsdlParser> {new TsdlParser {this}});
+        }
+
+        parallelFor(unparsedSlots.size(), threadCount,
+                    [&unparsedSlots, &workers](const Index threadIndex, const Index index) {
+            auto& slot = *unparsedSlots[index];
+
+            try {
+                workers[threadIndex]->_parseDeferredErtBlock(slot);
+            } catch (...) {
+                slot.exc = std::current_exception();
+            }
+        });
+    }
+
+    // add in metadata string order, like a sequential parser would
+    auto slots = std::move(_ertBlockSlots);
+
+    _ertBlockSlots.clear();
+
+    for (auto& slot : slots) {
+        if (slot.exc) {
+            std::rethrow_exception(slot.exc);
+        }
+
+        assert(slot.ertBlock);
+
+        const auto loc = slot.ertBlock->pseudoOrphanErt.loc();
+
+        try {
+            this->_addPseudoOrphanErt(std::move(*slot.ertBlock));
+        } catch (TextParseError& error) {
+            appendMsgToTextParseError(error, "In `event` root block:", loc);
+            throw;
+        }
+    }
+}
+
+bool TsdlParser::_tryParseErtBlock(boost::optional<_tErtBlock>& ertBlock)
 {
     _LexicalScope lexScope {*this, _tStackFrame::Kind::Ert};
 
@@ -2431,7 +2751,7 @@ bool TsdlParser::_tryParseErtBlock()
     // parse `;`
     this->_expectToken(";");
 
-    if (!_pseudoTraceType) {
+    if (!_pseudoTraceType && !_mainParser) {
         return true;
     }
 
@@ -2488,27 +2808,17 @@ bool TsdlParser::_tryParseErtBlock()
         }
     }
 
-    // get or create pseudo data stream type for orphan
-    auto& dstPseudoOrphanErts = _pseudoTraceType->pseudoOrphanErts()[dstId];
-
-    // check if the pseudo event record type exists
-    if (dstPseudoOrphanErts.find(id) != dstPseudoOrphanErts.end()) {
-        std::ostringstream ss;
-
-        ss << "Duplicate `event` block with ID " << id <<
-              " and data stream type ID " << dstId << ".";
-        throwTextParseError(ss.str(), beginLoc);
-    }
-
     // build event record type object
-    dstPseudoOrphanErts.insert(std::make_pair(id, PseudoOrphanErt {
-        PseudoErt {
-            id, boost::none, std::move(name), boost::none, std::move(logLevel),
-            std::move(emfUri), std::move(pseudoSpecCtxType),
-            std::move(pseudoPayloadType)
-        },
-        beginLoc
-    }));
+    ertBlock = _tErtBlock {
+        dstId, id, PseudoOrphanErt {
+            PseudoErt {
+                id, boost::none, std::move(name), boost::none, std::move(logLevel),
+                std::move(emfUri), std::move(pseudoSpecCtxType),
+                std::move(pseudoPayloadType)
+            },
+            beginLoc
+        }
+    };
 
     return true;
 }
@@ -2957,9 +3267,7 @@ PseudoDt::Up TsdlParser::_parseArraySubscripts(PseudoDt::Up innerPseudoDt)
                     throwTextParseError(ss.str(), subscriptLoc);
                 }
 
-                assert(_pseudoTraceType);
-
-                const auto entry = _pseudoTraceType->env()[envKey];
+                const auto entry = this->_traceEnv()[envKey];
 
                 if (!entry) {
                     std::ostringstream ss;
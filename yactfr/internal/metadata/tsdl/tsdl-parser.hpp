@@ -15,6 +15,7 @@
 #include <map>
 #include <cstring>
 #include <cassert>
+#include <exception>
 #include <utility>
 #include <unordered_map>
 #include <boost/utility.hpp>
@@ -48,6 +49,7 @@
 #include "../pseudo-types.hpp"
 #include "../pseudo-dt-utils.hpp"
 #include "../str-scanner.hpp"
+#include "../trace-type-from-pseudo-trace-type.hpp"
 
 namespace yactfr {
 namespace internal {
@@ -70,12 +72,18 @@ public:
      * Builds a metadata parser, wrapping a string between `begin`
      * (included) and `end` (excluded), and parses it.
      *
+     * If `threadCount` isn't 1, then this parser parses the `event`
+     * blocks which follow the `trace` block on `threadCount` threads
+     * (0 means the number of hardware threads) once it has parsed all
+     * the other blocks, and then adds the resulting event record types
+     * in metadata string order.
+     *
      * You can release the resulting trace type from this parser with
      * releaseTraceType() and get the trace environment with traceEnv().
      *
      * Throws `TextParseError` when there was a parsing error.
      */
-    explicit TsdlParser(const char *begin, const char *end);
+    explicit TsdlParser(const char *begin, const char *end, Size threadCount = 1);
 
     /*
      * Releases and returns the parsed trace type.
@@ -91,6 +99,24 @@ public:
      */
     const boost::optional<boost::uuids::uuid> metadataStreamUuid() const noexcept;
 
+    /*
+     * Parses the metadata string between `begin` (included) and `end`
+     * (excluded) which follows the metadata string(s) which this parser
+     * already parsed, and returns the resulting new event record types,
+     * which `traceType`, the trace type which releaseTraceType()
+     * returned, doesn't contain yet.
+     *
+     * Such an appended metadata string may only contain data type
+     * aliases and `event` blocks. It may use the root data type aliases
+     * of the previous metadata strings.
+     *
+     * Throws `TextParseError` when there was a parsing error, in which
+     * case the state of this parser is as it was before calling this
+     * method. The text locations of the error are relative to `begin`.
+     */
+    ErtsByDstId parseAppendedMetadata(const char *begin, const char *end,
+                                      const TraceType& traceType);
+
 private:
     /*
      * One frame of the parser context stack.
@@ -163,7 +189,7 @@ private:
         explicit _tStackFrame(Kind kind);
 
         // kind of this frame
-        const Kind kind;
+        Kind kind;
 
         // data type aliases of this frame
         std::unordered_map<std::string, PseudoDt::Up> dtAliases;
@@ -257,6 +283,53 @@ private:
     };
 
 private:
+    /*
+     * Parsed event record type block.
+     */
+    struct _tErtBlock final
+    {
+        // data stream type ID
+        TypeId dstId;
+
+        // event record type ID
+        TypeId id;
+
+        // pseudo orphan event record type
+        PseudoOrphanErt pseudoOrphanErt;
+    };
+
+    /*
+     * Event record type block to add, in parallel mode (see
+     * _tryDeferErtBlock()).
+     */
+    struct _tErtBlockSlot final
+    {
+        // position of the `event` block
+        StrScanner::Pos pos;
+
+        // number of root data type aliases which precede the block
+        Size rootDtAliasCount;
+
+        // whether or not an `env` block precedes the block
+        bool envParsed;
+
+        // parsed block, or `boost::none` if not parsed yet
+        boost::optional<_tErtBlock> ertBlock;
+
+        // error while parsing the block on a worker parser, if any
+        std::exception_ptr exc;
+    };
+
+    /*
+     * Builds a worker parser of the main parser `mainParser`.
+     *
+     * A worker parser only parses the `event` blocks which its main
+     * parser defers (see _parseDeferredErtBlock()), using the root data
+     * type aliases and the trace environment of its main parser, which
+     * must not change in the meantime.
+     */
+    explicit TsdlParser(const TsdlParser *mainParser);
+
     /*
      * Parses the whole metadata string, creating the resulting trace
      * type and trace environment on success, throwing `TextParseError`
@@ -275,6 +348,14 @@ private:
      */
     bool _tryParseRootBlock();
 
+    /*
+     * Like _tryParseRootBlock(), but only tries to parse the root
+     * blocks which an appended metadata string may contain (explicit
+     * data type aliases, named enumeration/structure/variant types, and
+     * `event` blocks).
+     */
+    bool _tryParseAppendedRootBlock();
+
     /*
      * Tries to parse a data type alias given by a named
      * enumeration/structure/variant type, terminating with `;`, adding
@@ -762,6 +843,65 @@ private:
      */
     bool _tryParseErtBlock();
 
+    /*
+     * Like _tryParseErtBlock(), but sets `ertBlock` to the parsed
+     * block, if there's a pseudo trace type, instead of adding it.
+     */
+    bool _tryParseErtBlock(boost::optional<_tErtBlock>& ertBlock);
+
+    /*
+     * Adds the pseudo orphan event record type of the parsed event
+     * record type block `ertBlock`, throwing if it already exists.
+     */
+    void _addPseudoOrphanErt(_tErtBlock&& ertBlock);
+
+    /*
+     * Whether or not this parser defers the `event` blocks to worker
+     * parsers.
+     */
+    bool _isDeferringErtBlocks() const noexcept
+    {
+        return _threadCount != 1 && _pseudoTraceType;
+    }
+
+    /*
+     * Tries to skip a complete `event` block, terminating with `;`,
+     * appending a corresponding slot to `_ertBlockSlots` so that a
+     * worker parser parses it later.
+     *
+     * Returns whether or not an `event` block was skipped.
+     */
+    bool _tryDeferErtBlock();
+
+    /*
+     * Parses the deferred `event` blocks on worker parsers, and then
+     * adds all the parsed event record type blocks in metadata string
+     * order, throwing the error of the first invalid one, if any.
+     */
+    void _addErtBlocks();
+
+    /*
+     * Parses the deferred `event` block of `slot`, setting its parsed
+     * block on success or throwing `TextParseError` otherwise.
+     *
+     * Only a worker parser calls this.
+     */
+    void _parseDeferredErtBlock(_tErtBlockSlot& slot);
+
+    /*
+     * Returns the current trace environment (the one of the main
+     * parser for a worker parser).
+     */
+    const TraceEnvironment& _traceEnv() const noexcept
+    {
+        if (_mainParser) {
+            return _mainParser->_traceEnv();
+        }
+
+        assert(_pseudoTraceType);
+        return _pseudoTraceType->env();
+    }
+
     /*
      * Returns a fast pseudo fixed-length integer type clone from the
      * fast pseudo fixed-length integer type cache, or `nullptr` if not
@@ -807,8 +947,8 @@ private:
      */
     _tStackFrame& _stackTop()
     {
-        assert(!_stack.empty());
-        return _stack.back();
+        assert(_stackSize > 0);
+        return _stack[_stackSize - 1];
     }
 
     /*
@@ -987,8 +1127,42 @@ private:
     // whether or not an `env` block was parsed
     bool _envParsed = false;
 
-    // lexical scope stack
+    // number of threads to parse the `event` blocks (0: hardware threads)
+    Size _threadCount = 1;
+
+    // main parser of this worker parser, or `nullptr` if none
+    const TsdlParser *_mainParser = nullptr;
+
+    /*
+     * Event record type blocks to add, in metadata string order, in
+     * parallel mode.
+     */
+    std::vector<_tErtBlockSlot> _ertBlockSlots;
+
+    /*
+     * Definition index of each root data type alias, in parallel mode.
+     *
+     * A worker parser only considers the root data type aliases of its
+     * main parser of which the index is less than
+     * `_visibleRootDtAliasCount`, like a sequential parser would.
+     */
+    std::unordered_map<std::string, Index> _rootDtAliasIndexes;
+
+    // number of visible root data type aliases of the main parser
+    Size _visibleRootDtAliasCount = 0;
+
+    /*
+     * Lexical scope stack.
+     *
+     * _stackPop() doesn't remove the popped frame from this vector so
+     * that _stackPush() can reuse it, together with its identifier
+     * vector and data type alias map storage, instead of allocating
+     * again for each structure/variant type.
+     */
     std::vector<_tStackFrame> _stack;
+
+    // number of frames in use within `_stack`
+    Size _stackSize = 0;
 };
 
 template <typename FlIntTypeT, typename CreatePseudoDtFuncT>
@@ -7,14 +7,20 @@
 
 #include <sstream>
 #include <vector>
+#include <array>
 #include <cassert>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <string.h>
 #include <errno.h>
 
+#ifdef __linux__
+# include <sys/inotify.h>
+#endif
+
 #include <yactfr/io-error.hpp>
 
 #include "mmap-file-view-factory-impl.hpp"
@@ -39,20 +45,13 @@ MmapFileViewFactoryImpl::MmapFileViewFactoryImpl(std::string path,
         throw IOError {ss.str()};
     }
 
-    struct stat stat;
-
-    const auto ret = fstat(_fd, &stat);
-
-    if (ret < 0) {
-        const auto error = internal::strError();
-        std::ostringstream ss;
-
-        ss << "Cannot get file status for \"" << _path << "\": " << error;
+    try {
+        _fileSize = this->_curFileSize();
+    } catch (...) {
         this->_close();
-        throw IOError {ss.str()};
+        throw;
     }
 
-    _fileSize = static_cast<Size>(stat.st_size);
     _mmapOffsetGranularity = sysconf(_SC_PAGE_SIZE);
     assert(_mmapOffsetGranularity >= 1);
 
@@ -68,6 +67,151 @@ MmapFileViewFactoryImpl::MmapFileViewFactoryImpl(std::string path,
     }
 }
 
+Size MmapFileViewFactoryImpl::_curFileSize() const
+{
+    struct stat stat;
+
+    const auto ret = fstat(_fd, &stat);
+
+    if (ret < 0) {
+        const auto error = internal::strError();
+        std::ostringstream ss;
+
+        ss << "Cannot get file status for \"" << _path << "\": " << error;
+        throw IOError {ss.str()};
+    }
+
+    return static_cast<Size>(stat.st_size);
+}
+
+bool MmapFileViewFactoryImpl::updateFileSize()
+{
+    const auto newFileSize = this->_curFileSize();
+    auto oldFileSize = _fileSize.load();
+
+    /*
+     * Only grow: a view which updates the file size concurrently could
+     * have seen a larger file size already.
+     */
+    while (newFileSize > oldFileSize) {
+        if (_fileSize.compare_exchange_weak(oldFileSize, newFileSize)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int MmapFileViewFactoryImpl::fileChangeFd()
+{
+#ifdef __linux__
+    if (_fileChangeFd >= 0) {
+        return _fileChangeFd;
+    }
+
+    _fileChangeFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (_fileChangeFd < 0) {
+        const auto error = internal::strError();
+        std::ostringstream ss;
+
+        ss << "Cannot create inotify instance to follow \"" << _path << "\": " << error;
+        throw IOError {ss.str()};
+    }
+
+    if (inotify_add_watch(_fileChangeFd, _path.c_str(), IN_MODIFY | IN_CLOSE_WRITE) < 0) {
+        const auto error = internal::strError();
+        std::ostringstream ss;
+
+        ss << "Cannot watch \"" << _path << "\" for changes: " << error;
+        static_cast<void>(close(_fileChangeFd));
+        _fileChangeFd = -1;
+        throw IOError {ss.str()};
+    }
+
+    return _fileChangeFd;
+#else
+    return -1;
+#endif
+}
+
+void MmapFileViewFactoryImpl::drainFileChangeFd() noexcept
+{
+    if (_fileChangeFd < 0) {
+        return;
+    }
+
+    /*
+     * We only care about the fact that the file changed, not about
+     * the events themselves.
+     */
+    std::array<char, 4096> buf;
+
+    while (read(_fileChangeFd, buf.data(), buf.size()) > 0);
+}
+
+bool MmapFileViewFactoryImpl::waitForFileGrowth(const boost::optional<std::chrono::milliseconds>& timeout)
+{
+    using Clock = std::chrono::steady_clock;
+
+    /*
+     * Create the file change file descriptor _before_ getting the file
+     * size so as to not miss any change between both.
+     */
+    const auto fileChangeFd = this->fileChangeFd();
+    boost::optional<Clock::time_point> deadline;
+
+    if (timeout) {
+        deadline = Clock::now() + *timeout;
+    }
+
+    while (true) {
+        this->drainFileChangeFd();
+
+        if (this->updateFileSize()) {
+            return true;
+        }
+
+        int pollTimeoutMs = -1;
+
+        if (deadline) {
+            const auto now = Clock::now();
+
+            if (now >= *deadline) {
+                return false;
+            }
+
+            pollTimeoutMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(*deadline - now).count());
+        }
+
+        if (fileChangeFd < 0) {
+            /*
+             * No way to get notified on this platform: check again
+             * periodically.
+             */
+            if (pollTimeoutMs < 0 || pollTimeoutMs > 10) {
+                pollTimeoutMs = 10;
+            }
+
+            static_cast<void>(poll(nullptr, 0, pollTimeoutMs));
+            continue;
+        }
+
+        struct pollfd pollFd;
+
+        pollFd.fd = fileChangeFd;
+        pollFd.events = POLLIN;
+
+        if (poll(&pollFd, 1, pollTimeoutMs) < 0 && errno != EINTR) {
+            const auto error = internal::strError();
+            std::ostringstream ss;
+
+            ss << "Cannot wait for changes of \"" << _path << "\": " << error;
+            throw IOError {ss.str()};
+        }
+    }
+}
+
 void MmapFileViewFactoryImpl::_close()
 {
     assert(_fd >= 0);
@@ -75,6 +219,11 @@ void MmapFileViewFactoryImpl::_close()
     // TODO: check return value and log (do not throw) on error
     static_cast<void>(close(_fd));
     _fd = -1;
+
+    if (_fileChangeFd >= 0) {
+        static_cast<void>(close(_fileChangeFd));
+        _fileChangeFd = -1;
+    }
 }
 
 MmapFileViewFactoryImpl::~MmapFileViewFactoryImpl()
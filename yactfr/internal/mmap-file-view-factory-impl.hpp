@@ -9,6 +9,9 @@
 #define YACTFR_INTERNAL_MMAP_FILE_VIEW_FACTORY_IMPL_HPP
 
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <boost/optional.hpp>
 #include <yactfr/aliases.hpp>
 #include <yactfr/mmap-file-view-factory.hpp>
 
@@ -24,8 +27,12 @@ namespace internal {
  * and guarantee its lifetime.
  *
  * `MemoryMappedFileView` objects also have access to some parameters
- * like the preferred memory map size and the expected data access
- * pattern.
+ * like the preferred memory map size, the expected data access
+ * pattern, and the paging hints.
+ *
+ * In follow mode, the file size can change: any
+ * `MemoryMappedFileView` object can update it when it reaches the
+ * current end of the file.
  */
 class MmapFileViewFactoryImpl final
 {
@@ -45,6 +52,30 @@ public:
         return _fileSize;
     }
 
+    /*
+     * Updates the file size from the current file status, returning
+     * `true` if the file grew.
+     */
+    bool updateFileSize();
+
+    /*
+     * Returns the file descriptor which becomes readable when the file
+     * changes, creating it if needed, or -1 if not supported.
+     */
+    int fileChangeFd();
+
+    /*
+     * Discards the pending events of the file change file descriptor,
+     * if any.
+     */
+    void drainFileChangeFd() noexcept;
+
+    /*
+     * Waits until the file grows or until `timeout` elapses, returning
+     * `true` if the file grew.
+     */
+    bool waitForFileGrowth(const boost::optional<std::chrono::milliseconds>& timeout);
+
     Size mmapOffsetGranularity() const noexcept
     {
         return _mmapOffsetGranularity;
@@ -70,15 +101,72 @@ public:
         _accessPattern = accessPattern;
     }
 
+    bool prefaultPages() const noexcept
+    {
+        return _prefaultPages;
+    }
+
+    void prefaultPages(const bool prefaultPages) noexcept
+    {
+        _prefaultPages = prefaultPages;
+    }
+
+    bool adviseHugePages() const noexcept
+    {
+        return _adviseHugePages;
+    }
+
+    void adviseHugePages(const bool adviseHugePages) noexcept
+    {
+        _adviseHugePages = adviseHugePages;
+    }
+
+    bool readAheadNextRegion() const noexcept
+    {
+        return _readAheadNextRegion;
+    }
+
+    void readAheadNextRegion(const bool readAheadNextRegion) noexcept
+    {
+        _readAheadNextRegion = readAheadNextRegion;
+    }
+
+    bool dropBehind() const noexcept
+    {
+        return _dropBehind;
+    }
+
+    bool followFile() const noexcept
+    {
+        return _followFile;
+    }
+
+    void followFile(const bool followFile) noexcept
+    {
+        _followFile = followFile;
+    }
+
+    void dropBehind(const bool dropBehind) noexcept
+    {
+        _dropBehind = dropBehind;
+    }
+
 private:
     void _close();
+    Size _curFileSize() const;
 
 private:
     const std::string _path;
     Size _mmapSize;
     MemoryMappedFileViewFactory::AccessPattern _accessPattern;
+    bool _prefaultPages = false;
+    bool _adviseHugePages = false;
+    bool _readAheadNextRegion = false;
+    bool _dropBehind = false;
+    std::atomic<bool> _followFile {false};
     int _fd = -1;
-    Size _fileSize;
+    int _fileChangeFd = -1;
+    std::atomic<Size> _fileSize;
     Size _mmapOffsetGranularity;
 };
 
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <mutex>
 #include <type_traits>
 #include <boost/optional/optional.hpp>
 
@@ -18,6 +19,7 @@
 #include <yactfr/metadata/dl-str-type.hpp>
 
 #include "pkt-proc-builder.hpp"
+#include "metadata/trace-type-impl.hpp"
 
 namespace yactfr {
 namespace internal {
@@ -138,14 +140,26 @@ void PktProcBuilder::_buildPktProc()
      *    dynamic-length string", "begin read dynamic-length BLOB",
      *    "begin read variant", and "begin read optional" instructions.
      *
-     * 5. Insert "end procedure" instructions at the end of each
+     * 5. Insert `SaveFieldValInstr` objects after the instructions
+     *    which read the data types that the field handles of the trace
+     *    type target.
+     *
+     * 6. Insert "end procedure" instructions at the end of each
      *    top-level procedure.
+     *
+     * 7. Set the maximum VM stack depths.
+     *
+     * 8. Set the row layouts of the event record procedures having a
+     *    static layout.
      */
     this->_buildBasePktProc();
     this->_subUuidInstr();
     this->_insertSpecialInstrs();
     this->_setSavedValPoss();
+    this->_setFieldValPoss();
     this->_insertEndInstrs();
+    this->_setMaxStackDepths();
+    this->_setErRowLayouts();
 }
 
 namespace {
@@ -298,6 +312,107 @@ private:
     const Func _func;
 };
 
+namespace {
+
+/*
+ * This procedure instruction visitor finds the maximum number of VM
+ * stack frames which executing a top-level procedure needs.
+ */
+class StackDepthFinder final :
+    public CallerInstrVisitor
+{
+public:
+    explicit StackDepthFinder(Proc& proc)
+    {
+        this->_visitProc(proc);
+    }
+
+    Size maxStackDepth() const noexcept
+    {
+        /*
+         * The deepest procedure may also begin reading a string or a
+         * BLOB, which pushes a frame without any procedure.
+         */
+        return _maxLevel + 1;
+    }
+
+    void visit(BeginReadScopeInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadStructInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadSlArrayInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadSlUuidArrayInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadDlArrayInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadVarUIntSelInstr& instr) override
+    {
+        this->_visitBeginReadVarInstr(instr);
+    }
+
+    void visit(BeginReadVarSIntSelInstr& instr) override
+    {
+        this->_visitBeginReadVarInstr(instr);
+    }
+
+    void visit(BeginReadOptBoolSelInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadOptUIntSelInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+    void visit(BeginReadOptSIntSelInstr& instr) override
+    {
+        this->_visitSubProc(instr.proc());
+    }
+
+private:
+    template <typename BeginReadVarInstrT>
+    void _visitBeginReadVarInstr(BeginReadVarInstrT& instr)
+    {
+        for (auto& opt : instr.opts()) {
+            this->_visitSubProc(opt.proc());
+        }
+    }
+
+    void _visitSubProc(Proc& proc)
+    {
+        _maxLevel = std::max(_maxLevel, _curLevel + 1);
+        this->_visitProc(proc);
+    }
+
+private:
+    // the top-level procedure is level 1
+    Size _maxLevel = 1;
+};
+
+Size procMaxStackDepth(Proc& proc)
+{
+    return StackDepthFinder {proc}.maxStackDepth();
+}
+
+} // namespace
+
 void PktProcBuilder::_subUuidInstr()
 {
     const auto readScopeInstrIt = firstBeginReadScopeInstr(_pktProc->preambleProc(),
@@ -810,6 +925,61 @@ void PktProcBuilder::_setSavedValPoss()
     }
 
     _pktProc->savedValsCount(nextPos);
+
+    for (auto& dsPktProcPair : _pktProc->dsPktProcs()) {
+        dsPktProcPair.second->forEachErProc([nextPos](ErProc& erProc) {
+            erProc.savedValsCount(nextPos);
+        });
+    }
+}
+
+void PktProcBuilder::_insertSaveFieldValInstrs(Proc& proc, const PktProc& pktProc)
+{
+    if (pktProc.fieldValPoss().empty()) {
+        return;
+    }
+
+    std::vector<std::pair<InstrLoc, Index>> instrLocPosPairs;
+
+    DtReadLenSelInstrMapCreator {proc, [&pktProc, &instrLocPosPairs](InstrLoc& instrLoc) {
+        auto& readDataInstr = static_cast<const ReadDataInstr&>(**instrLoc.it);
+        const auto it = pktProc.fieldValPoss().find(&readDataInstr.dt());
+
+        if (it != pktProc.fieldValPoss().end()) {
+            instrLocPosPairs.emplace_back(instrLoc, it->second);
+        }
+    }};
+
+    // insert "save field value" instructions just after
+    for (auto& instrLocPosPair : instrLocPosPairs) {
+        auto& instrLoc = instrLocPosPair.first;
+
+        instrLoc.proc->insert(std::next(instrLoc.it),
+                              std::make_shared<SaveFieldValInstr>(instrLocPosPair.second));
+    }
+}
+
+void PktProcBuilder::_setFieldValPoss()
+{
+    auto& traceTypeImpl = TraceTypeImpl::of(*_traceType);
+
+    _pktProc->fieldValsCount(traceTypeImpl.fieldHandles().size());
+    _pktProc->fieldValPoss(std::unordered_map<const DataType *, Index> {
+        traceTypeImpl.fieldValPoss()
+    });
+
+    PktProcBuilder::_insertSaveFieldValInstrs(_pktProc->preambleProc(), *_pktProc);
+
+    for (auto& dsPktProcPair : _pktProc->dsPktProcs()) {
+        auto& dsPktProc = dsPktProcPair.second;
+
+        PktProcBuilder::_insertSaveFieldValInstrs(dsPktProc->pktPreambleProc(), *_pktProc);
+        PktProcBuilder::_insertSaveFieldValInstrs(dsPktProc->erPreambleProc(), *_pktProc);
+
+        dsPktProc->forEachErProc([this](ErProc& erProc) {
+            PktProcBuilder::_insertSaveFieldValInstrs(erProc.proc(), *_pktProc);
+        });
+    }
 }
 
 template <typename InstrT>
@@ -818,6 +988,154 @@ void insertEndInstr(Proc& proc)
     proc.pushBack(std::make_shared<InstrT>());
 }
 
+namespace {
+
+/*
+ * Inserts "save value" instructions within the event record procedure
+ * `erProc` for its own length/selector types, using saved value
+ * positions from `nextPos` (updated).
+ *
+ * This is what PktProcBuilder::_setSavedValPoss() does, but only if
+ * the event record procedure itself reads all the length/selector
+ * types: returns `false` otherwise.
+ */
+bool setSelfContainedErProcSavedValPoss(ErProc& erProc, Index& nextPos)
+{
+    std::unordered_map<const DataType *, InstrLoc> dtReadLenSelInstrMap;
+    auto isSelfContained = true;
+
+    DtReadLenSelInstrMapCreator {erProc.proc(), [&dtReadLenSelInstrMap](InstrLoc& instrLoc) {
+        auto& readDataInstr = static_cast<const ReadDataInstr&>(**instrLoc.it);
+
+        dtReadLenSelInstrMap[&readDataInstr.dt()] = instrLoc;
+    }};
+
+    SaveValInstrInserterVisitor {
+        erProc.proc(),
+        [&dtReadLenSelInstrMap, &nextPos, &isSelfContained](const DataTypeSet& dts) {
+            const auto pos = nextPos;
+
+            for (auto& dt : dts) {
+                const auto it = dtReadLenSelInstrMap.find(dt);
+
+                if (it == dtReadLenSelInstrMap.end()) {
+                    isSelfContained = false;
+                    continue;
+                }
+
+                auto& instrLoc = it->second;
+
+                instrLoc.proc->insert(std::next(instrLoc.it), std::make_shared<SaveValInstr>(pos));
+            }
+
+            ++nextPos;
+            return pos;
+        }
+    };
+
+    return isSelfContained;
+}
+
+} // namespace
+
+bool PktProcBuilder::tryAddErProcs(PktProc& pktProc, const DataStreamType& dst,
+                                   const std::vector<const EventRecordType *>& erts)
+{
+    const auto dsPktProcIt = pktProc.dsPktProcs().find(dst.id());
+
+    if (dsPktProcIt == pktProc.dsPktProcs().end()) {
+        return false;
+    }
+
+    auto& dsPktProc = *dsPktProcIt->second;
+
+    // the event record preamble procedure must select the ERT by ID
+    {
+        const auto& rawProc = dsPktProc.erPreambleProc().rawProc();
+        const auto it = std::find_if(rawProc.begin(), rawProc.end(), [](const Instr * const instr) {
+            return instr->kind() == Instr::Kind::SetErt &&
+                   !static_cast<const SetErtInstr&>(*instr).fixedId();
+        });
+
+        if (it == rawProc.end()) {
+            return false;
+        }
+    }
+
+    PktProcBuilder builder;
+
+    builder._traceType = &pktProc.traceType();
+
+    std::vector<std::unique_ptr<ErProc>> erProcs;
+    auto nextPos = pktProc.savedValsCount();
+
+    for (const auto ert : erts) {
+        auto erProc = builder._buildErProc(*ert);
+
+        if (!setSelfContainedErProcSavedValPoss(*erProc, nextPos)) {
+            return false;
+        }
+
+        insertEndInstr<EndErProcInstr>(erProc->proc());
+        erProc->buildRawProcFromShared();
+        erProc->savedValsCount(nextPos);
+        erProc->maxStackDepth(procMaxStackDepth(erProc->proc()));
+        PktProcBuilder::_setErRowLayout(*erProc);
+        erProcs.push_back(std::move(erProc));
+    }
+
+    // commit
+    auto maxStackDepth = pktProc.maxStackDepth();
+
+    for (auto& erProc : erProcs) {
+        maxStackDepth = std::max(maxStackDepth, erProc->maxStackDepth());
+        dsPktProc.addErProc(std::move(erProc));
+    }
+
+    pktProc.savedValsCount(nextPos);
+    pktProc.maxStackDepth(maxStackDepth);
+    return true;
+}
+
+void PktProcBuilder::buildLazyErProc(const PktProc& pktProc, const ErProc& erProc)
+{
+    std::lock_guard<std::mutex> lock {pktProc.lazyErProcMutex()};
+
+    if (erProc.isBuilt()) {
+        // another thread built it in the meantime
+        return;
+    }
+
+    /*
+     * A placeholder event record procedure is logically immutable:
+     * building it once, under the lock, only fills its empty procedure.
+     */
+    auto& mutErProc = const_cast<ErProc&>(erProc);
+    PktProcBuilder builder;
+
+    builder._traceType = &pktProc.traceType();
+    builder._buildErProcProc(erProc.ert(), mutErProc.proc());
+
+    /*
+     * Only the event record procedure itself uses its saved values,
+     * so that all the placeholder event record procedures may use the
+     * same positions following those of the packet procedure.
+     */
+    auto nextPos = pktProc.savedValsCount();
+    const auto isSelfContained = setSelfContainedErProcSavedValPoss(mutErProc, nextPos);
+
+    static_cast<void>(isSelfContained);
+    assert(isSelfContained);
+    PktProcBuilder::_insertSaveFieldValInstrs(mutErProc.proc(), pktProc);
+    insertEndInstr<EndErProcInstr>(mutErProc.proc());
+    mutErProc.buildRawProcFromShared();
+    mutErProc.savedValsCount(nextPos);
+    mutErProc.maxStackDepth(procMaxStackDepth(mutErProc.proc()));
+    PktProcBuilder::_setErRowLayout(mutErProc);
+    pktProc.accountBuiltErProc(mutErProc);
+    mutErProc.markBuilt();
+}
+
 void PktProcBuilder::_insertEndInstrs()
 {
     insertEndInstr<EndPktPreambleProcInstr>(_pktProc->preambleProc());
@@ -834,6 +1152,164 @@ void PktProcBuilder::_insertEndInstrs()
     }
 }
 
+void PktProcBuilder::_setMaxStackDepths()
+{
+    auto maxStackDepth = procMaxStackDepth(_pktProc->preambleProc());
+
+    for (auto& dsPktProcPair : _pktProc->dsPktProcs()) {
+        auto& dsPktProc = dsPktProcPair.second;
+
+        maxStackDepth = std::max({
+            maxStackDepth,
+            procMaxStackDepth(dsPktProc->pktPreambleProc()),
+            procMaxStackDepth(dsPktProc->erPreambleProc())
+        });
+
+        dsPktProc->forEachErProc([&maxStackDepth](ErProc& erProc) {
+            erProc.maxStackDepth(procMaxStackDepth(erProc.proc()));
+            maxStackDepth = std::max(maxStackDepth, erProc.maxStackDepth());
+        });
+    }
+
+    _pktProc->maxStackDepth(maxStackDepth);
+}
+
+void PktProcBuilder::_setErRowLayouts()
+{
+    for (auto& dsPktProcPair : _pktProc->dsPktProcs()) {
+        dsPktProcPair.second->forEachErProc([](ErProc& erProc) {
+            PktProcBuilder::_setErRowLayout(erProc);
+        });
+    }
+}
+
+void PktProcBuilder::_setErRowLayout(ErProc& erProc)
+{
+    std::unique_ptr<EventRecordRowLayout> layout {new EventRecordRowLayout {erProc.ert()}};
+    unsigned int nextDsAlign = 1;
+
+    if (!PktProcBuilder::_addErRowLayoutFields(erProc.proc(), *layout, nextDsAlign)) {
+        // not a static layout
+        return;
+    }
+
+    layout->_size = (layout->_size + layout->_align - 1) & -layout->_align;
+    layout->_endDsAlign = nextDsAlign;
+    layout->_maxDsLenBits += nextDsAlign - 1;
+    erProc.rowLayout(std::move(layout));
+}
+
+namespace {
+
+// maximum number of fields of an event record row layout
+constexpr Size maxErRowLayoutFieldCount = 1024;
+
+} // namespace
+
+/*
+ * Appends the fields which the instructions of `proc` read to `layout`,
+ * returning `false` if `proc` doesn't have a static layout.
+ *
+ * `nextDsAlign` is the alignment (bits) which the data stream needs
+ * before the next field, considering the structures and static-length
+ * arrays which start before it.
+ */
+bool PktProcBuilder::_addErRowLayoutFields(const Proc& proc, EventRecordRowLayout& layout,
+                                           unsigned int& nextDsAlign)
+{
+    for (auto& instr : proc.sharedProc()) {
+        switch (instr->kind()) {
+        case Instr::Kind::BeginReadScope:
+        {
+            auto& beginReadScopeInstr = static_cast<const BeginReadScopeInstr&>(*instr);
+
+            nextDsAlign = std::max(nextDsAlign, beginReadScopeInstr.align());
+
+            if (!PktProcBuilder::_addErRowLayoutFields(beginReadScopeInstr.proc(), layout,
+                                                       nextDsAlign)) {
+                return false;
+            }
+
+            break;
+        }
+
+        case Instr::Kind::BeginReadStruct:
+        {
+            auto& beginReadStructInstr = static_cast<const BeginReadStructInstr&>(*instr);
+
+            nextDsAlign = std::max(nextDsAlign, beginReadStructInstr.align());
+
+            if (!PktProcBuilder::_addErRowLayoutFields(beginReadStructInstr.proc(), layout,
+                                                       nextDsAlign)) {
+                return false;
+            }
+
+            break;
+        }
+
+        case Instr::Kind::BeginReadSlArray:
+        {
+            auto& beginReadSlArrayInstr = static_cast<const BeginReadSlArrayInstr&>(*instr);
+
+            nextDsAlign = std::max(nextDsAlign, beginReadSlArrayInstr.align());
+
+            for (Index i = 0; i < beginReadSlArrayInstr.len(); ++i) {
+                if (!PktProcBuilder::_addErRowLayoutFields(beginReadSlArrayInstr.proc(), layout,
+                                                           nextDsAlign)) {
+                    return false;
+                }
+            }
+
+            break;
+        }
+
+        case Instr::Kind::EndReadScope:
+        case Instr::Kind::EndReadStruct:
+        case Instr::Kind::EndReadSlArray:
+        case Instr::Kind::EndErProc:
+            break;
+
+        default:
+        {
+            if (!instr->isReadFlBitArray() ||
+                    layout._fields.size() == maxErRowLayoutFieldCount) {
+                return false;
+            }
+
+            auto& readFlBitArrayInstr = static_cast<const ReadFlBitArrayInstr&>(*instr);
+            auto& type = readFlBitArrayInstr.flBitArrayType();
+            const auto dsAlign = std::max(nextDsAlign, readFlBitArrayInstr.align());
+            Size size = 8;
+
+            if (type.isFixedLengthBooleanType() || type.length() <= 8) {
+                size = 1;
+            } else if (type.length() <= 16) {
+                size = 2;
+            } else if (type.length() <= 32) {
+                size = 4;
+            }
+
+            layout._size = (layout._size + size - 1) & -size;
+            layout._fields.push_back(EventRecordRowLayout::Field {
+                type, layout._size, size, dsAlign
+            });
+            layout._size += size;
+            layout._align = std::max(layout._align, size);
+            layout._maxDsLenBits += dsAlign - 1 + type.length();
+
+            if (dsAlign % 8 != 0) {
+                layout._fieldsAreByteAligned = false;
+            }
+
+            nextDsAlign = 1;
+            break;
+        }
+        }
+    }
+
+    return true;
+}
+
 void PktProcBuilder::_buildBasePktProc()
 {
     _pktProc = std::make_unique<PktProc>(*_traceType);
@@ -849,6 +1325,133 @@ void PktProcBuilder::_buildBasePktProc()
     }
 }
 
+#ifndef YACTFR_EAGER_ER_PROCS
+
+namespace {
+
+/*
+ * This data type visitor checks whether or not all the length/selector
+ * types of the visited data types are within an event record type
+ * (specific context or payload).
+ */
+class IsErtSelfContainedDtVisitor :
+    public DataTypeVisitor
+{
+public:
+    explicit IsErtSelfContainedDtVisitor() = default;
+
+    void visit(const StructureType& dt) override
+    {
+        for (const auto& memberType : dt) {
+            memberType->dataType().accept(*this);
+        }
+    }
+
+    void visit(const StaticLengthArrayType& dt) override
+    {
+        dt.elementType().accept(*this);
+    }
+
+    void visit(const DynamicLengthArrayType& dt) override
+    {
+        this->_checkLoc(dt.lengthLocation());
+        dt.elementType().accept(*this);
+    }
+
+    void visit(const DynamicLengthStringType& dt) override
+    {
+        this->_checkLoc(dt.maximumLengthLocation());
+    }
+
+    void visit(const DynamicLengthBlobType& dt) override
+    {
+        this->_checkLoc(dt.lengthLocation());
+    }
+
+    void visit(const VariantWithUnsignedIntegerSelectorType& dt) override
+    {
+        this->_visitVarType(dt);
+    }
+
+    void visit(const VariantWithSignedIntegerSelectorType& dt) override
+    {
+        this->_visitVarType(dt);
+    }
+
+    void visit(const OptionalWithBooleanSelectorType& dt) override
+    {
+        this->_visitOptType(dt);
+    }
+
+    void visit(const OptionalWithUnsignedIntegerSelectorType& dt) override
+    {
+        this->_visitOptType(dt);
+    }
+
+    void visit(const OptionalWithSignedIntegerSelectorType& dt) override
+    {
+        this->_visitOptType(dt);
+    }
+
+    bool isSelfContained() const noexcept
+    {
+        return _isSelfContained;
+    }
+
+private:
+    void _checkLoc(const DataLocation& loc) noexcept
+    {
+        if (loc.scope() != Scope::EventRecordSpecificContext &&
+                loc.scope() != Scope::EventRecordPayload) {
+            _isSelfContained = false;
+        }
+    }
+
+    template <typename VarTypeT>
+    void _visitVarType(const VarTypeT& dt)
+    {
+        this->_checkLoc(dt.selectorLocation());
+
+        for (const auto& opt : dt) {
+            opt->dataType().accept(*this);
+        }
+    }
+
+    template <typename OptTypeT>
+    void _visitOptType(const OptTypeT& dt)
+    {
+        this->_checkLoc(dt.selectorLocation());
+        dt.dataType().accept(*this);
+    }
+
+private:
+    bool _isSelfContained = true;
+};
+
+/*
+ * Returns whether or not the procedure of the event record type `ert`
+ * only needs the values which it reads itself, in which case its
+ * "save value" instructions don't belong to any other procedure.
+ */
+bool isErtSelfContained(const EventRecordType& ert)
+{
+    IsErtSelfContainedDtVisitor visitor;
+
+    if (ert.specificContextType()) {
+        ert.specificContextType()->accept(visitor);
+    }
+
+    if (ert.payloadType()) {
+        ert.payloadType()->accept(visitor);
+    }
+
+    return visitor.isSelfContained();
+}
+
+} // namespace
+
+#endif // YACTFR_EAGER_ER_PROCS
+
 std::unique_ptr<DsPktProc> PktProcBuilder::_buildDsPktProc(const DataStreamType& dst)
 {
     auto dsPktProc = std::make_unique<DsPktProc>(dst);
@@ -861,6 +1464,18 @@ std::unique_ptr<DsPktProc> PktProcBuilder::_buildDsPktProc(const DataStreamType&
                                dst.eventRecordCommonContextType(), dsPktProc->erPreambleProc());
 
     for (auto& ert : dst.eventRecordTypes()) {
+#ifndef YACTFR_EAGER_ER_PROCS
+        /*
+         * Defer building the procedure of a self-contained event record
+         * type until the VM first dispatches it: a trace typically only
+         * contains event records of a few of its event record types.
+         */
+        if (isErtSelfContained(*ert)) {
+            dsPktProc->addErProc(std::make_unique<ErProc>(*ert, false));
+            continue;
+        }
+#endif
+
         auto erProc = this->_buildErProc(*ert);
 
         assert(erProc);
@@ -874,12 +1489,16 @@ std::unique_ptr<ErProc> PktProcBuilder::_buildErProc(const EventRecordType& ert)
 {
     auto erProc = std::make_unique<ErProc>(ert);
 
-    this->_buildReadScopeInstr(Scope::EventRecordSpecificContext, ert.specificContextType(),
-                               erProc->proc());
-    this->_buildReadScopeInstr(Scope::EventRecordPayload, ert.payloadType(), erProc->proc());
+    this->_buildErProcProc(ert, erProc->proc());
     return erProc;
 }
 
+void PktProcBuilder::_buildErProcProc(const EventRecordType& ert, Proc& proc)
+{
+    this->_buildReadScopeInstr(Scope::EventRecordSpecificContext, ert.specificContextType(), proc);
+    this->_buildReadScopeInstr(Scope::EventRecordPayload, ert.payloadType(), proc);
+}
+
 void PktProcBuilder::_buildReadScopeInstr(const Scope scope, const DataType * const dt,
                                           Proc& baseProc)
 {
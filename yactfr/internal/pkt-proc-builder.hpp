@@ -48,7 +48,41 @@ public:
         return std::move(_pktProc);
     }
 
+    /*
+     * Tries to add, in place, the event record procedures of the event
+     * record types `erts`, which are new within the data stream type
+     * `dst`, to the existing packet procedure `pktProc`.
+     *
+     * This is only possible when:
+     *
+     * * The event record preamble procedure of `dst` reads the current
+     *   event record type ID (no fixed ID).
+     *
+     * * All the length/selector types of the new event record types
+     *   are within those same event record types, so that no existing
+     *   procedure needs a new "save value" instruction.
+     *
+     * Returns `false`, leaving `pktProc` unchanged, if it's not
+     * possible.
+     */
+    static bool tryAddErProcs(PktProc& pktProc, const DataStreamType& dst,
+                              const std::vector<const EventRecordType *>& erts);
+
+    /*
+     * Builds the placeholder event record procedure `erProc` of the
+     * packet procedure `pktProc`, unless it's already built.
+     *
+     * The procedure of the event record type of `erProc` must only need
+     * the values which it reads itself.
+     *
+     * This method is thread-safe: element sequence iterators on
+     * different threads may call it for the same packet procedure.
+     */
+    static void buildLazyErProc(const PktProc& pktProc, const ErProc& erProc);
+
 private:
+    PktProcBuilder() = default;
+
     using _tDtReadLenSelInstrMap = std::unordered_map<const DataType *, InstrLoc>;
 
 private:
@@ -61,9 +95,17 @@ private:
     void _insertUpdateDefClkValInstrs();
     _tDtReadLenSelInstrMap _createDtReadLenSelInstrMap() const;
     void _setSavedValPoss();
+    void _setFieldValPoss();
+    static void _insertSaveFieldValInstrs(Proc& proc, const PktProc& pktProc);
     void _insertEndInstrs();
+    void _setMaxStackDepths();
+    void _setErRowLayouts();
+    static void _setErRowLayout(ErProc& erProc);
+    static bool _addErRowLayoutFields(const Proc& proc, EventRecordRowLayout& layout,
+                                      unsigned int& nextDsAlign);
     std::unique_ptr<DsPktProc> _buildDsPktProc(const DataStreamType& dst);
     std::unique_ptr<ErProc> _buildErProc(const EventRecordType& ert);
+    void _buildErProcProc(const EventRecordType& ert, Proc& proc);
     void _buildReadScopeInstr(Scope scope, const DataType *dt, Proc& baseProc);
     void _buildReadInstr(const StructureMemberType *memberType, const DataType& dt, Proc& baseProc);
 
@@ -143,6 +143,10 @@ std::string Instr::toStr(const Size indent) const
         ss << _strSpecName(kindStr);
     }
 
+#ifdef YACTFR_PROFILE
+    ss << profCountersToStr(_prof);
+#endif
+
     ss << this->_toStr(indent);
     return ss.str();
 }
@@ -177,6 +181,20 @@ std::string ReadDataInstr::_commonToStr() const
     return ss.str();
 }
 
+SaveFieldValInstr::SaveFieldValInstr(const Index pos) :
+    Instr {Kind::SaveFieldVal},
+    _pos {pos}
+{
+}
+
+std::string SaveFieldValInstr::_toStr(Size) const
+{
+    std::ostringstream ss;
+
+    ss << " " << _strProp("pos") << _pos << " " << std::endl;
+    return ss.str();
+}
+
 SaveValInstr::SaveValInstr(const Index pos) :
     Instr {Kind::SaveVal},
     _pos {pos}
@@ -1390,8 +1408,9 @@ DecrRemainingElemsInstr::DecrRemainingElemsInstr() :
 {
 }
 
-ErProc::ErProc(const EventRecordType& eventRecordType) :
-    _ert {&eventRecordType}
+ErProc::ErProc(const EventRecordType& eventRecordType, const bool isBuilt) :
+    _ert {&eventRecordType},
+    _isBuilt {isBuilt}
 {
 }
 
@@ -1411,6 +1430,13 @@ std::string ErProc::toStr(const Size indent) const
           ss << " " << _strProp("ert-name") << "`" << *_ert->name() << "`";
     }
 
+    if (!this->isBuilt()) {
+        ss << " (not built)" << std::endl;
+        return ss.str();
+    }
+
+    ss << " " << _strProp("saved-vals-count") << _savedValsCount;
+    ss << " " << _strProp("max-stack-depth") << _maxStackDepth;
     ss << std::endl;
     ss << internal::indent(indent + 1) << "<proc>" << std::endl;
     ss << _proc.toStr(indent + 2);
@@ -1580,7 +1606,9 @@ std::string PktProc::toStr(const Size indent) const
     std::ostringstream ss;
 
     ss << internal::indent(indent) << _strTopName("pkt proc") << " " <<
-          _strProp("saved-vals-count") << _savedValsCount << std::endl <<
+          _strProp("saved-vals-count") << _savedValsCount << " " <<
+          _strProp("field-vals-count") << _fieldValsCount << " " <<
+          _strProp("max-stack-depth") << this->maxStackDepth() << std::endl <<
           internal::indent(indent + 1) << "<preamble proc>" << std::endl <<
           _preambleProc.toStr(indent + 2);
 
@@ -62,13 +62,20 @@
 #include <cassert>
 #include <sstream>
 #include <list>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <vector>
+#include <unordered_map>
 #include <utility>
 #include <functional>
 #include <type_traits>
+#include <array>
 #include <boost/optional/optional.hpp>
 
 #include <yactfr/aliases.hpp>
+#include <yactfr/er-row-layout.hpp>
 #include <yactfr/metadata/dt.hpp>
 #include <yactfr/metadata/fl-bit-array-type.hpp>
 #include <yactfr/metadata/fl-bit-map-type.hpp>
@@ -92,6 +99,7 @@
 #include <yactfr/metadata/trace-type.hpp>
 
 #include "utils.hpp"
+#include "profile.hpp"
 #include "vendor/wise-enum/wise_enum.h"
 
 namespace yactfr {
@@ -129,6 +137,7 @@ class ReadFlSIntInstr;
 class ReadNtStrInstr;
 class ReadFlUIntInstr;
 class ReadVlIntInstr;
+class SaveFieldValInstr;
 class SaveValInstr;
 class SetCurIdInstr;
 class SetDsIdInstr;
@@ -302,6 +311,10 @@ public:
     {
     }
 
+    virtual void visit(SaveFieldValInstr&)
+    {
+    }
+
     virtual void visit(SaveValInstr&)
     {
     }
@@ -569,6 +582,7 @@ public:
         ReadNtStrUtf8,
         ReadVlSInt,
         ReadVlUInt,
+        SaveFieldVal,
         SaveVal,
         SetCurId,
         SetDsId,
@@ -763,17 +777,40 @@ public:
         }
     }
 
+    /*
+     * True if this is a `ReadFlBitArrayInstr` instance.
+     *
+     * This relies on the order of the `Kind` enumerators: all the "read
+     * fixed-length bit array" kinds are contiguous.
+     */
+    bool isReadFlBitArray() const noexcept
+    {
+        return _theKind >= Kind::ReadFlBitArrayA16Be && _theKind <= Kind::ReadFlUIntLeRev;
+    }
+
     Kind kind() const noexcept
     {
         assert(_theKind != Kind::Unset);
         return _theKind;
     }
 
+#ifdef YACTFR_PROFILE
+    // profile counters of the executions of this instruction
+    ProfCounters& prof() const noexcept
+    {
+        return _prof;
+    }
+#endif
+
 private:
     virtual std::string _toStr(Size indent = 0) const;
 
 private:
     const Kind _theKind = Kind::Unset;
+
+#ifdef YACTFR_PROFILE
+    mutable ProfCounters _prof;
+#endif
 };
 
 /*
@@ -816,6 +853,37 @@ private:
     const unsigned int _align;
 };
 
+/*
+ * "Save field value" procedure instruction.
+ *
+ * This instruction requires the VM to save the last decoded integer
+ * value to a position (index) in its field value vector so that the
+ * user can get it through the field handle having this index (see
+ * `TraceTypeImpl::fieldHandle()`).
+ */
+class SaveFieldValInstr final :
+    public Instr
+{
+public:
+    explicit SaveFieldValInstr(Index pos);
+
+    Index pos() const noexcept
+    {
+        return _pos;
+    }
+
+    void accept(InstrVisitor& visitor) override
+    {
+        visitor.visit(*this);
+    }
+
+private:
+    std::string _toStr(Size indent = 0) const override;
+
+private:
+    Index _pos;
+};
+
 /*
  * "Save value" procedure instruction.
  *
@@ -2229,14 +2297,57 @@ public:
 
 /*
  * Event record procedure.
+ *
+ * An event record procedure may be a placeholder (isBuilt() returns
+ * `false`): its procedure is empty until
+ * PktProcBuilder::buildLazyErProc() builds it, on the first dispatch
+ * of its event record type.
  */
 class ErProc final
 {
 public:
-    explicit ErProc(const EventRecordType& ert);
+    explicit ErProc(const EventRecordType& ert, bool isBuilt = true);
     std::string toStr(Size indent) const;
     void buildRawProcFromShared();
 
+    bool isBuilt() const noexcept
+    {
+        return _isBuilt.load(std::memory_order_acquire);
+    }
+
+    void markBuilt() noexcept
+    {
+        _isBuilt.store(true, std::memory_order_release);
+    }
+
+    /*
+     * Minimum number of saved values which the VM needs to execute
+     * this procedure.
+     */
+    Size savedValsCount() const noexcept
+    {
+        return _savedValsCount;
+    }
+
+    void savedValsCount(const Size savedValsCount) noexcept
+    {
+        _savedValsCount = savedValsCount;
+    }
+
+    /*
+     * Maximum number of VM stack frames which executing this
+     * procedure needs.
+     */
+    Size maxStackDepth() const noexcept
+    {
+        return _maxStackDepth;
+    }
+
+    void maxStackDepth(const Size maxStackDepth) noexcept
+    {
+        _maxStackDepth = maxStackDepth;
+    }
+
     Proc& proc() noexcept
     {
         return _proc;
@@ -2252,9 +2363,27 @@ public:
         return *_ert;
     }
 
+    /*
+     * Row layout of the event record type of this procedure, or
+     * `nullptr` if it doesn't have a static layout.
+     */
+    const EventRecordRowLayout *rowLayout() const noexcept
+    {
+        return _rowLayout.get();
+    }
+
+    void rowLayout(std::unique_ptr<const EventRecordRowLayout> rowLayout) noexcept
+    {
+        _rowLayout = std::move(rowLayout);
+    }
+
 private:
     const EventRecordType * const _ert;
     Proc _proc;
+    std::unique_ptr<const EventRecordRowLayout> _rowLayout;
+    Size _savedValsCount = 0;
+    Size _maxStackDepth = 0;
+    std::atomic<bool> _isBuilt;
 };
 
 /*
@@ -2276,17 +2405,23 @@ public:
     void buildRawProcFromShared();
     void setErAlign();
 
+    /*
+     * Calls `func` for each built (not placeholder) event record
+     * procedure.
+     */
     template <typename FuncT>
     void forEachErProc(FuncT&& func)
     {
         for (auto& erProc : _erProcsVec) {
-            if (erProc) {
+            if (erProc && erProc->isBuilt()) {
                 func(*erProc);
             }
         }
 
         for (auto& idErProcUpPair : _erProcsMap) {
-            func(*idErProcUpPair.second);
+            if (idErProcUpPair.second->isBuilt()) {
+                func(*idErProcUpPair.second);
+            }
         }
     }
 
@@ -2315,11 +2450,21 @@ public:
         return _erProcsMap;
     }
 
+    const ErProcsMap& erProcsMap() const noexcept
+    {
+        return _erProcsMap;
+    }
+
     ErProcsVec& erProcsVec() noexcept
     {
         return _erProcsVec;
     }
 
+    const ErProcsVec& erProcsVec() const noexcept
+    {
+        return _erProcsVec;
+    }
+
     Size erProcsCount() const noexcept
     {
         return _erProcsMap.size() + _erProcsVec.size();
@@ -2393,6 +2538,11 @@ public:
         return _dsPktProcs;
     }
 
+    const DsPktProcs& dsPktProcs() const noexcept
+    {
+        return _dsPktProcs;
+    }
+
     Size dsPktProcsCount() const noexcept
     {
         return _dsPktProcs.size();
@@ -2418,11 +2568,112 @@ public:
         _savedValsCount = savedValsCount;
     }
 
+    /*
+     * Number of field values (one per field handle of the trace type
+     * when this packet procedure was built).
+     */
+    Size fieldValsCount() const noexcept
+    {
+        return _fieldValsCount;
+    }
+
+    void fieldValsCount(const Size fieldValsCount) noexcept
+    {
+        _fieldValsCount = fieldValsCount;
+    }
+
+    /*
+     * Field value positions of the boolean and integer data types
+     * which field handles target.
+     */
+    const std::unordered_map<const DataType *, Index>& fieldValPoss() const noexcept
+    {
+        return _fieldValPoss;
+    }
+
+    void fieldValPoss(std::unordered_map<const DataType *, Index>&& fieldValPoss)
+    {
+        _fieldValPoss = std::move(fieldValPoss);
+    }
+
+    /*
+     * Maximum number of VM stack frames which executing any built
+     * procedure of this packet procedure needs.
+     */
+    Size maxStackDepth() const noexcept
+    {
+        return _maxStackDepth.load(std::memory_order_relaxed);
+    }
+
+    void maxStackDepth(const Size maxStackDepth)
+    {
+        _maxStackDepth.store(maxStackDepth, std::memory_order_relaxed);
+    }
+
+    /*
+     * Maximum number of saved values which executing any built
+     * procedure of this packet procedure needs (at least
+     * savedValsCount()).
+     */
+    Size maxSavedValsCount() const noexcept
+    {
+        return std::max(_savedValsCount,
+                        _builtErProcsSavedValsCount.load(std::memory_order_relaxed));
+    }
+
+    /*
+     * Makes maxStackDepth() and maxSavedValsCount() account for the
+     * placeholder event record procedure `erProc` which
+     * PktProcBuilder::buildLazyErProc() just built, with the mutex of
+     * lazyErProcMutex() locked.
+     *
+     * Those are only capacity hints for new VMs: a VM checks the needs
+     * of an event record procedure when dispatching it anyway.
+     */
+    void accountBuiltErProc(const ErProc& erProc) const noexcept
+    {
+        if (erProc.maxStackDepth() > this->maxStackDepth()) {
+            _maxStackDepth.store(erProc.maxStackDepth(), std::memory_order_relaxed);
+        }
+
+        if (erProc.savedValsCount() > _builtErProcsSavedValsCount.load(std::memory_order_relaxed)) {
+            _builtErProcsSavedValsCount.store(erProc.savedValsCount(), std::memory_order_relaxed);
+        }
+    }
+
+    /*
+     * Mutex which serializes the builds of placeholder event record
+     * procedures, as element sequence iterators on different threads
+     * may share this packet procedure.
+     */
+    std::mutex& lazyErProcMutex() const noexcept
+    {
+        return _lazyErProcMutex;
+    }
+
+#ifdef YACTFR_PROFILE
+    // profile counters of the VM state `state` (see `VmState`)
+    ProfCounters& stateProf(const Index state) const noexcept
+    {
+        assert(state < profVmStateCount);
+        return _stateProfs[state];
+    }
+#endif
+
 private:
     const TraceType * const _traceType;
     DsPktProcs _dsPktProcs;
     Size _savedValsCount = 0;
+    Size _fieldValsCount = 0;
+    std::unordered_map<const DataType *, Index> _fieldValPoss;
+    mutable std::atomic<Size> _maxStackDepth {0};
+    mutable std::atomic<Size> _builtErProcsSavedValsCount {0};
     Proc _preambleProc;
+    mutable std::mutex _lazyErProcMutex;
+
+#ifdef YACTFR_PROFILE
+    mutable std::array<ProfCounters, profVmStateCount> _stateProfs;
+#endif
 };
 
 inline ReadDataInstr& instrAsReadData(Instr& instr) noexcept
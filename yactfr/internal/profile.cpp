@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "profile.hpp"
+#include "proc.hpp"
+
+namespace yactfr {
+namespace internal {
+namespace {
+
+/*
+ * Total estimated duration (ns) of the instructions of the packet
+ * procedure which profToStr() is currently printing, or 0.
+ */
+thread_local unsigned long long curProfTotalNs = 0;
+
+// names of the VM states, in `VmState` order
+const char * const vmStateNames[] = {
+    "BeginPkt",
+    "BeginPktContent",
+    "EndPktContent",
+    "EndPkt",
+    "BeginEr",
+    "EndEr",
+    "ExecInstr",
+    "ExecArrayInstr",
+    "ReadUuidByte",
+    "ReadUtf8DataUntilNull",
+    "ReadUtf16DataUntilNull",
+    "ReadUtf32DataUntilNull",
+    "ReadRawData",
+    "ReadUuidBlobSection",
+    "ContinueReadVlUInt",
+    "ContinueReadVlSInt",
+    "EndStr",
+    "SetMetadataStreamUuid",
+    "ContinueSkipPaddingBits",
+    "ContinueSkipContentPaddingBits",
+};
+
+static_assert(sizeof vmStateNames / sizeof *vmStateNames == profVmStateCount,
+              "There's one name per VM state");
+
+/*
+ * Node of a flame graph, one per procedure instruction or per group of
+ * procedures.
+ */
+struct ProfNode final
+{
+    std::string name;
+
+    // profile counters of the instruction of this node, if any
+    const ProfCounters *counters = nullptr;
+
+    std::vector<ProfNode> children;
+
+    // estimated duration (ns) of this node, including its children
+    unsigned long long value() const noexcept
+    {
+        auto val = counters ? counters->estNs() : 0;
+
+        for (const auto& child : children) {
+            val += child.value();
+        }
+
+        return val;
+    }
+};
+
+ProfNode profNodeFromProc(std::string name, const Proc& proc);
+
+ProfNode profNodeFromInstr(const Instr& instr)
+{
+    ProfNode node;
+
+    node.name = wise_enum::to_string(instr.kind());
+    node.counters = &instr.prof();
+
+    if (const auto readDataInstr = dynamic_cast<const ReadDataInstr *>(&instr)) {
+        if (readDataInstr->memberType()) {
+            node.name += " `";
+            node.name += readDataInstr->memberType()->name();
+            node.name += '`';
+        }
+    }
+
+    if (const auto compoundInstr = dynamic_cast<const BeginReadCompoundInstr *>(&instr)) {
+        node.children = profNodeFromProc("", compoundInstr->proc()).children;
+    } else if (instr.kind() == Instr::Kind::BeginReadScope) {
+        node.children = profNodeFromProc("",
+                                         static_cast<const BeginReadScopeInstr&>(instr).proc()).children;
+    } else {
+        /*
+         * One child per variant option: options sharing instructions
+         * count them more than once.
+         */
+        const auto addOptNodes = [&node](const auto& opts) {
+            for (const auto& opt : opts) {
+                std::string name {"<var opt>"};
+
+                if (opt.opt().name()) {
+                    name += " `";
+                    name += *opt.opt().name();
+                    name += '`';
+                }
+
+                node.children.push_back(profNodeFromProc(std::move(name), opt.proc()));
+            }
+        };
+
+        if (instr.kind() == Instr::Kind::BeginReadVarUIntSel) {
+            addOptNodes(static_cast<const BeginReadVarUIntSelInstr&>(instr).opts());
+        } else if (instr.kind() == Instr::Kind::BeginReadVarSIntSel) {
+            addOptNodes(static_cast<const BeginReadVarSIntSelInstr&>(instr).opts());
+        }
+    }
+
+    return node;
+}
+
+ProfNode profNodeFromProc(std::string name, const Proc& proc)
+{
+    ProfNode node;
+
+    node.name = std::move(name);
+
+    for (const auto& instr : proc.sharedProc()) {
+        node.children.push_back(profNodeFromInstr(*instr));
+    }
+
+    return node;
+}
+
+ProfNode profNodeFromErProc(const ErProc& erProc)
+{
+    std::ostringstream ss;
+
+    ss << "<ER proc> " << erProc.ert().id();
+
+    if (erProc.ert().name()) {
+        ss << " `" << *erProc.ert().name() << '`';
+    }
+
+    return profNodeFromProc(ss.str(), erProc.proc());
+}
+
+ProfNode profNodeFromPktProc(const PktProc& pktProc)
+{
+    ProfNode node;
+
+    node.name = "<pkt proc>";
+    node.children.push_back(profNodeFromProc("<preamble proc>", pktProc.preambleProc()));
+
+    for (const auto& idDsPktProcPair : pktProc.dsPktProcs()) {
+        const auto& dsPktProc = *idDsPktProcPair.second;
+        ProfNode dsNode;
+
+        dsNode.name = "<DS pkt proc> " + std::to_string(dsPktProc.dst().id());
+        dsNode.children.push_back(profNodeFromProc("<pkt preamble proc>",
+                                                   dsPktProc.pktPreambleProc()));
+        dsNode.children.push_back(profNodeFromProc("<ER preamble proc>",
+                                                   dsPktProc.erPreambleProc()));
+
+        for (const auto& erProc : dsPktProc.erProcsVec()) {
+            if (erProc) {
+                dsNode.children.push_back(profNodeFromErProc(*erProc));
+            }
+        }
+
+        for (const auto& idErProcPair : dsPktProc.erProcsMap()) {
+            dsNode.children.push_back(profNodeFromErProc(*idErProcPair.second));
+        }
+
+        node.children.push_back(std::move(dsNode));
+    }
+
+    return node;
+}
+
+std::string jsonStr(const std::string& str)
+{
+    std::ostringstream ss;
+
+    ss << '"';
+
+    for (const auto ch : str) {
+        switch (ch) {
+        case '"':
+            ss << "\\\"";
+            break;
+
+        case '\\':
+            ss << "\\\\";
+            break;
+
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') <<
+                      static_cast<unsigned int>(ch) << std::dec;
+            } else {
+                ss << ch;
+            }
+        }
+    }
+
+    ss << '"';
+    return ss.str();
+}
+
+// writes `node` without its closing brace
+void writeJsonNode(std::ostream& os, const ProfNode& node)
+{
+    os << "{\"name\":" << jsonStr(node.name) << ",\"value\":" << node.value();
+
+    if (node.counters) {
+        os << ",\"hits\":" << node.counters->hits();
+    }
+
+    os << ",\"children\":[";
+
+    for (auto it = node.children.begin(); it != node.children.end(); ++it) {
+        if (it != node.children.begin()) {
+            os << ',';
+        }
+
+        writeJsonNode(os, *it);
+        os << '}';
+    }
+
+    os << ']';
+}
+
+} // namespace
+
+std::string profCountersToStr(const ProfCounters& counters)
+{
+    std::ostringstream ss;
+
+    ss << " " << _strProp("hits") << counters.hits() << " " <<
+          _strProp("est-time-ns") << counters.estNs();
+
+    if (curProfTotalNs > 0) {
+        ss << " " << _strProp("time-share") << std::fixed << std::setprecision(2) <<
+              100. * counters.estNs() / curProfTotalNs << '%';
+    }
+
+    return ss.str();
+}
+
+std::string profToStr(const PktProc& pktProc)
+{
+    std::ostringstream ss;
+
+    curProfTotalNs = profNodeFromPktProc(pktProc).value();
+    ss << pktProc.toStr(0);
+    curProfTotalNs = 0;
+    ss << "<VM states>" << std::endl;
+
+    for (Index i = 0; i < profVmStateCount; ++i) {
+        ss << internal::indent(1) << vmStateNames[i] << profCountersToStr(pktProc.stateProf(i)) <<
+              std::endl;
+    }
+
+    return ss.str();
+}
+
+std::string profToJson(const PktProc& pktProc)
+{
+    std::ostringstream ss;
+
+    writeJsonNode(ss, profNodeFromPktProc(pktProc));
+    ss << ",\"vm-states\":[";
+
+    for (Index i = 0; i < profVmStateCount; ++i) {
+        const auto& counters = pktProc.stateProf(i);
+
+        if (i > 0) {
+            ss << ',';
+        }
+
+        ss << "{\"name\":" << jsonStr(vmStateNames[i]) << ",\"hits\":" << counters.hits() <<
+              ",\"est-time-ns\":" << counters.estNs() << '}';
+    }
+
+    ss << "]}";
+    return ss.str();
+}
+
+void dumpProf(const PktProc& pktProc)
+{
+    const auto printVar = std::getenv("YACTFR_PROFILE_PRINT_PROC");
+
+    if (printVar && std::strcmp(printVar, "1") == 0) {
+        std::cerr << profToStr(pktProc) << std::endl;
+    }
+
+    const auto jsonPath = std::getenv("YACTFR_PROFILE_JSON");
+
+    if (jsonPath) {
+        std::ofstream file {jsonPath};
+
+        file << profToJson(pktProc) << std::endl;
+    }
+}
+
+} // namespace internal
+} // namespace yactfr
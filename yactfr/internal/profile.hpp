@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_PROFILE_HPP
+#define YACTFR_INTERNAL_PROFILE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <yactfr/aliases.hpp>
+
+namespace yactfr {
+namespace internal {
+
+class PktProc;
+
+/*
+ * The VM measures one execution of a given instruction, or one
+ * handling of a given VM state, out of `profSamplingPeriod`.
+ */
+constexpr unsigned int profSamplingPeriod = 16;
+
+// number of VM states (see `VmState`)
+constexpr Size profVmStateCount = 20;
+
+/*
+ * Profile counters of a procedure instruction or of a VM state.
+ *
+ * Only the VM of a library built with `YACTFR_PROFILE` updates them.
+ *
+ * Several VMs, on different threads, may update the same counters.
+ */
+class ProfCounters final
+{
+public:
+    explicit ProfCounters() = default;
+
+    // instructions are copyable
+    ProfCounters(const ProfCounters& other) noexcept
+    {
+        *this = other;
+    }
+
+    ProfCounters& operator=(const ProfCounters& other) noexcept
+    {
+        _hits.store(other.hits(), std::memory_order_relaxed);
+        _sampledHits.store(other.sampledHits(), std::memory_order_relaxed);
+        _sampledNs.store(other.sampledNs(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    /*
+     * Counts one execution, returning whether or not the caller must
+     * measure it and then call addSample().
+     */
+    bool hit() noexcept
+    {
+        return (_hits.fetch_add(1, std::memory_order_relaxed) + 1) % profSamplingPeriod == 0;
+    }
+
+    void addSample(const std::chrono::nanoseconds dur) noexcept
+    {
+        _sampledHits.fetch_add(1, std::memory_order_relaxed);
+        _sampledNs.fetch_add(dur.count(), std::memory_order_relaxed);
+    }
+
+    // number of executions
+    unsigned long long hits() const noexcept
+    {
+        return _hits.load(std::memory_order_relaxed);
+    }
+
+    // number of measured executions
+    unsigned long long sampledHits() const noexcept
+    {
+        return _sampledHits.load(std::memory_order_relaxed);
+    }
+
+    // total duration (ns) of the measured executions
+    unsigned long long sampledNs() const noexcept
+    {
+        return _sampledNs.load(std::memory_order_relaxed);
+    }
+
+    // estimated total duration (ns) of all the executions
+    unsigned long long estNs() const noexcept
+    {
+        const auto sampledHits = this->sampledHits();
+
+        if (sampledHits == 0) {
+            return 0;
+        }
+
+        return static_cast<unsigned long long>(static_cast<double>(this->sampledNs()) *
+                                               this->hits() / sampledHits);
+    }
+
+private:
+    std::atomic<unsigned long long> _hits {0};
+    std::atomic<unsigned long long> _sampledHits {0};
+    std::atomic<unsigned long long> _sampledNs {0};
+};
+
+/*
+ * Returns the properties of `counters` for Instr::toStr() and the like,
+ * including its share of the total duration which profToStr() is
+ * currently printing.
+ */
+std::string profCountersToStr(const ProfCounters& counters);
+
+/*
+ * Returns the procedure tree of `pktProc` annotated with the profile
+ * counters of each instruction, followed by the profile counters of
+ * each VM state.
+ */
+std::string profToStr(const PktProc& pktProc);
+
+/*
+ * Returns the profile of `pktProc` as a JSON object.
+ *
+ * The object is a node of a flame graph (`name`, `value`, and
+ * `children` properties, as d3-flame-graph expects), the value of a
+ * node being the estimated duration (ns) of its instruction, if any,
+ * plus the values of its children. Each instruction node also has a
+ * `hits` property.
+ *
+ * The `vm-states` property of the root node is an array of the profile
+ * counters of each VM state.
+ */
+std::string profToJson(const PktProc& pktProc);
+
+/*
+ * Dumps the profile of `pktProc`:
+ *
+ * • If the `YACTFR_PROFILE_PRINT_PROC` environment variable is `1`,
+ *   prints profToStr() to the standard error.
+ *
+ * • If the `YACTFR_PROFILE_JSON` environment variable is set, writes
+ *   profToJson() to the file having this path.
+ */
+void dumpProf(const PktProc& pktProc);
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_PROFILE_HPP
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <sstream>
+#include <limits>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+
+#include <yactfr/io-error.hpp>
+
+#include "shm-ring-data-src-factory-impl.hpp"
+#include "utils.hpp"
+
+namespace yactfr {
+namespace internal {
+
+ShmRingDataSrcFactoryImpl::ShmRingDataSrcFactoryImpl(std::string name) :
+    _name {std::move(name)}
+{
+    _fd = shm_open(_name.c_str(), O_RDWR, 0);
+
+    if (_fd < 0) {
+        const auto error = internal::strError();
+        std::ostringstream ss;
+
+        ss << "Cannot open shared memory object \"" << _name << "\": " << error;
+        throw IOError {ss.str()};
+    }
+
+    struct stat stat;
+
+    if (fstat(_fd, &stat) < 0) {
+        const auto error = internal::strError();
+        std::ostringstream ss;
+
+        ss << "Cannot get status of shared memory object \"" << _name << "\": " << error;
+        this->_close();
+        throw IOError {ss.str()};
+    }
+
+    if (static_cast<Size>(stat.st_size) < sizeof(SharedMemoryRingHeader)) {
+        std::ostringstream ss;
+
+        ss << "Shared memory object \"" << _name << "\" is too small (" << stat.st_size <<
+              " bytes) to contain a packet ring header.";
+        this->_close();
+        throw IOError {ss.str()};
+    }
+
+    _size = static_cast<Size>(stat.st_size);
+
+    // read-write: a consumer writes its own consumer position entry
+    _addr = mmap(nullptr, static_cast<size_t>(_size), PROT_READ | PROT_WRITE, MAP_SHARED,
+                 _fd, 0);
+
+    if (_addr == MAP_FAILED) {
+        const auto error = internal::strError();
+        std::ostringstream ss;
+
+        ss << "Cannot memory-map shared memory object \"" << _name << "\": " << error;
+        _addr = nullptr;
+        this->_close();
+        throw IOError {ss.str()};
+    }
+
+    try {
+        this->_validate(_size);
+    } catch (...) {
+        this->_close();
+        throw;
+    }
+}
+
+ShmRingDataSrcFactoryImpl::~ShmRingDataSrcFactoryImpl()
+{
+    this->_close();
+}
+
+void ShmRingDataSrcFactoryImpl::_validate(const Size size) const
+{
+    const auto& header = this->header();
+    std::ostringstream ss;
+
+    ss << "Invalid packet ring in shared memory object \"" << _name << "\": ";
+
+    if (header.magic != SharedMemoryRingHeader::expectedMagic) {
+        ss << "unexpected magic number " << header.magic << '.';
+        throw IOError {ss.str()};
+    }
+
+    if (header.version != SharedMemoryRingHeader::expectedVersion) {
+        ss << "unsupported layout version " << header.version << '.';
+        throw IOError {ss.str()};
+    }
+
+    if (header.maxConsumerCount == 0 || header.slotCount == 0) {
+        ss << "no consumer position entries or no packet slots.";
+        throw IOError {ss.str()};
+    }
+
+    if (header.slotSize > std::numeric_limits<std::uint64_t>::max() / 2 ||
+            header.slotCount > (std::numeric_limits<std::uint64_t>::max() -
+                                header.slotsOffset()) / header.slotStride() ||
+            header.segmentSize() > size) {
+        ss << "shared memory object is too small (" << size << " bytes) to contain " <<
+              header.slotCount << " packet slots of " << header.slotSize << " bytes.";
+        throw IOError {ss.str()};
+    }
+}
+
+void ShmRingDataSrcFactoryImpl::_close() noexcept
+{
+    if (_addr) {
+        static_cast<void>(munmap(_addr, static_cast<size_t>(_size)));
+        _addr = nullptr;
+    }
+
+    if (_fd >= 0) {
+        static_cast<void>(close(_fd));
+        _fd = -1;
+    }
+}
+
+Index ShmRingDataSrcFactoryImpl::acquireConsumer()
+{
+    auto& header = this->header();
+
+    for (Index index = 0; index < header.maxConsumerCount; ++index) {
+        auto& pos = this->consumerPos(index);
+        auto expectedPos = SharedMemoryRingHeader::freeConsumerPosition;
+
+        /*
+         * Occupy the entry with the position 0 first: from this point,
+         * the producer cannot overwrite any packet.
+         *
+         * Then we can safely move to the oldest packet which the
+         * producer cannot be overwriting: while we read
+         * `publishedCount` (N), the producer could be writing the
+         * packet N to the slot of the packet N - slotCount, but not
+         * beyond.
+         */
+        if (!pos.compare_exchange_strong(expectedPos, 0)) {
+            continue;
+        }
+
+        const auto publishedCount = header.publishedCount.load();
+        const auto safeCount = header.slotCount - 1;
+
+        pos.store(publishedCount >= safeCount ? publishedCount - safeCount : 0);
+        return index;
+    }
+
+    std::ostringstream ss;
+
+    ss << "No free consumer position entry in the packet ring of shared memory object \"" <<
+          _name << "\" (" << header.maxConsumerCount << " entries).";
+    throw IOError {ss.str()};
+}
+
+void ShmRingDataSrcFactoryImpl::releaseConsumer(const Index index) noexcept
+{
+    this->consumerPos(index).store(SharedMemoryRingHeader::freeConsumerPosition);
+}
+
+} // namespace internal
+} // namespace yactfr
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#ifndef YACTFR_INTERNAL_SHM_RING_DATA_SRC_FACTORY_IMPL_HPP
+#define YACTFR_INTERNAL_SHM_RING_DATA_SRC_FACTORY_IMPL_HPP
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <yactfr/aliases.hpp>
+#include <yactfr/shm-ring-data-src-factory.hpp>
+
+namespace yactfr {
+namespace internal {
+
+/*
+ * A `ShmRingDataSrcFactoryImpl` object is shared by zero or more
+ * `ShmRingDataSrc` objects, and also by the public
+ * `SharedMemoryRingDataSourceFactory` object which builds it. Its only
+ * purpose is to open and map a shared memory packet ring and keep it
+ * mapped while any `ShmRingDataSrc` object reads it.
+ */
+class ShmRingDataSrcFactoryImpl final
+{
+public:
+    explicit ShmRingDataSrcFactoryImpl(std::string name);
+    ~ShmRingDataSrcFactoryImpl();
+
+    const std::string& name() const noexcept
+    {
+        return _name;
+    }
+
+    SharedMemoryRingHeader& header() const noexcept
+    {
+        return *static_cast<SharedMemoryRingHeader *>(_addr);
+    }
+
+    std::atomic<std::uint64_t>& consumerPos(const Index index) const noexcept
+    {
+        return *reinterpret_cast<std::atomic<std::uint64_t> *>(_addrAt(SharedMemoryRingHeader::consumerOffset(index)));
+    }
+
+    // size (bytes) of the packet having the sequence number `seq`
+    Size pktSize(const std::uint64_t seq) const noexcept
+    {
+        return *reinterpret_cast<const std::uint64_t *>(this->_slotAddr(seq));
+    }
+
+    // data of the packet having the sequence number `seq`
+    const std::uint8_t *pktData(const std::uint64_t seq) const noexcept
+    {
+        return this->_slotAddr(seq) + SharedMemoryRingHeader::lineSize;
+    }
+
+    /*
+     * Occupies a free consumer position entry, setting it to the
+     * sequence number of the oldest packet which is safe to read, and
+     * returns its index.
+     *
+     * Throws `IOError` if there's no free consumer position entry.
+     */
+    Index acquireConsumer();
+
+    // frees the consumer position entry at index `index`
+    void releaseConsumer(Index index) noexcept;
+
+private:
+    std::uint8_t *_addrAt(const Index offset) const noexcept
+    {
+        return static_cast<std::uint8_t *>(_addr) + offset;
+    }
+
+    std::uint8_t *_slotAddr(const std::uint64_t seq) const noexcept
+    {
+        return this->_addrAt(this->header().slotOffset(seq % this->header().slotCount));
+    }
+
+    void _validate(Size size) const;
+    void _close() noexcept;
+
+private:
+    const std::string _name;
+    int _fd = -1;
+    void *_addr = nullptr;
+    Size _size = 0;
+};
+
+} // namespace internal
+} // namespace yactfr
+
+#endif // YACTFR_INTERNAL_SHM_RING_DATA_SRC_FACTORY_IMPL_HPP
@@ -6,6 +6,7 @@
  */
 
 #include <sstream>
+#include <array>
 #include <string.h>
 #include <errno.h>
 
@@ -27,13 +28,31 @@ std::string indent(const Size indent)
     return ind;
 }
 
+namespace {
+
+/*
+ * The GNU version of strerror_r() returns the message, which isn't
+ * necessarily within the buffer, while the XSI version returns an
+ * error code.
+ */
+inline const char *strErrorMsg(const char * const ret, const char *)
+{
+        return ret;
+}
+
+inline const char *strErrorMsg(int, const char * const buf)
+{
+        return buf;
+}
+
+} // namespace
+
 std::string strError()
 {
-        std::vector<char> buf;
+        std::array<char, 1024> buf;
 
-        buf.reserve(1024);
-        strerror_r(errno, buf.data(), buf.capacity());
-        return buf.data();
+        buf[0] = '\0';
+        return strErrorMsg(strerror_r(errno, buf.data(), buf.size()), buf.data());
 }
 
 } // namespace internal
@@ -6,9 +6,12 @@
  */
 
 #include <cstdint>
+#include <cstring>
 
 #include "vm.hpp"
 #include "fl-int-reader.hpp"
+#include "pkt-proc-builder.hpp"
+#include "it-checkpoint.hpp"
 
 namespace yactfr {
 namespace internal {
@@ -36,7 +39,9 @@ VmPos& VmPos::operator=(const VmPos& other)
 
 void VmPos::_initVectorsFromPktProc()
 {
-    savedVals.resize(pktProc->savedValsCount(), sizeUnset);
+    stack.reserve(pktProc->maxStackDepth());
+    savedVals.resize(pktProc->maxSavedValsCount(), savedValUnset);
+    fieldVals.resize(pktProc->fieldValsCount(), boost::none);
 }
 
 void VmPos::_setSimpleFromOther(const VmPos& other)
@@ -59,6 +64,7 @@ void VmPos::_setSimpleFromOther(const VmPos& other)
     metadataStreamUuid = other.metadataStreamUuid;
     curExpectedPktTotalLenBits = other.curExpectedPktTotalLenBits;
     curExpectedPktContentLenBits = other.curExpectedPktContentLenBits;
+    lastErBeginning = other.lastErBeginning;
 }
 
 void VmPos::_setFromOther(const VmPos& other)
@@ -66,6 +72,7 @@ void VmPos::_setFromOther(const VmPos& other)
     this->_setSimpleFromOther(other);
     stack = other.stack;
     savedVals = other.savedVals;
+    fieldVals = other.fieldVals;
     defClkVal = other.defClkVal;
 }
 
@@ -165,22 +172,25 @@ bool ElementSequenceIteratorPosition::operator>=(const ElementSequenceIteratorPo
 
 namespace internal {
 
-Vm::Vm(DataSourceFactory& dataSrcFactory, const PktProc& pktProc, ElementSequenceIterator& it) :
+const Vm::ExecFuncs Vm::_execFuncs = Vm::_createExecFuncs();
+
+Vm::Vm(DataSourceFactory& dataSrcFactory, const bool shareDataSrc, const PktProc& pktProc,
+       ElementSequenceIterator& it) :
     _dataSrcFactory {&dataSrcFactory},
-    _dataSrc {dataSrcFactory.createDataSource()},
     _it {&it},
     _pos {pktProc}
 {
-    this->_initExecFuncs();
+    this->_useDataSrc(std::make_shared<VmDataSrc>(dataSrcFactory.createDataSource(),
+                                                  shareDataSrc));
 }
 
 Vm::Vm(const Vm& other, ElementSequenceIterator& it) :
     _dataSrcFactory {other._dataSrcFactory},
-    _dataSrc {_dataSrcFactory->createDataSource()},
     _it {&it},
     _pos {other._pos}
 {
-    this->_initExecFuncs();
+    this->_useDataSrc(other._dataSrc->isShareable ? other._dataSrc :
+                      std::make_shared<VmDataSrc>(_dataSrcFactory->createDataSource(), false));
     this->_resetBuffer();
 }
 
@@ -189,170 +199,180 @@ void Vm::setFromOther(const Vm& other, ElementSequenceIterator& it)
     assert(_dataSrcFactory == other._dataSrcFactory);
     _it = &it;
     _pos = other._pos;
+
+    if (other._dataSrc->isShareable) {
+        this->_useDataSrc(other._dataSrc);
+    }
+
     this->_resetBuffer();
 }
 
-void Vm::_initExecFuncs() noexcept
-{
-    this->_initExecFunc<Instr::Kind::BeginReadDlArray>(&Vm::_execBeginReadDlArray);
-    this->_initExecFunc<Instr::Kind::BeginReadDlBlob>(&Vm::_execBeginReadDlBlob);
-    this->_initExecFunc<Instr::Kind::BeginReadDlStr>(&Vm::_execBeginReadDlStr);
-    this->_initExecFunc<Instr::Kind::BeginReadOptBoolSel>(&Vm::_execBeginReadOptBoolSel);
-    this->_initExecFunc<Instr::Kind::BeginReadOptSIntSel>(&Vm::_execBeginReadOptSIntSel);
-    this->_initExecFunc<Instr::Kind::BeginReadOptUIntSel>(&Vm::_execBeginReadOptUIntSel);
-    this->_initExecFunc<Instr::Kind::BeginReadScope>(&Vm::_execBeginReadScope);
-    this->_initExecFunc<Instr::Kind::BeginReadSlArray>(&Vm::_execBeginReadSlArray);
-    this->_initExecFunc<Instr::Kind::BeginReadSlBlob>(&Vm::_execBeginReadSlBlob);
-    this->_initExecFunc<Instr::Kind::BeginReadSlStr>(&Vm::_execBeginReadSlStr);
-    this->_initExecFunc<Instr::Kind::BeginReadSlUuidArray>(&Vm::_execBeginReadSlUuidArray);
-    this->_initExecFunc<Instr::Kind::BeginReadSlUuidBlob>(&Vm::_execBeginReadSlUuidBlob);
-    this->_initExecFunc<Instr::Kind::BeginReadStruct>(&Vm::_execBeginReadStruct);
-    this->_initExecFunc<Instr::Kind::BeginReadVarSIntSel>(&Vm::_execBeginReadVarSIntSel);
-    this->_initExecFunc<Instr::Kind::BeginReadVarUIntSel>(&Vm::_execBeginReadVarUIntSel);
-    this->_initExecFunc<Instr::Kind::EndDsErPreambleProc>(&Vm::_execEndDsErPreambleProc);
-    this->_initExecFunc<Instr::Kind::EndDsPktPreambleProc>(&Vm::_execEndDsPktPreambleProc);
-    this->_initExecFunc<Instr::Kind::EndErProc>(&Vm::_execEndErProc);
-    this->_initExecFunc<Instr::Kind::EndPktPreambleProc>(&Vm::_execEndPktPreambleProc);
-    this->_initExecFunc<Instr::Kind::EndReadDlArray>(&Vm::_execEndReadDlArray);
-    this->_initExecFunc<Instr::Kind::EndReadDlBlob>(&Vm::_execEndReadDlBlob);
-    this->_initExecFunc<Instr::Kind::EndReadDlStr>(&Vm::_execEndReadDlStr);
-    this->_initExecFunc<Instr::Kind::EndReadOptBoolSel>(&Vm::_execEndReadOptBoolSel);
-    this->_initExecFunc<Instr::Kind::EndReadOptSIntSel>(&Vm::_execEndReadOptSIntSel);
-    this->_initExecFunc<Instr::Kind::EndReadOptUIntSel>(&Vm::_execEndReadOptUIntSel);
-    this->_initExecFunc<Instr::Kind::EndReadScope>(&Vm::_execEndReadScope);
-    this->_initExecFunc<Instr::Kind::EndReadSlArray>(&Vm::_execEndReadSlArray);
-    this->_initExecFunc<Instr::Kind::EndReadSlBlob>(&Vm::_execEndReadSlBlob);
-    this->_initExecFunc<Instr::Kind::EndReadSlStr>(&Vm::_execEndReadSlStr);
-    this->_initExecFunc<Instr::Kind::EndReadStruct>(&Vm::_execEndReadStruct);
-    this->_initExecFunc<Instr::Kind::EndReadVarSIntSel>(&Vm::_execEndReadVarSIntSel);
-    this->_initExecFunc<Instr::Kind::EndReadVarUIntSel>(&Vm::_execEndReadVarUIntSel);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA16Be>(&Vm::_execReadFlBitArrayA16Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA16BeRev>(&Vm::_execReadFlBitArrayA16BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA16Le>(&Vm::_execReadFlBitArrayA16Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA16LeRev>(&Vm::_execReadFlBitArrayA16LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA32Be>(&Vm::_execReadFlBitArrayA32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA32BeRev>(&Vm::_execReadFlBitArrayA32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA32Le>(&Vm::_execReadFlBitArrayA32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA32LeRev>(&Vm::_execReadFlBitArrayA32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA64Be>(&Vm::_execReadFlBitArrayA64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA64BeRev>(&Vm::_execReadFlBitArrayA64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA64Le>(&Vm::_execReadFlBitArrayA64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA64LeRev>(&Vm::_execReadFlBitArrayA64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA8>(&Vm::_execReadFlBitArrayA8);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayA8Rev>(&Vm::_execReadFlBitArrayA8Rev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayBe>(&Vm::_execReadFlBitArrayBe);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayBeRev>(&Vm::_execReadFlBitArrayBeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayLe>(&Vm::_execReadFlBitArrayLe);
-    this->_initExecFunc<Instr::Kind::ReadFlBitArrayLeRev>(&Vm::_execReadFlBitArrayLeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA16Be>(&Vm::_execReadFlBitMapA16Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA16BeRev>(&Vm::_execReadFlBitMapA16BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA16Le>(&Vm::_execReadFlBitMapA16Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA16LeRev>(&Vm::_execReadFlBitMapA16LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA32Be>(&Vm::_execReadFlBitMapA32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA32BeRev>(&Vm::_execReadFlBitMapA32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA32Le>(&Vm::_execReadFlBitMapA32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA32LeRev>(&Vm::_execReadFlBitMapA32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA64Be>(&Vm::_execReadFlBitMapA64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA64BeRev>(&Vm::_execReadFlBitMapA64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA64Le>(&Vm::_execReadFlBitMapA64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA64LeRev>(&Vm::_execReadFlBitMapA64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA8>(&Vm::_execReadFlBitMapA8);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapA8Rev>(&Vm::_execReadFlBitMapA8Rev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapBe>(&Vm::_execReadFlBitMapBe);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapBeRev>(&Vm::_execReadFlBitMapBeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapLe>(&Vm::_execReadFlBitMapLe);
-    this->_initExecFunc<Instr::Kind::ReadFlBitMapLeRev>(&Vm::_execReadFlBitMapLeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA16Be>(&Vm::_execReadFlBoolA16Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA16BeRev>(&Vm::_execReadFlBoolA16BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA16Le>(&Vm::_execReadFlBoolA16Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA16LeRev>(&Vm::_execReadFlBoolA16LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA32Be>(&Vm::_execReadFlBoolA32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA32BeRev>(&Vm::_execReadFlBoolA32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA32Le>(&Vm::_execReadFlBoolA32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA32LeRev>(&Vm::_execReadFlBoolA32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA64Be>(&Vm::_execReadFlBoolA64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA64BeRev>(&Vm::_execReadFlBoolA64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA64Le>(&Vm::_execReadFlBoolA64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA64LeRev>(&Vm::_execReadFlBoolA64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA8>(&Vm::_execReadFlBoolA8);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolA8Rev>(&Vm::_execReadFlBoolA8Rev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolBe>(&Vm::_execReadFlBoolBe);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolBeRev>(&Vm::_execReadFlBoolBeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolLe>(&Vm::_execReadFlBoolLe);
-    this->_initExecFunc<Instr::Kind::ReadFlBoolLeRev>(&Vm::_execReadFlBoolLeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat32Be>(&Vm::_execReadFlFloat32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat32BeRev>(&Vm::_execReadFlFloat32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat32Le>(&Vm::_execReadFlFloat32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat32LeRev>(&Vm::_execReadFlFloat32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat64Be>(&Vm::_execReadFlFloat64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat64BeRev>(&Vm::_execReadFlFloat64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat64Le>(&Vm::_execReadFlFloat64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlFloat64LeRev>(&Vm::_execReadFlFloat64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA32Be>(&Vm::_execReadFlFloatA32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA32BeRev>(&Vm::_execReadFlFloatA32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA32Le>(&Vm::_execReadFlFloatA32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA32LeRev>(&Vm::_execReadFlFloatA32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA64Be>(&Vm::_execReadFlFloatA64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA64BeRev>(&Vm::_execReadFlFloatA64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA64Le>(&Vm::_execReadFlFloatA64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlFloatA64LeRev>(&Vm::_execReadFlFloatA64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA16Be>(&Vm::_execReadFlSIntA16Be);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA16BeRev>(&Vm::_execReadFlSIntA16BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA16Le>(&Vm::_execReadFlSIntA16Le);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA16LeRev>(&Vm::_execReadFlSIntA16LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA32Be>(&Vm::_execReadFlSIntA32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA32BeRev>(&Vm::_execReadFlSIntA32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA32Le>(&Vm::_execReadFlSIntA32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA32LeRev>(&Vm::_execReadFlSIntA32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA64Be>(&Vm::_execReadFlSIntA64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA64BeRev>(&Vm::_execReadFlSIntA64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA64Le>(&Vm::_execReadFlSIntA64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA64LeRev>(&Vm::_execReadFlSIntA64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA8>(&Vm::_execReadFlSIntA8);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntA8Rev>(&Vm::_execReadFlSIntA8Rev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntBe>(&Vm::_execReadFlSIntBe);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntBeRev>(&Vm::_execReadFlSIntBeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntLe>(&Vm::_execReadFlSIntLe);
-    this->_initExecFunc<Instr::Kind::ReadFlSIntLeRev>(&Vm::_execReadFlSIntLeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA16Be>(&Vm::_execReadFlUIntA16Be);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA16BeRev>(&Vm::_execReadFlUIntA16BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA16Le>(&Vm::_execReadFlUIntA16Le);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA16LeRev>(&Vm::_execReadFlUIntA16LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA32Be>(&Vm::_execReadFlUIntA32Be);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA32BeRev>(&Vm::_execReadFlUIntA32BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA32Le>(&Vm::_execReadFlUIntA32Le);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA32LeRev>(&Vm::_execReadFlUIntA32LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA64Be>(&Vm::_execReadFlUIntA64Be);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA64BeRev>(&Vm::_execReadFlUIntA64BeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA64Le>(&Vm::_execReadFlUIntA64Le);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA64LeRev>(&Vm::_execReadFlUIntA64LeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA8>(&Vm::_execReadFlUIntA8);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntA8Rev>(&Vm::_execReadFlUIntA8Rev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntBe>(&Vm::_execReadFlUIntBe);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntBeRev>(&Vm::_execReadFlUIntBeRev);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntLe>(&Vm::_execReadFlUIntLe);
-    this->_initExecFunc<Instr::Kind::ReadFlUIntLeRev>(&Vm::_execReadFlUIntLeRev);
-    this->_initExecFunc<Instr::Kind::ReadNtStrUtf16>(&Vm::_execReadNtStrUtf16);
-    this->_initExecFunc<Instr::Kind::ReadNtStrUtf32>(&Vm::_execReadNtStrUtf32);
-    this->_initExecFunc<Instr::Kind::ReadNtStrUtf8>(&Vm::_execReadNtStrUtf8);
-    this->_initExecFunc<Instr::Kind::ReadVlSInt>(&Vm::_execReadVlSInt);
-    this->_initExecFunc<Instr::Kind::ReadVlUInt>(&Vm::_execReadVlUInt);
-    this->_initExecFunc<Instr::Kind::SaveVal>(&Vm::_execSaveVal);
-    this->_initExecFunc<Instr::Kind::SetCurId>(&Vm::_execSetCurrentId);
-    this->_initExecFunc<Instr::Kind::SetDsId>(&Vm::_execSetDsId);
-    this->_initExecFunc<Instr::Kind::SetDsInfo>(&Vm::_execSetDsInfo);
-    this->_initExecFunc<Instr::Kind::SetDst>(&Vm::_execSetDst);
-    this->_initExecFunc<Instr::Kind::SetErInfo>(&Vm::_execSetErInfo);
-    this->_initExecFunc<Instr::Kind::SetErt>(&Vm::_execSetErt);
-    this->_initExecFunc<Instr::Kind::SetPktContentLen>(&Vm::_execSetPktContentLen);
-    this->_initExecFunc<Instr::Kind::SetPktDiscErCounterSnap>(&Vm::_execSetPktDiscErCounterSnap);
-    this->_initExecFunc<Instr::Kind::SetPktEndDefClkVal>(&Vm::_execSetPktEndDefClkVal);
-    this->_initExecFunc<Instr::Kind::SetPktInfo>(&Vm::_execSetPktInfo);
-    this->_initExecFunc<Instr::Kind::SetPktMagicNumber>(&Vm::_execSetPktMagicNumber);
-    this->_initExecFunc<Instr::Kind::SetPktSeqNum>(&Vm::_execSetPktSeqNum);
-    this->_initExecFunc<Instr::Kind::SetPktTotalLen>(&Vm::_execSetPktTotalLen);
-    this->_initExecFunc<Instr::Kind::UpdateDefClkVal>(&Vm::_execUpdateDefClkVal);
-    this->_initExecFunc<Instr::Kind::UpdateDefClkValFl>(&Vm::_execUpdateDefClkValFl);
+Vm::ExecFuncs Vm::_createExecFuncs() noexcept
+{
+    ExecFuncs execFuncs;
+
+
+    Vm::_initExecFunc<Instr::Kind::BeginReadDlArray>(execFuncs, &Vm::_execBeginReadDlArray);
+    Vm::_initExecFunc<Instr::Kind::BeginReadDlBlob>(execFuncs, &Vm::_execBeginReadDlBlob);
+    Vm::_initExecFunc<Instr::Kind::BeginReadDlStr>(execFuncs, &Vm::_execBeginReadDlStr);
+    Vm::_initExecFunc<Instr::Kind::BeginReadOptBoolSel>(execFuncs, &Vm::_execBeginReadOptBoolSel);
+    Vm::_initExecFunc<Instr::Kind::BeginReadOptSIntSel>(execFuncs, &Vm::_execBeginReadOptSIntSel);
+    Vm::_initExecFunc<Instr::Kind::BeginReadOptUIntSel>(execFuncs, &Vm::_execBeginReadOptUIntSel);
+    Vm::_initExecFunc<Instr::Kind::BeginReadScope>(execFuncs, &Vm::_execBeginReadScope);
+    Vm::_initExecFunc<Instr::Kind::BeginReadSlArray>(execFuncs, &Vm::_execBeginReadSlArray);
+    Vm::_initExecFunc<Instr::Kind::BeginReadSlBlob>(execFuncs, &Vm::_execBeginReadSlBlob);
+    Vm::_initExecFunc<Instr::Kind::BeginReadSlStr>(execFuncs, &Vm::_execBeginReadSlStr);
+    Vm::_initExecFunc<Instr::Kind::BeginReadSlUuidArray>(execFuncs, &Vm::_execBeginReadSlUuidArray);
+    Vm::_initExecFunc<Instr::Kind::BeginReadSlUuidBlob>(execFuncs, &Vm::_execBeginReadSlUuidBlob);
+    Vm::_initExecFunc<Instr::Kind::BeginReadStruct>(execFuncs, &Vm::_execBeginReadStruct);
+    Vm::_initExecFunc<Instr::Kind::BeginReadVarSIntSel>(execFuncs, &Vm::_execBeginReadVarSIntSel);
+    Vm::_initExecFunc<Instr::Kind::BeginReadVarUIntSel>(execFuncs, &Vm::_execBeginReadVarUIntSel);
+    Vm::_initExecFunc<Instr::Kind::EndDsErPreambleProc>(execFuncs, &Vm::_execEndDsErPreambleProc);
+    Vm::_initExecFunc<Instr::Kind::EndDsPktPreambleProc>(execFuncs, &Vm::_execEndDsPktPreambleProc);
+    Vm::_initExecFunc<Instr::Kind::EndErProc>(execFuncs, &Vm::_execEndErProc);
+    Vm::_initExecFunc<Instr::Kind::EndPktPreambleProc>(execFuncs, &Vm::_execEndPktPreambleProc);
+    Vm::_initExecFunc<Instr::Kind::EndReadDlArray>(execFuncs, &Vm::_execEndReadDlArray);
+    Vm::_initExecFunc<Instr::Kind::EndReadDlBlob>(execFuncs, &Vm::_execEndReadDlBlob);
+    Vm::_initExecFunc<Instr::Kind::EndReadDlStr>(execFuncs, &Vm::_execEndReadDlStr);
+    Vm::_initExecFunc<Instr::Kind::EndReadOptBoolSel>(execFuncs, &Vm::_execEndReadOptBoolSel);
+    Vm::_initExecFunc<Instr::Kind::EndReadOptSIntSel>(execFuncs, &Vm::_execEndReadOptSIntSel);
+    Vm::_initExecFunc<Instr::Kind::EndReadOptUIntSel>(execFuncs, &Vm::_execEndReadOptUIntSel);
+    Vm::_initExecFunc<Instr::Kind::EndReadScope>(execFuncs, &Vm::_execEndReadScope);
+    Vm::_initExecFunc<Instr::Kind::EndReadSlArray>(execFuncs, &Vm::_execEndReadSlArray);
+    Vm::_initExecFunc<Instr::Kind::EndReadSlBlob>(execFuncs, &Vm::_execEndReadSlBlob);
+    Vm::_initExecFunc<Instr::Kind::EndReadSlStr>(execFuncs, &Vm::_execEndReadSlStr);
+    Vm::_initExecFunc<Instr::Kind::EndReadStruct>(execFuncs, &Vm::_execEndReadStruct);
+    Vm::_initExecFunc<Instr::Kind::EndReadVarSIntSel>(execFuncs, &Vm::_execEndReadVarSIntSel);
+    Vm::_initExecFunc<Instr::Kind::EndReadVarUIntSel>(execFuncs, &Vm::_execEndReadVarUIntSel);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA16Be>(execFuncs, &Vm::_execReadFlBitArrayA16Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA16BeRev>(execFuncs, &Vm::_execReadFlBitArrayA16BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA16Le>(execFuncs, &Vm::_execReadFlBitArrayA16Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA16LeRev>(execFuncs, &Vm::_execReadFlBitArrayA16LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA32Be>(execFuncs, &Vm::_execReadFlBitArrayA32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA32BeRev>(execFuncs, &Vm::_execReadFlBitArrayA32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA32Le>(execFuncs, &Vm::_execReadFlBitArrayA32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA32LeRev>(execFuncs, &Vm::_execReadFlBitArrayA32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA64Be>(execFuncs, &Vm::_execReadFlBitArrayA64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA64BeRev>(execFuncs, &Vm::_execReadFlBitArrayA64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA64Le>(execFuncs, &Vm::_execReadFlBitArrayA64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA64LeRev>(execFuncs, &Vm::_execReadFlBitArrayA64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA8>(execFuncs, &Vm::_execReadFlBitArrayA8);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayA8Rev>(execFuncs, &Vm::_execReadFlBitArrayA8Rev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayBe>(execFuncs, &Vm::_execReadFlBitArrayBe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayBeRev>(execFuncs, &Vm::_execReadFlBitArrayBeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayLe>(execFuncs, &Vm::_execReadFlBitArrayLe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitArrayLeRev>(execFuncs, &Vm::_execReadFlBitArrayLeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA16Be>(execFuncs, &Vm::_execReadFlBitMapA16Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA16BeRev>(execFuncs, &Vm::_execReadFlBitMapA16BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA16Le>(execFuncs, &Vm::_execReadFlBitMapA16Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA16LeRev>(execFuncs, &Vm::_execReadFlBitMapA16LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA32Be>(execFuncs, &Vm::_execReadFlBitMapA32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA32BeRev>(execFuncs, &Vm::_execReadFlBitMapA32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA32Le>(execFuncs, &Vm::_execReadFlBitMapA32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA32LeRev>(execFuncs, &Vm::_execReadFlBitMapA32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA64Be>(execFuncs, &Vm::_execReadFlBitMapA64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA64BeRev>(execFuncs, &Vm::_execReadFlBitMapA64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA64Le>(execFuncs, &Vm::_execReadFlBitMapA64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA64LeRev>(execFuncs, &Vm::_execReadFlBitMapA64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA8>(execFuncs, &Vm::_execReadFlBitMapA8);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapA8Rev>(execFuncs, &Vm::_execReadFlBitMapA8Rev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapBe>(execFuncs, &Vm::_execReadFlBitMapBe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapBeRev>(execFuncs, &Vm::_execReadFlBitMapBeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapLe>(execFuncs, &Vm::_execReadFlBitMapLe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBitMapLeRev>(execFuncs, &Vm::_execReadFlBitMapLeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA16Be>(execFuncs, &Vm::_execReadFlBoolA16Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA16BeRev>(execFuncs, &Vm::_execReadFlBoolA16BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA16Le>(execFuncs, &Vm::_execReadFlBoolA16Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA16LeRev>(execFuncs, &Vm::_execReadFlBoolA16LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA32Be>(execFuncs, &Vm::_execReadFlBoolA32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA32BeRev>(execFuncs, &Vm::_execReadFlBoolA32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA32Le>(execFuncs, &Vm::_execReadFlBoolA32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA32LeRev>(execFuncs, &Vm::_execReadFlBoolA32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA64Be>(execFuncs, &Vm::_execReadFlBoolA64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA64BeRev>(execFuncs, &Vm::_execReadFlBoolA64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA64Le>(execFuncs, &Vm::_execReadFlBoolA64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA64LeRev>(execFuncs, &Vm::_execReadFlBoolA64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA8>(execFuncs, &Vm::_execReadFlBoolA8);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolA8Rev>(execFuncs, &Vm::_execReadFlBoolA8Rev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolBe>(execFuncs, &Vm::_execReadFlBoolBe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolBeRev>(execFuncs, &Vm::_execReadFlBoolBeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolLe>(execFuncs, &Vm::_execReadFlBoolLe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlBoolLeRev>(execFuncs, &Vm::_execReadFlBoolLeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat32Be>(execFuncs, &Vm::_execReadFlFloat32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat32BeRev>(execFuncs, &Vm::_execReadFlFloat32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat32Le>(execFuncs, &Vm::_execReadFlFloat32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat32LeRev>(execFuncs, &Vm::_execReadFlFloat32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat64Be>(execFuncs, &Vm::_execReadFlFloat64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat64BeRev>(execFuncs, &Vm::_execReadFlFloat64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat64Le>(execFuncs, &Vm::_execReadFlFloat64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloat64LeRev>(execFuncs, &Vm::_execReadFlFloat64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA32Be>(execFuncs, &Vm::_execReadFlFloatA32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA32BeRev>(execFuncs, &Vm::_execReadFlFloatA32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA32Le>(execFuncs, &Vm::_execReadFlFloatA32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA32LeRev>(execFuncs, &Vm::_execReadFlFloatA32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA64Be>(execFuncs, &Vm::_execReadFlFloatA64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA64BeRev>(execFuncs, &Vm::_execReadFlFloatA64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA64Le>(execFuncs, &Vm::_execReadFlFloatA64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlFloatA64LeRev>(execFuncs, &Vm::_execReadFlFloatA64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA16Be>(execFuncs, &Vm::_execReadFlSIntA16Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA16BeRev>(execFuncs, &Vm::_execReadFlSIntA16BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA16Le>(execFuncs, &Vm::_execReadFlSIntA16Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA16LeRev>(execFuncs, &Vm::_execReadFlSIntA16LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA32Be>(execFuncs, &Vm::_execReadFlSIntA32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA32BeRev>(execFuncs, &Vm::_execReadFlSIntA32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA32Le>(execFuncs, &Vm::_execReadFlSIntA32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA32LeRev>(execFuncs, &Vm::_execReadFlSIntA32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA64Be>(execFuncs, &Vm::_execReadFlSIntA64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA64BeRev>(execFuncs, &Vm::_execReadFlSIntA64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA64Le>(execFuncs, &Vm::_execReadFlSIntA64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA64LeRev>(execFuncs, &Vm::_execReadFlSIntA64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA8>(execFuncs, &Vm::_execReadFlSIntA8);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntA8Rev>(execFuncs, &Vm::_execReadFlSIntA8Rev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntBe>(execFuncs, &Vm::_execReadFlSIntBe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntBeRev>(execFuncs, &Vm::_execReadFlSIntBeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntLe>(execFuncs, &Vm::_execReadFlSIntLe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlSIntLeRev>(execFuncs, &Vm::_execReadFlSIntLeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA16Be>(execFuncs, &Vm::_execReadFlUIntA16Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA16BeRev>(execFuncs, &Vm::_execReadFlUIntA16BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA16Le>(execFuncs, &Vm::_execReadFlUIntA16Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA16LeRev>(execFuncs, &Vm::_execReadFlUIntA16LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA32Be>(execFuncs, &Vm::_execReadFlUIntA32Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA32BeRev>(execFuncs, &Vm::_execReadFlUIntA32BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA32Le>(execFuncs, &Vm::_execReadFlUIntA32Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA32LeRev>(execFuncs, &Vm::_execReadFlUIntA32LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA64Be>(execFuncs, &Vm::_execReadFlUIntA64Be);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA64BeRev>(execFuncs, &Vm::_execReadFlUIntA64BeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA64Le>(execFuncs, &Vm::_execReadFlUIntA64Le);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA64LeRev>(execFuncs, &Vm::_execReadFlUIntA64LeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA8>(execFuncs, &Vm::_execReadFlUIntA8);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntA8Rev>(execFuncs, &Vm::_execReadFlUIntA8Rev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntBe>(execFuncs, &Vm::_execReadFlUIntBe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntBeRev>(execFuncs, &Vm::_execReadFlUIntBeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntLe>(execFuncs, &Vm::_execReadFlUIntLe);
+    Vm::_initExecFunc<Instr::Kind::ReadFlUIntLeRev>(execFuncs, &Vm::_execReadFlUIntLeRev);
+    Vm::_initExecFunc<Instr::Kind::ReadNtStrUtf16>(execFuncs, &Vm::_execReadNtStrUtf16);
+    Vm::_initExecFunc<Instr::Kind::ReadNtStrUtf32>(execFuncs, &Vm::_execReadNtStrUtf32);
+    Vm::_initExecFunc<Instr::Kind::ReadNtStrUtf8>(execFuncs, &Vm::_execReadNtStrUtf8);
+    Vm::_initExecFunc<Instr::Kind::ReadVlSInt>(execFuncs, &Vm::_execReadVlSInt);
+    Vm::_initExecFunc<Instr::Kind::ReadVlUInt>(execFuncs, &Vm::_execReadVlUInt);
+    Vm::_initExecFunc<Instr::Kind::SaveFieldVal>(execFuncs, &Vm::_execSaveFieldVal);
+    Vm::_initExecFunc<Instr::Kind::SaveVal>(execFuncs, &Vm::_execSaveVal);
+    Vm::_initExecFunc<Instr::Kind::SetCurId>(execFuncs, &Vm::_execSetCurrentId);
+    Vm::_initExecFunc<Instr::Kind::SetDsId>(execFuncs, &Vm::_execSetDsId);
+    Vm::_initExecFunc<Instr::Kind::SetDsInfo>(execFuncs, &Vm::_execSetDsInfo);
+    Vm::_initExecFunc<Instr::Kind::SetDst>(execFuncs, &Vm::_execSetDst);
+    Vm::_initExecFunc<Instr::Kind::SetErInfo>(execFuncs, &Vm::_execSetErInfo);
+    Vm::_initExecFunc<Instr::Kind::SetErt>(execFuncs, &Vm::_execSetErt);
+    Vm::_initExecFunc<Instr::Kind::SetPktContentLen>(execFuncs, &Vm::_execSetPktContentLen);
+    Vm::_initExecFunc<Instr::Kind::SetPktDiscErCounterSnap>(execFuncs, &Vm::_execSetPktDiscErCounterSnap);
+    Vm::_initExecFunc<Instr::Kind::SetPktEndDefClkVal>(execFuncs, &Vm::_execSetPktEndDefClkVal);
+    Vm::_initExecFunc<Instr::Kind::SetPktInfo>(execFuncs, &Vm::_execSetPktInfo);
+    Vm::_initExecFunc<Instr::Kind::SetPktMagicNumber>(execFuncs, &Vm::_execSetPktMagicNumber);
+    Vm::_initExecFunc<Instr::Kind::SetPktSeqNum>(execFuncs, &Vm::_execSetPktSeqNum);
+    Vm::_initExecFunc<Instr::Kind::SetPktTotalLen>(execFuncs, &Vm::_execSetPktTotalLen);
+    Vm::_initExecFunc<Instr::Kind::UpdateDefClkVal>(execFuncs, &Vm::_execUpdateDefClkVal);
+    Vm::_initExecFunc<Instr::Kind::UpdateDefClkValFl>(execFuncs, &Vm::_execUpdateDefClkValFl);
+    return execFuncs;
 }
 
 void Vm::seekPkt(const Index offsetBytes)
@@ -369,7 +389,9 @@ bool Vm::_newDataBlock(const Index offsetInElemSeqBytes, const Size sizeBytes)
 {
     assert(sizeBytes <= 9);
 
-    const auto dataBlock = _dataSrc->data(offsetInElemSeqBytes, sizeBytes);
+    _dataSrc->lastVmToken = _dataSrcToken;
+
+    const auto dataBlock = _dataSrc->dataSrc->data(offsetInElemSeqBytes, sizeBytes);
 
     if (!dataBlock) {
         // no data
@@ -382,6 +404,102 @@ bool Vm::_newDataBlock(const Index offsetInElemSeqBytes, const Size sizeBytes)
     return true;
 }
 
+Vm::_tHaveBitsResult Vm::_newDataBlockNoThrow(const Index offsetInElemSeqBytes,
+                                               const Size sizeBytes)
+{
+    assert(sizeBytes <= 9);
+
+    bool isAvailable;
+
+    _dataSrc->lastVmToken = _dataSrcToken;
+
+    const auto dataBlock = _dataSrc->dataSrc->tryData(offsetInElemSeqBytes, sizeBytes, isAvailable);
+
+    if (!isAvailable) {
+        return _tHaveBitsResult::NotAvailable;
+    }
+
+    if (!dataBlock) {
+        // no data
+        return _tHaveBitsResult::No;
+    }
+
+    _bufAddr = static_cast<const std::uint8_t *>(dataBlock->address());
+    _bufLenBits = dataBlock->size() * 8;
+    _bufOffsetInCurPktBits = offsetInElemSeqBytes * 8 - _pos.curPktOffsetInElemSeqBits;
+    return _tHaveBitsResult::Yes;
+}
+
+bool Vm::_tryPrepareState()
+{
+    switch (_pos.state()) {
+    case VmState::BeginPkt:
+        if (this->_remBitsInBuf() == 0) {
+            // same check as _stateBeginPkt()
+            return this->_tryHaveBitsNoThrow(1) != _tHaveBitsResult::NotAvailable;
+        }
+
+        return true;
+
+    case VmState::BeginEr:
+        if (_pos.curExpectedPktContentLenBits == sizeUnset) {
+            if (this->_remBitsInBuf() == 0) {
+                // same check as _stateBeginEr()
+                switch (this->_tryHaveBitsNoThrow(1)) {
+                case _tHaveBitsResult::NotAvailable:
+                    return false;
+
+                case _tHaveBitsResult::No:
+                    // end of packet
+                    return true;
+
+                default:
+                    break;
+                }
+            }
+        } else if (_pos.remContentBitsInPkt() == 0) {
+            // end of packet content
+            return true;
+        }
+
+        return this->_tryPrepareAlignedContentBits(_pos.curDsPktProc->erAlign(), 0);
+
+    case VmState::ReadUuidByte:
+        if (_pos.stackTop().rem == 0) {
+            return true;
+        }
+
+        return this->_tryPrepareInstr(**_pos.stackTop().it);
+
+    case VmState::ReadRawData:
+    case VmState::ReadUuidBlobSection:
+        if (_pos.stackTop().rem == 0) {
+            return true;
+        }
+
+        return this->_tryPrepareContentBits(8);
+
+    case VmState::ContinueReadVlUInt:
+    case VmState::ContinueReadVlSInt:
+    case VmState::ReadUtf8DataUntilNull:
+    case VmState::ReadUtf16DataUntilNull:
+    case VmState::ReadUtf32DataUntilNull:
+        return this->_tryPrepareContentBits(8);
+
+    case VmState::ContinueSkipPaddingBits:
+    case VmState::ContinueSkipContentPaddingBits:
+        return this->_tryPrepareSkipPaddingBits();
+
+    default:
+        /*
+         * Either the state doesn't read data, or it executes
+         * instructions, in which case _stateExecInstr() and
+         * _stateExecArrayInstr() prepare each instruction.
+         */
+        return true;
+    }
+}
+
 void Vm::savePos(ElementSequenceIteratorPosition& pos) const
 {
     if (!pos) {
@@ -415,6 +533,140 @@ void Vm::restorePos(const ElementSequenceIteratorPosition& pos)
     this->_resetBuffer();
 }
 
+void Vm::saveCheckpoint(ElementSequenceIteratorCheckpoint& checkpoint) const
+{
+    assert(_it->_curElem);
+
+    ItCheckpointContents contents;
+
+    contents.pktOffsetBytes = _pos.curPktOffsetInElemSeqBits / 8;
+    contents.mark = _it->_mark;
+
+    if (_it->_curElem == &_pos.elems.pktEnd) {
+        /*
+         * The VM already moved to the next packet (see
+         * _stateEndPkt()), of which the offset is the offset of the
+         * packet end element.
+         */
+        contents.isPktEnd = true;
+    } else {
+        contents.elemOffsetInPktBits = _it->_offset - _pos.curPktOffsetInElemSeqBits;
+
+        if (_pos.lastErBeginning.headOffsetInCurPktBits != sizeUnset) {
+            ItCheckpointContents::ErBeginning erBeginning;
+            const auto optFromVal = [](const std::uint64_t val) -> boost::optional<std::uint64_t> {
+                // `sizeUnset` and `savedValUnset` are the same value
+                if (val == savedValUnset) {
+                    return boost::none;
+                }
+
+                return val;
+            };
+
+            assert(_pos.curDsPktProc);
+            erBeginning.dstId = _pos.curDsPktProc->dst().id();
+            erBeginning.headOffsetInPktBits = _pos.lastErBeginning.headOffsetInCurPktBits;
+            erBeginning.mark = _pos.lastErBeginning.mark;
+            erBeginning.expectedPktTotalLenBits = optFromVal(_pos.curExpectedPktTotalLenBits);
+            erBeginning.expectedPktContentLenBits = optFromVal(_pos.curExpectedPktContentLenBits);
+            erBeginning.defClkVal = _pos.lastErBeginning.defClkVal;
+            erBeginning.lastFlBitArrayBo = _pos.lastErBeginning.lastFlBitArrayBo;
+
+            /*
+             * Values which the current event record saves are saved
+             * again while decoding it: trailing unset values don't
+             * need to be part of the checkpoint.
+             */
+            auto savedValsCount = _pos.savedVals.size();
+
+            while (savedValsCount > 0 && _pos.savedVals[savedValsCount - 1] == savedValUnset) {
+                --savedValsCount;
+            }
+
+            erBeginning.savedVals.reserve(savedValsCount);
+
+            for (auto i = 0U; i < savedValsCount; ++i) {
+                erBeginning.savedVals.push_back(optFromVal(_pos.savedVals[i]));
+            }
+
+            contents.erBeginning = std::move(erBeginning);
+        }
+    }
+
+    itCheckpointToData(contents, checkpoint._data);
+    checkpoint._offset = _it->_offset;
+    checkpoint._mark = _it->_mark;
+}
+
+void Vm::restoreCheckpoint(const ElementSequenceIteratorCheckpoint& checkpoint)
+{
+    assert(checkpoint);
+
+    const auto contents = itCheckpointFromData(checkpoint._data);
+
+    _pos.curPktOffsetInElemSeqBits = contents.pktOffsetBytes * 8;
+    _pos.resetForNewPkt();
+
+    if (contents.isPktEnd) {
+        /*
+         * Same state as after _stateEndPkt(): the next element is the
+         * beginning of the next packet.
+         */
+        this->_resetBuffer();
+        _it->_mark = contents.mark - 1;
+        this->_updateItForUser(_pos.elems.pktEnd, _pos.curPktOffsetInElemSeqBits);
+        return;
+    }
+
+    _it->_mark = 0;
+
+    if (contents.erBeginning) {
+        const auto& erBeginning = *contents.erBeginning;
+        const auto dsPktProc = (*_pos.pktProc)[erBeginning.dstId];
+
+        if (!dsPktProc) {
+            throw InvalidElementSequenceIteratorCheckpoint {"No data stream type with this ID."};
+        }
+
+        // same state as when the VM began the event record
+        _pos.headOffsetInCurPktBits = erBeginning.headOffsetInPktBits;
+        _pos.curDsPktProc = dsPktProc;
+        _pos.curExpectedPktTotalLenBits = erBeginning.expectedPktTotalLenBits.value_or(sizeUnset);
+        _pos.curExpectedPktContentLenBits = erBeginning.expectedPktContentLenBits.value_or(sizeUnset);
+        _pos.defClkVal = erBeginning.defClkVal;
+        _pos.lastFlBitArrayBo = erBeginning.lastFlBitArrayBo;
+
+        if (_pos.savedVals.size() < erBeginning.savedVals.size()) {
+            _pos.savedVals.resize(erBeginning.savedVals.size(), savedValUnset);
+        }
+
+        for (auto i = 0U; i < erBeginning.savedVals.size(); ++i) {
+            _pos.savedVals[i] = erBeginning.savedVals[i].value_or(savedValUnset);
+        }
+
+        _pos.state(VmState::BeginEr);
+        _it->_mark = erBeginning.mark;
+    }
+
+    this->_resetBuffer();
+
+    // decode again up to the element of the checkpoint
+    while (_it->_mark < contents.mark) {
+        this->nextElem();
+
+        if (_it->_offset == ElementSequenceIterator::_endOffset ||
+                _it->_curElem == &_pos.elems.pktEnd) {
+            throw InvalidElementSequenceIteratorCheckpoint {
+                "Packet doesn't contain the element of the checkpoint."
+            };
+        }
+    }
+
+    if (_it->_offset != checkpoint._offset) {
+        throw InvalidElementSequenceIteratorCheckpoint {"Unexpected element offset."};
+    }
+}
+
 Vm::_tExecReaction Vm::_execReadFlBitArrayLe(const Instr& instr)
 {
     this->_execReadFlBitArray<readFlUIntLeFuncs, false>(instr);
@@ -1308,6 +1560,12 @@ Vm::_tExecReaction Vm::_execEndReadOptSIntSel(const Instr& instr)
     return _tExecReaction::Stop;
 }
 
+Vm::_tExecReaction Vm::_execSaveFieldVal(const Instr& instr)
+{
+    _pos.saveFieldVal(static_cast<const SaveFieldValInstr&>(instr).pos());
+    return _tExecReaction::ExecNextInstr;
+}
+
 Vm::_tExecReaction Vm::_execSaveVal(const Instr& instr)
 {
     _pos.saveVal(static_cast<const SaveValInstr&>(instr).pos());
@@ -1362,6 +1620,26 @@ Vm::_tExecReaction Vm::_execSetErt(const Instr& instr)
     assert(_pos.curDsPktProc);
 
     if (const auto erProc = (*_pos.curDsPktProc)[id]) {
+        if (!erProc->isBuilt()) {
+            // first dispatch of this event record type
+            PktProcBuilder::buildLazyErProc(*_pos.pktProc, *erProc);
+        }
+
+        /*
+         * Placeholder event record procedures and the ones which an
+         * incremental metadata text parser adds to an existing packet
+         * procedure may use new saved value positions and need a
+         * deeper stack.
+         *
+         * This only allocates on the first dispatch of such an event
+         * record type.
+         */
+        if (_pos.savedVals.size() < erProc->savedValsCount()) {
+            _pos.savedVals.resize(erProc->savedValsCount(), savedValUnset);
+        }
+
+        _pos.stack.reserve(erProc->maxStackDepth());
+
         _pos.curErProc = erProc;
         _pos.elems.erInfo._ert = &erProc->ert();
         return _tExecReaction::ExecNextInstr;
@@ -1526,6 +1804,13 @@ Vm::_tExecReaction Vm::_execEndDsErPreambleProc(const Instr&)
     _pos.stackPop();
     assert(_pos.stack.empty());
     assert(_pos.curErProc);
+
+    if (_erRow && this->_tryReadErRowFast()) {
+        // whole event record procedure done
+        _pos.state(VmState::EndEr);
+        return _tExecReaction::ChangeState;
+    }
+
     _pos.loadNewProc(_pos.curErProc->proc());
     return _tExecReaction::ExecCurInstr;
 }
@@ -1539,5 +1824,175 @@ Vm::_tExecReaction Vm::_execEndErProc(const Instr&)
     return _tExecReaction::ChangeState;
 }
 
+void Vm::_writeErRowField(std::uint8_t * const row, const EventRecordRowLayout::Field& field,
+                          const std::uint64_t val) noexcept
+{
+    const auto fieldAddr = row + field._offset;
+
+    switch (field._size) {
+    case 1:
+    {
+        const auto fieldVal = static_cast<std::uint8_t>(val);
+
+        std::memcpy(fieldAddr, &fieldVal, sizeof fieldVal);
+        break;
+    }
+
+    case 2:
+    {
+        const auto fieldVal = static_cast<std::uint16_t>(val);
+
+        std::memcpy(fieldAddr, &fieldVal, sizeof fieldVal);
+        break;
+    }
+
+    case 4:
+    {
+        const auto fieldVal = static_cast<std::uint32_t>(val);
+
+        std::memcpy(fieldAddr, &fieldVal, sizeof fieldVal);
+        break;
+    }
+
+    default:
+        assert(field._size == 8);
+        std::memcpy(fieldAddr, &val, sizeof val);
+        break;
+    }
+}
+
+/*
+ * Reads all the fields of the row layout of the current event record
+ * procedure to `_erRow` from the current buffer, without executing
+ * the procedure.
+ *
+ * Returns `false`, without changing anything, if it's not possible
+ * (bit fields, data beyond the current buffer or packet).
+ */
+bool Vm::_tryReadErRowFast()
+{
+    const auto layout = _pos.curErProc->rowLayout();
+
+    if (!layout || !layout->_fieldsAreByteAligned ||
+            layout->_maxDsLenBits > this->_remBitsInBuf() ||
+            layout->_maxDsLenBits > _pos.remContentBitsInPkt()) {
+        return false;
+    }
+
+    auto headOffsetBits = _pos.headOffsetInCurPktBits;
+
+    for (auto& field : layout->_fields) {
+        auto& type = *field._type;
+        const auto len = type.length();
+
+        headOffsetBits = (headOffsetBits + field._dsAlign - 1) & -static_cast<Size>(field._dsAlign);
+
+        const auto buf = &_bufAddr[(headOffsetBits - _bufOffsetInCurPktBits) / 8];
+        const auto index = (len - 1) * 8;
+        auto val = type.byteOrder() == ByteOrder::Big ? readFlUIntBeFuncs[index](buf) :
+                   readFlUIntLeFuncs[index](buf);
+
+        if ((type.byteOrder() == ByteOrder::Big) == (type.bitOrder() == BitOrder::FirstToLast)) {
+            val = revFlIntBits(val, len);
+        }
+
+        if (type.isFixedLengthBooleanType()) {
+            val = val != 0;
+        } else if (type.isFixedLengthSignedIntegerType() && len < 64 && ((val >> (len - 1)) & 1)) {
+            // sign-extend
+            val |= ~UINT64_C(0) << len;
+        }
+
+        Vm::_writeErRowField(_erRow, field, val);
+        headOffsetBits += len;
+    }
+
+    headOffsetBits = (headOffsetBits + layout->_endDsAlign - 1) & -static_cast<Size>(layout->_endDsAlign);
+    this->_consumeExistingBits(headOffsetBits - _pos.headOffsetInCurPktBits);
+
+    if (!layout->_fields.empty()) {
+        _pos.lastFlBitArrayBo = layout->_fields.back()._type->byteOrder();
+    }
+
+    _erRow = nullptr;
+    return true;
+}
+
+void Vm::readErRow(std::uint8_t * const row)
+{
+    assert(_pos.curErProc);
+    assert(_pos.curErProc->rowLayout());
+
+    auto& fields = _pos.curErProc->rowLayout()->_fields;
+    auto fieldIt = fields.begin();
+
+    /*
+     * _execEndDsErPreambleProc() reads the whole row at once if it can.
+     *
+     * Otherwise, fill `row` from the elements of the event record
+     * procedure.
+     */
+    _erRow = row;
+
+    try {
+        while (true) {
+            this->nextElem();
+
+            auto& elem = *_it->_curElem;
+
+            if (elem.isEventRecordEndElement()) {
+                break;
+            }
+
+            if (fieldIt == fields.end()) {
+                continue;
+            }
+
+            switch (elem.kind()) {
+            case Element::Kind::FixedLengthBitArray:
+            case Element::Kind::FixedLengthBitMap:
+            case Element::Kind::FixedLengthBoolean:
+            case Element::Kind::FixedLengthSignedInteger:
+            case Element::Kind::FixedLengthUnsignedInteger:
+            case Element::Kind::FixedLengthFloatingPointNumber:
+                break;
+
+            default:
+                continue;
+            }
+
+            auto& flBitArrayElem = static_cast<const FixedLengthBitArrayElement&>(elem);
+
+            if (&flBitArrayElem.dataType() != fieldIt->_type) {
+                // not a field of the row (second event record context)
+                continue;
+            }
+
+            if (elem.isFixedLengthFloatingPointNumberElement()) {
+                const auto val = elem.asFixedLengthFloatingPointNumberElement().value();
+
+                if (fieldIt->_size == sizeof(float)) {
+                    const auto fieldVal = static_cast<float>(val);
+
+                    std::memcpy(row + fieldIt->_offset, &fieldVal, sizeof fieldVal);
+                } else {
+                    std::memcpy(row + fieldIt->_offset, &val, sizeof val);
+                }
+            } else if (elem.isFixedLengthBooleanElement()) {
+                Vm::_writeErRowField(row, *fieldIt, elem.asFixedLengthBooleanElement().value());
+            } else {
+                Vm::_writeErRowField(row, *fieldIt, flBitArrayElem.unsignedIntegerValue());
+            }
+
+            ++fieldIt;
+        }
+    } catch (...) {
+        _erRow = nullptr;
+        throw;
+    }
+
+    _erRow = nullptr;
+}
+
 } // namespace yactfr
 } // namespace internal
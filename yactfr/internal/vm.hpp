@@ -17,18 +17,24 @@
 #include <type_traits>
 #include <cstdint>
 #include <array>
+#include <memory>
+#include <chrono>
 
 #include <yactfr/aliases.hpp>
 #include <yactfr/elem.hpp>
 #include <yactfr/data-src-factory.hpp>
 #include <yactfr/elem.hpp>
 #include <yactfr/elem-seq-it.hpp>
+#include <yactfr/elem-seq-it-checkpoint.hpp>
+#include <yactfr/elem-seq-metrics.hpp>
 #include <yactfr/decoding-errors.hpp>
 
 #include "proc.hpp"
+#include "profile.hpp"
 #include "std-fl-int-reader.hpp"
 #include "fl-int-rev.hpp"
 #include "utils.hpp"
+#include "inline-vec.hpp"
 
 namespace yactfr {
 namespace internal {
@@ -60,9 +66,15 @@ enum class VmState {
     ContinueSkipContentPaddingBits,
 };
 
+static_assert(static_cast<Size>(VmState::ContinueSkipContentPaddingBits) + 1 == profVmStateCount,
+              "`profVmStateCount` is the number of VM states");
+
 // VM stack frame
 struct VmStackFrame final
 {
+    // for `InlineVec`
+    explicit VmStackFrame() = default;
+
     explicit VmStackFrame(const Proc * const proc, const VmState parentState) :
         proc {proc ? &proc->rawProc() : nullptr},
         parentState {parentState}
@@ -77,7 +89,7 @@ struct VmStackFrame final
      *
      * May be `nullptr`.
      */
-    const Proc::Raw *proc;
+    const Proc::Raw *proc = nullptr;
 
     /*
      * _Next_ instruction to execute (part of `*proc` above).
@@ -87,7 +99,7 @@ struct VmStackFrame final
     Proc::RawIt it;
 
     // state when this frame was created
-    VmState parentState;
+    VmState parentState = VmState::BeginPkt;
 
     /*
      * Either:
@@ -125,6 +137,11 @@ public:
 
     void stackPush(const Proc * const proc = nullptr)
     {
+        /*
+         * See PktProc::maxStackDepth() and ErProc::maxStackDepth():
+         * push_back() only allocates if this computation is wrong.
+         */
+        assert(stack.size() < stack.capacity());
         stack.push_back(VmStackFrame {proc, theState});
     }
 
@@ -134,7 +151,7 @@ public:
         return stack.back();
     }
 
-    void stackPop()
+    void stackPop() noexcept
     {
         assert(!stack.empty());
         stack.pop_back();
@@ -182,6 +199,12 @@ public:
         savedVals[pos] = lastIntVal.u;
     }
 
+    void saveFieldVal(const Index pos) noexcept
+    {
+        assert(pos < fieldVals.size());
+        fieldVals[pos] = lastIntVal.u;
+    }
+
     std::uint64_t savedVal(const Index pos) noexcept
     {
         assert(pos < savedVals.size());
@@ -248,7 +271,9 @@ public:
         curExpectedPktContentLenBits = sizeUnset;
         stack.clear();
         defClkVal = 0;
+        lastErBeginning.headOffsetInCurPktBits = sizeUnset;
         std::fill(savedVals.begin(), savedVals.end(), savedValUnset);
+        std::fill(fieldVals.begin(), fieldVals.end(), boost::none);
 
         /*
          * Reset all informative elements as a given element sequence
@@ -278,12 +303,95 @@ private:
     void _setFromOther(const VmPos& other);
 
 public:
+    /*
+     * Hot members: what the VM reads and writes for almost each
+     * instruction, packed at the beginning of the object so that
+     * decoding an element touches as few cache lines as possible.
+     */
+    // head offset within current packet (bits)
+    Index headOffsetInCurPktBits = 0;
+
     // offset of current packet beginning within its element sequence (bits)
     Index curPktOffsetInElemSeqBits = 0;
 
-    // head offset within current packet (bits)
-    Index headOffsetInCurPktBits = 0;
+    // last integer value
+    union {
+        std::uint64_t u;
+        std::int64_t i;
+    } lastIntVal;
 
+    // next state to handle
+    VmState theState = VmState::BeginPkt;
+
+    // next immediate state
+    VmState nextState;
+
+    // remaining padding bits to skip for alignment
+    Size remBitsToSkip = 0;
+
+    // current packet expected total length (bits)
+    Size curExpectedPktTotalLenBits;
+
+    // current packet content length (bits)
+    Size curExpectedPktContentLenBits;
+
+    // last fixed-length bit array byte order
+    boost::optional<ByteOrder> lastFlBitArrayBo;
+
+    // packet procedure
+    const PktProc *pktProc = nullptr;
+
+    // current data stream type packet procedure
+    const DsPktProc *curDsPktProc = nullptr;
+
+    // current event record type procedure
+    const ErProc *curErProc = nullptr;
+
+    // current ID (event record or data stream type)
+    TypeId curId;
+
+    // current variable-length integer length (bits)
+    Size curVlIntLenBits;
+
+    // current variable-length integer element
+    VariableLengthIntegerElement *curVlIntElem;
+
+    // default clock value, if any
+    std::uint64_t defClkVal = 0;
+
+    /*
+     * Stack.
+     *
+     * Its capacity is the maximum depth which the procedures of
+     * `*pktProc` need (see PktProc::maxStackDepth() and
+     * ErProc::maxStackDepth()) so that pushing a frame never
+     * allocates.
+     */
+    InlineVec<VmStackFrame, 16> stack;
+
+    /*
+     * Saved values.
+     *
+     * Its size is the number of saved values which the procedures of
+     * `*pktProc` need (see PktProc::savedValsCount() and
+     * ErProc::savedValsCount()).
+     */
+    InlineVec<std::uint64_t, 16> savedVals;
+
+    /*
+     * Field values, within the current packet.
+     *
+     * Its size is the number of field handles which `*pktProc` knows
+     * (see PktProc::fieldValsCount()), the index of a field handle
+     * being the position of its value.
+     */
+    InlineVec<boost::optional<std::uint64_t>, 8> fieldVals;
+
+    /*
+     * Cold members: current elements (the VM only writes the one it
+     * sets for the user), and what the VM only needs at specific
+     * moments.
+     */
     // current elements
     struct {
         PacketBeginningElement pktBeginning;
@@ -337,30 +445,6 @@ public:
         OptionalWithUnsignedIntegerSelectorEndElement optUIntSelEnd;
     } elems;
 
-    // next state to handle
-    VmState theState = VmState::BeginPkt;
-
-    // next immediate state
-    VmState nextState;
-
-    // last fixed-length bit array byte order
-    boost::optional<ByteOrder> lastFlBitArrayBo;
-
-    // remaining padding bits to skip for alignment
-    Size remBitsToSkip = 0;
-
-    // last integer value
-    union {
-        std::uint64_t u;
-        std::int64_t i;
-    } lastIntVal;
-
-    // current variable-length integer length (bits)
-    Size curVlIntLenBits;
-
-    // current variable-length integer element
-    VariableLengthIntegerElement *curVlIntElem;
-
     /*
      * Code unit buffer for null-terminated strings.
      *
@@ -394,35 +478,24 @@ public:
         Index index = 0;
     } ntStrCuBuf;
 
-    // current ID (event record or data stream type)
-    TypeId curId;
-
-    // packet procedure
-    const PktProc *pktProc = nullptr;
-
-    // current data stream type packet procedure
-    const DsPktProc *curDsPktProc = nullptr;
-
-    // current event record type procedure
-    const ErProc *curErProc = nullptr;
-
     // metadata stream UUID
     boost::uuids::uuid metadataStreamUuid;
 
-    // current packet expected total length (bits)
-    Size curExpectedPktTotalLenBits;
-
-    // current packet content length (bits)
-    Size curExpectedPktContentLenBits;
-
-    // stack
-    std::vector<VmStackFrame> stack;
-
-    // vector of saved values
-    std::vector<std::uint64_t> savedVals;
+    /*
+     * State at the beginning of the last event record of the current
+     * packet, from which restoring an element sequence iterator
+     * checkpoint decodes again.
+     *
+     * `headOffsetInCurPktBits` is `sizeUnset` if the VM didn't begin
+     * any event record within the current packet yet.
+     */
+    struct {
+        Index headOffsetInCurPktBits = sizeUnset;
+        Index mark = 0;
+        std::uint64_t defClkVal = 0;
+        boost::optional<ByteOrder> lastFlBitArrayBo;
+    } lastErBeginning;
 
-    // default clock value, if any
-    std::uint64_t defClkVal = 0;
 };
 
 class ItInfos final
@@ -474,27 +547,179 @@ public:
     const Element *elem = nullptr;
 };
 
+class Vm;
+
+/*
+ * Data source of one or more VMs.
+ *
+ * Copying a VM of which the data source is shareable (see
+ * ElementSequence::iteratorCopiesShareDataSource()) makes both VMs
+ * share the same data source instead of creating a new one.
+ *
+ * Each VM keeps its own current buffer (cursor within its current data
+ * block), but only the last data block which the data source returned
+ * is valid: `lastVmToken` is the token of the VM which requested it,
+ * that is, the only one of which the current buffer is valid.
+ *
+ * Each VM using a data source gets a unique token from `nextVmToken`
+ * (see Vm::_useDataSrc()): unlike the address of a VM, a token is
+ * never reused for another VM.
+ */
+struct VmDataSrc final
+{
+    explicit VmDataSrc(DataSource::Up dataSrc, const bool shareDataSrc) :
+        dataSrc {std::move(dataSrc)},
+        isShareable {shareDataSrc && this->dataSrc->isShareable()}
+    {
+    }
+
+    DataSource::Up dataSrc;
+    bool isShareable;
+    unsigned long long lastVmToken = 0;
+    unsigned long long nextVmToken = 1;
+};
+
 class Vm final
 {
 public:
-    explicit Vm(DataSourceFactory& dataSrcFactory, const PktProc& pktProc,
+    explicit Vm(DataSourceFactory& dataSrcFactory, bool shareDataSrc, const PktProc& pktProc,
                 ElementSequenceIterator& it);
     Vm(const Vm& vm, ElementSequenceIterator& it);
     void setFromOther(const Vm& vm, ElementSequenceIterator& it);
     void seekPkt(Index offset);
     void savePos(ElementSequenceIteratorPosition& pos) const;
     void restorePos(const ElementSequenceIteratorPosition& pos);
+    void saveCheckpoint(ElementSequenceIteratorCheckpoint& checkpoint) const;
+    void restoreCheckpoint(const ElementSequenceIteratorCheckpoint& checkpoint);
+
+    /*
+     * Reads the fields of the current event record, of which the
+     * procedure has a row layout, to `row` and advances to its end
+     * element.
+     *
+     * The current element must be the event record info element.
+     */
+    void readErRow(std::uint8_t *row);
 
     const VmPos& pos() const
     {
         return _pos;
     }
 
+    /*
+     * Value of the field of which the handle has the index `index`,
+     * if any.
+     */
+    boost::optional<std::uint64_t> fieldVal(const Index index) const noexcept
+    {
+        if (index >= _pos.fieldVals.size()) {
+            // field handle created after the packet procedure
+            return boost::none;
+        }
+
+        return _pos.fieldVals[index];
+    }
+
     void nextElem()
     {
-        while (!this->_handleState());
+#ifdef YACTFR_METRICS
+        if (_it->_metrics) {
+            _MetricsScope scope {*this};
+
+            this->_nextElem();
+            return;
+        }
+#endif
+
+        this->_nextElem();
+    }
+
+    /*
+     * Like nextElem(), but returns `false` instead of throwing
+     * `DataNotAvailable` when the data source doesn't have the data
+     * which the VM needs now.
+     *
+     * In that case, the iterator doesn't move (its current element
+     * remains valid) and the VM is at a state from which calling this
+     * method (or nextElem()) again continues exactly where it stopped.
+     *
+     * To achieve this without unwinding the instruction handlers, this
+     * method makes sure, _before_ handling a state or executing an
+     * instruction, that the data it needs first (padding bits and
+     * fixed-length data) is available. The only state changes before
+     * returning `false` are consumed padding bits and executed
+     * instructions which don't read data.
+     */
+    bool tryNextElem()
+    {
+#ifdef YACTFR_METRICS
+        if (_it->_metrics) {
+            _MetricsScope scope {*this};
+
+            return this->_tryNextElem();
+        }
+#endif
+
+        return this->_tryNextElem();
+    }
+
+    /*
+     * Decodes the rest of the element sequence, calling `sinkFunc`
+     * with `sink` and each element, until the end of the element
+     * sequence.
+     *
+     * Unlike calling nextElem() repeatedly, the instruction states
+     * don't return after each element: they call the sink and execute
+     * the next instruction.
+     */
+    void decode(const ElementSequenceIterator::_tSinkFunc sinkFunc, void * const sink)
+    {
+        _sinkFunc = sinkFunc;
+        _sink = sink;
+        this->_validateBuffer();
+
+        while (_it->_offset != ElementSequenceIterator::_endOffset) {
+            if (this->_handleState<false, true>() &&
+                    _it->_offset != ElementSequenceIterator::_endOffset) {
+                this->_pushElem();
+            }
+        }
+    }
+
+private:
+    void _pushElem()
+    {
+        _sinkFunc(_sink, *_it->_curElem);
+    }
+
+    void _nextElem()
+    {
+        this->_validateBuffer();
+
+        while (!this->_handleState<false>());
+    }
+
+    bool _tryNextElem()
+    {
+        this->_validateBuffer();
+
+        while (true) {
+            if (!this->_tryPrepareState()) {
+                return false;
+            }
+
+            if (this->_handleState<true>()) {
+                if (_dataNotAvail) {
+                    _dataNotAvail = false;
+                    return false;
+                }
+
+                return true;
+            }
+        }
     }
 
+public:
     void updateItElemFromOtherPos(const VmPos& otherPos, const Element * const otherElem)
     {
         if (!otherElem) {
@@ -529,21 +754,64 @@ private:
         Stop,
     };
 
+    // result of _tryHaveBitsNoThrow()
+    enum class _tHaveBitsResult {
+        // enough bits in the buffer
+        Yes,
+
+        // no more data
+        No,
+
+        // data is not available now
+        NotAvailable,
+    };
+
+private:
+    using ExecFunc = _tExecReaction (Vm::*)(const Instr&);
+    using ExecFuncs = std::array<ExecFunc, wise_enum::size<Instr::Kind>>;
+
 private:
     template <Instr::Kind InstrKindV>
-    void _initExecFunc(_tExecReaction (Vm::*)(const Instr&)) noexcept;
+    static void _initExecFunc(ExecFuncs& execFuncs, ExecFunc execFunc) noexcept;
 
-    void _initExecFuncs() noexcept;
+    static ExecFuncs _createExecFuncs() noexcept;
     bool _newDataBlock(Index offsetInElemSeqBytes, Size sizeBytes);
+    _tHaveBitsResult _newDataBlockNoThrow(Index offsetInElemSeqBytes, Size sizeBytes);
+    bool _tryPrepareState();
 
+    /*
+     * With `PushV`, the VM is decoding with decode(): the instruction
+     * states call the sink for each element they provide instead of
+     * returning.
+     */
+    template <bool TryV, bool PushV = false>
     bool _handleState()
+    {
+#ifdef YACTFR_PROFILE
+        auto& prof = _pos.pktProc->stateProf(static_cast<Index>(_pos.state()));
+
+        if (prof.hit()) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto ret = this->_handleStateNoProf<TryV, PushV>();
+
+            prof.addSample(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start));
+            return ret;
+        }
+#endif
+
+        return this->_handleStateNoProf<TryV, PushV>();
+    }
+
+    template <bool TryV, bool PushV>
+    bool _handleStateNoProf()
     {
         switch (_pos.state()) {
         case VmState::ExecInstr:
-            return this->_stateExecInstr();
+            return this->_stateExecInstr<TryV, PushV>();
 
         case VmState::ExecArrayInstr:
-            return this->_stateExecArrayInstr();
+            return this->_stateExecArrayInstr<TryV, PushV>();
 
         case VmState::BeginEr:
             return this->_stateBeginEr();
@@ -604,15 +872,39 @@ private:
         }
     }
 
+    template <bool TryV, bool PushV>
     bool _stateExecInstr()
     {
         while (true) {
+            if (TryV && !this->_tryPrepareInstr(_pos.nextInstr())) {
+                _dataNotAvail = true;
+                return true;
+            }
+
             switch (this->_exec(_pos.nextInstr())) {
             case _tExecReaction::FetchNextInstrAndStop:
                 _pos.gotoNextInstr();
+
+                if (PushV) {
+                    this->_pushElem();
+
+                    if (_pos.state() != VmState::ExecInstr) {
+                        // the handler changed the state
+                        return false;
+                    }
+
+                    break;
+                }
+
                 return true;
 
             case _tExecReaction::Stop:
+                if (PushV) {
+                    // the handler may have changed the state
+                    this->_pushElem();
+                    return false;
+                }
+
                 return true;
 
             case _tExecReaction::ExecNextInstr:
@@ -634,6 +926,7 @@ private:
         return true;
     }
 
+    template <bool TryV, bool PushV>
     bool _stateExecArrayInstr()
     {
         if (_pos.stackTop().rem == 0) {
@@ -657,12 +950,35 @@ private:
                 continue;
             }
 
+            if (TryV && !this->_tryPrepareInstr(_pos.nextInstr())) {
+                _dataNotAvail = true;
+                return true;
+            }
+
             switch (this->_exec(_pos.nextInstr())) {
             case _tExecReaction::FetchNextInstrAndStop:
                 _pos.gotoNextInstr();
+
+                if (PushV) {
+                    this->_pushElem();
+
+                    if (_pos.state() != VmState::ExecArrayInstr) {
+                        // the handler changed the state
+                        return false;
+                    }
+
+                    break;
+                }
+
                 return true;
 
             case _tExecReaction::Stop:
+                if (PushV) {
+                    // the handler may have changed the state
+                    this->_pushElem();
+                    return false;
+                }
+
                 return true;
 
             case _tExecReaction::ExecNextInstr:
@@ -754,6 +1070,9 @@ private:
     {
         const auto offset = _pos.headOffsetInElemSeqBits();
 
+        // current offset within packet is the packet length
+        this->_metricsCountPkt(_pos.headOffsetInCurPktBits / 8);
+
         // adjust buffer address and offsets
         _pos.curPktOffsetInElemSeqBits = _pos.headOffsetInElemSeqBits();
         _pos.headOffsetInCurPktBits = 0;
@@ -771,6 +1090,13 @@ private:
             _bufLenBits -= (_bufAddr - oldBufAddr) * 8;
         }
 
+        /*
+         * We won't need the data of this packet anymore, but other VMs
+         * sharing the data source could.
+         */
+        if (_dataSrc.use_count() == 1) {
+            _dataSrc->dataSrc->releaseDataBefore(_pos.curPktOffsetInElemSeqBits / 8);
+        }
         this->_updateItForUser(_pos.elems.pktEnd, offset);
         _pos.state(VmState::BeginPkt);
         return true;
@@ -780,6 +1106,12 @@ private:
     {
         assert(_pos.curDsPktProc);
 
+        // checkpoint resume point
+        _pos.lastErBeginning.headOffsetInCurPktBits = _pos.headOffsetInCurPktBits;
+        _pos.lastErBeginning.mark = _it->_mark;
+        _pos.lastErBeginning.defClkVal = _pos.defClkVal;
+        _pos.lastErBeginning.lastFlBitArrayBo = _pos.lastFlBitArrayBo;
+
         if (_pos.curExpectedPktContentLenBits == sizeUnset) {
             if (this->_remBitsInBuf() == 0) {
                 /*
@@ -804,6 +1136,7 @@ private:
          */
         this->_alignHead(_pos.curDsPktProc->erAlign());
 
+        this->_metricsBeginEr();
         this->_updateItForUser(_pos.elems.erBeginning);
         _pos.loadNewProc(_pos.curDsPktProc->erPreambleProc());
         _pos.state(VmState::ExecInstr);
@@ -813,6 +1146,7 @@ private:
     bool _stateEndEr()
     {
         assert(_pos.curErProc);
+        this->_metricsCountEr(_pos.curErProc->ert());
         _pos.curErProc = nullptr;
         this->_updateItForUser(_pos.elems.erEnd);
         _pos.state(VmState::BeginEr);
@@ -1110,6 +1444,17 @@ private:
 
     _tExecReaction _exec(const Instr& instr)
     {
+#ifdef YACTFR_PROFILE
+        if (instr.prof().hit()) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto reaction = (this->*_execFuncs[static_cast<Index>(instr.kind())])(instr);
+
+            instr.prof().addSample(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start));
+            return reaction;
+        }
+#endif
+
         return (this->*_execFuncs[static_cast<Index>(instr.kind())])(instr);
     }
 
@@ -1118,6 +1463,62 @@ private:
         _it->_curElem = &elem;
         _it->_offset = offset;
         ++_it->_mark;
+        this->_metricsCountElem(elem);
+    }
+
+    /*
+     * Decoding metrics hooks: they do nothing without the
+     * `YACTFR_METRICS` definition.
+     */
+    void _metricsCountElem(const Element& elem) noexcept
+    {
+#ifdef YACTFR_METRICS
+        if (_it->_metrics) {
+            _it->_metrics->_countElem(elem.kind());
+        }
+#else
+        static_cast<void>(elem);
+#endif
+    }
+
+    void _metricsCountPkt(const Size byteCount) noexcept
+    {
+#ifdef YACTFR_METRICS
+        if (_it->_metrics) {
+            _it->_metrics->_countPkt(byteCount);
+        }
+#else
+        static_cast<void>(byteCount);
+#endif
+    }
+
+    void _metricsBeginEr() noexcept
+    {
+#ifdef YACTFR_METRICS
+        _metricsInEr = true;
+#endif
+    }
+
+    void _metricsCountEr(const EventRecordType& ert) noexcept
+    {
+#ifdef YACTFR_METRICS
+        _metricsInEr = false;
+
+        if (!_it->_metrics) {
+            return;
+        }
+
+        _it->_metrics->_countEr(ert);
+
+        if (this->_metricsIsErSampled()) {
+            // _metricsAddCallDur() adds the duration
+            _metricsSampledErt = &ert;
+        }
+
+        ++_metricsErCount;
+#else
+        static_cast<void>(ert);
+#endif
     }
 
     void _updateItForUser(const Element& elem) noexcept
@@ -1189,6 +1590,27 @@ private:
         _pos.state(_pos.nextState);
     }
 
+    /*
+     * Aligns the current head to its current byte and returns the
+     * offset, from the beginning of the element sequence, to request
+     * in bytes at this point.
+     */
+    Index _requestOffsetInElemSeqBytes() const noexcept
+    {
+        const auto flooredHeadOffsetInCurPacketBits = _pos.headOffsetInCurPktBits & ~7ULL;
+        const auto flooredHeadOffsetInCurPacketBytes = flooredHeadOffsetInCurPacketBits / 8;
+
+        return _pos.curPktOffsetInElemSeqBits / 8 + flooredHeadOffsetInCurPacketBytes;
+    }
+
+    // size, in bytes, to request to have `bits` bits from the head
+    Size _requestSizeBytes(const Size bits) const noexcept
+    {
+        const auto bitInByte = _pos.headOffsetInCurPktBits & 7;
+
+        return (bits + 7 + bitInByte) / 8;
+    }
+
     bool _tryHaveBits(const Size bits)
     {
         assert(bits <= 64);
@@ -1198,19 +1620,132 @@ private:
             return true;
         }
 
-        /*
-         * Align the current head to its current byte and compute the
-         * offset, from the beginning of the element sequence, to
-         * request in bytes at this point.
-         */
-        const auto flooredHeadOffsetInCurPacketBits = _pos.headOffsetInCurPktBits & ~7ULL;
-        const auto flooredHeadOffsetInCurPacketBytes = flooredHeadOffsetInCurPacketBits / 8;
-        const auto requestOffsetInElemSeqBytes = _pos.curPktOffsetInElemSeqBits / 8 +
-                                                 flooredHeadOffsetInCurPacketBytes;
-        const auto bitInByte = _pos.headOffsetInCurPktBits & 7;
-        const auto sizeBytes = (bits + 7 + bitInByte) / 8;
+        return this->_newDataBlock(this->_requestOffsetInElemSeqBytes(),
+                                   this->_requestSizeBytes(bits));
+    }
+
+    _tHaveBitsResult _tryHaveBitsNoThrow(const Size bits)
+    {
+        assert(bits <= 64);
 
-        return this->_newDataBlock(requestOffsetInElemSeqBytes, sizeBytes);
+        if (bits <= this->_remBitsInBuf()) {
+            // we still have enough
+            return _tHaveBitsResult::Yes;
+        }
+
+        return this->_newDataBlockNoThrow(this->_requestOffsetInElemSeqBytes(),
+                                          this->_requestSizeBytes(bits));
+    }
+
+    /*
+     * Makes sure that `bits` content bits are available from the head,
+     * returning `false` if the data isn't available now.
+     *
+     * Returns `true` when the corresponding handler is about to fail
+     * anyway (going past the packet content or no more data) so that
+     * it throws the appropriate decoding error.
+     */
+    bool _tryPrepareContentBits(const Size bits)
+    {
+        if (bits > _pos.remContentBitsInPkt()) {
+            return true;
+        }
+
+        return this->_tryHaveBitsNoThrow(bits) != _tHaveBitsResult::NotAvailable;
+    }
+
+    /*
+     * Skips `_pos.remBitsToSkip` padding bits as long as data is
+     * available, returning `false` if the data isn't available now.
+     *
+     * On success, `_pos.remBitsToSkip` is zero.
+     */
+    bool _tryPrepareSkipPaddingBits()
+    {
+        while (_pos.remBitsToSkip > 0) {
+            if (this->_remBitsInBuf() == 0) {
+                switch (this->_tryHaveBitsNoThrow(1)) {
+                case _tHaveBitsResult::NotAvailable:
+                    return false;
+
+                case _tHaveBitsResult::No:
+                    // let the state handler throw
+                    return true;
+
+                default:
+                    break;
+                }
+            }
+
+            const auto bitsToSkip = std::min(_pos.remBitsToSkip, this->_remBitsInBuf());
+
+            _pos.remBitsToSkip -= bitsToSkip;
+            this->_consumeExistingBits(bitsToSkip);
+        }
+
+        return true;
+    }
+
+    /*
+     * Aligns the head to `align` bits, and then makes sure that `bits`
+     * content bits are available from the aligned head, returning
+     * `false` if the data isn't available now.
+     *
+     * Aligning the head ahead of the instruction handler is safe:
+     * aligning an aligned head is a no-op.
+     */
+    bool _tryPrepareAlignedContentBits(const Size align, const Size bits)
+    {
+        const auto newHeadOffsetBits = (_pos.headOffsetInCurPktBits + align - 1) & -align;
+        const auto paddingBits = newHeadOffsetBits - _pos.headOffsetInCurPktBits;
+
+        if (paddingBits > _pos.remContentBitsInPkt()) {
+            // let the instruction handler throw
+            return true;
+        }
+
+        if (paddingBits > 0) {
+            /*
+             * This is the same as what _alignHead() does, without
+             * changing the state.
+             */
+            _pos.remBitsToSkip = paddingBits;
+
+            if (!this->_tryPrepareSkipPaddingBits()) {
+                return false;
+            }
+
+            if (_pos.headOffsetInCurPktBits != newHeadOffsetBits) {
+                // no more data: let the instruction handler throw
+                _pos.remBitsToSkip = 0;
+                return true;
+            }
+        }
+
+        return this->_tryPrepareContentBits(bits);
+    }
+
+    /*
+     * Makes sure that the data which `instr` needs first is available,
+     * returning `false` if it isn't available now.
+     */
+    bool _tryPrepareInstr(const Instr& instr)
+    {
+        if (instr.isReadFlBitArray()) {
+            auto& readFlBitArrayInstr = static_cast<const ReadFlBitArrayInstr&>(instr);
+
+            return this->_tryPrepareAlignedContentBits(readFlBitArrayInstr.align(),
+                                                       readFlBitArrayInstr.len());
+        } else if (instr.kind() == Instr::Kind::BeginReadScope) {
+            return this->_tryPrepareAlignedContentBits(static_cast<const BeginReadScopeInstr&>(instr).align(),
+                                                       0);
+        } else if (instr.isBeginReadData()) {
+            return this->_tryPrepareAlignedContentBits(static_cast<const ReadDataInstr&>(instr).align(),
+                                                       0);
+        }
+
+        // doesn't read data
+        return true;
     }
 
     void _requireBits(const Size bits)
@@ -1258,6 +1793,24 @@ private:
         _bufOffsetInCurPktBits = _pos.headOffsetInCurPktBits;
     }
 
+    /*
+     * Resets the current buffer if another VM sharing the data source
+     * requested a data block since this VM requested its own.
+     */
+    void _useDataSrc(std::shared_ptr<VmDataSrc> dataSrc) noexcept
+    {
+        _dataSrc = std::move(dataSrc);
+        _dataSrcToken = _dataSrc->nextVmToken;
+        ++_dataSrc->nextVmToken;
+    }
+
+    void _validateBuffer() noexcept
+    {
+        if (_dataSrc->lastVmToken != _dataSrcToken) {
+            this->_resetBuffer();
+        }
+    }
+
     // instruction handlers
     _tExecReaction _execBeginReadDlArray(const Instr& instr);
     _tExecReaction _execBeginReadDlBlob(const Instr& instr);
@@ -1277,6 +1830,9 @@ private:
     _tExecReaction _execEndDsErPreambleProc(const Instr& instr);
     _tExecReaction _execEndDsPktPreambleProc(const Instr& instr);
     _tExecReaction _execEndErProc(const Instr& instr);
+    bool _tryReadErRowFast();
+    static void _writeErRowField(std::uint8_t *row, const EventRecordRowLayout::Field& field,
+                                 std::uint64_t val) noexcept;
     _tExecReaction _execEndPktPreambleProc(const Instr& instr);
     _tExecReaction _execEndReadDlArray(const Instr& instr);
     _tExecReaction _execEndReadDlBlob(const Instr& instr);
@@ -1402,6 +1958,7 @@ private:
     _tExecReaction _execReadNtStrUtf8(const Instr& instr);
     _tExecReaction _execReadVlSInt(const Instr& instr);
     _tExecReaction _execReadVlUInt(const Instr& instr);
+    _tExecReaction _execSaveFieldVal(const Instr& instr);
     _tExecReaction _execSaveVal(const Instr& instr);
     _tExecReaction _execSetCurrentId(const Instr& instr);
     _tExecReaction _execSetDsId(const Instr& instr);
@@ -1775,11 +2332,15 @@ private:
     }
 
 private:
-    using ExecFunc = _tExecReaction (Vm::*)(const Instr&);
+    // array of instruction handler functions, shared by all the VMs
+    static const ExecFuncs _execFuncs;
 
 private:
     DataSourceFactory *_dataSrcFactory;
-    DataSource::Up _dataSrc;
+    std::shared_ptr<VmDataSrc> _dataSrc;
+
+    // token of this VM within `*_dataSrc`
+    unsigned long long _dataSrcToken;
 
     // current buffer
     const std::uint8_t *_bufAddr = nullptr;
@@ -1793,17 +2354,128 @@ private:
     // owning element sequence iterator
     ElementSequenceIterator *_it;
 
-    // array of instruction handler functions
-    std::array<ExecFunc, wise_enum::size<Instr::Kind>> _execFuncs;
-
     // position (whole state of the VM)
     VmPos _pos;
+
+    /*
+     * Row which readErRow() fills, if any: _execEndDsErPreambleProc()
+     * tries to read all its fields at once.
+     */
+    std::uint8_t *_erRow = nullptr;
+
+    /*
+     * Set when _handleState<true>() stops because data is not
+     * available now.
+     */
+    bool _dataNotAvail = false;
+
+    // sink function and sink which decode() calls
+    ElementSequenceIterator::_tSinkFunc _sinkFunc = nullptr;
+    void *_sink = nullptr;
+#ifdef YACTFR_METRICS
+    /*
+     * Measures the duration of a nextElem() or tryNextElem() call when
+     * it's sampled, updating the decoding metrics of the owning
+     * iterator.
+     *
+     * A call is sampled when it's the `samplingPeriod()`th call: its
+     * duration goes to the call duration histogram.
+     *
+     * A call is also timed, without being sampled, when the VM samples
+     * the current (or next) event record: then _metricsErDur
+     * accumulates the durations of all the calls from the one
+     * providing the beginning element of the event record to the one
+     * providing its end element.
+     */
+    class _MetricsScope final
+    {
+    public:
+        explicit _MetricsScope(Vm& vm) noexcept :
+            _vm {&vm},
+            _wasInEr {vm._metricsInEr},
+            _isSampled {vm._metricsIsCallSampled()},
+            _isTimed {_isSampled || vm._metricsIsErSampled()}
+        {
+            if (_isTimed) {
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~_MetricsScope()
+        {
+            if (_isTimed) {
+                _vm->_metricsAddCallDur(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _start), _wasInEr, _isSampled);
+            }
+        }
+
+    private:
+        Vm *_vm;
+        bool _wasInEr;
+        bool _isSampled;
+        bool _isTimed;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    bool _metricsIsCallSampled() noexcept
+    {
+        ++_metricsIncrCount;
+        return _metricsIncrCount % _it->_metrics->samplingPeriod() == 0;
+    }
+
+    /*
+     * Whether or not the VM samples the current (or next) event
+     * record, that is, the `samplingPeriod()`th one.
+     */
+    bool _metricsIsErSampled() const noexcept
+    {
+        return (_metricsErCount + 1) % _it->_metrics->samplingPeriod() == 0;
+    }
+
+    void _metricsAddCallDur(const std::chrono::nanoseconds dur, const bool wasInEr,
+                            const bool isSampled) noexcept
+    {
+        auto& metrics = *_it->_metrics;
+
+        if (isSampled) {
+            metrics._addIncrDur(dur);
+        }
+
+        if (wasInEr || _metricsInEr || _metricsSampledErt) {
+            _metricsErDur += dur;
+        }
+
+        if (_metricsSampledErt) {
+            metrics._addSampledErDur(*_metricsSampledErt, _metricsErDur);
+            _metricsSampledErt = nullptr;
+            _metricsErDur = std::chrono::nanoseconds::zero();
+        } else if (!_metricsInEr) {
+            // not within an event record: don't count packet elements
+            _metricsErDur = std::chrono::nanoseconds::zero();
+        }
+    }
+
+    // number of measured nextElem()/tryNextElem() calls
+    unsigned long long _metricsIncrCount = 0;
+
+    // number of event records which this VM decoded
+    unsigned long long _metricsErCount = 0;
+
+    // whether or not the VM is between event record elements
+    bool _metricsInEr = false;
+
+    // sampled event record type which just ended, if any
+    const EventRecordType *_metricsSampledErt = nullptr;
+
+    // decoding duration of the sampled event record so far
+    std::chrono::nanoseconds _metricsErDur {0};
+#endif
 };
 
 template <Instr::Kind InstrKindV>
-void Vm::_initExecFunc(const ExecFunc execFunc) noexcept
+void Vm::_initExecFunc(ExecFuncs& execFuncs, const ExecFunc execFunc) noexcept
 {
-    _execFuncs[static_cast<unsigned int>(InstrKindV)] = execFunc;
+    execFuncs[static_cast<unsigned int>(InstrKindV)] = execFunc;
 }
 
 } // namespace internal
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <sstream>
+#include <cassert>
 
 #include <yactfr/metadata/data-loc.hpp>
 #include <yactfr/metadata/dt.hpp>
@@ -49,13 +50,22 @@ DataStreamType::DataStreamType(const TypeId id, EventRecordTypeSet&& erts,
     // TODO: Add validation.
 }
 
-void DataStreamType::_buildErtMap()
+void DataStreamType::_buildErtMap() const
 {
     for (auto& ertUp : _erts) {
         _idsToErts[ertUp->id()] = ertUp.get();
     }
 }
 
+void DataStreamType::_addErts(std::vector<EventRecordType::Up>&& erts) const
+{
+    for (auto& ertUp : erts) {
+        assert(_idsToErts.find(ertUp->id()) == _idsToErts.end());
+        _idsToErts[ertUp->id()] = ertUp.get();
+        _erts.insert(std::move(ertUp));
+    }
+}
+
 const EventRecordType *DataStreamType::operator[](const TypeId id) const
 {
     const auto it = _idsToErts.find(id);
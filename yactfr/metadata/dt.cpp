@@ -26,20 +26,23 @@
 #include <yactfr/metadata/dl-blob-type.hpp>
 #include <yactfr/metadata/var-type.hpp>
 #include <yactfr/metadata/opt-type.hpp>
+#include <yactfr/internal/metadata/dt-content.hpp>
 
 namespace yactfr {
 
 DataType::DataType(const _tKind kind, const unsigned int align, MapItem::Up attrs) :
     _theKind {kind},
     _align {align},
-    _attrs {std::move(attrs)}
+    _attrs {internal::internAttrs(std::move(attrs))}
 {
 }
 
 bool DataType::operator==(const DataType& other) const noexcept
 {
+    // equal attributes are most likely the same interned ones
     return _theKind == other._theKind && _align == other._align &&
-           _attrs == other._attrs && this->_isEqual(other);
+           (_attrs == other._attrs || (_attrs && other._attrs && *_attrs == *other._attrs)) &&
+           this->_isEqual(other);
 }
 
 bool DataType::operator!=(const DataType& other) const noexcept
@@ -14,15 +14,16 @@
 namespace yactfr {
 
 template <typename ParserT>
-FromMetadataTextReturn fromMetadataText(const char * const begin, const char * const end)
+FromMetadataTextReturn fromMetadataText(const char * const begin, const char * const end,
+                                        const Size threadCount)
 {
-    ParserT parser {begin, end};
+    ParserT parser {begin, end, threadCount};
 
     return std::make_pair(parser.releaseTraceType(), parser.metadataStreamUuid());
 }
 
-FromMetadataTextReturn fromMetadataText(const char * const begin,
-                                                            const char * const end)
+FromMetadataTextReturn fromMetadataText(const char * const begin, const char * const end,
+                                        const Size threadCount)
 {
     if (begin == end) {
         internal::throwTextParseError("Empty metadata text.", TextLocation {});
@@ -30,11 +31,16 @@ FromMetadataTextReturn fromMetadataText(const char * const begin,
 
     if (*begin == 30) {
         // starts with the RS byte: expect CTF 2
-        return fromMetadataText<internal::Ctf2JsonSeqParser>(begin, end);
+        return fromMetadataText<internal::Ctf2JsonSeqParser>(begin, end, threadCount);
     } else {
         // fall back to CTF 1.8
-        return fromMetadataText<internal::TsdlParser>(begin, end);
+        return fromMetadataText<internal::TsdlParser>(begin, end, threadCount);
     }
 }
 
+FromMetadataTextReturn fromMetadataText(const char * const begin, const char * const end)
+{
+    return fromMetadataText(begin, end, 1);
+}
+
 } // namespace yactfr
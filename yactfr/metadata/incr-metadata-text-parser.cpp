@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cassert>
+
+#include <yactfr/metadata/incr-metadata-text-parser.hpp>
+#include <yactfr/text-parse-error.hpp>
+
+#include "../internal/metadata/tsdl/tsdl-parser.hpp"
+#include "../internal/metadata/json/ctf-2-json-seq-parser.hpp"
+#include "../internal/metadata/trace-type-impl.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class IncrMetadataTextParserImpl final
+{
+public:
+    explicit IncrMetadataTextParserImpl(const char * const begin, const char * const end)
+    {
+        if (begin == end) {
+            throwTextParseError("Empty metadata text.", TextLocation {});
+        }
+
+        if (*begin == 30) {
+            // starts with the RS byte: expect CTF 2
+            _ctf2JsonSeqParser = std::make_unique<Ctf2JsonSeqParser>(begin, end);
+            _traceType = _ctf2JsonSeqParser->releaseTraceType();
+            _metadataStreamUuid = _ctf2JsonSeqParser->metadataStreamUuid();
+        } else {
+            // fall back to CTF 1.8
+            _tsdlParser = std::make_unique<TsdlParser>(begin, end);
+            _traceType = _tsdlParser->releaseTraceType();
+            _metadataStreamUuid = _tsdlParser->metadataStreamUuid();
+        }
+    }
+
+    const TraceType& traceType() const noexcept
+    {
+        return *_traceType;
+    }
+
+    const boost::optional<boost::uuids::uuid>& metadataStreamUuid() const noexcept
+    {
+        return _metadataStreamUuid;
+    }
+
+    Size appendMetadataText(const char * const begin, const char * const end)
+    {
+        auto newErts = _tsdlParser ?
+                       _tsdlParser->parseAppendedMetadata(begin, end, *_traceType) :
+                       _ctf2JsonSeqParser->parseAppendedMetadata(begin, end, *_traceType);
+        auto& traceTypeImpl = TraceTypeImpl::of(*_traceType);
+        Size count = 0;
+
+        for (auto& dstIdErtsPair : newErts) {
+            count += dstIdErtsPair.second.size();
+            traceTypeImpl.addErts(dstIdErtsPair.first, std::move(dstIdErtsPair.second));
+        }
+
+        return count;
+    }
+
+private:
+    // exactly one of those is set
+    std::unique_ptr<TsdlParser> _tsdlParser;
+    std::unique_ptr<Ctf2JsonSeqParser> _ctf2JsonSeqParser;
+
+    TraceType::Up _traceType;
+    boost::optional<boost::uuids::uuid> _metadataStreamUuid;
+};
+
+} // namespace internal
+
+IncrementalMetadataTextParser::IncrementalMetadataTextParser(const char * const begin,
+                                                             const char * const end) :
+    _pimpl {std::make_unique<internal::IncrMetadataTextParserImpl>(begin, end)}
+{
+}
+
+IncrementalMetadataTextParser::IncrementalMetadataTextParser(const std::string& text) :
+    IncrementalMetadataTextParser {text.data(), text.data() + text.size()}
+{
+}
+
+IncrementalMetadataTextParser::~IncrementalMetadataTextParser()
+{
+}
+
+const TraceType& IncrementalMetadataTextParser::traceType() const noexcept
+{
+    return _pimpl->traceType();
+}
+
+const boost::optional<boost::uuids::uuid>& IncrementalMetadataTextParser::metadataStreamUuid() const noexcept
+{
+    return _pimpl->metadataStreamUuid();
+}
+
+Size IncrementalMetadataTextParser::appendMetadataText(const char * const begin,
+                                                       const char * const end)
+{
+    return _pimpl->appendMetadataText(begin, end);
+}
+
+} // namespace yactfr
@@ -8,14 +8,17 @@
 #include <istream>
 #include <memory>
 #include <sstream>
-#include <vector>
 #include <cassert>
 #include <cstdint>
-#include <array>
+#include <cstring>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <boost/endian/conversion.hpp>
 #include <boost/uuid/nil_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
-#include <boost/optional.hpp>
 
 #include <yactfr/io-error.hpp>
 #include <yactfr/metadata/metadata-stream.hpp>
@@ -23,40 +26,48 @@
 #include <yactfr/metadata/packetized-metadata-stream.hpp>
 #include <yactfr/metadata/invalid-metadata-stream.hpp>
 
+#include "../internal/utils.hpp"
+
 namespace bendian = boost::endian;
 namespace buuids = boost::uuids;
 
 namespace yactfr {
 namespace internal {
 
+/*
+ * Decodes the metadata stream from `begin` to `end`, walking the packet
+ * headers in place.
+ *
+ * If the metadata stream is packetized, the decoder concatenates the
+ * packet contents. Otherwise, the whole range is the metadata text and
+ * the decoder doesn't copy it: see metadataStream().
+ */
 class MetadataStreamDecoder final
 {
 public:
-    explicit MetadataStreamDecoder(std::istream& stream);
-
-    bool isPacketized() const noexcept
-    {
-        return _isPacketized;
-    }
-
-    std::string& text() noexcept
-    {
-        return _text;
-    }
-
-    Size pktCount() const noexcept
-    {
-        return _pktCount;
-    }
-
-    int majorVersion() const noexcept
-    {
-        return _majorVersion;
-    }
+    explicit MetadataStreamDecoder(const std::uint8_t *begin, const std::uint8_t *end);
 
-    int minorVersion() const noexcept
+    /*
+     * Creates a metadata stream object from the decoded data.
+     *
+     * `plainText` returns the metadata text when the metadata stream
+     * isn't packetized.
+     */
+    template <typename PlainTextFuncT>
+    std::unique_ptr<const MetadataStream> metadataStream(PlainTextFuncT&& plainText)
     {
-        return _minorVersion;
+        if (_isPacketized) {
+            return std::unique_ptr<const PacketizedMetadataStream> {new PacketizedMetadataStream {
+                std::move(_text), _pktCount,
+                static_cast<unsigned int>(_majorVersion),
+                static_cast<unsigned int>(_minorVersion),
+                this->bo(), _uuid
+            }};
+        } else {
+            return std::unique_ptr<const PlainTextMetadataStream> {new PlainTextMetadataStream {
+                plainText()
+            }};
+        }
     }
 
     ByteOrder bo() const noexcept
@@ -70,11 +81,6 @@ public:
         std::abort();
     }
 
-    const buuids::uuid& uuid() const noexcept
-    {
-        return _uuid;
-    }
-
 private:
     struct _tPktHeader
     {
@@ -91,13 +97,22 @@ private:
     };
 
 private:
-    boost::optional<_tPktHeader> _readPktHeader(const bool readMagic);
-    void _readPacketized();
-    void _readText();
+    _tPktHeader _readPktHeader();
+    void _decodePacketized();
+
+    Index _curOffset() const noexcept
+    {
+        return static_cast<Index>(_cur - _begin);
+    }
+
+    Size _availSize() const noexcept
+    {
+        return static_cast<Size>(_end - _cur);
+    }
 
     void _throwInvalid(const std::string& msg) const
     {
-        this->_throwInvalid(_curOffset, msg);
+        this->_throwInvalid(this->_curOffset(), msg);
     }
 
     void _throwInvalid(const Index offset, const std::string& msg) const
@@ -113,50 +128,27 @@ private:
         std::ostringstream ss;
 
         ss << "metadata stream ends prematurely: expecting " << expectedSize <<
-              " more bytes at this point, got only " << _stream->gcount() << ".";
+              " more bytes at this point, got only " << this->_availSize() << ".";
         this->_throwInvalid(ss.str());
     }
 
-    bool _streamIsBad() const
-    {
-        return _stream->bad() || (_stream->fail() && !_stream->eof());
-    }
-
     /*
-     * Calls `_stream->read()` and updates the current offset on
-     * success. Also checks if `_stream->gcount()` is equal to `size`
-     * after reading, throwing `InvalidMetadataStream` if not.
+     * Throws `InvalidMetadataStream` if there's less than `size` bytes
+     * left to decode.
      */
-    void _expect(char * const s, const std::streamsize size)
+    void _expect(const Size size) const
     {
-        _stream->read(s, size);
-
-        if (this->_streamIsBad()) {
-            // checked by the caller
-            return;
-        }
-
-        if (_stream->gcount() != size) {
+        if (this->_availSize() < size) {
             this->_throwEndsPrematurely(size);
         }
-
-        _curOffset += _stream->gcount();
     }
 
     /*
-     * Reads `sizeof item` bytes into `item`.
+     * Decodes `sizeof item` bytes into `item`, considering the byte
+     * order of the metadata stream, throwing `InvalidMetadataStream`
+     * if there's not enough bytes left.
      *
-     * Only throws if the stream is in a bad state (which excludes
-     * anything related to EOF).
-     *
-     * Returns whether or not the method could read `sizeof item` bytes.
-     */
-    template <typename T>
-    bool _readItem(T& item);
-
-    /*
-     * Like _readItem(), but throws `InvalidMetadataStream` if it can't
-     * read `sizeof item` bytes.
+     * Don't assume the alignment of the item.
      */
     template <typename T>
     void _expectItem(T& item);
@@ -169,16 +161,9 @@ private:
     static constexpr auto _minorVersion = 8;
 
 private:
-    std::istream *_stream;
-    std::ios_base::iostate _origStreamMask;
-
-    /*
-     * We keep a current offset for exception messages because
-     * `_stream->tellg()` is not guaranteed to return a valid offset,
-     * for example if it's `std::cin`.
-     */
-    Index _curOffset = 0;
-
+    const std::uint8_t *_begin;
+    const std::uint8_t *_end;
+    const std::uint8_t *_cur;
     bool _isPacketized = false;
     std::string _text;
     Size _pktCount = 0;
@@ -186,88 +171,49 @@ private:
     bendian::order _bo = bendian::order::native;
 };
 
-MetadataStreamDecoder::MetadataStreamDecoder(std::istream& stream) :
-    _stream {&stream},
+MetadataStreamDecoder::MetadataStreamDecoder(const std::uint8_t * const begin,
+                                             const std::uint8_t * const end) :
+    _begin {begin},
+    _end {end},
+    _cur {begin},
     _uuid {buuids::nil_generator {}()}
 {
-    // fail now if the stream is already in a failing state
-    if (stream.fail() || stream.bad()) {
-        throw IOError {"Input stream is in a bad state before decoding."};
-    }
-
     /*
-     * We don't want any I/O exceptions during the decoding process (we
-     * check the error flags explicitly), so temporarily set the
-     * exception mask of the input stream to nothing. Save the current
-     * value to restore it after the decoding process.
+     * The first four bytes of the stream indicate if the metadata is
+     * packetized or not.
+     *
+     * It's okay to require four bytes at this point: the size of a
+     * valid metadata stream, plain text or packetized, cannot be under
+     * four bytes.
      */
-    _origStreamMask = stream.exceptions();
-    stream.exceptions(std::ios_base::goodbit);
+    std::uint32_t magic;
 
-    try {
-        /*
-         * Let's read the first four bytes of the stream first.
-         *
-         * This indicates if the metadata is packetized or not. If it's
-         * not, we append those four bytes as the first four characters
-         * of the metadata text and read the whole stream directly.
-         *
-         * Otherwise, we decode each packet, except for the magic number
-         * of the first packet which is already decoded.
-         *
-         * It's okay to require four bytes at this point: the size of a
-         * valid metadata stream, plain text or packetized, cannot be
-         * under four bytes.
-         */
-        std::array<char, sizeof(std::uint32_t)> magicBuf;
-
-        this->_expect(magicBuf.data(), magicBuf.size());
-
-        const auto magic = reinterpret_cast<const std::uint32_t *>(magicBuf.data());
-
-        if (*magic == _pktMagic) {
-            _bo = bendian::order::native;
-            _isPacketized = true;
-        } else if (bendian::endian_reverse(*magic) == _pktMagic) {
-            if (bendian::order::native == bendian::order::big) {
-                _bo = bendian::order::little;
-            } else {
-                _bo = bendian::order::big;
-            }
+    this->_expect(sizeof magic);
+    std::memcpy(&magic, _cur, sizeof magic);
 
-            _isPacketized = true;
-        }
-
-        if (_isPacketized) {
-            this->_readPacketized();
+    if (magic == _pktMagic) {
+        _bo = bendian::order::native;
+        _isPacketized = true;
+    } else if (bendian::endian_reverse(magic) == _pktMagic) {
+        if (bendian::order::native == bendian::order::big) {
+            _bo = bendian::order::little;
         } else {
-            // start with those four bytes
-            _text.assign(magicBuf.begin(), magicBuf.end());
-            this->_readText();
+            _bo = bendian::order::big;
         }
-    } catch (...) {
-        stream.exceptions(_origStreamMask);
-        throw;
+
+        _isPacketized = true;
     }
 
-    // TODO: should probably use some RAII to avoid repeating this
-    stream.exceptions(_origStreamMask);
+    if (_isPacketized) {
+        this->_decodePacketized();
+    }
 }
 
 template <typename T>
-bool MetadataStreamDecoder::_readItem(T& item)
+void MetadataStreamDecoder::_expectItem(T& item)
 {
-    assert(_stream->good());
-    _stream->read(reinterpret_cast<char *>(&item), sizeof item);
-
-    if (this->_streamIsBad()) {
-        throw IOError {"Cannot read metadata stream."};
-    }
-
-    if (_stream->gcount() != sizeof item) {
-        assert(_stream->eof());
-        return false;
-    }
+    this->_expect(sizeof item);
+    std::memcpy(&item, _cur, sizeof item);
 
     if (_bo == bendian::order::little) {
         item = bendian::little_to_native(item);
@@ -275,46 +221,17 @@ bool MetadataStreamDecoder::_readItem(T& item)
         item = bendian::big_to_native(item);
     }
 
-    _curOffset += sizeof item;
-    return true;
+    _cur += sizeof item;
 }
 
-template <typename T>
-void MetadataStreamDecoder::_expectItem(T& item)
-{
-    if (!this->_readItem(item)) {
-        this->_throwEndsPrematurely(sizeof item);
-    }
-}
-
-boost::optional<MetadataStreamDecoder::_tPktHeader> MetadataStreamDecoder::_readPktHeader(const bool readMagic)
+MetadataStreamDecoder::_tPktHeader MetadataStreamDecoder::_readPktHeader()
 {
     _tPktHeader header;
 
-    /*
-     * Do not assume the alignment of `_tPktHeader` fields. Any of the
-     * reading operations below may throw `IOError` or
-     * `InvalidMetadataStream`: this must be catched by the caller.
-     */
-    if (readMagic) {
-        if (!this->_readItem(header.magic)) {
-            if (_stream->gcount() == 0) {
-                // end of stream
-                return boost::none;
-            } else {
-                this->_throwEndsPrematurely(sizeof header.magic);
-            }
-        }
-    } else {
-        header.magic = _pktMagic;
-    }
-
-    this->_expect(reinterpret_cast<char *>(&header.uuid[0]), sizeof header.uuid);
-
-    if (this->_streamIsBad()) {
-        throw IOError {"Cannot read metadata stream."};
-    }
-
+    this->_expectItem(header.magic);
+    this->_expect(sizeof header.uuid);
+    std::memcpy(&header.uuid[0], _cur, sizeof header.uuid);
+    _cur += sizeof header.uuid;
     this->_expectItem(header.checksum);
     this->_expectItem(header.contentSize);
     this->_expectItem(header.totalSize);
@@ -326,105 +243,92 @@ boost::optional<MetadataStreamDecoder::_tPktHeader> MetadataStreamDecoder::_read
     return header;
 }
 
-void MetadataStreamDecoder::_readPacketized()
+void MetadataStreamDecoder::_decodePacketized()
 {
-    std::vector<char> buf;
-    bool readMagic = false;
-
-    /*
-     * We can't initialize to `_curOffset` here because at this point we
-     * already read the magic number of the first packet.
-     */
-    decltype(_curOffset) curPktOffset = 0;
+    // the text can't be larger than the stream: allocate once
+    _text.reserve(this->_availSize());
 
     try {
-        while (true) {
-            const auto header = this->_readPktHeader(readMagic);
-
-            if (!header) {
-                // end of stream
-                break;
-            }
+        while (_cur != _end) {
+            const auto curPktOffset = this->_curOffset();
+            const auto header = this->_readPktHeader();
+            const auto pktHeaderSize = (this->_curOffset() - curPktOffset) * 8;
 
-            // read magic number from now on
-            readMagic = true;
-
-            const auto pktHeaderSize = (_curOffset - curPktOffset) * 8;
-
-            if (header->totalSize % 8 != 0) {
+            if (header.totalSize % 8 != 0) {
                 std::ostringstream ss;
 
-                ss << "packet total size: " << header->totalSize <<
+                ss << "packet total size: " << header.totalSize <<
                       " is not a multiple of 8.";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->contentSize % 8 != 0) {
+            if (header.contentSize % 8 != 0) {
                 std::ostringstream ss;
 
-                ss << "packet content size: " << header->contentSize <<
+                ss << "packet content size: " << header.contentSize <<
                       " is not a multiple of 8.";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->contentSize < pktHeaderSize) { std::ostringstream ss;
+            if (header.contentSize < pktHeaderSize) {
+                std::ostringstream ss;
 
-                ss << "packet content size (" << header->contentSize <<
+                ss << "packet content size (" << header.contentSize <<
                       ") should be at least " << pktHeaderSize << ".";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->contentSize > header->totalSize) {
+            if (header.contentSize > header.totalSize) {
                 std::ostringstream ss;
 
                 ss << "packet content size (" <<
-                      static_cast<unsigned int>(header->contentSize) <<
+                      static_cast<unsigned int>(header.contentSize) <<
                       ") is greater than total size (" <<
-                      static_cast<unsigned int>(header->totalSize) << ").";
+                      static_cast<unsigned int>(header.totalSize) << ").";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->majorVersion != 1 || header->minorVersion != 8) {
+            if (header.majorVersion != 1 || header.minorVersion != 8) {
                 std::ostringstream ss;
 
                 ss << "unknown major or minor version (" <<
-                      static_cast<unsigned int>(header->majorVersion) <<
-                      "." << static_cast<unsigned int>(header->minorVersion) <<
+                      static_cast<unsigned int>(header.majorVersion) <<
+                      "." << static_cast<unsigned int>(header.minorVersion) <<
                       ": expecting 1.8).";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->compressionScheme != 0) {
+            if (header.compressionScheme != 0) {
                 std::ostringstream ss;
 
                 ss << "unsupported compression scheme: " <<
-                      static_cast<unsigned int>(header->compressionScheme) << ".";
+                      static_cast<unsigned int>(header.compressionScheme) << ".";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->encryptionScheme != 0) {
+            if (header.encryptionScheme != 0) {
                 std::ostringstream ss;
 
                 ss << "unsupported encryption scheme: " <<
-                      static_cast<unsigned int>(header->encryptionScheme) << ".";
+                      static_cast<unsigned int>(header.encryptionScheme) << ".";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
-            if (header->checksumScheme != 0) {
+            if (header.checksumScheme != 0) {
                 std::ostringstream ss;
 
                 ss << "unsupported checksum scheme: " <<
-                      static_cast<unsigned int>(header->checksumScheme) << ".";
+                      static_cast<unsigned int>(header.checksumScheme) << ".";
                 this->_throwInvalid(curPktOffset, ss.str());
             }
 
             if (_pktCount == 0) {
                 // use the UUID of the first packet as the UUID
-                std::copy(header->uuid, header->uuid + 16, _uuid.begin());
+                std::copy(header.uuid, header.uuid + 16, _uuid.begin());
             } else {
                 buuids::uuid uuid;
 
-                std::copy(header->uuid, header->uuid + 16, uuid.begin());
+                std::copy(header.uuid, header.uuid + 16, uuid.begin());
 
                 if (uuid != _uuid) {
                     std::ostringstream ss;
@@ -435,72 +339,147 @@ void MetadataStreamDecoder::_readPacketized()
                 }
             }
 
-            const Size totalSizeBytes = header->totalSize / 8;
-            const Size contentSizeBytes = header->contentSize / 8;
+            const Size totalSizeBytes = header.totalSize / 8;
+            const Size contentSizeBytes = header.contentSize / 8;
             const Size pktHeaderSizeBytes = pktHeaderSize / 8;
             const Size textSizeBytes = contentSizeBytes - pktHeaderSizeBytes;
 
-            buf.resize(textSizeBytes);
-            this->_expect(buf.data(), textSizeBytes);
-
-            if (this->_streamIsBad()) {
-                throw IOError {"Cannot read metadata stream."};
-            }
+            this->_expect(textSizeBytes);
+            _text.append(reinterpret_cast<const char *>(_cur), textSizeBytes);
+            _cur += textSizeBytes;
 
             const Size paddingSizeBytes = totalSizeBytes - contentSizeBytes;
 
-            _stream->ignore(paddingSizeBytes);
-
-            if (static_cast<Size>(_stream->gcount()) != paddingSizeBytes) {
-                this->_throwEndsPrematurely(paddingSizeBytes);
-            }
-
-            if (this->_streamIsBad()) {
-                throw IOError {"Cannot read metadata stream."};
-            }
-
-            _curOffset += paddingSizeBytes;
-            _text.append(buf.data(), buf.size());
+            this->_expect(paddingSizeBytes);
+            _cur += paddingSizeBytes;
             ++_pktCount;
-            curPktOffset = _curOffset;
         }
     } catch (const InvalidMetadataStream& exc) {
         std::ostringstream ss;
 
         ss << "At packet " << _pktCount << ": " << exc.what();
         throw InvalidMetadataStream {ss.str(), exc.offset()};
-    } catch (const IOError& exc) {
-        std::ostringstream ss;
+    }
+}
 
-        ss << "At packet " << _pktCount << ": " << exc.what();
-        throw IOError {ss.str()};
+/*
+ * Reads the whole stream `stream` into `data`.
+ */
+void readStream(std::istream& stream, std::string& data)
+{
+    // fail now if the stream is already in a failing state
+    if (stream.fail() || stream.bad()) {
+        throw IOError {"Input stream is in a bad state before decoding."};
     }
+
+    /*
+     * We don't want any I/O exceptions while reading (we check the
+     * error flags explicitly), so temporarily set the exception mask of
+     * the input stream to nothing. Save the current value to restore it
+     * after reading.
+     */
+    const auto origStreamMask = stream.exceptions();
+
+    stream.exceptions(std::ios_base::goodbit);
+
+    while (!stream.eof()) {
+        static constexpr Size blkSize = 4096;
+        const auto offset = data.size();
+
+        data.resize(offset + blkSize);
+        stream.read(&data[offset], blkSize);
+
+        if (stream.bad() || (stream.fail() && !stream.eof())) {
+            stream.exceptions(origStreamMask);
+            throw IOError {"Cannot read metadata stream."};
+        }
+
+        data.resize(offset + stream.gcount());
+    }
+
+    stream.exceptions(origStreamMask);
 }
 
-void MetadataStreamDecoder::_readText()
+/*
+ * Read-only memory mapping of a whole file.
+ */
+class MmapFile final
 {
-    // just read everything
-    while (true) {
-        if (_stream->eof()) {
-            break;
+public:
+    explicit MmapFile(const std::string& path)
+    {
+        const auto fd = open(path.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            this->_throwIoError("Cannot open", path);
         }
 
-        const auto textOffset = _text.size();
+        struct stat stat;
 
-        {
-            static constexpr Size blkSize = 4096;
+        if (fstat(fd, &stat) < 0) {
+            const auto error = internal::strError();
 
-            _text.resize(_text.size() + blkSize);
-            _stream->read(&_text[textOffset], blkSize);
+            close(fd);
+            this->_throwIoError("Cannot get file status for", path, error);
         }
 
-        if (this->_streamIsBad()) {
-            throw IOError {"Cannot read metadata stream."};
+        _size = static_cast<Size>(stat.st_size);
+
+        if (_size > 0) {
+            _addr = mmap(nullptr, static_cast<size_t>(_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (_addr == MAP_FAILED) {
+                const auto error = internal::strError();
+
+                _addr = nullptr;
+                close(fd);
+                this->_throwIoError("Cannot memory-map", path, error);
+            }
+
+            // decoded once, from beginning to end
+            (void) madvise(_addr, static_cast<size_t>(_size), MADV_SEQUENTIAL);
         }
 
-        _text.resize(textOffset + _stream->gcount());
+        // the mapping remains valid without the file descriptor
+        close(fd);
+    }
+
+    ~MmapFile()
+    {
+        if (_addr) {
+            munmap(_addr, static_cast<size_t>(_size));
+        }
+    }
+
+    const std::uint8_t *begin() const noexcept
+    {
+        return static_cast<const std::uint8_t *>(_addr);
+    }
+
+    const std::uint8_t *end() const noexcept
+    {
+        return this->begin() + _size;
     }
-}
+
+private:
+    [[noreturn]] static void _throwIoError(const char * const what, const std::string& path)
+    {
+        _throwIoError(what, path, internal::strError());
+    }
+
+    [[noreturn]] static void _throwIoError(const char * const what, const std::string& path,
+                                           const std::string& error)
+    {
+        std::ostringstream ss;
+
+        ss << what << " \"" << path << "\": " << error;
+        throw IOError {ss.str()};
+    }
+
+private:
+    void *_addr = nullptr;
+    Size _size = 0;
+};
 
 } // namespace internal
 
@@ -512,20 +491,41 @@ InvalidMetadataStream::InvalidMetadataStream(std::string msg, const Index offset
 
 std::unique_ptr<const MetadataStream> createMetadataStream(std::istream& stream)
 {
-    internal::MetadataStreamDecoder decoder {stream};
-
-    if (decoder.isPacketized()) {
-        return std::unique_ptr<const PacketizedMetadataStream> {new PacketizedMetadataStream {
-            std::move(decoder.text()), decoder.pktCount(),
-            static_cast<unsigned int>(decoder.majorVersion()),
-            static_cast<unsigned int>(decoder.minorVersion()),
-            decoder.bo(), decoder.uuid()
-        }};
-    } else {
-        return std::unique_ptr<const PlainTextMetadataStream> {new PlainTextMetadataStream {
-            std::move(decoder.text())
-        }};
-    }
+    std::string data;
+
+    internal::readStream(stream, data);
+
+    const auto begin = reinterpret_cast<const std::uint8_t *>(data.data());
+    internal::MetadataStreamDecoder decoder {begin, begin + data.size()};
+
+    // plain text: the data is the text
+    return decoder.metadataStream([&data] {
+        return std::move(data);
+    });
+}
+
+std::unique_ptr<const MetadataStream> createMetadataStream(const char * const begin,
+                                                           const char * const end)
+{
+    internal::MetadataStreamDecoder decoder {
+        reinterpret_cast<const std::uint8_t *>(begin),
+        reinterpret_cast<const std::uint8_t *>(end)
+    };
+
+    return decoder.metadataStream([begin, end] {
+        return std::string {begin, end};
+    });
+}
+
+std::unique_ptr<const MetadataStream> createMetadataStream(const std::string& path)
+{
+    const internal::MmapFile file {path};
+    internal::MetadataStreamDecoder decoder {file.begin(), file.end()};
+
+    return decoder.metadataStream([&file] {
+        return std::string {reinterpret_cast<const char *>(file.begin()),
+                            reinterpret_cast<const char *>(file.end())};
+    });
 }
 
 } // namespace yactfr
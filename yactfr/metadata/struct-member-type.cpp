@@ -8,6 +8,7 @@
 #include <utility>
 
 #include <yactfr/metadata/struct-member-type.hpp>
+#include <yactfr/internal/metadata/dt-content.hpp>
 #include <yactfr/internal/metadata/utils.hpp>
 
 namespace yactfr {
@@ -15,7 +16,7 @@ namespace yactfr {
 StructureMemberType::StructureMemberType(std::string name, DataType::Up dt, MapItem::Up attrs) :
     _name {std::move(name)},
     _dt {std::move(dt)},
-    _attrs {std::move(attrs)}
+    _attrs {internal::internAttrs(std::move(attrs))}
 {
 }
 
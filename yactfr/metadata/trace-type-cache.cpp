@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <yactfr/metadata/trace-type-cache.hpp>
+
+#include "../internal/metadata/trace-type-bin.hpp"
+
+namespace yactfr {
+namespace {
+
+/*
+ * Returns the 64-bit FNV-1a hash of the bytes from `begin` to `end`.
+ */
+std::uint64_t fnv1a64(const char *begin, const char * const end) noexcept
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (; begin != end; ++begin) {
+        hash ^= static_cast<unsigned char>(*begin);
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+/*
+ * Reads the whole file `path` into `contents`, returning `false` on
+ * error.
+ */
+bool readFile(const std::string& path, std::string& contents)
+{
+    std::ifstream file {path, std::ios::binary | std::ios::ate};
+
+    if (!file) {
+        return false;
+    }
+
+    const auto size = file.tellg();
+
+    if (size < 0) {
+        return false;
+    }
+
+    // read everything at once: a cache file can be a few megabytes
+    contents.resize(static_cast<std::size_t>(size));
+    file.seekg(0);
+    file.read(&contents[0], size);
+    return static_cast<bool>(file);
+}
+
+/*
+ * Writes the `size` bytes of `data` to the file descriptor `fd`,
+ * returning `false` on error.
+ */
+bool writeAll(const int fd, const char *data, std::size_t size) noexcept
+{
+    while (size > 0) {
+        const auto count = ::write(fd, data, size);
+
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        data += count;
+        size -= static_cast<std::size_t>(count);
+    }
+
+    return true;
+}
+
+/*
+ * Writes `contents` to the file `path` through a temporary file within
+ * the same directory so that a concurrent reader never sees a partial
+ * file, ignoring any error.
+ *
+ * mkstemp() makes the name of the temporary file unique, so that
+ * concurrent writers of the same file, even within the same process,
+ * never write to the same temporary file.
+ */
+void writeFile(const std::string& path, const std::string& contents)
+{
+    const auto tmpPathTemplate = path + ".tmp.XXXXXX";
+    std::vector<char> tmpPath {tmpPathTemplate.begin(), tmpPathTemplate.end()};
+
+    tmpPath.push_back('\0');
+
+    const auto fd = mkstemp(tmpPath.data());
+
+    if (fd < 0) {
+        return;
+    }
+
+    // mkstemp() creates the file with mode 0600
+    auto ok = fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0 &&
+              writeAll(fd, contents.data(), contents.size());
+
+    if (close(fd) != 0) {
+        ok = false;
+    }
+
+    if (!ok || std::rename(tmpPath.data(), path.c_str()) != 0) {
+        std::remove(tmpPath.data());
+    }
+}
+
+} // namespace
+
+TraceTypeCache::TraceTypeCache(std::string directoryPath) :
+    _dirPath {std::move(directoryPath)}
+{
+}
+
+std::string TraceTypeCache::filePath(const char * const begin, const char * const end) const
+{
+    std::ostringstream ss;
+
+    ss << _dirPath << '/' << std::hex << std::setw(16) << std::setfill('0') <<
+          fnv1a64(begin, end) << ".yactfr-tt";
+    return ss.str();
+}
+
+FromMetadataTextReturn TraceTypeCache::fromMetadataText(const char * const begin,
+                                                        const char * const end) const
+{
+    const auto path = this->filePath(begin, end);
+
+    {
+        std::string bin;
+
+        if (readFile(path, bin)) {
+            try {
+                return internal::traceTypeFromBin(bin, begin, end);
+            } catch (const internal::InvalidTraceTypeBin&) {
+                // invalid or stale cache file: parse and overwrite it
+            }
+        }
+    }
+
+    auto ret = yactfr::fromMetadataText(begin, end);
+
+    writeFile(path, internal::traceTypeToBin(*ret.first, ret.second, begin, end));
+    return ret;
+}
+
+} // namespace yactfr
@@ -12,6 +12,7 @@
 #include <functional>
 #include <cstdlib>
 #include <cstring>
+#include <cassert>
 
 #ifndef NDEBUG
 # include <iostream>
@@ -25,6 +26,7 @@
 #include "../internal/metadata/trace-type-impl.hpp"
 #include "../internal/proc.hpp"
 #include "../internal/pkt-proc-builder.hpp"
+#include "../internal/profile.hpp"
 
 namespace yactfr {
 
@@ -52,6 +54,11 @@ TraceType::TraceType(const unsigned int majorVersion, const unsigned int minorVe
 
 TraceType::~TraceType()
 {
+#ifdef YACTFR_PROFILE
+    if (const auto pktProc = _pimpl->builtPktProc()) {
+        internal::dumpProf(*pktProc);
+    }
+#endif
 }
 
 unsigned int TraceType::majorVersion() const noexcept
@@ -129,4 +136,17 @@ bool TraceType::isEmpty() const noexcept
     return _pimpl->dsts().empty();
 }
 
+const FieldHandle *TraceType::fieldHandle(const DataStreamType& dataStreamType,
+                                          const DataLocation& location) const
+{
+    return _pimpl->fieldHandle(dataStreamType, nullptr, location);
+}
+
+const FieldHandle *TraceType::fieldHandle(const EventRecordType& eventRecordType,
+                                          const DataLocation& location) const
+{
+    assert(eventRecordType.dataStreamType());
+    return _pimpl->fieldHandle(*eventRecordType.dataStreamType(), &eventRecordType, location);
+}
+
 } // namespace yactfr
@@ -10,6 +10,7 @@
 #include <sstream>
 #include <array>
 #include <sys/mman.h>
+#include <fcntl.h>
 
 #include <yactfr/mmap-file-view-factory.hpp>
 #include <yactfr/io-error.hpp>
@@ -29,14 +30,27 @@ public:
 
 private:
     boost::optional<DataBlock> _data(Index offset, Size minSize) override;
+    boost::optional<DataBlock> _tryData(Index offset, Size minSize, bool& isAvailable) override;
+    void _releaseDataBefore(Index offset) noexcept override;
     void _doMmap(Index offset);
     void _doMunmap();
+    void _adviseMmap();
+    void _readAheadNextRegion();
 
 private:
     std::shared_ptr<internal::MmapFileViewFactoryImpl> _mmapFileViewFactoryImpl;
     void *_mmapAddr = nullptr;
     Size _mmapLength = 0;
     Index _mmapOffset = 0;
+
+    /*
+     * Offset at which to read ahead the file region following the
+     * current memory map, if not done yet.
+     */
+    boost::optional<Index> _readAheadOffset;
+
+    // offset before which we already dropped the data (drop-behind)
+    Index _releasedOffset = 0;
     std::array<std::uint8_t, 16> _tmpBuf;
 };
 
@@ -52,9 +66,40 @@ MemoryMappedFileView::~MemoryMappedFileView()
 
 boost::optional<DataBlock> MemoryMappedFileView::_data(const Index offset, const Size minSize)
 {
+    bool isAvailable;
+    auto dataBlock = this->_tryData(offset, minSize, isAvailable);
+
+    if (!isAvailable) {
+        throw DataNotAvailable {};
+    }
+
+    return dataBlock;
+}
+
+boost::optional<DataBlock> MemoryMappedFileView::_tryData(const Index offset, const Size minSize,
+                                                          bool& isAvailable)
+{
+    isAvailable = true;
+
     if ((offset + minSize) > _mmapFileViewFactoryImpl->fileSize()) {
-        // no more data
-        return boost::none;
+        if (!_mmapFileViewFactoryImpl->followFile()) {
+            // no more data
+            return boost::none;
+        }
+
+        /*
+         * Follow mode: the file could have grown since we last checked.
+         *
+         * If it's still not large enough, then the requested data
+         * (possibly part of a partially written packet) could become
+         * available later.
+         */
+        _mmapFileViewFactoryImpl->updateFileSize();
+
+        if ((offset + minSize) > _mmapFileViewFactoryImpl->fileSize()) {
+            isAvailable = false;
+            return boost::none;
+        }
     }
 
     if (!_mmapAddr) {
@@ -65,13 +110,33 @@ boost::optional<DataBlock> MemoryMappedFileView::_data(const Index offset, const
     if (offset < _mmapOffset || offset >= (_mmapOffset + _mmapLength)) {
         // requested offset is outside the current memory-mapped region
         this->_doMmap(offset);
+    } else if ((offset + minSize) > (_mmapOffset + _mmapLength) &&
+            _mmapLength < _mmapFileViewFactoryImpl->mmapSize()) {
+        /*
+         * The end of the file truncated the current memory-mapped
+         * region, but the file grew since (follow mode): map again to
+         * include the requested data.
+         */
+        this->_doMmap(offset);
     }
 
     assert(_mmapAddr);
 
     const auto offsetFromMmapOffset = offset - _mmapOffset;
     const void * const addr = static_cast<const void *>(static_cast<const std::uint8_t *>(_mmapAddr) + offsetFromMmapOffset);
-    const auto availSize = _mmapLength - offsetFromMmapOffset;
+    auto availSize = _mmapLength - offsetFromMmapOffset;
+
+    if (_readAheadOffset) {
+        if (offset + minSize <= *_readAheadOffset) {
+            /*
+             * Stop the returned data block at the read-ahead offset so
+             * that the VM calls us again once it gets there.
+             */
+            availSize = *_readAheadOffset - offset;
+        } else {
+            this->_readAheadNextRegion();
+        }
+    }
 
     if (availSize < minSize) {
         /*
@@ -94,6 +159,52 @@ boost::optional<DataBlock> MemoryMappedFileView::_data(const Index offset, const
     }
 }
 
+void MemoryMappedFileView::_releaseDataBefore(const Index offset) noexcept
+{
+    if (!_mmapFileViewFactoryImpl->dropBehind()) {
+        return;
+    }
+
+    // only drop whole pages
+    const auto endOffset = offset & ~(_mmapFileViewFactoryImpl->mmapOffsetGranularity() - 1);
+
+    if (endOffset < _releasedOffset) {
+        /*
+         * We went back (seeked a previous packet, for example): only
+         * consider the current memory-mapped region from now on.
+         */
+        _releasedOffset = std::min(_mmapOffset, endOffset);
+    }
+
+    if (endOffset == _releasedOffset) {
+        // nothing new to drop
+        return;
+    }
+
+#ifdef MADV_DONTNEED
+    if (_mmapAddr) {
+        /*
+         * Drop the pages of the current memory map first: the kernel
+         * can't evict mapped pages from the page cache.
+         */
+        const auto beginOffset = std::max(_releasedOffset, _mmapOffset);
+        const auto mmapEndOffset = std::min(endOffset, _mmapOffset + _mmapLength);
+
+        if (beginOffset < mmapEndOffset) {
+            (void) madvise(static_cast<std::uint8_t *>(_mmapAddr) + (beginOffset - _mmapOffset),
+                           static_cast<size_t>(mmapEndOffset - beginOffset), MADV_DONTNEED);
+        }
+    }
+#endif
+
+#ifdef POSIX_FADV_DONTNEED
+    (void) posix_fadvise(_mmapFileViewFactoryImpl->fd(), static_cast<off_t>(_releasedOffset),
+                         static_cast<off_t>(endOffset - _releasedOffset), POSIX_FADV_DONTNEED);
+#endif
+
+    _releasedOffset = endOffset;
+}
+
 void MemoryMappedFileView::_doMunmap()
 {
     if (_mmapAddr) {
@@ -108,8 +219,17 @@ void MemoryMappedFileView::_doMmap(const Index offset)
     _mmapOffset = offset & ~(_mmapFileViewFactoryImpl->mmapOffsetGranularity() - 1);
     _mmapLength = std::min(_mmapFileViewFactoryImpl->fileSize() - _mmapOffset,
                            _mmapFileViewFactoryImpl->mmapSize());
+
+    auto flags = MAP_PRIVATE;
+
+#ifdef MAP_POPULATE
+    if (_mmapFileViewFactoryImpl->prefaultPages()) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+
     _mmapAddr = mmap(nullptr, static_cast<size_t>(_mmapLength), PROT_READ,
-                     MAP_PRIVATE, _mmapFileViewFactoryImpl->fd(),
+                     flags, _mmapFileViewFactoryImpl->fd(),
                      static_cast<off_t>(_mmapOffset));
 
     if (_mmapAddr == MAP_FAILED) {
@@ -123,6 +243,13 @@ void MemoryMappedFileView::_doMmap(const Index offset)
         throw IOError {ss.str()};
     }
 
+    this->_adviseMmap();
+}
+
+void MemoryMappedFileView::_adviseMmap()
+{
+    const auto mmapEnd = _mmapOffset + _mmapLength;
+
     switch (_mmapFileViewFactoryImpl->accessPattern()) {
     case MemoryMappedFileViewFactory::AccessPattern::Normal:
         (void) madvise(_mmapAddr, static_cast<size_t>(_mmapLength), MADV_NORMAL);
@@ -134,6 +261,36 @@ void MemoryMappedFileView::_doMmap(const Index offset)
         (void) madvise(_mmapAddr, static_cast<size_t>(_mmapLength), MADV_RANDOM);
         break;
     }
+
+#ifdef MADV_HUGEPAGE
+    if (_mmapFileViewFactoryImpl->adviseHugePages()) {
+        (void) madvise(_mmapAddr, static_cast<size_t>(_mmapLength), MADV_HUGEPAGE);
+    }
+#endif
+
+    if (_mmapFileViewFactoryImpl->readAheadNextRegion() &&
+            mmapEnd < _mmapFileViewFactoryImpl->fileSize()) {
+        // read ahead once we reach the last quarter of this memory map
+        _readAheadOffset = mmapEnd - _mmapLength / 4;
+    } else {
+        _readAheadOffset = boost::none;
+    }
+}
+
+void MemoryMappedFileView::_readAheadNextRegion()
+{
+    const auto nextRegionOffset = _mmapOffset + _mmapLength;
+
+    // only once per memory map
+    _readAheadOffset = boost::none;
+
+#ifdef POSIX_FADV_WILLNEED
+    const auto nextRegionLen = std::min(_mmapFileViewFactoryImpl->fileSize() - nextRegionOffset,
+                                        _mmapFileViewFactoryImpl->mmapSize());
+
+    (void) posix_fadvise(_mmapFileViewFactoryImpl->fd(), static_cast<off_t>(nextRegionOffset),
+                         static_cast<off_t>(nextRegionLen), POSIX_FADV_WILLNEED);
+#endif
 }
 
 } // namespace internal
@@ -158,6 +315,72 @@ void MemoryMappedFileViewFactory::expectedAccessPattern(const AccessPattern expe
     _pimpl->accessPattern(expectedAccessPattern);
 }
 
+bool MemoryMappedFileViewFactory::prefaultPages() const noexcept
+{
+    return _pimpl->prefaultPages();
+}
+
+void MemoryMappedFileViewFactory::prefaultPages(const bool prefaultPages) noexcept
+{
+    _pimpl->prefaultPages(prefaultPages);
+}
+
+bool MemoryMappedFileViewFactory::adviseHugePages() const noexcept
+{
+    return _pimpl->adviseHugePages();
+}
+
+void MemoryMappedFileViewFactory::adviseHugePages(const bool adviseHugePages) noexcept
+{
+    _pimpl->adviseHugePages(adviseHugePages);
+}
+
+bool MemoryMappedFileViewFactory::readAheadNextRegion() const noexcept
+{
+    return _pimpl->readAheadNextRegion();
+}
+
+void MemoryMappedFileViewFactory::readAheadNextRegion(const bool readAheadNextRegion) noexcept
+{
+    _pimpl->readAheadNextRegion(readAheadNextRegion);
+}
+
+bool MemoryMappedFileViewFactory::dropBehind() const noexcept
+{
+    return _pimpl->dropBehind();
+}
+
+void MemoryMappedFileViewFactory::dropBehind(const bool dropBehind) noexcept
+{
+    _pimpl->dropBehind(dropBehind);
+}
+
+bool MemoryMappedFileViewFactory::followFile() const noexcept
+{
+    return _pimpl->followFile();
+}
+
+void MemoryMappedFileViewFactory::followFile(const bool followFile) noexcept
+{
+    _pimpl->followFile(followFile);
+}
+
+int MemoryMappedFileViewFactory::fileChangeFd()
+{
+    return _pimpl->fileChangeFd();
+}
+
+bool MemoryMappedFileViewFactory::updateFileSize()
+{
+    _pimpl->drainFileChangeFd();
+    return _pimpl->updateFileSize();
+}
+
+bool MemoryMappedFileViewFactory::waitForFileGrowth(const boost::optional<std::chrono::milliseconds>& timeout)
+{
+    return _pimpl->waitForFileGrowth(timeout);
+}
+
 DataSource::Up MemoryMappedFileViewFactory::_createDataSource()
 {
     return std::make_unique<internal::MemoryMappedFileView>(_pimpl);
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2024 Philippe Proulx <eepp.ca>
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <sstream>
+#include <array>
+
+#include <yactfr/shm-ring-data-src-factory.hpp>
+#include <yactfr/io-error.hpp>
+
+#include "internal/shm-ring-data-src-factory-impl.hpp"
+
+namespace yactfr {
+namespace internal {
+
+class ShmRingDataSrc final :
+    public DataSource
+{
+public:
+    explicit ShmRingDataSrc(std::shared_ptr<internal::ShmRingDataSrcFactoryImpl> shmRingDataSrcFactoryImpl);
+    ~ShmRingDataSrc();
+
+private:
+    enum class _PktAvail {
+        Available,
+        NotAvailable,
+        End,
+    };
+
+private:
+    boost::optional<DataBlock> _data(Index offset, Size minSize) override;
+    boost::optional<DataBlock> _tryData(Index offset, Size minSize, bool& isAvailable) override;
+    void _releaseDataBefore(Index offset) noexcept override;
+    bool _isShareable() const noexcept override;
+    _PktAvail _pktAvail(std::uint64_t seq) const noexcept;
+    Size _pktSize(std::uint64_t seq) const;
+    void _releaseCurPkt() noexcept;
+
+private:
+    std::shared_ptr<internal::ShmRingDataSrcFactoryImpl> _shmRingDataSrcFactoryImpl;
+    Index _consumerIndex;
+
+    // sequence number of the current packet
+    std::uint64_t _curPktSeq;
+
+    // offset of the current packet within the element sequence
+    Index _curPktOffset = 0;
+
+    // size of the current packet, if it's published
+    boost::optional<Size> _curPktSize;
+
+    std::array<std::uint8_t, 16> _tmpBuf;
+};
+
+ShmRingDataSrc::ShmRingDataSrc(std::shared_ptr<internal::ShmRingDataSrcFactoryImpl> shmRingDataSrcFactoryImpl) :
+    _shmRingDataSrcFactoryImpl {std::move(shmRingDataSrcFactoryImpl)},
+    _consumerIndex {_shmRingDataSrcFactoryImpl->acquireConsumer()},
+    _curPktSeq {_shmRingDataSrcFactoryImpl->consumerPos(_consumerIndex).load()}
+{
+}
+
+ShmRingDataSrc::~ShmRingDataSrc()
+{
+    _shmRingDataSrcFactoryImpl->releaseConsumer(_consumerIndex);
+}
+
+ShmRingDataSrc::_PktAvail ShmRingDataSrc::_pktAvail(const std::uint64_t seq) const noexcept
+{
+    const auto& header = _shmRingDataSrcFactoryImpl->header();
+
+    if (seq < header.publishedCount.load()) {
+        return _PktAvail::Available;
+    }
+
+    // the producer could publish a last packet and then close the ring
+    if (header.isClosed.load() && seq >= header.publishedCount.load()) {
+        return _PktAvail::End;
+    }
+
+    return _PktAvail::NotAvailable;
+}
+
+Size ShmRingDataSrc::_pktSize(const std::uint64_t seq) const
+{
+    const auto size = _shmRingDataSrcFactoryImpl->pktSize(seq);
+    const auto slotSize = _shmRingDataSrcFactoryImpl->header().slotSize;
+
+    if (size > slotSize) {
+        std::ostringstream ss;
+
+        ss << "Packet #" << seq << " of the packet ring of shared memory object \"" <<
+              _shmRingDataSrcFactoryImpl->name() << "\" is larger (" << size <<
+              " bytes) than a packet slot (" << slotSize << " bytes).";
+        throw IOError {ss.str()};
+    }
+
+    return size;
+}
+
+void ShmRingDataSrc::_releaseCurPkt() noexcept
+{
+    assert(_curPktSize);
+    _curPktOffset += *_curPktSize;
+    ++_curPktSeq;
+    _curPktSize = boost::none;
+
+    // from this point, the producer can overwrite the previous packet
+    _shmRingDataSrcFactoryImpl->consumerPos(_consumerIndex).store(_curPktSeq);
+}
+
+boost::optional<DataBlock> ShmRingDataSrc::_data(const Index offset, const Size minSize)
+{
+    bool isAvailable;
+    auto dataBlock = this->_tryData(offset, minSize, isAvailable);
+
+    if (!isAvailable) {
+        throw DataNotAvailable {};
+    }
+
+    return dataBlock;
+}
+
+boost::optional<DataBlock> ShmRingDataSrc::_tryData(const Index offset, const Size minSize,
+                                                    bool& isAvailable)
+{
+    isAvailable = true;
+
+    if (offset < _curPktOffset) {
+        std::ostringstream ss;
+
+        ss << "Cannot read data at offset " << offset << " of the packet ring of shared "
+              "memory object \"" << _shmRingDataSrcFactoryImpl->name() << "\": " <<
+              "the data source already released this packet.";
+        throw IOError {ss.str()};
+    }
+
+    /*
+     * Move to the packet containing `offset`.
+     *
+     * Releasing the current packet here is safe: the current data block
+     * of the caller cannot contain data beyond the current packet.
+     */
+    while (true) {
+        if (!_curPktSize) {
+            switch (this->_pktAvail(_curPktSeq)) {
+            case _PktAvail::NotAvailable:
+                isAvailable = false;
+                return boost::none;
+
+            case _PktAvail::End:
+                return boost::none;
+
+            default:
+                break;
+            }
+
+            _curPktSize = this->_pktSize(_curPktSeq);
+        }
+
+        if (offset < _curPktOffset + *_curPktSize) {
+            break;
+        }
+
+        this->_releaseCurPkt();
+    }
+
+    const auto offsetInPkt = offset - _curPktOffset;
+    const auto size = *_curPktSize - offsetInPkt;
+    const auto data = _shmRingDataSrcFactoryImpl->pktData(_curPktSeq) + offsetInPkt;
+
+    if (size >= minSize) {
+        // zero-copy
+        return DataBlock {static_cast<const void *>(data), size};
+    }
+
+    /*
+     * The request spans packets: copy the data to a temporary buffer.
+     *
+     * Don't modify `_tmpBuf` before we know that all the data is
+     * available: it could be the current data block of the caller.
+     */
+    std::array<std::uint8_t, 16> buf;
+    Size bufSize = size;
+    auto seq = _curPktSeq + 1;
+
+    assert(minSize <= buf.size());
+    std::memcpy(buf.data(), data, size);
+
+    while (bufSize < minSize) {
+        switch (this->_pktAvail(seq)) {
+        case _PktAvail::NotAvailable:
+            isAvailable = false;
+            return boost::none;
+
+        case _PktAvail::End:
+            return boost::none;
+
+        default:
+            break;
+        }
+
+        const auto copySize = std::min(this->_pktSize(seq), minSize - bufSize);
+
+        std::memcpy(buf.data() + bufSize, _shmRingDataSrcFactoryImpl->pktData(seq), copySize);
+        bufSize += copySize;
+        ++seq;
+    }
+
+    _tmpBuf = buf;
+    return DataBlock {static_cast<const void *>(_tmpBuf.data()), bufSize};
+}
+
+void ShmRingDataSrc::_releaseDataBefore(const Index offset) noexcept
+{
+    if (_curPktSize && offset >= _curPktOffset + *_curPktSize) {
+        this->_releaseCurPkt();
+    }
+}
+
+bool ShmRingDataSrc::_isShareable() const noexcept
+{
+    // _tryData() releases the packets which it moves past
+    return false;
+}
+
+} // namespace internal
+
+SharedMemoryRingDataSourceFactory::SharedMemoryRingDataSourceFactory(std::string name) :
+    _pimpl {std::make_shared<internal::ShmRingDataSrcFactoryImpl>(std::move(name))}
+{
+}
+
+DataSource::Up SharedMemoryRingDataSourceFactory::_createDataSource()
+{
+    return std::make_unique<internal::ShmRingDataSrc>(_pimpl);
+}
+
+} // namespace yactfr